@@ -0,0 +1,90 @@
+/**
+ * @file bench.h
+ * @brief 基准测试：负载描述、结果与报表输出
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_BENCH_BENCH_H_
+#define DEVICE_FRAMEWORK_BENCH_BENCH_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "device_framework/virtio_blk.hpp"
+#include "test_env.h"
+
+/// 每个负载的运行时长（rdtime 计数，0.5 秒）
+constexpr uint64_t kBenchRuntimeTicks = kTimebaseFrequency / 2;
+
+/**
+ * @brief 访问模式
+ */
+enum class AccessPattern : uint8_t {
+  /// 在工作集中按块对齐随机分布
+  kRandom,
+  /// 从工作集起点顺序推进，到达末尾后回绕
+  kSequential,
+};
+
+/**
+ * @brief 单个负载描述（对应 fio 的一个 job）
+ */
+struct BenchProfile {
+  /// 负载名（如 "randread"）
+  const char* name;
+  /// 每个请求的字节数（扇区大小的整数倍）
+  size_t block_size;
+  /// 同时在途的请求数
+  uint16_t queue_depth;
+  /// 读请求占比（百分比，100 为只读，0 为只写）
+  uint8_t read_percent;
+  /// 访问模式
+  AccessPattern pattern;
+};
+
+/**
+ * @brief 单个负载的测量结果
+ *
+ * 时间与延迟以 rdtime 计数为单位，cycles 为 rdcycle 差值。
+ */
+struct BenchResult {
+  /// 成功完成的请求数
+  uint64_t ios = 0;
+  /// 成功传输的字节数
+  uint64_t bytes = 0;
+  /// 失败的请求数（入队失败或设备返回错误）
+  uint64_t errors = 0;
+  /// 从首个请求提交到最后一个请求完成的时长
+  uint64_t elapsed = 0;
+  /// 同一区间内的 CPU 周期数
+  uint64_t cycles = 0;
+  /// 回收到至少一个完成的回收次数（同步路径每个请求一次）
+  uint64_t reaps = 0;
+  /// 区间内驱动借助 Event Index 省略的 Kick 次数
+  uint64_t kicks_elided = 0;
+  /// 单个请求从提交到完成的延迟分布
+  device_framework::virtio::blk::Log2Histogram<
+      device_framework::virtio::blk::kLatencyBuckets>
+      latency{};
+};
+
+/**
+ * @brief 打印结果表头
+ */
+void bench_print_header();
+
+/**
+ * @brief 打印一行结果
+ * @param engine 提交路径名（"async"/"sync"/"blkdev"）
+ * @param profile 负载描述
+ * @param result 测量结果
+ */
+void bench_print_row(const char* engine, const BenchProfile& profile,
+                     const BenchResult& result);
+
+/**
+ * @brief 运行块设备基准测试（async / sync / BlockDevice 三条路径）
+ */
+void bench_virtio_blk();
+
+#endif /* DEVICE_FRAMEWORK_BENCH_BENCH_H_ */
@@ -0,0 +1,333 @@
+/**
+ * @file blk_bench.cpp
+ * @brief VirtIO 块设备基准测试（fio 风格负载）
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 负载：
+ * 1. async：EnqueueRead/EnqueueWrite + Kick，轮询 HandleInterrupt 回收，
+ *    4K 随机读/写 QD 1/8/32/64、128K 顺序读/写、4K 70/30 混合
+ * 2. sync：Read/Write（每次一个扇区，QD 1）
+ * 3. blkdev：BlockDevice::ReadBlocks/WriteBlocks（QD 1）
+ *
+ * 每个负载运行 kBenchRuntimeTicks，随后等待在途请求全部完成。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "bench.h"
+#include "device_framework/virtio_blk.hpp"
+#include "test_env.h"
+#include "uart.h"
+
+namespace {
+
+using device_framework::ErrorCode;
+using device_framework::virtio::IoVec;
+
+using BlkType = device_framework::virtio::blk::VirtioBlk<RiscvTraits>;
+using BlkDeviceType =
+    device_framework::virtio::blk::VirtioBlkDevice<RiscvTraits>;
+
+/// 队列大小（QD 64 时每个请求 3 个描述符仍有余量）
+constexpr uint32_t kQueueSize = 256;
+/// 最大队列深度
+constexpr uint16_t kMaxQueueDepth = 64;
+/// 数据缓冲区大小（queue_depth * block_size 不得超过）
+constexpr size_t kBenchBufSize = 1 << 20;
+/// 工作集上限（扇区数，64MB）
+constexpr uint64_t kMaxWorkingSetSectors = (64 << 20) / kSectorSize;
+
+static_assert(kMaxQueueDepth <= BlkType::kMaxInflight,
+              "queue depth exceeds request slots");
+
+alignas(4096) uint8_t g_bench_dma[BlkType::CalcDmaSize(kQueueSize)];
+alignas(4096) uint8_t g_bench_buf[kBenchBufSize];
+
+/// 异步路径负载
+constexpr BenchProfile kAsyncProfiles[] = {
+    {"randread", 4096, 1, 100, AccessPattern::kRandom},
+    {"randread", 4096, 8, 100, AccessPattern::kRandom},
+    {"randread", 4096, 32, 100, AccessPattern::kRandom},
+    {"randread", 4096, 64, 100, AccessPattern::kRandom},
+    {"randwrite", 4096, 1, 0, AccessPattern::kRandom},
+    {"randwrite", 4096, 8, 0, AccessPattern::kRandom},
+    {"randwrite", 4096, 32, 0, AccessPattern::kRandom},
+    {"randwrite", 4096, 64, 0, AccessPattern::kRandom},
+    {"seqread", 131072, 8, 100, AccessPattern::kSequential},
+    {"seqwrite", 131072, 8, 0, AccessPattern::kSequential},
+    {"randrw", 4096, 32, 70, AccessPattern::kRandom},
+};
+
+/// 同步路径负载（Read/Write 每次传输一个扇区）
+constexpr BenchProfile kSyncProfiles[] = {
+    {"randread", 512, 1, 100, AccessPattern::kRandom},
+    {"randwrite", 512, 1, 0, AccessPattern::kRandom},
+    {"randrw", 512, 1, 70, AccessPattern::kRandom},
+};
+
+/// BlockDevice 层负载
+constexpr BenchProfile kBlkDevProfiles[] = {
+    {"randread", 4096, 1, 100, AccessPattern::kRandom},
+    {"randwrite", 4096, 1, 0, AccessPattern::kRandom},
+    {"seqread", 131072, 1, 100, AccessPattern::kSequential},
+    {"seqwrite", 131072, 1, 0, AccessPattern::kSequential},
+    {"randrw", 4096, 1, 70, AccessPattern::kRandom},
+};
+
+/**
+ * @brief 负载的偏移与读写选择（xorshift64，固定种子保证可复现）
+ */
+class OffsetGenerator {
+ public:
+  OffsetGenerator(const BenchProfile& profile, uint64_t working_set_sectors)
+      : profile_(profile),
+        sectors_per_io_(profile.block_size / kSectorSize),
+        slots_(working_set_sectors / sectors_per_io_) {}
+
+  /// @brief 下一个请求的起始扇区
+  auto NextSector() -> uint64_t {
+    if (profile_.pattern == AccessPattern::kSequential) {
+      uint64_t slot = next_++;
+      if (next_ == slots_) {
+        next_ = 0;
+      }
+      return slot * sectors_per_io_;
+    }
+    return (Next() % slots_) * sectors_per_io_;
+  }
+
+  /// @brief 下一个请求是否为读
+  auto NextIsRead() -> bool { return Next() % 100 < profile_.read_percent; }
+
+ private:
+  auto Next() -> uint64_t {
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 7;
+    state_ ^= state_ << 17;
+    return state_;
+  }
+
+  const BenchProfile& profile_;
+  uint64_t sectors_per_io_;
+  uint64_t slots_;
+  uint64_t next_ = 0;
+  uint64_t state_ = 0x9E3779B97F4A7C15;
+};
+
+/**
+ * @brief 异步路径：保持 queue_depth 个请求在途
+ *
+ * 每轮先以单次 HandleInterrupt 回收全部完成，再补齐空闲槽并 Kick 一次，
+ * 因此 batch 列反映每次回收的完成数，elided 列反映 Event Index 省略的通知。
+ */
+auto RunAsync(BlkType& blk, const BenchProfile& profile,
+              uint64_t working_set_sectors) -> BenchResult {
+  struct Slot {
+    uint64_t submitted_at;
+  };
+  Slot slots[kMaxQueueDepth];
+  uint16_t free_slots[kMaxQueueDepth];
+  uint16_t free_count = profile.queue_depth;
+  for (uint16_t i = 0; i < profile.queue_depth; ++i) {
+    free_slots[i] = i;
+  }
+
+  BenchResult result;
+  OffsetGenerator gen(profile, working_set_sectors);
+  uint16_t inflight = 0;
+
+  auto issue = [&](uint16_t slot_index) -> bool {
+    auto& slot = slots[slot_index];
+    IoVec iov{RiscvTraits::VirtToPhys(g_bench_buf +
+                                      slot_index * profile.block_size),
+              profile.block_size};
+    uint64_t sector = gen.NextSector();
+    bool is_read = gen.NextIsRead();
+    slot.submitted_at = ReadTimeCounter();
+    auto enq = is_read ? blk.EnqueueRead(0, sector, &iov, 1, &slot)
+                       : blk.EnqueueWrite(0, sector, &iov, 1, &slot);
+    if (!enq.has_value()) {
+      ++result.errors;
+      return false;
+    }
+    ++inflight;
+    return true;
+  };
+
+  auto on_complete = [&](void* token, ErrorCode status) {
+    auto* slot = static_cast<Slot*>(token);
+    result.latency.Record(ReadTimeCounter() - slot->submitted_at);
+    if (status == ErrorCode::kSuccess) {
+      ++result.ios;
+      result.bytes += profile.block_size;
+    } else {
+      ++result.errors;
+    }
+    free_slots[free_count++] = static_cast<uint16_t>(slot - slots);
+    --inflight;
+  };
+
+  uint64_t elided_before = blk.GetStats().kicks_elided;
+  uint64_t start = ReadTimeCounter();
+  uint64_t start_cycles = ReadCycleCounter();
+  bool running = true;
+  while (running || inflight > 0) {
+    if (running) {
+      running = ReadTimeCounter() - start < kBenchRuntimeTicks;
+    }
+    bool issued = false;
+    while (running && free_count > 0) {
+      uint16_t slot_index = free_slots[--free_count];
+      if (!issue(slot_index)) {
+        free_slots[free_count++] = slot_index;
+        running = false;
+        break;
+      }
+      issued = true;
+    }
+    if (issued) {
+      blk.Kick(0);
+    }
+
+    uint64_t completed_before = result.ios + result.errors;
+    RiscvTraits::Rmb();
+    blk.HandleInterrupt(0, on_complete);
+    if (result.ios + result.errors != completed_before) {
+      ++result.reaps;
+    }
+  }
+  result.cycles = ReadCycleCounter() - start_cycles;
+  result.elapsed = ReadTimeCounter() - start;
+  result.kicks_elided = blk.GetStats().kicks_elided - elided_before;
+  return result;
+}
+
+/**
+ * @brief 同步路径：Read/Write 逐扇区提交并等待完成
+ */
+auto RunSync(BlkType& blk, const BenchProfile& profile,
+             uint64_t working_set_sectors) -> BenchResult {
+  BenchResult result;
+  OffsetGenerator gen(profile, working_set_sectors);
+
+  uint64_t elided_before = blk.GetStats().kicks_elided;
+  uint64_t start = ReadTimeCounter();
+  uint64_t start_cycles = ReadCycleCounter();
+  uint64_t now = start;
+  while (now - start < kBenchRuntimeTicks) {
+    uint64_t sector = gen.NextSector();
+    bool is_read = gen.NextIsRead();
+    uint64_t submitted_at = now;
+    auto status = is_read ? blk.Read(sector, g_bench_buf)
+                          : blk.Write(sector, g_bench_buf);
+    now = ReadTimeCounter();
+    result.latency.Record(now - submitted_at);
+    if (status.has_value()) {
+      ++result.ios;
+      result.bytes += profile.block_size;
+    } else {
+      ++result.errors;
+    }
+    ++result.reaps;
+  }
+  result.cycles = ReadCycleCounter() - start_cycles;
+  result.elapsed = now - start;
+  result.kicks_elided = blk.GetStats().kicks_elided - elided_before;
+  return result;
+}
+
+/**
+ * @brief BlockDevice 路径：ReadBlocks/WriteBlocks 每次传输 block_size 字节
+ */
+auto RunBlkDev(BlkDeviceType& dev, const BenchProfile& profile,
+               uint64_t working_set_sectors) -> BenchResult {
+  BenchResult result;
+  OffsetGenerator gen(profile, working_set_sectors);
+  const size_t block_size = dev.GetBlockSize();
+  const size_t blocks_per_io = profile.block_size / block_size;
+  const uint64_t sectors_per_block = block_size / kSectorSize;
+  std::span<uint8_t> buffer(g_bench_buf, profile.block_size);
+
+  uint64_t elided_before = dev.GetDriver().GetStats().kicks_elided;
+  uint64_t start = ReadTimeCounter();
+  uint64_t start_cycles = ReadCycleCounter();
+  uint64_t now = start;
+  while (now - start < kBenchRuntimeTicks) {
+    uint64_t block_no = gen.NextSector() / sectors_per_block;
+    bool is_read = gen.NextIsRead();
+    uint64_t submitted_at = now;
+    auto done = is_read ? dev.ReadBlocks(block_no, buffer, blocks_per_io)
+                        : dev.WriteBlocks(block_no, buffer, blocks_per_io);
+    now = ReadTimeCounter();
+    result.latency.Record(now - submitted_at);
+    if (done.has_value() && *done == blocks_per_io) {
+      ++result.ios;
+      result.bytes += profile.block_size;
+    } else {
+      ++result.errors;
+    }
+    ++result.reaps;
+  }
+  result.cycles = ReadCycleCounter() - start_cycles;
+  result.elapsed = now - start;
+  result.kicks_elided =
+      dev.GetDriver().GetStats().kicks_elided - elided_before;
+  return result;
+}
+
+/// @brief 工作集扇区数：min(设备容量, kMaxWorkingSetSectors)
+auto WorkingSetSectors(uint64_t capacity) -> uint64_t {
+  return capacity < kMaxWorkingSetSectors ? capacity : kMaxWorkingSetSectors;
+}
+
+}  // namespace
+
+void bench_virtio_blk() {
+  uint64_t blk_base = FindBlkDevice();
+  if (blk_base == 0) {
+    uart_puts("No VirtIO block device found\n");
+    return;
+  }
+
+  {
+    Memzero(g_bench_dma, sizeof(g_bench_dma));
+    auto blk_result = BlkType::Create(blk_base, g_bench_dma, 1, kQueueSize);
+    if (!blk_result.has_value()) {
+      uart_puts("VirtioBlk::Create() failed\n");
+      return;
+    }
+    auto& blk = *blk_result;
+    uint64_t working_set = WorkingSetSectors(blk.GetCapacity());
+    uart_printf("Working set: %llu sectors, runtime: %llu ms per job\n\n",
+                working_set, kBenchRuntimeTicks * 1000 / kTimebaseFrequency);
+
+    bench_print_header();
+    for (const auto& profile : kAsyncProfiles) {
+      bench_print_row("async", profile, RunAsync(blk, profile, working_set));
+    }
+    for (const auto& profile : kSyncProfiles) {
+      bench_print_row("sync", profile, RunSync(blk, profile, working_set));
+    }
+  }
+
+  Memzero(g_bench_dma, sizeof(g_bench_dma));
+  auto dev_result = BlkDeviceType::Create(blk_base, g_bench_dma, 1, kQueueSize);
+  if (!dev_result.has_value()) {
+    uart_puts("VirtioBlkDevice::Create() failed\n");
+    return;
+  }
+  auto& dev = *dev_result;
+  if (!dev.OpenReadWrite().has_value()) {
+    uart_puts("VirtioBlkDevice::OpenReadWrite() failed\n");
+    return;
+  }
+  uint64_t working_set = WorkingSetSectors(dev.GetCapacity() / kSectorSize);
+  for (const auto& profile : kBlkDevProfiles) {
+    if (profile.block_size % dev.GetBlockSize() != 0) {
+      continue;
+    }
+    bench_print_row("blkdev", profile, RunBlkDev(dev, profile, working_set));
+  }
+}
@@ -0,0 +1,42 @@
+/**
+ * @file main.cpp
+ * @brief 基准测试主入口
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#include <cstdint>
+
+#include "bench.h"
+#include "uart.h"
+
+/**
+ * @brief 基准测试入口
+ *
+ * 不初始化 PLIC：设备中断不送达，完成全部由轮询回收。
+ */
+void bench_main(uint32_t hart_id, uint8_t* dtb) {
+  (void)hart_id;
+  (void)dtb;
+
+  uart_init();
+
+  uart_puts("\n");
+  uart_puts(
+      "================================================================\n");
+  uart_puts("  device_framework Block I/O Benchmark\n");
+  uart_puts(
+      "================================================================\n");
+
+  bench_virtio_blk();
+
+  uart_puts(
+      "================================================================\n");
+}
+
+extern "C" void _start(uint32_t hart_id, uint8_t* dtb) {
+  bench_main(hart_id, dtb);
+
+  while (true) {
+    asm volatile("wfi");
+  }
+}
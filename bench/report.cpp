@@ -0,0 +1,115 @@
+/**
+ * @file report.cpp
+ * @brief 基准测试结果表输出
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bench.h"
+#include "uart.h"
+
+namespace {
+
+/// 每秒的 0.1us 数（延迟以 0.1us 为单位输出）
+constexpr uint64_t kTicksToTenthUs = 10000000;
+
+/**
+ * @brief 左对齐输出字符串并以空格补足宽度
+ */
+void PutLeft(const char* str, size_t width) {
+  size_t len = 0;
+  while (str[len] != '\0') {
+    uart_putc(str[len++]);
+  }
+  for (; len < width; ++len) {
+    uart_putc(' ');
+  }
+}
+
+/**
+ * @brief 右对齐输出字符串
+ */
+void PutRight(const char* str, size_t len, size_t width) {
+  for (size_t i = len; i < width; ++i) {
+    uart_putc(' ');
+  }
+  for (size_t i = 0; i < len; ++i) {
+    uart_putc(str[i]);
+  }
+}
+
+/**
+ * @brief 右对齐输出十进制数，tenths 为 true 时 value 以 0.1 为单位
+ */
+void PutNumber(uint64_t value, size_t width, bool tenths = false) {
+  char buf[24];
+  size_t pos = sizeof(buf);
+  if (tenths) {
+    buf[--pos] = static_cast<char>('0' + value % 10);
+    buf[--pos] = '.';
+    value /= 10;
+  }
+  do {
+    buf[--pos] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  PutRight(buf + pos, sizeof(buf) - pos, width);
+}
+
+/**
+ * @brief 输出请求大小（1024 的整数倍以 K 为单位）
+ */
+void PutSize(size_t bytes, size_t width) {
+  char buf[24];
+  size_t pos = sizeof(buf);
+  if (bytes % 1024 == 0) {
+    buf[--pos] = 'K';
+    bytes /= 1024;
+  }
+  do {
+    buf[--pos] = static_cast<char>('0' + bytes % 10);
+    bytes /= 10;
+  } while (bytes != 0);
+  PutRight(buf + pos, sizeof(buf) - pos, width);
+}
+
+/// @brief rdtime 计数换算为 0.1us
+auto ToTenthUs(uint64_t ticks) -> uint64_t {
+  return ticks * kTicksToTenthUs / kTimebaseFrequency;
+}
+
+}  // namespace
+
+void bench_print_header() {
+  uart_puts(
+      "engine  profile     bs    qd  rd%    IOPS     MB/s   avg_us   p99_us"
+      "   max_us  cyc/IO  batch  elided\n");
+}
+
+void bench_print_row(const char* engine, const BenchProfile& profile,
+                     const BenchResult& result) {
+  PutLeft(engine, 8);
+  PutLeft(profile.name, 9);
+  PutSize(profile.block_size, 5);
+  PutNumber(profile.queue_depth, 6);
+  PutNumber(profile.read_percent, 5);
+
+  uint64_t elapsed = result.elapsed != 0 ? result.elapsed : 1;
+  uint64_t ios = result.ios != 0 ? result.ios : 1;
+  PutNumber(result.ios * kTimebaseFrequency / elapsed, 8);
+  PutNumber(result.bytes * 10 * kTimebaseFrequency / elapsed / 1000000, 9,
+            true);
+  PutNumber(ToTenthUs(result.latency.sum / ios), 9, true);
+  PutNumber(ToTenthUs(result.latency.Percentile(990)), 9, true);
+  PutNumber(ToTenthUs(result.latency.max), 9, true);
+  PutNumber(result.cycles / ios, 8);
+  PutNumber(result.reaps != 0 ? result.ios * 10 / result.reaps : 0, 7, true);
+  PutNumber(result.kicks_elided, 8);
+  if (result.errors != 0) {
+    uart_puts("  errors=");
+    uart_put_dec(result.errors);
+  }
+  uart_putc('\n');
+}
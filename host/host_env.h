@@ -0,0 +1,58 @@
+/**
+ * @file host_env.h
+ * @brief 宿主机测试环境：平台 Traits 与测试套件声明
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_HOST_HOST_ENV_H_
+#define DEVICE_FRAMEWORK_HOST_HOST_ENV_H_
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+
+#include "uart.h"
+
+/**
+ * @brief 宿主机平台 Traits 实现
+ *
+ * 满足 EnvironmentTraits + BarrierTraits + DmaTraits（VirtioTraits）。
+ * DMA 地址即进程虚拟地址，VirtioBlkModel 按此解释描述符地址。
+ */
+struct HostTraits {
+  static auto Log(const char* fmt, ...) -> int {
+    uart_puts("  ");
+    va_list ap;
+    va_start(ap, fmt);
+    int ret = uart_vprintf(fmt, ap);
+    va_end(ap);
+    uart_puts("\n");
+    return ret;
+  }
+
+  static auto Mb() -> void {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+  static auto Rmb() -> void {
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  static auto Wmb() -> void {
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  static auto VirtToPhys(void* p) -> uintptr_t {
+    return reinterpret_cast<uintptr_t>(p);
+  }
+  static auto PhysToVirt(uintptr_t a) -> void* {
+    return reinterpret_cast<void*>(a);
+  }
+};
+
+/// @name 测试套件声明
+/// @{
+void test_host_virtio_blk();
+void test_host_trace();
+void test_host_mmio_accessor();
+/// @}
+
+#endif /* DEVICE_FRAMEWORK_HOST_HOST_ENV_H_ */
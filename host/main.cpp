@@ -0,0 +1,19 @@
+/**
+ * @file main.cpp
+ * @brief 宿主机测试主入口
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#include "host_env.h"
+#include "test.h"
+
+auto main() -> int {
+  test_print_banner();
+
+  test_host_virtio_blk();
+  test_host_trace();
+  test_host_mmio_accessor();
+
+  test_print_summary();
+  return g_global_stats.failed == 0 ? 0 : 1;
+}
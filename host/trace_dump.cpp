@@ -0,0 +1,84 @@
+/**
+ * @file trace_dump.cpp
+ * @brief 跟踪环内存转储解码工具
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 用法：trace_dump <dump-file>...
+ *
+ * 转储文件为一个或多个 TraceRing 对象的原始内存（如 QEMU monitor 的
+ * pmemsave、gdb 的 dump binary memory），按 CPU 输出每条记录的时间戳、
+ * 与上一条记录的间隔、事件名、队列、描述符链头与长度。
+ */
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "device_framework/trace.hpp"
+
+namespace {
+
+auto ReadFile(const char* path, std::vector<uint64_t>& storage) -> size_t {
+  std::FILE* file = std::fopen(path, "rb");
+  if (file == nullptr) {
+    return 0;
+  }
+  std::vector<uint8_t> bytes;
+  uint8_t chunk[4096];
+  size_t n;
+  while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    bytes.insert(bytes.end(), chunk, chunk + n);
+  }
+  std::fclose(file);
+  // 以 uint64_t 存储保证记录按 8 字节对齐
+  storage.assign((bytes.size() + 7) / 8, 0);
+  std::memcpy(storage.data(), bytes.data(), bytes.size());
+  return bytes.size();
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <dump-file>...\n", argv[0]);
+    return 2;
+  }
+  int status = 0;
+  for (int i = 1; i < argc; ++i) {
+    std::vector<uint64_t> storage;
+    size_t size = ReadFile(argv[i], storage);
+    std::span<const uint8_t> image(
+        reinterpret_cast<const uint8_t*>(storage.data()), size);
+
+    int last_cpu = -1;
+    uint64_t last_sequence = 0;
+    uint64_t last_ts = 0;
+    size_t rings = device_framework::DecodeTraceImage(
+        image, [&](const device_framework::TraceRingHeader& ring,
+                   const device_framework::TraceRecord& record) {
+          // 序号在同一个环内严格递增，回退说明进入了下一个环
+          if (ring.cpu != last_cpu || record.sequence <= last_sequence) {
+            std::printf("# cpu %u: capacity %u, %" PRIu64 " written\n",
+                        ring.cpu, ring.capacity, ring.head);
+            std::printf("%20s %12s  %-12s %5s %5s %10s\n", "timestamp",
+                        "delta", "event", "queue", "head", "len");
+            last_cpu = ring.cpu;
+            last_ts = record.timestamp;
+          }
+          std::printf("%20" PRIu64 " %12" PRIu64 "  %-12s %5u %5u %10u\n",
+                      record.timestamp, record.timestamp - last_ts,
+                      device_framework::TraceEventName(record.event),
+                      record.queue, record.head, record.len);
+          last_sequence = record.sequence;
+          last_ts = record.timestamp;
+        });
+    if (rings == 0) {
+      std::fprintf(stderr, "%s: no trace ring found\n", argv[i]);
+      status = 1;
+    }
+  }
+  return status;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file trace_test.cpp
+ * @brief 热路径跟踪环测试
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 测试内容：
+ * 1. TraceRing 按写入顺序遍历与覆盖语义
+ * 2. DecodeTraceImage 解码拼接的多个环
+ * 3. 写入序号越过 2^32 后仍按顺序解码
+ * 4. VirtioBlk 跟踪点的事件序列（enqueue → kick → irq → used-pop →
+ *    complete）
+ * 5. 未满足 TraceTraits 时跟踪点编译期消除
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "device_framework/trace.hpp"
+#include "device_framework/virtio_blk.hpp"
+#include "host_env.h"
+#include "test.h"
+#include "virtio_blk_model.hpp"
+
+namespace {
+
+using device_framework::TraceEvent;
+using device_framework::TraceRecord;
+using device_framework::TraceRingHeader;
+using device_framework::host::HostMmioTransport;
+using device_framework::host::VirtioBlkModel;
+
+/**
+ * @brief 开启跟踪的宿主机 Traits（单 CPU，时间戳为递增计数）
+ */
+struct TracingHostTraits : HostTraits {
+  static inline uint64_t clock = 0;
+  static auto Now() -> uint64_t { return ++clock; }
+  static auto GetTraceRing() -> device_framework::TraceRing<64>& {
+    static device_framework::TraceRing<64> ring;
+    return ring;
+  }
+};
+
+static_assert(device_framework::TraceTraits<TracingHostTraits>);
+static_assert(!device_framework::TraceTraits<HostTraits>);
+
+alignas(4096) uint8_t g_trace_dma[1 << 16];
+alignas(4096) uint8_t g_trace_data[512];
+
+}  // namespace
+
+void test_host_trace() {
+  TEST_SUITE_BEGIN("Host Trace Ring");
+
+  // === 测试 1: 顺序与覆盖 ===
+  {
+    device_framework::TraceRing<8> ring(3);
+    for (uint32_t i = 0; i < 20; ++i) {
+      ring.Record(TraceEvent::kEnqueue, 1, static_cast<uint16_t>(i), i * 10,
+                  100 + i);
+    }
+    EXPECT_EQ(20u, ring.Written(), "Written() counts all records");
+    EXPECT_EQ(12u, ring.Overwritten(), "Oldest 12 records overwritten");
+    uint32_t expected = 12;
+    bool ordered = true;
+    size_t visited = ring.ForEach([&](const TraceRecord& record) {
+      ordered = ordered && record.head == expected &&
+                record.len == expected * 10 &&
+                record.timestamp == 100 + expected;
+      ++expected;
+    });
+    EXPECT_EQ(static_cast<size_t>(8), visited, "ForEach visits capacity");
+    EXPECT_TRUE(ordered, "Records visited oldest to newest");
+  }
+
+  // === 测试 2: 解码内存转储 ===
+  {
+    static device_framework::TraceRing<4> cpu0(0);
+    static device_framework::TraceRing<4> cpu1(1);
+    cpu0.Record(TraceEvent::kKickNotify, 0, 5, 2, 1);
+    cpu1.Record(TraceEvent::kUsedPop, 0, 7, 512, 2);
+    cpu1.Record(TraceEvent::kComplete, 0, 7, 0, 3);
+    alignas(8) uint8_t image[2 * sizeof(cpu0)];
+    std::memcpy(image, &cpu0, sizeof(cpu0));
+    std::memcpy(image + sizeof(cpu0), &cpu1, sizeof(cpu1));
+    size_t records[2] = {};
+    size_t rings = device_framework::DecodeTraceImage(
+        image, [&](const TraceRingHeader& ring, const TraceRecord&) {
+          ++records[ring.cpu & 1];
+        });
+    EXPECT_EQ(static_cast<size_t>(2), rings, "Two rings decoded");
+    EXPECT_TRUE(records[0] == 1 && records[1] == 2, "Records per CPU");
+  }
+
+  // === 测试 3: 写入序号超过 32 位 ===
+  {
+    // 构造 head 已越过 2^32 的转储：最旧的保留记录序号在 2^32 之前
+    constexpr uint32_t kCapacity = 4;
+    constexpr uint64_t kHead = (uint64_t{1} << 32) + 2;
+    struct {
+      TraceRingHeader header;
+      TraceRecord records[kCapacity];
+    } dump{};
+    dump.header = {device_framework::kTraceMagic, sizeof(TraceRecord), 2,
+                   kCapacity, 0, kHead};
+    for (uint64_t seq = kHead - kCapacity; seq != kHead; ++seq) {
+      auto& slot = dump.records[seq & (kCapacity - 1)];
+      slot.sequence = seq + 1;
+      slot.timestamp = seq;
+    }
+    uint64_t expected = kHead - kCapacity;
+    bool ordered = true;
+    device_framework::DecodeTraceImage(
+        {reinterpret_cast<const uint8_t*>(&dump), sizeof(dump)},
+        [&](const TraceRingHeader&, const TraceRecord& record) {
+          ordered = ordered && record.timestamp == expected;
+          ++expected;
+        });
+    EXPECT_TRUE(ordered && expected == kHead,
+                "Records across 2^32 decoded oldest to newest");
+  }
+
+  // === 测试 4: VirtioBlk 跟踪点 ===
+  {
+    using Blk = device_framework::virtio::blk::VirtioBlk<TracingHostTraits,
+                                                         HostMmioTransport>;
+    VirtioBlkModel model(64);
+    std::memset(g_trace_dma, 0, sizeof(g_trace_dma));
+    auto blk_result = Blk::Create(model.base(), g_trace_dma, 1, 64);
+    EXPECT_TRUE(blk_result.has_value(), "Create() with tracing traits");
+    if (blk_result.has_value()) {
+      auto& blk = *blk_result;
+      auto& ring = TracingHostTraits::GetTraceRing();
+      ring.Reset();
+
+      device_framework::virtio::IoVec iov{
+          HostTraits::VirtToPhys(g_trace_data), sizeof(g_trace_data)};
+      EXPECT_TRUE(blk.EnqueueWrite(0, 3, &iov, 1).has_value(),
+                  "EnqueueWrite()");
+      blk.Kick(0);
+      bool done = false;
+      blk.HandleInterrupt(
+          [&done](void*, device_framework::ErrorCode) { done = true; });
+      EXPECT_TRUE(done, "Request completed");
+
+      constexpr TraceEvent kExpected[] = {
+          TraceEvent::kEnqueue, TraceEvent::kKickNotify,
+          TraceEvent::kInterrupt, TraceEvent::kUsedPop,
+          TraceEvent::kComplete};
+      size_t index = 0;
+      bool match = true;
+      uint16_t head = 0;
+      uint64_t last_ts = 0;
+      ring.ForEach([&](const TraceRecord& record) {
+        match = match && index < 5 &&
+                record.event == static_cast<uint16_t>(kExpected[index]) &&
+                record.timestamp > last_ts;
+        if (record.event == static_cast<uint16_t>(TraceEvent::kEnqueue)) {
+          head = record.head;
+          match = match && record.len == sizeof(g_trace_data);
+        } else if (record.event ==
+                   static_cast<uint16_t>(TraceEvent::kComplete)) {
+          match = match && record.head == head && record.len == 0;
+        }
+        last_ts = record.timestamp;
+        ++index;
+      });
+      EXPECT_EQ(static_cast<size_t>(5), index, "Five trace records");
+      EXPECT_TRUE(match, "enqueue/kick/irq/used-pop/complete in order");
+      device_framework::DumpTrace<HostTraits>(ring);
+    }
+  }
+
+  TEST_SUITE_END();
+}
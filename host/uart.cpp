@@ -0,0 +1,43 @@
+/**
+ * @file uart.cpp
+ * @brief 宿主机 uart.h 实现：输出到标准输出
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 使 test/ 中的测试框架（test.h / test.cpp）无需修改即可在宿主机运行。
+ */
+
+#include "uart.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+void uart_init() {}
+
+void uart_putc(char c) { std::fputc(c, stdout); }
+
+void uart_puts(const char *str) {
+  if (str == nullptr) {
+    return;
+  }
+  std::fputs(str, stdout);
+}
+
+void uart_put_hex(uint64_t num) { std::printf("0x%016" PRIx64, num); }
+
+void uart_put_dec(uint64_t num) { std::printf("%" PRIu64, num); }
+
+auto uart_printf(const char *format, ...) -> int {
+  va_list args;
+  va_start(args, format);
+  int count = uart_vprintf(format, args);
+  va_end(args);
+  return count;
+}
+
+auto uart_vprintf(const char *format, va_list args) -> int {
+  return std::vprintf(format, args);
+}
+
+auto uart_getc() -> int { return -1; }
+
+void uart_handle_interrupt() {}
@@ -0,0 +1,701 @@
+/**
+ * @file virtio_blk_model.hpp
+ * @brief 宿主机软件 virtio-blk 设备模型（virtio-mmio 寄存器接口）
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_HOST_VIRTIO_BLK_MODEL_HPP_
+#define DEVICE_FRAMEWORK_HOST_VIRTIO_BLK_MODEL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "device_framework/detail/virtio/defs.h"
+#include "device_framework/detail/virtio/device/virtio_blk_defs.h"
+#include "device_framework/detail/virtio/transport/mmio.hpp"
+#include "device_framework/detail/virtio/virt_queue/split.hpp"
+
+namespace device_framework::host {
+
+/**
+ * @brief 进程内 virtio-blk 设备（Modern virtio-mmio，split virtqueue）
+ *
+ * 以函数调用实现 virtio-mmio 寄存器组（magic/version/特性/队列/状态/
+ * 中断/配置空间），磁盘内容保存在宿主机内存中。驱动写 QueueNotify 时
+ * 模型在调用线程上同步处理 avail ring 中的全部请求并更新 used ring，
+ * 因此设备侧延迟为零，profiler 看到的是驱动自身的 CPU 开销。
+ *
+ * 描述符中的地址按宿主机虚拟地址解释（需配合恒等映射的
+ * VirtToPhys/PhysToVirt）。支持间接描述符与 VIRTIO_F_EVENT_IDX：
+ * 每次取走请求后写回 avail_event，并按 used_event 判断是否需要中断。
+ * 提供 VIRTIO_BLK_F_WRITE_ZEROES 时按请求中的范围把扇区清零。
+ *
+ * 担任 MmioTransport 的访问器时，寄存器访问经 ModelAccessor 转发到
+ * Read()/Write()，驱动与传输层代码与裸机构建完全相同：
+ * @code
+ * VirtioBlkModel model(2048);
+ * auto blk = VirtioBlk<HostTraits, HostMmioTransport>::Create(
+ *     model.base(), dma_buf);
+ * @endcode
+ *
+ * @note 不支持 packed virtqueue（不提供 VIRTIO_F_RING_PACKED）
+ * @see virtio-v1.2#4.2.2 MMIO Device Register Layout
+ * @see virtio-v1.2#5.2 Block Device
+ */
+class VirtioBlkModel {
+ public:
+  /// 每个队列的最大描述符数
+  static constexpr uint32_t kQueueNumMax = 1024;
+  /// 支持的最大队列数
+  static constexpr uint16_t kMaxQueues = 8;
+  /// 默认提供的特性位
+  static constexpr uint64_t kDefaultFeatures =
+      static_cast<uint64_t>(detail::virtio::ReservedFeature::kVersion1) |
+      static_cast<uint64_t>(detail::virtio::ReservedFeature::kIndirectDesc) |
+      static_cast<uint64_t>(detail::virtio::ReservedFeature::kEventIdx) |
+      static_cast<uint64_t>(detail::virtio::blk::BlkFeatureBit::kSizeMax) |
+      static_cast<uint64_t>(detail::virtio::blk::BlkFeatureBit::kSegMax) |
+      static_cast<uint64_t>(detail::virtio::blk::BlkFeatureBit::kBlkSize) |
+      static_cast<uint64_t>(detail::virtio::blk::BlkFeatureBit::kFlush) |
+      static_cast<uint64_t>(detail::virtio::blk::BlkFeatureBit::kMq);
+  /// 模型的 virtio-mmio Vendor ID（"HOST"）
+  static constexpr uint32_t kVendorId = 0x54534F48;
+
+  /**
+   * @brief 设备侧统计
+   */
+  struct Stats {
+    /// QueueNotify 写入次数
+    uint64_t notifies = 0;
+    /// 处理的请求数
+    uint64_t requests = 0;
+    /// 读出的数据字节数
+    uint64_t bytes_read = 0;
+    /// 写入的数据字节数
+    uint64_t bytes_written = 0;
+    /// 按通知抑制规则需要发出的中断数
+    uint64_t interrupts = 0;
+    /// 以 IOERR/UNSUPP 完成的请求数
+    uint64_t errors = 0;
+    /// 寄存器写入次数（不含 QueueNotify）
+    uint64_t register_writes = 0;
+  };
+
+  /**
+   * @brief 构造函数
+   * @param capacity 磁盘容量（512 字节扇区数）
+   * @param num_queues 提供的请求队列数（1 ~ kMaxQueues）
+   * @param features 提供的特性位
+   */
+  explicit VirtioBlkModel(uint64_t capacity, uint16_t num_queues = 1,
+                          uint64_t features = kDefaultFeatures)
+      : disk_(capacity * kSectorSize),
+        features_(features),
+        num_queues_(num_queues == 0            ? 1
+                    : num_queues > kMaxQueues ? kMaxQueues
+                                              : num_queues) {
+    config_.capacity = capacity;
+    config_.size_max = 128 * 1024;
+    config_.seg_max = 126;
+    config_.blk_size = kSectorSize;
+    config_.num_queues = num_queues_;
+    config_.max_write_zeroes_sectors = 1024;
+    config_.max_write_zeroes_seg = 8;
+  }
+
+  /// @brief MmioTransport 构造参数（模型对象地址）
+  [[nodiscard]] auto base() -> uint64_t {
+    return reinterpret_cast<uint64_t>(this);
+  }
+
+  /// @brief 磁盘内容
+  [[nodiscard]] auto Disk() -> std::span<uint8_t> { return disk_; }
+
+  /// @brief 设备配置空间（测试可在 Create() 前调整 size_max 等字段）
+  [[nodiscard]] auto Config() -> detail::virtio::blk::BlkConfig& {
+    return config_;
+  }
+
+  /**
+   * @brief 修改容量并发出配置变更中断
+   *
+   * @param capacity 新容量（扇区数，不超过构造时的容量）
+   */
+  auto ChangeCapacity(uint64_t capacity) -> void {
+    std::lock_guard guard(lock_);
+    config_.capacity = capacity;
+    config_generation_.fetch_add(1, std::memory_order_release);
+    interrupt_status_ |=
+        static_cast<uint32_t>(detail::virtio::InterruptStatus::kConfigChange);
+  }
+
+  /**
+   * @brief 模拟设备内部错误：设置 DEVICE_NEEDS_RESET 并停止处理请求
+   *
+   * 之后的 QueueNotify 被忽略，直到驱动复位设备。
+   */
+  auto InjectNeedsReset() -> void {
+    std::lock_guard guard(lock_);
+    status_ |= detail::virtio::Transport<>::kDeviceNeedsReset;
+    interrupt_status_ |=
+        static_cast<uint32_t>(detail::virtio::InterruptStatus::kConfigChange);
+  }
+
+  /**
+   * @brief 模拟设备停顿：之后提交的请求留在 Available Ring 中不被处理
+   *
+   * 用于测试驱动的超时路径。Unstall() 恢复处理并立即处理积压的请求。
+   */
+  auto Stall() -> void {
+    std::lock_guard guard(lock_);
+    stalled_ = true;
+  }
+
+  /// @brief 解除 Stall() 并处理全部队列中积压的请求
+  auto Unstall() -> void {
+    {
+      std::lock_guard guard(lock_);
+      stalled_ = false;
+    }
+    for (uint32_t i = 0; i < num_queues_; ++i) {
+      Process(i);
+    }
+  }
+
+  /// @brief 设备侧统计
+  [[nodiscard]] auto GetStats() const -> Stats {
+    std::lock_guard guard(lock_);
+    return stats_;
+  }
+
+  /// @brief 清零设备侧统计
+  auto ResetStats() -> void {
+    std::lock_guard guard(lock_);
+    stats_ = {};
+  }
+
+  /// @brief 驱动协商得到的特性位
+  [[nodiscard]] auto GetDriverFeatures() const -> uint64_t {
+    return driver_features_;
+  }
+
+  /**
+   * @brief 读寄存器或配置空间
+   *
+   * @tparam T 访问宽度（寄存器区只支持 32 位访问）
+   * @param offset 相对于设备基地址的偏移
+   */
+  template <typename T>
+  [[nodiscard]] auto Read(size_t offset) -> T {
+    if (offset >= Reg::kConfig) {
+      T value{};
+      size_t off = offset - Reg::kConfig;
+      if (off + sizeof(T) <= sizeof(config_)) {
+        std::lock_guard guard(lock_);
+        std::memcpy(&value, reinterpret_cast<const uint8_t*>(&config_) + off,
+                    sizeof(T));
+      }
+      return value;
+    }
+    return static_cast<T>(ReadReg(offset));
+  }
+
+  /**
+   * @brief 写寄存器或配置空间
+   *
+   * 配置空间只有 writeback 字段可写，其余写入被忽略。
+   *
+   * @tparam T 访问宽度
+   * @param offset 相对于设备基地址的偏移
+   * @param value 写入值
+   */
+  template <typename T>
+  auto Write(size_t offset, T value) -> void {
+    if (offset >= Reg::kConfig) {
+      if (offset - Reg::kConfig ==
+          static_cast<size_t>(
+              detail::virtio::blk::BlkConfigOffset::kWriteback)) {
+        std::lock_guard guard(lock_);
+        config_.writeback = static_cast<uint8_t>(value);
+      }
+      return;
+    }
+    WriteReg(offset, static_cast<uint32_t>(value));
+  }
+
+  /// @name 构造/析构函数
+  /// @{
+  VirtioBlkModel(const VirtioBlkModel&) = delete;
+  VirtioBlkModel(VirtioBlkModel&&) = delete;
+  auto operator=(const VirtioBlkModel&) -> VirtioBlkModel& = delete;
+  auto operator=(VirtioBlkModel&&) -> VirtioBlkModel& = delete;
+  ~VirtioBlkModel() = default;
+  /// @}
+
+ private:
+  using Reg = detail::virtio::MmioTransport<>::MmioReg;
+  using Ring = detail::virtio::SplitVirtqueue<>;
+  using ReqType = detail::virtio::blk::ReqType;
+  using BlkStatus = detail::virtio::blk::BlkStatus;
+
+  /// 扇区大小
+  static constexpr size_t kSectorSize = 512;
+  /// GET_ID 返回的设备序列号（不含结尾 NUL）
+  static constexpr char kSerial[] = "host-virtio-blk";
+  /// 单个请求中的最大描述符数（含间接表）
+  static constexpr size_t kMaxSegments = kQueueNumMax;
+
+  /**
+   * @brief 设备侧队列状态
+   */
+  struct Queue {
+    uint32_t num = 0;
+    bool ready = false;
+    uint64_t desc = 0;
+    uint64_t driver = 0;
+    uint64_t device = 0;
+    /// 下一个待处理的 avail ring 位置
+    uint16_t last_avail = 0;
+    /// 下一个写入的 used ring 位置
+    uint16_t used_idx = 0;
+  };
+
+  /**
+   * @brief 请求中的一个缓冲区段
+   */
+  struct Segment {
+    uint8_t* addr;
+    uint32_t len;
+    bool writable;
+  };
+
+  [[nodiscard]] auto ReadReg(size_t offset) -> uint32_t {
+    std::lock_guard guard(lock_);
+    switch (offset) {
+      case Reg::kMagicValue:
+        return detail::virtio::kMmioMagicValue;
+      case Reg::kVersion:
+        return detail::virtio::kMmioVersionModern;
+      case Reg::kDeviceId:
+        return static_cast<uint32_t>(detail::virtio::DeviceId::kBlock);
+      case Reg::kVendorId:
+        return kVendorId;
+      case Reg::kDeviceFeatures:
+        return device_features_sel_ == 0
+                   ? static_cast<uint32_t>(features_)
+                   : device_features_sel_ == 1
+                         ? static_cast<uint32_t>(features_ >> 32)
+                         : 0;
+      case Reg::kQueueNumMax:
+        return queue_sel_ < num_queues_ ? kQueueNumMax : 0;
+      case Reg::kQueueReady:
+        return queue_sel_ < num_queues_ && queues_[queue_sel_].ready ? 1 : 0;
+      case Reg::kInterruptStatus:
+        return interrupt_status_;
+      case Reg::kStatus:
+        return status_;
+      case Reg::kConfigGeneration:
+        return config_generation_.load(std::memory_order_acquire);
+      default:
+        return 0;
+    }
+  }
+
+  auto WriteReg(size_t offset, uint32_t value) -> void {
+    if (offset == Reg::kQueueNotify) {
+      // 低 16 位为队列号（VIRTIO_F_NOTIFICATION_DATA 时高位携带数据）
+      Process(value & 0xFFFF);
+      return;
+    }
+    std::lock_guard guard(lock_);
+    ++stats_.register_writes;
+    Queue* queue = queue_sel_ < num_queues_ ? &queues_[queue_sel_] : nullptr;
+    switch (offset) {
+      case Reg::kDeviceFeaturesSel:
+        device_features_sel_ = value;
+        break;
+      case Reg::kDriverFeatures:
+        if (driver_features_sel_ == 0) {
+          driver_features_ =
+              (driver_features_ & ~uint64_t{0xFFFFFFFF}) | value;
+        } else if (driver_features_sel_ == 1) {
+          driver_features_ = (driver_features_ & uint64_t{0xFFFFFFFF}) |
+                             (static_cast<uint64_t>(value) << 32);
+        }
+        break;
+      case Reg::kDriverFeaturesSel:
+        driver_features_sel_ = value;
+        break;
+      case Reg::kQueueSel:
+        queue_sel_ = value;
+        break;
+      case Reg::kInterruptAck:
+        interrupt_status_ &= ~value;
+        break;
+      case Reg::kStatus:
+        WriteStatus(value);
+        break;
+      default:
+        if (queue != nullptr) {
+          WriteQueueReg(*queue, offset, value);
+        }
+        break;
+    }
+  }
+
+  /// 写队列配置寄存器（调用者持有 lock_）
+  static auto WriteQueueReg(Queue& queue, size_t offset, uint32_t value)
+      -> void {
+    auto set_lo = [value](uint64_t& addr) {
+      addr = (addr & ~uint64_t{0xFFFFFFFF}) | value;
+    };
+    auto set_hi = [value](uint64_t& addr) {
+      addr = (addr & uint64_t{0xFFFFFFFF}) |
+             (static_cast<uint64_t>(value) << 32);
+    };
+    switch (offset) {
+      case Reg::kQueueNum:
+        queue.num = value <= kQueueNumMax ? value : 0;
+        break;
+      case Reg::kQueueReady:
+        queue.ready = value != 0;
+        break;
+      case Reg::kQueueDescLow:
+        set_lo(queue.desc);
+        break;
+      case Reg::kQueueDescHigh:
+        set_hi(queue.desc);
+        break;
+      case Reg::kQueueDriverLow:
+        set_lo(queue.driver);
+        break;
+      case Reg::kQueueDriverHigh:
+        set_hi(queue.driver);
+        break;
+      case Reg::kQueueDeviceLow:
+        set_lo(queue.device);
+        break;
+      case Reg::kQueueDeviceHigh:
+        set_hi(queue.device);
+        break;
+      default:
+        break;
+    }
+  }
+
+  /**
+   * @brief 写设备状态（调用者持有 lock_）
+   *
+   * 写 0 复位设备；设置 FEATURES_OK 时若驱动特性不是设备特性的子集，
+   * 设备不保留该位（驱动读回后判定协商失败）。
+   */
+  auto WriteStatus(uint32_t value) -> void {
+    using Status = detail::virtio::Transport<>::DeviceStatus;
+    if (value == Status::kReset) {
+      status_ = 0;
+      interrupt_status_ = 0;
+      driver_features_ = 0;
+      for (auto& queue : queues_) {
+        queue = Queue{};
+      }
+      return;
+    }
+    if ((value & Status::kFeaturesOk) != 0 &&
+        (driver_features_ & ~features_) != 0) {
+      value &= ~static_cast<uint32_t>(Status::kFeaturesOk);
+    }
+    status_ = value;
+  }
+
+  /**
+   * @brief 处理队列中所有新提交的请求
+   *
+   * @param queue_idx 队列号
+   */
+  auto Process(uint32_t queue_idx) -> void {
+    using Status = detail::virtio::Transport<>::DeviceStatus;
+    std::lock_guard guard(lock_);
+    ++stats_.notifies;
+    if (queue_idx >= num_queues_ || (status_ & Status::kDriverOk) == 0 ||
+        (status_ & Status::kDeviceNeedsReset) != 0 || stalled_) {
+      return;
+    }
+    Queue& queue = queues_[queue_idx];
+    if (!queue.ready || queue.num == 0) {
+      return;
+    }
+    auto* avail = reinterpret_cast<volatile Ring::Avail*>(queue.driver);
+    auto* used = reinterpret_cast<volatile Ring::Used*>(queue.device);
+    bool event_idx =
+        (driver_features_ &
+         static_cast<uint64_t>(detail::virtio::ReservedFeature::kEventIdx)) !=
+        0;
+    auto num = static_cast<uint16_t>(queue.num);
+
+    uint16_t old_used = queue.used_idx;
+    while (true) {
+      uint16_t avail_idx = avail->idx;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (queue.last_avail == avail_idx) {
+        break;
+      }
+      while (queue.last_avail != avail_idx) {
+        uint16_t head = avail->ring[queue.last_avail % num];
+        ++queue.last_avail;
+        uint32_t written = Service(queue, head);
+        volatile auto& elem = used->ring[queue.used_idx % num];
+        elem.id = head;
+        elem.len = written;
+        ++queue.used_idx;
+      }
+      std::atomic_thread_fence(std::memory_order_release);
+      used->idx = queue.used_idx;
+      if (event_idx) {
+        // 驱动在写 avail_event 之后提交的请求会再次通知
+        *used->avail_event(num) = queue.last_avail;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+      } else {
+        break;
+      }
+    }
+
+    if (queue.used_idx == old_used) {
+      return;
+    }
+    bool need_interrupt;
+    if (event_idx) {
+      uint16_t used_event = *avail->used_event(num);
+      need_interrupt = static_cast<uint16_t>(queue.used_idx - used_event - 1) <
+                       static_cast<uint16_t>(queue.used_idx - old_used);
+    } else {
+      need_interrupt = (avail->flags & Ring::kAvailFNoInterrupt) == 0;
+    }
+    if (need_interrupt) {
+      ++stats_.interrupts;
+      interrupt_status_ |=
+          static_cast<uint32_t>(detail::virtio::InterruptStatus::kUsedBuffer);
+    }
+  }
+
+  /**
+   * @brief 收集描述符链（展开间接描述符表）
+   *
+   * @return 段数；描述符链非法时返回 0
+   */
+  auto Gather(const Queue& queue, uint16_t head) -> size_t {
+    const auto* table = reinterpret_cast<const Ring::Desc*>(queue.desc);
+    size_t count = 0;
+    uint16_t idx = head;
+    for (uint32_t hops = 0; hops < queue.num; ++hops) {
+      const Ring::Desc& desc = table[idx % queue.num];
+      if ((desc.flags & Ring::kDescFIndirect) != 0) {
+        const auto* indirect = reinterpret_cast<const Ring::Desc*>(desc.addr);
+        size_t entries = desc.len / sizeof(Ring::Desc);
+        for (size_t i = 0; i < entries && count < kMaxSegments; ++i) {
+          segments_[count++] = {reinterpret_cast<uint8_t*>(indirect[i].addr),
+                                indirect[i].len,
+                                (indirect[i].flags & Ring::kDescFWrite) != 0};
+        }
+        return count;
+      }
+      if (count == kMaxSegments) {
+        return 0;
+      }
+      segments_[count++] = {reinterpret_cast<uint8_t*>(desc.addr), desc.len,
+                            (desc.flags & Ring::kDescFWrite) != 0};
+      if ((desc.flags & Ring::kDescFNext) == 0) {
+        return count;
+      }
+      idx = desc.next;
+    }
+    return 0;
+  }
+
+  /**
+   * @brief 执行一个请求（header → 数据段 → status）
+   *
+   * @return 写入驱动缓冲区的字节数（used ring 中的 len）
+   */
+  auto Service(const Queue& queue, uint16_t head) -> uint32_t {
+    ++stats_.requests;
+    size_t count = Gather(queue, head);
+    if (count < 2 ||
+        segments_[0].len < sizeof(detail::virtio::blk::BlkReqHeader) ||
+        !segments_[count - 1].writable || segments_[count - 1].len == 0) {
+      ++stats_.errors;
+      return 0;
+    }
+    detail::virtio::blk::BlkReqHeader header;
+    std::memcpy(&header, segments_[0].addr, sizeof(header));
+    const Segment& status_seg = segments_[count - 1];
+    uint8_t* status = status_seg.addr + status_seg.len - 1;
+
+    // 数据段：header 与 status 之间的全部段（status 可与最后一个数据段同段）
+    std::span<const Segment> data(segments_ + 1, count - 2);
+    uint64_t bytes = 0;
+    for (const auto& seg : data) {
+      bytes += seg.len;
+    }
+    uint32_t written = 0;
+    auto result = BlkStatus::kOk;
+    switch (static_cast<ReqType>(header.type)) {
+      case ReqType::kIn:
+      case ReqType::kOut: {
+        uint64_t offset = header.sector * kSectorSize;
+        if (offset > disk_.size() || bytes > disk_.size() - offset ||
+            header.sector >= config_.capacity) {
+          result = BlkStatus::kIoErr;
+          break;
+        }
+        bool is_read = static_cast<ReqType>(header.type) == ReqType::kIn;
+        for (const auto& seg : data) {
+          if (is_read) {
+            std::memcpy(seg.addr, disk_.data() + offset, seg.len);
+            written += seg.len;
+          } else {
+            std::memcpy(disk_.data() + offset, seg.addr, seg.len);
+          }
+          offset += seg.len;
+        }
+        (is_read ? stats_.bytes_read : stats_.bytes_written) += bytes;
+        break;
+      }
+      case ReqType::kFlush:
+        break;
+      case ReqType::kWriteZeroes:
+        if ((driver_features_ &
+             static_cast<uint64_t>(
+                 detail::virtio::blk::BlkFeatureBit::kWriteZeroes)) == 0) {
+          result = BlkStatus::kUnsupp;
+          break;
+        }
+        result = ZeroRanges(data);
+        break;
+      case ReqType::kGetId:
+        if (!data.empty()) {
+          size_t len = data[0].len < sizeof(kSerial) ? data[0].len
+                                                     : sizeof(kSerial);
+          std::memcpy(data[0].addr, kSerial, len);
+          written += static_cast<uint32_t>(len);
+        }
+        break;
+      default:
+        result = BlkStatus::kUnsupp;
+        break;
+    }
+    if (result != BlkStatus::kOk) {
+      ++stats_.errors;
+    }
+    *status = static_cast<uint8_t>(result);
+    return written + 1;
+  }
+
+  /**
+   * @brief 执行 WRITE_ZEROES：按数据段中的范围数组清零扇区
+   *
+   * @param data header 与 status 之间的数据段（设备只读）
+   * @return 范围越界或格式错误时返回 IOERR
+   */
+  auto ZeroRanges(std::span<const Segment> data) -> BlkStatus {
+    using Range = detail::virtio::blk::BlkDiscardWriteZeroes;
+    for (const auto& seg : data) {
+      if (seg.writable || seg.len % sizeof(Range) != 0) {
+        return BlkStatus::kIoErr;
+      }
+      for (size_t off = 0; off < seg.len; off += sizeof(Range)) {
+        Range range;
+        std::memcpy(&range, seg.addr + off, sizeof(range));
+        if (range.sector > config_.capacity ||
+            range.num_sectors > config_.capacity - range.sector) {
+          return BlkStatus::kIoErr;
+        }
+        std::memset(disk_.data() + range.sector * kSectorSize, 0,
+                    static_cast<size_t>(range.num_sectors) * kSectorSize);
+        stats_.bytes_written +=
+            static_cast<uint64_t>(range.num_sectors) * kSectorSize;
+      }
+    }
+    return BlkStatus::kOk;
+  }
+
+  /// 保护寄存器状态、队列与统计（驱动可在多个线程上通知不同队列）
+  mutable std::mutex lock_;
+  /// 磁盘内容
+  std::vector<uint8_t> disk_;
+  /// 设备配置空间
+  detail::virtio::blk::BlkConfig config_{};
+  /// 配置空间代数
+  std::atomic<uint32_t> config_generation_{0};
+
+  /// 提供的特性位
+  uint64_t features_;
+  /// 驱动写入的特性位
+  uint64_t driver_features_ = 0;
+  uint32_t device_features_sel_ = 0;
+  uint32_t driver_features_sel_ = 0;
+  /// 提供的队列数
+  uint16_t num_queues_;
+  uint32_t queue_sel_ = 0;
+  Queue queues_[kMaxQueues]{};
+
+  /// 设备状态寄存器
+  uint32_t status_ = 0;
+  /// 中断状态寄存器
+  uint32_t interrupt_status_ = 0;
+  /// Stall() 后为 true：QueueNotify 不处理请求
+  bool stalled_ = false;
+
+  /// 当前请求的描述符段（处理请求时复用，避免分配）
+  Segment segments_[kMaxSegments]{};
+  /// 设备侧统计
+  Stats stats_{};
+};
+
+/**
+ * @brief 把寄存器访问转发到软件设备模型的访问器
+ *
+ * 接口与 MmioAccessor 相同，基地址即模型对象地址（Model::base()）。
+ *
+ * @tparam Model 设备模型类型（提供 Read<T>() / Write<T>()）
+ */
+template <class Model>
+class ModelAccessor {
+ public:
+  explicit ModelAccessor(uint64_t base = 0)
+      : model_(reinterpret_cast<Model*>(base)) {}
+
+  template <typename T>
+  [[nodiscard]] auto Read(size_t offset) const -> T {
+    return model_->template Read<T>(offset);
+  }
+
+  template <typename T>
+  auto Write(size_t offset, T val) const -> void {
+    model_->template Write<T>(offset, val);
+  }
+
+  [[nodiscard]] auto base() const -> uint64_t {
+    return reinterpret_cast<uint64_t>(model_);
+  }
+
+ private:
+  Model* model_;
+};
+
+/**
+ * @brief 连接 VirtioBlkModel 的 virtio-mmio 传输层
+ *
+ * 与裸机构建使用同一个 MmioTransport 实现，仅替换寄存器访问器。
+ */
+template <class Traits>
+using HostMmioTransport =
+    detail::virtio::MmioTransport<Traits, ModelAccessor<VirtioBlkModel>>;
+
+}  // namespace device_framework::host
+
+#endif /* DEVICE_FRAMEWORK_HOST_VIRTIO_BLK_MODEL_HPP_ */
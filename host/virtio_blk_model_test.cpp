@@ -0,0 +1,648 @@
+/**
+ * @file virtio_blk_model_test.cpp
+ * @brief 宿主机 virtio-blk 设备模型测试
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 测试内容：
+ * 1. VirtioBlk<HostTraits, HostMmioTransport>::Create() 与特性协商
+ * 2. 单扇区读写与磁盘内容一致
+ * 3. Flush / GetId
+ * 4. 越界请求以 IOERR 完成
+ * 5. VirtioBlkDevice 多块读写（多段请求）
+ * 6. 多队列与设备侧统计
+ * 7. Quiesce() 回收/取消在途请求，Resume() 在原有内存上快速恢复
+ * 8. GetResumeState() / Restore() 交接到新的驱动对象
+ * 9. 请求截止时间、Cancel() 与 WaitFor()，同步请求超时后保留请求槽
+ * 10. 同步 WRITE_ZEROES 超时后，设备稍后读取的范围数组仍然有效
+ * 11. VirtioBlkDevice 批量传输超时遗留的请求不影响之后的调用
+ * 12. 拆分的异步传输全部入队或全部不入队
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "device_framework/virtio_blk.hpp"
+#include "host_env.h"
+#include "test.h"
+#include "virtio_blk_model.hpp"
+
+namespace {
+
+using device_framework::host::HostMmioTransport;
+using device_framework::host::VirtioBlkModel;
+
+/// 模型磁盘容量（扇区）
+constexpr uint64_t kCapacity = 4096;
+/// 扇区大小
+constexpr size_t kSectorSize = 512;
+/// 多块读写的块数
+constexpr size_t kBlocks = 64;
+
+alignas(4096) uint8_t g_dma[1 << 20];
+alignas(4096) uint8_t g_data[kBlocks * kSectorSize];
+alignas(4096) uint8_t g_readback[kBlocks * kSectorSize];
+
+/**
+ * @brief 提供手动时钟与 Yield() 的宿主机 Traits
+ *
+ * 每次 Yield() 让时钟前进一拍，同步等待因此能在有限步内到达截止时间。
+ */
+struct ClockHostTraits : HostTraits {
+  static constexpr uint32_t kMaxSpinIterations = 1000;
+  static inline uint64_t clock = 0;
+  static inline uint64_t yields = 0;
+  static auto Now() -> uint64_t { return clock; }
+  static auto Yield() -> void {
+    ++yields;
+    ++clock;
+  }
+};
+
+static_assert(device_framework::YieldTraits<ClockHostTraits>);
+static_assert(!device_framework::YieldTraits<HostTraits>);
+
+/**
+ * @brief 启用多生产者并发提交的 ClockHostTraits
+ */
+struct ConcurrentClockHostTraits : ClockHostTraits {
+  static constexpr bool kConcurrentSubmit = true;
+};
+
+/**
+ * @brief 批量传输超时后，设备归还的过期请求不得被之后的调用认领
+ *
+ * @tparam Traits 平台 Traits（覆盖普通与并发提交两种模式）
+ * @param name 用例名前缀
+ */
+template <class Traits>
+void CheckStaleBatchRequests(const char* name) {
+  using Dev =
+      device_framework::virtio::blk::VirtioBlkDevice<Traits, HostMmioTransport>;
+  VirtioBlkModel stall_model(kCapacity);
+  std::memset(g_dma, 0, sizeof(g_dma));
+  auto dev_result = Dev::Create(stall_model.base(), g_dma);
+  EXPECT_TRUE(dev_result.has_value() && dev_result->OpenReadWrite(),
+              name);
+  if (!dev_result.has_value()) {
+    return;
+  }
+  auto& dev = *dev_result;
+  auto disk = stall_model.Disk();
+  for (size_t i = 0; i < sizeof(g_data); ++i) {
+    disk[100 * kSectorSize + i] = static_cast<uint8_t>(i * 7 + 3);
+  }
+
+  // 设备停顿：批量读取超时返回，请求仍在途
+  stall_model.Stall();
+  EXPECT_FALSE(dev.ReadBlocks(100, g_readback, kBlocks).has_value(), name);
+  // 设备稍后归还全部过期请求，新的调用须等待自己的请求
+  stall_model.Unstall();
+  std::memset(g_readback, 0, sizeof(g_readback));
+  auto read = dev.ReadBlocks(100, g_readback, kBlocks);
+  EXPECT_TRUE(read.has_value() && *read == kBlocks, name);
+  EXPECT_TRUE(std::memcmp(g_readback, disk.data() + 100 * kSectorSize,
+                          sizeof(g_readback)) == 0,
+              name);
+}
+
+/**
+ * @brief 覆写一段栈内存（模拟返回后的栈帧被后续调用复用）
+ */
+[[gnu::noinline]] void ClobberStack() {
+  volatile uint8_t scratch[4096];
+  for (auto& byte : scratch) {
+    byte = 0x5A;
+  }
+}
+
+}  // namespace
+
+void test_host_virtio_blk() {
+  TEST_SUITE_BEGIN("Host VirtIO Block Model");
+
+  using Blk =
+      device_framework::virtio::blk::VirtioBlk<HostTraits, HostMmioTransport>;
+
+  // === 测试 1: 创建与特性协商 ===
+  VirtioBlkModel model(kCapacity, 2);
+  {
+    std::memset(g_dma, 0, sizeof(g_dma));
+    auto blk_result = Blk::Create(model.base(), g_dma);
+    EXPECT_TRUE(blk_result.has_value(), "VirtioBlk::Create() over model");
+    if (!blk_result.has_value()) {
+      TEST_SUITE_END();
+      return;
+    }
+    auto& blk = *blk_result;
+    EXPECT_EQ(kCapacity, blk.GetCapacity(), "Capacity from model config");
+    EXPECT_EQ(blk.GetNegotiatedFeatures(), model.GetDriverFeatures(),
+              "Model sees negotiated features");
+
+    // === 测试 2: 单扇区读写 ===
+    for (size_t i = 0; i < kSectorSize; ++i) {
+      g_data[i] = static_cast<uint8_t>(i * 3 + 1);
+    }
+    EXPECT_TRUE(blk.Write(7, g_data).has_value(), "Write sector 7");
+    EXPECT_TRUE(std::memcmp(model.Disk().data() + 7 * kSectorSize, g_data,
+                            kSectorSize) == 0,
+                "Model disk holds written data");
+    std::memset(g_readback, 0, kSectorSize);
+    EXPECT_TRUE(blk.Read(7, g_readback).has_value(), "Read sector 7");
+    EXPECT_TRUE(std::memcmp(g_readback, g_data, kSectorSize) == 0,
+                "Read back matches");
+
+    // === 测试 3: Flush / GetId ===
+    EXPECT_TRUE(blk.Flush().has_value(), "Flush");
+    uint8_t id[device_framework::virtio::blk::kDeviceIdMaxLen] = {};
+    EXPECT_TRUE(blk.GetId(id).has_value(), "GetId");
+    EXPECT_TRUE(std::memcmp(id, "host-virtio-blk", 15) == 0,
+                "Serial from model");
+
+    // === 测试 4: 越界请求 ===
+    EXPECT_FALSE(blk.Read(kCapacity, g_readback).has_value(),
+                 "Read beyond capacity fails");
+    EXPECT_TRUE(model.GetStats().errors > 0, "Model counted IOERR");
+  }
+
+  // === 测试 5: 多块读写 ===
+  {
+    using Dev = device_framework::virtio::blk::VirtioBlkDevice<
+        HostTraits, HostMmioTransport>;
+    std::memset(g_dma, 0, sizeof(g_dma));
+    model.ResetStats();
+    auto dev_result = Dev::Create(model.base(), g_dma);
+    EXPECT_TRUE(dev_result.has_value(), "VirtioBlkDevice::Create()");
+    if (dev_result.has_value()) {
+      auto& dev = *dev_result;
+      EXPECT_TRUE(dev.OpenReadWrite().has_value(), "OpenReadWrite()");
+      for (size_t i = 0; i < sizeof(g_data); ++i) {
+        g_data[i] = static_cast<uint8_t>(i ^ (i >> 9));
+      }
+      auto written = dev.WriteBlocks(100, g_data, kBlocks);
+      EXPECT_TRUE(written.has_value() && *written == kBlocks,
+                  "WriteBlocks() 64 blocks");
+      std::memset(g_readback, 0, sizeof(g_readback));
+      auto read = dev.ReadBlocks(100, g_readback, kBlocks);
+      EXPECT_TRUE(read.has_value() && *read == kBlocks,
+                  "ReadBlocks() 64 blocks");
+      EXPECT_TRUE(std::memcmp(g_readback, g_data, sizeof(g_data)) == 0,
+                  "Multi-block data matches");
+      auto stats = model.GetStats();
+      EXPECT_EQ(static_cast<uint64_t>(sizeof(g_data)), stats.bytes_written,
+                "Model counted written bytes");
+      EXPECT_EQ(static_cast<uint64_t>(sizeof(g_data)), stats.bytes_read,
+                "Model counted read bytes");
+    }
+  }
+
+  // === 测试 6: 多队列 ===
+  {
+    std::memset(g_dma, 0, sizeof(g_dma));
+    model.ResetStats();
+    auto blk_result = Blk::Create(model.base(), g_dma, 2);
+    EXPECT_TRUE(blk_result.has_value(), "VirtioBlk::Create() with 2 queues");
+    if (blk_result.has_value()) {
+      auto& blk = *blk_result;
+      EXPECT_EQ(static_cast<uint16_t>(2), blk.GetQueueCount(),
+                "Two queues from model num_queues");
+      EXPECT_TRUE(blk.Read(7, g_readback).has_value(), "Read after reset");
+      auto stats = model.GetStats();
+      EXPECT_TRUE(stats.requests >= 1 && stats.notifies >= 1,
+                  "Model counted notify and request");
+
+      // 共享中断线：逐队列处理不确认中断状态，也不认领其他队列的中断
+      size_t callbacks = 0;
+      auto on_complete = [&callbacks](void*, device_framework::ErrorCode) {
+        ++callbacks;
+      };
+      blk.AcknowledgeInterrupt();
+      device_framework::virtio::IoVec iov{
+          reinterpret_cast<uintptr_t>(g_readback), kSectorSize};
+      EXPECT_TRUE(blk.EnqueueRead(1, 7, &iov, 1).has_value(),
+                  "Enqueue on queue 1");
+      blk.Kick(1);
+      EXPECT_TRUE(blk.IsInterruptPending(), "Queue 1 raised the interrupt");
+      blk.HandleInterrupt(0, on_complete);
+      EXPECT_EQ(static_cast<size_t>(0), callbacks, "Queue 0 found no work");
+      EXPECT_TRUE(blk.IsInterruptPending(),
+                  "Per-queue handler left the shared ISR unacked");
+      EXPECT_EQ(static_cast<uint64_t>(0),
+                blk.GetQueueStats(0).interrupts_handled,
+                "Queue 0 did not count another queue's interrupt");
+      blk.AcknowledgeInterrupt();
+      blk.HandleInterrupt(1, on_complete);
+      EXPECT_EQ(static_cast<size_t>(1), callbacks, "Queue 1 reaped its read");
+      EXPECT_FALSE(blk.IsInterruptPending(), "Line handler acked once");
+      EXPECT_EQ(static_cast<uint64_t>(1),
+                blk.GetQueueStats(1).interrupts_handled,
+                "Queue 1 counted its interrupt");
+
+      // 全队列处理：中断计入完成所在的队列
+      EXPECT_TRUE(blk.EnqueueRead(1, 8, &iov, 1).has_value(),
+                  "Enqueue on queue 1 again");
+      blk.Kick(1);
+      blk.HandleInterrupt(on_complete);
+      EXPECT_EQ(static_cast<size_t>(2), callbacks, "All-queue handler reaped");
+      EXPECT_EQ(static_cast<uint64_t>(0),
+                blk.GetQueueStats(0).interrupts_handled,
+                "Queue 0 count unchanged");
+      EXPECT_EQ(static_cast<uint64_t>(2),
+                blk.GetQueueStats(1).interrupts_handled,
+                "Queue 1 counted the shared interrupt");
+
+      // 同步方法不回收并丢弃回调方式请求的完成
+      int token = 0;
+      void* completed_token = nullptr;
+      auto record = [&completed_token](void* t, device_framework::ErrorCode) {
+        completed_token = t;
+      };
+      EXPECT_TRUE(blk.EnqueueRead(0, 9, &iov, 1, &token).has_value(),
+                  "Enqueue callback request on queue 0");
+      auto busy = blk.Read(7, g_readback);
+      EXPECT_TRUE(!busy.has_value() &&
+                      busy.error().code ==
+                          device_framework::ErrorCode::kDeviceBusy,
+                  "Sync Read() refused while a callback request is pending");
+      blk.Kick(0);
+      blk.HandleInterrupt(record);
+      EXPECT_TRUE(completed_token == &token,
+                  "Callback request completion still delivered");
+      EXPECT_TRUE(blk.Read(7, g_readback).has_value(),
+                  "Sync Read() after the callback request completed");
+    }
+  }
+
+  // === 测试 7: 静默与快速恢复 ===
+  {
+    std::memset(g_dma, 0, sizeof(g_dma));
+    model.ResetStats();
+    auto blk_result = Blk::Create(model.base(), g_dma);
+    EXPECT_TRUE(blk_result.has_value(), "VirtioBlk::Create() for quiesce");
+    if (blk_result.has_value()) {
+      auto& blk = *blk_result;
+      uint64_t create_writes = model.GetStats().register_writes;
+
+      size_t completed = 0;
+      size_t canceled = 0;
+      auto on_complete = [&](void*, device_framework::ErrorCode status) {
+        if (status == device_framework::ErrorCode::kCanceled) {
+          ++canceled;
+        } else if (status == device_framework::ErrorCode::kSuccess) {
+          ++completed;
+        }
+      };
+
+      // 入队但未 Kick 的请求在 drain 阶段被提交并回收
+      for (size_t i = 0; i < 4; ++i) {
+        device_framework::virtio::IoVec iov{
+            reinterpret_cast<uintptr_t>(g_readback + i * kSectorSize),
+            kSectorSize};
+        (void)blk.EnqueueRead(0, 200 + i, &iov, 1);
+      }
+      EXPECT_EQ(static_cast<size_t>(0), blk.Quiesce(on_complete),
+                "Drain completes all in-flight requests");
+      EXPECT_EQ(static_cast<size_t>(4), completed, "Drained completions");
+      EXPECT_TRUE(blk.IsQuiesced(), "Quiesced after Quiesce()");
+      EXPECT_FALSE(blk.Read(7, g_readback).has_value(),
+                   "Submission rejected while quiesced");
+
+      model.ResetStats();
+      EXPECT_TRUE(blk.Resume().has_value(), "Resume()");
+      EXPECT_FALSE(blk.IsQuiesced(), "Not quiesced after Resume()");
+      EXPECT_TRUE(model.GetStats().register_writes < create_writes,
+                  "Resume writes fewer registers than Create");
+      EXPECT_EQ(blk.GetNegotiatedFeatures(), model.GetDriverFeatures(),
+                "Resume restores negotiated features");
+      EXPECT_TRUE(blk.Write(9, g_data).has_value(), "Write after Resume");
+
+      // 设备请求复位时在途请求以 kCanceled 完成，且从未到达磁盘
+      std::memset(model.Disk().data() + 300 * kSectorSize, 0, kSectorSize);
+      device_framework::virtio::IoVec write_iov{
+          reinterpret_cast<uintptr_t>(g_data), kSectorSize};
+      (void)blk.EnqueueWrite(0, 300, &write_iov, 1);
+      model.InjectNeedsReset();
+      blk.Kick(0);
+      EXPECT_TRUE(blk.GetTransport().NeedsReset(), "Device needs reset");
+      completed = 0;
+      EXPECT_EQ(static_cast<size_t>(1), blk.Quiesce(on_complete, false),
+                "Quiesce cancels request on failed device");
+      EXPECT_EQ(static_cast<size_t>(1), canceled, "Callback saw kCanceled");
+      EXPECT_EQ(static_cast<size_t>(0), completed, "Nothing completed");
+      EXPECT_EQ(static_cast<uint8_t>(0),
+                model.Disk()[300 * kSectorSize], "Canceled write not served");
+      EXPECT_TRUE(blk.Resume().has_value(), "Resume() after NEEDS_RESET");
+      EXPECT_FALSE(blk.GetTransport().NeedsReset(), "Device recovered");
+      std::memset(g_readback, 0, kSectorSize);
+      EXPECT_TRUE(blk.Read(9, g_readback).has_value(), "Read after recovery");
+      EXPECT_TRUE(std::memcmp(g_readback, g_data, kSectorSize) == 0,
+                  "Data survives recovery");
+      auto stats = blk.GetStats();
+      EXPECT_EQ(static_cast<uint64_t>(2), stats.resumes, "Resume count");
+      EXPECT_EQ(static_cast<uint64_t>(1), stats.requests_canceled,
+                "Canceled count");
+
+      // === 测试 8: 交接到新的驱动对象 ===
+      EXPECT_EQ(static_cast<size_t>(0), blk.Quiesce(on_complete),
+                "Quiesce idle device");
+      auto state = blk.GetResumeState();
+      auto restored = Blk::Restore(model.base(), g_dma, state);
+      EXPECT_TRUE(restored.has_value(), "Restore() from resume state");
+      if (restored.has_value()) {
+        EXPECT_EQ(blk.GetNegotiatedFeatures(),
+                  restored->GetNegotiatedFeatures(), "Restored features");
+        std::memset(g_readback, 0, kSectorSize);
+        EXPECT_TRUE(restored->Read(9, g_readback).has_value(),
+                    "Read through restored driver");
+        EXPECT_TRUE(std::memcmp(g_readback, g_data, kSectorSize) == 0,
+                    "Restored read matches");
+        EXPECT_EQ(kCapacity, restored->GetCapacity(),
+                  "Restored driver reads config lazily");
+      }
+      Blk::ResumeState bad = state;
+      bad.queue_count = 0;
+      EXPECT_FALSE(Blk::Restore(model.base(), g_dma, bad).has_value(),
+                   "Restore() rejects invalid state");
+    }
+  }
+
+  // === 测试 9: 截止时间与取消 ===
+  {
+    using ClockBlk = device_framework::virtio::blk::VirtioBlk<
+        ClockHostTraits, HostMmioTransport>;
+    static_assert(ClockBlk::kDeadlines);
+    static_assert(!Blk::kDeadlines);
+    using device_framework::ErrorCode;
+
+    std::memset(g_dma, 0, sizeof(g_dma));
+    auto blk_result = ClockBlk::Create(model.base(), g_dma);
+    EXPECT_TRUE(blk_result.has_value(), "VirtioBlk::Create() with clock");
+    if (blk_result.has_value()) {
+      auto& blk = *blk_result;
+      int token_a = 0;
+      int token_b = 0;
+      void* last_token = nullptr;
+      ErrorCode last_status = ErrorCode::kSuccess;
+      size_t callbacks = 0;
+      auto on_complete = [&](void* token, ErrorCode status) {
+        last_token = token;
+        last_status = status;
+        ++callbacks;
+      };
+      device_framework::virtio::IoVec iov{
+          reinterpret_cast<uintptr_t>(g_readback), kSectorSize};
+
+      // 未 Kick 的请求不会被设备看到，到期后由超时扫描放弃
+      blk.SetRequestTimeout(100);
+      EXPECT_EQ(static_cast<uint64_t>(100), blk.GetRequestTimeout(),
+                "Request timeout set");
+      ClockHostTraits::clock = 1000;
+      (void)blk.EnqueueRead(0, 7, &iov, 1, &token_a);
+      EXPECT_EQ(static_cast<size_t>(0), blk.ExpireRequests(on_complete),
+                "Nothing expires before deadline");
+      ClockHostTraits::clock += 200;
+      EXPECT_EQ(static_cast<size_t>(1), blk.ExpireRequests(on_complete),
+                "Expired request reported");
+      EXPECT_TRUE(last_token == &token_a && last_status == ErrorCode::kTimeout,
+                  "Timeout callback carries token and kTimeout");
+      EXPECT_EQ(static_cast<size_t>(0), blk.ExpireRequests(on_complete),
+                "Expired request reported once");
+
+      // 设备归还已超时的请求时静默释放，不再回调
+      callbacks = 0;
+      blk.Kick(0);
+      blk.HandleInterrupt(on_complete);
+      EXPECT_EQ(static_cast<size_t>(0), callbacks,
+                "Late completion after timeout is silent");
+      blk.SetRequestTimeout(0);
+
+      // Cancel()：调用者立即得到 kCanceled，请求槽保留到设备归还
+      auto handle_b = blk.EnqueueRead(0, 7, &iov, 1, &token_b);
+      EXPECT_TRUE(handle_b.has_value() && blk.Cancel(*handle_b, on_complete),
+                  "Cancel() in-flight request");
+      EXPECT_TRUE(callbacks == 1 && last_token == &token_b &&
+                      last_status == ErrorCode::kCanceled,
+                  "Cancel() delivers kCanceled to the callback");
+      EXPECT_FALSE(blk.Cancel(*handle_b, on_complete), "Cancel() only once");
+      callbacks = 0;
+      blk.Kick(0);
+      blk.HandleInterrupt(on_complete);
+      EXPECT_EQ(static_cast<size_t>(0), callbacks,
+                "Canceled request completes silently");
+
+      // 句柄带有分配代数：请求完成、槽被复用后旧句柄失效
+      auto stale = blk.EnqueueRead(0, 7, &iov, 1);
+      blk.Kick(0);
+      blk.HandleInterrupt(on_complete);
+      auto reused = blk.EnqueueRead(0, 7, &iov, 1);
+      EXPECT_TRUE(stale.has_value() && reused.has_value() &&
+                      stale->slot == reused->slot &&
+                      !blk.Cancel(*stale, on_complete),
+                  "Stale handle does not cancel the slot's new request");
+      blk.Kick(0);
+      blk.HandleInterrupt(on_complete);
+      EXPECT_EQ(static_cast<size_t>(2), callbacks,
+                "Both requests complete normally");
+      callbacks = 0;
+
+      // WaitFor()：完成前返回结果，截止时间到达则取消并返回 kTimeout
+      auto handle_a = blk.EnqueueRead(0, 7, &iov, 1, &token_a);
+      blk.Kick(0);
+      EXPECT_TRUE(handle_a.has_value() &&
+                      blk.WaitFor(*handle_a, ClockHostTraits::clock + 10,
+                                  on_complete)
+                          .has_value(),
+                  "WaitFor() completed request");
+      EXPECT_EQ(static_cast<size_t>(0), callbacks,
+                "Awaited request bypasses the callback");
+      handle_b = blk.EnqueueRead(0, 7, &iov, 1, &token_b);
+      ClockHostTraits::yields = 0;
+      auto waited =
+          blk.WaitFor(*handle_b, ClockHostTraits::clock + 10, on_complete);
+      EXPECT_TRUE(!waited.has_value() &&
+                      waited.error().code == ErrorCode::kTimeout,
+                  "WaitFor() times out");
+      EXPECT_EQ(static_cast<uint64_t>(10), ClockHostTraits::yields,
+                "WaitFor() yields between polls");
+      blk.Kick(0);
+      blk.HandleInterrupt(on_complete);
+      EXPECT_EQ(static_cast<size_t>(0), callbacks,
+                "WaitFor() timeout leaves no callback");
+      EXPECT_FALSE(
+          blk.WaitFor(*handle_b, ClockHostTraits::clock, on_complete)
+              .has_value(),
+          "WaitFor() rejects completed request");
+
+      // 等待期间回调取消了被等待的请求：WaitFor() 立即返回 kCanceled
+      auto other = blk.EnqueueRead(0, 7, &iov, 1, &token_a);
+      blk.Kick(0);
+      handle_b = blk.EnqueueRead(0, 7, &iov, 1, &token_b);
+      auto cancel_target = [&](void*, ErrorCode) {
+        (void)blk.Cancel(*handle_b, on_complete);
+      };
+      ClockHostTraits::yields = 0;
+      waited = blk.WaitFor(*handle_b, ClockHostTraits::clock + 1000,
+                           cancel_target);
+      EXPECT_TRUE(other.has_value() && !waited.has_value() &&
+                      waited.error().code == ErrorCode::kCanceled &&
+                      ClockHostTraits::yields == 0,
+                  "WaitFor() returns at once when canceled by a callback");
+      EXPECT_EQ(static_cast<size_t>(0), callbacks,
+                "Awaited request's cancellation goes to WaitFor()");
+
+      // 等待期间超时扫描放弃了被等待的请求：WaitFor() 立即返回 kTimeout
+      other = blk.EnqueueRead(0, 7, &iov, 1, &token_a);
+      blk.Kick(0);
+      blk.SetRequestTimeout(5);
+      handle_b = blk.EnqueueRead(0, 7, &iov, 1, &token_b);
+      blk.SetRequestTimeout(0);
+      auto expire = [&](void*, ErrorCode) {
+        ClockHostTraits::clock += 10;
+        (void)blk.ExpireRequests(on_complete);
+      };
+      ClockHostTraits::yields = 0;
+      waited = blk.WaitFor(*handle_b, ClockHostTraits::clock + 1000, expire);
+      EXPECT_TRUE(!waited.has_value() &&
+                      waited.error().code == ErrorCode::kTimeout &&
+                      ClockHostTraits::yields == 0,
+                  "WaitFor() returns at once when expired by the sweep");
+      EXPECT_EQ(static_cast<size_t>(0), callbacks,
+                "Awaited request's timeout goes to WaitFor()");
+      blk.Kick(0);
+      blk.HandleInterrupt(on_complete);
+
+      // 同步请求超时：请求槽保留，直到复位后静默释放
+      model.InjectNeedsReset();
+      EXPECT_FALSE(blk.Read(7, g_readback).has_value(),
+                   "Sync read times out on stalled device");
+      EXPECT_EQ(static_cast<size_t>(0), blk.Quiesce(on_complete, false),
+                "Timed-out request is not canceled twice");
+      EXPECT_EQ(static_cast<size_t>(0), callbacks, "No stale sync callback");
+      EXPECT_TRUE(blk.Resume().has_value(), "Resume() after sync timeout");
+      EXPECT_TRUE(blk.Read(7, g_readback).has_value(), "Read after recovery");
+
+      auto stats = blk.GetStats();
+      EXPECT_EQ(static_cast<uint64_t>(4), stats.requests_timed_out,
+                "Timed-out count");
+      EXPECT_EQ(static_cast<uint64_t>(2), stats.requests_canceled,
+                "Canceled count");
+    }
+
+    // 队列小于 MaxInflight：可用槽之外的位图位恒为占用，不得当作请求
+    std::memset(g_dma, 0, sizeof(g_dma));
+    auto small_result = ClockBlk::Create(model.base(), g_dma, 1, 16);
+    EXPECT_TRUE(small_result.has_value(), "VirtioBlk::Create() 16 entries");
+    if (small_result.has_value()) {
+      auto& blk = *small_result;
+      size_t callbacks = 0;
+      auto on_complete = [&callbacks](void*, ErrorCode) { ++callbacks; };
+      EXPECT_FALSE(blk.Cancel({0, 40, 0}, on_complete),
+                   "Handle past the usable slots is rejected");
+      device_framework::virtio::IoVec iov{
+          reinterpret_cast<uintptr_t>(g_readback), kSectorSize};
+      blk.SetRequestTimeout(5);
+      (void)blk.EnqueueRead(0, 7, &iov, 1);
+      blk.SetRequestTimeout(0);
+      ClockHostTraits::clock += 10;
+      EXPECT_EQ(static_cast<size_t>(1), blk.ExpireRequests(on_complete),
+                "Sweep only visits usable slots");
+      EXPECT_EQ(static_cast<size_t>(1), callbacks, "One timeout reported");
+      blk.Kick(0);
+      blk.HandleInterrupt(on_complete);
+    }
+  }
+
+  // === 测试 10: 同步 WRITE_ZEROES 超时后的范围数组 ===
+  {
+    using ClockBlk = device_framework::virtio::blk::VirtioBlk<
+        ClockHostTraits, HostMmioTransport>;
+    VirtioBlkModel wz_model(
+        kCapacity, 1,
+        VirtioBlkModel::kDefaultFeatures |
+            static_cast<uint64_t>(
+                device_framework::virtio::blk::BlkFeatureBit::kWriteZeroes));
+    std::memset(g_dma, 0, sizeof(g_dma));
+    auto blk_result = ClockBlk::Create(wz_model.base(), g_dma);
+    EXPECT_TRUE(blk_result.has_value(), "VirtioBlk::Create() write zeroes");
+    if (blk_result.has_value()) {
+      auto& blk = *blk_result;
+      auto disk = wz_model.Disk();
+      std::memset(disk.data(), 0xAB, disk.size());
+
+      // 设备停顿期间请求超时返回，之后设备才读取范围数组
+      wz_model.Stall();
+      EXPECT_FALSE(blk.WriteZeroes(500, 8).has_value(),
+                   "WriteZeroes() times out on stalled device");
+      ClobberStack();
+      wz_model.Unstall();
+      EXPECT_EQ(static_cast<uint64_t>(0), wz_model.GetStats().errors,
+                "Late request carries valid ranges");
+      bool zeroed = true;
+      for (size_t i = 500 * kSectorSize; i < 508 * kSectorSize; ++i) {
+        zeroed = zeroed && disk[i] == 0;
+      }
+      EXPECT_TRUE(zeroed, "Late request zeroes the requested sectors");
+      EXPECT_TRUE(disk[500 * kSectorSize - 1] == 0xAB &&
+                      disk[508 * kSectorSize] == 0xAB,
+                  "Neighbouring sectors untouched");
+
+      size_t callbacks = 0;
+      blk.HandleInterrupt(
+          [&callbacks](void*, device_framework::ErrorCode) { ++callbacks; });
+      EXPECT_EQ(static_cast<size_t>(0), callbacks,
+                "Timed-out request completes silently");
+      EXPECT_TRUE(blk.WriteZeroes(600, 4).has_value(),
+                  "WriteZeroes() after recovery");
+      EXPECT_EQ(static_cast<uint8_t>(0), disk[603 * kSectorSize],
+                "WriteZeroes() reached the disk");
+    }
+  }
+
+  // === 测试 11: 批量传输超时遗留的请求 ===
+  CheckStaleBatchRequests<ClockHostTraits>("Stale batch requests ignored");
+  CheckStaleBatchRequests<ConcurrentClockHostTraits>(
+      "Stale batch requests ignored (concurrent submit)");
+
+
+  // === 测试 12: 拆分的异步传输全部入队或全部不入队 ===
+  {
+    using Dev =
+        device_framework::virtio::blk::VirtioBlkDevice<HostTraits,
+                                                       HostMmioTransport>;
+    using device_framework::ErrorCode;
+    // 每段一个扇区、每个请求两段：8 个块拆分为 4 个请求
+    VirtioBlkModel split_model(kCapacity);
+    split_model.Config().size_max = kSectorSize;
+    split_model.Config().seg_max = 2;
+    std::memset(g_dma, 0, sizeof(g_dma));
+    auto dev_result = Dev::Create(split_model.base(), g_dma, 1, 4);
+    EXPECT_TRUE(dev_result.has_value() && dev_result->OpenReadWrite(),
+                "VirtioBlkDevice with 4-entry queue");
+    if (dev_result.has_value()) {
+      auto& dev = *dev_result;
+      int token = 0;
+      auto busy = dev.SubmitReadBlocks(
+          0, std::span(g_readback, 10 * kSectorSize), 10, &token);
+      EXPECT_TRUE(!busy.has_value() &&
+                      busy.error().code == ErrorCode::kDeviceBusy,
+                  "Transfer needing 5 requests on 4 slots is refused");
+      EXPECT_EQ(static_cast<uint64_t>(0), split_model.GetStats().requests,
+                "No part of the refused transfer reached the device");
+
+      auto fits = dev.SubmitReadBlocks(
+          0, std::span(g_readback, 8 * kSectorSize), 8, &token);
+      EXPECT_TRUE(fits.has_value(), "Transfer needing 4 requests fits");
+      device_framework::BlockCompletion completion{};
+      size_t reaped = 0;
+      for (int i = 0; i < 100 && reaped == 0; ++i) {
+        reaped = dev.Reap(std::span(&completion, 1));
+      }
+      EXPECT_TRUE(reaped == 1 && completion.token == &token &&
+                      completion.status == ErrorCode::kSuccess &&
+                      completion.block_count == 8,
+                  "Split transfer completes once after every part");
+    }
+  }
+
+  TEST_SUITE_END();
+}
@@ -9,6 +9,8 @@
  * #include "device_framework/acpi.hpp"
  *
  * device_framework::acpi::Acpi acpi(rsdp_address);
+ * auto mcfg = acpi.FindTable<"MCFG">();
+ * auto topo = device_framework::acpi::NumaTopology<>::Create(acpi);
  * @endcode
  */
 
@@ -16,6 +18,7 @@
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_ACPI_HPP_
 
 #include "device_framework/detail/acpi/acpi.hpp"
+#include "device_framework/detail/acpi/numa_topology.hpp"
 
 namespace device_framework::acpi {
 using namespace detail::acpi;  // NOLINT(google-build-using-namespace)
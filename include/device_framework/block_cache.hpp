@@ -0,0 +1,30 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ *
+ * @brief 块缓存公开接口
+ *
+ * 用户应通过此头文件使用块缓存适配器，而非直接包含 detail/ 中的实现文件。
+ *
+ * @code
+ * #include "device_framework/block_cache.hpp"
+ *
+ * alignas(4096) static uint8_t pool[64 * 512];
+ * auto cached =
+ *     device_framework::block_cache::CachedBlockDevice<MyBlockDevice, 64>::
+ *         Create(std::move(dev), pool);
+ * cached->OpenReadWrite();
+ * cached->ReadBlock(0, buffer);
+ * cached->Flush();
+ * @endcode
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_BLOCK_CACHE_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_BLOCK_CACHE_HPP_
+
+#include "device_framework/detail/block_cache/cached_block_device.hpp"
+
+namespace device_framework::block_cache {
+using namespace detail::block_cache;  // NOLINT(google-build-using-namespace)
+}  // namespace device_framework::block_cache
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_BLOCK_CACHE_HPP_ */
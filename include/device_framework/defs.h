@@ -19,8 +19,92 @@ enum class DeviceType : uint32_t {
   kBlock,
   /// 网络设备
   kNetwork,
+  /// 帧缓冲设备
+  kFramebuffer,
 };
 
+/// @brief 帧缓冲中的矩形区域（像素）
+struct FramebufferRect {
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+};
+
+/// @brief 帧缓冲布局信息
+struct FramebufferInfo {
+  /// 可见宽度（像素）
+  uint32_t width = 0;
+  /// 可见高度（像素）
+  uint32_t height = 0;
+  /// 相邻两行起始地址的间距（字节）
+  uint32_t stride = 0;
+  /// 每像素位数
+  uint32_t bits_per_pixel = 0;
+  /// 帧缓冲总字节数（Mmap 的上限）
+  uint64_t size = 0;
+};
+
+/// @brief UART 校验方式
+enum class UartParity : uint8_t {
+  /// 无校验
+  kNone = 0,
+  /// 奇校验
+  kOdd,
+  /// 偶校验
+  kEven,
+};
+
+/**
+ * @brief UART 线路与 FIFO 配置
+ *
+ * 通过 `Ioctl(UartIoctl::kSetConfig, reinterpret_cast<uintptr_t>(&config))`
+ * 应用，驱动将实际生效的值（舍入后的波特率、最近的硬件触发档位）
+ * 写回 config。
+ */
+struct UartConfig {
+  /// 波特率（bps），0 表示保持当前分频
+  uint32_t baud_rate = 0;
+  /// UART 参考时钟（Hz），baud_rate 非 0 时必须提供
+  uint32_t clock = 0;
+  /// 接收中断触发水位（字节），取不超过该值的最大硬件档位
+  uint8_t rx_trigger = 1;
+  /// 发送中断阈值（发送 FIFO 剩余字节数不超过该值时触发），
+  /// 不支持可编程阈值的硬件（如 16550A，FIFO 全空时触发）写回 0
+  uint8_t tx_threshold = 0;
+  /// 数据位（5-8）
+  uint8_t data_bits = 8;
+  /// 停止位（1 或 2）
+  uint8_t stop_bits = 1;
+  /// 校验方式
+  UartParity parity = UartParity::kNone;
+};
+
+/// @brief UART 设备的 Ioctl 命令码
+struct UartIoctl {
+  /// 应用 UartConfig（arg 为 UartConfig*，返回时写回实际配置）
+  static constexpr uint32_t kSetConfig = 0x5501;
+  /// 读取当前 UartConfig（arg 为 UartConfig*）
+  static constexpr uint32_t kGetConfig = 0x5502;
+};
+
+/// 分频舍入后允许的最大波特率误差（千分比），超出时两端采样会失步
+inline constexpr uint32_t kUartMaxBaudErrorPermille = 30;
+
+/**
+ * @brief 检查分频后的实际波特率是否在允许误差内
+ *
+ * @param requested 请求的波特率
+ * @param actual 分频后的实际波特率
+ * @return 误差不超过 kUartMaxBaudErrorPermille 时返回 true
+ */
+[[nodiscard]] constexpr auto UartBaudWithinTolerance(uint32_t requested,
+                                                     uint32_t actual) -> bool {
+  uint64_t diff = requested > actual ? requested - actual : actual - requested;
+  return diff * 1000 <= static_cast<uint64_t>(requested) *
+                            kUartMaxBaudErrorPermille;
+}
+
 }  // namespace device_framework
 
 #endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DEFS_H_ */
@@ -5,36 +5,81 @@
 #ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_ACPI_ACPI_HPP_
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_ACPI_ACPI_HPP_
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
+
+#include "device_framework/expected.hpp"
 
 namespace device_framework::detail::acpi {
 
+/**
+ * @brief 编译期 ACPI 表签名
+ *
+ * 由 4 字符字符串字面量在编译期构造，按小端序打包为 32 位整数，
+ * 与表头 signature 字段的内存布局一致。常用别名 "MADT" / "FADT"
+ * 映射为规范中的实际签名 "APIC" / "FACP"。
+ */
+struct Signature {
+  /// 打包后的签名
+  uint32_t value;
+
+  /**
+   * @brief 由字符串字面量构造签名
+   * @param name 4 字符签名（如 "MCFG"）
+   */
+  template <size_t N>
+    requires(N == 5)
+  consteval Signature(const char (&name)[N])  // NOLINT(google-explicit-*)
+      : value(Pack(name)) {
+    if (value == Pack("MADT")) {
+      value = Pack("APIC");
+    } else if (value == Pack("FADT")) {
+      value = Pack("FACP");
+    }
+  }
+
+  /**
+   * @brief 将 4 字节签名打包为 32 位整数（小端序）
+   */
+  [[nodiscard]] static constexpr auto Pack(const char* name) -> uint32_t {
+    return static_cast<uint32_t>(static_cast<uint8_t>(name[0])) |
+           static_cast<uint32_t>(static_cast<uint8_t>(name[1])) << 8 |
+           static_cast<uint32_t>(static_cast<uint8_t>(name[2])) << 16 |
+           static_cast<uint32_t>(static_cast<uint8_t>(name[3])) << 24;
+  }
+};
+
 /**
  * @brief ACPI 驱动
  *
- * 提供 ACPI 表结构定义和基本的表解析能力。
+ * 提供 ACPI 表结构定义和表查找：
+ * - RSDP 与 XSDT（或 RSDT）校验和只在首次查找时验证一次
+ * - 首次查找时遍历 XSDT，把签名 → 表地址写入定长开放寻址散列索引
+ *   （校验和错误的表不入索引），FADT 引用的 DSDT 一并索引
+ * - 之后的 FindTable<"APIC">() 在编译期计算签名散列，查找为 O(1)，
+ *   不再扫描 XSDT
+ *
+ * 表所在的物理内存须可直接访问：virt_offset 为物理地址到可访问虚拟
+ * 地址的偏移（恒等映射为 0）。
+ *
+ * 使用示例：
+ * @code
+ * Acpi acpi(rsdp_phys);
+ * auto madt = acpi.FindTable<"APIC">();
+ * auto fadt = acpi.FindTable<"FACP", Acpi::Fadt>();
+ * auto ssdt1 = acpi.FindTable<"SSDT">(1);  // 第二个 SSDT
+ * @endcode
  *
+ * @note 非线程安全：首次查找会构建索引，多个上下文并发使用前应先在
+ *       单一上下文中调用一次 Validate()
  * @see https://uefi.org/sites/default/files/resources/ACPI_Spec_6_5_Aug29.pdf
  */
 class Acpi {
  public:
-  /**
-   * @brief 构造函数
-   * @param rsdp RSDP 地址
-   */
-  explicit Acpi(uint64_t rsdp) : rsdp_addr_(rsdp) {}
-
-  /// @name 默认构造/析构函数
-  /// @{
-  Acpi() = default;
-  Acpi(const Acpi&) = delete;
-  Acpi(Acpi&&) = default;
-  auto operator=(const Acpi&) -> Acpi& = delete;
-  auto operator=(Acpi&&) -> Acpi& = default;
-  ~Acpi() = default;
-  /// @}
+  /// 可索引的最大表数量
+  static constexpr size_t kMaxTables = 64;
 
- private:
   /**
    * @brief Generic Address Structure
    * @see ACPI_Spec_6_5_Aug29.pdf#5.2.3.2
@@ -81,24 +126,30 @@ class Acpi {
 
   /**
    * @brief Root System Description Table (RSDT)
+   *
+   * 表头之后紧跟 (length - sizeof(header)) / 4 个 32 位表地址。
    * @see ACPI_Spec_6_5_Aug29.pdf#5.2.7
    */
   struct Rsdt {
     DescriptionHeader header;
-    uint32_t* entry;
   } __attribute__((packed));
 
   /**
    * @brief Extended System Description Table (XSDT)
+   *
+   * 表头之后紧跟 (length - sizeof(header)) / 8 个 64 位表地址
+   * （只按 4 字节对齐）。
    * @see ACPI_Spec_6_5_Aug29.pdf#5.2.8
    */
   struct Xsdt {
     DescriptionHeader header;
-    uint64_t* entry;
   } __attribute__((packed));
 
   /**
    * @brief Fixed ACPI Description Table (FADT)
+   *
+   * 旧版本固件的 FADT 可能短于本结构，访问 x_dsdt 等扩展字段前须
+   * 检查 header.length。
    * @see ACPI_Spec_6_5_Aug29.pdf#5.2.9
    */
   struct Fadt {
@@ -162,14 +213,552 @@ class Acpi {
 
   /**
    * @brief Differentiated System Description Table (DSDT)
+   *
+   * 表头之后紧跟 AML 定义块。
    * @see ACPI_Spec_6_5_Aug29.pdf#5.2.11.1
    */
   struct Dsdt {
     DescriptionHeader header;
-    uint8_t* definition_block;
   } __attribute__((packed));
 
+  /**
+   * @brief 中断控制器结构 / 资源亲和性结构的公共头部
+   *
+   * MADT 与 SRAT 的表体均为 {type, length} 开头的变长结构序列。
+   */
+  struct SubtableHeader {
+    uint8_t type;
+    uint8_t length;
+  } __attribute__((packed));
+
+  /**
+   * @brief Multiple APIC Description Table (MADT，签名 "APIC")
+   *
+   * 表头之后紧跟中断控制器结构序列。
+   * @see ACPI_Spec_6_5_Aug29.pdf#5.2.12
+   */
+  struct Madt {
+    DescriptionHeader header;
+    uint32_t local_interrupt_controller_address;
+    uint32_t flags;
+  } __attribute__((packed));
+
+  /// MADT 中断控制器结构类型
+  enum class MadtType : uint8_t {
+    kLocalApic = 0x00,
+    kLocalX2apic = 0x09,
+    kGicc = 0x0B,
+    kRintc = 0x18,
+  };
+
+  /// MADT 处理器结构 flags：处理器可用
+  static constexpr uint32_t kMadtEnabled = 1U << 0;
+  /// MADT 处理器结构 flags：处理器可在运行时上线
+  static constexpr uint32_t kMadtOnlineCapable = 1U << 1;
+
+  /**
+   * @brief Processor Local APIC Structure
+   * @see ACPI_Spec_6_5_Aug29.pdf#5.2.12.2
+   */
+  struct MadtLocalApic {
+    SubtableHeader header;
+    uint8_t acpi_processor_uid;
+    uint8_t apic_id;
+    uint32_t flags;
+  } __attribute__((packed));
+
+  /**
+   * @brief Processor Local x2APIC Structure
+   * @see ACPI_Spec_6_5_Aug29.pdf#5.2.12.12
+   */
+  struct MadtLocalX2apic {
+    SubtableHeader header;
+    uint16_t reserved;
+    uint32_t x2apic_id;
+    uint32_t flags;
+    uint32_t acpi_processor_uid;
+  } __attribute__((packed));
+
+  /**
+   * @brief GIC CPU Interface (GICC) Structure（截至 mpidr 字段）
+   * @see ACPI_Spec_6_5_Aug29.pdf#5.2.12.14
+   */
+  struct MadtGicc {
+    SubtableHeader header;
+    uint16_t reserved;
+    uint32_t cpu_interface_number;
+    uint32_t acpi_processor_uid;
+    uint32_t flags;
+    uint32_t parking_protocol_version;
+    uint32_t performance_interrupt_gsiv;
+    uint64_t parked_address;
+    uint64_t physical_base_address;
+    uint64_t gicv;
+    uint64_t gich;
+    uint32_t vgic_maintenance_interrupt;
+    uint64_t gicr_base_address;
+    uint64_t mpidr;
+  } __attribute__((packed));
+
+  /**
+   * @brief RISC-V Hart Local Interrupt Controller (RINTC) Structure
+   * @see ACPI_Spec_6_5_Aug29.pdf#5.2.12.22
+   */
+  struct MadtRintc {
+    SubtableHeader header;
+    uint8_t version;
+    uint8_t reserved;
+    uint32_t flags;
+    uint64_t hart_id;
+    uint32_t acpi_processor_uid;
+  } __attribute__((packed));
+
+  /**
+   * @brief System Resource Affinity Table (SRAT)
+   *
+   * 表头之后紧跟资源亲和性结构序列。
+   * @see ACPI_Spec_6_5_Aug29.pdf#5.2.16
+   */
+  struct Srat {
+    DescriptionHeader header;
+    uint32_t reserved1;
+    uint64_t reserved2;
+  } __attribute__((packed));
+
+  /// SRAT 资源亲和性结构类型
+  enum class SratType : uint8_t {
+    kProcessorAffinity = 0,
+    kMemoryAffinity = 1,
+    kX2apicAffinity = 2,
+    kGiccAffinity = 3,
+    kRintcAffinity = 7,
+  };
+
+  /// SRAT 亲和性结构 flags：结构有效
+  static constexpr uint32_t kSratEnabled = 1U << 0;
+  /// SRAT 内存亲和性 flags：可热插拔
+  static constexpr uint32_t kSratHotPluggable = 1U << 1;
+
+  /**
+   * @brief Processor Local APIC/SAPIC Affinity Structure
+   * @see ACPI_Spec_6_5_Aug29.pdf#5.2.16.1
+   */
+  struct SratProcessorAffinity {
+    SubtableHeader header;
+    uint8_t proximity_domain_lo;
+    uint8_t apic_id;
+    uint32_t flags;
+    uint8_t local_sapic_eid;
+    uint8_t proximity_domain_hi[3];
+    uint32_t clock_domain;
+  } __attribute__((packed));
+
+  /**
+   * @brief Memory Affinity Structure
+   * @see ACPI_Spec_6_5_Aug29.pdf#5.2.16.2
+   */
+  struct SratMemoryAffinity {
+    SubtableHeader header;
+    uint32_t proximity_domain;
+    uint16_t reserved1;
+    uint64_t base_address;
+    uint64_t length;
+    uint32_t reserved2;
+    uint32_t flags;
+    uint64_t reserved3;
+  } __attribute__((packed));
+
+  /**
+   * @brief Processor Local x2APIC Affinity Structure
+   * @see ACPI_Spec_6_5_Aug29.pdf#5.2.16.3
+   */
+  struct SratX2apicAffinity {
+    SubtableHeader header;
+    uint16_t reserved1;
+    uint32_t proximity_domain;
+    uint32_t x2apic_id;
+    uint32_t flags;
+    uint32_t clock_domain;
+    uint32_t reserved2;
+  } __attribute__((packed));
+
+  /**
+   * @brief GICC Affinity Structure
+   * @see ACPI_Spec_6_5_Aug29.pdf#5.2.16.4
+   */
+  struct SratGiccAffinity {
+    SubtableHeader header;
+    uint32_t proximity_domain;
+    uint32_t acpi_processor_uid;
+    uint32_t flags;
+    uint32_t clock_domain;
+  } __attribute__((packed));
+
+  /**
+   * @brief RINTC Affinity Structure
+   * @see ACPI_Spec_6_5_Aug29.pdf#5.2.16.7
+   */
+  struct SratRintcAffinity {
+    SubtableHeader header;
+    uint16_t reserved;
+    uint32_t proximity_domain;
+    uint32_t acpi_processor_uid;
+    uint32_t flags;
+    uint32_t clock_domain;
+  } __attribute__((packed));
+
+  /**
+   * @brief System Locality Information Table (SLIT)
+   *
+   * 表头之后紧跟 number_of_localities² 字节的距离矩阵（行优先，
+   * 以邻近域编号为下标；10 表示本地）。
+   * @see ACPI_Spec_6_5_Aug29.pdf#5.2.17
+   */
+  struct Slit {
+    DescriptionHeader header;
+    uint64_t number_of_localities;
+  } __attribute__((packed));
+
+  /**
+   * @brief PCI Express Memory-mapped Configuration Table (MCFG)
+   *
+   * 表头之后紧跟若干 McfgAllocation，每项描述一段 ECAM 窗口。
+   * @see PCI Firmware Specification 3.2 §4.1.2
+   */
+  struct Mcfg {
+    DescriptionHeader header;
+    uint64_t reserved;
+  } __attribute__((packed));
+
+  /**
+   * @brief MCFG 配置空间基地址分配结构
+   *
+   * base_address 为总线 0 对应的 ECAM 物理地址（即使 start_bus 非 0）。
+   * @see PCI Firmware Specification 3.2 §4.1.2 Table 4-3
+   */
+  struct McfgAllocation {
+    uint64_t base_address;
+    uint16_t pci_segment_group;
+    uint8_t start_bus;
+    uint8_t end_bus;
+    uint32_t reserved;
+  } __attribute__((packed));
+
+  /**
+   * @brief 构造函数
+   * @param rsdp RSDP 物理地址
+   * @param virt_offset 物理地址到可访问虚拟地址的偏移（恒等映射为 0）
+   */
+  explicit Acpi(uint64_t rsdp, uint64_t virt_offset = 0)
+      : rsdp_addr_(rsdp), virt_offset_(virt_offset) {}
+
+  /// @name 默认构造/析构函数
+  /// @{
+  Acpi() = default;
+  Acpi(const Acpi&) = delete;
+  Acpi(Acpi&&) = default;
+  auto operator=(const Acpi&) -> Acpi& = delete;
+  auto operator=(Acpi&&) -> Acpi& = default;
+  ~Acpi() = default;
+  /// @}
+
+  /**
+   * @brief 验证 RSDP 与 XSDT/RSDT 并构建表索引（只执行一次）
+   *
+   * @return 成功；RSDP 签名错误返回 kAcpiInvalidSignature，
+   *         校验和错误返回 kAcpiChecksumMismatch
+   */
+  [[nodiscard]] auto Validate() const -> Expected<void> {
+    if (!indexed_) {
+      BuildIndex();
+    }
+    if (status_ != ErrorCode::kSuccess) {
+      return std::unexpected(Error{status_});
+    }
+    return {};
+  }
+
+  /**
+   * @brief 按签名查找表
+   *
+   * 签名散列在编译期计算；首次调用时构建索引。
+   *
+   * @tparam Sig 表签名（如 "APIC"、"MCFG"、"SRAT"）
+   * @tparam Table 返回的表结构类型（默认只返回表头）
+   * @param instance 同签名表的序号（如多个 SSDT），按 XSDT 中的顺序
+   * @return 表指针；不存在返回 kAcpiTableNotFound
+   */
+  template <Signature Sig, class Table = DescriptionHeader>
+  [[nodiscard]] auto FindTable(size_t instance = 0) const
+      -> Expected<const Table*> {
+    constexpr size_t kSlot = Slot(Sig.value);
+    auto valid = Validate();
+    if (!valid) {
+      return std::unexpected(valid.error());
+    }
+    auto addr = Lookup(Sig.value, kSlot, instance);
+    if (addr == 0) {
+      return std::unexpected(Error{ErrorCode::kAcpiTableNotFound});
+    }
+    return reinterpret_cast<const Table*>(addr);
+  }
+
+  /**
+   * @brief 获取 MCFG 中的全部 ECAM 窗口
+   *
+   * @return 分配结构数组；没有 MCFG 返回 kAcpiTableNotFound
+   */
+  [[nodiscard]] auto GetMcfgAllocations() const
+      -> Expected<std::span<const McfgAllocation>> {
+    auto mcfg = FindTable<"MCFG", Mcfg>();
+    if (!mcfg) {
+      return std::unexpected(mcfg.error());
+    }
+    size_t length = (*mcfg)->header.length;
+    if (length < sizeof(Mcfg)) {
+      return std::span<const McfgAllocation>{};
+    }
+    const auto* entries = reinterpret_cast<const McfgAllocation*>(
+        reinterpret_cast<uintptr_t>(*mcfg) + sizeof(Mcfg));
+    return std::span(entries,
+                     (length - sizeof(Mcfg)) / sizeof(McfgAllocation));
+  }
+
+  /**
+   * @brief 查找覆盖指定 PCI 段组与总线的 ECAM 窗口
+   *
+   * @param segment PCI 段组号
+   * @param bus 总线号
+   * @return 分配结构；不存在返回 kAcpiTableNotFound
+   */
+  [[nodiscard]] auto FindMcfgAllocation(uint16_t segment, uint8_t bus = 0) const
+      -> Expected<const McfgAllocation*> {
+    auto allocations = GetMcfgAllocations();
+    if (!allocations) {
+      return std::unexpected(allocations.error());
+    }
+    for (const auto& alloc : *allocations) {
+      if (alloc.pci_segment_group == segment && bus >= alloc.start_bus &&
+          bus <= alloc.end_bus) {
+        return &alloc;
+      }
+    }
+    return std::unexpected(Error{ErrorCode::kAcpiTableNotFound});
+  }
+
+  /**
+   * @brief 已索引的表数量（不含校验和错误被跳过的表）
+   */
+  [[nodiscard]] auto GetTableCount() const -> size_t {
+    (void)Validate();
+    return table_count_;
+  }
+
+  /**
+   * @brief 因校验和错误或长度异常被跳过的表数量
+   */
+  [[nodiscard]] auto GetInvalidTableCount() const -> size_t {
+    (void)Validate();
+    return invalid_tables_;
+  }
+
+ private:
+  /// 散列索引槽数（2 的幂，装载因子不超过 1/2）
+  static constexpr size_t kIndexSize = kMaxTables * 2;
+  /// 散列索引位数
+  static constexpr int kIndexBits = 7;
+  static_assert((size_t{1} << kIndexBits) == kIndexSize);
+  /// 单个表的最大长度（超出视为损坏，避免校验和遍历越界）
+  static constexpr uint32_t kMaxTableLength = 16U * 1024 * 1024;
+  /// ACPI 1.0 RSDP 长度（校验和覆盖范围）
+  static constexpr size_t kRsdpV1Length = 20;
+
+  /**
+   * @brief 索引项
+   */
+  struct IndexEntry {
+    /// 表签名（0 表示空槽）
+    uint32_t signature;
+    /// 表的可访问地址
+    uintptr_t addr;
+  };
+
+  /**
+   * @brief 签名的起始散列槽（Fibonacci 散列）
+   */
+  [[nodiscard]] static constexpr auto Slot(uint32_t signature) -> size_t {
+    return static_cast<size_t>((signature * 0x9E3779B1U) >>
+                               (32 - kIndexBits));
+  }
+
+  /**
+   * @brief 字节和校验（和为 0 即通过）
+   */
+  [[nodiscard]] static auto Checksum(const uint8_t* data, size_t length)
+      -> bool {
+    uint8_t sum = 0;
+    for (size_t i = 0; i < length; ++i) {
+      sum = static_cast<uint8_t>(sum + data[i]);
+    }
+    return sum == 0;
+  }
+
+  /**
+   * @brief 物理地址转换为可访问地址
+   */
+  [[nodiscard]] auto Map(uint64_t phys) const -> uintptr_t {
+    return static_cast<uintptr_t>(phys + virt_offset_);
+  }
+
+  /**
+   * @brief 读取并校验一个描述表
+   *
+   * @param phys 表物理地址
+   * @return 表头指针；长度异常或校验和错误返回 nullptr
+   */
+  [[nodiscard]] auto MapTable(uint64_t phys) const
+      -> const DescriptionHeader* {
+    if (phys == 0) {
+      return nullptr;
+    }
+    const auto* header = reinterpret_cast<const DescriptionHeader*>(Map(phys));
+    uint32_t length = header->length;
+    if (length < sizeof(DescriptionHeader) || length > kMaxTableLength ||
+        !Checksum(reinterpret_cast<const uint8_t*>(header), length)) {
+      return nullptr;
+    }
+    return header;
+  }
+
+  /**
+   * @brief 验证 RSDP 与根表，并把根表引用的各表写入索引
+   */
+  auto BuildIndex() const -> void {
+    indexed_ = true;
+    const auto* rsdp = reinterpret_cast<const Rsdp*>(Map(rsdp_addr_));
+    if (rsdp_addr_ == 0 ||
+        __builtin_memcmp(rsdp->signature, "RSD PTR ", 8) != 0) {
+      status_ = ErrorCode::kAcpiInvalidSignature;
+      return;
+    }
+    const auto* rsdp_bytes = reinterpret_cast<const uint8_t*>(rsdp);
+    if (!Checksum(rsdp_bytes, kRsdpV1Length)) {
+      status_ = ErrorCode::kAcpiChecksumMismatch;
+      return;
+    }
+
+    // ACPI 2.0+ 优先使用 XSDT（64 位表地址），否则回退到 RSDT
+    bool use_xsdt = false;
+    uint64_t root_phys = rsdp->rsdt_address;
+    if (rsdp->revision >= 2 && rsdp->xsdt_address != 0) {
+      uint32_t length = rsdp->length;
+      if (length < sizeof(Rsdp) || !Checksum(rsdp_bytes, length)) {
+        status_ = ErrorCode::kAcpiChecksumMismatch;
+        return;
+      }
+      use_xsdt = true;
+      root_phys = rsdp->xsdt_address;
+    }
+    const auto* root = MapTable(root_phys);
+    if (root == nullptr) {
+      status_ = ErrorCode::kAcpiChecksumMismatch;
+      return;
+    }
+    if (__builtin_memcmp(root->signature, use_xsdt ? "XSDT" : "RSDT", 4) !=
+        0) {
+      status_ = ErrorCode::kAcpiInvalidSignature;
+      return;
+    }
+
+    const auto* entries =
+        reinterpret_cast<const uint8_t*>(root) + sizeof(DescriptionHeader);
+    size_t entry_size = use_xsdt ? sizeof(uint64_t) : sizeof(uint32_t);
+    size_t count = (root->length - sizeof(DescriptionHeader)) / entry_size;
+    for (size_t i = 0; i < count; ++i) {
+      uint64_t phys = 0;
+      if (use_xsdt) {
+        __builtin_memcpy(&phys, entries + i * entry_size, sizeof(uint64_t));
+      } else {
+        uint32_t phys32 = 0;
+        __builtin_memcpy(&phys32, entries + i * entry_size, sizeof(uint32_t));
+        phys = phys32;
+      }
+      Insert(MapTable(phys));
+    }
+
+    // DSDT 不在根表中，由 FADT 引用
+    constexpr size_t kFadtSlot = Slot(Signature("FACP").value);
+    auto fadt_addr = Lookup(Signature("FACP").value, kFadtSlot, 0);
+    if (fadt_addr != 0) {
+      const auto* fadt = reinterpret_cast<const Fadt*>(fadt_addr);
+      uint64_t dsdt = 0;
+      if (fadt->header.length >= offsetof(Fadt, x_dsdt) + sizeof(uint64_t)) {
+        dsdt = fadt->x_dsdt;
+      }
+      if (dsdt == 0) {
+        dsdt = fadt->dsdt;
+      }
+      Insert(MapTable(dsdt));
+    }
+  }
+
+  /**
+   * @brief 把一个已校验的表写入索引
+   *
+   * @param header 表头；nullptr 表示该表已被 MapTable 拒绝
+   */
+  auto Insert(const DescriptionHeader* header) const -> void {
+    if (header == nullptr) {
+      ++invalid_tables_;
+      return;
+    }
+    if (table_count_ >= kMaxTables) {
+      return;
+    }
+    uint32_t signature = Signature::Pack(header->signature);
+    size_t slot = Slot(signature);
+    while (index_[slot].signature != 0) {
+      slot = (slot + 1) & (kIndexSize - 1);
+    }
+    index_[slot] = {signature, reinterpret_cast<uintptr_t>(header)};
+    ++table_count_;
+  }
+
+  /**
+   * @brief 沿探测序列查找第 instance 个同签名表
+   *
+   * 同签名的表按插入顺序位于同一探测序列上。
+   *
+   * @return 表地址；不存在返回 0
+   */
+  [[nodiscard]] auto Lookup(uint32_t signature, size_t slot,
+                            size_t instance) const -> uintptr_t {
+    while (index_[slot].signature != 0) {
+      if (index_[slot].signature == signature) {
+        if (instance == 0) {
+          return index_[slot].addr;
+        }
+        --instance;
+      }
+      slot = (slot + 1) & (kIndexSize - 1);
+    }
+    return 0;
+  }
+
+  /// RSDP 物理地址
   uint64_t rsdp_addr_ = 0;
+  /// 物理地址到可访问虚拟地址的偏移
+  uint64_t virt_offset_ = 0;
+  /// 索引是否已构建
+  mutable bool indexed_ = false;
+  /// RSDP/根表的验证结果
+  mutable ErrorCode status_ = ErrorCode::kSuccess;
+  /// 已索引的表数量
+  mutable size_t table_count_ = 0;
+  /// 被跳过的表数量
+  mutable size_t invalid_tables_ = 0;
+  /// 签名 → 表地址散列索引（开放寻址，线性探测）
+  mutable IndexEntry index_[kIndexSize]{};
 };
 
 }  // namespace device_framework::detail::acpi
@@ -0,0 +1,478 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_ACPI_NUMA_TOPOLOGY_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_ACPI_NUMA_TOPOLOGY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "device_framework/detail/acpi/acpi.hpp"
+#include "device_framework/expected.hpp"
+
+namespace device_framework::detail::acpi {
+
+/**
+ * @brief 一个处理器的拓扑信息
+ */
+struct CpuAffinity {
+  /// 硬件 ID（APIC ID / x2APIC ID / MPIDR / RISC-V hart ID）
+  uint64_t hw_id;
+  /// ACPI Processor UID
+  uint32_t uid;
+  /// 所属节点（紧凑编号，见 NumaTopology::GetProximityDomain()）
+  uint16_t node;
+  /// 启动时是否可用（否则仅可在运行时上线）
+  bool enabled;
+};
+
+/**
+ * @brief 一段节点本地内存
+ */
+struct MemoryRange {
+  /// 物理基地址
+  uint64_t base;
+  /// 长度（字节）
+  uint64_t length;
+  /// 所属节点（紧凑编号）
+  uint16_t node;
+  /// 是否可热插拔
+  bool hot_pluggable;
+};
+
+/**
+ * @brief 由 MADT / SRAT / SLIT 提取的 NUMA 拓扑
+ *
+ * Create() 一次性解析三张表并保存为紧凑的定长表：
+ * - CPU → 节点：MADT 的 Local APIC / x2APIC / GICC / RINTC 结构给出处理器
+ *   列表，SRAT 的处理器亲和性结构给出其邻近域（APIC 类按硬件 ID 匹配，
+ *   GICC / RINTC 按 ACPI Processor UID 匹配）
+ * - 节点 → 内存：SRAT 的内存亲和性结构
+ * - 节点间距离：SLIT（缺失时本地 10、远端 20）
+ *
+ * 邻近域编号被压缩为 0..GetNodeCount()-1 的节点编号。没有 SRAT 时
+ * 视为单节点（UMA）系统，全部 CPU 位于节点 0。
+ *
+ * 多队列驱动可用 GetQueueNode() 把队列均匀分给各节点，再用
+ * GetCpusOfNode() / GetMemoryRanges() 选择提交 CPU 与队列内存
+ * （如从节点本地内存分配 VirtioBlk 的 DMA 区域与 DmaBufferPool 后备存储）。
+ *
+ * 使用示例：
+ * @code
+ * Acpi acpi(rsdp_phys);
+ * auto topo = NumaTopology<>::Create(acpi);
+ * uint16_t node = topo->GetQueueNode(queue, queue_count);
+ * size_t n = topo->GetCpusOfNode(node, cpu_ids);
+ * @endcode
+ *
+ * @tparam MaxCpus 可记录的最大处理器数
+ * @tparam MaxNodes 可记录的最大节点数
+ * @tparam MaxRanges 可记录的最大内存区间数
+ * @note 超出容量的处理器、节点或内存区间被忽略，IsTruncated() 返回 true
+ */
+template <size_t MaxCpus = 256, size_t MaxNodes = 16, size_t MaxRanges = 64>
+class NumaTopology {
+ public:
+  /// 本地访问距离（SLIT 约定）
+  static constexpr uint8_t kLocalDistance = 10;
+  /// SLIT 缺失时的远端访问距离
+  static constexpr uint8_t kRemoteDistance = 20;
+
+  static_assert(MaxNodes >= 1 && MaxNodes < UINT16_MAX,
+                "MaxNodes must be in [1, 65534]");
+
+  /**
+   * @brief 解析 MADT / SRAT / SLIT
+   *
+   * @param acpi 已定位 RSDP 的 Acpi 实例
+   * @return 拓扑表；ACPI 表验证失败或缺少 MADT 时返回错误
+   */
+  [[nodiscard]] static auto Create(const Acpi& acpi) -> Expected<NumaTopology> {
+    auto madt = acpi.FindTable<"APIC", Acpi::Madt>();
+    if (!madt) {
+      return std::unexpected(madt.error());
+    }
+    NumaTopology topo;
+    topo.ParseMadt(**madt);
+
+    auto srat = acpi.FindTable<"SRAT", Acpi::Srat>();
+    if (srat) {
+      topo.ParseSrat(**srat);
+    }
+    if (topo.node_count_ == 0) {
+      topo.node_count_ = 1;
+      topo.domains_[0] = 0;
+    }
+
+    topo.InitDistances();
+    auto slit = acpi.FindTable<"SLIT", Acpi::Slit>();
+    if (slit) {
+      topo.ParseSlit(**slit);
+    }
+    return topo;
+  }
+
+  /// @brief 处理器列表（按 MADT 顺序）
+  [[nodiscard]] auto GetCpus() const -> std::span<const CpuAffinity> {
+    return {cpus_, cpu_count_};
+  }
+
+  /// @brief 节点本地内存区间列表（按 SRAT 顺序）
+  [[nodiscard]] auto GetMemoryRanges() const -> std::span<const MemoryRange> {
+    return {ranges_, range_count_};
+  }
+
+  /// @brief 节点数（至少为 1）
+  [[nodiscard]] auto GetNodeCount() const -> size_t { return node_count_; }
+
+  /// @brief 节点对应的 ACPI 邻近域编号
+  [[nodiscard]] auto GetProximityDomain(uint16_t node) const -> uint32_t {
+    return node < node_count_ ? domains_[node] : 0;
+  }
+
+  /**
+   * @brief 按硬件 ID 查找处理器
+   *
+   * @param hw_id APIC ID / x2APIC ID / MPIDR / hart ID
+   * @return 处理器拓扑信息；不存在返回 kInvalidArgument
+   */
+  [[nodiscard]] auto FindCpu(uint64_t hw_id) const
+      -> Expected<const CpuAffinity*> {
+    for (size_t i = 0; i < cpu_count_; ++i) {
+      if (cpus_[i].hw_id == hw_id) {
+        return &cpus_[i];
+      }
+    }
+    return std::unexpected(Error{ErrorCode::kInvalidArgument});
+  }
+
+  /**
+   * @brief 处理器所属节点
+   *
+   * @param hw_id 硬件 ID
+   * @return 节点编号；未知处理器返回 0
+   */
+  [[nodiscard]] auto GetCpuNode(uint64_t hw_id) const -> uint16_t {
+    auto cpu = FindCpu(hw_id);
+    return cpu ? (*cpu)->node : 0;
+  }
+
+  /**
+   * @brief 物理地址所属节点
+   *
+   * @param phys 物理地址
+   * @return 节点编号；不在任何已知区间内返回 kInvalidArgument
+   */
+  [[nodiscard]] auto FindMemoryNode(uint64_t phys) const -> Expected<uint16_t> {
+    for (size_t i = 0; i < range_count_; ++i) {
+      if (phys >= ranges_[i].base &&
+          phys - ranges_[i].base < ranges_[i].length) {
+        return ranges_[i].node;
+      }
+    }
+    return std::unexpected(Error{ErrorCode::kInvalidArgument});
+  }
+
+  /**
+   * @brief 节点间访问距离
+   *
+   * @return SLIT 给出的相对距离（本地为 10）；节点编号越界返回 0xFF
+   */
+  [[nodiscard]] auto GetDistance(uint16_t from, uint16_t to) const -> uint8_t {
+    if (from >= node_count_ || to >= node_count_) {
+      return 0xFF;
+    }
+    return distances_[from][to];
+  }
+
+  /**
+   * @brief 列出节点上的处理器
+   *
+   * @param node 节点编号
+   * @param hw_ids 输出硬件 ID 数组
+   * @return 节点上的处理器总数（可能大于 hw_ids.size()，只写入前若干个）
+   */
+  [[nodiscard]] auto GetCpusOfNode(uint16_t node,
+                                   std::span<uint64_t> hw_ids) const -> size_t {
+    size_t count = 0;
+    for (size_t i = 0; i < cpu_count_; ++i) {
+      if (cpus_[i].node != node) {
+        continue;
+      }
+      if (count < hw_ids.size()) {
+        hw_ids[count] = cpus_[i].hw_id;
+      }
+      ++count;
+    }
+    return count;
+  }
+
+  /**
+   * @brief 队列应绑定的节点
+   *
+   * 把 queue_count 个队列按编号连续、均匀地分给各节点
+   * （队列数少于节点数时只使用前 queue_count 个节点）。
+   *
+   * @param queue 队列编号
+   * @param queue_count 队列总数
+   * @return 节点编号
+   */
+  [[nodiscard]] auto GetQueueNode(size_t queue, size_t queue_count) const
+      -> uint16_t {
+    if (queue_count == 0 || queue >= queue_count) {
+      return 0;
+    }
+    size_t nodes = node_count_ < queue_count ? node_count_ : queue_count;
+    return static_cast<uint16_t>(queue * nodes / queue_count);
+  }
+
+  /// @brief 是否有处理器、节点或内存区间因容量不足被忽略
+  [[nodiscard]] auto IsTruncated() const -> bool { return truncated_; }
+
+ private:
+  /// 无效节点编号
+  static constexpr uint16_t kNoNode = UINT16_MAX;
+
+  NumaTopology() = default;
+
+  /**
+   * @brief 遍历表头之后 offset 字节开始的 {type, length} 结构序列
+   *
+   * @tparam Visitor 签名：void(const Acpi::SubtableHeader& entry)
+   */
+  template <typename Visitor>
+  static auto ForEachSubtable(const Acpi::DescriptionHeader& header,
+                              size_t offset, Visitor&& visit) -> void {
+    const auto* base = reinterpret_cast<const uint8_t*>(&header);
+    while (offset + sizeof(Acpi::SubtableHeader) <= header.length) {
+      const auto* entry =
+          reinterpret_cast<const Acpi::SubtableHeader*>(base + offset);
+      if (entry->length < sizeof(Acpi::SubtableHeader) ||
+          offset + entry->length > header.length) {
+        break;
+      }
+      visit(*entry);
+      offset += entry->length;
+    }
+  }
+
+  /// @brief 追加一个处理器（不可用且不可上线的处理器忽略）
+  auto AddCpu(uint64_t hw_id, uint32_t uid, uint32_t flags) -> void {
+    if ((flags & (Acpi::kMadtEnabled | Acpi::kMadtOnlineCapable)) == 0) {
+      return;
+    }
+    if (cpu_count_ >= MaxCpus) {
+      truncated_ = true;
+      return;
+    }
+    cpus_[cpu_count_++] = {hw_id, uid, 0,
+                           (flags & Acpi::kMadtEnabled) != 0};
+  }
+
+  /// @brief 提取 MADT 中的处理器结构
+  auto ParseMadt(const Acpi::Madt& madt) -> void {
+    ForEachSubtable(
+        madt.header, sizeof(Acpi::Madt),
+        [this](const Acpi::SubtableHeader& entry) {
+          switch (static_cast<Acpi::MadtType>(entry.type)) {
+            case Acpi::MadtType::kLocalApic:
+              if (entry.length >= sizeof(Acpi::MadtLocalApic)) {
+                const auto& lapic =
+                    reinterpret_cast<const Acpi::MadtLocalApic&>(entry);
+                AddCpu(lapic.apic_id, lapic.acpi_processor_uid, lapic.flags);
+              }
+              break;
+            case Acpi::MadtType::kLocalX2apic:
+              if (entry.length >= sizeof(Acpi::MadtLocalX2apic)) {
+                const auto& x2apic =
+                    reinterpret_cast<const Acpi::MadtLocalX2apic&>(entry);
+                AddCpu(x2apic.x2apic_id, x2apic.acpi_processor_uid,
+                       x2apic.flags);
+              }
+              break;
+            case Acpi::MadtType::kGicc:
+              if (entry.length >= sizeof(Acpi::MadtGicc)) {
+                const auto& gicc =
+                    reinterpret_cast<const Acpi::MadtGicc&>(entry);
+                AddCpu(gicc.mpidr, gicc.acpi_processor_uid, gicc.flags);
+              }
+              break;
+            case Acpi::MadtType::kRintc:
+              if (entry.length >= sizeof(Acpi::MadtRintc)) {
+                const auto& rintc =
+                    reinterpret_cast<const Acpi::MadtRintc&>(entry);
+                AddCpu(rintc.hart_id, rintc.acpi_processor_uid, rintc.flags);
+              }
+              break;
+            default:
+              break;
+          }
+        });
+  }
+
+  /**
+   * @brief 邻近域对应的节点编号（首次出现时分配）
+   *
+   * @return 节点编号；节点表已满返回 kNoNode
+   */
+  auto NodeOf(uint32_t domain) -> uint16_t {
+    for (size_t i = 0; i < node_count_; ++i) {
+      if (domains_[i] == domain) {
+        return static_cast<uint16_t>(i);
+      }
+    }
+    if (node_count_ >= MaxNodes) {
+      truncated_ = true;
+      return kNoNode;
+    }
+    domains_[node_count_] = domain;
+    return static_cast<uint16_t>(node_count_++);
+  }
+
+  /**
+   * @brief 为匹配的处理器设置节点
+   *
+   * @param by_uid true 按 ACPI Processor UID 匹配，否则按硬件 ID 匹配
+   */
+  auto AssignCpu(bool by_uid, uint64_t id, uint32_t domain, uint32_t flags)
+      -> void {
+    if ((flags & Acpi::kSratEnabled) == 0) {
+      return;
+    }
+    uint16_t node = NodeOf(domain);
+    if (node == kNoNode) {
+      return;
+    }
+    for (size_t i = 0; i < cpu_count_; ++i) {
+      if ((by_uid ? cpus_[i].uid : cpus_[i].hw_id) == id) {
+        cpus_[i].node = node;
+        return;
+      }
+    }
+  }
+
+  /// @brief 提取 SRAT 中的处理器与内存亲和性结构
+  auto ParseSrat(const Acpi::Srat& srat) -> void {
+    ForEachSubtable(
+        srat.header, sizeof(Acpi::Srat),
+        [this](const Acpi::SubtableHeader& entry) {
+          switch (static_cast<Acpi::SratType>(entry.type)) {
+            case Acpi::SratType::kProcessorAffinity:
+              if (entry.length >= sizeof(Acpi::SratProcessorAffinity)) {
+                const auto& cpu =
+                    reinterpret_cast<const Acpi::SratProcessorAffinity&>(
+                        entry);
+                uint32_t domain =
+                    cpu.proximity_domain_lo |
+                    static_cast<uint32_t>(cpu.proximity_domain_hi[0]) << 8 |
+                    static_cast<uint32_t>(cpu.proximity_domain_hi[1]) << 16 |
+                    static_cast<uint32_t>(cpu.proximity_domain_hi[2]) << 24;
+                AssignCpu(false, cpu.apic_id, domain, cpu.flags);
+              }
+              break;
+            case Acpi::SratType::kX2apicAffinity:
+              if (entry.length >= sizeof(Acpi::SratX2apicAffinity)) {
+                const auto& cpu =
+                    reinterpret_cast<const Acpi::SratX2apicAffinity&>(entry);
+                AssignCpu(false, cpu.x2apic_id, cpu.proximity_domain,
+                          cpu.flags);
+              }
+              break;
+            case Acpi::SratType::kGiccAffinity:
+              if (entry.length >= sizeof(Acpi::SratGiccAffinity)) {
+                const auto& cpu =
+                    reinterpret_cast<const Acpi::SratGiccAffinity&>(entry);
+                AssignCpu(true, cpu.acpi_processor_uid, cpu.proximity_domain,
+                          cpu.flags);
+              }
+              break;
+            case Acpi::SratType::kRintcAffinity:
+              if (entry.length >= sizeof(Acpi::SratRintcAffinity)) {
+                const auto& cpu =
+                    reinterpret_cast<const Acpi::SratRintcAffinity&>(entry);
+                AssignCpu(true, cpu.acpi_processor_uid, cpu.proximity_domain,
+                          cpu.flags);
+              }
+              break;
+            case Acpi::SratType::kMemoryAffinity:
+              if (entry.length >= sizeof(Acpi::SratMemoryAffinity)) {
+                AddRange(
+                    reinterpret_cast<const Acpi::SratMemoryAffinity&>(entry));
+              }
+              break;
+            default:
+              break;
+          }
+        });
+  }
+
+  /// @brief 追加一段内存区间
+  auto AddRange(const Acpi::SratMemoryAffinity& mem) -> void {
+    if ((mem.flags & Acpi::kSratEnabled) == 0 || mem.length == 0) {
+      return;
+    }
+    uint16_t node = NodeOf(mem.proximity_domain);
+    if (node == kNoNode) {
+      return;
+    }
+    if (range_count_ >= MaxRanges) {
+      truncated_ = true;
+      return;
+    }
+    ranges_[range_count_++] = {mem.base_address, mem.length, node,
+                               (mem.flags & Acpi::kSratHotPluggable) != 0};
+  }
+
+  /// @brief 默认距离：本地 10，远端 20
+  auto InitDistances() -> void {
+    for (size_t i = 0; i < MaxNodes; ++i) {
+      for (size_t j = 0; j < MaxNodes; ++j) {
+        distances_[i][j] = i == j ? kLocalDistance : kRemoteDistance;
+      }
+    }
+  }
+
+  /// @brief 按邻近域编号从 SLIT 矩阵取节点间距离
+  auto ParseSlit(const Acpi::Slit& slit) -> void {
+    uint64_t localities = slit.number_of_localities;
+    if (slit.header.length < sizeof(Acpi::Slit) || localities == 0 ||
+        localities > (slit.header.length - sizeof(Acpi::Slit)) / localities) {
+      return;
+    }
+    const auto* matrix =
+        reinterpret_cast<const uint8_t*>(&slit) + sizeof(Acpi::Slit);
+    for (size_t i = 0; i < node_count_; ++i) {
+      for (size_t j = 0; j < node_count_; ++j) {
+        uint64_t from = domains_[i];
+        uint64_t to = domains_[j];
+        if (from < localities && to < localities) {
+          distances_[i][j] = matrix[from * localities + to];
+        }
+      }
+    }
+  }
+
+  /// 处理器表
+  CpuAffinity cpus_[MaxCpus]{};
+  /// 处理器数
+  size_t cpu_count_ = 0;
+  /// 内存区间表
+  MemoryRange ranges_[MaxRanges]{};
+  /// 内存区间数
+  size_t range_count_ = 0;
+  /// 节点编号 → 邻近域编号
+  uint32_t domains_[MaxNodes]{};
+  /// 节点数
+  size_t node_count_ = 0;
+  /// 节点间距离矩阵
+  uint8_t distances_[MaxNodes][MaxNodes]{};
+  /// 是否有条目因容量不足被忽略
+  bool truncated_ = false;
+};
+
+}  // namespace device_framework::detail::acpi
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_ACPI_NUMA_TOPOLOGY_HPP_ \
+        */
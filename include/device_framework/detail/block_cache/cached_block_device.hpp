@@ -0,0 +1,855 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_BLOCK_CACHE_CACHED_BLOCK_DEVICE_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_BLOCK_CACHE_CACHED_BLOCK_DEVICE_HPP_
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "device_framework/expected.hpp"
+#include "device_framework/ops/block_device.hpp"
+
+namespace device_framework::detail::block_cache {
+
+/**
+ * @brief 块缓存统计数据
+ */
+struct CacheStats {
+  /// 命中缓存的块数
+  uint64_t hits{0};
+  /// 未命中、从设备读取的块数
+  uint64_t misses{0};
+  /// 被 CLOCK 淘汰的缓存页数
+  uint64_t evictions{0};
+  /// 回写提交的设备请求数（合并后）
+  uint64_t writeback_requests{0};
+  /// 回写的块数
+  uint64_t writeback_blocks{0};
+  /// 预读提交的块数
+  uint64_t readahead_blocks{0};
+  /// 预读的块在淘汰前被读取的次数
+  uint64_t readahead_hits{0};
+};
+
+/**
+ * @brief 写回式块缓存适配器
+ *
+ * 在任意 BlockDevice 之上实现 BlockDevice 接口：
+ * - 缓存页来自调用者提供的 DMA 可访问内存池（Capacity 页，每页一个块），
+ *   不使用堆分配
+ * - 块号 → 缓存页通过 Fibonacci 散列 + 链式桶查找，平均 O(1)
+ * - CLOCK（二次机会）淘汰；淘汰脏页时先回写其所在的连续脏块区间
+ * - 写操作只更新缓存页并标记为脏，Flush()/Release() 时回写
+ * - 回写按块号连续的脏页区间合并，池内相邻的页合并为一个多块请求，
+ *   通过内层设备的 SubmitWriteBlocks()/Reap() 批量提交
+ *
+ * 未命中的连续块直接读入调用者缓冲区（单个多块请求），再复制到缓存页，
+ * 因此调用者缓冲区与内层设备的要求相同（需 DMA 可访问）。
+ *
+ * 顺序预读：DoReadBlocks 检测到与上次读取首尾相接的访问后，通过内层设备的
+ * SubmitReadBlocks() 异步读取后续窗口到缓存页；读到预读窗口后半段时提交
+ * 下一个窗口。窗口在顺序流持续时加倍（不超过 SetReadAhead() 设定的上限），
+ * 预读的页未被读取即被淘汰时减半。
+ *
+ * 内层设备报告最优 I/O 大小（GetIoHints().opt_io_size）时，回写与预读
+ * 请求在最优 I/O 边界处切分，预读窗口的末尾向上取整到边界。
+ *
+ * 使用示例：
+ * @code
+ * alignas(4096) static uint8_t pool[64 * 512];
+ * auto cached = CachedBlockDevice<VirtioBlkDevice<MyTraits>, 64>::Create(
+ *     std::move(*dev_result), pool);
+ * cached->OpenReadWrite();
+ * cached->ReadBlock(0, buffer);   // 设备读取
+ * cached->ReadBlock(0, buffer);   // 缓存命中
+ * cached->Flush();                // 回写脏页并刷新设备缓存
+ * @endcode
+ *
+ * @tparam Inner 内层块设备类型（BlockDevice<Inner> 的派生类）
+ * @tparam Capacity 缓存页数量
+ * @note 异步接口使用 BlockDevice 的同步回退实现
+ * @note 非线程安全，多个上下文并发使用时需由调用者同步
+ * @see BlockDevice
+ */
+template <class Inner, size_t Capacity>
+class CachedBlockDevice
+    : public BlockDevice<CachedBlockDevice<Inner, Capacity>> {
+  static_assert(std::derived_from<Inner, BlockDevice<Inner>>,
+                "Inner must be a BlockDevice");
+  static_assert(Capacity >= 1 && Capacity < (size_t{1} << 31),
+                "Capacity must be in [1, 2^31)");
+
+ public:
+  /// 缓存页数量
+  static constexpr size_t kCapacity = Capacity;
+
+  /**
+   * @brief 创建块缓存
+   *
+   * @param inner 内层块设备（尚未打开；所有权转移给缓存）
+   * @param pool 缓存页内存池（DMA 可访问，
+   *        大小 >= Capacity * inner.GetBlockSize()）
+   * @return 成功返回 CachedBlockDevice 实例，失败返回错误
+   */
+  [[nodiscard]] static auto Create(Inner inner, std::span<uint8_t> pool)
+      -> Expected<CachedBlockDevice> {
+    size_t block_size = inner.GetBlockSize();
+    if (block_size == 0) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+    }
+    if (pool.data() == nullptr || pool.size() < Capacity * block_size) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    return CachedBlockDevice(std::move(inner), pool.data(), block_size);
+  }
+
+  /// @brief 直接访问内层块设备
+  [[nodiscard]] auto GetInner() -> Inner& { return inner_; }
+  [[nodiscard]] auto GetInner() const -> const Inner& { return inner_; }
+
+  /**
+   * @brief 获取缓存统计数据
+   */
+  [[nodiscard]] auto GetStats() const -> CacheStats { return stats_; }
+
+  /**
+   * @brief 设置预读窗口上限
+   *
+   * @param max_blocks 预读窗口的最大块数（不超过 Capacity / 2），0 表示禁用
+   */
+  auto SetReadAhead(size_t max_blocks) -> void {
+    ra_max_window_ = max_blocks < Capacity / 2 ? max_blocks : Capacity / 2;
+    ra_window_ = ra_max_window_ < kMinReadAhead ? ra_max_window_
+                                                : kMinReadAhead;
+  }
+
+  /**
+   * @brief 获取当前预读窗口大小（块数）
+   */
+  [[nodiscard]] auto GetReadAheadWindow() const -> size_t {
+    return ra_window_;
+  }
+
+  /**
+   * @brief 获取当前脏页数量
+   */
+  [[nodiscard]] auto GetDirtyCount() const -> size_t {
+    size_t count = 0;
+    for (const auto& entry : entries_) {
+      count += (entry.valid && entry.dirty) ? 1 : 0;
+    }
+    return count;
+  }
+
+  /// @name 移动/拷贝控制
+  /// @{
+  CachedBlockDevice(CachedBlockDevice&&) noexcept = default;
+  auto operator=(CachedBlockDevice&&) noexcept -> CachedBlockDevice& = default;
+  CachedBlockDevice(const CachedBlockDevice&) = delete;
+  auto operator=(const CachedBlockDevice&) -> CachedBlockDevice& = delete;
+  ~CachedBlockDevice() = default;
+  /// @}
+
+ protected:
+  /**
+   * @brief 打开设备（同时以相同模式打开内层设备）
+   */
+  auto DoOpen(OpenFlags flags) -> Expected<void> {
+    auto result = inner_.Open(flags);
+    if (!result) {
+      return result;
+    }
+    flags_ = flags;
+    return {};
+  }
+
+  /**
+   * @brief 释放设备（回写全部脏页后释放内层设备）
+   */
+  auto DoRelease() -> Expected<void> {
+    auto result = WriteBackAll();
+    if (!result) {
+      return result;
+    }
+    return inner_.Release();
+  }
+
+  /**
+   * @brief 读取多个块
+   *
+   * 命中的块从缓存页复制；未命中的连续块以一个请求读入 buffer，
+   * 随后填充到缓存页。
+   *
+   * @param block_no 起始块号
+   * @param buffer 目标缓冲区
+   * @param block_count 块数量
+   * @return 实际读取的块数
+   */
+  auto DoReadBlocks(uint64_t block_no, std::span<uint8_t> buffer,
+                    size_t block_count) -> Expected<size_t> {
+    if (!flags_.CanRead()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    bool sequential = block_no == next_sequential_;
+    size_t done = 0;
+    while (done < block_count) {
+      uint32_t idx = Lookup(block_no + done);
+      if (idx != kNoEntry && entries_[idx].loading) {
+        auto wait = WaitLoaded(idx);
+        if (!wait) {
+          return std::unexpected(wait.error());
+        }
+        if (!*wait) {
+          // 预读失败，页已被移除，按未命中处理
+          idx = kNoEntry;
+        }
+      }
+      if (idx != kNoEntry) {
+        auto& entry = entries_[idx];
+        __builtin_memcpy(buffer.data() + done * block_size_, Page(idx),
+                         block_size_);
+        entry.referenced = true;
+        if (entry.prefetched) {
+          entry.prefetched = false;
+          stats_.readahead_hits++;
+        }
+        stats_.hits++;
+        ++done;
+        continue;
+      }
+
+      size_t run = 1;
+      while (done + run < block_count &&
+             Lookup(block_no + done + run) == kNoEntry) {
+        ++run;
+      }
+      stats_.misses += run;
+      auto result = inner_.ReadBlocks(
+          block_no + done, buffer.subspan(done * block_size_), run);
+      if (!result) {
+        if (done == 0) {
+          return std::unexpected(result.error());
+        }
+        return done;
+      }
+      for (size_t i = 0; i < *result; ++i) {
+        // 缓存页分配失败（回写出错）不影响本次读取结果
+        (void)Fill(block_no + done + i,
+                   buffer.data() + (done + i) * block_size_);
+      }
+      done += *result;
+      if (*result < run) {
+        break;
+      }
+    }
+    next_sequential_ = block_no + done;
+    ReadAhead(block_no + done, sequential);
+    return done;
+  }
+
+  /**
+   * @brief 写入多个块（只更新缓存页并标记为脏）
+   *
+   * @param block_no 起始块号
+   * @param data 待写入数据
+   * @param block_count 块数量
+   * @return 实际写入缓存的块数
+   */
+  auto DoWriteBlocks(uint64_t block_no, std::span<const uint8_t> data,
+                     size_t block_count) -> Expected<size_t> {
+    if (!flags_.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    for (size_t i = 0; i < block_count; ++i) {
+      uint32_t idx = Lookup(block_no + i);
+      // 预读中的页须等待读取完成，避免设备数据覆盖新写入的内容
+      if (idx != kNoEntry && entries_[idx].loading) {
+        auto wait = WaitLoaded(idx);
+        if (!wait) {
+          return std::unexpected(wait.error());
+        }
+        if (!*wait) {
+          idx = kNoEntry;
+        }
+      }
+      if (idx == kNoEntry) {
+        auto alloc = AllocEntry(block_no + i);
+        if (!alloc) {
+          if (i == 0) {
+            return std::unexpected(alloc.error());
+          }
+          return i;
+        }
+        idx = *alloc;
+      }
+      __builtin_memcpy(Page(idx), data.data() + i * block_size_, block_size_);
+      entries_[idx].dirty = true;
+      entries_[idx].referenced = true;
+    }
+    return block_count;
+  }
+
+  /**
+   * @brief 回写全部脏页并刷新内层设备
+   *
+   * 内层设备不支持 Flush（kDeviceNotSupported）时视为写直通。
+   */
+  auto DoFlush() -> Expected<void> {
+    auto result = WriteBackAll();
+    if (!result) {
+      return result;
+    }
+    auto flush = inner_.Flush();
+    if (!flush && flush.error().code != ErrorCode::kDeviceNotSupported) {
+      return flush;
+    }
+    return {};
+  }
+
+  /**
+   * @brief 获取块大小（与内层设备一致）
+   */
+  auto DoGetBlockSize() const -> size_t { return block_size_; }
+
+  /**
+   * @brief 获取设备总块数（与内层设备一致）
+   */
+  auto DoGetBlockCount() const -> uint64_t { return inner_.GetBlockCount(); }
+
+  /**
+   * @brief 获取 I/O 提示（与内层设备一致）
+   */
+  auto DoGetIoHints() const -> BlockIoHints { return inner_.GetIoHints(); }
+
+ private:
+  /// 无效缓存页索引
+  static constexpr uint32_t kNoEntry = static_cast<uint32_t>(-1);
+  /// 散列桶数量（>= 2 * Capacity 的 2 的幂）
+  static constexpr size_t kBuckets = std::bit_ceil(Capacity * 2);
+  /// 散列桶索引位数
+  static constexpr int kBucketBits = std::countr_zero(kBuckets);
+  /// 等待在途请求完成的最大轮询次数
+  static constexpr uint32_t kMaxPollIterations = 100000000;
+  /// 预读窗口下限（块数）
+  static constexpr size_t kMinReadAhead = 4;
+  /// 默认预读窗口上限（块数）
+  static constexpr size_t kDefaultMaxReadAhead =
+      Capacity / 4 < 32 ? Capacity / 4 : 32;
+  /// 无效块号（尚无顺序访问记录）
+  static constexpr uint64_t kNoBlock = static_cast<uint64_t>(-1);
+
+  /**
+   * @brief 缓存页元数据
+   */
+  struct CacheEntry {
+    /// 缓存的块号
+    uint64_t block_no = 0;
+    /// 同一散列桶中的下一个缓存页
+    uint32_t hash_next = kNoEntry;
+    /// 缓存页是否有效
+    bool valid = false;
+    /// 缓存页内容是否比设备新
+    bool dirty = false;
+    /// CLOCK 访问位
+    bool referenced = false;
+    /// 是否有在途的回写请求
+    bool writing = false;
+    /// 是否有在途的预读请求（页内容尚未有效）
+    bool loading = false;
+    /// 由预读填充且尚未被读取
+    bool prefetched = false;
+    /// 以本页开始的在途请求覆盖的页数（仅请求首页有效）
+    uint32_t io_count = 0;
+  };
+
+  /// @brief 只能通过 Create() 工厂方法创建
+  CachedBlockDevice(Inner inner, uint8_t* pool, size_t block_size)
+      : inner_(std::move(inner)), pool_(pool), block_size_(block_size) {
+    for (auto& bucket : buckets_) {
+      bucket = kNoEntry;
+    }
+    auto hints = inner_.GetIoHints();
+    io_align_ = hints.opt_io_size;
+    io_align_offset_ = hints.alignment_offset;
+    SetReadAhead(kDefaultMaxReadAhead);
+  }
+
+  /**
+   * @brief 块号是否位于内层设备的最优 I/O 边界上
+   */
+  [[nodiscard]] auto OnIoBoundary(uint64_t block_no) const -> bool {
+    return io_align_ > 1 && block_no >= io_align_offset_ &&
+           (block_no - io_align_offset_) % io_align_ == 0;
+  }
+
+  /**
+   * @brief 块号的散列桶索引（Fibonacci 散列）
+   */
+  [[nodiscard]] static constexpr auto Bucket(uint64_t block_no) -> size_t {
+    if constexpr (kBucketBits == 0) {
+      return 0;
+    } else {
+      return static_cast<size_t>((block_no * 0x9E3779B97F4A7C15ULL) >>
+                                 (64 - kBucketBits));
+    }
+  }
+
+  /**
+   * @brief 缓存页数据地址
+   */
+  [[nodiscard]] auto Page(uint32_t idx) const -> uint8_t* {
+    return pool_ + static_cast<size_t>(idx) * block_size_;
+  }
+
+  /**
+   * @brief 查找块号对应的缓存页
+   *
+   * @return 缓存页索引，未命中返回 kNoEntry
+   */
+  [[nodiscard]] auto Lookup(uint64_t block_no) const -> uint32_t {
+    uint32_t idx = buckets_[Bucket(block_no)];
+    while (idx != kNoEntry && entries_[idx].block_no != block_no) {
+      idx = entries_[idx].hash_next;
+    }
+    return idx;
+  }
+
+  /**
+   * @brief 将缓存页从散列桶中移除并置为无效
+   */
+  auto Evict(uint32_t idx) -> void {
+    auto& entry = entries_[idx];
+    uint32_t* link = &buckets_[Bucket(entry.block_no)];
+    while (*link != idx) {
+      link = &entries_[*link].hash_next;
+    }
+    *link = entry.hash_next;
+    entry = CacheEntry{};
+  }
+
+  /**
+   * @brief 为块号分配一个缓存页（CLOCK 淘汰）
+   *
+   * 最多扫描两轮：第一轮清除访问位，第二轮必然找到可淘汰的页
+   * （跳过有在途请求的页；全部页都有在途请求时先回收完成再重新扫描）。
+   * 被淘汰的页为脏页时先回写其所在的连续脏块区间；预读的页未被读取
+   * 即被淘汰时预读窗口减半。
+   *
+   * @param block_no 新缓存页的块号
+   * @return 已插入散列桶的缓存页索引（dirty/referenced 为 false）
+   */
+  auto AllocEntry(uint64_t block_no) -> Expected<uint32_t> {
+    while (true) {
+      for (size_t scanned = 0; scanned < 2 * Capacity + 1; ++scanned) {
+        auto idx = static_cast<uint32_t>(clock_hand_);
+        clock_hand_ = (clock_hand_ + 1) % Capacity;
+        auto& entry = entries_[idx];
+        if (entry.valid) {
+          if (entry.loading || entry.writing) {
+            continue;
+          }
+          if (entry.referenced) {
+            entry.referenced = false;
+            continue;
+          }
+          if (entry.dirty) {
+            auto result = WriteBackRun(entry.block_no);
+            if (!result) {
+              return std::unexpected(result.error());
+            }
+          }
+          if (entry.prefetched) {
+            ShrinkReadAhead();
+          }
+          Evict(idx);
+          stats_.evictions++;
+        }
+
+        auto& bucket = buckets_[Bucket(block_no)];
+        entry.block_no = block_no;
+        entry.valid = true;
+        entry.hash_next = bucket;
+        bucket = idx;
+        return idx;
+      }
+      if (io_inflight_ == 0) {
+        return std::unexpected(Error{ErrorCode::kOutOfMemory});
+      }
+      auto reap = ReapCompletions();
+      if (!reap) {
+        return std::unexpected(reap.error());
+      }
+    }
+  }
+
+  /**
+   * @brief 将从设备读取的块数据填充到缓存页
+   */
+  auto Fill(uint64_t block_no, const uint8_t* data) -> Expected<void> {
+    auto alloc = AllocEntry(block_no);
+    if (!alloc) {
+      return std::unexpected(alloc.error());
+    }
+    __builtin_memcpy(Page(*alloc), data, block_size_);
+    return {};
+  }
+
+  /**
+   * @brief 块号对应的缓存页是否需要回写（脏且没有在途回写）
+   */
+  [[nodiscard]] auto NeedsWriteBack(uint64_t block_no) const -> bool {
+    uint32_t idx = Lookup(block_no);
+    return idx != kNoEntry && entries_[idx].dirty && !entries_[idx].writing;
+  }
+
+  /**
+   * @brief 提交从 block_no 开始的连续脏块区间的回写
+   *
+   * 块号连续且池内相邻的缓存页合并为一个多块请求（不跨越最优 I/O
+   * 边界）；内层设备完成记录已满时先回收已完成的回写再继续提交。
+   *
+   * @param block_no 区间起始块号（须满足 NeedsWriteBack）
+   * @return 成功或首个提交失败的错误
+   */
+  auto SubmitRun(uint64_t block_no) -> Expected<void> {
+    while (NeedsWriteBack(block_no)) {
+      uint32_t first = Lookup(block_no);
+      size_t count = 1;
+      while (first + count < Capacity && NeedsWriteBack(block_no + count) &&
+             Lookup(block_no + count) == first + count &&
+             !OnIoBoundary(block_no + count)) {
+        ++count;
+      }
+
+      auto data = std::span<const uint8_t>(Page(first), count * block_size_);
+      auto* token =
+          reinterpret_cast<void*>(static_cast<uintptr_t>(first) + 1);
+      auto result = inner_.SubmitWriteBlocks(block_no, data, count, token);
+      while (!result && result.error().code == ErrorCode::kDeviceBusy &&
+             io_inflight_ > 0) {
+        auto reap = ReapCompletions();
+        if (!reap) {
+          return reap;
+        }
+        result = inner_.SubmitWriteBlocks(block_no, data, count, token);
+      }
+      if (!result) {
+        return result;
+      }
+
+      for (size_t i = 0; i < count; ++i) {
+        entries_[first + i].writing = true;
+      }
+      entries_[first].io_count = static_cast<uint32_t>(count);
+      ++io_inflight_;
+      stats_.writeback_requests++;
+      block_no += count;
+    }
+    return {};
+  }
+
+  /**
+   * @brief 回收至少一个已完成的回写/预读请求
+   *
+   * 回写成功的缓存页清除脏标志；失败的保持为脏，错误记录在
+   * writeback_error_ 中。预读成功的页变为有效，失败的页被移除。
+   *
+   * @return 成功，或等待超时返回 kTimeout
+   */
+  auto ReapCompletions() -> Expected<void> {
+    for (uint32_t spin = 0; spin < kMaxPollIterations; ++spin) {
+      BlockCompletion completions[BlockDevice<Inner>::kMaxCompletions];
+      size_t reaped = inner_.Reap(completions);
+      for (size_t i = 0; i < reaped; ++i) {
+        const auto& completion = completions[i];
+        auto first = static_cast<uint32_t>(
+            reinterpret_cast<uintptr_t>(completion.token) - 1);
+        uint32_t count = entries_[first].io_count;
+        bool load = entries_[first].loading;
+        entries_[first].io_count = 0;
+        --io_inflight_;
+        if (load) {
+          for (uint32_t idx = first; idx < first + count; ++idx) {
+            entries_[idx].loading = false;
+            if (completion.status != ErrorCode::kSuccess) {
+              Evict(idx);
+            }
+          }
+          continue;
+        }
+        for (uint32_t idx = first; idx < first + count; ++idx) {
+          auto& entry = entries_[idx];
+          entry.writing = false;
+          if (completion.status == ErrorCode::kSuccess) {
+            entry.dirty = false;
+            stats_.writeback_blocks++;
+          }
+        }
+        if (completion.status != ErrorCode::kSuccess &&
+            writeback_error_ == ErrorCode::kSuccess) {
+          writeback_error_ = completion.status;
+        }
+      }
+      if (reaped > 0) {
+        return {};
+      }
+    }
+    return std::unexpected(Error{ErrorCode::kTimeout});
+  }
+
+  /**
+   * @brief 等待全部在途回写/预读请求完成
+   *
+   * @return 成功，或首个回写失败/超时的错误
+   */
+  auto DrainIo() -> Expected<void> {
+    while (io_inflight_ > 0) {
+      auto result = ReapCompletions();
+      if (!result) {
+        return result;
+      }
+    }
+    ErrorCode error = writeback_error_;
+    writeback_error_ = ErrorCode::kSuccess;
+    if (error != ErrorCode::kSuccess) {
+      return std::unexpected(Error{error});
+    }
+    return {};
+  }
+
+  /**
+   * @brief 同步回写包含 block_no 的连续脏块区间
+   */
+  auto WriteBackRun(uint64_t block_no) -> Expected<void> {
+    while (block_no > 0 && NeedsWriteBack(block_no - 1)) {
+      --block_no;
+    }
+    auto result = SubmitRun(block_no);
+    auto drain = DrainIo();
+    if (!result) {
+      return result;
+    }
+    return drain;
+  }
+
+  /**
+   * @brief 回写全部脏页
+   *
+   * 以每个连续脏块区间的起点提交该区间，全部提交后统一等待完成。
+   */
+  auto WriteBackAll() -> Expected<void> {
+    Expected<void> result{};
+    for (const auto& entry : entries_) {
+      if (!entry.valid || !entry.dirty || entry.writing) {
+        continue;
+      }
+      if (entry.block_no > 0 && NeedsWriteBack(entry.block_no - 1)) {
+        continue;
+      }
+      result = SubmitRun(entry.block_no);
+      if (!result) {
+        break;
+      }
+    }
+    auto drain = DrainIo();
+    if (!result) {
+      return result;
+    }
+    return drain;
+  }
+
+  /**
+   * @brief 等待预读中的页读取完成
+   *
+   * @param idx 缓存页索引（loading 为 true）
+   * @return 页内容有效返回 true，预读失败（页已移除）返回 false；
+   *         等待超时返回 kTimeout
+   */
+  auto WaitLoaded(uint32_t idx) -> Expected<bool> {
+    while (entries_[idx].loading) {
+      auto result = ReapCompletions();
+      if (!result) {
+        return std::unexpected(result.error());
+      }
+    }
+    return entries_[idx].valid;
+  }
+
+  /**
+   * @brief 预读的页未被读取即被淘汰：窗口减半
+   */
+  auto ShrinkReadAhead() -> void {
+    size_t window = ra_window_ / 2 < kMinReadAhead ? kMinReadAhead
+                                                  : ra_window_ / 2;
+    ra_window_ = window < ra_max_window_ ? window : ra_max_window_;
+  }
+
+  /**
+   * @brief 读取完成后按访问模式提交预读
+   *
+   * 非顺序访问重置预读状态；顺序访问在尚无预读或已读到预读窗口后半段时，
+   * 从预读窗口末尾提交下一个窗口，并将窗口加倍。提交的窗口末尾向上
+   * 取整到最优 I/O 边界（不超过 Capacity / 2）。
+   *
+   * @param next_block 本次读取之后的下一个块号
+   * @param sequential 本次读取是否与上次读取首尾相接
+   */
+  auto ReadAhead(uint64_t next_block, bool sequential) -> void {
+    if (ra_max_window_ == 0) {
+      return;
+    }
+    if (!sequential) {
+      ra_end_ = next_block;
+      ShrinkReadAhead();
+      return;
+    }
+    if (ra_end_ < next_block) {
+      ra_end_ = next_block;
+    }
+    if (ra_end_ - next_block > ra_window_ / 2) {
+      return;
+    }
+    size_t window = ra_window_;
+    ra_window_ = ra_window_ * 2 > ra_max_window_ ? ra_max_window_
+                                                 : ra_window_ * 2;
+    if (io_align_ > 1) {
+      uint64_t end = ra_end_ + window;
+      uint64_t extra = 0;
+      if (end < io_align_offset_) {
+        extra = io_align_offset_ - end;
+      } else if ((end - io_align_offset_) % io_align_ != 0) {
+        extra = io_align_ - (end - io_align_offset_) % io_align_;
+      }
+      if (window + extra <= Capacity / 2) {
+        window += extra;
+      }
+    }
+    SubmitReadAhead(ra_end_, window);
+  }
+
+  /**
+   * @brief 异步预读 [block_no, block_no + count) 中尚未缓存的块
+   *
+   * 块号连续且池内相邻的页合并为一个请求（不跨越最优 I/O 边界）。
+   * 分配失败或提交失败（如内层设备忙）时停止本次预读，不影响正常读写。
+   *
+   * @param block_no 起始块号
+   * @param count 块数
+   */
+  auto SubmitReadAhead(uint64_t block_no, size_t count) -> void {
+    uint64_t end = block_no + count;
+    uint64_t device_blocks = inner_.GetBlockCount();
+    if (end > device_blocks) {
+      end = device_blocks;
+    }
+    uint32_t first = kNoEntry;
+    uint64_t first_block = 0;
+    size_t pages = 0;
+    uint64_t b = block_no;
+    for (; b < end; ++b) {
+      if (Lookup(b) != kNoEntry) {
+        if (pages > 0 && !SubmitLoad(first, first_block, pages)) {
+          return;
+        }
+        pages = 0;
+        continue;
+      }
+      auto alloc = AllocEntry(b);
+      if (!alloc) {
+        break;
+      }
+      entries_[*alloc].loading = true;
+      entries_[*alloc].prefetched = true;
+      if (pages > 0 && *alloc == first + pages && !OnIoBoundary(b)) {
+        ++pages;
+        continue;
+      }
+      if (pages > 0 && !SubmitLoad(first, first_block, pages)) {
+        Evict(*alloc);
+        return;
+      }
+      first = *alloc;
+      first_block = b;
+      pages = 1;
+    }
+    if (pages > 0 && !SubmitLoad(first, first_block, pages)) {
+      return;
+    }
+    ra_end_ = b;
+  }
+
+  /**
+   * @brief 提交一个预读请求
+   *
+   * @param first 首个缓存页索引（后续 pages - 1 页在池内相邻）
+   * @param block_no 首页块号
+   * @param pages 页数
+   * @return 提交成功返回 true；失败时移除这些页并返回 false
+   */
+  auto SubmitLoad(uint32_t first, uint64_t block_no, size_t pages) -> bool {
+    auto* token = reinterpret_cast<void*>(static_cast<uintptr_t>(first) + 1);
+    auto result = inner_.SubmitReadBlocks(
+        block_no, std::span<uint8_t>(Page(first), pages * block_size_), pages,
+        token);
+    if (!result) {
+      for (uint32_t idx = first; idx < first + pages; ++idx) {
+        Evict(idx);
+      }
+      return false;
+    }
+    entries_[first].io_count = static_cast<uint32_t>(pages);
+    ++io_inflight_;
+    stats_.readahead_blocks += pages;
+    return true;
+  }
+
+  /// CRTP 基类需要访问 DoXxx 方法
+  template <class>
+  friend class device_framework::DeviceOperationsBase;
+  template <class>
+  friend class device_framework::BlockDevice;
+
+  /// 内层块设备
+  Inner inner_;
+  /// 缓存页内存池
+  uint8_t* pool_;
+  /// 块大小（字节）
+  size_t block_size_;
+  /// 内层设备的最优 I/O 大小（块数，0 表示未报告）
+  uint64_t io_align_ = 0;
+  /// 首个最优 I/O 边界的块号
+  uint64_t io_align_offset_ = 0;
+  /// 打开标志
+  OpenFlags flags_{0};
+  /// 缓存页元数据
+  CacheEntry entries_[Capacity]{};
+  /// 散列桶（每个桶为缓存页链表头）
+  uint32_t buckets_[kBuckets]{};
+  /// CLOCK 指针
+  size_t clock_hand_ = 0;
+  /// 在途回写/预读请求数
+  size_t io_inflight_ = 0;
+  /// 首个失败回写的完成状态（DrainIo 时返回并清除）
+  ErrorCode writeback_error_ = ErrorCode::kSuccess;
+  /// 下一个顺序读取的块号
+  uint64_t next_sequential_ = kNoBlock;
+  /// 已预读区间的末尾块号
+  uint64_t ra_end_ = 0;
+  /// 当前预读窗口（块数）
+  size_t ra_window_ = 0;
+  /// 预读窗口上限（块数，0 表示禁用）
+  size_t ra_max_window_ = 0;
+  /// 统计数据
+  CacheStats stats_{};
+};
+
+}  // namespace device_framework::detail::block_cache
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_BLOCK_CACHE_CACHED_BLOCK_DEVICE_HPP_ \
+        */
@@ -0,0 +1,329 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_BUFFERED_UART_DEVICE_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_BUFFERED_UART_DEVICE_HPP_
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "device_framework/detail/spsc_ring.hpp"
+#include "device_framework/detail/uart_device.hpp"
+#include "device_framework/expected.hpp"
+#include "device_framework/ops/char_device.hpp"
+
+namespace device_framework::detail {
+
+/**
+ * @brief 支持中断驱动发送的 UART 底层驱动接口约束
+ *
+ * 在 UartDriver 的基础上要求非阻塞发送与发送中断开关。
+ */
+template <typename T>
+concept BufferedUartDriver =
+    UartDriver<T> && requires(const T& driver, uint8_t ch, bool enable) {
+      { driver.TryPutChar(ch) } -> std::same_as<bool>;
+      { driver.SetTxInterrupt(enable) } -> std::same_as<void>;
+    };
+
+/**
+ * @brief 中断驱动、带 RX/TX 环形缓冲区的 UART 字符设备 CRTP 中间层
+ *
+ * 与 UartDevice 不同，Write 不等待串口：数据写入 TX 环后立即返回，
+ * 由中断处理程序在发送 FIFO 有空间时从 TX 环补充；接收中断把硬件 FIFO
+ * 中的字节存入 RX 环，Read 从 RX 环取出。
+ *
+ * 两个环都是 SPSC 无锁环：
+ * - RX：生产者为 HandleInterrupt()，消费者为 Read()
+ * - TX：生产者为 Write()，消费者为持有发送权的一方（见 KickTx()）
+ *
+ * 发送权通过原子标志在 Write() 与中断处理程序之间传递，任何一方都不会
+ * 自旋等待；未取得发送权的一方留下请求，由持有者释放前代为处理。
+ * RX 环满时新到达的字节被丢弃并计入 GetRxDropped()。驱动满足
+ * UartBurstDriver 时按 FIFO 块收发。
+ *
+ * @tparam Derived 具体设备类型（CRTP）
+ * @tparam DriverType 底层 UART 驱动类型
+ * @tparam RxSize RX 环容量（2 的幂）
+ * @tparam TxSize TX 环容量（2 的幂）
+ * @warning 同一时刻只能有一个写者和一个读者；只有中断处理程序
+ *          （或充当它的轮询循环）接收数据，未接入中断时需周期性调用
+ *          HandleInterrupt()
+ */
+template <class Derived, BufferedUartDriver DriverType, size_t RxSize = 256,
+          size_t TxSize = 1024>
+class BufferedUartDevice : public CharDevice<Derived> {
+ public:
+  BufferedUartDevice() = default;
+
+  /// @brief 直接访问底层驱动（用于中断处理等需要绕过 Device 框架的场景）
+  auto GetDriver() -> DriverType& { return driver_; }
+
+  /// @brief TX 环中等待发送的字节数
+  [[nodiscard]] auto GetTxPending() const -> size_t { return tx_.Size(); }
+
+  /// @brief RX 环中等待读取的字节数
+  [[nodiscard]] auto GetRxAvailable() const -> size_t { return rx_.Size(); }
+
+  /// @brief RX 环满而被丢弃的字节数
+  [[nodiscard]] auto GetRxDropped() const -> uint64_t {
+    return rx_dropped_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 阻塞直到 TX 环中的数据全部交给硬件
+   *
+   * 不依赖中断，直接轮询串口发送。用于 Release()、panic 输出等场景。
+   */
+  auto DrainTx() -> void {
+    while (!tx_.Empty()) {
+      KickTx();
+    }
+  }
+
+ protected:
+  auto DoOpen(OpenFlags flags) -> Expected<void> {
+    if (!flags.CanRead() && !flags.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    flags_ = flags;
+    return {};
+  }
+
+  auto DoCharRead(std::span<uint8_t> buffer) -> Expected<size_t> {
+    if (!flags_.CanRead()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    size_t count = rx_.Read(buffer);
+    this->RefreshPollReady([this] { return Readiness(); });
+    return count;
+  }
+
+  /**
+   * @brief 写入 TX 环并启动发送（不等待串口）
+   *
+   * @return 实际写入 TX 环的字节数（环剩余空间不足时小于 data.size()）
+   */
+  auto DoCharWrite(std::span<const uint8_t> data) -> Expected<size_t> {
+    if (!flags_.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    size_t written = tx_.Write(data);
+    KickTx();
+    this->RefreshPollReady([this] { return Readiness(); });
+    return written;
+  }
+
+  auto DoPoll(PollEvents requested) -> Expected<PollEvents> {
+    return Readiness() & requested;
+  }
+
+  auto DoRelease() -> Expected<void> {
+    DrainTx();
+    driver_.SetTxInterrupt(false);
+    return {};
+  }
+
+  /**
+   * @brief UartIoctl 命令
+   *
+   * kSetConfig 先同步排空 TX 环，避免已排队的数据以新的线路参数发出。
+   */
+  auto DoIoctl(uint32_t request, uintptr_t arg) -> Expected<int64_t> {
+    if (request == UartIoctl::kSetConfig &&
+        UartConfigurableDriver<DriverType>) {
+      DrainTx();
+    }
+    return HandleUartIoctl(driver_, request, arg);
+  }
+
+  /**
+   * @brief UART 中断处理
+   *
+   * 把接收 FIFO 中的字节存入 RX 环，并从 TX 环补充发送 FIFO；
+   * RX 环变为非空或 TX 环腾出空间时通知就绪等待者。
+   *
+   * @note 可在中断上下文中安全调用
+   */
+  auto DoHandleInterrupt() -> void {
+    ReceiveToRing([](uint8_t) {});
+    ServiceTx();
+    this->RefreshPollReady([this] { return Readiness(); });
+  }
+
+  /**
+   * @brief UART 中断处理（带回调版）
+   *
+   * 与无回调版相同地存储接收到的字节，并对每个存入 RX 环的字节调用
+   * on_complete（例如用于唤醒等待的读者）。
+   *
+   * @tparam CompletionCallback 签名：void(uint8_t ch)
+   * @param on_complete 每接收一个字节调用一次的回调函数
+   */
+  template <typename CompletionCallback>
+  auto DoHandleInterrupt(CompletionCallback&& on_complete) -> void {
+    ReceiveToRing(on_complete);
+    ServiceTx();
+    this->RefreshPollReady([this] { return Readiness(); });
+  }
+
+  /// @name 构造/析构函数
+  /// @{
+  ~BufferedUartDevice() = default;
+  BufferedUartDevice(const BufferedUartDevice&) = delete;
+  auto operator=(const BufferedUartDevice&) -> BufferedUartDevice& = delete;
+  BufferedUartDevice(BufferedUartDevice&& other) noexcept
+      : CharDevice<Derived>(std::move(other)),
+        driver_(std::move(other.driver_)),
+        flags_(other.flags_),
+        rx_(std::move(other.rx_)),
+        tx_(std::move(other.tx_)),
+        rx_dropped_(other.rx_dropped_.load(std::memory_order_relaxed)) {}
+  auto operator=(BufferedUartDevice&& other) noexcept
+      -> BufferedUartDevice& {
+    if (this != &other) {
+      CharDevice<Derived>::operator=(std::move(other));
+      driver_ = std::move(other.driver_);
+      flags_ = other.flags_;
+      rx_ = std::move(other.rx_);
+      tx_ = std::move(other.tx_);
+      rx_dropped_.store(other.rx_dropped_.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+    }
+    return *this;
+  }
+  /// @}
+
+  DriverType driver_;
+  OpenFlags flags_{0};
+
+ private:
+  /// @brief CRTP 基类需要访问 DoXxx 方法
+  template <class>
+  friend class ::device_framework::DeviceOperationsBase;
+  template <class>
+  friend class ::device_framework::CharDevice;
+
+  /// @brief 由两个环的状态得到当前就绪事件（不访问设备寄存器）
+  [[nodiscard]] auto Readiness() const -> PollEvents {
+    uint32_t ready = 0;
+    if (!rx_.Empty()) {
+      ready |= PollEvents::kIn;
+    }
+    if (!tx_.Full()) {
+      ready |= PollEvents::kOut;
+    }
+    return PollEvents{ready};
+  }
+
+  /**
+   * @brief 排空接收 FIFO 到 RX 环
+   *
+   * @param on_byte 每存入一个字节调用一次
+   */
+  template <typename Callback>
+  auto ReceiveToRing(Callback&& on_byte) -> void {
+    if constexpr (UartBurstDriver<DriverType>) {
+      uint8_t chunk[kFifoChunkSize];
+      while (size_t count = driver_.ReadBurst(chunk)) {
+        for (size_t i = 0; i < count; ++i) {
+          StoreRx(chunk[i], on_byte);
+        }
+      }
+    } else {
+      while (driver_.HasData()) {
+        auto ch = driver_.TryGetChar();
+        if (!ch) {
+          break;
+        }
+        StoreRx(*ch, on_byte);
+      }
+    }
+  }
+
+  /// @brief 把一个接收到的字节存入 RX 环，环满时计入丢弃数
+  template <typename Callback>
+  auto StoreRx(uint8_t ch, Callback& on_byte) -> void {
+    if (rx_.Push(ch)) {
+      on_byte(ch);
+    } else {
+      rx_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief 中断上下文中的发送处理
+   *
+   * 先屏蔽发送中断，避免在被打断的 Write() 持有发送权时反复进入中断；
+   * 取得发送权的一方会按 TX 环状态重新设置。
+   */
+  auto ServiceTx() -> void {
+    driver_.SetTxInterrupt(false);
+    KickTx();
+  }
+
+  /**
+   * @brief 请求从 TX 环补充发送 FIFO
+   *
+   * 设置请求标志后尝试取得发送权：取得者清除请求、补充 FIFO，
+   * 释放后若期间又有新请求则再处理一轮；未取得者直接返回，
+   * 由当前持有者代为处理。
+   */
+  auto KickTx() -> void {
+    tx_requested_.store(true);
+    while (tx_requested_.load() && !tx_busy_.exchange(true)) {
+      tx_requested_.store(false);
+      FillTxFifo();
+      tx_busy_.store(false);
+    }
+  }
+
+  /**
+   * @brief 从 TX 环向发送 FIFO 写入，直到 FIFO 满或 TX 环空
+   *
+   * TX 环仍有数据时启用发送中断，否则禁用。仅由发送权持有者调用。
+   */
+  auto FillTxFifo() -> void {
+    if constexpr (UartBurstDriver<DriverType>) {
+      uint8_t chunk[kFifoChunkSize];
+      while (size_t count = tx_.Peek(chunk)) {
+        size_t sent = driver_.WriteBurst({chunk, count});
+        tx_.Skip(sent);
+        if (sent < count) {
+          break;
+        }
+      }
+    } else {
+      while (auto ch = tx_.Peek()) {
+        if (!driver_.TryPutChar(*ch)) {
+          break;
+        }
+        (void)tx_.Pop();
+      }
+    }
+    driver_.SetTxInterrupt(!tx_.Empty());
+  }
+
+  /// 批量收发时每次在栈上暂存的字节数
+  static constexpr size_t kFifoChunkSize = 16;
+
+  /// 接收环（中断处理程序 → Read）
+  SpscRing<uint8_t, RxSize> rx_;
+  /// 发送环（Write → 发送权持有者）
+  SpscRing<uint8_t, TxSize> tx_;
+  /// RX 环满时丢弃的字节数
+  std::atomic<uint64_t> rx_dropped_{0};
+  /// 是否有一方持有发送权
+  std::atomic<bool> tx_busy_{false};
+  /// 是否有未处理的发送请求
+  std::atomic<bool> tx_requested_{false};
+};
+
+}  // namespace device_framework::detail
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_BUFFERED_UART_DEVICE_HPP_ \
+        */
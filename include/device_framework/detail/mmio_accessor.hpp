@@ -7,6 +7,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 
 namespace device_framework::detail {
 
@@ -16,7 +17,8 @@ namespace device_framework::detail {
  * 封装 volatile 指针的 MMIO 读写操作，消除各驱动中重复的
  * reinterpret_cast<volatile T*> 样板代码。
  *
- * 支持任意宽度的寄存器访问（uint8_t / uint16_t / uint32_t / uint64_t）。
+ * 支持任意宽度的寄存器访问（uint8_t / uint16_t / uint32_t / uint64_t），
+ * 以及按最宽合法宽度拆分的块读写（ReadBlock / WriteBlock）。
  */
 class MmioAccessor {
  public:
@@ -32,9 +34,111 @@ class MmioAccessor {
     *reinterpret_cast<volatile T*>(base_ + offset) = val;
   }
 
+  /**
+   * @brief 块读取：以不超过 MaxWidth 的最宽自然对齐访问复制一段区域
+   *
+   * 每次访问选取地址对齐且不超出剩余长度的最宽宽度（8/4/2/1 字节），
+   * 因此对齐的区域在中段全部使用 MaxWidth 宽度访问。所有访问均为
+   * volatile、按地址递增顺序进行，每个字节只访问一次；与 Read() 相同，
+   * 不附带内存屏障。目标缓冲区为普通内存，可以不对齐。
+   *
+   * @tparam MaxWidth 总线允许的最大访问宽度（1/2/4/8 字节），如
+   *         virtio-mmio 寄存器区与 PCI 配置空间为 4
+   * @param offset 起始偏移
+   * @param out 目标缓冲区（读取 out.size() 字节）
+   * @warning 仅用于允许任意宽度访问的区域（设备内存窗口、共享内存、
+   *          固件表）；字段需按各自宽度访问的寄存器仍应使用 Read()
+   */
+  template <size_t MaxWidth = sizeof(uint64_t)>
+  auto ReadBlock(size_t offset, std::span<uint8_t> out) const -> void {
+    static_assert(IsValidWidth(MaxWidth), "MaxWidth must be 1, 2, 4 or 8");
+    uint64_t addr = base_ + offset;
+    size_t done = 0;
+    while (done < out.size()) {
+      size_t width = StepWidth<MaxWidth>(addr + done, out.size() - done);
+      switch (width) {
+        case 8:
+          Store(out.data() + done, Read<uint64_t>(offset + done));
+          break;
+        case 4:
+          Store(out.data() + done, Read<uint32_t>(offset + done));
+          break;
+        case 2:
+          Store(out.data() + done, Read<uint16_t>(offset + done));
+          break;
+        default:
+          out[done] = Read<uint8_t>(offset + done);
+          break;
+      }
+      done += width;
+    }
+  }
+
+  /**
+   * @brief 块写入：以不超过 MaxWidth 的最宽自然对齐访问写入一段区域
+   *
+   * 访问宽度与顺序规则同 ReadBlock()。
+   *
+   * @tparam MaxWidth 总线允许的最大访问宽度（1/2/4/8 字节）
+   * @param offset 起始偏移
+   * @param data 源数据（写入 data.size() 字节）
+   * @warning 适用范围同 ReadBlock()
+   */
+  template <size_t MaxWidth = sizeof(uint64_t)>
+  auto WriteBlock(size_t offset, std::span<const uint8_t> data) const -> void {
+    static_assert(IsValidWidth(MaxWidth), "MaxWidth must be 1, 2, 4 or 8");
+    uint64_t addr = base_ + offset;
+    size_t done = 0;
+    while (done < data.size()) {
+      size_t width = StepWidth<MaxWidth>(addr + done, data.size() - done);
+      switch (width) {
+        case 8:
+          Write(offset + done, Load<uint64_t>(data.data() + done));
+          break;
+        case 4:
+          Write(offset + done, Load<uint32_t>(data.data() + done));
+          break;
+        case 2:
+          Write(offset + done, Load<uint16_t>(data.data() + done));
+          break;
+        default:
+          Write(offset + done, data[done]);
+          break;
+      }
+      done += width;
+    }
+  }
+
   [[nodiscard]] auto base() const -> uint64_t { return base_; }
 
  private:
+  [[nodiscard]] static constexpr auto IsValidWidth(size_t width) -> bool {
+    return width == 1 || width == 2 || width == 4 || width == 8;
+  }
+
+  /// @brief 地址 addr 处剩余 remaining 字节时可用的最宽访问宽度
+  template <size_t MaxWidth>
+  [[nodiscard]] static constexpr auto StepWidth(uint64_t addr,
+                                                size_t remaining) -> size_t {
+    size_t width = MaxWidth;
+    while (width > 1 && ((addr & (width - 1)) != 0 || remaining < width)) {
+      width >>= 1;
+    }
+    return width;
+  }
+
+  template <typename T>
+  static auto Store(uint8_t* dst, T val) -> void {
+    __builtin_memcpy(dst, &val, sizeof(T));
+  }
+
+  template <typename T>
+  [[nodiscard]] static auto Load(const uint8_t* src) -> T {
+    T val;
+    __builtin_memcpy(&val, src, sizeof(T));
+    return val;
+  }
+
   uint64_t base_;
 };
 
@@ -5,9 +5,12 @@
 #ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_NS16550A_NS16550A_HPP_
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_NS16550A_NS16550A_HPP_
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <span>
 
+#include "device_framework/defs.h"
 #include "device_framework/detail/mmio_accessor.hpp"
 #include "device_framework/expected.hpp"
 
@@ -23,6 +26,11 @@ namespace device_framework::detail::ns16550a {
  */
 class Ns16550a {
  public:
+  /// 发送/接收 FIFO 深度（字节）
+  static constexpr size_t kFifoDepth = 16;
+  /// 标准 16550 参考时钟（Hz），Create() 的默认分频按此计算
+  static constexpr uint32_t kDefaultClock = 1843200;
+
   /**
    * @brief 工厂方法：创建并初始化 NS16550A 驱动
    * @param dev_addr 设备 MMIO 基地址
@@ -44,9 +52,87 @@ class Ns16550a {
     uart.mmio_.Write<uint8_t>(kRegFCR, 0x07);   // 启用并清除 FIFO
     uart.mmio_.Write<uint8_t>(kRegIER, 0x01);   // 启用接收中断
 
+    uart.config_.baud_rate = kDefaultClock / (16 * 3);
+    uart.config_.clock = kDefaultClock;
     return uart;
   }
 
+  /**
+   * @brief 应用线路与 FIFO 配置
+   *
+   * 分频取 clock / (16 * baud_rate) 的最近整数，实际误差超过
+   * kUartMaxBaudErrorPermille 时拒绝。接收触发水位取 1/4/8/14 中
+   * 不超过 rx_trigger 的最大档位，水位以下的剩余字节由字符超时中断
+   * 通知。16550A 的发送中断固定在 FIFO 全空时触发，tx_threshold 被忽略。
+   * 配置期间暂时屏蔽中断，FIFO 中的数据保留。
+   *
+   * @param config 目标配置
+   * @return 参数无效时返回 kInvalidArgument，硬件状态不变
+   */
+  auto Configure(const UartConfig& config) -> Expected<void> {
+    if (config.data_bits < 5 || config.data_bits > 8 ||
+        config.stop_bits < 1 || config.stop_bits > 2) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    uint32_t divisor = 0;
+    UartConfig applied = config;
+    if (config.baud_rate != 0) {
+      if (config.clock == 0) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
+      uint64_t scale = 16 * static_cast<uint64_t>(config.baud_rate);
+      divisor = static_cast<uint32_t>((config.clock + scale / 2) / scale);
+      if (divisor == 0 || divisor > 0xFFFF) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
+      applied.baud_rate = config.clock / (16 * divisor);
+      if (!UartBaudWithinTolerance(config.baud_rate, applied.baud_rate)) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
+    } else {
+      applied.baud_rate = config_.baud_rate;
+      applied.clock = config_.clock;
+    }
+
+    uint8_t fcr = kFcrEnable;
+    applied.rx_trigger = 1;
+    for (uint8_t i = 1; i < sizeof(kRxTriggerLevels); ++i) {
+      if (kRxTriggerLevels[i] <= config.rx_trigger) {
+        fcr = static_cast<uint8_t>(kFcrEnable | (i << 6));
+        applied.rx_trigger = kRxTriggerLevels[i];
+      }
+    }
+    applied.tx_threshold = 0;
+
+    auto lcr = static_cast<uint8_t>(config.data_bits - 5);
+    if (config.stop_bits == 2) {
+      lcr |= kLcrStop2;
+    }
+    if (config.parity != UartParity::kNone) {
+      lcr |= kLcrParity;
+      if (config.parity == UartParity::kEven) {
+        lcr |= kLcrEvenParity;
+      }
+    }
+
+    auto ier = mmio_.Read<uint8_t>(kRegIER);
+    mmio_.Write<uint8_t>(kRegIER, 0x00);
+    if (divisor != 0) {
+      mmio_.Write<uint8_t>(kRegLCR, kLcrDlab);
+      mmio_.Write<uint8_t>(kUartDLL, static_cast<uint8_t>(divisor & 0xFF));
+      mmio_.Write<uint8_t>(kUartDLM, static_cast<uint8_t>(divisor >> 8));
+    }
+    mmio_.Write<uint8_t>(kRegLCR, lcr);
+    mmio_.Write<uint8_t>(kRegFCR, fcr);
+    mmio_.Write<uint8_t>(kRegIER, ier);
+
+    config_ = applied;
+    return {};
+  }
+
+  /// @brief 当前生效的线路与 FIFO 配置
+  [[nodiscard]] auto GetConfig() const -> UartConfig { return config_; }
+
   /// @name 构造/析构函数
   /// @{
   Ns16550a() = default;
@@ -67,6 +153,72 @@ class Ns16550a {
     mmio_.Write<uint8_t>(kRegTHR, c);
   }
 
+  /**
+   * @brief 非阻塞式尝试写入一个字符
+   * @param c 待写入的字符
+   * @return 发送保持寄存器为空且已写入返回 true，否则返回 false
+   */
+  [[nodiscard]] auto TryPutChar(uint8_t c) const -> bool {
+    if ((mmio_.Read<uint8_t>(kRegLSR) & kLsrThre) == 0) {
+      return false;
+    }
+    mmio_.Write<uint8_t>(kRegTHR, c);
+    return true;
+  }
+
+  /**
+   * @brief 非阻塞地按 FIFO 深度批量写入
+   *
+   * 启用 FIFO 时 LSR.THRE 表示发送 FIFO 全空，一次状态检查后即可连续
+   * 写入 kFifoDepth 字节。
+   *
+   * @param data 待写入的数据
+   * @return 实际写入的字节数（THRE 未置位时为 0）
+   */
+  [[nodiscard]] auto WriteBurst(std::span<const uint8_t> data) const
+      -> size_t {
+    if ((mmio_.Read<uint8_t>(kRegLSR) & kLsrThre) == 0) {
+      return 0;
+    }
+    size_t count = data.size() < kFifoDepth ? data.size() : kFifoDepth;
+    for (size_t i = 0; i < count; ++i) {
+      mmio_.Write<uint8_t>(kRegTHR, data[i]);
+    }
+    return count;
+  }
+
+  /**
+   * @brief 非阻塞地排空接收 FIFO
+   *
+   * 每个字节读取前检查一次 LSR.DR（16550 不提供接收 FIFO 水位），
+   * 直到 FIFO 为空或 buffer 写满。
+   *
+   * @param buffer 输出缓冲区
+   * @return 实际读取的字节数
+   */
+  [[nodiscard]] auto ReadBurst(std::span<uint8_t> buffer) const -> size_t {
+    size_t count = 0;
+    while (count < buffer.size() &&
+           (mmio_.Read<uint8_t>(kRegLSR) & kLsrDr) != 0) {
+      buffer[count++] = mmio_.Read<uint8_t>(kRegRHR);
+    }
+    return count;
+  }
+
+  /**
+   * @brief 启用/禁用发送保持寄存器空（THRE）中断
+   *
+   * 启用时若 THR 已空，设备立即产生 THRE 中断。
+   *
+   * @param enable true 启用，false 禁用
+   */
+  auto SetTxInterrupt(bool enable) const -> void {
+    auto ier = mmio_.Read<uint8_t>(kRegIER);
+    ier = enable ? static_cast<uint8_t>(ier | kIerThri)
+                 : static_cast<uint8_t>(ier & ~kIerThri);
+    mmio_.Write<uint8_t>(kRegIER, ier);
+  }
+
   /**
    * @brief 阻塞式读取一个字符
    * @return 读取到的字符
@@ -96,6 +248,14 @@ class Ns16550a {
     return (mmio_.Read<uint8_t>(kRegLSR) & (1 << 0)) != 0;
   }
 
+  /**
+   * @brief 检查发送保持寄存器是否可写入（不阻塞）
+   * @return true 如果 LSR.THRE 置位
+   */
+  [[nodiscard]] auto TxReady() const -> bool {
+    return (mmio_.Read<uint8_t>(kRegLSR) & kLsrThre) != 0;
+  }
+
   /**
    * @brief 读取中断标识寄存器（ISR / IIR）
    *
@@ -141,12 +301,34 @@ class Ns16550a {
   /// read mode: Modem Status Reg
   static constexpr uint8_t kRegMSR = 6;
 
+  /// IER: transmit holding register empty interrupt
+  static constexpr uint8_t kIerThri = 1 << 1;
+  /// LSR: data ready
+  static constexpr uint8_t kLsrDr = 1 << 0;
+  /// LSR: transmit holding register empty
+  static constexpr uint8_t kLsrThre = 1 << 5;
+
+  /// LCR: two stop bits
+  static constexpr uint8_t kLcrStop2 = 1 << 2;
+  /// LCR: parity enable
+  static constexpr uint8_t kLcrParity = 1 << 3;
+  /// LCR: even parity select
+  static constexpr uint8_t kLcrEvenParity = 1 << 4;
+  /// LCR: divisor latch access bit
+  static constexpr uint8_t kLcrDlab = 1 << 7;
+  /// FCR: FIFO enable
+  static constexpr uint8_t kFcrEnable = 1 << 0;
+  /// FCR[7:6] 对应的接收触发水位（字节）
+  static constexpr uint8_t kRxTriggerLevels[] = {1, 4, 8, 14};
+
   /// LSB of divisor Latch when enabled
   static constexpr uint8_t kUartDLL = 0;
   /// MSB of divisor Latch when enabled
   static constexpr uint8_t kUartDLM = 1;
 
   MmioAccessor mmio_;
+  /// 当前生效的配置（Create() 的默认值：8N1，触发水位 1）
+  UartConfig config_{};
 
   explicit Ns16550a(uint64_t dev_addr) : mmio_(dev_addr) {}
 };
@@ -5,8 +5,10 @@
 #ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_NS16550A_NS16550A_DEVICE_HPP_
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_NS16550A_NS16550A_DEVICE_HPP_
 
+#include <cstddef>
 #include <cstdint>
 
+#include "device_framework/detail/buffered_uart_device.hpp"
 #include "device_framework/detail/ns16550a/ns16550a.hpp"
 #include "device_framework/detail/uart_device.hpp"
 
@@ -39,6 +41,39 @@ class Ns16550aDevice : public UartDevice<Ns16550aDevice, Ns16550a> {
   }
 };
 
+/**
+ * @brief 中断驱动的 NS16550A 字符设备
+ *
+ * Write 写入 TX 环后立即返回，THRE 中断从 TX 环补充发送；接收中断把
+ * 字节存入 RX 环供 Read 读取。需将 UART 中断路由到 HandleInterrupt()。
+ *
+ * @tparam RxSize RX 环容量（2 的幂）
+ * @tparam TxSize TX 环容量（2 的幂）
+ */
+template <size_t RxSize = 256, size_t TxSize = 1024>
+class Ns16550aBufferedDevice
+    : public BufferedUartDevice<Ns16550aBufferedDevice<RxSize, TxSize>,
+                                Ns16550a, RxSize, TxSize> {
+ public:
+  Ns16550aBufferedDevice() = default;
+
+  /**
+   * @brief 工厂方法：创建已初始化的中断驱动 NS16550A 字符设备
+   * @param base_addr 设备 MMIO 基地址
+   * @return 成功返回已初始化的实例，失败返回错误
+   */
+  [[nodiscard]] static auto Create(uint64_t base_addr)
+      -> Expected<Ns16550aBufferedDevice> {
+    auto driver = Ns16550a::Create(base_addr);
+    if (!driver) {
+      return std::unexpected(driver.error());
+    }
+    Ns16550aBufferedDevice dev;
+    dev.driver_ = std::move(*driver);
+    return dev;
+  }
+};
+
 }  // namespace device_framework::detail::ns16550a
 
 #endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_NS16550A_NS16550A_DEVICE_HPP_ \
@@ -0,0 +1,155 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_PCI_CONFIG_ACCESSOR_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_PCI_CONFIG_ACCESSOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "device_framework/detail/mmio_accessor.hpp"
+
+namespace device_framework::detail {
+
+/**
+ * @brief PCI Express ECAM 配置空间访问器
+ *
+ * 一段 ECAM 窗口覆盖一个 PCI 段组中 [start_bus, end_bus] 的全部
+ * function，每个 function 的 4KB 配置空间位于
+ * base + (bus << 20 | device << 15 | function << 12)，
+ * 其中 base 对应总线 0（与 ACPI MCFG 中的基地址含义一致）。
+ *
+ * 配置读写都是普通的内存访问，不经过端口 I/O 的地址/数据寄存器对，
+ * 因此无需加锁，多个核可以同时访问不同的 function。
+ *
+ * @see PCI Express Base Specification 4.0 §7.2.2
+ * @see PCI Firmware Specification 3.2 §4.1.2 MCFG Table Description
+ */
+class PciConfigAccessor {
+ public:
+  /// 每条总线的设备数
+  static constexpr uint8_t kDevicesPerBus = 32;
+  /// 每个设备的 function 数
+  static constexpr uint8_t kFunctionsPerDevice = 8;
+  /// 每个 function 的配置空间大小（字节）
+  static constexpr size_t kFunctionConfigSize = 4096;
+  /// 不存在的 function 读回的 Vendor ID
+  static constexpr uint16_t kInvalidVendor = 0xFFFF;
+
+  /**
+   * @brief 构造函数
+   * @param base 总线 0 对应的 ECAM 窗口虚拟地址
+   * @param start_bus 窗口覆盖的第一条总线
+   * @param end_bus 窗口覆盖的最后一条总线
+   * @param segment PCI 段组号
+   */
+  explicit PciConfigAccessor(uint64_t base = 0, uint8_t start_bus = 0,
+                             uint8_t end_bus = 0, uint16_t segment = 0)
+      : base_(base),
+        start_bus_(start_bus),
+        end_bus_(end_bus),
+        segment_(segment) {}
+
+  /// @brief function 配置空间相对于 base 的偏移
+  [[nodiscard]] static constexpr auto Offset(uint8_t bus, uint8_t device,
+                                             uint8_t function) -> uint64_t {
+    return (static_cast<uint64_t>(bus) << 20) |
+           (static_cast<uint64_t>(device & 0x1F) << 15) |
+           (static_cast<uint64_t>(function & 0x7) << 12);
+  }
+
+  /// @brief 总线是否位于窗口内
+  [[nodiscard]] auto Contains(uint8_t bus) const -> bool {
+    return base_ != 0 && bus >= start_bus_ && bus <= end_bus_;
+  }
+
+  /**
+   * @brief 获取 function 配置空间的访问器
+   *
+   * 返回的访问器基地址即 PciTransport 构造参数所需的 ECAM 地址。
+   *
+   * @return 总线不在窗口内时返回基地址为 0 的访问器
+   */
+  [[nodiscard]] auto Function(uint8_t bus, uint8_t device,
+                              uint8_t function) const -> MmioAccessor {
+    if (!Contains(bus)) {
+      return MmioAccessor(0);
+    }
+    return MmioAccessor(base_ + Offset(bus, device, function));
+  }
+
+  template <typename T>
+  [[nodiscard]] auto Read(uint8_t bus, uint8_t device, uint8_t function,
+                          size_t offset) const -> T {
+    return Function(bus, device, function).template Read<T>(offset);
+  }
+
+  template <typename T>
+  auto Write(uint8_t bus, uint8_t device, uint8_t function, size_t offset,
+             T val) const -> void {
+    Function(bus, device, function).template Write<T>(offset, val);
+  }
+
+  /**
+   * @brief 枚举窗口内存在的全部 function
+   *
+   * 每个设备先读 function 0 的 Vendor ID，不存在时跳过其余 function；
+   * 只有 Header Type 的多功能位置位时才探测 function 1 ~ 7。
+   * 总线号按窗口范围穷举，不依赖桥的次级总线配置。
+   *
+   * @tparam Visitor 签名：void(uint8_t bus, uint8_t device,
+   *         uint8_t function, MmioAccessor cfg)
+   * @param visit 每个存在的 function 调用一次
+   * @return 存在的 function 数
+   */
+  template <typename Visitor>
+  auto ForEachFunction(Visitor&& visit) const -> size_t {
+    if (base_ == 0) {
+      return 0;
+    }
+    size_t found = 0;
+    for (uint32_t bus = start_bus_; bus <= end_bus_; ++bus) {
+      for (uint8_t dev = 0; dev < kDevicesPerBus; ++dev) {
+        auto fn0 = Function(static_cast<uint8_t>(bus), dev, 0);
+        if (fn0.Read<uint16_t>(kVendorIdOffset) == kInvalidVendor) {
+          continue;
+        }
+        // Header Type bit 7 = 多功能设备
+        bool multi = (fn0.Read<uint8_t>(kHeaderTypeOffset) & 0x80) != 0;
+        uint8_t functions = multi ? kFunctionsPerDevice : 1;
+        for (uint8_t fn = 0; fn < functions; ++fn) {
+          auto cfg = Function(static_cast<uint8_t>(bus), dev, fn);
+          if (fn != 0 &&
+              cfg.Read<uint16_t>(kVendorIdOffset) == kInvalidVendor) {
+            continue;
+          }
+          visit(static_cast<uint8_t>(bus), dev, fn, cfg);
+          ++found;
+        }
+      }
+    }
+    return found;
+  }
+
+  [[nodiscard]] auto base() const -> uint64_t { return base_; }
+  [[nodiscard]] auto start_bus() const -> uint8_t { return start_bus_; }
+  [[nodiscard]] auto end_bus() const -> uint8_t { return end_bus_; }
+  [[nodiscard]] auto segment() const -> uint16_t { return segment_; }
+
+ private:
+  /// 配置空间头部：Vendor ID 偏移
+  static constexpr size_t kVendorIdOffset = 0x00;
+  /// 配置空间头部：Header Type 偏移
+  static constexpr size_t kHeaderTypeOffset = 0x0E;
+
+  uint64_t base_;
+  uint8_t start_bus_;
+  uint8_t end_bus_;
+  uint16_t segment_;
+};
+
+}  // namespace device_framework::detail
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_PCI_CONFIG_ACCESSOR_HPP_ \
+        */
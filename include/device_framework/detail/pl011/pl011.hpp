@@ -5,10 +5,14 @@
 #ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_PL011_PL011_HPP_
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_PL011_PL011_HPP_
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <span>
 
+#include "device_framework/defs.h"
 #include "device_framework/detail/mmio_accessor.hpp"
+#include "device_framework/expected.hpp"
 
 namespace device_framework::detail::pl011 {
 
@@ -22,6 +26,13 @@ namespace device_framework::detail::pl011 {
  */
 class Pl011 {
  public:
+  /// 发送/接收 FIFO 深度（字节，r1p5 为 32，这里按早期版本保守取 16）
+  static constexpr size_t kFifoDepth = 16;
+  /// 中断位（RIS/MIS/ICR）：接收
+  static constexpr uint32_t kIntRx = (1 << 4);
+  /// 中断位（RIS/MIS/ICR）：接收超时
+  static constexpr uint32_t kIntRt = (1 << 6);
+
   /**
    * @brief 构造函数
    * @param dev_addr  设备 MMIO 基地址
@@ -29,18 +40,26 @@ class Pl011 {
    * @param baud_rate 波特率（0 表示不设置波特率）
    */
   explicit Pl011(uint64_t dev_addr, uint64_t clock = 0, uint64_t baud_rate = 0)
-      : mmio_(dev_addr), base_clock_(clock), baud_rate_(baud_rate) {
+      : mmio_(dev_addr) {
     mmio_.Write<uint32_t>(kRegRSRECR, 0);
     mmio_.Write<uint32_t>(kRegCR, 0);
 
-    if (baud_rate_ != 0) {
-      uint32_t divisor = (base_clock_ * 4) / baud_rate_;
+    config_.clock = static_cast<uint32_t>(clock);
+    if (baud_rate != 0) {
+      uint32_t divisor =
+          CalcDivisor(config_.clock, static_cast<uint32_t>(baud_rate));
       mmio_.Write<uint32_t>(kRegIBRD, divisor >> 6);
       mmio_.Write<uint32_t>(kRegFBRD, divisor & 0x3f);
+      config_.baud_rate = divisor != 0 ? config_.clock * 4 / divisor : 0;
     }
 
-    mmio_.Write<uint32_t>(kRegLCRH, kLCRHWlen8);
-    mmio_.Write<uint32_t>(kRegIMSC, kIMSCRxim);
+    // 复位默认水位：收发均为 FIFO 的 1/2
+    mmio_.Write<uint32_t>(kRegIFLS, (kIflsHalf << 3) | kIflsHalf);
+    config_.rx_trigger = kTriggerLevels[kIflsHalf];
+    config_.tx_threshold = kTriggerLevels[kIflsHalf];
+    mmio_.Write<uint32_t>(kRegLCRH, kLCRHWlen8 | kLCRHFen);
+    // 启用 FIFO 后接收中断按水位触发，水位以下的剩余字节由接收超时中断通知
+    mmio_.Write<uint32_t>(kRegIMSC, kIMSCRxim | kIMSCRtim);
     mmio_.Write<uint32_t>(kRegCR, kCREnable | kCRTxEnable | kCRRxEnable);
   }
 
@@ -54,6 +73,83 @@ class Pl011 {
   ~Pl011() = default;
   /// @}
 
+  /**
+   * @brief 应用线路与 FIFO 配置
+   *
+   * 分频以 1/64 为单位取 clock / (16 * baud_rate) 的最近值拆分到
+   * IBRD/FBRD，实际误差超过 kUartMaxBaudErrorPermille 时拒绝。
+   * 收发水位分别取 FIFO 的 1/8、1/4、1/2、3/4、7/8（2/4/8/12/14 字节）中
+   * 不超过请求值的最大档位（不足 2 字节时取 1/8），接收水位以下的剩余
+   * 字节由接收超时中断通知。
+   *
+   * 按 TRM 要求先等待发送完成并禁用 UART，再写分频与 LCR_H
+   * （LCR_H 的写入使 IBRD/FBRD 生效）；发送 FIFO 中尚未发出的数据在
+   * 此前发送完毕，接收 FIFO 中的数据被丢弃。
+   *
+   * @param config 目标配置
+   * @return 参数无效时返回 kInvalidArgument，硬件状态不变
+   */
+  auto Configure(const UartConfig& config) -> Expected<void> {
+    if (config.data_bits < 5 || config.data_bits > 8 ||
+        config.stop_bits < 1 || config.stop_bits > 2) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    uint32_t divisor = 0;
+    UartConfig applied = config;
+    if (config.baud_rate != 0) {
+      divisor = CalcDivisor(config.clock, config.baud_rate);
+      uint32_t ibrd = divisor >> 6;
+      if (ibrd == 0 || ibrd > 0xFFFF ||
+          (ibrd == 0xFFFF && (divisor & 0x3f) != 0)) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
+      applied.baud_rate = static_cast<uint32_t>(
+          static_cast<uint64_t>(config.clock) * 4 / divisor);
+      if (!UartBaudWithinTolerance(config.baud_rate, applied.baud_rate)) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
+    } else {
+      applied.baud_rate = config_.baud_rate;
+      applied.clock = config_.clock;
+    }
+
+    uint32_t rx_sel = SelectTriggerLevel(config.rx_trigger);
+    uint32_t tx_sel = SelectTriggerLevel(config.tx_threshold);
+    applied.rx_trigger = kTriggerLevels[rx_sel];
+    applied.tx_threshold = kTriggerLevels[tx_sel];
+
+    uint32_t lcrh = ((config.data_bits - 5U) << 5) | kLCRHFen;
+    if (config.stop_bits == 2) {
+      lcrh |= kLCRHStp2;
+    }
+    if (config.parity != UartParity::kNone) {
+      lcrh |= kLCRHPen;
+      if (config.parity == UartParity::kEven) {
+        lcrh |= kLCRHEps;
+      }
+    }
+
+    while ((mmio_.Read<uint32_t>(kRegFR) & kFRBusy) != 0) {
+    }
+    auto cr = mmio_.Read<uint32_t>(kRegCR);
+    mmio_.Write<uint32_t>(kRegCR, 0);
+    // 清除 FEN 以冲刷 FIFO
+    mmio_.Write<uint32_t>(kRegLCRH, 0);
+    if (divisor != 0) {
+      mmio_.Write<uint32_t>(kRegIBRD, divisor >> 6);
+      mmio_.Write<uint32_t>(kRegFBRD, divisor & 0x3f);
+    }
+    mmio_.Write<uint32_t>(kRegIFLS, (rx_sel << 3) | tx_sel);
+    mmio_.Write<uint32_t>(kRegLCRH, lcrh);
+    mmio_.Write<uint32_t>(kRegCR, cr);
+
+    config_ = applied;
+    return {};
+  }
+
+  /// @brief 当前生效的线路与 FIFO 配置
+  [[nodiscard]] auto GetConfig() const -> UartConfig { return config_; }
+
   /**
    * @brief 写入一个字符
    * @param c 待写入的字符
@@ -64,6 +160,84 @@ class Pl011 {
     mmio_.Write<uint32_t>(kRegDR, c);
   }
 
+  /**
+   * @brief 非阻塞式尝试写入一个字符
+   * @param c 待写入的字符
+   * @return 发送 FIFO 未满且已写入返回 true，否则返回 false
+   */
+  [[nodiscard]] auto TryPutChar(uint8_t c) const -> bool {
+    if (mmio_.Read<uint32_t>(kRegFR) & kFRTxFIFO) {
+      return false;
+    }
+    mmio_.Write<uint32_t>(kRegDR, c);
+    return true;
+  }
+
+  /**
+   * @brief 非阻塞地批量写入发送 FIFO
+   *
+   * FR.TXFE 置位（FIFO 全空）时一次检查后连续写入 kFifoDepth 字节，
+   * 否则逐字节检查 FR.TXFF 直到 FIFO 满。
+   *
+   * @param data 待写入的数据
+   * @return 实际写入的字节数
+   */
+  [[nodiscard]] auto WriteBurst(std::span<const uint8_t> data) const
+      -> size_t {
+    size_t count = 0;
+    if ((mmio_.Read<uint32_t>(kRegFR) & kFRTXFE) != 0) {
+      count = data.size() < kFifoDepth ? data.size() : kFifoDepth;
+      for (size_t i = 0; i < count; ++i) {
+        mmio_.Write<uint32_t>(kRegDR, data[i]);
+      }
+    }
+    while (count < data.size() &&
+           (mmio_.Read<uint32_t>(kRegFR) & kFRTxFIFO) == 0) {
+      mmio_.Write<uint32_t>(kRegDR, data[count++]);
+    }
+    return count;
+  }
+
+  /**
+   * @brief 非阻塞地排空接收 FIFO
+   *
+   * FR.RXFF 置位（FIFO 满）时一次检查后连续读取 kFifoDepth 字节，
+   * 否则逐字节检查 FR.RXFE 直到 FIFO 空。
+   *
+   * @param buffer 输出缓冲区
+   * @return 实际读取的字节数
+   */
+  [[nodiscard]] auto ReadBurst(std::span<uint8_t> buffer) const -> size_t {
+    size_t count = 0;
+    while (count < buffer.size()) {
+      uint32_t fr = mmio_.Read<uint32_t>(kRegFR);
+      if ((fr & kFRRXFE) != 0) {
+        break;
+      }
+      size_t chunk = (fr & kFRRXFF) != 0 ? kFifoDepth : 1;
+      size_t left = buffer.size() - count;
+      chunk = chunk < left ? chunk : left;
+      for (size_t i = 0; i < chunk; ++i) {
+        buffer[count++] = static_cast<uint8_t>(mmio_.Read<uint32_t>(kRegDR));
+      }
+    }
+    return count;
+  }
+
+  /**
+   * @brief 启用/禁用发送中断（TXIM）
+   *
+   * PL011 的发送中断在 FIFO 水位越过触发点时才置位，启用本身不会产生
+   * 中断，调用者应先向 FIFO 写入数据。
+   *
+   * @param enable true 启用，false 禁用
+   */
+  auto SetTxInterrupt(bool enable) const -> void {
+    uint32_t imsc = mmio_.Read<uint32_t>(kRegIMSC);
+    imsc = enable ? (imsc | kIMSCTxim) : (imsc & ~kIMSCTxim);
+    mmio_.Write<uint32_t>(kRegIMSC, imsc);
+  }
+
   /**
    * @brief 阻塞式读取一个字符
    * @return 读取到的字符
@@ -93,6 +267,52 @@ class Pl011 {
     return !(mmio_.Read<uint32_t>(kRegFR) & kFRRXFE);
   }
 
+  /**
+   * @brief 检查发送 FIFO 是否可写入（不阻塞）
+   * @return true 如果 FR.TXFF 未置位
+   */
+  [[nodiscard]] auto TxReady() const -> bool {
+    return !(mmio_.Read<uint32_t>(kRegFR) & kFRTxFIFO);
+  }
+
+  /**
+   * @brief 启用/禁用接收水位中断（RXIM）
+   *
+   * 接收 DMA 进行时由 DMA 排空 FIFO，只需保留接收超时中断（RTIM）。
+   *
+   * @param enable true 启用，false 禁用
+   */
+  auto SetRxInterrupt(bool enable) const -> void {
+    auto imsc = mmio_.Read<uint32_t>(kRegIMSC);
+    imsc = enable ? (imsc | kIMSCRxim) : (imsc & ~kIMSCRxim);
+    mmio_.Write<uint32_t>(kRegIMSC, imsc);
+  }
+
+  /**
+   * @brief 设置 DMA 请求（UARTDMACR）
+   *
+   * 启用接收 DMA 时同时设置 DMAONERR：出现接收错误时停止接收 DMA
+   * 请求，直到错误中断被清除。
+   *
+   * @param tx 是否启用发送 DMA 请求（TXDMAE）
+   * @param rx 是否启用接收 DMA 请求（RXDMAE）
+   */
+  auto SetDma(bool tx, bool rx) const -> void {
+    uint32_t dmacr = 0;
+    if (tx) {
+      dmacr |= kDMACRTxdmae;
+    }
+    if (rx) {
+      dmacr |= kDMACRRxdmae | kDMACRDmaonerr;
+    }
+    mmio_.Write<uint32_t>(kRegDMACR, dmacr);
+  }
+
+  /// @brief 数据寄存器（DR）的地址，作为 DMA 传输的设备端地址
+  [[nodiscard]] auto GetDataRegisterAddress() const -> uint64_t {
+    return mmio_.base() + kRegDR;
+  }
+
   /**
    * @brief 读取屏蔽后的中断状态寄存器（MIS）
    *
@@ -150,6 +370,8 @@ class Pl011 {
   static constexpr uint32_t kRegLCRH = 0x2C;
   /// control register
   static constexpr uint32_t kRegCR = 0x30;
+  /// interrupt FIFO level select register
+  static constexpr uint32_t kRegIFLS = 0x34;
   /// interrupt mask set/clear
   static constexpr uint32_t kRegIMSC = 0x38;
   /// raw interrupt status register
@@ -158,13 +380,27 @@ class Pl011 {
   static constexpr uint32_t kRegMIS = 0x40;
   /// interrupt clear register
   static constexpr uint32_t kRegICR = 0x44;
+  /// DMA control register
+  static constexpr uint32_t kRegDMACR = 0x48;
 
   /// flag register bits
   static constexpr uint32_t kFRTxFIFO = (1 << 5);
   static constexpr uint32_t kFRRXFE = (1 << 4);
+  static constexpr uint32_t kFRRXFF = (1 << 6);
+  static constexpr uint32_t kFRTXFE = (1 << 7);
+  static constexpr uint32_t kFRBusy = (1 << 3);
 
   /// line control register bits
   static constexpr uint32_t kLCRHWlen8 = (3 << 5);
+  static constexpr uint32_t kLCRHFen = (1 << 4);
+  static constexpr uint32_t kLCRHPen = (1 << 1);
+  static constexpr uint32_t kLCRHEps = (1 << 2);
+  static constexpr uint32_t kLCRHStp2 = (1 << 3);
+
+  /// IFLS 档位（下标即 RXIFLSEL/TXIFLSEL 的值）对应的字节数
+  static constexpr uint8_t kTriggerLevels[] = {2, 4, 8, 12, 14};
+  /// IFLS 复位值对应的档位（FIFO 的 1/2）
+  static constexpr uint32_t kIflsHalf = 2;
 
   /// control register bits
   static constexpr uint32_t kCREnable = (1 << 0);
@@ -173,10 +409,41 @@ class Pl011 {
 
   /// interrupt mask bits
   static constexpr uint32_t kIMSCRxim = (1 << 4);
+  static constexpr uint32_t kIMSCTxim = (1 << 5);
+  static constexpr uint32_t kIMSCRtim = (1 << 6);
+
+  /// DMA control register bits
+  static constexpr uint32_t kDMACRRxdmae = (1 << 0);
+  static constexpr uint32_t kDMACRTxdmae = (1 << 1);
+  static constexpr uint32_t kDMACRDmaonerr = (1 << 2);
+
+  /**
+   * @brief 计算以 1/64 为单位的波特率分频（四舍五入）
+   *
+   * 分频 = clock / (16 * baud)，乘 64 后等于 clock * 4 / baud，
+   * 高 16 位写入 IBRD，低 6 位写入 FBRD。
+   */
+  [[nodiscard]] static constexpr auto CalcDivisor(uint32_t clock,
+                                                  uint32_t baud) -> uint32_t {
+    return static_cast<uint32_t>(
+        (static_cast<uint64_t>(clock) * 8 + baud) / (2 * uint64_t{baud}));
+  }
+
+  /// @brief 不超过 bytes 的最大 IFLS 档位（不足最低档时取最低档）
+  [[nodiscard]] static constexpr auto SelectTriggerLevel(uint8_t bytes)
+      -> uint32_t {
+    uint32_t sel = 0;
+    for (uint32_t i = 1; i < sizeof(kTriggerLevels); ++i) {
+      if (kTriggerLevels[i] <= bytes) {
+        sel = i;
+      }
+    }
+    return sel;
+  }
 
   MmioAccessor mmio_;
-  uint64_t base_clock_ = 0;
-  uint64_t baud_rate_ = 0;
+  /// 当前生效的配置
+  UartConfig config_{};
 };
 
 }  // namespace device_framework::detail::pl011
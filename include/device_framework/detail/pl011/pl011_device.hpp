@@ -5,8 +5,10 @@
 #ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_PL011_PL011_DEVICE_HPP_
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_PL011_PL011_DEVICE_HPP_
 
+#include <cstddef>
 #include <cstdint>
 
+#include "device_framework/detail/buffered_uart_device.hpp"
 #include "device_framework/detail/pl011/pl011.hpp"
 #include "device_framework/detail/uart_device.hpp"
 
@@ -27,6 +29,30 @@ class Pl011Device : public UartDevice<Pl011Device, Pl011> {
   }
 };
 
+/**
+ * @brief 中断驱动的 PL011 字符设备
+ *
+ * Write 写入 TX 环后立即返回并先行填充发送 FIFO，TXIM 中断从 TX 环继续
+ * 补充；接收中断把字节存入 RX 环供 Read 读取。需将 UART 中断路由到
+ * HandleInterrupt()。
+ *
+ * @tparam RxSize RX 环容量（2 的幂）
+ * @tparam TxSize TX 环容量（2 的幂）
+ */
+template <size_t RxSize = 256, size_t TxSize = 1024>
+class Pl011BufferedDevice
+    : public BufferedUartDevice<Pl011BufferedDevice<RxSize, TxSize>, Pl011,
+                                RxSize, TxSize> {
+ public:
+  Pl011BufferedDevice() = default;
+  explicit Pl011BufferedDevice(uint64_t base_addr) {
+    this->driver_ = Pl011(base_addr);
+  }
+  Pl011BufferedDevice(uint64_t base_addr, uint64_t clock, uint64_t baud_rate) {
+    this->driver_ = Pl011(base_addr, clock, baud_rate);
+  }
+};
+
 }  // namespace device_framework::detail::pl011
 
 #endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_PL011_PL011_DEVICE_HPP_ */
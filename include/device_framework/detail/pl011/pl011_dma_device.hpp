@@ -0,0 +1,454 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_PL011_PL011_DMA_DEVICE_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_PL011_PL011_DMA_DEVICE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "device_framework/detail/pl011/pl011.hpp"
+#include "device_framework/detail/uart_device.hpp"
+#include "device_framework/expected.hpp"
+#include "device_framework/ops/char_device.hpp"
+#include "device_framework/traits.hpp"
+
+namespace device_framework::detail::pl011 {
+
+/**
+ * @brief 由系统 DMA 控制器搬运数据的 PL011 字符设备
+ *
+ * 通过 UARTDMACR 的 TXDMAE/RXDMAE 把数据搬运交给 Traits 提供的外设 DMA
+ * 通道（见 DmaChannelTraits），CPU 只负责环形缓冲区的索引：
+ * - TX：Write 把数据复制到 TX 环后立即返回；TX 环中连续的一段交给发送
+ *   通道，完成后由 HandleInterrupt() 推进并提交下一段
+ * - RX：接收通道始终指向 RX 环的下一段空闲区域；通道完成或接收超时
+ *   中断（RTIM）时由 HandleInterrupt() 提交已到达的字节并重新启动，
+ *   DMA 停止后残留在 FIFO 中的字节以 PIO 读入
+ *
+ * 两个环均位于调用者提供的 DMA 缓冲区（大小见 CalcDmaSize()），
+ * 非一致性平台按 DmaCoherencyTraits 维护缓存。RX 环满时新到达的字节被
+ * 丢弃并计入 GetRxDropped()。
+ *
+ * 内存布局：
+ * ```
+ * [TX 环 TxSize][RX 环 RxSize]
+ * ```
+ *
+ * @tparam Traits 平台环境特征类型，需满足 DmaChannelTraits
+ * @tparam TxSize TX 环容量（2 的幂）
+ * @tparam RxSize RX 环容量（2 的幂）
+ * @warning 同一时刻只能有一个写者和一个读者；发送与接收 DMA 通道的
+ *          完成中断以及 UART 中断都需路由到 HandleInterrupt()
+ * @note 若 DMA 控制器以单次请求排空 FIFO，接收超时不会产生，部分填充的
+ *       RX 段要等到整段完成才被提交
+ */
+template <DmaChannelTraits Traits, size_t TxSize = 4096, size_t RxSize = 1024>
+class Pl011DmaDevice
+    : public CharDevice<Pl011DmaDevice<Traits, TxSize, RxSize>> {
+ public:
+  static_assert(TxSize >= 2 && (TxSize & (TxSize - 1)) == 0,
+                "TX ring size must be a power of two");
+  static_assert(RxSize >= 2 && (RxSize & (RxSize - 1)) == 0,
+                "RX ring size must be a power of two");
+
+  /**
+   * @brief 计算所需的 DMA 缓冲区大小
+   * @return TX 环与 RX 环的总字节数
+   */
+  [[nodiscard]] static constexpr auto CalcDmaSize() -> size_t {
+    return TxSize + RxSize;
+  }
+
+  /**
+   * @brief 工厂方法：初始化 PL011 并启动接收 DMA
+   *
+   * @param base_addr 设备 MMIO 基地址
+   * @param dma_buf CalcDmaSize() 字节、可供 DMA 访问的缓冲区
+   * @param clock 串口时钟（0 表示不设置波特率）
+   * @param baud_rate 波特率（0 表示不设置波特率）
+   * @return 成功返回设备实例；参数无效返回 kInvalidArgument，
+   *         接收通道无法启动返回 kDeviceBusy
+   */
+  [[nodiscard]] static auto Create(uint64_t base_addr, void* dma_buf,
+                                   uint64_t clock = 0, uint64_t baud_rate = 0)
+      -> Expected<Pl011DmaDevice> {
+    if (base_addr == 0 || dma_buf == nullptr) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    Pl011DmaDevice dev;
+    dev.driver_ = Pl011(base_addr, clock, baud_rate);
+    dev.tx_buf_ = static_cast<uint8_t*>(dma_buf);
+    dev.rx_buf_ = dev.tx_buf_ + TxSize;
+    dev.tx_phys_ = Traits::VirtToPhys(dev.tx_buf_);
+    dev.rx_phys_ = Traits::VirtToPhys(dev.rx_buf_);
+    dev.dr_phys_ = Traits::VirtToPhys(
+        reinterpret_cast<void*>(dev.driver_.GetDataRegisterAddress()));
+    dev.driver_.SetDma(true, true);
+    if (!dev.StartRx()) {
+      dev.driver_.SetDma(false, false);
+      return std::unexpected(Error{ErrorCode::kDeviceBusy});
+    }
+    return dev;
+  }
+
+  /// @brief 直接访问底层驱动（用于中断处理等需要绕过 Device 框架的场景）
+  auto GetDriver() -> Pl011& { return driver_; }
+
+  /// @brief TX 环中尚未发送完成的字节数
+  [[nodiscard]] auto GetTxPending() const -> size_t {
+    return tx_tail_.load(std::memory_order_acquire) -
+           tx_head_.load(std::memory_order_acquire);
+  }
+
+  /// @brief RX 环中等待读取的字节数
+  [[nodiscard]] auto GetRxAvailable() const -> size_t {
+    return rx_tail_.load(std::memory_order_acquire) -
+           rx_head_.load(std::memory_order_acquire);
+  }
+
+  /// @brief RX 环满而被丢弃的字节数
+  [[nodiscard]] auto GetRxDropped() const -> uint64_t {
+    return rx_dropped_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 阻塞直到 TX 环中的数据全部发送完成
+   *
+   * 不依赖中断，轮询发送通道的剩余字节数。用于 Release()、panic 输出等
+   * 场景。
+   */
+  auto DrainTx() -> void {
+    while (GetTxPending() != 0) {
+      KickTx();
+    }
+  }
+
+  /// @name 构造/析构函数
+  /// @{
+  Pl011DmaDevice() = default;
+  ~Pl011DmaDevice() = default;
+  Pl011DmaDevice(const Pl011DmaDevice&) = delete;
+  auto operator=(const Pl011DmaDevice&) -> Pl011DmaDevice& = delete;
+  /// 移动仅在无并发访问时进行（如设备初始化期间），进行中的 DMA 不受影响
+  Pl011DmaDevice(Pl011DmaDevice&& other) noexcept
+      : CharDevice<Pl011DmaDevice>(std::move(other)) {
+    MoveFrom(other);
+  }
+  auto operator=(Pl011DmaDevice&& other) noexcept -> Pl011DmaDevice& {
+    if (this != &other) {
+      CharDevice<Pl011DmaDevice>::operator=(std::move(other));
+      MoveFrom(other);
+    }
+    return *this;
+  }
+  /// @}
+
+ protected:
+  auto DoOpen(OpenFlags flags) -> Expected<void> {
+    if (!flags.CanRead() && !flags.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    flags_ = flags;
+    return {};
+  }
+
+  auto DoCharRead(std::span<uint8_t> buffer) -> Expected<size_t> {
+    if (!flags_.CanRead()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    size_t head = rx_head_.load(std::memory_order_relaxed);
+    size_t used = rx_tail_.load(std::memory_order_acquire) - head;
+    size_t count = buffer.size() < used ? buffer.size() : used;
+    for (size_t i = 0; i < count; ++i) {
+      buffer[i] = rx_buf_[(head + i) % RxSize];
+    }
+    rx_head_.store(head + count, std::memory_order_release);
+    this->RefreshPollReady([this] { return Readiness(); });
+    return count;
+  }
+
+  /**
+   * @brief 写入 TX 环并启动发送 DMA（不等待串口）
+   *
+   * @return 实际写入 TX 环的字节数（环剩余空间不足时小于 data.size()）
+   */
+  auto DoCharWrite(std::span<const uint8_t> data) -> Expected<size_t> {
+    if (!flags_.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    size_t tail = tx_tail_.load(std::memory_order_relaxed);
+    size_t space = TxSize - (tail - tx_head_.load(std::memory_order_acquire));
+    size_t count = data.size() < space ? data.size() : space;
+    for (size_t i = 0; i < count; ++i) {
+      tx_buf_[(tail + i) % TxSize] = data[i];
+    }
+    tx_tail_.store(tail + count, std::memory_order_release);
+    KickTx();
+    this->RefreshPollReady([this] { return Readiness(); });
+    return count;
+  }
+
+  auto DoPoll(PollEvents requested) -> Expected<PollEvents> {
+    return Readiness() & requested;
+  }
+
+  auto DoRelease() -> Expected<void> {
+    DrainTx();
+    return {};
+  }
+
+  /**
+   * @brief UartIoctl 命令
+   *
+   * kSetConfig 先同步排空 TX 环，避免已排队的数据以新的线路参数发出。
+   */
+  auto DoIoctl(uint32_t request, uintptr_t arg) -> Expected<int64_t> {
+    if (request == UartIoctl::kSetConfig) {
+      DrainTx();
+    }
+    return HandleUartIoctl(driver_, request, arg);
+  }
+
+  /**
+   * @brief UART 与 DMA 通道的中断处理
+   *
+   * 提交已完成的接收段并重新启动接收 DMA，推进 TX 环并提交下一段发送，
+   * 之后向就绪等待者报告两个环的状态。
+   *
+   * @note 可在中断上下文中安全调用
+   */
+  auto DoHandleInterrupt() -> void {
+    ServiceRx([](uint8_t) {});
+    KickTx();
+    this->RefreshPollReady([this] { return Readiness(); });
+  }
+
+  /**
+   * @brief UART 与 DMA 通道的中断处理（带回调版）
+   *
+   * 与无回调版相同，并对每个提交到 RX 环的字节调用 on_complete。
+   *
+   * @tparam CompletionCallback 签名：void(uint8_t ch)
+   * @param on_complete 每接收一个字节调用一次的回调函数
+   */
+  template <typename CompletionCallback>
+  auto DoHandleInterrupt(CompletionCallback&& on_complete) -> void {
+    ServiceRx(on_complete);
+    KickTx();
+    this->RefreshPollReady([this] { return Readiness(); });
+  }
+
+ private:
+  /// @brief CRTP 基类需要访问 DoXxx 方法
+  template <class>
+  friend class ::device_framework::DeviceOperationsBase;
+  template <class>
+  friend class ::device_framework::CharDevice;
+
+  /// @brief 由两个环的状态得到当前就绪事件（不访问设备寄存器）
+  [[nodiscard]] auto Readiness() const -> PollEvents {
+    uint32_t ready = 0;
+    if (GetRxAvailable() != 0) {
+      ready |= PollEvents::kIn;
+    }
+    if (GetTxPending() < TxSize) {
+      ready |= PollEvents::kOut;
+    }
+    return PollEvents{ready};
+  }
+
+  /**
+   * @brief 在 RX 环的下一段连续空闲区域上启动接收 DMA
+   *
+   * 环满时不启动，此时保留接收水位中断，由 DrainRxFifo() 丢弃新字节。
+   * 仅在中断处理程序（或 Create()）中调用。
+   *
+   * @return 已启动或环满时返回 true，通道拒绝传输时返回 false
+   */
+  auto StartRx() -> bool {
+    size_t tail = rx_tail_.load(std::memory_order_relaxed);
+    size_t space = RxSize - (tail - rx_head_.load(std::memory_order_acquire));
+    size_t offset = tail % RxSize;
+    size_t chunk = RxSize - offset < space ? RxSize - offset : space;
+    if (chunk == 0) {
+      driver_.SetRxInterrupt(true);
+      return true;
+    }
+    DmaSyncForDevice<Traits>(rx_buf_ + offset, chunk);
+    if (!Traits::DmaStartRx(dr_phys_, rx_phys_ + offset, chunk)) {
+      driver_.SetRxInterrupt(true);
+      return false;
+    }
+    rx_inflight_ = chunk;
+    driver_.SetRxInterrupt(false);
+    return true;
+  }
+
+  /**
+   * @brief 接收侧中断处理
+   *
+   * 接收段未完成且没有接收超时时直接返回；否则中止通道、提交已写入
+   * 的字节、以 PIO 读走 FIFO 中的残留字节，再启动下一段。
+   */
+  template <typename Callback>
+  auto ServiceRx(Callback&& on_byte) -> void {
+    if (rx_inflight_ != 0) {
+      size_t remaining = Traits::DmaRxRemaining();
+      if (remaining != 0) {
+        if ((driver_.GetMaskedInterruptStatus() & Pl011::kIntRt) == 0) {
+          return;
+        }
+        Traits::DmaStopRx();
+        remaining = Traits::DmaRxRemaining();
+      }
+      CommitRx(rx_inflight_ - remaining, on_byte);
+      rx_inflight_ = 0;
+    }
+    DrainRxFifo(on_byte);
+    driver_.ClearInterrupt(Pl011::kIntRx | Pl011::kIntRt);
+    (void)StartRx();
+  }
+
+  /// @brief 把 DMA 写入的 count 字节发布给读者
+  template <typename Callback>
+  auto CommitRx(size_t count, Callback& on_byte) -> void {
+    size_t tail = rx_tail_.load(std::memory_order_relaxed);
+    DmaSyncForCpu<Traits>(rx_buf_ + tail % RxSize, count);
+    for (size_t i = 0; i < count; ++i) {
+      on_byte(rx_buf_[(tail + i) % RxSize]);
+    }
+    rx_tail_.store(tail + count, std::memory_order_release);
+  }
+
+  /// @brief 以 PIO 读走 FIFO 中的残留字节，RX 环满时丢弃
+  template <typename Callback>
+  auto DrainRxFifo(Callback& on_byte) -> void {
+    while (driver_.HasData()) {
+      size_t tail = rx_tail_.load(std::memory_order_relaxed);
+      size_t space =
+          RxSize - (tail - rx_head_.load(std::memory_order_acquire));
+      size_t offset = tail % RxSize;
+      size_t chunk = RxSize - offset < space ? RxSize - offset : space;
+      if (chunk == 0) {
+        uint8_t discard[Pl011::kFifoDepth];
+        rx_dropped_.fetch_add(driver_.ReadBurst(discard),
+                              std::memory_order_relaxed);
+        continue;
+      }
+      size_t count = driver_.ReadBurst({rx_buf_ + offset, chunk});
+      // 下一段接收 DMA 可能与这些字节共享缓存行，先写回
+      DmaSyncForDevice<Traits>(rx_buf_ + offset, count);
+      for (size_t i = 0; i < count; ++i) {
+        on_byte(rx_buf_[offset + i]);
+      }
+      rx_tail_.store(tail + count, std::memory_order_release);
+    }
+  }
+
+  /**
+   * @brief 请求推进 TX 环
+   *
+   * 与 BufferedUartDevice 相同的发送权交接：设置请求标志后尝试取得
+   * 发送权，取得者处理请求并在释放后检查期间是否有新请求，
+   * 未取得者直接返回。
+   */
+  auto KickTx() -> void {
+    tx_requested_.store(true);
+    while (tx_requested_.load() && !tx_busy_.exchange(true)) {
+      tx_requested_.store(false);
+      PumpTx();
+      tx_busy_.store(false);
+    }
+  }
+
+  /**
+   * @brief 回收已完成的发送段并提交下一段（仅由发送权持有者调用）
+   */
+  auto PumpTx() -> void {
+    size_t head = tx_head_.load(std::memory_order_relaxed);
+    if (tx_inflight_ != 0) {
+      if (Traits::DmaTxRemaining() != 0) {
+        return;
+      }
+      head += tx_inflight_;
+      tx_inflight_ = 0;
+      tx_head_.store(head, std::memory_order_release);
+    }
+    size_t pending = tx_tail_.load(std::memory_order_acquire) - head;
+    if (pending == 0) {
+      return;
+    }
+    size_t offset = head % TxSize;
+    size_t chunk = TxSize - offset < pending ? TxSize - offset : pending;
+    DmaSyncForDevice<Traits>(tx_buf_ + offset, chunk);
+    if (Traits::DmaStartTx(tx_phys_ + offset, dr_phys_, chunk)) {
+      tx_inflight_ = chunk;
+    }
+  }
+
+  auto MoveFrom(Pl011DmaDevice& other) -> void {
+    driver_ = std::move(other.driver_);
+    flags_ = other.flags_;
+    tx_buf_ = other.tx_buf_;
+    rx_buf_ = other.rx_buf_;
+    tx_phys_ = other.tx_phys_;
+    rx_phys_ = other.rx_phys_;
+    dr_phys_ = other.dr_phys_;
+    tx_head_.store(other.tx_head_.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+    tx_tail_.store(other.tx_tail_.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+    tx_inflight_ = other.tx_inflight_;
+    rx_head_.store(other.rx_head_.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+    rx_tail_.store(other.rx_tail_.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+    rx_inflight_ = other.rx_inflight_;
+    rx_dropped_.store(other.rx_dropped_.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+    other.tx_buf_ = nullptr;
+    other.rx_buf_ = nullptr;
+    other.tx_inflight_ = 0;
+    other.rx_inflight_ = 0;
+  }
+
+  Pl011 driver_;
+  OpenFlags flags_{0};
+
+  /// TX 环（DMA 缓冲区起始处）
+  uint8_t* tx_buf_ = nullptr;
+  /// RX 环（紧随 TX 环）
+  uint8_t* rx_buf_ = nullptr;
+  uintptr_t tx_phys_ = 0;
+  uintptr_t rx_phys_ = 0;
+  /// 数据寄存器的物理地址（DMA 设备端地址）
+  uintptr_t dr_phys_ = 0;
+
+  /// TX 环消费者索引（已发送完成），由发送权持有者推进
+  std::atomic<size_t> tx_head_{0};
+  /// TX 环生产者索引，由 Write 推进
+  std::atomic<size_t> tx_tail_{0};
+  /// 发送通道上进行中的字节数（0 表示空闲），仅发送权持有者访问
+  size_t tx_inflight_ = 0;
+  /// RX 环消费者索引，由 Read 推进
+  std::atomic<size_t> rx_head_{0};
+  /// RX 环生产者索引，由中断处理程序推进
+  std::atomic<size_t> rx_tail_{0};
+  /// 接收通道上进行中的段长（0 表示空闲），仅中断处理程序访问
+  size_t rx_inflight_ = 0;
+  /// RX 环满时丢弃的字节数
+  std::atomic<uint64_t> rx_dropped_{0};
+  /// 是否有一方持有发送权
+  std::atomic<bool> tx_busy_{false};
+  /// 是否有未处理的发送请求
+  std::atomic<bool> tx_requested_{false};
+};
+
+}  // namespace device_framework::detail::pl011
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_PL011_PL011_DMA_DEVICE_HPP_ \
+        */
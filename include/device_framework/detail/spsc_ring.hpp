@@ -0,0 +1,179 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_SPSC_RING_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_SPSC_RING_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <span>
+
+namespace device_framework::detail {
+
+/**
+ * @brief 固定容量的单生产者-单消费者无锁环形缓冲区
+ *
+ * 生产者只写 tail_，消费者只写 head_，两侧各自以 acquire 读取对方的
+ * 索引，因此生产者与消费者可分别位于普通上下文与中断处理程序（或两个核）
+ * 中，无需加锁或关中断。索引单调递增，按 N 取模定位元素。
+ *
+ * @tparam T 元素类型（可平凡拷贝）
+ * @tparam N 容量（2 的幂）
+ * @warning 同一时刻只能有一个生产者和一个消费者
+ */
+template <typename T, size_t N>
+class SpscRing {
+ public:
+  static_assert(N >= 2 && (N & (N - 1)) == 0,
+                "SpscRing capacity must be a power of two");
+
+  /**
+   * @brief 写入一个元素（生产者）
+   * @param value 待写入的元素
+   * @return 成功返回 true，缓冲区已满返回 false
+   */
+  auto Push(const T& value) -> bool {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == N) {
+      return false;
+    }
+    buffer_[tail % N] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief 批量写入（生产者）
+   * @param data 待写入的元素
+   * @return 实际写入的元素数（缓冲区剩余空间不足时小于 data.size()）
+   */
+  auto Write(std::span<const T> data) -> size_t {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t space = N - (tail - head_.load(std::memory_order_acquire));
+    size_t count = data.size() < space ? data.size() : space;
+    for (size_t i = 0; i < count; ++i) {
+      buffer_[(tail + i) % N] = data[i];
+    }
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  /**
+   * @brief 取出一个元素（消费者）
+   * @return 取出的元素，缓冲区为空时返回 std::nullopt
+   */
+  auto Pop() -> std::optional<T> {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+    T value = buffer_[head % N];
+    head_.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+  /**
+   * @brief 批量取出（消费者）
+   * @param out 输出缓冲区
+   * @return 实际取出的元素数
+   */
+  auto Read(std::span<T> out) -> size_t {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t used = tail_.load(std::memory_order_acquire) - head;
+    size_t count = out.size() < used ? out.size() : used;
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = buffer_[(head + i) % N];
+    }
+    head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  /**
+   * @brief 查看下一个元素但不取出（消费者）
+   * @return 下一个元素，缓冲区为空时返回 std::nullopt
+   */
+  [[nodiscard]] auto Peek() const -> std::optional<T> {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+    return buffer_[head % N];
+  }
+
+  /**
+   * @brief 批量查看但不取出（消费者）
+   * @param out 输出缓冲区
+   * @return 复制到 out 的元素数
+   */
+  [[nodiscard]] auto Peek(std::span<T> out) const -> size_t {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t used = tail_.load(std::memory_order_acquire) - head;
+    size_t count = out.size() < used ? out.size() : used;
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = buffer_[(head + i) % N];
+    }
+    return count;
+  }
+
+  /**
+   * @brief 丢弃已查看的元素（消费者）
+   * @param count 丢弃的元素数，不得超过先前 Peek() 返回的数量
+   */
+  auto Skip(size_t count) -> void {
+    head_.store(head_.load(std::memory_order_relaxed) + count,
+                std::memory_order_release);
+  }
+
+  /// @brief 当前元素数（另一侧并发修改时为近似值）
+  [[nodiscard]] auto Size() const -> size_t {
+    return tail_.load(std::memory_order_acquire) -
+           head_.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] auto Empty() const -> bool { return Size() == 0; }
+
+  [[nodiscard]] auto Full() const -> bool { return Size() == N; }
+
+  [[nodiscard]] static constexpr auto Capacity() -> size_t { return N; }
+
+  /// @name 构造/析构函数
+  /// @{
+  SpscRing() = default;
+  ~SpscRing() = default;
+  SpscRing(const SpscRing&) = delete;
+  auto operator=(const SpscRing&) -> SpscRing& = delete;
+  /// 移动仅在两侧都未并发访问时进行（如设备初始化期间）
+  SpscRing(SpscRing&& other) noexcept { MoveFrom(other); }
+  auto operator=(SpscRing&& other) noexcept -> SpscRing& {
+    if (this != &other) {
+      MoveFrom(other);
+    }
+    return *this;
+  }
+  /// @}
+
+ private:
+  auto MoveFrom(SpscRing& other) -> void {
+    size_t head = other.head_.load(std::memory_order_relaxed);
+    size_t tail = other.tail_.load(std::memory_order_relaxed);
+    for (size_t i = head; i != tail; ++i) {
+      buffer_[i % N] = other.buffer_[i % N];
+    }
+    head_.store(head, std::memory_order_relaxed);
+    tail_.store(tail, std::memory_order_relaxed);
+    other.head_.store(tail, std::memory_order_relaxed);
+  }
+
+  /// 消费者索引（下一个待取出的位置）
+  std::atomic<size_t> head_{0};
+  /// 生产者索引（下一个待写入的位置）
+  std::atomic<size_t> tail_{0};
+  /// 元素存储
+  T buffer_[N]{};
+};
+
+}  // namespace device_framework::detail
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_SPSC_RING_HPP_ */
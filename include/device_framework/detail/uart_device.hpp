@@ -6,10 +6,12 @@
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_UART_DEVICE_HPP_
 
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <span>
 
+#include "device_framework/defs.h"
 #include "device_framework/expected.hpp"
 #include "device_framework/ops/char_device.hpp"
 
@@ -28,6 +30,72 @@ concept UartDriver = requires(const T& driver, uint8_t ch) {
   { driver.HasData() } -> std::same_as<bool>;
 };
 
+/**
+ * @brief 可选：支持按 FIFO 批量收发的 UART 底层驱动
+ *
+ * WriteBurst/ReadBurst 均不阻塞，每个 FIFO 块只检查一次状态寄存器，
+ * 返回实际处理的字节数。满足此 concept 的驱动由 UartDevice 与
+ * BufferedUartDevice 优先使用批量路径，否则回退到逐字节的
+ * PutChar/TryGetChar。
+ */
+template <typename T>
+concept UartBurstDriver =
+    UartDriver<T> && requires(const T& driver, std::span<const uint8_t> data,
+                              std::span<uint8_t> buffer) {
+      { driver.WriteBurst(data) } -> std::same_as<size_t>;
+      { driver.ReadBurst(buffer) } -> std::same_as<size_t>;
+    };
+
+/**
+ * @brief 可选：支持运行时线路与 FIFO 配置的 UART 底层驱动
+ *
+ * 满足此 concept 的驱动可通过设备的 Ioctl(UartIoctl::kSetConfig /
+ * kGetConfig) 调整波特率、字符格式与 FIFO 触发水位。
+ */
+template <typename T>
+concept UartConfigurableDriver =
+    UartDriver<T> &&
+    requires(T& driver, const T& const_driver, const UartConfig& config) {
+      { driver.Configure(config) } -> std::same_as<Expected<void>>;
+      { const_driver.GetConfig() } -> std::same_as<UartConfig>;
+    };
+
+/**
+ * @brief UART 设备共用的 Ioctl 处理
+ *
+ * @param driver 底层驱动
+ * @param request UartIoctl 命令码
+ * @param arg 指向 UartConfig 的指针
+ * @return 成功返回 0；arg 为空返回 kInvalidArgument，
+ *         驱动不支持配置或命令未知返回 kDeviceNotSupported
+ */
+template <UartDriver DriverType>
+auto HandleUartIoctl(DriverType& driver, uint32_t request, uintptr_t arg)
+    -> Expected<int64_t> {
+  if constexpr (UartConfigurableDriver<DriverType>) {
+    if (request != UartIoctl::kSetConfig && request != UartIoctl::kGetConfig) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+    }
+    if (arg == 0) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    auto* config = reinterpret_cast<UartConfig*>(arg);
+    if (request == UartIoctl::kSetConfig) {
+      auto result = driver.Configure(*config);
+      if (!result) {
+        return std::unexpected(result.error());
+      }
+    }
+    *config = driver.GetConfig();
+    return 0;
+  } else {
+    (void)driver;
+    (void)request;
+    (void)arg;
+    return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+  }
+}
+
 /**
  * @brief UART 字符设备通用 CRTP 中间层
  *
@@ -37,6 +105,9 @@ concept UartDriver = requires(const T& driver, uint8_t ch) {
  * - `TryGetChar() -> std::optional<uint8_t>`
  * - `HasData() -> bool`
  *
+ * 驱动满足 UartBurstDriver 时，读写与中断处理按 FIFO 块进行；满足
+ * UartConfigurableDriver 时支持 UartIoctl 命令。
+ *
  * @tparam Derived 具体设备类型（CRTP）
  * @tparam DriverType 底层 UART 驱动类型
  */
@@ -61,39 +132,79 @@ class UartDevice : public CharDevice<Derived> {
     if (!flags_.CanRead()) {
       return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
     }
-    for (size_t i = 0; i < buffer.size(); ++i) {
-      auto ch = driver_.TryGetChar();
-      if (!ch) {
-        return i;
+    if constexpr (UartBurstDriver<DriverType>) {
+      return driver_.ReadBurst(buffer);
+    } else {
+      for (size_t i = 0; i < buffer.size(); ++i) {
+        auto ch = driver_.TryGetChar();
+        if (!ch) {
+          return i;
+        }
+        buffer[i] = *ch;
       }
-      buffer[i] = *ch;
+      return buffer.size();
     }
-    return buffer.size();
   }
 
+  /**
+   * @brief 写入串口
+   *
+   * 默认等待发送 FIFO 直到全部写出。以 OpenFlags::kNonBlock 打开时，
+   * FIFO 满即返回已写入的字节数（可能为 0）；驱动既无 WriteBurst 也无
+   * TryPutChar 时仍逐字节等待。
+   *
+   * @return 实际写入的字节数
+   */
   auto DoCharWrite(std::span<const uint8_t> data) -> Expected<size_t> {
     if (!flags_.CanWrite()) {
       return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
     }
-    for (auto byte : data) {
-      driver_.PutChar(byte);
+    if constexpr (UartBurstDriver<DriverType>) {
+      size_t written = 0;
+      while (written < data.size()) {
+        size_t sent = driver_.WriteBurst(data.subspan(written));
+        if (sent == 0 && flags_.IsNonBlock()) {
+          break;
+        }
+        written += sent;
+      }
+      return written;
+    } else if constexpr (requires(uint8_t ch) {
+                           { driver_.TryPutChar(ch) } -> std::same_as<bool>;
+                         }) {
+      for (size_t i = 0; i < data.size(); ++i) {
+        if (flags_.IsNonBlock()) {
+          if (!driver_.TryPutChar(data[i])) {
+            return i;
+          }
+        } else {
+          driver_.PutChar(data[i]);
+        }
+      }
+    } else {
+      for (auto byte : data) {
+        driver_.PutChar(byte);
+      }
     }
     return data.size();
   }
 
+  /**
+   * @brief 查询就绪状态并刷新 GetPollReady() 缓存
+   *
+   * 驱动提供 TxReady() 时 kOut 反映发送 FIFO 是否可写入，否则总是就绪。
+   */
   auto DoPoll(PollEvents requested) -> Expected<PollEvents> {
-    uint32_t ready = 0;
-    if (requested.HasIn() && driver_.HasData()) {
-      ready |= PollEvents::kIn;
-    }
-    if (requested.HasOut()) {
-      ready |= PollEvents::kOut;
-    }
-    return PollEvents{ready};
+    return this->RefreshPollReady([this] { return Readiness(); }) &
+           requested;
   }
 
   auto DoRelease() -> Expected<void> { return {}; }
 
+  auto DoIoctl(uint32_t request, uintptr_t arg) -> Expected<int64_t> {
+    return HandleUartIoctl(driver_, request, arg);
+  }
+
   /**
    * @brief UART 中断处理（简化版）
    *
@@ -103,27 +214,36 @@ class UartDevice : public CharDevice<Derived> {
    * @note 可在中断上下文中安全调用
    */
   auto DoHandleInterrupt() -> void {
-    while (driver_.HasData()) {
-      (void)driver_.TryGetChar();
-    }
+    DoHandleInterrupt([](uint8_t) {});
   }
 
   /**
    * @brief UART 中断处理（带回调版）
    *
-   * 排空接收 FIFO，对每个接收到的字节调用 on_complete 回调。
+   * 排空接收 FIFO，对每个接收到的字节调用 on_complete 回调，
+   * 之后向就绪等待者报告当前状态。
    *
    * @tparam CompletionCallback 签名：void(uint8_t ch)
    * @param on_complete 每接收一个字节调用一次的回调函数
    */
   template <typename CompletionCallback>
   auto DoHandleInterrupt(CompletionCallback&& on_complete) -> void {
-    while (driver_.HasData()) {
-      auto ch = driver_.TryGetChar();
-      if (ch) {
-        on_complete(*ch);
+    if constexpr (UartBurstDriver<DriverType>) {
+      uint8_t chunk[kRxChunkSize];
+      while (size_t count = driver_.ReadBurst(chunk)) {
+        for (size_t i = 0; i < count; ++i) {
+          on_complete(chunk[i]);
+        }
+      }
+    } else {
+      while (driver_.HasData()) {
+        auto ch = driver_.TryGetChar();
+        if (ch) {
+          on_complete(*ch);
+        }
       }
     }
+    this->RefreshPollReady([this] { return Readiness(); });
   }
 
   /// @name 构造/析构函数
@@ -144,6 +264,25 @@ class UartDevice : public CharDevice<Derived> {
   friend class ::device_framework::DeviceOperationsBase;
   template <class>
   friend class ::device_framework::CharDevice;
+
+  /// @brief 读取状态寄存器得到当前就绪事件
+  [[nodiscard]] auto Readiness() const -> PollEvents {
+    uint32_t ready = 0;
+    if (driver_.HasData()) {
+      ready |= PollEvents::kIn;
+    }
+    if constexpr (requires { driver_.TxReady(); }) {
+      if (driver_.TxReady()) {
+        ready |= PollEvents::kOut;
+      }
+    } else {
+      ready |= PollEvents::kOut;
+    }
+    return PollEvents{ready};
+  }
+
+  /// 中断处理中每次批量读取的字节数
+  static constexpr size_t kRxChunkSize = 16;
 };
 
 }  // namespace device_framework::detail
@@ -199,6 +199,74 @@ class DeviceInitializer {
     return {};
   }
 
+  /**
+   * @brief 以已知特性快速重新初始化设备（跳过特性读取与日志）
+   *
+   * 用于复位后的快速恢复：设备特性在首次 Init() 时已协商，这里直接写回
+   * negotiated_features 而不再读取设备特性，成功路径上不输出日志。
+   * 依次执行复位、ACKNOWLEDGE、DRIVER、写入特性、FEATURES_OK 校验，
+   * 调用 rearm_queues(*this) 重新配置队列（通常只调用 RearmQueue()），
+   * 最后设置 DRIVER_OK。
+   *
+   * @tparam RearmQueues void(DeviceInitializer&)
+   * @param negotiated_features 此前协商得到的特性位
+   * @param rearm_queues 在 FEATURES_OK 与 DRIVER_OK 之间配置队列的回调
+   * @return 成功或失败；设备不再接受这些特性时返回
+   *         kFeatureNegotiationFailed
+   * @see virtio-v1.2#3.1.1 Driver Requirements: Device Initialization
+   */
+  template <typename RearmQueues>
+  [[nodiscard]] auto Reinit(uint64_t negotiated_features,
+                            RearmQueues&& rearm_queues) -> Expected<void> {
+    if (!transport_.IsValid()) {
+      return std::unexpected(Error{ErrorCode::kTransportNotInitialized});
+    }
+
+    transport_.Reset();
+    transport_.SetStatus(TransportImpl::kAcknowledge);
+    transport_.SetStatus(TransportImpl::kAcknowledge | TransportImpl::kDriver);
+    transport_.SetDriverFeatures(negotiated_features);
+    transport_.SetStatus(TransportImpl::kAcknowledge | TransportImpl::kDriver |
+                         TransportImpl::kFeaturesOk);
+
+    uint32_t status = transport_.GetStatus();
+    if ((status & TransportImpl::kFeaturesOk) == 0) {
+      Traits::Log("Device rejected previously negotiated features");
+      transport_.SetStatus(status | TransportImpl::kFailed);
+      return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
+    }
+
+    rearm_queues(*this);
+
+    transport_.SetStatus(status | TransportImpl::kDriverOk);
+    if ((transport_.GetStatus() & TransportImpl::kDeviceNeedsReset) != 0) {
+      Traits::Log("Device re-activation failed: device needs reset");
+      return std::unexpected(Error{ErrorCode::kDeviceError});
+    }
+    return {};
+  }
+
+  /**
+   * @brief 重新配置一个此前已由 SetupQueue() 校验过的 virtqueue
+   *
+   * 与 SetupQueue() 相同，但不再读取 QueueNumMax，也不输出日志。
+   * 只应在 Reinit() 的回调中调用。
+   *
+   * @param queue_idx 队列索引
+   * @param desc_phys 描述符表的客户机物理地址
+   * @param avail_phys Available Ring 的客户机物理地址
+   * @param used_phys Used Ring 的客户机物理地址
+   * @param queue_size 队列大小
+   */
+  auto RearmQueue(uint32_t queue_idx, uint64_t desc_phys, uint64_t avail_phys,
+                  uint64_t used_phys, uint32_t queue_size) -> void {
+    transport_.SetQueueNum(queue_idx, queue_size);
+    transport_.SetQueueDesc(queue_idx, desc_phys);
+    transport_.SetQueueAvail(queue_idx, avail_phys);
+    transport_.SetQueueUsed(queue_idx, used_phys);
+    transport_.SetQueueReady(queue_idx, true);
+  }
+
   /**
    * @brief 获取底层传输层引用
    *
@@ -5,17 +5,25 @@
 #ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_BLK_HPP_
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_BLK_HPP_
 
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <span>
 #include <type_traits>
 #include <utility>
 
 #include "device_framework/detail/virtio/defs.h"
 #include "device_framework/detail/virtio/device/device_initializer.hpp"
 #include "device_framework/detail/virtio/device/virtio_blk_defs.h"
+#include "device_framework/detail/virtio/feature_set.hpp"
 #include "device_framework/detail/virtio/traits.hpp"
 #include "device_framework/detail/virtio/transport/mmio.hpp"
+#include "device_framework/detail/virtio/virt_queue/packed.hpp"
 #include "device_framework/detail/virtio/virt_queue/split.hpp"
 #include "device_framework/expected.hpp"
+#include "device_framework/trace.hpp"
 
 namespace device_framework::detail::virtio::blk {
 
@@ -30,7 +38,21 @@ namespace device_framework::detail::virtio::blk {
  * - Virtqueue 的创建和管理（通过 VirtqueueT 模板参数泛化）
  * - 设备初始化序列（特性协商、队列配置、设备激活）
  * - 异步 IO 接口（Enqueue/Kick/HandleInterrupt 回调模型）
+ * - 协程接口（co_await AsyncRead/AsyncWrite，完成时自动恢复协程）
  * - 同步读写便捷方法（基于异步接口实现）
+ * - FLUSH / GET_ID / 多段 DISCARD / WRITE_ZEROES 命令（按协商的特性启用）
+ * - 可选遥测（Traits 满足 TelemetryTraits 时记录延迟直方图与在途深度）
+ * - 可选跟踪（Traits 满足 TraceTraits 时在热路径写入 TraceRing 记录）
+ * - 可选多生产者并发提交（Traits 满足 ConcurrentSubmitTraits 时）
+ * - 请求取消与超时（Cancel()/WaitFor()；Traits 满足 TimestampTraits 时
+ *   支持按请求截止时间的超时扫描 ExpireRequests()）
+ * - 可选编译期特性集（Features 参数），裁剪确定关闭的特性路径
+ *
+ * 并发提交模式下，请求槽 i 固定使用环上描述符 i 及其间接描述符表，
+ * 槽位图以原子操作分配，因此 Enqueue*()/EnqueueBatch()/Kick() 可由
+ * 多个核同时调用，只有 avail idx 的发布按预留顺序串行。该模式要求
+ * split virtqueue 并协商 VIRTIO_F_INDIRECT_DESC；HandleInterrupt()/
+ * PollCompletions() 及同步接口仍须由单一上下文调用，可与提交并发执行。
  *
  * 用户只需提供 MMIO 基地址和 DMA 缓冲区，
  * 即可通过 Read() / Write() 或异步接口进行块设备操作。
@@ -38,27 +60,118 @@ namespace device_framework::detail::virtio::blk {
  * @tparam Traits 平台环境特征类型
  * @tparam TransportT 传输层模板（默认 MmioTransport）
  * @tparam VirtqueueT Virtqueue 模板（默认 SplitVirtqueue）
+ * @tparam MaxInflight 每个队列的请求槽数量（1..4096，默认 64）；
+ *         实际并发上限为 min(MaxInflight, queue_size)
+ * @tparam Features 编译期特性集（默认 RuntimeFeatures，全部按运行时
+ *         协商结果处理）；使用 FeatureSet 固定特性后，关闭的特性不再
+ *         请求，Kick/完成路径上的对应分支在编译期消除
  * @see virtio-v1.2#5.2 Block Device
  * @see 架构文档 §3
  */
 template <VirtioTraits Traits = NullVirtioTraits,
           template <class> class TransportT = MmioTransport,
-          template <class> class VirtqueueT = SplitVirtqueue>
+          template <class> class VirtqueueT = SplitVirtqueue,
+          uint16_t MaxInflight = 64,
+          FeatureSetPolicy Features = RuntimeFeatures>
 class VirtioBlk {
  public:
   /// 异步 IO 回调中使用的用户自定义上下文指针类型
   using UserData = void*;
 
-  /// 每个设备的最大并发(in-flight)请求数
-  static constexpr uint16_t kMaxInflight = 64;
+  /// 是否支持请求截止时间（需要 Traits::Now()，且未启用并发提交）
+  static constexpr bool kDeadlines =
+      TimestampTraits<Traits> && !ConcurrentSubmitTraits<Traits>;
+
+  /**
+   * @brief EnqueueBatch() 的单个请求描述
+   */
+  struct BlkRequest {
+    /// 请求类型（kIn/kOut）
+    ReqType type;
+    /// 起始扇区号（以 512 字节为单位）
+    uint64_t sector;
+    /// 数据缓冲区 IoVec 数组
+    const IoVec* buffers;
+    /// buffers 数组中的元素数量
+    size_t buffer_count;
+    /// 用户自定义上下文指针，在 HandleInterrupt 回调时原样传回
+    UserData token;
+  };
+
+  /**
+   * @brief 在途请求的句柄（由 Enqueue*() 返回，供 Cancel()/WaitFor() 使用）
+   *
+   * 由队列、请求槽与该槽的分配代数组成。请求完成后槽被新请求复用时
+   * 代数随之改变，过期的句柄因此不会指向新请求。
+   */
+  struct RequestHandle {
+    /// 队列索引
+    uint16_t queue_index;
+    /// 请求槽索引
+    uint16_t slot;
+    /// 请求槽的分配代数
+    uint32_t generation;
+  };
+
+  /**
+   * @brief DISCARD / WRITE_ZEROES 请求的范围限制（随配置空间快照缓存）
+   */
+  struct RangeLimits {
+    /// 单个范围的最大扇区数
+    uint32_t max_sectors = 0;
+    /// 单个请求的最大范围数（0 表示设备不支持该命令）
+    uint32_t max_segments = 0;
+  };
+
+  /**
+   * @brief 快速恢复所需的设备状态（可跨 kexec / 热重启交接）
+   *
+   * 由 GetResumeState() 获取，传给 Restore() 在同一块队列 DMA 内存上
+   * 重建驱动，不再重新协商特性。只含普通字段，可原样保存在交接区。
+   */
+  struct ResumeState {
+    /// 协商后的特性位
+    uint64_t features = 0;
+    /// 每个队列的描述符数量
+    uint32_t queue_size = 0;
+    /// 实际使用的队列数
+    uint16_t queue_count = 0;
+    /// 自适应轮询阈值（0 = 禁用）
+    uint32_t poll_threshold = 0;
+  };
+
+  /// 同步 Discard()/WriteZeroes() 单个请求携带的最大范围数
+  static constexpr size_t kMaxSyncRanges = 16;
+
+  /// 每个队列的最大并发(in-flight)请求数（请求槽数量）
+  static constexpr uint16_t kMaxInflight = MaxInflight;
+  static_assert(kMaxInflight >= 1 && kMaxInflight <= 4096,
+                "MaxInflight must be in [1, 4096]");
+
+  /// 每个设备支持的最大请求队列数（VIRTIO_BLK_F_MQ，特性集关闭 MQ 时为 1）
+  static constexpr uint16_t kMaxQueues =
+      kFeatureMode<Features, BlkFeatureBit::kMq> == FeatureMode::kNever ? 1
+                                                                        : 8;
+
+  /// 多队列 DMA 布局中每个队列区域的对齐要求（字节）
+  static constexpr size_t kQueueAlign = 4096;
 
   /// 每个 Scatter-Gather 请求的最大 IoVec 数量（含请求头和状态字节）
   static constexpr size_t kMaxSgElements = 18;
 
+  /// 协商 VIRTIO_F_INDIRECT_DESC 后每个请求的最大 IoVec 数量
+  /// （含请求头和状态字节，即每个请求槽间接描述符表的容量）
+  static constexpr size_t kMaxIndirectSgElements = 32;
+
   /**
    * @brief 获取多队列所需的总 DMA 内存大小
    *
    * 调用者应根据此值预分配页对齐、已清零的 DMA 内存。
+   * 每个队列占用一段按 kQueueAlign 对齐的独立区域，队列 i 位于
+   * `i * GetQueueStride(queue_size)` 偏移处；区域内依次为 Virtqueue、
+   * 该队列全部请求槽的间接描述符表、描述符链头到请求槽的映射表、
+   * 请求槽簿记数组，以及按缓存行对齐的请求头/范围数组/状态字节数组。
+   * 请求状态全部位于该区域内，驱动对象本身只保存指针。
    *
    * @param queue_count 请求的队列数量
    * @param queue_size 每个队列的描述符数量（必须为 2 的幂）
@@ -68,22 +181,34 @@ class VirtioBlk {
   [[nodiscard]] static constexpr auto GetRequiredVqMemSize(uint16_t queue_count,
                                                            uint32_t queue_size)
       -> std::pair<size_t, size_t> {
-    // 始终按 event_idx=true 分配，因为特性协商在分配之后
-    size_t per_queue =
-        VirtqueueT<Traits>::CalcSize(static_cast<uint16_t>(queue_size), true);
-    return {per_queue * queue_count, 4096};
+    return {GetQueueStride(queue_size) * queue_count, kQueueAlign};
+  }
+
+  /**
+   * @brief 获取多队列 DMA 布局中相邻队列区域的间距
+   *
+   * @param queue_size 每个队列的描述符数量（必须为 2 的幂）
+   * @return 单个队列区域按 kQueueAlign 对齐后的字节数
+   */
+  [[nodiscard]] static constexpr auto GetQueueStride(uint32_t queue_size)
+      -> size_t {
+    // 始终按 event_idx=true 并预留间接描述符表分配，因为特性协商在分配之后
+    return AlignUp(GetRequestDmaOffset(queue_size) +
+                       sizeof(RequestDma) * GetUsableSlots(queue_size),
+                   kQueueAlign);
   }
 
   /**
-   * @brief 计算单个 Virtqueue DMA 缓冲区所需的字节数（向后兼容）
+   * @brief 计算单队列 DMA 缓冲区所需的字节数
+   *
+   * 等价于 GetRequiredVqMemSize(1, queue_size).first。
    *
    * @param queue_size 队列大小（2 的幂，默认 128）
    * @return 所需的 DMA 内存字节数
    */
   [[nodiscard]] static constexpr auto CalcDmaSize(uint16_t queue_size = 128)
       -> size_t {
-    // 始终按 event_idx=true 分配，确保空间充足
-    return VirtqueueT<Traits>::CalcSize(queue_size, true);
+    return GetQueueStride(queue_size);
   }
 
   /**
@@ -91,28 +216,37 @@ class VirtioBlk {
    *
    * 内部自动完成：
    * 1. Transport 初始化和验证
-   * 2. Virtqueue 创建
-   * 3. VirtIO 设备初始化序列（重置、特性协商、队列配置、设备激活）
+   * 2. VirtIO 设备初始化序列（重置、特性协商）
+   * 3. 按协商结果创建 Virtqueue（queue_count > 1 时协商 VIRTIO_BLK_F_MQ）
+   * 4. 队列配置与设备激活
+   *
+   * 实际创建的队列数为 min(queue_count, 设备 num_queues, kMaxQueues)，
+   * 可通过 GetQueueCount() 查询。
    *
    * @param mmio_base MMIO 设备基地址
    * @param vq_dma_buf 预分配的 DMA 缓冲区虚拟地址
    *        （页对齐，已清零，大小 >= GetRequiredVqMemSize()）
-   * @param queue_count 期望的队列数量（当前仅支持 1）
+   * @param queue_count 期望的队列数量
    * @param queue_size 每个队列的描述符数量（2 的幂，默认 128）
-   * @param driver_features 额外的驱动特性位（VERSION_1 自动包含）
-   * @return 成功返回 VirtioBlk 实例，失败返回错误
+   * @param driver_features 额外的驱动特性位（VERSION_1 自动包含；
+   *        特性集确定关闭的特性位会被忽略）
+   * @return 成功返回 VirtioBlk 实例，失败返回错误；特性集确定开启的
+   *         特性未被设备接受时返回 kFeatureNegotiationFailed
    * @see virtio-v1.2#3.1.1 Driver Requirements: Device Initialization
+   * @see virtio-v1.2#5.2.5 Device Initialization
    */
   [[nodiscard]] static auto Create(uint64_t mmio_base, void* vq_dma_buf,
                                    uint16_t queue_count = 1,
                                    uint32_t queue_size = 128,
                                    uint64_t driver_features = 0)
       -> Expected<VirtioBlk> {
-    if (queue_count == 0) {
+    if (queue_count == 0 || vq_dma_buf == nullptr) {
       return std::unexpected(Error{ErrorCode::kInvalidArgument});
     }
-    if (queue_count > 1) {
-      Traits::Log("Multi-queue not yet supported, using 1 queue");
+    if (queue_count > kMaxQueues) {
+      Traits::Log("Requested %u queues, limited to %u", queue_count,
+                  kMaxQueues);
+      queue_count = kMaxQueues;
     }
 
     // 1. 创建传输层
@@ -120,55 +254,109 @@ class VirtioBlk {
     if (!transport.IsValid()) {
       return std::unexpected(Error{ErrorCode::kTransportNotInitialized});
     }
+    VirtioBlk blk(std::move(transport));
 
     // 2. 设备初始化序列
-    DeviceInitializer<Traits, TransportT<Traits>> initializer(transport);
+    DeviceInitializer<Traits, TransportT<Traits>> initializer(blk.transport_);
 
     uint64_t wanted_features =
         static_cast<uint64_t>(ReservedFeature::kVersion1) |
-        static_cast<uint64_t>(ReservedFeature::kEventIdx) | driver_features;
+        static_cast<uint64_t>(ReservedFeature::kEventIdx) |
+        static_cast<uint64_t>(ReservedFeature::kIndirectDesc) |
+        static_cast<uint64_t>(BlkFeatureBit::kFlush) |
+        static_cast<uint64_t>(BlkFeatureBit::kDiscard) |
+        static_cast<uint64_t>(BlkFeatureBit::kWriteZeroes) |
+        VirtqueueT<Traits>::kRequiredFeatures | driver_features;
+    if (queue_count > 1) {
+      wanted_features |= static_cast<uint64_t>(BlkFeatureBit::kMq);
+    }
+    if constexpr (NotificationDataTransport<TransportT<Traits>>) {
+      wanted_features |=
+          static_cast<uint64_t>(ReservedFeature::kNotificationData);
+    }
+    wanted_features = ApplyFeatureSet<Features>(wanted_features, kMandatory);
     auto negotiated_result = initializer.Init(wanted_features);
     if (!negotiated_result) {
       return std::unexpected(negotiated_result.error());
     }
     uint64_t negotiated = *negotiated_result;
+    blk.negotiated_features_ = negotiated;
 
     if ((negotiated & static_cast<uint64_t>(ReservedFeature::kVersion1)) == 0) {
       Traits::Log("Device does not support VERSION_1 (modern mode)");
       return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
     }
 
+    // Virtqueue 格式所需特性（如 VIRTIO_F_RING_PACKED）必须被设备接受
+    constexpr uint64_t kVqFeatures = VirtqueueT<Traits>::kRequiredFeatures;
+    if ((negotiated & kVqFeatures) != kVqFeatures) {
+      Traits::Log("Device does not support the requested virtqueue format");
+      return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
+    }
+
+    // 特性集确定开启的特性必须全部被设备接受
+    if ((negotiated & Features::kEnabled) != Features::kEnabled) {
+      Traits::Log("Device does not support the compile-time feature set");
+      return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
+    }
+
     // 根据协商结果决定是否启用 Event Index
-    bool event_idx =
-        (negotiated & static_cast<uint64_t>(ReservedFeature::kEventIdx)) != 0;
+    bool event_idx = blk.HasFeature<ReservedFeature::kEventIdx>();
     if (event_idx) {
       Traits::Log(
           "VIRTIO_F_EVENT_IDX negotiated, notification suppression enabled");
     }
+    // 并发提交模式下每个请求槽固定占用一个指向其间接表的描述符
+    if (kConcurrent && !blk.HasFeature<ReservedFeature::kIndirectDesc>()) {
+      Traits::Log("Concurrent submission requires VIRTIO_F_INDIRECT_DESC");
+      return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+    }
+    // 建立配置空间快照（之后仅在配置变更时重新读取）
+    blk.LoadConfig();
+
+    // 根据设备报告的 num_queues 确定实际队列数
+    uint16_t num_queues = 1;
+    if (blk.HasFeature<BlkFeatureBit::kMq>()) {
+      uint16_t device_queues = blk.config_.config.num_queues;
+      num_queues = device_queues < queue_count ? device_queues : queue_count;
+      if (num_queues == 0) {
+        num_queues = 1;
+      }
+      Traits::Log("VIRTIO_BLK_F_MQ negotiated: device=%u, using %u queues",
+                  device_queues, num_queues);
+    } else if (queue_count > 1) {
+      Traits::Log("Device does not support VIRTIO_BLK_F_MQ, using 1 queue");
+    }
 
-    // 3. 创建 Virtqueue
+    // 3. 创建并配置 Virtqueue（每个队列占用独立的 DMA 区域）
+    const size_t stride = GetQueueStride(queue_size);
+    auto* dma_base = static_cast<uint8_t*>(vq_dma_buf);
     uint64_t dma_phys = Traits::VirtToPhys(vq_dma_buf);
-    VirtqueueT<Traits> vq(vq_dma_buf, dma_phys,
-                          static_cast<uint16_t>(queue_size), event_idx);
-    if (!vq.IsValid()) {
-      return std::unexpected(Error{ErrorCode::kInvalidArgument});
-    }
+    for (uint16_t i = 0; i < num_queues; ++i) {
+      auto& queue = blk.queues_[i];
+      if (!blk.InitQueue(i, dma_base + i * stride, dma_phys + i * stride,
+                         queue_size, event_idx)) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
 
-    // 4. 配置队列
-    const uint32_t queue_idx = 0;
-    auto setup_result = initializer.SetupQueue(
-        queue_idx, vq.DescPhys(), vq.AvailPhys(), vq.UsedPhys(), vq.Size());
-    if (!setup_result) {
-      return std::unexpected(setup_result.error());
+      auto setup_result =
+          initializer.SetupQueue(i, queue.vq->DescPhys(), queue.vq->AvailPhys(),
+                                 queue.vq->UsedPhys(), queue.vq->Size());
+      if (!setup_result) {
+        return std::unexpected(setup_result.error());
+      }
     }
+    blk.queue_count_ = num_queues;
+    // 非一致性 DMA 平台：逐队列区域（stride 字节）的初始化须在激活前写回
+    DmaSyncForDevice<Traits>(vq_dma_buf, stride * num_queues);
 
-    // 5. 激活设备
+    // 4. 激活设备
     auto activate_result = initializer.Activate();
     if (!activate_result) {
       return std::unexpected(activate_result.error());
     }
 
-    return VirtioBlk(std::move(transport), std::move(vq), negotiated);
+    return blk;
   }
 
   // ======== 异步 IO 接口 (Enqueue/Kick/HandleInterrupt) ========
@@ -179,17 +367,19 @@ class VirtioBlk {
    * 构建 virtio-blk 请求描述符链（header + data buffers + status），
    * 提交到 Available Ring，但不通知设备。调用者需随后调用 Kick() 通知。
    *
-   * @param queue_index 队列索引（当前仅支持 0）
+   * @param queue_index 队列索引（< GetQueueCount()）
    * @param sector 起始扇区号（以 512 字节为单位）
    * @param buffers 数据缓冲区 IoVec 数组（物理地址 + 长度）
    * @param buffer_count buffers 数组中的元素数量
+   *        （buffer_count + 2 <= GetMaxSgElements()）
    * @param token 用户自定义上下文指针，在 HandleInterrupt 回调时原样传回
-   * @return 成功或失败
+   * @return 成功返回请求句柄，失败返回错误
    * @see virtio-v1.2#5.2.6 Device Operation
    */
   [[nodiscard]] auto EnqueueRead(uint16_t queue_index, uint64_t sector,
                                  const IoVec* buffers, size_t buffer_count,
-                                 UserData token = nullptr) -> Expected<void> {
+                                 UserData token = nullptr)
+      -> Expected<RequestHandle> {
     return DoEnqueue(ReqType::kIn, queue_index, sector, buffers, buffer_count,
                      token);
   }
@@ -203,61 +393,247 @@ class VirtioBlk {
    * 针对 Write 操作，数据缓冲区的描述符 flag 为设备只读（无
    * VRING_DESC_F_WRITE）。
    *
-   * @param queue_index 队列索引（当前仅支持 0）
+   * @param queue_index 队列索引（< GetQueueCount()）
    * @param sector 起始扇区号（以 512 字节为单位）
    * @param buffers 数据缓冲区 IoVec 数组（物理地址 + 长度）
    * @param buffer_count buffers 数组中的元素数量
+   *        （buffer_count + 2 <= GetMaxSgElements()）
    * @param token 用户自定义上下文指针，在 HandleInterrupt 回调时原样传回
-   * @return 成功或失败
+   * @return 成功返回请求句柄，失败返回错误
    * @see virtio-v1.2#5.2.6 Device Operation
    */
   [[nodiscard]] auto EnqueueWrite(uint16_t queue_index, uint64_t sector,
                                   const IoVec* buffers, size_t buffer_count,
-                                  UserData token = nullptr) -> Expected<void> {
+                                  UserData token = nullptr)
+      -> Expected<RequestHandle> {
     return DoEnqueue(ReqType::kOut, queue_index, sector, buffers, buffer_count,
                      token);
   }
 
+  /**
+   * @brief 异步提交 Flush 请求（仅入队描述符，不触发硬件通知）
+   *
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @param token 用户自定义上下文指针，在 HandleInterrupt 回调时原样传回
+   * @return 成功返回请求句柄；未协商 VIRTIO_BLK_F_FLUSH 时返回 kDeviceNotSupported
+   * @see virtio-v1.2#5.2.6 Device Operation
+   */
+  [[nodiscard]] auto EnqueueFlush(uint16_t queue_index,
+                                  UserData token = nullptr)
+      -> Expected<RequestHandle> {
+    return DoEnqueue(ReqType::kFlush, queue_index, 0, nullptr, 0, token);
+  }
+
+  /**
+   * @brief 异步提交 GET_ID 请求（仅入队描述符，不触发硬件通知）
+   *
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @param id 设备 ID 输出缓冲区（kDeviceIdMaxLen 字节，完成前保持有效）
+   * @param token 用户自定义上下文指针，在 HandleInterrupt 回调时原样传回
+   * @return 成功返回请求句柄，失败返回错误
+   * @see virtio-v1.2#5.2.6 Device Operation
+   */
+  [[nodiscard]] auto EnqueueGetId(uint16_t queue_index, uint8_t* id,
+                                  UserData token = nullptr)
+      -> Expected<RequestHandle> {
+    if (id == nullptr) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    IoVec iov{Traits::VirtToPhys(id), kDeviceIdMaxLen};
+    return DoEnqueue(ReqType::kGetId, queue_index, 0, &iov, 1, token);
+  }
+
+  /**
+   * @brief 异步提交多段 DISCARD 请求（仅入队描述符，不触发硬件通知）
+   *
+   * 一个请求携带 range_count 个扇区范围，设备一次完成全部范围。
+   *
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @param ranges 扇区范围数组（DMA 可访问，完成前保持有效）
+   * @param range_count 范围数量（1..GetDiscardLimits().max_segments），
+   *        每个范围不超过 max_sectors 个扇区
+   * @param token 用户自定义上下文指针，在 HandleInterrupt 回调时原样传回
+   * @return 成功返回请求句柄；未协商 VIRTIO_BLK_F_DISCARD 时返回 kDeviceNotSupported
+   * @see virtio-v1.2#5.2.6 Device Operation
+   */
+  [[nodiscard]] auto EnqueueDiscard(uint16_t queue_index,
+                                    const BlkDiscardWriteZeroes* ranges,
+                                    size_t range_count,
+                                    UserData token = nullptr)
+      -> Expected<RequestHandle> {
+    return EnqueueRanges(ReqType::kDiscard, queue_index, ranges, range_count,
+                         token);
+  }
+
+  /**
+   * @brief 异步提交多段 WRITE_ZEROES 请求（仅入队描述符，不触发硬件通知）
+   *
+   * 范围的 flags.unmap 置位时允许设备以 unmap 方式实现清零
+   * （仅在配置空间 write_zeroes_may_unmap 非 0 时生效）。
+   *
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @param ranges 扇区范围数组（DMA 可访问，完成前保持有效）
+   * @param range_count 范围数量（1..GetWriteZeroesLimits().max_segments），
+   *        每个范围不超过 max_sectors 个扇区
+   * @param token 用户自定义上下文指针，在 HandleInterrupt 回调时原样传回
+   * @return 成功返回请求句柄；未协商 VIRTIO_BLK_F_WRITE_ZEROES 时返回
+   *         kDeviceNotSupported
+   * @see virtio-v1.2#5.2.6 Device Operation
+   */
+  [[nodiscard]] auto EnqueueWriteZeroes(uint16_t queue_index,
+                                        const BlkDiscardWriteZeroes* ranges,
+                                        size_t range_count,
+                                        UserData token = nullptr)
+      -> Expected<RequestHandle> {
+    return EnqueueRanges(ReqType::kWriteZeroes, queue_index, ranges,
+                         range_count, token);
+  }
+
+  /**
+   * @brief 批量提交请求并通知设备
+   *
+   * 依次构建每个请求的描述符链和 Available Ring 条目，整批只执行一次
+   * 写屏障、发布一次 avail idx，随后调用 Kick()。
+   * 遇到第一个入队失败的请求即停止，已入队的请求照常提交。
+   *
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @param requests 请求数组（type 仅支持 kIn/kOut）
+   * @return 成功入队的请求数；第一个请求即失败时返回错误
+   * @see virtio-v1.2#2.7.13 Supplying Buffers to The Device
+   */
+  [[nodiscard]] auto EnqueueBatch(uint16_t queue_index,
+                                  std::span<const BlkRequest> requests)
+      -> Expected<size_t> {
+    if (queue_index >= queue_count_) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    auto& vq = *queues_[queue_index].vq;
+
+    size_t enqueued = 0;
+    Error error{ErrorCode::kSuccess};
+    // 并发提交模式下每个请求各自按序发布，不使用共享的批量状态
+    if constexpr (!kConcurrent) {
+      vq.BeginBatch();
+    }
+    for (const auto& req : requests) {
+      if (req.type != ReqType::kIn && req.type != ReqType::kOut) {
+        error = Error{ErrorCode::kInvalidArgument};
+        break;
+      }
+      auto result = DoEnqueue(req.type, queue_index, req.sector, req.buffers,
+                              req.buffer_count, req.token);
+      if (!result) {
+        error = result.error();
+        break;
+      }
+      ++enqueued;
+    }
+    if constexpr (!kConcurrent) {
+      vq.EndBatch();
+    }
+
+    if (enqueued > 0) {
+      Kick(queue_index);
+    } else if (!requests.empty()) {
+      return std::unexpected(error);
+    }
+    return enqueued;
+  }
+
+  /**
+   * @brief 检查队列当前能否再容纳一组读写请求
+   *
+   * 按空闲的请求槽与环上描述符判断：协商 VIRTIO_F_INDIRECT_DESC 时每个
+   * 请求占用一个描述符，否则占用数据段数 + 2（请求头与状态字节）个。
+   * 供需要把一次传输拆分为多个请求、且要求全部入队或全部不入队的调用者
+   * 在提交前检查。并发提交模式下结果只是快照。
+   *
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @param requests 请求数
+   * @param data_segments 全部请求的数据段总数
+   * @return 全部请求均可入队时返回 true
+   */
+  [[nodiscard]] auto CanEnqueue(uint16_t queue_index, size_t requests,
+                                size_t data_segments) const -> bool {
+    if (queue_index >= queue_count_) {
+      return false;
+    }
+    const auto& queue = queues_[queue_index];
+    size_t usable = GetUsableSlots(queue.vq->Size());
+    if (requests > usable - CountInflight(queue)) {
+      return false;
+    }
+    // 并发提交模式下槽 i 固定使用描述符 i，有空闲槽即有描述符
+    if constexpr (kConcurrent) {
+      return true;
+    }
+    size_t descriptors = HasFeature<ReservedFeature::kIndirectDesc>()
+                             ? requests
+                             : data_segments + 2 * requests;
+    return descriptors <= queue.vq->NumFree();
+  }
+
   /**
    * @brief 批量触发硬件通知
    *
    * 通知设备 Available Ring 中有新的待处理请求。
    * 调用者应在 EnqueueRead/EnqueueWrite 后调用此方法。
    *
-   * @param queue_index 队列索引（当前仅支持 0）
+   * @param queue_index 队列索引（< GetQueueCount()）
    * @see virtio-v1.2#2.7.13 Supplying Buffers to The Device
    */
   auto Kick(uint16_t queue_index) -> void {
-    if (queue_index != 0) {
+    if (queue_index >= queue_count_) {
       return;
     }
+    auto& queue = queues_[queue_index];
+    auto& vq = *queue.vq;
+
     // 写屏障：确保 Available Ring 更新对设备可见
     Traits::Wmb();
 
-    if (vq_.EventIdxEnabled()) {
-      auto* avail_event_ptr = vq_.UsedAvailEvent();
+    // 特性集关闭 EVENT_IDX 时整段抑制逻辑在编译期消除，总是通知
+    if constexpr (kEventIdxMode != FeatureMode::kNever) {
+      auto* avail_event_ptr = EventIdxActive(vq) ? vq.UsedAvailEvent()
+                                                 : nullptr;
       if (avail_event_ptr != nullptr) {
+        DmaSyncForCpu<Traits>(avail_event_ptr, sizeof(uint16_t));
         uint16_t avail_event = *avail_event_ptr;
-        uint16_t new_idx = vq_.AvailIdx();
-        if (VringNeedEvent(avail_event, new_idx, old_avail_idx_)) {
-          transport_.NotifyQueue(queue_index);
+        uint16_t new_idx = vq.AvailIdx();
+        // 并发 Kick 交换得到的区间首尾相接（乱序时只会多发通知）
+        uint16_t old_idx = queue.old_avail_idx;
+        if constexpr (kConcurrent) {
+          old_idx = std::atomic_ref<uint16_t>(queue.old_avail_idx)
+                        .exchange(new_idx, std::memory_order_relaxed);
         } else {
-          stats_.kicks_elided++;
+          queue.old_avail_idx = new_idx;
         }
-        old_avail_idx_ = new_idx;
-      } else {
-        transport_.NotifyQueue(queue_index);
+        auto batch = static_cast<uint16_t>(new_idx - old_idx);
+        if (VringNeedEvent(avail_event, new_idx, old_idx)) {
+          TracePoint<Traits>(TraceEvent::kKickNotify, queue_index, new_idx,
+                             batch);
+          NotifyDevice(queue_index);
+        } else {
+          TracePoint<Traits>(TraceEvent::kKickElided, queue_index, new_idx,
+                             batch);
+          CountSubmitEvent(queue.stats.kicks_elided);
+        }
+        return;
       }
-    } else {
-      transport_.NotifyQueue(queue_index);
     }
+    if constexpr (kTrace) {
+      TracePoint<Traits>(TraceEvent::kKickNotify, queue_index, vq.AvailIdx(),
+                         0);
+    }
+    NotifyDevice(queue_index);
   }
 
   /**
    * @brief 中断处理（带完成回调）
    *
-   * 在 ISR 或轮询循环中调用。确认设备中断，遍历 Used Ring 中已完成的请求，
-   * 对每个请求调用 on_complete 回调，释放描述符链和请求槽。
+   * 在 ISR 或轮询循环中调用。确认一次设备中断，遍历所有队列 Used Ring
+   * 中已完成的请求，对每个请求调用 on_complete 回调，释放描述符链和请求槽。
+   * 只有 Used Ring 确有新完成的队列才计入该队列的 interrupts_handled。
    *
    * @tparam CompletionCallback 签名要求：void(UserData token, ErrorCode status)
    *         - token: 提交时传入的用户上下文指针
@@ -267,15 +643,115 @@ class VirtioBlk {
    */
   template <typename CompletionCallback>
   auto HandleInterrupt(CompletionCallback&& on_complete) -> void {
-    // 确认中断
-    uint32_t isr_status = transport_.GetInterruptStatus();
-    if (isr_status != 0) {
-      transport_.AckInterrupt(isr_status);
+    TracePoint<Traits>(TraceEvent::kInterrupt, kTraceAllQueues, 0, 0);
+    AckDeviceInterrupt();
+
+    for (uint16_t i = 0; i < queue_count_; ++i) {
+      if (queues_[i].vq->HasUsed()) {
+        queues_[i].stats.interrupts_handled++;
+      }
+      size_t completed = ProcessCompletions(i, on_complete);
+      UpdateNotifyMode(i, completed);
+    }
+  }
+
+  /**
+   * @brief 单队列中断处理（带完成回调）
+   *
+   * 仅处理 queue_index 对应队列的 Used Ring。多队列场景下每个核
+   * 只提交和回收自己的队列，各队列的描述符、请求槽互不共享，无需加锁。
+   *
+   * 不读取也不确认共享的中断状态寄存器：共享中断线时，一个核确认后
+   * 其余核将读到 0 而漏掉自己队列的完成。此时以本队列 Used Ring 是否
+   * 前进来判断中断是否属于本队列（未前进时直接返回，不计数），中断线
+   * 的处理函数须先调用一次 AcknowledgeInterrupt() 再分发到各队列。
+   *
+   * @tparam CompletionCallback 签名要求：void(UserData token, ErrorCode status)
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @param on_complete 完成回调函数
+   * @warning 同一队列的提交与回收必须在同一执行上下文中串行进行
+   *          （并发提交模式下提交可与回收并发，回收仍须串行）
+   * @see virtio-v1.2#2.7.14 Receiving Used Buffers From The Device
+   */
+  template <typename CompletionCallback>
+  auto HandleInterrupt(uint16_t queue_index, CompletionCallback&& on_complete)
+      -> void {
+    if (queue_index >= queue_count_) {
+      return;
+    }
+    // 逐队列向量（如 MSI-X）下中断必属于本队列；共享中断线时由本队列
+    // 自己的 used 索引判断，中断状态寄存器由中断线处理函数统一确认
+    if (!UsesQueueVectors() && !queues_[queue_index].vq->HasUsed()) {
+      return;
+    }
+    TracePoint<Traits>(TraceEvent::kInterrupt, queue_index, 0, 0);
+    queues_[queue_index].stats.interrupts_handled++;
+
+    size_t completed = ProcessCompletions(
+        queue_index, static_cast<CompletionCallback&&>(on_complete));
+    UpdateNotifyMode(queue_index, completed);
+  }
+
+  /**
+   * @brief 启用/禁用自适应轮询（类似 NAPI）
+   *
+   * 启用后，若一次带回调的 HandleInterrupt 在某个队列上回收的完成数
+   * >= threshold，该队列暂停 Used Buffer 通知并进入轮询模式；调用者应
+   * 在 IsPolling() 为 true 时周期性调用 PollCompletions()，队列空闲
+   * （一次轮询未回收到任何完成）后自动恢复中断模式。
+   *
+   * @param threshold 进入轮询模式的单次中断完成数阈值，0 表示禁用（默认）
+   */
+  auto SetAdaptivePolling(uint32_t threshold) -> void {
+    poll_threshold_ = threshold;
+  }
+
+  /**
+   * @brief 检查队列是否处于轮询模式（Used Buffer 通知已暂停）
+   *
+   * @param queue_index 队列索引（< GetQueueCount()）
+   */
+  [[nodiscard]] auto IsPolling(uint16_t queue_index) const -> bool {
+    return queue_index < queue_count_ && queues_[queue_index].polling;
+  }
+
+  /**
+   * @brief 有预算的完成轮询
+   *
+   * 不读取/确认中断状态，最多回收 budget 个已完成的请求。
+   * 轮询模式下，若本次未回收到任何完成则恢复 Used Buffer 通知并退出
+   * 轮询模式（恢复时发现新完成则继续保持轮询模式）。
+   *
+   * @tparam CompletionCallback 签名要求：void(UserData token, ErrorCode status)
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @param budget 本次最多回收的完成数
+   * @param on_complete 完成回调函数
+   * @return 实际回收的完成数
+   * @see virtio-v1.2#2.7.7 Used Buffer Notification Suppression
+   */
+  template <typename CompletionCallback>
+  auto PollCompletions(uint16_t queue_index, size_t budget,
+                       CompletionCallback&& on_complete) -> size_t {
+    if (queue_index >= queue_count_) {
+      return 0;
+    }
+    auto& queue = queues_[queue_index];
+    size_t completed = ProcessCompletions(
+        queue_index, static_cast<CompletionCallback&&>(on_complete), budget);
+
+    if (!queue.polling) {
+      UpdateUsedEvent(queue_index);
+      return completed;
     }
-    stats_.interrupts_handled++;
 
-    ProcessCompletions(static_cast<CompletionCallback&&>(on_complete));
-    UpdateUsedEvent();
+    queue.stats.polled_completions += completed;
+    if (completed == 0 && queue.vq->EnableUsedNotify()) {
+      queue.polling = false;
+    } else {
+      // 保持通知关闭（EVENT_IDX 下随 last_used 推进 used_event）
+      queue.vq->DisableUsedNotify();
+    }
+    return completed;
   }
 
   /**
@@ -288,68 +764,1654 @@ class VirtioBlk {
    * @see virtio-v1.2#2.3 Notifications
    */
   auto HandleInterrupt() -> void {
-    uint32_t status = transport_.GetInterruptStatus();
-    if (status != 0) {
-      transport_.AckInterrupt(status);
+    AckDeviceInterrupt();
+    queues_[0].stats.interrupts_handled++;
+    request_completed_ = true;
+    Traits::Wmb();
+  }
+
+  /**
+   * @brief 检查设备是否有中断挂起（只读取 InterruptStatus，不确认）
+   *
+   * 供多个设备共享中断线时在完整处理前快速筛选。
+   */
+  [[nodiscard]] auto IsInterruptPending() const -> bool {
+    return transport_.GetInterruptStatus() != 0;
+  }
+
+  /**
+   * @brief 只确认设备中断，不处理 Used Ring
+   *
+   * 用于中断合并：已完成的请求留在 Used Ring 中，由之后带回调的
+   * HandleInterrupt 或 PollCompletions 统一回收。也是多队列共享中断线
+   * 时中断线处理函数的入口：每次中断确认一次，再分发到逐队列的
+   * HandleInterrupt(queue_index, ...)。
+   *
+   * @warning 协商了 EVENT_IDX 时，used_event 在回收前不再前进，设备可能
+   *          不再发出中断，调用者须保证推迟的回收最终会执行
+   */
+  auto AcknowledgeInterrupt() -> void { AckDeviceInterrupt(); }
+
+  // ======== 静默与快速恢复 (Quiesce/Resume/Restore) ========
+
+  /**
+   * @brief 静默设备：回收或取消全部在途请求并复位设备
+   *
+   * 依次执行：
+   * 1. 拒绝新的提交（之后 Enqueue*() 返回 kDeviceBusy，直到 Resume()）
+   * 2. drain 为 true 且设备未报告 DEVICE_NEEDS_RESET 时，Kick 全部
+   *    队列并轮询回收完成（上限同同步接口的自旋次数）
+   * 3. 复位设备，此后设备不再访问环与数据缓冲区
+   * 4. 回收复位前已写入 Used Ring 的完成，其余在途请求以 kCanceled
+   *    完成（协程等待者同样被恢复）
+   *
+   * 队列 DMA 区域、配置快照、统计与遥测全部保留，之后可由 Resume()
+   * 在同一块内存上快速恢复，或经 GetResumeState() 交接给 Restore()。
+   *
+   * @tparam CompletionCallback void(UserData token, ErrorCode status)
+   * @param on_complete 完成回调（回收与取消的请求都经由它通知）
+   * @param drain 是否先等待在途请求完成；为 false 时立即复位并取消
+   * @return 以 kCanceled 完成的请求数
+   * @warning 须由回收完成的上下文调用，且不得与提交并发执行；回调中
+   *          重新提交的请求会失败，应在 Resume() 之后重新提交
+   * @see virtio-v1.2#2.1 Device Status Field
+   */
+  template <typename CompletionCallback>
+  auto Quiesce(CompletionCallback&& on_complete, bool drain = true)
+      -> size_t {
+    quiesced_ = true;
+
+    if (drain && !transport_.NeedsReset()) {
+      constexpr uint32_t spin_limit = [] {
+        if constexpr (SpinWaitTraits<Traits>) {
+          return static_cast<uint32_t>(Traits::kMaxSpinIterations);
+        } else {
+          return uint32_t{100000000};
+        }
+      }();
+
+      size_t pending = 0;
+      for (uint16_t i = 0; i < queue_count_; ++i) {
+        pending += CountInflight(queues_[i]);
+        Kick(i);
+      }
+      for (uint32_t spin = 0; spin < spin_limit && pending > 0; ++spin) {
+        size_t reaped = 0;
+        for (uint16_t i = 0; i < queue_count_; ++i) {
+          reaped += ProcessCompletions(i, on_complete);
+        }
+        pending = reaped < pending ? pending - reaped : 0;
+      }
+    }
+
+    transport_.Reset();
+
+    size_t canceled = 0;
+    for (uint16_t i = 0; i < queue_count_; ++i) {
+      (void)ProcessCompletions(i, on_complete);
+      canceled += CancelInflight(i, on_complete);
+    }
+    if (canceled > 0) {
+      Traits::Log("Quiesce canceled %u in-flight requests",
+                  static_cast<unsigned>(canceled));
+    }
+    return canceled;
+  }
+
+  /**
+   * @brief 快速恢复：在原有队列内存上重新激活设备
+   *
+   * 用于 Quiesce() 之后，或 Transport::NeedsReset() 报告设备需要复位时
+   * （先以 drain = false 调用 Quiesce()）。与 Create() 相比：
+   * - 不读取设备特性，直接写回此前协商的特性位
+   * - 不重新读取配置空间（快照标记为失效，下次访问时按需读取）
+   * - 不重新计算队列布局，环与请求槽沿用原有 DMA 内存，只清零环并
+   *   写入队列地址寄存器
+   * - 成功路径上不输出日志
+   *
+   * 统计、遥测、自适应轮询阈值与各队列的轮询模式保持不变。
+   *
+   * @return 成功或失败；仍有在途请求时返回 kDeviceBusy，设备不再接受
+   *         原特性位时返回 kFeatureNegotiationFailed
+   * @warning 不得与提交或回收并发执行
+   * @see virtio-v1.2#3.1.1 Driver Requirements: Device Initialization
+   */
+  [[nodiscard]] auto Resume() -> Expected<void> {
+    for (uint16_t i = 0; i < queue_count_; ++i) {
+      if (CountInflight(queues_[i]) != 0) {
+        return std::unexpected(Error{ErrorCode::kDeviceBusy});
+      }
+    }
+
+    bool event_idx = HasFeature<ReservedFeature::kEventIdx>();
+    for (uint16_t i = 0; i < queue_count_; ++i) {
+      auto& queue = queues_[i];
+      // 队列区域起始即 Virtqueue 起始，间接描述符表紧随其后
+      uint32_t queue_size = queue.vq->Size();
+      size_t table_offset = GetIndirectTableOffset(queue_size);
+      auto* region = reinterpret_cast<uint8_t*>(
+                         const_cast<IndirectDesc*>(queue.indirect_tables)) -
+                     table_offset;
+      (void)InitQueue(i, region, queue.indirect_phys - table_offset,
+                      queue_size, event_idx);
+    }
+
+    auto result = Rearm();
+    if (!result) {
+      return result;
+    }
+    queues_[0].stats.resumes++;
+    return {};
+  }
+
+  /**
+   * @brief 获取交接给 Restore() 所需的设备状态
+   */
+  [[nodiscard]] auto GetResumeState() const -> ResumeState {
+    ResumeState state;
+    state.features = negotiated_features_;
+    state.queue_size = queue_count_ > 0 ? queues_[0].vq->Size() : 0;
+    state.queue_count = queue_count_;
+    state.poll_threshold = poll_threshold_;
+    return state;
+  }
+
+  /**
+   * @brief 以交接的设备状态在原有队列内存上重建驱动（热重启 / kexec）
+   *
+   * 与 Resume() 相同的快速路径，但从新的驱动对象开始：前一个实例
+   * （可能属于上一个内核）须已调用 Quiesce()，并通过 GetResumeState()
+   * 交出状态；vq_dma_buf 须为同一块队列 DMA 内存（内容无需清零），
+   * 模板参数须与前一个实例一致。在途请求、统计与遥测不会跨越交接。
+   *
+   * @param mmio_base MMIO 设备基地址
+   * @param vq_dma_buf 前一个实例使用的队列 DMA 缓冲区虚拟地址
+   * @param state 前一个实例的 GetResumeState() 结果
+   * @return 成功返回 VirtioBlk 实例，失败返回错误
+   * @see virtio-v1.2#3.1.1 Driver Requirements: Device Initialization
+   */
+  [[nodiscard]] static auto Restore(uint64_t mmio_base, void* vq_dma_buf,
+                                    const ResumeState& state)
+      -> Expected<VirtioBlk> {
+    if (vq_dma_buf == nullptr || state.queue_count == 0 ||
+        state.queue_count > kMaxQueues || state.queue_size == 0 ||
+        state.queue_size > 32768 ||
+        (state.features & kMandatory) != kMandatory ||
+        (state.features & Features::kEnabled) != Features::kEnabled) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+
+    TransportT<Traits> transport(mmio_base);
+    if (!transport.IsValid()) {
+      return std::unexpected(Error{ErrorCode::kTransportNotInitialized});
+    }
+    VirtioBlk blk(std::move(transport));
+    blk.negotiated_features_ = state.features;
+    blk.poll_threshold_ = state.poll_threshold;
+    if (kConcurrent && !blk.HasFeature<ReservedFeature::kIndirectDesc>()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+    }
+
+    bool event_idx = blk.HasFeature<ReservedFeature::kEventIdx>();
+    const size_t stride = GetQueueStride(state.queue_size);
+    auto* dma_base = static_cast<uint8_t*>(vq_dma_buf);
+    uint64_t dma_phys = Traits::VirtToPhys(vq_dma_buf);
+    for (uint16_t i = 0; i < state.queue_count; ++i) {
+      if (!blk.InitQueue(i, dma_base + i * stride, dma_phys + i * stride,
+                         state.queue_size, event_idx)) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
+    }
+    blk.queue_count_ = state.queue_count;
+    DmaSyncForDevice<Traits>(vq_dma_buf, stride * state.queue_count);
+
+    auto result = blk.Rearm();
+    if (!result) {
+      return std::unexpected(result.error());
+    }
+    return blk;
+  }
+
+  /**
+   * @brief 设备是否处于静默状态（Quiesce() 之后、Resume() 成功之前）
+   */
+  [[nodiscard]] auto IsQuiesced() const -> bool { return quiesced_; }
+
+  // ======== 取消与超时 (Cancel/ExpireRequests/WaitFor) ========
+
+  /**
+   * @brief 设置此后提交的请求的超时时长
+   *
+   * 设置后每个入队的请求记录截止时间 Now() + ticks，由 ExpireRequests()
+   * 定期检查。已在途的请求保持原有截止时间。
+   *
+   * @param ticks 超时时长（Traits::Now() 时基），0 表示不设截止时间
+   */
+  auto SetRequestTimeout(uint64_t ticks) -> void
+    requires kDeadlines
+  {
+    request_timeout_ = ticks;
+  }
+
+  /**
+   * @brief 获取当前的请求超时时长（0 表示未设置）
+   */
+  [[nodiscard]] auto GetRequestTimeout() const -> uint64_t
+    requires kDeadlines
+  {
+    return request_timeout_;
+  }
+
+  /**
+   * @brief 取消一个在途请求
+   *
+   * 立即以 kCanceled 通知调用者（回调方式的请求经由 on_complete，协程
+   * 等待者被恢复，WaitFor() 中的请求令其立即返回），但请求槽与描述符
+   * 保持占用，直到设备在 Used Ring 中归还该请求后才静默释放：设备可能
+   * 正在访问数据缓冲区，过早复用描述符会让设备读写新请求的内存。
+   *
+   * @tparam CompletionCallback void(UserData token, ErrorCode status)
+   * @param handle 请求入队时返回的句柄
+   * @param on_complete 取消通知回调
+   * @return 取消了请求返回 true；请求已完成、已取消或句柄无效返回 false
+   * @warning 须与提交、回收在同一上下文中串行执行。数据缓冲区须保持
+   *          有效，直到设备归还该请求（或 Quiesce() 之后）
+   */
+  template <typename CompletionCallback>
+  auto Cancel(RequestHandle handle, CompletionCallback&& on_complete) -> bool
+    requires(!ConcurrentSubmitTraits<Traits>)
+  {
+    RequestSlot* slot = ResolveHandle(handle);
+    if (slot == nullptr) {
+      return false;
+    }
+    slot->canceled = true;
+    ++queues_[handle.queue_index].stats.requests_canceled;
+    TracePoint<Traits>(TraceEvent::kComplete, handle.queue_index,
+                       slot->desc_head,
+                       static_cast<uint32_t>(ErrorCode::kCanceled));
+    NotifyRequest(slot->token, slot->notify, ErrorCode::kCanceled,
+                  on_complete);
+    return true;
+  }
+
+  /**
+   * @brief 放弃超过截止时间的在途请求（由定时器周期性调用）
+   *
+   * 队列记录了在途请求中最早的截止时间，未到期时只需一次 Now() 与
+   * 比较即返回。到期的请求以 kTimeout 通知调用者（回调方式的请求经由
+   * on_timeout，协程等待者被恢复，WaitFor() 中的请求令其立即返回），
+   * 与 Cancel() 相同，请求槽与描述符在设备归还后才释放。
+   *
+   * @tparam CompletionCallback void(UserData token, ErrorCode status)
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @param on_timeout 超时回调
+   * @return 本次超时的请求数
+   * @warning 须与提交、回收在同一上下文中串行执行
+   */
+  template <typename CompletionCallback>
+  auto ExpireRequests(uint16_t queue_index, CompletionCallback&& on_timeout)
+      -> size_t
+    requires kDeadlines
+  {
+    if (queue_index >= queue_count_) {
+      return 0;
+    }
+    auto& queue = queues_[queue_index];
+    auto now = static_cast<uint64_t>(Traits::Now());
+    if (now < queue.next_deadline) {
+      return 0;
+    }
+
+    size_t expired = 0;
+    uint64_t next_deadline = kNoDeadline;
+    size_t usable = GetUsableSlots(queue.vq->Size());
+    for (size_t idx = 0; idx < usable; ++idx) {
+      if (!queue.slot_bitmap.Test(idx)) {
+        continue;
+      }
+      auto& slot = queue.slots[idx];
+      if (slot.canceled || slot.deadline == 0) {
+        continue;
+      }
+      if (slot.deadline > now) {
+        if (slot.deadline < next_deadline) {
+          next_deadline = slot.deadline;
+        }
+        continue;
+      }
+      slot.canceled = true;
+      ++expired;
+      TracePoint<Traits>(TraceEvent::kComplete, queue_index, slot.desc_head,
+                         static_cast<uint32_t>(ErrorCode::kTimeout));
+      NotifyRequest(slot.token, slot.notify, ErrorCode::kTimeout, on_timeout);
+    }
+    queue.next_deadline = next_deadline;
+    queue.stats.requests_timed_out += expired;
+    if (expired > 0) {
+      Traits::Log("Queue %u: %u requests timed out",
+                  static_cast<unsigned>(queue_index),
+                  static_cast<unsigned>(expired));
+    }
+    return expired;
+  }
+
+  /**
+   * @brief 对全部队列执行 ExpireRequests()
+   *
+   * @tparam CompletionCallback void(UserData token, ErrorCode status)
+   * @param on_timeout 超时回调
+   * @return 本次超时的请求总数
+   */
+  template <typename CompletionCallback>
+  auto ExpireRequests(CompletionCallback&& on_timeout) -> size_t
+    requires kDeadlines
+  {
+    size_t expired = 0;
+    for (uint16_t i = 0; i < queue_count_; ++i) {
+      expired += ExpireRequests(i, on_timeout);
+    }
+    return expired;
+  }
+
+  /**
+   * @brief 等待指定请求完成，直到截止时间
+   *
+   * 轮询回收该请求所在队列的完成，两次轮询之间调用 Traits::Yield()
+   * （若提供）让出 CPU。期间完成的其他请求照常经由 on_complete 通知；
+   * 被等待的请求不再调用回调，其结果由返回值给出。等待期间回调中的
+   * Cancel() 或 ExpireRequests() 取消了该请求时立即返回对应状态。
+   * 截止时间到达仍未完成时取消该请求（见 Cancel()）并返回 kTimeout。
+   *
+   * @tparam CompletionCallback void(UserData token, ErrorCode status)
+   * @param handle 请求入队时返回的句柄（须为回调方式提交的请求）
+   * @param deadline 截止时间（Traits::Now() 时基的绝对时间）
+   * @param on_complete 其他请求的完成回调
+   * @return 请求的完成状态；句柄无效或请求已完成时返回
+   *         kInvalidArgument，超时返回 kTimeout，被取消返回 kCanceled
+   * @warning 须在回收完成的上下文中调用，且不得与该队列的中断处理并发
+   */
+  template <typename CompletionCallback>
+  [[nodiscard]] auto WaitFor(RequestHandle handle, uint64_t deadline,
+                             CompletionCallback&& on_complete)
+      -> Expected<void>
+    requires kDeadlines
+  {
+    RequestSlot* slot = ResolveHandle(handle);
+    if (slot == nullptr || slot->notify != NotifyKind::kCallback) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    // 结果改为记录到栈上的等待者；在得到结果之前请求槽保持为本请求占用
+    SyncWaiter waiter;
+    slot->token = &waiter;
+    slot->notify = NotifyKind::kWaiter;
+
+    while (true) {
+      (void)ProcessCompletions(handle.queue_index, on_complete);
+      UpdateUsedEvent(handle.queue_index);
+      if (waiter.done) {
+        break;
+      }
+      if (static_cast<uint64_t>(Traits::Now()) >= deadline) {
+        slot->canceled = true;
+        ++queues_[handle.queue_index].stats.requests_timed_out;
+        return std::unexpected(Error{ErrorCode::kTimeout});
+      }
+      YieldCpu<Traits>();
+    }
+
+    if (waiter.status != ErrorCode::kSuccess) {
+      return std::unexpected(Error{waiter.status});
+    }
+    return {};
+  }
+
+  // ======== 协程接口 (co_await AsyncRead/AsyncWrite) ========
+
+  /**
+   * @brief 块请求的协程等待者
+   *
+   * 挂起时将请求入队并 Kick，自身地址作为请求槽的 token；
+   * 请求完成后由 ProcessCompletions（即任意带回调的 HandleInterrupt）
+   * 恢复协程，不经过用户回调，也不需要任何堆分配。
+   *
+   * 使用示例：
+   * @code
+   * auto result = co_await blk.AsyncRead(0, sector, iovs, iov_count);
+   * @endcode
+   *
+   * @note 等待者位于协程帧中，请求完成前协程帧不得销毁
+   */
+  class IoAwaiter {
+   public:
+    /// 入队总是需要挂起
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+    /**
+     * @brief 入队请求并挂起协程
+     *
+     * @param handle 当前协程句柄
+     * @return 入队成功返回 true（挂起）；失败返回 false（立即恢复，
+     *         await_resume 返回入队错误）
+     */
+    auto await_suspend(std::coroutine_handle<> handle) -> bool {
+      handle_ = handle;
+      // 请求可能在 Kick 返回前完成并恢复协程（如在中断中），
+      // 入队后不再访问本对象
+      VirtioBlk& blk = blk_;
+      uint16_t queue_index = queue_index_;
+      auto result = blk.DoEnqueue(type_, queue_index, sector_, buffers_,
+                                  buffer_count_, this, NotifyKind::kAwaiter);
+      if (!result) {
+        status_ = result.error().code;
+        return false;
+      }
+      blk.Kick(queue_index);
+      return true;
+    }
+
+    /**
+     * @brief 获取请求结果
+     * @return 成功返回 void，失败返回设备状态或入队错误
+     */
+    [[nodiscard]] auto await_resume() const noexcept -> Expected<void> {
+      if (status_ != ErrorCode::kSuccess) {
+        return std::unexpected(Error{status_});
+      }
+      return {};
+    }
+
+    /// @name 构造/移动/拷贝控制
+    /// @{
+    IoAwaiter(VirtioBlk& blk, ReqType type, uint16_t queue_index,
+              uint64_t sector, const IoVec* buffers, size_t buffer_count)
+        : blk_(blk),
+          type_(type),
+          queue_index_(queue_index),
+          sector_(sector),
+          buffers_(buffers),
+          buffer_count_(buffer_count) {}
+    IoAwaiter(IoAwaiter&&) = delete;
+    auto operator=(IoAwaiter&&) -> IoAwaiter& = delete;
+    IoAwaiter(const IoAwaiter&) = delete;
+    auto operator=(const IoAwaiter&) -> IoAwaiter& = delete;
+    ~IoAwaiter() = default;
+    /// @}
+
+   private:
+    friend class VirtioBlk;
+
+    /**
+     * @brief 记录完成状态并恢复协程（由 ProcessCompletions 调用）
+     * @param status 设备返回的完成状态
+     */
+    auto Complete(ErrorCode status) -> void {
+      status_ = status;
+      handle_.resume();
+    }
+
+    /// 所属驱动
+    VirtioBlk& blk_;
+    /// 请求类型（kIn/kOut）
+    ReqType type_;
+    /// 队列索引
+    uint16_t queue_index_;
+    /// 起始扇区号
+    uint64_t sector_;
+    /// 数据缓冲区 IoVec 数组（入队时读取）
+    const IoVec* buffers_;
+    /// buffers 数组中的元素数量
+    size_t buffer_count_;
+    /// 完成状态
+    ErrorCode status_ = ErrorCode::kSuccess;
+    /// 等待请求完成的协程
+    std::coroutine_handle<> handle_;
+  };
+
+  /**
+   * @brief 以协程方式读取
+   *
+   * 返回的等待者被 co_await 时入队读请求并 Kick，请求完成后恢复协程。
+   * 参数约束与 EnqueueRead() 相同。
+   *
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @param sector 起始扇区号（以 512 字节为单位）
+   * @param buffers 数据缓冲区 IoVec 数组（物理地址 + 长度）
+   * @param buffer_count buffers 数组中的元素数量
+   * @return 等待者，co_await 结果为 Expected<void>
+   */
+  [[nodiscard]] auto AsyncRead(uint16_t queue_index, uint64_t sector,
+                               const IoVec* buffers, size_t buffer_count)
+      -> IoAwaiter {
+    return {*this, ReqType::kIn, queue_index, sector, buffers, buffer_count};
+  }
+
+  /**
+   * @brief 以协程方式写入
+   *
+   * 返回的等待者被 co_await 时入队写请求并 Kick，请求完成后恢复协程。
+   * 参数约束与 EnqueueWrite() 相同。
+   *
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @param sector 起始扇区号（以 512 字节为单位）
+   * @param buffers 数据缓冲区 IoVec 数组（物理地址 + 长度）
+   * @param buffer_count buffers 数组中的元素数量
+   * @return 等待者，co_await 结果为 Expected<void>
+   */
+  [[nodiscard]] auto AsyncWrite(uint16_t queue_index, uint64_t sector,
+                                const IoVec* buffers, size_t buffer_count)
+      -> IoAwaiter {
+    return {*this, ReqType::kOut, queue_index, sector, buffers, buffer_count};
+  }
+
+  // ======== 同步便捷方法 ========
+  //
+  // 同步方法在队列 0 上自行轮询回收完成，没有可交付的完成回调：队列 0
+  // 上仍有以回调方式提交（EnqueueRead() 等）且尚未完成的请求时返回
+  // kDeviceBusy，而不是回收并丢弃它们的完成。协程请求不受此限制。
+  // 并发提交模式下调用者须保证同步调用期间没有回调方式的提交。
+
+  /**
+   * @brief 同步读取一个扇区
+   *
+   * 基于异步接口实现：EnqueueRead → Kick → 轮询 HandleInterrupt → 返回。
+   *
+   * @param sector 起始扇区号（以 512 字节为单位）
+   * @param data 数据缓冲区（至少 kSectorSize 字节，必须位于 DMA 可访问内存）
+   * @return 成功或失败
+   * @note 缓冲区在函数返回前不得释放或修改
+   * @see virtio-v1.2#5.2.6 Device Operation
+   */
+  [[nodiscard]] auto Read(uint64_t sector, uint8_t* data) -> Expected<void> {
+    if (data == nullptr) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    IoVec data_iov{Traits::VirtToPhys(data), kSectorSize};
+    return SubmitSyncRequest(ReqType::kIn, sector, &data_iov, 1);
+  }
+
+  /**
+   * @brief 同步写入一个扇区
+   *
+   * 基于异步接口实现：EnqueueWrite → Kick → 轮询 HandleInterrupt → 返回。
+   *
+   * @param sector 起始扇区号（以 512 字节为单位）
+   * @param data 数据缓冲区（至少 kSectorSize 字节，必须位于 DMA 可访问内存）
+   * @return 成功或失败
+   * @note 如果设备协商了 VIRTIO_BLK_F_RO，写请求将返回错误
+   * @see virtio-v1.2#5.2.6 Device Operation
+   */
+  [[nodiscard]] auto Write(uint64_t sector, const uint8_t* data)
+      -> Expected<void> {
+    if (data == nullptr) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    IoVec data_iov{Traits::VirtToPhys(const_cast<uint8_t*>(data)), kSectorSize};
+    return SubmitSyncRequest(ReqType::kOut, sector, &data_iov, 1);
+  }
+
+  /**
+   * @brief 同步读取一个扇区到 DMA 缓冲区（使用缓存的物理地址）
+   *
+   * @param sector 起始扇区号（以 512 字节为单位）
+   * @param buffer DMA 缓冲区（size 至少 kSectorSize 字节）
+   * @return 成功或失败
+   */
+  [[nodiscard]] auto Read(uint64_t sector, const DmaBuffer& buffer)
+      -> Expected<void> {
+    if (!buffer.IsValid() || buffer.size < kSectorSize) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    IoVec data_iov = ToIoVec(buffer.Slice(0, kSectorSize));
+    return SubmitSyncRequest(ReqType::kIn, sector, &data_iov, 1);
+  }
+
+  /**
+   * @brief 同步将 DMA 缓冲区写入一个扇区（使用缓存的物理地址）
+   *
+   * @param sector 起始扇区号（以 512 字节为单位）
+   * @param buffer DMA 缓冲区（size 至少 kSectorSize 字节）
+   * @return 成功或失败
+   */
+  [[nodiscard]] auto Write(uint64_t sector, const DmaBuffer& buffer)
+      -> Expected<void> {
+    if (!buffer.IsValid() || buffer.size < kSectorSize) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    IoVec data_iov = ToIoVec(buffer.Slice(0, kSectorSize));
+    return SubmitSyncRequest(ReqType::kOut, sector, &data_iov, 1);
+  }
+
+  /**
+   * @brief 同步 Flush：将设备写缓存落盘
+   *
+   * 未协商 VIRTIO_BLK_F_FLUSH 时设备为写直通，直接返回成功。
+   *
+   * @return 成功或失败
+   * @see virtio-v1.2#5.2.6.2 Device Requirements: Device Operation
+   */
+  [[nodiscard]] auto Flush() -> Expected<void> {
+    if (!SupportsFlush()) {
+      return {};
+    }
+    return SubmitSyncRequest(ReqType::kFlush, 0, nullptr, 0);
+  }
+
+  /**
+   * @brief 同步读取设备 ID 字符串
+   *
+   * @param id 输出缓冲区（kDeviceIdMaxLen 字节；长度为 kDeviceIdMaxLen
+   *        时没有 NUL 终止符）
+   * @return 成功或失败
+   */
+  [[nodiscard]] auto GetId(uint8_t* id) -> Expected<void> {
+    if (id == nullptr) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    IoVec iov{Traits::VirtToPhys(id), kDeviceIdMaxLen};
+    return SubmitSyncRequest(ReqType::kGetId, 0, &iov, 1);
+  }
+
+  /**
+   * @brief 同步 DISCARD 一段连续扇区
+   *
+   * 按 max_discard_sectors 拆分为多个范围，每个请求携带最多
+   * max_discard_seg 个范围。
+   *
+   * @param sector 起始扇区号
+   * @param num_sectors 扇区数
+   * @return 成功或失败
+   */
+  [[nodiscard]] auto Discard(uint64_t sector, uint64_t num_sectors)
+      -> Expected<void> {
+    return SubmitSyncRanges(ReqType::kDiscard, sector, num_sectors, false);
+  }
+
+  /**
+   * @brief 同步 WRITE_ZEROES 一段连续扇区
+   *
+   * 按 max_write_zeroes_sectors 拆分为多个范围，每个请求携带最多
+   * max_write_zeroes_seg 个范围。
+   *
+   * @param sector 起始扇区号
+   * @param num_sectors 扇区数
+   * @param unmap 允许设备以 unmap 方式实现清零
+   * @return 成功或失败
+   */
+  [[nodiscard]] auto WriteZeroes(uint64_t sector, uint64_t num_sectors,
+                                 bool unmap = false) -> Expected<void> {
+    return SubmitSyncRanges(ReqType::kWriteZeroes, sector, num_sectors, unmap);
+  }
+
+  // ======== 配置与监控 ========
+
+  /**
+   * @brief 获取块设备配置快照
+   *
+   * 配置空间的可用字段取决于协商的特性位。快照在 Create() 时建立，
+   * 之后只在收到配置变更中断（或 RefreshConfig() 发现 config_generation
+   * 变化）后的首次访问时重新读取，其余调用不访问设备寄存器。
+   *
+   * @return 块设备配置结构（引用在下次刷新前有效）
+   * @see virtio-v1.2#5.2.4 Device configuration layout
+   */
+  [[nodiscard]] auto ReadConfig() const -> const BlkConfig& {
+    if (config_stale_) {
+      LoadConfig();
+    }
+    return config_.config;
+  }
+
+  /**
+   * @brief 按 config_generation 校验配置快照，必要时重新读取
+   *
+   * 只读取一次 generation 寄存器。适用于没有接入配置变更中断的场景
+   * （如逐队列中断向量下未处理配置向量）。
+   *
+   * @return 快照被重新读取时返回 true
+   * @see virtio-v1.2#2.5.1 Driver Requirements: Device Configuration Space
+   */
+  auto RefreshConfig() -> bool {
+    if (!config_stale_ &&
+        transport_.GetConfigGeneration() == config_.generation) {
+      return false;
+    }
+    LoadConfig();
+    return true;
+  }
+
+  /**
+   * @brief 配置变更通知：使配置快照失效
+   *
+   * 共享中断状态寄存器时由 HandleInterrupt() 自动调用；使用逐队列
+   * 中断向量（如 MSI-X）时应由配置向量的中断处理函数调用。
+   * 只设置标志，下次访问配置时才重新读取，可在中断上下文中调用。
+   *
+   * @see virtio-v1.2#4.2.3.3 Notification of Device Configuration Changes
+   */
+  auto HandleConfigChange() -> void {
+    config_stale_ = true;
+    queues_[0].stats.config_changes++;
+  }
+
+  /**
+   * @brief 获取设备容量
+   *
+   * 取自配置快照，通常不访问设备寄存器（见 ReadConfig()）。
+   *
+   * @return 设备容量（以 512 字节扇区为单位）
+   * @see virtio-v1.2#5.2.4
+   */
+  [[nodiscard]] auto GetCapacity() const -> uint64_t {
+    return ReadConfig().capacity;
+  }
+
+  /**
+   * @brief 获取协商后的特性位
+   *
+   * @return 设备和驱动程序都支持的特性位掩码
+   */
+  [[nodiscard]] auto GetNegotiatedFeatures() const -> uint64_t {
+    return negotiated_features_;
+  }
+
+  /**
+   * @brief 获取单个请求允许的最大 IoVec 数量（含请求头和状态字节）
+   *
+   * 协商 VIRTIO_F_INDIRECT_DESC 时为 kMaxIndirectSgElements，
+   * 否则为 kMaxSgElements。
+   */
+  [[nodiscard]] auto GetMaxSgElements() const -> size_t {
+    return HasFeature<ReservedFeature::kIndirectDesc>() ? kMaxIndirectSgElements
+                                                        : kMaxSgElements;
+  }
+
+  /**
+   * @brief 是否协商了 VIRTIO_BLK_F_FLUSH
+   */
+  [[nodiscard]] auto SupportsFlush() const -> bool {
+    return HasFeature<BlkFeatureBit::kFlush>();
+  }
+
+  /**
+   * @brief 获取 DISCARD 请求限制（未协商时 max_segments 为 0）
+   */
+  [[nodiscard]] auto GetDiscardLimits() const -> RangeLimits {
+    (void)ReadConfig();
+    return config_.discard;
+  }
+
+  /**
+   * @brief 获取 WRITE_ZEROES 请求限制（未协商时 max_segments 为 0）
+   */
+  [[nodiscard]] auto GetWriteZeroesLimits() const -> RangeLimits {
+    (void)ReadConfig();
+    return config_.write_zeroes;
+  }
+
+  /**
+   * @brief 获取实际使用的请求队列数
+   */
+  [[nodiscard]] auto GetQueueCount() const -> uint16_t { return queue_count_; }
+
+  /**
+   * @brief 获取传输层
+   *
+   * 供平台代码访问传输层特有的功能（如 PciTransport 的 MSI-X 表配置）。
+   *
+   * @warning 不得通过它修改设备状态或队列配置
+   */
+  [[nodiscard]] auto GetTransport() -> TransportT<Traits>& {
+    return transport_;
+  }
+
+  /**
+   * @brief 获取性能监控统计数据
+   *
+   * @return 所有队列统计数据之和的快照
+   * @see 架构文档 §3
+   */
+  [[nodiscard]] auto GetStats() const -> VirtioStats {
+    VirtioStats total{};
+    for (uint16_t i = 0; i < queue_count_; ++i) {
+      const auto& stats = queues_[i].stats;
+      total.bytes_transferred += stats.bytes_transferred;
+      total.kicks_elided += stats.kicks_elided;
+      total.interrupts_handled += stats.interrupts_handled;
+      total.queue_full_errors += stats.queue_full_errors;
+      total.poll_mode_entries += stats.poll_mode_entries;
+      total.polled_completions += stats.polled_completions;
+      total.config_changes += stats.config_changes;
+      total.requests_canceled += stats.requests_canceled;
+      total.requests_timed_out += stats.requests_timed_out;
+      total.resumes += stats.resumes;
+    }
+    return total;
+  }
+
+  /**
+   * @brief 获取单个队列的性能监控统计数据
+   *
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @return 该队列统计数据的快照，索引无效时返回全零
+   */
+  [[nodiscard]] auto GetQueueStats(uint16_t queue_index) const -> VirtioStats {
+    if (queue_index >= queue_count_) {
+      return {};
+    }
+    return queues_[queue_index].stats;
+  }
+
+  /**
+   * @brief 获取单个队列的遥测数据（仅 Traits 满足 TelemetryTraits 时可用）
+   *
+   * @param queue_index 队列索引（< GetQueueCount()）
+   * @return 该队列遥测数据，索引无效时返回 nullptr
+   */
+  [[nodiscard]] auto GetTelemetry(uint16_t queue_index) const
+      -> const VirtioTelemetry*
+    requires TelemetryTraits<Traits>
+  {
+    if (queue_index >= queue_count_) {
+      return nullptr;
+    }
+    return &queues_[queue_index].telemetry;
+  }
+
+  /**
+   * @brief 清零单个队列的遥测数据（保留当前在途请求数）
+   *
+   * @param queue_index 队列索引（< GetQueueCount()）
+   */
+  auto ResetTelemetry(uint16_t queue_index) -> void
+    requires TelemetryTraits<Traits>
+  {
+    if (queue_index >= queue_count_) {
+      return;
+    }
+    auto& telemetry = queues_[queue_index].telemetry;
+    uint32_t inflight = telemetry.inflight;
+    telemetry = {};
+    telemetry.inflight = inflight;
+    telemetry.max_inflight = inflight;
+  }
+
+  /// @name 移动/拷贝控制
+  /// @{
+  VirtioBlk(VirtioBlk&& other) noexcept
+      : transport_(std::move(other.transport_)),
+        negotiated_features_(other.negotiated_features_),
+        queue_count_(other.queue_count_),
+        poll_threshold_(other.poll_threshold_),
+        request_timeout_(other.request_timeout_),
+        config_(other.config_),
+        config_stale_(other.config_stale_),
+        request_completed_(other.request_completed_),
+        quiesced_(other.quiesced_) {
+    MoveQueues(other);
+  }
+  auto operator=(VirtioBlk&& other) noexcept -> VirtioBlk& {
+    if (this != &other) {
+      transport_ = std::move(other.transport_);
+      negotiated_features_ = other.negotiated_features_;
+      queue_count_ = other.queue_count_;
+      poll_threshold_ = other.poll_threshold_;
+      request_timeout_ = other.request_timeout_;
+      config_ = other.config_;
+      config_stale_ = other.config_stale_;
+      request_completed_ = other.request_completed_;
+      quiesced_ = other.quiesced_;
+      MoveQueues(other);
+    }
+    return *this;
+  }
+  VirtioBlk(const VirtioBlk&) = delete;
+  auto operator=(const VirtioBlk&) -> VirtioBlk& = delete;
+  ~VirtioBlk() = default;
+  /// @}
+
+ private:
+  /// 是否记录遥测数据
+  static constexpr bool kTelemetry = TelemetryTraits<Traits>;
+  /// 是否记录请求延迟（需要 Traits::Now()）
+  static constexpr bool kTimestamps = kTelemetry && TimestampTraits<Traits>;
+
+  /// 是否写入热路径跟踪记录
+  static constexpr bool kTrace = TraceTraits<Traits>;
+
+  /// 是否启用多生产者并发提交
+  static constexpr bool kConcurrent = ConcurrentSubmitTraits<Traits>;
+
+  /// 特性集是否可能协商 DISCARD / WRITE_ZEROES（决定请求槽是否内嵌范围数组）
+  static constexpr bool kRangeRequests =
+      kFeatureMode<Features, BlkFeatureBit::kDiscard> != FeatureMode::kNever ||
+      kFeatureMode<Features, BlkFeatureBit::kWriteZeroes> !=
+          FeatureMode::kNever;
+
+  /// 尚无截止时间时 QueueContext::next_deadline 的取值
+  static constexpr uint64_t kNoDeadline = ~uint64_t{0};
+
+  static_assert(!kConcurrent ||
+                    std::is_same_v<VirtqueueT<Traits>, SplitVirtqueue<Traits>>,
+                "Concurrent submission requires SplitVirtqueue");
+  static_assert(!(kConcurrent && kTelemetry),
+                "Telemetry requires single-producer submission");
+  static_assert(!kConcurrent ||
+                    kFeatureMode<Features, ReservedFeature::kIndirectDesc> !=
+                        FeatureMode::kNever,
+                "Concurrent submission requires VIRTIO_F_INDIRECT_DESC");
+
+  /// 读取配置快照时 config_generation 不一致的最大重试次数
+  static constexpr uint32_t kMaxConfigRetries = 8;
+
+  /**
+   * @brief 配置空间快照
+   */
+  struct ConfigSnapshot {
+    /// 配置字段
+    BlkConfig config{};
+    /// DISCARD 请求限制
+    RangeLimits discard{};
+    /// WRITE_ZEROES 请求限制
+    RangeLimits write_zeroes{};
+    /// 读取快照时的 config_generation
+    uint32_t generation{0};
+  };
+
+  /// 不受特性集影响、始终请求的特性位
+  static constexpr uint64_t kMandatory =
+      static_cast<uint64_t>(ReservedFeature::kVersion1) |
+      VirtqueueT<Traits>::kRequiredFeatures;
+  /// EVENT_IDX 的编译期状态（决定 Kick/完成路径是否保留通知抑制逻辑）
+  static constexpr FeatureMode kEventIdxMode =
+      kFeatureMode<Features, ReservedFeature::kEventIdx>;
+
+  /// 请求槽占用位图类型（并发提交模式下以原子操作分配）
+  using SlotBitmapT =
+      std::conditional_t<kConcurrent, AtomicSlotBitmap<kMaxInflight>,
+                         SlotBitmap<kMaxInflight>>;
+
+  /// 遥测关闭时替代遥测字段的空类型
+  struct NoTelemetry {};
+
+  /**
+   * @brief 请求槽中的遥测字段
+   */
+  struct SlotTelemetry {
+    /// 入队时间戳（Traits::Now()，未提供时为 0）
+    uint64_t submit_time;
+    /// 请求类别
+    RequestClass request_class;
+  };
+
+  /// 请求头/状态字节数组每项的对齐（不小于一个缓存行）
+  static constexpr size_t kSlotDmaAlign =
+      DmaCacheLineSize<Traits>() > kDefaultCacheLineSize
+          ? DmaCacheLineSize<Traits>()
+          : kDefaultCacheLineSize;
+
+  /**
+   * @brief 请求完成、取消或超时时通知调用者的方式
+   */
+  enum class NotifyKind : uint8_t {
+    /// 调用 ProcessCompletions()/Cancel()/ExpireRequests() 传入的回调
+    kCallback,
+    /// token 指向 IoAwaiter：记录状态并恢复其协程
+    kAwaiter,
+    /// token 指向同步等待者 SyncWaiter：只记录状态
+    kWaiter,
+  };
+
+  /**
+   * @brief 同步等待者（WaitFor() 与同步读写的栈上完成记录）
+   *
+   * 被等待的请求以它替换 token，完成、Cancel() 与 ExpireRequests()
+   * 都只在此记录结果，由等待方返回给调用者。
+   */
+  struct SyncWaiter {
+    /// 是否已有结果
+    bool done = false;
+    /// 完成状态
+    ErrorCode status = ErrorCode::kSuccess;
+  };
+
+  /**
+   * @brief 异步请求上下文槽
+   *
+   * 每个 in-flight 请求占用一个槽，仅保存 CPU 侧簿记：用户 token、
+   * 描述符链头索引、取消状态与截止时间。设备可见的请求头与状态字节
+   * 位于 RequestDma 数组。被取消的请求继续占用槽与描述符，直到设备
+   * 在 Used Ring 中归还它。
+   * 两个数组都位于调用者提供的队列区域内（设备不访问本数组），
+   * 槽的占用状态由 QueueContext::slot_bitmap（分层位图）管理。
+   */
+  struct RequestSlot {
+    /// 用户自定义上下文指针（notify 非 kCallback 时指向对应的等待者）
+    UserData token;
+    /// 分配代数（每次分配递增，用于校验 RequestHandle）
+    uint32_t generation = 0;
+    /// 完成、取消或超时时的通知方式
+    NotifyKind notify = NotifyKind::kCallback;
+    /// 完成时需检查缓存维护的描述符数量（仅非一致性 DMA 平台使用）
+    uint8_t sync_count = 0;
+    /// 已取消或超时：调用者已得到通知，设备归还后静默释放
+    bool canceled = false;
+    /// 描述符链头索引（用于在 Used Ring 中匹配）
+    uint16_t desc_head;
+    /// 截止时间（Traits::Now() 时基，0 表示无；不支持截止时间时不占空间）
+    [[no_unique_address]] std::conditional_t<kDeadlines, uint64_t,
+                                             NoTelemetry> deadline;
+    /// 遥测字段（遥测关闭时不占空间）
+    [[no_unique_address]] std::conditional_t<kTelemetry, SlotTelemetry,
+                                             NoTelemetry> telemetry;
+  };
+
+  /**
+   * @brief 请求槽中设备可见的部分（位于调用者提供的队列 DMA 区域内）
+   *
+   * 每项独占 kSlotDmaAlign 字节：设备写入的状态字节既不与 CPU 侧簿记
+   * 共享缓存行，也不与相邻槽共享；驱动对象移动时其物理地址保持不变。
+   */
+  struct alignas(kSlotDmaAlign) RequestDma {
+    /// 请求头（设备只读）
+    BlkReqHeader header;
+    /// 同步 DISCARD / WRITE_ZEROES 的范围数组（设备只读）：请求超时后
+    /// 设备仍可能读取它，因此不能位于调用者栈上（特性集排除这两种请求时
+    /// 不占空间）
+    [[no_unique_address]] std::conditional_t<
+        kRangeRequests, BlkDiscardWriteZeroes[kMaxSyncRanges], NoTelemetry>
+        ranges;
+    /// 状态字节（设备只写）
+    volatile uint8_t status;
+  };
+
+  /// 间接描述符表条目类型（与所用 Virtqueue 的描述符格式一致）
+  using IndirectDesc = typename VirtqueueT<Traits>::Desc;
+
+  /**
+   * @brief 队列区域内间接描述符表的偏移
+   *
+   * @param queue_size 每个队列的描述符数量
+   * @return 相对队列区域起始的字节偏移
+   */
+  [[nodiscard]] static constexpr auto GetIndirectTableOffset(
+      uint32_t queue_size) -> size_t {
+    // 非一致性 DMA 平台上与设备写入的环尾部分隔到不同缓存行
+    constexpr size_t kAlign =
+        DmaCacheLineSize<Traits>() > VirtqueueT<Traits>::Desc::kAlign
+            ? DmaCacheLineSize<Traits>()
+            : VirtqueueT<Traits>::Desc::kAlign;
+    return AlignUp(
+        VirtqueueT<Traits>::CalcSize(static_cast<uint16_t>(queue_size), true),
+        kAlign);
+  }
+
+  /**
+   * @brief 队列区域内描述符链头 → 请求槽映射表的偏移
+   *
+   * @param queue_size 每个队列的描述符数量
+   * @return 相对队列区域起始的字节偏移
+   */
+  [[nodiscard]] static constexpr auto GetSlotMapOffset(uint32_t queue_size)
+      -> size_t {
+    return AlignUp(GetIndirectTableOffset(queue_size) +
+                       sizeof(IndirectDesc) * kMaxIndirectSgElements *
+                           GetUsableSlots(queue_size),
+                   alignof(uint16_t));
+  }
+
+  /**
+   * @brief 队列区域内请求头/状态字节数组的偏移
+   *
+   * @param queue_size 每个队列的描述符数量
+   * @return 相对队列区域起始的字节偏移
+   */
+  [[nodiscard]] static constexpr auto GetRequestDmaOffset(uint32_t queue_size)
+      -> size_t {
+    return AlignUp(GetRequestSlotOffset(queue_size) +
+                       sizeof(RequestSlot) * GetUsableSlots(queue_size),
+                   alignof(RequestDma));
+  }
+
+  /**
+   * @brief 队列区域内请求槽簿记数组的偏移
+   *
+   * @param queue_size 每个队列的描述符数量
+   * @return 相对队列区域起始的字节偏移
+   */
+  [[nodiscard]] static constexpr auto GetRequestSlotOffset(uint32_t queue_size)
+      -> size_t {
+    return AlignUp(GetSlotMapOffset(queue_size) + sizeof(uint16_t) * queue_size,
+                   alignof(RequestSlot));
+  }
+
+  /**
+   * @brief 每个队列实际可用的请求槽数量
+   *
+   * 每个请求至少占用一个环上描述符，超过 queue_size 的槽永远用不到，
+   * 也不为其预留间接描述符表。
+   *
+   * @param queue_size 每个队列的描述符数量
+   * @return min(kMaxInflight, queue_size)
+   */
+  [[nodiscard]] static constexpr auto GetUsableSlots(uint32_t queue_size)
+      -> size_t {
+    return queue_size < kMaxInflight ? queue_size : kMaxInflight;
+  }
+
+  /**
+   * @brief 单个请求队列的运行时状态
+   *
+   * 每个队列独占一个 Virtqueue、请求槽池和统计数据，
+   * 不同队列之间没有共享的可变状态。
+   */
+  struct QueueContext {
+    /// Virtqueue 实例（Create() 中按实际队列数构造）
+    std::optional<VirtqueueT<Traits>> vq;
+    /// 请求槽间接描述符表（DMA 内存，slots[i] 使用第 i 张表）
+    volatile IndirectDesc* indirect_tables = nullptr;
+    /// indirect_tables 的物理地址
+    uint64_t indirect_phys = 0;
+    /// 描述符链头 → 请求槽索引映射表（队列区域内，queue_size 项，仅 CPU
+    /// 访问）
+    uint16_t* slot_map = nullptr;
+    /// 请求头/状态字节数组（DMA 内存，slots[i] 使用第 i 项）
+    RequestDma* request_dma = nullptr;
+    /// request_dma 的物理地址
+    uint64_t request_dma_phys = 0;
+    /// 请求槽池（队列区域内，用于跟踪 in-flight 异步请求，仅 CPU 访问）
+    RequestSlot* slots = nullptr;
+    /// 请求槽占用位图（bit i = 1 表示 slots[i] 被占用）
+    SlotBitmapT slot_bitmap{};
+    /// 上次 Kick 时的 avail idx（用于 Event Index 通知抑制，
+    /// 并发提交模式下原子访问）
+    uint16_t old_avail_idx = 0;
+    /// 是否处于轮询模式（Used Buffer 通知已暂停）
+    bool polling = false;
+    /// 在途请求中最早的截止时间（kNoDeadline 表示无，超时扫描据此提前返回）
+    uint64_t next_deadline = kNoDeadline;
+    /// 性能统计数据
+    VirtioStats stats{};
+    /// 遥测数据（遥测关闭时不占空间）
+    [[no_unique_address]] std::conditional_t<kTelemetry, VirtioTelemetry,
+                                             NoTelemetry> telemetry{};
+  };
+
+  /**
+   * @brief 私有构造函数
+   *
+   * 只能通过 Create() 静态工厂方法创建实例。
+   */
+  explicit VirtioBlk(TransportT<Traits> transport)
+      : transport_(std::move(transport)),
+        negotiated_features_(0),
+        queue_count_(0),
+        poll_threshold_(0),
+        request_timeout_(0),
+        config_stale_(true),
+        request_completed_(false),
+        quiesced_(false) {}
+
+  /**
+   * @brief 判断特性是否生效（特性集已确定的特性为编译期常量）
+   */
+  template <auto Feature>
+  [[nodiscard]] auto HasFeature() const -> bool {
+    return FeatureActive<Features, Feature>(negotiated_features_);
+  }
+
+  /**
+   * @brief 生效的特性位：特性集已确定的位取编译期值，其余取协商结果
+   *
+   * 特性集固定全部特性时结果为常量，请求类型检查不再读取成员。
+   */
+  [[nodiscard]] auto ActiveFeatures() const -> uint64_t {
+    if constexpr (Features::kKnown == ~uint64_t{0}) {
+      return Features::kEnabled | kMandatory;
+    } else {
+      return (negotiated_features_ & ~Features::kKnown) | Features::kEnabled;
+    }
+  }
+
+  /**
+   * @brief 队列是否启用了 EVENT_IDX（特性集已确定时为编译期常量）
+   */
+  [[nodiscard]] static auto EventIdxActive(const VirtqueueT<Traits>& vq)
+      -> bool {
+    if constexpr (kEventIdxMode == FeatureMode::kRuntime) {
+      return vq.EventIdxEnabled();
+    } else {
+      return kEventIdxMode == FeatureMode::kAlways;
+    }
+  }
+
+  /**
+   * @brief 向设备发送队列通知
+   *
+   * 协商了 VIRTIO_F_NOTIFICATION_DATA 时随通知携带下一个可用位置，
+   * 设备无需再读取 Available Ring 的索引。
+   *
+   * @param queue_index 队列索引
+   * @see virtio-v1.2#2.9 Driver Notifications
+   */
+  auto NotifyDevice(uint16_t queue_index) -> void {
+    // 特性集关闭 NOTIFICATION_DATA 时特性位检查在编译期消除
+    bool notification_data = false;
+    if constexpr (kFeatureMode<Features, ReservedFeature::kNotificationData> !=
+                  FeatureMode::kNever) {
+      notification_data = HasFeature<ReservedFeature::kNotificationData>();
+    }
+    NotifyVirtqueue(transport_, queue_index, *queues_[queue_index].vq,
+                    notification_data);
+  }
+
+  /**
+   * @brief 传输层是否为每个队列使用独立的中断向量
+   */
+  [[nodiscard]] auto UsesQueueVectors() const -> bool {
+    if constexpr (QueueVectorTransport<TransportT<Traits>>) {
+      return transport_.UsesQueueVectors();
+    } else {
+      return false;
+    }
+  }
+
+  /**
+   * @brief 确认设备中断（读取并回写 InterruptStatus）
+   *
+   * 配置变更位置位时使配置快照失效。
+   */
+  auto AckDeviceInterrupt() -> void {
+    uint32_t isr_status = transport_.GetInterruptStatus();
+    if (isr_status != 0) {
+      transport_.AckInterrupt(isr_status);
+      if ((isr_status &
+           static_cast<uint32_t>(InterruptStatus::kConfigChange)) != 0) {
+        HandleConfigChange();
+      }
+    }
+  }
+
+  /**
+   * @brief 异步入队请求的内部实现
+   *
+   * 分配请求槽，填充请求头，构建 Scatter-Gather 描述符链，提交到 Available
+   * Ring。数据方向由请求类型决定：kIn/kGetId/kGetLifetime 为设备可写，
+   * kFlush 不带数据，其余类型为设备只读。
+   *
+   * @param type 请求类型
+   * @param queue_index 队列索引
+   * @param sector 起始扇区号
+   * @param buffers 数据缓冲区 IoVec 数组
+   * @param buffer_count 缓冲区数量
+   * @param token 用户上下文指针
+   * @param notify 完成时的通知方式（token 的含义随之确定）
+   * @param ranges 非空时复制到请求槽的 RequestDma::ranges 并作为数据
+   *        缓冲区（此时 buffer_count 须为 0）
+   * @param range_count ranges 中的范围数（不超过 kMaxSyncRanges）
+   * @return 成功返回请求句柄，失败返回错误
+   */
+  [[nodiscard]] auto DoEnqueue(ReqType type, uint16_t queue_index,
+                               uint64_t sector, const IoVec* buffers,
+                               size_t buffer_count, UserData token,
+                               NotifyKind notify = NotifyKind::kCallback,
+                               const BlkDiscardWriteZeroes* ranges = nullptr,
+                               size_t range_count = 0)
+      -> Expected<RequestHandle> {
+    if (queue_index >= queue_count_) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    if (quiesced_) {
+      return std::unexpected(Error{ErrorCode::kDeviceBusy});
+    }
+
+    if (buffer_count + 2 > GetMaxSgElements()) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    if (type == ReqType::kFlush && buffer_count != 0) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    if (range_count > kMaxSyncRanges ||
+        (range_count != 0 && buffer_count != 0)) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    if constexpr (!kRangeRequests) {
+      if (range_count != 0) {
+        return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+      }
+    }
+    uint64_t required = RequiredFeature(type);
+    if ((ActiveFeatures() & required) != required) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+    }
+
+    auto& queue = queues_[queue_index];
+    auto slot_result = AllocRequestSlot(queue);
+    if (!slot_result) {
+      CountSubmitEvent(queue.stats.queue_full_errors);
+      return std::unexpected(slot_result.error());
+    }
+    uint16_t slot_idx = *slot_result;
+    auto& slot = queue.slots[slot_idx];
+    auto& dma = queue.request_dma[slot_idx];
+    uint64_t dma_phys = queue.request_dma_phys +
+                        static_cast<uint64_t>(slot_idx) * sizeof(RequestDma);
+
+    dma.header.type = static_cast<uint32_t>(type);
+    dma.header.reserved = 0;
+    // 仅读写请求使用 sector 字段，其余类型必须为 0
+    dma.header.sector =
+        (type == ReqType::kIn || type == ReqType::kOut) ? sector : 0;
+    dma.status = 0xFF;  // sentinel：设备完成后会覆写
+    slot.token = token;
+    slot.notify = notify;
+    slot.canceled = false;
+    ++slot.generation;
+    RequestHandle handle{queue_index, slot_idx, slot.generation};
+
+    IoVec readable_iovs[kMaxIndirectSgElements];
+    IoVec writable_iovs[kMaxIndirectSgElements];
+    size_t readable_count = 0;
+    size_t writable_count = 0;
+
+    readable_iovs[readable_count++] = {
+        dma_phys + offsetof(RequestDma, header), sizeof(BlkReqHeader)};
+
+    if constexpr (kRangeRequests) {
+      if (range_count != 0) {
+        for (size_t i = 0; i < range_count; ++i) {
+          dma.ranges[i] = ranges[i];
+        }
+        readable_iovs[readable_count++] = {
+            dma_phys + offsetof(RequestDma, ranges),
+            range_count * sizeof(BlkDiscardWriteZeroes)};
+      }
+    }
+
+    if (IsDeviceWritable(type)) {
+      for (size_t i = 0; i < buffer_count; ++i) {
+        writable_iovs[writable_count++] = buffers[i];
+      }
+    } else {
+      for (size_t i = 0; i < buffer_count; ++i) {
+        readable_iovs[readable_count++] = buffers[i];
+      }
+    }
+
+    // 状态字节始终为 device-writable
+    writable_iovs[writable_count++] = {dma_phys + offsetof(RequestDma, status),
+                                       sizeof(uint8_t)};
+
+    SyncRequestForDevice(queue, slot_idx, readable_iovs, readable_count,
+                         writable_iovs, writable_count);
+
+    if constexpr (kConcurrent) {
+      // 槽 i 固定使用描述符 i：发布前写好映射，发布后回收方可能立即完成
+      slot.desc_head = slot_idx;
+      queue.slot_map[slot_idx] = slot_idx;
+      auto submit_result = queue.vq->SubmitIndirectAt(
+          slot_idx,
+          queue.indirect_tables + slot_idx * kMaxIndirectSgElements,
+          queue.indirect_phys + static_cast<uint64_t>(slot_idx) *
+                                    kMaxIndirectSgElements *
+                                    sizeof(IndirectDesc),
+          readable_iovs, readable_count, writable_iovs, writable_count);
+      if (!submit_result) {
+        FreeRequestSlot(queue, slot_idx);
+        CountSubmitEvent(queue.stats.queue_full_errors);
+        return std::unexpected(submit_result.error());
+      }
+      TraceEnqueue(queue_index, slot_idx, buffers, buffer_count);
+      return handle;
+    }
+
+    // 请求头与状态字节的写入由 Virtqueue 发布请求前的写屏障排序
+    // 间接描述符：整个请求只占用一个环上描述符
+    auto chain_result =
+        HasFeature<ReservedFeature::kIndirectDesc>()
+            ? queue.vq->SubmitChainIndirect(
+                  queue.indirect_tables + slot_idx * kMaxIndirectSgElements,
+                  queue.indirect_phys + static_cast<uint64_t>(slot_idx) *
+                                            kMaxIndirectSgElements *
+                                            sizeof(IndirectDesc),
+                  readable_iovs, readable_count, writable_iovs, writable_count)
+            : queue.vq->SubmitChain(readable_iovs, readable_count,
+                                    writable_iovs, writable_count);
+    if (!chain_result) {
+      FreeRequestSlot(queue, slot_idx);
+      queue.stats.queue_full_errors++;
+      return std::unexpected(chain_result.error());
+    }
+
+    slot.desc_head = *chain_result;
+    queue.slot_map[slot.desc_head] = slot_idx;
+    ArmDeadline(queue, slot);
+    RecordSubmit(queue, slot, type);
+    TraceEnqueue(queue_index, slot.desc_head, buffers, buffer_count);
+
+    return handle;
+  }
+
+  /**
+   * @brief 跟踪：记录一次成功入队（跟踪关闭时为空操作）
+   *
+   * @param queue_index 队列索引
+   * @param head 描述符链头
+   * @param buffers 数据缓冲区 IoVec 数组
+   * @param buffer_count 缓冲区数量
+   */
+  static auto TraceEnqueue([[maybe_unused]] uint16_t queue_index,
+                           [[maybe_unused]] uint16_t head,
+                           [[maybe_unused]] const IoVec* buffers,
+                           [[maybe_unused]] size_t buffer_count) -> void {
+    if constexpr (kTrace) {
+      size_t len = 0;
+      for (size_t i = 0; i < buffer_count; ++i) {
+        len += buffers[i].len;
+      }
+      TracePoint<Traits>(TraceEvent::kEnqueue, queue_index, head,
+                         static_cast<uint32_t>(len));
+    }
+  }
+
+  /**
+   * @brief 为新入队的请求记录截止时间（不支持截止时间时为空操作）
+   *
+   * @param queue 所属队列
+   * @param slot 请求槽
+   */
+  auto ArmDeadline(QueueContext& queue, RequestSlot& slot) const -> void {
+    if constexpr (kDeadlines) {
+      slot.deadline = 0;
+      if (request_timeout_ != 0) {
+        slot.deadline =
+            static_cast<uint64_t>(Traits::Now()) + request_timeout_;
+        if (slot.deadline < queue.next_deadline) {
+          queue.next_deadline = slot.deadline;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief 遥测：记录一次成功入队（遥测关闭时为空操作）
+   *
+   * @param queue 所属队列
+   * @param slot 请求槽
+   * @param type 请求类型
+   */
+  static auto RecordSubmit(QueueContext& queue, RequestSlot& slot,
+                           ReqType type) -> void {
+    if constexpr (kTelemetry) {
+      RequestClass cls = type == ReqType::kIn      ? RequestClass::kRead
+                         : type == ReqType::kOut   ? RequestClass::kWrite
+                         : type == ReqType::kFlush ? RequestClass::kFlush
+                                                   : RequestClass::kOther;
+      slot.telemetry.request_class = cls;
+      if constexpr (kTimestamps) {
+        slot.telemetry.submit_time = static_cast<uint64_t>(Traits::Now());
+      }
+      auto& telemetry = queue.telemetry;
+      ++telemetry.submitted[static_cast<size_t>(cls)];
+      ++telemetry.inflight;
+      if (telemetry.inflight > telemetry.max_inflight) {
+        telemetry.max_inflight = telemetry.inflight;
+      }
+      telemetry.inflight_depth.Record(telemetry.inflight);
+    }
+  }
+
+  /**
+   * @brief 遥测：记录一个请求的完成（遥测关闭时为空操作）
+   *
+   * @param queue 所属队列
+   * @param slot 请求槽
+   * @param status 完成状态
+   * @param now 本次回收的时间戳（未提供 Traits::Now() 时忽略）
+   */
+  static auto RecordCompletion(QueueContext& queue, const RequestSlot& slot,
+                               ErrorCode status, uint64_t now) -> void {
+    if constexpr (kTelemetry) {
+      auto cls = static_cast<size_t>(slot.telemetry.request_class);
+      auto& telemetry = queue.telemetry;
+      ++telemetry.completed[cls];
+      if (status != ErrorCode::kSuccess) {
+        ++telemetry.errors[cls];
+      }
+      if constexpr (kTimestamps) {
+        telemetry.latency[cls].Record(now - slot.telemetry.submit_time);
+      }
+      if (telemetry.inflight > 0) {
+        --telemetry.inflight;
+      }
+    }
+  }
+
+  /**
+   * @brief 请求发布前写回请求头、状态字节与数据缓冲区的缓存行
+   *
+   * 仅在非一致性 DMA 平台上生效。设备可写的缓冲区同样需要写回，避免之后
+   * 淘汰的脏缓存行覆盖设备写入的数据。未使用间接描述符时，设备可写缓冲区
+   * 记录在该槽（此时闲置的）间接描述符表中，供完成时丢弃过期缓存行。
+   *
+   * @param queue 所属队列
+   * @param slot_idx 请求槽索引
+   * @param readable 设备只读缓冲区数组
+   * @param readable_count readable 数组中的元素数量
+   * @param writable 设备可写缓冲区数组
+   * @param writable_count writable 数组中的元素数量
+   */
+  auto SyncRequestForDevice(QueueContext& queue, uint16_t slot_idx,
+                            const IoVec* readable, size_t readable_count,
+                            const IoVec* writable, size_t writable_count)
+      -> void {
+    if constexpr (DmaCoherencyTraits<Traits>) {
+      for (size_t i = 0; i < readable_count; ++i) {
+        DmaSyncForDevice<Traits>(Traits::PhysToVirt(readable[i].phys_addr),
+                                 readable[i].len);
+      }
+      for (size_t i = 0; i < writable_count; ++i) {
+        DmaSyncForDevice<Traits>(Traits::PhysToVirt(writable[i].phys_addr),
+                                 writable[i].len);
+      }
+
+      auto& slot = queue.slots[slot_idx];
+      if (HasFeature<ReservedFeature::kIndirectDesc>()) {
+        slot.sync_count = static_cast<uint8_t>(readable_count + writable_count);
+        return;
+      }
+      volatile IndirectDesc* record =
+          queue.indirect_tables + slot_idx * kMaxIndirectSgElements;
+      for (size_t i = 0; i < writable_count; ++i) {
+        record[i].addr = writable[i].phys_addr;
+        record[i].len = static_cast<uint32_t>(writable[i].len);
+        record[i].flags = VirtqueueT<Traits>::kDescFWrite;
+      }
+      slot.sync_count = static_cast<uint8_t>(writable_count);
+    }
+  }
+
+  /**
+   * @brief 请求完成后丢弃设备写入区域（状态字节与数据缓冲区）的缓存行
+   *
+   * 仅在非一致性 DMA 平台上生效。
+   *
+   * @param queue 所属队列
+   * @param slot_idx 请求槽索引
+   */
+  auto SyncRequestForCpu(const QueueContext& queue, uint16_t slot_idx) const
+      -> void {
+    if constexpr (DmaCoherencyTraits<Traits>) {
+      const volatile IndirectDesc* record =
+          queue.indirect_tables + slot_idx * kMaxIndirectSgElements;
+      for (size_t i = 0; i < queue.slots[slot_idx].sync_count; ++i) {
+        if ((record[i].flags & VirtqueueT<Traits>::kDescFWrite) != 0) {
+          DmaSyncForCpu<Traits>(Traits::PhysToVirt(record[i].addr),
+                                record[i].len);
+        }
+      }
     }
-    stats_.interrupts_handled++;
-    request_completed_ = true;
-    Traits::Wmb();
   }
 
-  // ======== 同步便捷方法 ========
+  /**
+   * @brief 请求类型的数据缓冲区是否由设备写入
+   */
+  [[nodiscard]] static constexpr auto IsDeviceWritable(ReqType type) -> bool {
+    return type == ReqType::kIn || type == ReqType::kGetId ||
+           type == ReqType::kGetLifetime;
+  }
 
   /**
-   * @brief 同步读取一个扇区
-   *
-   * 基于异步接口实现：EnqueueRead → Kick → 轮询 HandleInterrupt → 返回。
-   *
-   * @param sector 起始扇区号（以 512 字节为单位）
-   * @param data 数据缓冲区（至少 kSectorSize 字节，必须位于 DMA 可访问内存）
-   * @return 成功或失败
-   * @note 缓冲区在函数返回前不得释放或修改
-   * @see virtio-v1.2#5.2.6 Device Operation
+   * @brief 请求类型所需的特性位（无要求时为 0）
    */
-  [[nodiscard]] auto Read(uint64_t sector, uint8_t* data) -> Expected<void> {
-    if (data == nullptr) {
-      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+  [[nodiscard]] static constexpr auto RequiredFeature(ReqType type)
+      -> uint64_t {
+    switch (type) {
+      case ReqType::kFlush:
+        return static_cast<uint64_t>(BlkFeatureBit::kFlush);
+      case ReqType::kGetLifetime:
+        return static_cast<uint64_t>(BlkFeatureBit::kLifetime);
+      case ReqType::kDiscard:
+        return static_cast<uint64_t>(BlkFeatureBit::kDiscard);
+      case ReqType::kWriteZeroes:
+        return static_cast<uint64_t>(BlkFeatureBit::kWriteZeroes);
+      case ReqType::kSecureErase:
+        return static_cast<uint64_t>(BlkFeatureBit::kSecureErase);
+      default:
+        return 0;
     }
-    IoVec data_iov{Traits::VirtToPhys(data), kSectorSize};
-    return SubmitSyncRequest(ReqType::kIn, sector, &data_iov, 1);
   }
 
   /**
-   * @brief 同步写入一个扇区
+   * @brief 由配置字段构造 DISCARD / WRITE_ZEROES 的范围限制
    *
-   * 基于异步接口实现：EnqueueWrite → Kick → 轮询 HandleInterrupt → 返回。
+   * 配置空间中为 0 的扇区上限视为不限，段数上限至少为 1。
    *
-   * @param sector 起始扇区号（以 512 字节为单位）
-   * @param data 数据缓冲区（至少 kSectorSize 字节，必须位于 DMA 可访问内存）
-   * @return 成功或失败
-   * @note 如果设备协商了 VIRTIO_BLK_F_RO，写请求将返回错误
-   * @see virtio-v1.2#5.2.6 Device Operation
+   * @param active 对应特性是否生效
+   * @param max_sectors 配置空间中的最大扇区数
+   * @param max_segments 配置空间中的最大段数
+   * @return 特性未生效时返回全零
    */
-  [[nodiscard]] auto Write(uint64_t sector, const uint8_t* data)
-      -> Expected<void> {
-    if (data == nullptr) {
-      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+  [[nodiscard]] static auto MakeRangeLimits(bool active, uint32_t max_sectors,
+                                            uint32_t max_segments)
+      -> RangeLimits {
+    if (!active) {
+      return {};
     }
-    IoVec data_iov{Traits::VirtToPhys(const_cast<uint8_t*>(data)), kSectorSize};
-    return SubmitSyncRequest(ReqType::kOut, sector, &data_iov, 1);
+    RangeLimits limits{max_sectors, max_segments};
+    if (limits.max_sectors == 0) {
+      limits.max_sectors = static_cast<uint32_t>(-1);
+    }
+    if (limits.max_segments == 0) {
+      limits.max_segments = 1;
+    }
+    return limits;
   }
 
-  // ======== 配置与监控 ========
-
   /**
-   * @brief 读取块设备配置空间
-   *
-   * 读取设备的配置信息，包括容量、几何信息、拓扑信息等。
-   * 配置空间的可用字段取决于协商的特性位。
-   *
-   * @return 块设备配置结构
-   * @see virtio-v1.2#5.2.4 Device configuration layout
+   * @brief 从配置空间读取全部字段
    */
-  [[nodiscard]] auto ReadConfig() const -> BlkConfig {
+  [[nodiscard]] auto FetchConfig() const -> BlkConfig {
     BlkConfig config{};
 
     config.capacity = transport_.ReadConfigU64(
@@ -359,8 +2421,7 @@ class VirtioBlk {
     config.seg_max = transport_.ReadConfigU32(
         static_cast<uint32_t>(BlkConfigOffset::kSegMax));
 
-    if ((negotiated_features_ &
-         static_cast<uint64_t>(BlkFeatureBit::kGeometry)) != 0) {
+    if (HasFeature<BlkFeatureBit::kGeometry>()) {
       config.geometry.cylinders = transport_.ReadConfigU16(
           static_cast<uint32_t>(BlkConfigOffset::kGeometryCylinders));
       config.geometry.heads = transport_.ReadConfigU8(
@@ -369,14 +2430,12 @@ class VirtioBlk {
           static_cast<uint32_t>(BlkConfigOffset::kGeometrySectors));
     }
 
-    if ((negotiated_features_ &
-         static_cast<uint64_t>(BlkFeatureBit::kBlkSize)) != 0) {
+    if (HasFeature<BlkFeatureBit::kBlkSize>()) {
       config.blk_size = transport_.ReadConfigU32(
           static_cast<uint32_t>(BlkConfigOffset::kBlkSize));
     }
 
-    if ((negotiated_features_ &
-         static_cast<uint64_t>(BlkFeatureBit::kTopology)) != 0) {
+    if (HasFeature<BlkFeatureBit::kTopology>()) {
       config.topology.physical_block_exp = transport_.ReadConfigU8(
           static_cast<uint32_t>(BlkConfigOffset::kTopologyPhysBlockExp));
       config.topology.alignment_offset = transport_.ReadConfigU8(
@@ -387,14 +2446,12 @@ class VirtioBlk {
           static_cast<uint32_t>(BlkConfigOffset::kTopologyOptIoSize));
     }
 
-    if ((negotiated_features_ &
-         static_cast<uint64_t>(BlkFeatureBit::kConfigWce)) != 0) {
+    if (HasFeature<BlkFeatureBit::kConfigWce>()) {
       config.writeback = transport_.ReadConfigU8(
           static_cast<uint32_t>(BlkConfigOffset::kWriteback));
     }
 
-    if ((negotiated_features_ &
-         static_cast<uint64_t>(BlkFeatureBit::kDiscard)) != 0) {
+    if (HasFeature<BlkFeatureBit::kDiscard>()) {
       config.max_discard_sectors = transport_.ReadConfigU32(
           static_cast<uint32_t>(BlkConfigOffset::kMaxDiscardSectors));
       config.max_discard_seg = transport_.ReadConfigU32(
@@ -403,8 +2460,7 @@ class VirtioBlk {
           static_cast<uint32_t>(BlkConfigOffset::kDiscardSectorAlignment));
     }
 
-    if ((negotiated_features_ &
-         static_cast<uint64_t>(BlkFeatureBit::kWriteZeroes)) != 0) {
+    if (HasFeature<BlkFeatureBit::kWriteZeroes>()) {
       config.max_write_zeroes_sectors = transport_.ReadConfigU32(
           static_cast<uint32_t>(BlkConfigOffset::kMaxWriteZeroesSectors));
       config.max_write_zeroes_seg = transport_.ReadConfigU32(
@@ -413,8 +2469,7 @@ class VirtioBlk {
           static_cast<uint32_t>(BlkConfigOffset::kWriteZeroesMayUnmap));
     }
 
-    if ((negotiated_features_ &
-         static_cast<uint64_t>(BlkFeatureBit::kSecureErase)) != 0) {
+    if (HasFeature<BlkFeatureBit::kSecureErase>()) {
       config.max_secure_erase_sectors = transport_.ReadConfigU32(
           static_cast<uint32_t>(BlkConfigOffset::kMaxSecureEraseSectors));
       config.max_secure_erase_seg = transport_.ReadConfigU32(
@@ -423,8 +2478,7 @@ class VirtioBlk {
           static_cast<uint32_t>(BlkConfigOffset::kSecureEraseSectorAlignment));
     }
 
-    if ((negotiated_features_ & static_cast<uint64_t>(BlkFeatureBit::kMq)) !=
-        0) {
+    if (HasFeature<BlkFeatureBit::kMq>()) {
       config.num_queues = transport_.ReadConfigU16(
           static_cast<uint32_t>(BlkConfigOffset::kNumQueues));
     }
@@ -433,266 +2487,491 @@ class VirtioBlk {
   }
 
   /**
-   * @brief 获取设备容量
+   * @brief 重新读取配置快照
    *
-   * @return 设备容量（以 512 字节扇区为单位）
-   * @see virtio-v1.2#5.2.4
+   * 以 config_generation 前后一致为准（设备在读取期间更新配置时重读），
+   * 重试耗尽时保留最后一次结果并保持失效标志，下次访问再次读取。
+   *
+   * @see virtio-v1.2#2.5.1 Driver Requirements: Device Configuration Space
    */
-  [[nodiscard]] auto GetCapacity() const -> uint64_t {
-    return transport_.ReadConfigU64(
-        static_cast<uint32_t>(BlkConfigOffset::kCapacity));
+  auto LoadConfig() const -> void {
+    // 先清除标志：读取期间到达的配置变更中断会重新置位
+    config_stale_ = false;
+    bool consistent = false;
+    for (uint32_t retry = 0; retry < kMaxConfigRetries && !consistent;
+         ++retry) {
+      uint32_t generation = transport_.GetConfigGeneration();
+      config_.config = FetchConfig();
+      config_.generation = generation;
+      consistent = transport_.GetConfigGeneration() == generation;
+    }
+    if (!consistent) {
+      config_stale_ = true;
+    }
+    const auto& config = config_.config;
+    config_.discard = MakeRangeLimits(HasFeature<BlkFeatureBit::kDiscard>(),
+                                      config.max_discard_sectors,
+                                      config.max_discard_seg);
+    config_.write_zeroes =
+        MakeRangeLimits(HasFeature<BlkFeatureBit::kWriteZeroes>(),
+                        config.max_write_zeroes_sectors,
+                        config.max_write_zeroes_seg);
   }
 
   /**
-   * @brief 获取协商后的特性位
+   * @brief 获取范围类请求的限制
    *
-   * @return 设备和驱动程序都支持的特性位掩码
+   * 提交路径可能并发执行，直接使用当前快照而不触发刷新。
    */
-  [[nodiscard]] auto GetNegotiatedFeatures() const -> uint64_t {
-    return negotiated_features_;
+  [[nodiscard]] auto GetRangeLimits(ReqType type) const -> RangeLimits {
+    return type == ReqType::kDiscard ? config_.discard : config_.write_zeroes;
   }
 
   /**
-   * @brief 获取性能监控统计数据
+   * @brief 校验并入队一个多段 DISCARD / WRITE_ZEROES 请求
    *
-   * @return 当前统计数据的快照
-   * @see 架构文档 §3
+   * 全部范围作为一个设备只读数据段提交。
+   *
+   * @param type kDiscard 或 kWriteZeroes
+   * @param queue_index 队列索引
+   * @param ranges 扇区范围数组
+   * @param range_count 范围数量
+   * @param token 用户上下文指针
+   * @return 成功返回请求句柄，失败返回错误
    */
-  [[nodiscard]] auto GetStats() const -> VirtioStats { return stats_; }
-
-  /// @name 移动/拷贝控制
-  /// @{
-  VirtioBlk(VirtioBlk&& other) noexcept
-      : transport_(std::move(other.transport_)),
-        vq_(std::move(other.vq_)),
-        negotiated_features_(other.negotiated_features_),
-        stats_(other.stats_),
-        slot_bitmap_(other.slot_bitmap_),
-        old_avail_idx_(other.old_avail_idx_),
-        request_completed_(other.request_completed_) {
-    CopySlots(other);
-    other.slot_bitmap_ = 0;
-  }
-  auto operator=(VirtioBlk&& other) noexcept -> VirtioBlk& {
-    if (this != &other) {
-      transport_ = std::move(other.transport_);
-      vq_ = std::move(other.vq_);
-      negotiated_features_ = other.negotiated_features_;
-      stats_ = other.stats_;
-      slot_bitmap_ = other.slot_bitmap_;
-      old_avail_idx_ = other.old_avail_idx_;
-      request_completed_ = other.request_completed_;
-      CopySlots(other);
-      other.slot_bitmap_ = 0;
+  [[nodiscard]] auto EnqueueRanges(ReqType type, uint16_t queue_index,
+                                   const BlkDiscardWriteZeroes* ranges,
+                                   size_t range_count, UserData token)
+      -> Expected<RequestHandle> {
+    auto limits = GetRangeLimits(type);
+    if (limits.max_segments == 0) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
     }
-    return *this;
+    if (ranges == nullptr || range_count == 0 ||
+        range_count > limits.max_segments) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    for (size_t i = 0; i < range_count; ++i) {
+      if (ranges[i].num_sectors > limits.max_sectors) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
+    }
+    IoVec iov{Traits::VirtToPhys(const_cast<BlkDiscardWriteZeroes*>(ranges)),
+              range_count * sizeof(BlkDiscardWriteZeroes)};
+    return DoEnqueue(type, queue_index, 0, &iov, 1, token);
   }
-  VirtioBlk(const VirtioBlk&) = delete;
-  auto operator=(const VirtioBlk&) -> VirtioBlk& = delete;
-  ~VirtioBlk() = default;
-  /// @}
 
- private:
   /**
-   * @brief 异步请求上下文槽
+   * @brief 同步执行覆盖一段连续扇区的 DISCARD / WRITE_ZEROES
    *
-   * 每个 in-flight 请求占用一个槽，存储请求头（DMA可访问）、
-   * 状态字节（设备回写）、用户 token 和描述符链头索引。
-   * 槽的占用状态由 slot_bitmap_ 管理。
-   */
-  struct RequestSlot {
-    /// 请求头（DMA 可访问，设备只读）
-    alignas(16) BlkReqHeader header;
-    /// 状态字节（DMA 可访问，设备只写）
-    alignas(4) volatile uint8_t status;
-    /// 用户自定义上下文指针
-    UserData token;
-    /// 描述符链头索引（用于在 Used Ring 中匹配）
-    uint16_t desc_head;
-  };
-
-  /**
-   * @brief 私有构造函数
+   * 按 max_sectors 拆分范围，每个请求最多携带
+   * min(max_segments, kMaxSyncRanges) 个范围，依次同步提交。范围数组
+   * 复制到请求槽的 DMA 内存中：请求超时返回后设备读取的仍是本请求的范围。
    *
-   * 只能通过 Create() 静态工厂方法创建实例。
+   * @param type kDiscard 或 kWriteZeroes
+   * @param sector 起始扇区号
+   * @param num_sectors 扇区数
+   * @param unmap WRITE_ZEROES 时允许设备 unmap
+   * @return 成功或首个失败请求的错误
    */
-  VirtioBlk(TransportT<Traits> transport, VirtqueueT<Traits> vq,
-            uint64_t features)
-      : transport_(std::move(transport)),
-        vq_(std::move(vq)),
-        negotiated_features_(features),
-        stats_{},
-        slot_bitmap_(0),
-        old_avail_idx_(0),
-        request_completed_(false) {}
+  [[nodiscard]] auto SubmitSyncRanges(ReqType type, uint64_t sector,
+                                      uint64_t num_sectors, bool unmap)
+      -> Expected<void> {
+    auto limits = GetRangeLimits(type);
+    if (limits.max_segments == 0) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+    }
+    size_t max_ranges = limits.max_segments < kMaxSyncRanges
+                            ? limits.max_segments
+                            : kMaxSyncRanges;
+
+    BlkDiscardWriteZeroes ranges[kMaxSyncRanges]{};
+    while (num_sectors > 0) {
+      size_t range_count = 0;
+      while (range_count < max_ranges && num_sectors > 0) {
+        uint32_t count = num_sectors < limits.max_sectors
+                             ? static_cast<uint32_t>(num_sectors)
+                             : limits.max_sectors;
+        auto& range = ranges[range_count++];
+        range.sector = sector;
+        range.num_sectors = count;
+        range.flags.unmap = (type == ReqType::kWriteZeroes && unmap) ? 1 : 0;
+        range.flags.reserved = 0;
+        sector += count;
+        num_sectors -= count;
+      }
+      auto result =
+          SubmitSyncRequest(type, 0, nullptr, 0, ranges, range_count);
+      if (!result) {
+        return result;
+      }
+    }
+    return {};
+  }
 
   /**
-   * @brief 异步入队请求的内部实现
+   * @brief 处理指定队列 Used Ring 中已完成的请求
    *
-   * 分配请求槽，填充请求头，构建 Scatter-Gather 描述符链，提交到 Available
-   * Ring。
+   * 遍历 Used Ring，对每个已完成的请求：
+   * 1. 查找对应的请求槽
+   * 2. 读取设备返回的状态字节
+   * 3. 释放描述符链和请求槽
+   * 4. 恢复等待的协程，或调用回调函数
    *
-   * @param type 请求类型（kIn/kOut）
+   * 先释放再通知，回调或恢复的协程可以立即提交新请求。
+   *
+   * @tparam CompletionCallback void(UserData token, ErrorCode status)
    * @param queue_index 队列索引
-   * @param sector 起始扇区号
-   * @param buffers 数据缓冲区 IoVec 数组
-   * @param buffer_count 缓冲区数量
-   * @param token 用户上下文指针
-   * @return 成功或失败
+   * @param on_complete 完成回调
+   * @param budget 最多处理的 Used Ring 元素数
+   * @return 处理的 Used Ring 元素数
    */
-  [[nodiscard]] auto DoEnqueue(ReqType type, uint16_t queue_index,
-                               uint64_t sector, const IoVec* buffers,
-                               size_t buffer_count, UserData token)
-      -> Expected<void> {
-    if (queue_index != 0) {
-      return std::unexpected(Error{ErrorCode::kInvalidArgument});
-    }
+  template <typename CompletionCallback>
+  auto ProcessCompletions(uint16_t queue_index,
+                          CompletionCallback&& on_complete,
+                          size_t budget = static_cast<size_t>(-1)) -> size_t {
+    auto& queue = queues_[queue_index];
+    auto& vq = *queue.vq;
 
-    if (buffer_count + 2 > kMaxSgElements) {
-      return std::unexpected(Error{ErrorCode::kInvalidArgument});
-    }
+    Traits::Rmb();
 
-    auto slot_result = AllocRequestSlot();
-    if (!slot_result) {
-      stats_.queue_full_errors++;
-      return std::unexpected(slot_result.error());
+    uint64_t now = 0;
+    if constexpr (kTimestamps) {
+      now = static_cast<uint64_t>(Traits::Now());
     }
-    uint16_t slot_idx = *slot_result;
-    auto& slot = slots_[slot_idx];
 
-    slot.header.type = static_cast<uint32_t>(type);
-    slot.header.reserved = 0;
-    slot.header.sector = sector;
-    slot.status = 0xFF;  // sentinel：设备完成后会覆写
-    slot.token = token;
-
-    IoVec readable_iovs[kMaxSgElements];
-    IoVec writable_iovs[kMaxSgElements];
-    size_t readable_count = 0;
-    size_t writable_count = 0;
+    size_t processed = 0;
+    while (processed < budget && vq.HasUsed()) {
+      auto elem_result = vq.PopUsed();
+      if (!elem_result) {
+        break;
+      }
 
-    readable_iovs[readable_count++] = {Traits::VirtToPhys(&slot.header),
-                                       sizeof(BlkReqHeader)};
+      auto elem = *elem_result;
+      auto head = static_cast<uint16_t>(elem.id);
+      ++processed;
+      TracePoint<Traits>(TraceEvent::kUsedPop, queue_index, head, elem.len);
 
-    if (type == ReqType::kIn) {
-      for (size_t i = 0; i < buffer_count; ++i) {
-        writable_iovs[writable_count++] = buffers[i];
+      uint16_t slot_idx = FindSlotByDescHead(queue, head);
+      // 并发提交模式下描述符静态归属请求槽，不经过空闲链表
+      if constexpr (!kConcurrent) {
+        (void)vq.FreeChain(head);
       }
-    } else {
-      for (size_t i = 0; i < buffer_count; ++i) {
-        readable_iovs[readable_count++] = buffers[i];
+      if (slot_idx >= kMaxInflight) {
+        continue;
       }
-    }
 
-    // 状态字节始终为 device-writable
-    writable_iovs[writable_count++] = {
-        Traits::VirtToPhys(
-            const_cast<uint8_t*>(static_cast<volatile uint8_t*>(&slot.status))),
-        sizeof(uint8_t)};
+      auto& slot = queue.slots[slot_idx];
 
-    Traits::Wmb();
+      Traits::Rmb();
+      SyncRequestForCpu(queue, slot_idx);
+
+      // 已取消或超时的请求：调用者已得到通知，设备归还后只释放资源
+      if (slot.canceled) {
+        RecordCompletion(queue, slot, ErrorCode::kCanceled, now);
+        FreeRequestSlot(queue, slot_idx);
+        TracePoint<Traits>(TraceEvent::kComplete, queue_index, head,
+                           static_cast<uint32_t>(ErrorCode::kCanceled));
+        continue;
+      }
 
-    auto chain_result = vq_.SubmitChain(readable_iovs, readable_count,
-                                        writable_iovs, writable_count);
-    if (!chain_result) {
-      FreeRequestSlot(slot_idx);
-      stats_.queue_full_errors++;
-      return std::unexpected(chain_result.error());
+      ErrorCode ec = MapBlkStatus(queue.request_dma[slot_idx].status);
+      UserData token = slot.token;
+      NotifyKind notify = slot.notify;
+      queue.stats.bytes_transferred += elem.len;
+      RecordCompletion(queue, slot, ec, now);
+      FreeRequestSlot(queue, slot_idx);
+
+      TracePoint<Traits>(TraceEvent::kComplete, queue_index, head,
+                         static_cast<uint32_t>(ec));
+      NotifyRequest(token, notify, ec, on_complete);
+    }
+    if constexpr (kTelemetry) {
+      if (processed > 0) {
+        queue.telemetry.completion_batch.Record(processed);
+      }
     }
+    return processed;
+  }
 
-    slot.desc_head = *chain_result;
+  /**
+   * @brief 在队列区域内建立 Virtqueue 与请求槽簿记
+   *
+   * 先清零 Virtqueue 所占的环内存（Resume()/Restore() 复用的内存中
+   * 残留着上一次运行的索引），再构造 Virtqueue 并清空请求槽位图。
+   * 并非 Virtqueue 所需的其余区域内容保持不变。
+   *
+   * @param queue_index 队列索引
+   * @param region 队列区域虚拟地址
+   * @param region_phys 队列区域物理地址
+   * @param queue_size 每个队列的描述符数量
+   * @param event_idx 是否启用 VIRTIO_F_EVENT_IDX
+   * @return Virtqueue 参数无效时返回 false
+   */
+  auto InitQueue(uint16_t queue_index, uint8_t* region, uint64_t region_phys,
+                 uint32_t queue_size, bool event_idx) -> bool {
+    auto& queue = queues_[queue_index];
+    __builtin_memset(region, 0,
+                     VirtqueueT<Traits>::CalcSize(
+                         static_cast<uint16_t>(queue_size), true));
+    queue.vq.emplace(region, region_phys, static_cast<uint16_t>(queue_size),
+                     event_idx);
+    if (!queue.vq->IsValid()) {
+      return false;
+    }
+    size_t table_offset = GetIndirectTableOffset(queue_size);
+    queue.indirect_tables =
+        reinterpret_cast<volatile IndirectDesc*>(region + table_offset);
+    queue.indirect_phys = region_phys + table_offset;
+    queue.slot_map =
+        reinterpret_cast<uint16_t*>(region + GetSlotMapOffset(queue_size));
+    for (uint32_t head = 0; head < queue_size; ++head) {
+      queue.slot_map[head] = kMaxInflight;
+    }
+    queue.slots = reinterpret_cast<RequestSlot*>(
+        region + GetRequestSlotOffset(queue_size));
+    size_t request_offset = GetRequestDmaOffset(queue_size);
+    queue.request_dma = reinterpret_cast<RequestDma*>(region + request_offset);
+    queue.request_dma_phys = region_phys + request_offset;
+    queue.slot_bitmap.Reset(GetUsableSlots(queue_size));
+    queue.old_avail_idx = 0;
+    queue.next_deadline = kNoDeadline;
+    return true;
+  }
 
+  /**
+   * @brief 以已协商的特性重新激活设备并写入全部队列地址
+   *
+   * Resume()/Restore() 的共享实现，调用前各队列须已由 InitQueue() 重建。
+   * 成功后解除静默，恢复各队列的轮询模式，并使配置快照失效。
+   *
+   * @return 成功或失败
+   */
+  [[nodiscard]] auto Rearm() -> Expected<void> {
+    DeviceInitializer<Traits, TransportT<Traits>> initializer(transport_);
+    auto result = initializer.Reinit(
+        negotiated_features_, [this](auto& init) {
+          for (uint16_t i = 0; i < queue_count_; ++i) {
+            auto& vq = *queues_[i].vq;
+            init.RearmQueue(i, vq.DescPhys(), vq.AvailPhys(), vq.UsedPhys(),
+                            vq.Size());
+          }
+        });
+    if (!result) {
+      return result;
+    }
+    for (uint16_t i = 0; i < queue_count_; ++i) {
+      if (queues_[i].polling) {
+        queues_[i].vq->DisableUsedNotify();
+      }
+    }
+    // 复位期间配置可能已改变（如设备因容量变化请求复位）
+    config_stale_ = true;
+    quiesced_ = false;
     return {};
   }
 
   /**
-   * @brief 处理 Used Ring 中已完成的请求
+   * @brief 统计队列中被占用的请求槽数
    *
-   * 遍历 Used Ring，对每个已完成的请求：
-   * 1. 查找对应的请求槽
-   * 2. 读取设备返回的状态字节
-   * 3. 调用回调函数
-   * 4. 释放描述符链和请求槽
+   * @param queue 所属队列
+   * @return 在途请求数
+   */
+  [[nodiscard]] static auto CountInflight(const QueueContext& queue)
+      -> size_t {
+    size_t count = 0;
+    size_t usable = GetUsableSlots(queue.vq->Size());
+    for (size_t idx = 0; idx < usable; ++idx) {
+      if (queue.slot_bitmap.Test(idx)) {
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * @brief 队列中是否有完成时须调用回调的在途请求
+   *
+   * 已取消（回调已送达）的请求与协程、同步等待者的请求不计入。
+   */
+  [[nodiscard]] static auto HasPendingCallbacks(const QueueContext& queue)
+      -> bool {
+    size_t usable = GetUsableSlots(queue.vq->Size());
+    for (size_t idx = 0; idx < usable; ++idx) {
+      const auto& slot = queue.slots[idx];
+      if (queue.slot_bitmap.Test(idx) && !slot.canceled &&
+          slot.notify == NotifyKind::kCallback) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief 以 kCanceled 完成队列中全部在途请求（设备已复位）
+   *
+   * 设备复位后不再访问描述符与数据缓冲区，描述符链不逐个释放，
+   * 由之后重建 Virtqueue 时一并回收。
    *
    * @tparam CompletionCallback void(UserData token, ErrorCode status)
+   * @param queue_index 队列索引
    * @param on_complete 完成回调
+   * @return 取消的请求数
    */
   template <typename CompletionCallback>
-  auto ProcessCompletions(CompletionCallback&& on_complete) -> void {
-    Traits::Rmb();
+  auto CancelInflight(uint16_t queue_index, CompletionCallback&& on_complete)
+      -> size_t {
+    auto& queue = queues_[queue_index];
+    uint64_t now = 0;
+    if constexpr (kTimestamps) {
+      now = static_cast<uint64_t>(Traits::Now());
+    }
 
-    while (vq_.HasUsed()) {
-      auto elem_result = vq_.PopUsed();
-      if (!elem_result) {
-        break;
+    size_t canceled = 0;
+    size_t usable = GetUsableSlots(queue.vq->Size());
+    for (size_t idx = 0; idx < usable; ++idx) {
+      if (!queue.slot_bitmap.Test(idx)) {
+        continue;
       }
+      auto& slot = queue.slots[idx];
+      UserData token = slot.token;
+      NotifyKind notify = slot.notify;
+      bool notified = slot.canceled;
+      uint16_t head = slot.desc_head;
+      RecordCompletion(queue, slot, ErrorCode::kCanceled, now);
+      FreeRequestSlot(queue, static_cast<uint16_t>(idx));
+      // 此前已取消或超时的请求已通知过调用者
+      if (notified) {
+        continue;
+      }
+      ++canceled;
 
-      auto elem = *elem_result;
-      auto head = static_cast<uint16_t>(elem.id);
-
-      uint16_t slot_idx = FindSlotByDescHead(head);
-      if (slot_idx < kMaxInflight) {
-        auto& slot = slots_[slot_idx];
-
-        Traits::Rmb();
+      TracePoint<Traits>(TraceEvent::kComplete, queue_index, head,
+                         static_cast<uint32_t>(ErrorCode::kCanceled));
+      NotifyRequest(token, notify, ErrorCode::kCanceled, on_complete);
+    }
+    queue.stats.requests_canceled += canceled;
+    return canceled;
+  }
 
-        ErrorCode ec = MapBlkStatus(slot.status);
-        on_complete(slot.token, ec);
-        stats_.bytes_transferred += elem.len;
-        FreeRequestSlot(slot_idx);
+  /**
+   * @brief 按请求槽记录的通知方式通知调用者
+   *
+   * 调用前请求槽可能已被释放，因此 token 与通知方式须预先取出。
+   *
+   * @tparam CompletionCallback void(UserData token, ErrorCode status)
+   * @param token 请求的 token
+   * @param notify 请求的通知方式
+   * @param status 完成、取消或超时状态
+   * @param on_complete notify 为 kCallback 时调用的回调
+   */
+  template <typename CompletionCallback>
+  static auto NotifyRequest(UserData token, NotifyKind notify,
+                            ErrorCode status,
+                            CompletionCallback& on_complete) -> void {
+    switch (notify) {
+      case NotifyKind::kAwaiter:
+        static_cast<IoAwaiter*>(token)->Complete(status);
+        break;
+      case NotifyKind::kWaiter: {
+        auto* waiter = static_cast<SyncWaiter*>(token);
+        waiter->done = true;
+        waiter->status = status;
+        break;
       }
-
-      (void)vq_.FreeChain(head);
+      case NotifyKind::kCallback:
+        on_complete(token, status);
+        break;
     }
   }
 
   /**
    * @brief 从请求槽池中分配一个空闲槽（O(1) 位图算法）
    *
-   * 使用 __builtin_ctzll 找到 slot_bitmap_ 中最低的 0 位。
+   * 通过分层位图的摘要字定位未满的叶子字，再找到其中最低的 0 位。
    *
+   * @param queue 所属队列
    * @return 成功返回槽索引，失败返回错误
    */
-  [[nodiscard]] auto AllocRequestSlot() -> Expected<uint16_t> {
-    uint64_t free_bits = ~slot_bitmap_;
-    if (free_bits == 0) {
-      return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
-    }
-    auto idx = static_cast<uint16_t>(__builtin_ctzll(free_bits));
-    if (idx >= kMaxInflight) {
+  [[nodiscard]] static auto AllocRequestSlot(QueueContext& queue)
+      -> Expected<uint16_t> {
+    auto idx = queue.slot_bitmap.Alloc();
+    if (idx == SlotBitmapT::kInvalid) {
       return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
     }
-    slot_bitmap_ |= (uint64_t{1} << idx);
-    return idx;
+    return static_cast<uint16_t>(idx);
   }
 
   /**
    * @brief 释放请求槽
    *
+   * @param queue 所属队列
    * @param idx 槽索引
    */
-  auto FreeRequestSlot(uint16_t idx) -> void {
-    if (idx < kMaxInflight) {
-      slot_bitmap_ &= ~(uint64_t{1} << idx);
+  static auto FreeRequestSlot(QueueContext& queue, uint16_t idx) -> void {
+    queue.slot_bitmap.Free(idx);
+  }
+
+  /**
+   * @brief 递增提交路径上的统计计数（并发提交模式下为原子操作）
+   *
+   * @param counter VirtioStats 中的计数字段
+   */
+  static auto CountSubmitEvent(uint64_t& counter) -> void {
+    if constexpr (kConcurrent) {
+      std::atomic_ref<uint64_t>(counter).fetch_add(1,
+                                                   std::memory_order_relaxed);
+    } else {
+      ++counter;
     }
   }
 
   /**
-   * @brief 根据描述符链头索引查找请求槽
+   * @brief 根据描述符链头索引查找请求槽（O(1) 映射表查询）
    *
+   * 映射表项在槽释放后不清除，查询时通过占用位图和槽内记录的
+   * desc_head 校验，过期或越界的链头返回未找到。
+   *
+   * @param queue 所属队列
    * @param desc_head 描述符链头索引
    * @return 匹配的槽索引，未找到则返回 kMaxInflight
    */
-  [[nodiscard]] auto FindSlotByDescHead(uint16_t desc_head) const -> uint16_t {
-    uint64_t used = slot_bitmap_;
-    while (used != 0) {
-      auto i = static_cast<uint16_t>(__builtin_ctzll(used));
-      if (slots_[i].desc_head == desc_head) {
-        return i;
-      }
-      used &= used - 1;  // clear lowest set bit
+  [[nodiscard]] static auto FindSlotByDescHead(const QueueContext& queue,
+                                               uint16_t desc_head)
+      -> uint16_t {
+    if (desc_head >= queue.vq->Size()) {
+      return kMaxInflight;
+    }
+    uint16_t idx = queue.slot_map[desc_head];
+    if (!queue.slot_bitmap.Test(idx) ||
+        queue.slots[idx].desc_head != desc_head) {
+      return kMaxInflight;
+    }
+    return idx;
+  }
+
+  /**
+   * @brief 解析请求句柄
+   *
+   * @param handle Enqueue*() 返回的句柄
+   * @return 句柄仍指向尚未完成、也未被取消的请求时返回其请求槽，
+   *         否则返回 nullptr
+   */
+  [[nodiscard]] auto ResolveHandle(RequestHandle handle) -> RequestSlot* {
+    if (handle.queue_index >= queue_count_) {
+      return nullptr;
+    }
+    auto& queue = queues_[handle.queue_index];
+    // 可用槽之外的位图位恒为占用，须先排除再取槽
+    if (handle.slot >= GetUsableSlots(queue.vq->Size())) {
+      return nullptr;
+    }
+    auto& slot = queue.slots[handle.slot];
+    if (!queue.slot_bitmap.Test(handle.slot) ||
+        slot.generation != handle.generation || slot.canceled) {
+      return nullptr;
     }
-    return kMaxInflight;
+    return &slot;
   }
 
   /**
@@ -715,37 +2994,50 @@ class VirtioBlk {
   }
 
   /**
-   * @brief 判断是否需要发送通知（处理 wrap-around）
+   * @brief 中断处理后更新队列的通知模式
    *
-   * 基于 virtio 规范中的 vring_need_event 算法：检查 event_idx
-   * 是否落在 (old, new] 区间内（含 uint16_t 回绕处理）。
+   * 启用自适应轮询且本次回收的完成数达到阈值时进入轮询模式，
+   * 否则按常规更新 used_event。
    *
-   * @param event_idx 设备/驱动期望的通知阈值
-   * @param new_idx 当前索引
-   * @param old_idx 上次通知时的索引
-   * @return true 表示需要发送通知
-   * @see virtio-v1.2#2.7.10 Available Buffer Notification Suppression
+   * @param queue_index 队列索引
+   * @param completed 本次中断处理回收的完成数
    */
-  [[nodiscard]] static auto VringNeedEvent(uint16_t event_idx, uint16_t new_idx,
-                                           uint16_t old_idx) -> bool {
-    return static_cast<uint16_t>(new_idx - event_idx - 1) <
-           static_cast<uint16_t>(new_idx - old_idx);
+  auto UpdateNotifyMode(uint16_t queue_index, size_t completed) -> void {
+    auto& queue = queues_[queue_index];
+    if (!queue.polling && poll_threshold_ != 0 &&
+        completed >= poll_threshold_) {
+      queue.polling = true;
+      queue.stats.poll_mode_entries++;
+      queue.vq->DisableUsedNotify();
+      return;
+    }
+    UpdateUsedEvent(queue_index);
   }
 
   /**
    * @brief 更新 avail->used_event 字段
    *
    * 在处理完 Used Ring 后调用，告知设备下次在此索引之后再发送中断。
-   * 仅在协商了 VIRTIO_F_EVENT_IDX 时生效。
+   * 仅在协商了 VIRTIO_F_EVENT_IDX 时生效；轮询模式下保持通知关闭。
    *
+   * @param queue_index 队列索引
    * @see virtio-v1.2#2.7.10 Available Buffer Notification Suppression
    */
-  auto UpdateUsedEvent() -> void {
-    if (vq_.EventIdxEnabled()) {
-      auto* used_event_ptr = vq_.AvailUsedEvent();
-      if (used_event_ptr != nullptr) {
-        *used_event_ptr = vq_.LastUsedIdx();
-        Traits::Wmb();
+  auto UpdateUsedEvent(uint16_t queue_index) -> void {
+    auto& queue = queues_[queue_index];
+    auto& vq = *queue.vq;
+    if (queue.polling) {
+      vq.DisableUsedNotify();
+      return;
+    }
+    if constexpr (kEventIdxMode != FeatureMode::kNever) {
+      if (EventIdxActive(vq)) {
+        auto* used_event_ptr = vq.AvailUsedEvent();
+        if (used_event_ptr != nullptr) {
+          *used_event_ptr = vq.LastUsedIdx();
+          DmaSyncForDevice<Traits>(used_event_ptr, sizeof(uint16_t));
+          Traits::Wmb();
+        }
       }
     }
   }
@@ -755,23 +3047,46 @@ class VirtioBlk {
    *
    * Read()/Write() 的共享实现：入队 → Kick → 轮询等待 → 处理完成 → 返回。
    * 轮询上限由 SpinWaitTraits::kMaxSpinIterations 控制（若 Traits
-   * 未提供则回退默认值）。
+   * 未提供则回退默认值），两次轮询之间调用 YieldCpu()。超时后请求标记为
+   * 已取消，请求槽与描述符在设备归还后才释放。
+   *
+   * 轮询期间回收的其他完成没有回调可交付，因此队列 0 上有待完成的
+   * 回调方式请求时拒绝提交（kDeviceBusy）。
    *
    * @param type 请求类型（kIn/kOut）
    * @param sector 起始扇区号
    * @param buffers 数据缓冲区 IoVec 数组
    * @param buffer_count 缓冲区数量
+   * @param ranges DISCARD / WRITE_ZEROES 的范围数组（复制到请求槽内）
+   * @param range_count ranges 中的范围数
    * @return 成功或失败
    */
-  [[nodiscard]] auto SubmitSyncRequest(ReqType type, uint64_t sector,
-                                       const IoVec* buffers,
-                                       size_t buffer_count) -> Expected<void> {
-    auto enq = DoEnqueue(type, 0, sector, buffers, buffer_count, nullptr);
+  [[nodiscard]] auto SubmitSyncRequest(
+      ReqType type, uint64_t sector, const IoVec* buffers,
+      size_t buffer_count, const BlkDiscardWriteZeroes* ranges = nullptr,
+      size_t range_count = 0) -> Expected<void> {
+    constexpr uint16_t queue_index = 0;
+    auto& queue = queues_[queue_index];
+    auto& vq = *queue.vq;
+    if (HasPendingCallbacks(queue)) {
+      return std::unexpected(Error{ErrorCode::kDeviceBusy});
+    }
+
+    // 结果记录到栈上的等待者，不经过回调
+    SyncWaiter waiter;
+    auto enq = DoEnqueue(type, queue_index, sector, buffers, buffer_count,
+                         &waiter, NotifyKind::kWaiter, ranges, range_count);
     if (!enq) {
       return std::unexpected(enq.error());
     }
 
-    Kick(0);
+    // 同步路径自行轮询 Used Ring，等待期间无需设备发送中断
+    const bool suppress_notify = !queue.polling;
+    if (suppress_notify) {
+      vq.DisableUsedNotify();
+    }
+
+    Kick(queue_index);
 
     constexpr uint32_t spin_limit = [] {
       if constexpr (SpinWaitTraits<Traits>) {
@@ -781,66 +3096,90 @@ class VirtioBlk {
       }
     }();
 
-    for (uint32_t i = 0; i < spin_limit; ++i) {
+    auto ignore = [](UserData, ErrorCode) {};
+    for (uint32_t i = 0; i < spin_limit && !waiter.done; ++i) {
       Traits::Rmb();
-      if (vq_.HasUsed()) {
-        break;
+      if (vq.HasUsed()) {
+        (void)ProcessCompletions(queue_index, ignore);
+      } else {
+        YieldCpu<Traits>();
       }
     }
+    if (suppress_notify) {
+      (void)vq.EnableUsedNotify();
+    }
 
-    if (!vq_.HasUsed()) {
+    if (!waiter.done) {
+      // 设备仍可能访问请求：保留槽与描述符，归还后静默释放
+      queue.slots[enq->slot].canceled = true;
+      ++queue.stats.requests_timed_out;
       Traits::Log("Sync request timeout: sector=%llu",
                   static_cast<unsigned long long>(sector));
       return std::unexpected(Error{ErrorCode::kTimeout});
     }
-
-    ErrorCode result = ErrorCode::kSuccess;
-    bool done = false;
-    ProcessCompletions([&done, &result](UserData, ErrorCode status) {
-      done = true;
-      result = status;
-    });
-    UpdateUsedEvent();
-
-    if (!done) {
-      return std::unexpected(Error{ErrorCode::kTimeout});
-    }
-    if (result != ErrorCode::kSuccess) {
-      return std::unexpected(Error{result});
+    if (waiter.status != ErrorCode::kSuccess) {
+      return std::unexpected(Error{waiter.status});
     }
     return {};
   }
 
   /**
-   * @brief 逐字段复制请求槽（处理 volatile status 字段）
+   * @brief 移动全部队列状态
+   *
+   * 请求槽、请求头与状态字节都位于调用者提供的队列区域内，移动只转移
+   * 指针与少量队列状态，其地址在移动前后不变，在途请求不受影响。
    *
    * @param other 源 VirtioBlk 实例
    */
-  auto CopySlots(const VirtioBlk& other) -> void {
-    for (uint16_t i = 0; i < kMaxInflight; ++i) {
-      slots_[i].header = other.slots_[i].header;
-      slots_[i].status = other.slots_[i].status;
-      slots_[i].token = other.slots_[i].token;
-      slots_[i].desc_head = other.slots_[i].desc_head;
+  auto MoveQueues(VirtioBlk& other) -> void {
+    for (uint16_t q = 0; q < kMaxQueues; ++q) {
+      auto& dst = queues_[q];
+      auto& src = other.queues_[q];
+      if (!dst.vq.has_value() && !src.vq.has_value()) {
+        continue;
+      }
+      dst.vq.reset();
+      if (src.vq.has_value()) {
+        dst.vq.emplace(std::move(*src.vq));
+        src.vq.reset();
+      }
+      dst.slots = src.slots;
+      dst.indirect_tables = src.indirect_tables;
+      dst.indirect_phys = src.indirect_phys;
+      dst.slot_map = src.slot_map;
+      dst.request_dma = src.request_dma;
+      dst.request_dma_phys = src.request_dma_phys;
+      dst.slot_bitmap = src.slot_bitmap;
+      dst.old_avail_idx = src.old_avail_idx;
+      dst.polling = src.polling;
+      dst.next_deadline = src.next_deadline;
+      dst.stats = src.stats;
+      dst.telemetry = src.telemetry;
+      src.slot_bitmap.Reset();
     }
+    other.queue_count_ = 0;
   }
 
   /// 传输层实例
   TransportT<Traits> transport_;
-  /// Virtqueue 实例（当前支持单队列）
-  VirtqueueT<Traits> vq_;
   /// 协商后的特性位掩码
   uint64_t negotiated_features_;
-  /// 性能统计数据
-  VirtioStats stats_;
-  /// 请求槽池（用于跟踪 in-flight 异步请求）
-  RequestSlot slots_[kMaxInflight];
-  /// 请求槽占用位图（bit i = 1 表示 slots_[i] 被占用）
-  uint64_t slot_bitmap_;
-  /// 上次 Kick 时的 avail idx（用于 Event Index 通知抑制）
-  uint16_t old_avail_idx_;
+  /// 请求队列（仅前 queue_count_ 个有效）
+  QueueContext queues_[kMaxQueues];
+  /// 实际使用的队列数
+  uint16_t queue_count_;
+  /// 自适应轮询阈值（0 = 禁用）
+  uint32_t poll_threshold_;
+  /// 新请求的超时时长（Traits::Now() 时基，0 = 不设截止时间）
+  uint64_t request_timeout_;
+  /// 配置空间快照（const 访问器中按需刷新）
+  mutable ConfigSnapshot config_{};
+  /// 配置快照已失效（由配置变更中断设置）
+  mutable volatile bool config_stale_;
   /// 请求完成标志（由简化版 HandleInterrupt 在中断上下文中设置）
   volatile bool request_completed_;
+  /// 已静默（Quiesce() 之后、Resume() 成功之前拒绝新的提交）
+  bool quiesced_;
 };
 
 }  // namespace device_framework::detail::virtio::blk
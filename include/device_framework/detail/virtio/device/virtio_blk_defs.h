@@ -5,6 +5,7 @@
 #ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_BLK_DEFS_H_
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_BLK_DEFS_H_
 
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 
@@ -291,6 +292,125 @@ struct VirtioStats {
   uint64_t interrupts_handled{0};
   /// 队列满导致入队失败的次数
   uint64_t queue_full_errors{0};
+  /// 自适应轮询：从中断模式切换到轮询模式的次数
+  uint64_t poll_mode_entries{0};
+  /// 轮询模式下通过 PollCompletions 回收的完成数
+  uint64_t polled_completions{0};
+  /// 收到的配置变更通知次数
+  uint64_t config_changes{0};
+  /// 被取消的在途请求数（Cancel() 或静默时）
+  uint64_t requests_canceled{0};
+  /// 超过截止时间而被放弃的请求数
+  uint64_t requests_timed_out{0};
+  /// 通过 Resume() 完成的快速恢复次数
+  uint64_t resumes{0};
+};
+
+/**
+ * @brief 以 2 的幂分桶的直方图
+ *
+ * 桶 0 计数值 0，桶 i（i >= 1）计数 [2^(i-1), 2^i) 内的值，
+ * 超出范围的值计入最后一个桶。
+ *
+ * @tparam Buckets 桶数量
+ */
+template <size_t Buckets>
+struct Log2Histogram {
+  static_assert(Buckets >= 2 && Buckets <= 65, "Buckets must be in [2, 65]");
+
+  /// 各桶计数
+  uint64_t buckets[Buckets]{};
+  /// 样本总数
+  uint64_t count{0};
+  /// 样本值之和
+  uint64_t sum{0};
+  /// 最大样本值
+  uint64_t max{0};
+
+  /**
+   * @brief 记录一个样本
+   * @param value 样本值
+   */
+  auto Record(uint64_t value) -> void {
+    auto bucket = static_cast<size_t>(std::bit_width(value));
+    ++buckets[bucket < Buckets ? bucket : Buckets - 1];
+    ++count;
+    sum += value;
+    if (value > max) {
+      max = value;
+    }
+  }
+
+  /**
+   * @brief 估算分位数
+   *
+   * @param permille 分位（千分比，如 990 表示 p99）
+   * @return 该分位所在桶的上界（不超过 max），无样本时返回 0
+   */
+  [[nodiscard]] auto Percentile(uint32_t permille) const -> uint64_t {
+    if (count == 0) {
+      return 0;
+    }
+    uint64_t rank = (count * permille + 999) / 1000;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < Buckets; ++i) {
+      seen += buckets[i];
+      if (seen >= rank && seen != 0) {
+        uint64_t upper = i == 0 ? 0 : (uint64_t{2} << (i - 1)) - 1;
+        return i + 1 == Buckets || upper > max ? max : upper;
+      }
+    }
+    return max;
+  }
+};
+
+/**
+ * @brief 遥测中的请求类别
+ */
+enum class RequestClass : uint8_t {
+  /// 读取（VIRTIO_BLK_T_IN）
+  kRead = 0,
+  /// 写入（VIRTIO_BLK_T_OUT）
+  kWrite = 1,
+  /// 刷新（VIRTIO_BLK_T_FLUSH）
+  kFlush = 2,
+  /// 其余命令（GET_ID、DISCARD、WRITE_ZEROES 等）
+  kOther = 3,
+};
+
+/// 请求类别数量
+static constexpr size_t kRequestClassCount = 4;
+
+/// 延迟直方图桶数（最后一个桶覆盖 >= 2^38 个时间单位）
+static constexpr size_t kLatencyBuckets = 40;
+
+/// 在途深度与批大小直方图桶数（覆盖到 4096）
+static constexpr size_t kDepthBuckets = 14;
+
+/**
+ * @brief 单个请求队列的遥测数据
+ *
+ * 仅当 Traits 满足 TelemetryTraits 时由驱动记录；latency 还要求
+ * Traits 满足 TimestampTraits，单位为 Traits::Now() 的计数单位。
+ * 各数组按 RequestClass 索引。
+ */
+struct VirtioTelemetry {
+  /// 从入队到回收的延迟分布
+  Log2Histogram<kLatencyBuckets> latency[kRequestClassCount];
+  /// 成功入队的请求数
+  uint64_t submitted[kRequestClassCount]{};
+  /// 已回收的请求数
+  uint64_t completed[kRequestClassCount]{};
+  /// 设备返回错误状态的请求数
+  uint64_t errors[kRequestClassCount]{};
+  /// 每次入队后的在途请求数分布
+  Log2Histogram<kDepthBuckets> inflight_depth;
+  /// 每次回收（中断或轮询）处理的完成数分布（不含空回收）
+  Log2Histogram<kDepthBuckets> completion_batch;
+  /// 当前在途请求数
+  uint32_t inflight{0};
+  /// 在途请求数峰值
+  uint32_t max_inflight{0};
 };
 
 }  // namespace device_framework::detail::virtio::blk
@@ -33,29 +33,52 @@ namespace device_framework::detail::virtio::blk {
  * dev.Release();
  * @endcode
  *
+ * 异步接口（SubmitReadBlocks/SubmitWriteBlocks/SubmitFlush）直接入队到
+ * 队列 0，完成结果通过 Poll()/Reap() 取回。
+ * DmaBuffer 重载直接使用句柄中缓存的物理地址构建数据段，
+ * 不调用 Traits::VirtToPhys。
+ * 异步请求以完成记录的索引作为驱动 token，且驱动的请求状态位于
+ * 调用者提供的 DMA 区域内，存在在途异步请求时也可以移动设备对象。
+ *
+ * 协商到 VIRTIO_BLK_F_BLK_SIZE 时以设备报告的 blk_size（如 4K 原生盘）
+ * 作为逻辑块大小，块号按 blk_size 换算为 512 字节扇区号；协商到
+ * VIRTIO_BLK_F_TOPOLOGY 时通过 GetIoHints() 报告物理块与最优 I/O 大小，
+ * 超出单请求上限而拆分的请求在最优 I/O 边界处切分。
+ *
  * @tparam Traits 平台环境特征类型
  * @tparam TransportT 传输层模板（默认 MmioTransport）
  * @tparam VirtqueueT Virtqueue 模板（默认 SplitVirtqueue）
+ * @tparam MaxInflight 每个队列的请求槽数量（见 VirtioBlk）
+ * @tparam Features 编译期特性集（见 VirtioBlk）
  * @see BlockDevice
  * @see VirtioBlk
  */
 template <VirtioTraits Traits = NullVirtioTraits,
           template <class> class TransportT = MmioTransport,
-          template <class> class VirtqueueT = SplitVirtqueue>
+          template <class> class VirtqueueT = SplitVirtqueue,
+          uint16_t MaxInflight = 64,
+          FeatureSetPolicy Features = RuntimeFeatures>
 class VirtioBlkDevice
-    : public BlockDevice<VirtioBlkDevice<Traits, TransportT, VirtqueueT>> {
+    : public BlockDevice<VirtioBlkDevice<Traits, TransportT, VirtqueueT,
+                                         MaxInflight, Features>> {
  public:
   /// 底层驱动类型别名
-  using DriverType = VirtioBlk<Traits, TransportT, VirtqueueT>;
+  using DriverType =
+      VirtioBlk<Traits, TransportT, VirtqueueT, MaxInflight, Features>;
+
+  /// 单次 ReadBlocks/WriteBlocks 调用中同时在途的最大请求数
+  static constexpr size_t kMaxBatchRequests = 16;
 
   /**
    * @brief 创建并初始化 VirtIO 块设备（统一接口版）
    *
-   * 内部委托 VirtioBlk::Create() 完成设备初始化。
+   * 内部委托 VirtioBlk::Create() 完成设备初始化，并自动协商
+   * VIRTIO_BLK_F_SIZE_MAX / VIRTIO_BLK_F_SEG_MAX 以确定多扇区请求的拆分上限，
+   * 协商 VIRTIO_BLK_F_BLK_SIZE / VIRTIO_BLK_F_TOPOLOGY 以获取块大小与拓扑。
    *
    * @param mmio_base MMIO 设备基地址
    * @param vq_dma_buf 预分配的 DMA 缓冲区虚拟地址
-   * @param queue_count 期望的队列数量（当前仅支持 1）
+   * @param queue_count 期望的队列数量（BlockDevice 接口使用队列 0）
    * @param queue_size 每个队列的描述符数量（2 的幂，默认 128）
    * @param driver_features 额外的驱动特性位
    * @return 成功返回 VirtioBlkDevice 实例，失败返回错误
@@ -65,6 +88,10 @@ class VirtioBlkDevice
                                    uint32_t queue_size = 128,
                                    uint64_t driver_features = 0)
       -> Expected<VirtioBlkDevice> {
+    driver_features |= static_cast<uint64_t>(BlkFeatureBit::kSizeMax) |
+                       static_cast<uint64_t>(BlkFeatureBit::kSegMax) |
+                       static_cast<uint64_t>(BlkFeatureBit::kBlkSize) |
+                       static_cast<uint64_t>(BlkFeatureBit::kTopology);
     auto blk_result = DriverType::Create(mmio_base, vq_dma_buf, queue_count,
                                          queue_size, driver_features);
     if (!blk_result) {
@@ -114,7 +141,7 @@ class VirtioBlkDevice
   /**
    * @brief 读取多个块
    *
-   * 循环调用 VirtioBlk::Read() 逐扇区读取。
+   * 将连续块合并为多扇区请求（见 TransferBlocks()）。
    *
    * @param block_no 起始块号
    * @param buffer 目标缓冲区
@@ -126,23 +153,15 @@ class VirtioBlkDevice
     if (!flags_.CanRead()) {
       return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
     }
-
-    for (size_t i = 0; i < block_count; ++i) {
-      auto result = driver_.Read(block_no + i, buffer.data() + i * kSectorSize);
-      if (!result) {
-        if (i > 0) {
-          return i;
-        }
-        return std::unexpected(result.error());
-      }
-    }
-    return block_count;
+    const std::span<uint8_t> segment = buffer;
+    return TransferBlocks(false, block_no, std::span(&segment, 1),
+                          block_count);
   }
 
   /**
    * @brief 写入多个块
    *
-   * 循环调用 VirtioBlk::Write() 逐扇区写入。
+   * 将连续块合并为多扇区请求（见 TransferBlocks()）。
    *
    * @param block_no 起始块号
    * @param data 待写入数据
@@ -154,28 +173,152 @@ class VirtioBlkDevice
     if (!flags_.CanWrite()) {
       return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
     }
+    const std::span<const uint8_t> segment = data;
+    return TransferBlocks(true, block_no, std::span(&segment, 1), block_count);
+  }
 
-    for (size_t i = 0; i < block_count; ++i) {
-      auto result = driver_.Write(block_no + i, data.data() + i * kSectorSize);
-      if (!result) {
-        if (i > 0) {
-          return i;
-        }
-        return std::unexpected(result.error());
+  /**
+   * @brief 读取多个块到 DMA 缓冲区（使用缓存的物理地址）
+   */
+  auto DoReadBlocksDma(uint64_t block_no, const DmaBuffer& buffer,
+                       size_t block_count) -> Expected<size_t> {
+    if (!flags_.CanRead()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    const std::span<uint8_t> segment = buffer.Data();
+    return TransferBlocks(false, block_no, std::span(&segment, 1),
+                          block_count, buffer.phys);
+  }
+
+  /**
+   * @brief 从 DMA 缓冲区写入多个块（使用缓存的物理地址）
+   */
+  auto DoWriteBlocksDma(uint64_t block_no, const DmaBuffer& data,
+                        size_t block_count) -> Expected<size_t> {
+    if (!flags_.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    const std::span<uint8_t> segment = data.Data();
+    return TransferBlocks(true, block_no, std::span(&segment, 1), block_count,
+                          data.phys);
+  }
+
+  /**
+   * @brief 分散读取：多个缓冲区合并为多扇区请求（见 TransferBlocks()）
+   *
+   * 缓冲区之间物理地址不连续处开始新的数据段，段数与单段长度仍受
+   * seg_max / size_max 限制，通常整个向量只需一个请求。
+   *
+   * @param block_no 起始块号
+   * @param buffers 按块对齐的目标缓冲区列表
+   * @param block_count 总块数
+   * @return 实际读取的块数
+   */
+  auto DoReadBlocksv(uint64_t block_no,
+                     std::span<const std::span<uint8_t>> buffers,
+                     size_t block_count) -> Expected<size_t> {
+    if (!flags_.CanRead()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    return TransferBlocks(false, block_no, buffers, block_count);
+  }
+
+  /**
+   * @brief 聚集写入：多个缓冲区合并为多扇区请求（见 DoReadBlocksv()）
+   *
+   * @param block_no 起始块号
+   * @param data 按块对齐的数据缓冲区列表
+   * @param block_count 总块数
+   * @return 实际写入的块数
+   */
+  auto DoWriteBlocksv(uint64_t block_no,
+                      std::span<const std::span<const uint8_t>> data,
+                      size_t block_count) -> Expected<size_t> {
+    if (!flags_.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    return TransferBlocks(true, block_no, data, block_count);
+  }
+
+  /**
+   * @brief 刷新设备写缓存
+   *
+   * 以异步 FLUSH 请求提交，轮询回收期间照常处理其他异步请求的完成。
+   * 未协商 VIRTIO_BLK_F_FLUSH 时设备为写直通，直接返回成功。
+   *
+   * @return 成功或失败
+   */
+  auto DoFlush() -> Expected<void> {
+    if (!driver_.SupportsFlush()) {
+      return {};
+    }
+    constexpr uint32_t spin_limit = [] {
+      if constexpr (SpinWaitTraits<Traits>) {
+        return static_cast<uint32_t>(Traits::kMaxSpinIterations);
+      } else {
+        return uint32_t{100000000};
+      }
+    }();
+
+    ErrorCode result = ErrorCode::kSuccess;
+    bool done = false;
+    BeginSyncCall();
+    void* flush_token = SyncToken(kFlushTokenIndex);
+    auto enq = driver_.EnqueueFlush(0, flush_token);
+    if (!enq) {
+      return std::unexpected(enq.error());
+    }
+    driver_.Kick(0);
+
+    for (uint32_t spin = 0; spin < spin_limit && !done; ++spin) {
+      Traits::Rmb();
+      driver_.HandleInterrupt(
+          [this, &done, &result, flush_token](void* token, ErrorCode status) {
+            if (CompleteAsyncPart(token, status)) {
+              return;
+            }
+            if (token == flush_token) {
+              done = true;
+              result = status;
+            }
+          });
+      if (!done) {
+        YieldCpu<Traits>();
       }
     }
-    return block_count;
+    if (!done) {
+      // 请求仍在途：之后的完成带有过期代数的 token，被静默丢弃
+      Traits::Log("Flush request timeout");
+      return std::unexpected(Error{ErrorCode::kTimeout});
+    }
+    if (result != ErrorCode::kSuccess) {
+      return std::unexpected(Error{result});
+    }
+    return {};
   }
 
   /**
-   * @brief 获取块大小（扇区大小 = 512 字节）
+   * @brief 获取逻辑块大小
+   *
+   * 协商到 VIRTIO_BLK_F_BLK_SIZE 时为设备报告的 blk_size，否则为 512 字节。
    */
-  auto DoGetBlockSize() const -> size_t { return kSectorSize; }
+  auto DoGetBlockSize() const -> size_t { return block_size_; }
 
   /**
-   * @brief 获取设备总块数（扇区数）
+   * @brief 获取设备总块数（容量扇区数换算为逻辑块数）
+   *
+   * 取自驱动缓存的配置快照，块访问校验不访问设备寄存器。
    */
-  auto DoGetBlockCount() const -> uint64_t { return driver_.GetCapacity(); }
+  auto DoGetBlockCount() const -> uint64_t {
+    return driver_.GetCapacity() / sectors_per_block_;
+  }
+
+  /**
+   * @brief 获取 I/O 提示
+   *
+   * 未协商 VIRTIO_BLK_F_TOPOLOGY 时各字段为 0。
+   */
+  auto DoGetIoHints() const -> BlockIoHints { return io_hints_; }
 
   /**
    * @brief VirtIO 块设备中断处理（简化版）
@@ -197,13 +340,638 @@ class VirtioBlkDevice
    */
   template <typename CompletionCallback>
   auto DoHandleInterrupt(CompletionCallback&& on_complete) -> void {
-    driver_.HandleInterrupt(static_cast<CompletionCallback&&>(on_complete));
+    driver_.HandleInterrupt([this, &on_complete](void* token,
+                                                 ErrorCode status) {
+      // 异步接口提交的请求由 Reap() 返回，同步传输超时遗留的请求直接
+      // 丢弃，均不转发给调用者
+      if (!CompleteAsyncPart(token, status) && !IsSyncToken(token)) {
+        on_complete(token, status);
+      }
+    });
+  }
+
+  /**
+   * @brief 异步读取多个块
+   *
+   * @param block_no 起始块号
+   * @param buffer 目标缓冲区
+   * @param block_count 块数量
+   * @param token 用户 token
+   * @return 提交结果
+   */
+  auto DoSubmitReadBlocks(uint64_t block_no, std::span<uint8_t> buffer,
+                          size_t block_count, void* token) -> Expected<void> {
+    if (!flags_.CanRead()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    const std::span<uint8_t> segment = buffer;
+    return SubmitTransfer(false, block_no, std::span(&segment, 1), block_count,
+                          token);
+  }
+
+  /**
+   * @brief 异步写入多个块
+   *
+   * @param block_no 起始块号
+   * @param data 待写入数据
+   * @param block_count 块数量
+   * @param token 用户 token
+   * @return 提交结果
+   */
+  auto DoSubmitWriteBlocks(uint64_t block_no, std::span<const uint8_t> data,
+                           size_t block_count, void* token) -> Expected<void> {
+    if (!flags_.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    const std::span<const uint8_t> segment = data;
+    return SubmitTransfer(true, block_no, std::span(&segment, 1), block_count,
+                          token);
+  }
+
+  /**
+   * @brief 异步读取多个块到 DMA 缓冲区（使用缓存的物理地址）
+   */
+  auto DoSubmitReadBlocksDma(uint64_t block_no, const DmaBuffer& buffer,
+                             size_t block_count, void* token)
+      -> Expected<void> {
+    if (!flags_.CanRead()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    const std::span<uint8_t> segment = buffer.Data();
+    return SubmitTransfer(false, block_no, std::span(&segment, 1), block_count,
+                          token, buffer.phys);
+  }
+
+  /**
+   * @brief 异步从 DMA 缓冲区写入多个块（使用缓存的物理地址）
+   */
+  auto DoSubmitWriteBlocksDma(uint64_t block_no, const DmaBuffer& data,
+                              size_t block_count, void* token)
+      -> Expected<void> {
+    if (!flags_.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    const std::span<uint8_t> segment = data.Data();
+    return SubmitTransfer(true, block_no, std::span(&segment, 1), block_count,
+                          token, data.phys);
+  }
+
+  /**
+   * @brief 异步 Flush
+   *
+   * 未协商 VIRTIO_BLK_F_FLUSH 时直接记录一个成功的完成结果。
+   *
+   * @param token 用户 token
+   * @return 提交结果
+   */
+  auto DoSubmitFlush(void* token) -> Expected<void> {
+    if (!driver_.SupportsFlush()) {
+      if (!this->PostCompletion(token, ErrorCode::kSuccess, 0)) {
+        return std::unexpected(Error{ErrorCode::kDeviceBusy});
+      }
+      return {};
+    }
+    auto req_result = AllocAsyncRequest(token, 0);
+    if (!req_result) {
+      return std::unexpected(req_result.error());
+    }
+    auto* req = *req_result;
+    auto enq = driver_.EnqueueFlush(0, AsyncToken(req));
+    if (!enq) {
+      req->in_use = false;
+      return std::unexpected(enq.error());
+    }
+    req->parts = 1;
+    ++async_inflight_;
+    driver_.Kick(0);
+    return {};
+  }
+
+  /**
+   * @brief 回收已完成的异步请求
+   *
+   * 轮询 Used Ring，将完成的异步请求记录到 BlockDevice 的完成记录中。
+   */
+  auto DoPollCompletions() -> void {
+    if (async_inflight_ == 0) {
+      return;
+    }
+    driver_.HandleInterrupt(0, [this](void* token, ErrorCode status) {
+      CompleteAsyncPart(token, status);
+    });
   }
 
  private:
+  /// 物理地址未知（由 Traits::VirtToPhys 逐扇区转换）
+  static constexpr uintptr_t kNoPhys = static_cast<uintptr_t>(-1);
+
+  /// 异步请求 token 的起始值：地址空间顶端的值不会是合法的用户 token 指针
+  static constexpr uintptr_t kAsyncTokenBase =
+      static_cast<uintptr_t>(-1) -
+      BlockDevice<VirtioBlkDevice>::kMaxCompletions;
+
+  /// 每次同步传输可用的 token 数：kMaxBatchRequests 个读写请求 + 1 个 FLUSH
+  static constexpr uintptr_t kSyncTokensPerCall = kMaxBatchRequests + 1;
+  /// FLUSH 请求在一次同步调用中的 token 编号
+  static constexpr size_t kFlushTokenIndex = kMaxBatchRequests;
+  /// 同步 token 的代数个数（代数回绕之前，过期请求的 token 不会与新请求重复）
+  static constexpr uintptr_t kSyncGenerations = uintptr_t{1} << 16;
+  /// 同步 token 的起始值（紧邻异步 token 之下，同样不是合法的用户指针）
+  static constexpr uintptr_t kSyncTokenBase =
+      kAsyncTokenBase - kSyncGenerations * kSyncTokensPerCall;
+
+  /**
+   * @brief 批量传输中一个在途请求的完成记录
+   */
+  struct BatchRequest {
+    /// 请求起始块相对于本次传输起点的偏移
+    size_t offset;
+    /// 请求覆盖的块数
+    size_t count;
+    /// 设备返回的完成状态
+    ErrorCode status;
+    /// 记录是否被在途请求占用
+    bool in_use;
+  };
+
+  /**
+   * @brief 一个在途异步请求的完成记录
+   */
+  struct AsyncRequest {
+    /// 用户 token
+    void* token;
+    /// 请求覆盖的块数
+    size_t block_count;
+    /// 尚未完成的驱动请求数（超出单请求上限时拆分）
+    size_t parts;
+    /// 首个失败部分的完成状态
+    ErrorCode status;
+    /// 记录是否被在途请求占用
+    bool in_use;
+  };
+
   /// @brief 只能通过 Create() 工厂方法创建
   explicit VirtioBlkDevice(DriverType driver)
-      : driver_(std::move(driver)), flags_{0} {}
+      : driver_(std::move(driver)), flags_{0} {
+    auto features = driver_.GetNegotiatedFeatures();
+    const auto& config = driver_.ReadConfig();
+    bool size_max_valid =
+        (features & static_cast<uint64_t>(BlkFeatureBit::kSizeMax)) != 0;
+
+    uint32_t reported_block_size =
+        (features & static_cast<uint64_t>(BlkFeatureBit::kBlkSize)) != 0
+            ? config.blk_size
+            : static_cast<uint32_t>(kSectorSize);
+
+    // blk_size 须为不小于扇区的 2 的幂，且单个数据段至少容纳一个块
+    if (reported_block_size >= kSectorSize &&
+        (reported_block_size & (reported_block_size - 1)) == 0 &&
+        (!size_max_valid || config.size_max >= reported_block_size)) {
+      block_size_ = reported_block_size;
+      sectors_per_block_ =
+          static_cast<uint32_t>(reported_block_size / kSectorSize);
+    } else {
+      Traits::Log("Ignoring unsupported blk_size %u", reported_block_size);
+    }
+
+    // 拓扑字段以 blk_size 为单位，块大小回退为 512 字节时不再适用
+    if ((features & static_cast<uint64_t>(BlkFeatureBit::kTopology)) != 0 &&
+        block_size_ == reported_block_size) {
+      io_hints_ = {config.topology.physical_block_exp,
+                   config.topology.alignment_offset,
+                   config.topology.min_io_size, config.topology.opt_io_size};
+    }
+
+    // 根据设备报告的 size_max / seg_max 确定单个请求的拆分上限
+    max_segments_ = driver_.GetMaxSgElements() - 2;
+    if ((features & static_cast<uint64_t>(BlkFeatureBit::kSegMax)) != 0 &&
+        config.seg_max != 0 && config.seg_max < max_segments_) {
+      max_segments_ = config.seg_max;
+    }
+    if (size_max_valid && config.size_max >= block_size_) {
+      max_segment_bytes_ = config.size_max - config.size_max % block_size_;
+    }
+  }
+
+  /**
+   * @brief 多扇区批量传输
+   *
+   * 将物理地址连续的块合并为一个 IoVec（单段不超过 size_max），
+   * 每个请求最多 seg_max 个 IoVec；最多 kMaxBatchRequests 个请求同时在途，
+   * 每轮入队后只 Kick 一次，随后轮询回收完成的请求并继续提交剩余部分。
+   *
+   * @tparam Segment std::span<uint8_t> 或 std::span<const uint8_t>
+   * @param is_write true 为写请求，false 为读请求
+   * @param block_no 起始块号
+   * @param segments 按块对齐的数据缓冲区列表（共 block_count * 块大小
+   *        字节）
+   * @param block_count 块数量
+   * @param phys 单个缓冲区时其物理地址（物理连续）；kNoPhys 表示逐块转换
+   * @return 从起点开始连续成功传输的块数；首个请求即失败时返回错误
+   * @note 请求以带调用代数的同步 token 提交，不指向本栈帧。超时返回后
+   *       仍在途的请求在设备归还时被识别为过期并静默丢弃，不影响之后的
+   *       调用；但设备仍可能读写 segments，调用者应将该缓冲区视为失效
+   */
+  template <typename Segment>
+  auto TransferBlocks(bool is_write, uint64_t block_no,
+                      std::span<const Segment> segments, size_t block_count,
+                      uintptr_t phys = kNoPhys) -> Expected<size_t> {
+    constexpr uint32_t spin_limit = [] {
+      if constexpr (SpinWaitTraits<Traits>) {
+        return static_cast<uint32_t>(Traits::kMaxSpinIterations);
+      } else {
+        return uint32_t{100000000};
+      }
+    }();
+
+    BatchRequest requests[kMaxBatchRequests]{};
+    BeginSyncCall();
+    size_t inflight = 0;
+    size_t submitted = 0;
+    // 首个失败块的偏移（block_count 表示尚无失败）
+    size_t first_error = block_count;
+    ErrorCode error = ErrorCode::kSuccess;
+
+    auto record_error = [&first_error, &error](size_t offset, ErrorCode ec) {
+      if (offset < first_error) {
+        first_error = offset;
+        error = ec;
+      }
+    };
+
+    while (submitted < first_error || inflight > 0) {
+      // 1. 尽可能多地入队请求
+      bool kick = false;
+      while (inflight < kMaxBatchRequests && submitted < block_count &&
+             submitted < first_error) {
+        IoVec iovs[DriverType::kMaxIndirectSgElements];
+        size_t iov_count = 0;
+        size_t count =
+            BuildSegments(segments, phys, block_no, submitted,
+                          block_count - submitted, iovs, iov_count);
+
+        size_t index = 0;
+        while (requests[index].in_use) {
+          ++index;
+        }
+        BatchRequest* req = &requests[index];
+        *req = {submitted, count, ErrorCode::kSuccess, true};
+
+        uint64_t sector = (block_no + submitted) * sectors_per_block_;
+        void* token = SyncToken(index);
+        auto enq =
+            is_write ? driver_.EnqueueWrite(0, sector, iovs, iov_count, token)
+                     : driver_.EnqueueRead(0, sector, iovs, iov_count, token);
+        if (!enq) {
+          req->in_use = false;
+          // 队列已满时先等待在途请求完成，再继续提交
+          if (enq.error().code == ErrorCode::kNoFreeDescriptors &&
+              inflight > 0) {
+            break;
+          }
+          record_error(submitted, enq.error().code);
+          break;
+        }
+        ++inflight;
+        submitted += count;
+        kick = true;
+      }
+
+      if (kick) {
+        driver_.Kick(0);
+      }
+      if (inflight == 0) {
+        break;
+      }
+
+      // 2. 轮询回收已完成的请求
+      size_t reaped = 0;
+      auto reap = [this, &requests, &reaped, &record_error](void* token,
+                                                            ErrorCode status) {
+        if (CompleteAsyncPart(token, status)) {
+          return;
+        }
+        // 此前超时返回的调用遗留的请求带有过期代数，直接丢弃
+        size_t index = SyncTokenIndex(token);
+        if (index >= kMaxBatchRequests || !requests[index].in_use) {
+          return;
+        }
+        BatchRequest& req = requests[index];
+        if (status != ErrorCode::kSuccess) {
+          record_error(req.offset, status);
+        }
+        req.in_use = false;
+        ++reaped;
+      };
+      for (uint32_t spin = 0; spin < spin_limit && reaped == 0; ++spin) {
+        Traits::Rmb();
+        driver_.HandleInterrupt(reap);
+        if (reaped == 0) {
+          YieldCpu<Traits>();
+        }
+      }
+      if (reaped == 0) {
+        Traits::Log("Batch request timeout: block=%llu",
+                    static_cast<unsigned long long>(block_no + submitted));
+        return std::unexpected(Error{ErrorCode::kTimeout});
+      }
+      inflight -= reaped;
+    }
+
+    if (first_error < block_count) {
+      if (first_error == 0) {
+        return std::unexpected(Error{error});
+      }
+      return first_error;
+    }
+    return block_count;
+  }
+
+  /**
+   * @brief 将连续块合并为一个请求的数据段
+   *
+   * 物理地址连续的块合并为一个 IoVec（单段不超过 size_max），
+   * 段数达到 seg_max 时停止；因此被截断的请求尽量在最优 I/O 边界处
+   * 结束，使后续请求从边界开始。已知物理地址时按偏移计算，不调用
+   * Traits::VirtToPhys。
+   *
+   * @param segments 按块对齐的数据缓冲区列表
+   * @param phys_base 单个缓冲区时其物理地址；kNoPhys 表示逐块转换
+   * @param block_no segments 起点对应的块号
+   * @param first 本请求起始块相对于 segments 起点的偏移
+   * @param block_count 剩余块数
+   * @param iovs 输出数据段数组（至少 max_segments_ 项）
+   * @param iov_count 输出数据段数
+   * @return 本请求覆盖的块数
+   */
+  template <typename Segment>
+  auto BuildSegments(std::span<const Segment> segments, uintptr_t phys_base,
+                     uint64_t block_no, size_t first, size_t block_count,
+                     IoVec* iovs, size_t& iov_count) const -> size_t {
+    // 定位起始块所在的缓冲区，之后随块号顺序前进
+    size_t seg = 0;
+    size_t seg_offset = first * block_size_;
+    while (seg < segments.size() && seg_offset >= segments[seg].size()) {
+      seg_offset -= segments[seg].size();
+      ++seg;
+    }
+    size_t count = 0;
+    while (count < block_count) {
+      size_t offset = (first + count) * block_size_;
+      auto phys = phys_base != kNoPhys
+                      ? phys_base + offset
+                      : Traits::VirtToPhys(const_cast<uint8_t*>(
+                            segments[seg].data() + seg_offset));
+      if (iov_count > 0 &&
+          iovs[iov_count - 1].phys_addr + iovs[iov_count - 1].len == phys &&
+          iovs[iov_count - 1].len + block_size_ <= max_segment_bytes_) {
+        iovs[iov_count - 1].len += block_size_;
+      } else if (iov_count < max_segments_) {
+        iovs[iov_count++] = {phys, block_size_};
+      } else {
+        break;
+      }
+      ++count;
+      seg_offset += block_size_;
+      while (seg < segments.size() && seg_offset >= segments[seg].size()) {
+        seg_offset -= segments[seg].size();
+        ++seg;
+      }
+    }
+
+    // 请求被截断时，把结尾回退到最优 I/O 边界（回退后仍须非空）
+    uint64_t end = block_no + first + count;
+    if (count < block_count && io_hints_.opt_io_size > 1 &&
+        end > io_hints_.alignment_offset) {
+      auto excess = static_cast<size_t>((end - io_hints_.alignment_offset) %
+                                        io_hints_.opt_io_size);
+      if (excess < count) {
+        count -= excess;
+        size_t trim = excess * block_size_;
+        while (trim > 0) {
+          auto& tail = iovs[iov_count - 1];
+          if (tail.len > trim) {
+            tail.len -= trim;
+            break;
+          }
+          trim -= tail.len;
+          --iov_count;
+        }
+      }
+    }
+    return count;
+  }
+
+  /**
+   * @brief 检查队列能否容纳一次拆分传输的全部驱动请求
+   *
+   * @param segments 按块对齐的数据缓冲区列表
+   * @param phys 单个缓冲区时其物理地址；kNoPhys 表示逐块转换
+   * @param block_no 起始块号
+   * @param first 首个请求覆盖的块数
+   * @param block_count 总块数
+   * @param first_iovs 首个请求的数据段数
+   */
+  template <typename Segment>
+  auto CanSubmitParts(std::span<const Segment> segments, uintptr_t phys,
+                      uint64_t block_no, size_t first, size_t block_count,
+                      size_t first_iovs) const -> bool {
+    size_t parts = 1;
+    size_t iov_total = first_iovs;
+    for (size_t next = first; next < block_count; ++parts) {
+      IoVec iovs[DriverType::kMaxIndirectSgElements];
+      size_t iov_count = 0;
+      next += BuildSegments(segments, phys, block_no, next, block_count - next,
+                            iovs, iov_count);
+      iov_total += iov_count;
+    }
+    return driver_.CanEnqueue(0, parts, iov_total);
+  }
+
+  /**
+   * @brief 提交一个异步块请求
+   *
+   * 超出单个请求上限时拆分为多个驱动请求，全部以同一条 AsyncRequest
+   * 作为 token；入队后立即 Kick，由事件索引抑制冗余通知。拆分时先检查
+   * 队列能否容纳全部部分，不能时不提交任何部分并返回 kDeviceBusy，
+   * 避免调用者认为请求失败后仍有部分在途。
+   *
+   * @param is_write true 为写请求，false 为读请求
+   * @param block_no 起始块号
+   * @param segments 按块对齐的数据缓冲区列表（见 TransferBlocks()）
+   * @param block_count 块数量
+   * @param token 用户 token
+   * @param phys 单个缓冲区时其物理地址；kNoPhys 表示逐块转换
+   * @return 首个驱动请求即入队失败或队列容纳不下全部部分时返回错误；
+   *         检查之后仍发生的入队失败（并发提交模式下其他生产者占用了
+   *         队列）记录为该请求的完成状态，在已入队的部分完成后报告
+   */
+  template <typename Segment>
+  auto SubmitTransfer(bool is_write, uint64_t block_no,
+                      std::span<const Segment> segments, size_t block_count,
+                      void* token, uintptr_t phys = kNoPhys)
+      -> Expected<void> {
+    IoVec iovs[DriverType::kMaxIndirectSgElements];
+    size_t iov_count = 0;
+    size_t count = BuildSegments(segments, phys, block_no, 0, block_count,
+                                 iovs, iov_count);
+    if (count < block_count &&
+        !CanSubmitParts(segments, phys, block_no, count, block_count,
+                        iov_count)) {
+      return std::unexpected(Error{ErrorCode::kDeviceBusy});
+    }
+
+    auto req_result = AllocAsyncRequest(token, block_count);
+    if (!req_result) {
+      return std::unexpected(req_result.error());
+    }
+    auto* req = *req_result;
+    void* driver_token = AsyncToken(req);
+
+    size_t submitted = 0;
+    while (true) {
+      uint64_t sector = (block_no + submitted) * sectors_per_block_;
+      auto enq =
+          is_write
+              ? driver_.EnqueueWrite(0, sector, iovs, iov_count, driver_token)
+              : driver_.EnqueueRead(0, sector, iovs, iov_count, driver_token);
+      if (!enq) {
+        if (req->parts == 0) {
+          req->in_use = false;
+          return std::unexpected(enq.error());
+        }
+        req->status = enq.error().code;
+        break;
+      }
+      ++req->parts;
+      submitted += count;
+      if (submitted == block_count) {
+        break;
+      }
+      iov_count = 0;
+      count = BuildSegments(segments, phys, block_no, submitted,
+                            block_count - submitted, iovs, iov_count);
+    }
+
+    ++async_inflight_;
+    driver_.Kick(0);
+    return {};
+  }
+
+  /**
+   * @brief 分配一条异步请求完成记录
+   *
+   * 在途异步请求数与未取走的完成记录数之和不超过 kMaxCompletions，
+   * 保证每个完成都能被记录。
+   *
+   * @param token 用户 token
+   * @param block_count 请求覆盖的块数
+   * @return 完成记录（parts 为 0），已满时返回 kDeviceBusy
+   */
+  auto AllocAsyncRequest(void* token, size_t block_count)
+      -> Expected<AsyncRequest*> {
+    if (async_inflight_ + this->PendingCompletions() >=
+        BlockDevice<VirtioBlkDevice>::kMaxCompletions) {
+      return std::unexpected(Error{ErrorCode::kDeviceBusy});
+    }
+    for (auto& r : async_requests_) {
+      if (!r.in_use) {
+        r = {token, block_count, 0, ErrorCode::kSuccess, true};
+        return &r;
+      }
+    }
+    return std::unexpected(Error{ErrorCode::kDeviceBusy});
+  }
+
+  /**
+   * @brief 异步请求的驱动 token（与对象地址无关，移动后仍然有效）
+   *
+   * @param req 完成记录
+   * @return kAsyncTokenBase + 记录索引
+   */
+  [[nodiscard]] auto AsyncToken(const AsyncRequest* req) const -> void* {
+    auto index = static_cast<uintptr_t>(req - async_requests_);
+    return reinterpret_cast<void*>(kAsyncTokenBase + index);
+  }
+
+  /**
+   * @brief 开始一次同步传输：推进代数，使此前调用遗留的请求的 token 过期
+   */
+  auto BeginSyncCall() -> void {
+    sync_generation_ = (sync_generation_ + 1) % kSyncGenerations;
+  }
+
+  /**
+   * @brief 当前同步调用中第 index 个请求的驱动 token
+   *
+   * token 由调用代数与编号组成，不指向调用者栈帧，超时返回后仍在途的
+   * 请求在之后的完成回调中不会被误认为新调用的请求。
+   *
+   * @param index 请求编号（< kSyncTokensPerCall）
+   * @return kSyncTokenBase + 代数 * kSyncTokensPerCall + index
+   */
+  [[nodiscard]] auto SyncToken(size_t index) const -> void* {
+    return reinterpret_cast<void*>(kSyncTokenBase +
+                                   sync_generation_ * kSyncTokensPerCall +
+                                   index);
+  }
+
+  /**
+   * @brief 解析当前同步调用的 token
+   *
+   * @param token 驱动回调传入的 token
+   * @return 请求编号；不是同步 token 或属于此前的调用时返回
+   *         kSyncTokensPerCall
+   */
+  [[nodiscard]] auto SyncTokenIndex(void* token) const -> size_t {
+    auto value = reinterpret_cast<uintptr_t>(token);
+    uintptr_t base = kSyncTokenBase + sync_generation_ * kSyncTokensPerCall;
+    if (value < base || value - base >= kSyncTokensPerCall) {
+      return kSyncTokensPerCall;
+    }
+    return value - base;
+  }
+
+  /**
+   * @brief token 是否为同步传输提交的请求（含此前调用遗留的请求）
+   */
+  [[nodiscard]] static auto IsSyncToken(void* token) -> bool {
+    auto value = reinterpret_cast<uintptr_t>(token);
+    return value >= kSyncTokenBase && value < kAsyncTokenBase;
+  }
+
+  /**
+   * @brief 处理一个驱动请求的完成
+   *
+   * 若 token 属于异步请求，则累计其完成状态；全部拆分部分完成后
+   * 记录到 BlockDevice 的完成记录中。
+   *
+   * @param token 驱动回调传入的 token
+   * @param status 设备返回的完成状态
+   * @return token 属于异步请求返回 true，否则返回 false
+   */
+  auto CompleteAsyncPart(void* token, ErrorCode status) -> bool {
+    auto value = reinterpret_cast<uintptr_t>(token);
+    if (value < kAsyncTokenBase ||
+        value - kAsyncTokenBase >=
+            BlockDevice<VirtioBlkDevice>::kMaxCompletions) {
+      return false;
+    }
+    AsyncRequest* req = &async_requests_[value - kAsyncTokenBase];
+    if (!req->in_use) {
+      return false;
+    }
+    if (status != ErrorCode::kSuccess && req->status == ErrorCode::kSuccess) {
+      req->status = status;
+    }
+    if (--req->parts == 0) {
+      size_t done = req->status == ErrorCode::kSuccess ? req->block_count : 0;
+      this->PostCompletion(req->token, req->status, done);
+      req->in_use = false;
+      --async_inflight_;
+    }
+    return true;
+  }
 
   /// CRTP 基类需要访问 DoXxx 方法
   template <class>
@@ -215,6 +983,22 @@ class VirtioBlkDevice
   DriverType driver_;
   /// 打开标志
   OpenFlags flags_{0};
+  /// 单个请求的最大数据段数（受 seg_max 与驱动 SG 上限约束）
+  size_t max_segments_ = DriverType::kMaxSgElements - 2;
+  /// 单个数据段的最大字节数（受 size_max 约束，按块对齐）
+  size_t max_segment_bytes_ = static_cast<size_t>(-1);
+  /// 逻辑块大小（字节）
+  size_t block_size_ = kSectorSize;
+  /// 每个逻辑块包含的扇区数
+  uint32_t sectors_per_block_ = 1;
+  /// 设备报告的 I/O 提示（以逻辑块为单位）
+  BlockIoHints io_hints_{};
+  /// 异步请求完成记录
+  AsyncRequest async_requests_[BlockDevice<VirtioBlkDevice>::kMaxCompletions]{};
+  /// 在途异步请求数
+  size_t async_inflight_ = 0;
+  /// 同步传输的调用代数（见 SyncToken()）
+  uintptr_t sync_generation_ = 0;
 };
 
 }  // namespace device_framework::detail::virtio::blk
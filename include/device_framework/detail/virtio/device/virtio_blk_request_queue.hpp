@@ -0,0 +1,572 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_BLK_REQUEST_QUEUE_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_BLK_REQUEST_QUEUE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "device_framework/detail/virtio/device/virtio_blk_defs.h"
+#include "device_framework/detail/virtio/virt_queue/misc.hpp"
+#include "device_framework/expected.hpp"
+
+namespace device_framework::detail::virtio::blk {
+
+/**
+ * @brief 请求队列统计
+ */
+struct BlkRequestQueueStats {
+  /// 提交的请求数
+  uint64_t submitted{0};
+  /// 追加到已有请求尾部的次数
+  uint64_t back_merges{0};
+  /// 插入到已有请求头部的次数
+  uint64_t front_merges{0};
+  /// 下发到驱动的请求数
+  uint64_t dispatched{0};
+  /// 因等待超过 FIFO 期限而优先下发的请求数
+  uint64_t expired{0};
+  /// 因衔接处位于最优 I/O 边界而放弃合并的次数
+  uint64_t boundary_splits{0};
+};
+
+/**
+ * @brief VirtioBlk 前端的请求合并与电梯调度队列
+ *
+ * 读写请求先进入本队列，与扇区首尾相接的同类型待发请求合并为一个
+ * 多 IoVec 请求（合并处物理地址连续的数据段进一步合并为一个 IoVec），
+ * 段数不超过驱动 SG 上限与设备 seg_max。Dispatch() 按 C-SCAN 顺序
+ * （从上次下发位置沿扇区号递增，到末尾后回绕）选取请求，等待超过
+ * FIFO 期限的请求优先下发，整批通过 EnqueueBatch() 一次发布并通知设备。
+ * 合并请求完成后，按原始 token 逐一回调。
+ *
+ * 期限以"下发的请求数"计量（不依赖时钟）：请求入队后已有 fifo_expire
+ * 个其他请求先于它下发，即视为到期。
+ *
+ * 设备报告 opt_io_size（VIRTIO_BLK_F_TOPOLOGY）时，衔接处恰好位于最优
+ * I/O 边界的两个请求不合并，合并请求因此不会跨越边界。
+ *
+ * @tparam Driver VirtioBlk 实例化类型
+ * @tparam Depth 可同时排队或在途的原始请求数（1..4096，默认 64）
+ * @warning 同一队列的提交、下发与回收必须在同一执行上下文中串行进行；
+ *          设备本身可能乱序完成请求，重叠扇区的请求之间不保证顺序
+ * @see VirtioBlk
+ */
+template <class Driver, size_t Depth = 64>
+class BlkRequestQueue {
+ public:
+  /// 异步 IO 回调中使用的用户自定义上下文指针类型
+  using UserData = void*;
+
+  /// 可同时排队或在途的原始请求数
+  static constexpr size_t kDepth = Depth;
+  static_assert(kDepth >= 1 && kDepth <= 4096, "Depth must be in [1, 4096]");
+
+  /// 合并请求的最大数据段数（不含请求头和状态字节）
+  static constexpr size_t kMaxSegments = Driver::kMaxIndirectSgElements - 2;
+
+  /// 默认 FIFO 期限（下发的请求数）
+  static constexpr uint32_t kDefaultFifoExpire = 16;
+
+  /**
+   * @brief 构造请求队列
+   *
+   * 根据驱动协商结果与设备报告的 seg_max / size_max 确定合并上限，
+   * 根据 opt_io_size / alignment_offset 确定合并边界。
+   *
+   * @param driver 已初始化的 VirtioBlk 驱动（生命周期长于本队列）
+   * @param queue_index 下发使用的驱动队列索引（< GetQueueCount()）
+   */
+  explicit BlkRequestQueue(Driver& driver, uint16_t queue_index = 0)
+      : driver_(&driver), queue_index_(queue_index) {
+    auto features = driver.GetNegotiatedFeatures();
+    auto config = driver.ReadConfig();
+    max_segments_ = driver.GetMaxSgElements() - 2;
+    if ((features & static_cast<uint64_t>(BlkFeatureBit::kSegMax)) != 0 &&
+        config.seg_max != 0 && config.seg_max < max_segments_) {
+      max_segments_ = config.seg_max;
+    }
+    if ((features & static_cast<uint64_t>(BlkFeatureBit::kSizeMax)) != 0 &&
+        config.size_max >= kSectorSize) {
+      max_segment_bytes_ = config.size_max - config.size_max % kSectorSize;
+    }
+    if ((features & static_cast<uint64_t>(BlkFeatureBit::kTopology)) != 0) {
+      // 拓扑字段以 blk_size 为单位，换算为扇区
+      uint64_t block_sectors =
+          (features & static_cast<uint64_t>(BlkFeatureBit::kBlkSize)) != 0 &&
+                  config.blk_size > kSectorSize
+              ? config.blk_size / kSectorSize
+              : 1;
+      merge_boundary_ = config.topology.opt_io_size * block_sectors;
+      boundary_offset_ = config.topology.alignment_offset * block_sectors;
+    }
+    for (auto& member : members_) {
+      member.next = kNone;
+    }
+  }
+
+  /**
+   * @brief 提交读请求（仅排队，不下发）
+   *
+   * @param sector 起始扇区号（以 512 字节为单位）
+   * @param buffers 数据缓冲区 IoVec 数组（每段长度为扇区大小的整数倍；
+   *        数组本身在返回后即可释放，缓冲区须保持有效直至完成）
+   * @param buffer_count buffers 数组中的元素数量（1..GetMaxSegments()）
+   * @param token 用户自定义上下文指针，完成回调时原样传回
+   * @return 成功或失败；队列已满返回 kDeviceBusy
+   */
+  [[nodiscard]] auto EnqueueRead(uint64_t sector, const IoVec* buffers,
+                                 size_t buffer_count, UserData token = nullptr)
+      -> Expected<void> {
+    return Submit(ReqType::kIn, sector, buffers, buffer_count, token);
+  }
+
+  /**
+   * @brief 提交写请求（仅排队，不下发）
+   *
+   * @param sector 起始扇区号（以 512 字节为单位）
+   * @param buffers 数据缓冲区 IoVec 数组（要求同 EnqueueRead()）
+   * @param buffer_count buffers 数组中的元素数量（1..GetMaxSegments()）
+   * @param token 用户自定义上下文指针，完成回调时原样传回
+   * @return 成功或失败；队列已满返回 kDeviceBusy
+   */
+  [[nodiscard]] auto EnqueueWrite(uint64_t sector, const IoVec* buffers,
+                                  size_t buffer_count, UserData token = nullptr)
+      -> Expected<void> {
+    return Submit(ReqType::kOut, sector, buffers, buffer_count, token);
+  }
+
+  /**
+   * @brief 按调度顺序将排队的请求下发到驱动
+   *
+   * 每批最多 kDispatchBatch 个请求，通过 EnqueueBatch() 一次发布。
+   * 驱动请求槽或描述符耗尽时停止，未下发的请求留在队列中，
+   * 回收完成后可再次调用。
+   *
+   * @return 下发的驱动请求数；一个也未能下发时返回驱动的错误
+   */
+  [[nodiscard]] auto Dispatch() -> Expected<size_t> {
+    size_t total = 0;
+    while (pending_ > 0) {
+      typename Driver::BlkRequest batch[kDispatchBatch];
+      uint32_t picked[kDispatchBatch];
+      size_t count = 0;
+      uint64_t head = head_sector_;
+      while (count < kDispatchBatch && count < pending_) {
+        uint32_t idx = PickNext(head, dispatched_ + count);
+        auto& group = groups_[idx];
+        group.state = GroupState::kInflight;
+        head = group.sector + group.sectors;
+        batch[count] = {group.type, group.sector, group.iovs, group.iov_count,
+                        &group};
+        picked[count++] = idx;
+      }
+
+      auto result = driver_->EnqueueBatch(
+          queue_index_,
+          std::span<const typename Driver::BlkRequest>(batch, count));
+      size_t enqueued = result ? *result : 0;
+      for (size_t i = enqueued; i < count; ++i) {
+        groups_[picked[i]].state = GroupState::kPending;
+      }
+      if (enqueued > 0) {
+        const auto& last = groups_[picked[enqueued - 1]];
+        head_sector_ = last.sector + last.sectors;
+      }
+      pending_ -= enqueued;
+      inflight_ += enqueued;
+      dispatched_ += enqueued;
+      stats_.dispatched += enqueued;
+      total += enqueued;
+      if (enqueued < count) {
+        if (total == 0 && !result) {
+          return std::unexpected(result.error());
+        }
+        break;
+      }
+    }
+    return total;
+  }
+
+  /**
+   * @brief 处理一个驱动完成
+   *
+   * token 属于本队列下发的请求时，对其合并的每个原始请求调用 on_complete。
+   *
+   * @tparam CompletionCallback 签名：void(UserData token, ErrorCode status)
+   * @param token 驱动回调传入的 token
+   * @param status 设备返回的完成状态
+   * @param on_complete 原始请求的完成回调
+   * @return token 属于本队列返回 true，否则返回 false
+   */
+  template <typename CompletionCallback>
+  auto Complete(UserData token, ErrorCode status,
+                CompletionCallback&& on_complete) -> bool {
+    auto addr = reinterpret_cast<uintptr_t>(token);
+    auto base = reinterpret_cast<uintptr_t>(groups_);
+    if (addr < base || addr >= base + sizeof(groups_) ||
+        (addr - base) % sizeof(Group) != 0) {
+      return false;
+    }
+    auto* group = static_cast<Group*>(token);
+    if (group->state != GroupState::kInflight) {
+      return false;
+    }
+    uint32_t member = group->first;
+    while (member != kNone) {
+      auto& m = members_[member];
+      uint32_t next = m.next;
+      m.in_use = false;
+      m.next = kNone;
+      on_complete(m.token, status);
+      member = next;
+    }
+    group->state = GroupState::kFree;
+    --inflight_;
+    return true;
+  }
+
+  /**
+   * @brief 回收驱动队列的完成
+   *
+   * 本队列下发的请求按原始 token 回调；同一驱动队列上绕过本队列直接
+   * 提交的请求原样转发给 on_complete。
+   *
+   * @tparam CompletionCallback 签名：void(UserData token, ErrorCode status)
+   * @param on_complete 完成回调函数
+   */
+  template <typename CompletionCallback>
+  auto HandleInterrupt(CompletionCallback&& on_complete) -> void {
+    driver_->HandleInterrupt(
+        queue_index_, [this, &on_complete](void* token, ErrorCode status) {
+          if (!Complete(token, status, on_complete)) {
+            on_complete(token, status);
+          }
+        });
+  }
+
+  /**
+   * @brief 设置 FIFO 期限
+   *
+   * @param expire 请求入队后最多被其他请求超越的次数（0 表示严格 FIFO）
+   */
+  auto SetFifoExpire(uint32_t expire) -> void { fifo_expire_ = expire; }
+
+  /**
+   * @brief 设置合并边界（覆盖设备报告的最优 I/O 大小）
+   *
+   * @param sectors 边界间隔（扇区数，0 或 1 表示不限制）
+   * @param offset 首个边界的扇区号
+   */
+  auto SetMergeBoundary(uint64_t sectors, uint64_t offset = 0) -> void {
+    merge_boundary_ = sectors;
+    boundary_offset_ = offset;
+  }
+
+  /// @brief 合并边界间隔（扇区数，0 表示不限制）
+  [[nodiscard]] auto GetMergeBoundary() const -> uint64_t {
+    return merge_boundary_;
+  }
+
+  /// @brief 合并请求允许的最大数据段数
+  [[nodiscard]] auto GetMaxSegments() const -> size_t {
+    return max_segments_;
+  }
+
+  /// @brief 排队中（尚未下发）的驱动请求数
+  [[nodiscard]] auto GetPendingCount() const -> size_t { return pending_; }
+
+  /// @brief 已下发且尚未完成的驱动请求数
+  [[nodiscard]] auto GetInflightCount() const -> size_t { return inflight_; }
+
+  /// @brief 获取统计数据
+  [[nodiscard]] auto GetStats() const -> BlkRequestQueueStats {
+    return stats_;
+  }
+
+  /// @name 拷贝/移动控制（驱动 token 指向本对象内部，不可移动）
+  /// @{
+  BlkRequestQueue(const BlkRequestQueue&) = delete;
+  BlkRequestQueue(BlkRequestQueue&&) = delete;
+  auto operator=(const BlkRequestQueue&) -> BlkRequestQueue& = delete;
+  auto operator=(BlkRequestQueue&&) -> BlkRequestQueue& = delete;
+  ~BlkRequestQueue() = default;
+  /// @}
+
+ private:
+  /// 空链表/无效索引
+  static constexpr uint32_t kNone = UINT32_MAX;
+  /// 单次 EnqueueBatch() 的最大请求数
+  static constexpr size_t kDispatchBatch = 16;
+
+  /// 合并请求状态
+  enum class GroupState : uint8_t { kFree, kPending, kInflight };
+
+  /**
+   * @brief 原始请求
+   */
+  struct Member {
+    /// 用户 token
+    UserData token = nullptr;
+    /// 同一合并请求中的下一个原始请求
+    uint32_t next = kNone;
+    /// 是否被占用
+    bool in_use = false;
+  };
+
+  /**
+   * @brief 合并请求（一个驱动请求）
+   */
+  struct Group {
+    /// 请求类型（kIn/kOut）
+    ReqType type = ReqType::kIn;
+    /// 起始扇区号
+    uint64_t sector = 0;
+    /// 扇区数
+    uint64_t sectors = 0;
+    /// 数据段
+    IoVec iovs[kMaxSegments]{};
+    /// 数据段数
+    size_t iov_count = 0;
+    /// 原始请求链表头/尾（Member 索引）
+    uint32_t first = kNone;
+    uint32_t last = kNone;
+    /// 入队时已下发的请求数（FIFO 期限基准）
+    uint64_t arrival = 0;
+    /// 入队序号（FIFO 顺序）
+    uint64_t seq = 0;
+    /// 状态
+    GroupState state = GroupState::kFree;
+  };
+
+  /**
+   * @brief 提交请求：能合并则合并，否则新建合并请求
+   */
+  [[nodiscard]] auto Submit(ReqType type, uint64_t sector,
+                            const IoVec* buffers, size_t buffer_count,
+                            UserData token) -> Expected<void> {
+    if (buffers == nullptr || buffer_count == 0 ||
+        buffer_count > max_segments_) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    uint64_t sectors = 0;
+    for (size_t i = 0; i < buffer_count; ++i) {
+      if (buffers[i].len == 0 || buffers[i].len % kSectorSize != 0) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
+      sectors += buffers[i].len / kSectorSize;
+    }
+
+    uint32_t member = AllocMember();
+    if (member == kNone) {
+      return std::unexpected(Error{ErrorCode::kDeviceBusy});
+    }
+    members_[member].token = token;
+    stats_.submitted++;
+
+    for (auto& group : groups_) {
+      if (group.state != GroupState::kPending || group.type != type) {
+        continue;
+      }
+      bool back = group.sector + group.sectors == sector;
+      bool front = sector + sectors == group.sector;
+      if ((back && OnBoundary(sector)) || (front && OnBoundary(group.sector))) {
+        stats_.boundary_splits++;
+        continue;
+      }
+      if (back && BackMerge(group, buffers, buffer_count)) {
+        group.sectors += sectors;
+        members_[group.last].next = member;
+        group.last = member;
+        stats_.back_merges++;
+        return {};
+      }
+      if (front && FrontMerge(group, buffers, buffer_count)) {
+        group.sector = sector;
+        group.sectors += sectors;
+        members_[member].next = group.first;
+        group.first = member;
+        stats_.front_merges++;
+        return {};
+      }
+    }
+
+    // 原始请求数不超过 kDepth，必有空闲的合并请求
+    for (auto& group : groups_) {
+      if (group.state == GroupState::kFree) {
+        group.type = type;
+        group.sector = sector;
+        group.sectors = sectors;
+        for (size_t i = 0; i < buffer_count; ++i) {
+          group.iovs[i] = buffers[i];
+        }
+        group.iov_count = buffer_count;
+        group.first = member;
+        group.last = member;
+        group.arrival = dispatched_;
+        group.seq = next_seq_++;
+        group.state = GroupState::kPending;
+        ++pending_;
+        break;
+      }
+    }
+    return {};
+  }
+
+  /**
+   * @brief 扇区是否位于合并边界上
+   */
+  [[nodiscard]] auto OnBoundary(uint64_t sector) const -> bool {
+    return merge_boundary_ > 1 && sector >= boundary_offset_ &&
+           (sector - boundary_offset_) % merge_boundary_ == 0;
+  }
+
+  /**
+   * @brief 两个数据段能否合并为一个（物理地址连续且不超过 size_max）
+   */
+  [[nodiscard]] auto Contiguous(const IoVec& front, const IoVec& back) const
+      -> bool {
+    return front.phys_addr + front.len == back.phys_addr &&
+           front.len + back.len <= max_segment_bytes_;
+  }
+
+  /**
+   * @brief 将数据段追加到合并请求尾部
+   *
+   * @return 合并后段数不超过上限返回 true（并完成追加），否则返回 false
+   */
+  auto BackMerge(Group& group, const IoVec* buffers, size_t count) -> bool {
+    bool join = Contiguous(group.iovs[group.iov_count - 1], buffers[0]);
+    if (group.iov_count + count - (join ? 1 : 0) > max_segments_) {
+      return false;
+    }
+    size_t i = 0;
+    if (join) {
+      group.iovs[group.iov_count - 1].len += buffers[0].len;
+      i = 1;
+    }
+    for (; i < count; ++i) {
+      group.iovs[group.iov_count++] = buffers[i];
+    }
+    return true;
+  }
+
+  /**
+   * @brief 将数据段插入到合并请求头部
+   *
+   * @return 合并后段数不超过上限返回 true（并完成插入），否则返回 false
+   */
+  auto FrontMerge(Group& group, const IoVec* buffers, size_t count) -> bool {
+    bool join = Contiguous(buffers[count - 1], group.iovs[0]);
+    size_t added = count - (join ? 1 : 0);
+    if (group.iov_count + added > max_segments_) {
+      return false;
+    }
+    if (join) {
+      group.iovs[0].phys_addr = buffers[count - 1].phys_addr;
+      group.iovs[0].len += buffers[count - 1].len;
+    }
+    for (size_t i = group.iov_count; i > 0; --i) {
+      group.iovs[i - 1 + added] = group.iovs[i - 1];
+    }
+    for (size_t i = 0; i < added; ++i) {
+      group.iovs[i] = buffers[i];
+    }
+    group.iov_count += added;
+    return true;
+  }
+
+  /**
+   * @brief 分配一个原始请求记录
+   *
+   * @return Member 索引，已满返回 kNone
+   */
+  auto AllocMember() -> uint32_t {
+    for (uint32_t i = 0; i < kDepth; ++i) {
+      if (!members_[i].in_use) {
+        members_[i].in_use = true;
+        members_[i].next = kNone;
+        return i;
+      }
+    }
+    return kNone;
+  }
+
+  /**
+   * @brief 选取下一个下发的合并请求（调用者保证至少有一个待发请求）
+   *
+   * 最早入队的请求已到期时优先选取；否则按 C-SCAN 选取扇区号不小于
+   * head 的最小请求，没有则回绕到扇区号最小的请求。
+   *
+   * @param head 上一个下发请求的结束扇区
+   * @param dispatched 截至本次选取已下发的请求数
+   * @return 合并请求索引
+   */
+  auto PickNext(uint64_t head, uint64_t dispatched) -> uint32_t {
+    uint32_t oldest = kNone;
+    uint32_t ahead = kNone;
+    uint32_t lowest = kNone;
+    for (uint32_t i = 0; i < kDepth; ++i) {
+      const auto& group = groups_[i];
+      if (group.state != GroupState::kPending) {
+        continue;
+      }
+      if (oldest == kNone || group.seq < groups_[oldest].seq) {
+        oldest = i;
+      }
+      if (group.sector >= head &&
+          (ahead == kNone || group.sector < groups_[ahead].sector)) {
+        ahead = i;
+      }
+      if (lowest == kNone || group.sector < groups_[lowest].sector) {
+        lowest = i;
+      }
+    }
+    uint32_t next = ahead != kNone ? ahead : lowest;
+    if (next != oldest &&
+        dispatched - groups_[oldest].arrival >= fifo_expire_) {
+      stats_.expired++;
+      return oldest;
+    }
+    return next;
+  }
+
+  /// 底层驱动（不拥有）
+  Driver* driver_;
+  /// 下发使用的驱动队列索引
+  uint16_t queue_index_;
+  /// 合并请求的最大数据段数（受 seg_max 与驱动 SG 上限约束）
+  size_t max_segments_ = Driver::kMaxSgElements - 2;
+  /// 合并后单个数据段的最大字节数（受 size_max 约束，按扇区对齐）
+  size_t max_segment_bytes_ = static_cast<size_t>(-1);
+  /// FIFO 期限（下发的请求数）
+  uint32_t fifo_expire_ = kDefaultFifoExpire;
+  /// 合并边界间隔（扇区数，0 表示不限制）
+  uint64_t merge_boundary_ = 0;
+  /// 首个合并边界的扇区号
+  uint64_t boundary_offset_ = 0;
+  /// 原始请求记录
+  Member members_[kDepth]{};
+  /// 合并请求（每个原始请求至多占用一个）
+  Group groups_[kDepth]{};
+  /// 排队中的合并请求数
+  size_t pending_ = 0;
+  /// 在途的合并请求数
+  size_t inflight_ = 0;
+  /// 累计下发的请求数
+  uint64_t dispatched_ = 0;
+  /// 下一个入队序号
+  uint64_t next_seq_ = 0;
+  /// 上一个下发请求的结束扇区（C-SCAN 位置）
+  uint64_t head_sector_ = 0;
+  /// 统计数据
+  BlkRequestQueueStats stats_{};
+};
+
+}  // namespace device_framework::detail::virtio::blk
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_BLK_REQUEST_QUEUE_HPP_ \
+        */
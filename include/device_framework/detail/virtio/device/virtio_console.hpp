@@ -0,0 +1,1057 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_CONSOLE_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_CONSOLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "device_framework/detail/virtio/defs.h"
+#include "device_framework/detail/virtio/device/device_initializer.hpp"
+#include "device_framework/detail/virtio/device/virtio_console_defs.h"
+#include "device_framework/detail/virtio/traits.hpp"
+#include "device_framework/detail/virtio/transport/mmio.hpp"
+#include "device_framework/detail/virtio/virt_queue/misc.hpp"
+#include "device_framework/detail/virtio/virt_queue/split.hpp"
+#include "device_framework/expected.hpp"
+#include "device_framework/ops/poll_notifier.hpp"
+
+namespace device_framework::detail::virtio::console {
+
+/**
+ * @brief Virtio 控制台设备驱动
+ *
+ * 端口 0 使用队列 0（rx）/ 1（tx）；协商 VIRTIO_CONSOLE_F_MULTIPORT 后
+ * 控制队列位于 2（rx）/ 3（tx），端口 p（p >= 1）使用队列 2p+2 / 2p+3。
+ *
+ * 与逐字节写寄存器的 UART 不同，数据以整块缓冲区经 Virtqueue 传输：
+ * - 发送：Write() 把数据复制到驱动管理的发送缓冲池，每 kTxBufSize 字节
+ *   占用一个描述符，整次调用只发布一批、Kick 一次（Event Index 抑制）；
+ *   返回时数据已入队，调用者缓冲区即可复用。发送完成不产生中断，
+ *   由下一次 Write() 或 HandleInterrupt() 回收
+ * - 接收：Create() 时用接收缓冲池填满每个接收队列，Read() 按需消费，
+ *   缓冲区读空后原地重新投递
+ * - 多端口：控制队列上的 DEVICE_ADD / CONSOLE_PORT / PORT_OPEN 等消息
+ *   在 Create() 与 HandleInterrupt() 中处理
+ *
+ * 不同端口互不共享可变状态；同一端口的读、写各自必须串行，控制消息
+ * 处理（HandleInterrupt()）与 SetPortOpen() 必须串行。
+ *
+ * @tparam Traits 平台环境特征类型
+ * @tparam TransportT 传输层模板（默认 MmioTransport）
+ * @tparam VirtqueueT Virtqueue 模板（默认 SplitVirtqueue）
+ * @tparam MaxPorts 支持的最大端口数（1 表示不协商多端口）
+ * @see virtio-v1.2#5.3 Console Device
+ */
+template <VirtioTraits Traits = NullVirtioTraits,
+          template <class> class TransportT = MmioTransport,
+          template <class> class VirtqueueT = SplitVirtqueue,
+          uint32_t MaxPorts = 4>
+class VirtioConsole {
+ public:
+  static_assert(MaxPorts >= 1 && MaxPorts <= 32,
+                "MaxPorts must be in 1..32");
+
+  /// 每个队列的最大描述符数量
+  static constexpr uint32_t kMaxQueueSize = 256;
+
+  /// 接收缓冲区大小（字节）
+  static constexpr size_t kRxBufSize = 256;
+
+  /// 发送缓冲区大小（字节）：单个描述符携带的最大数据量
+  static constexpr size_t kTxBufSize = 4096;
+
+  /// DMA 布局中每个区域的对齐要求（字节）
+  static constexpr size_t kQueueAlign = 4096;
+
+  /**
+   * @brief 获取相邻端口区域的间距
+   *
+   * 区域内依次为接收 Virtqueue、发送 Virtqueue、描述符链头映射表、
+   * queue_size 个接收缓冲区与 queue_size 个发送缓冲区。
+   *
+   * @param queue_size 每个队列的描述符数量（2 的幂）
+   * @return 单个端口区域按 kQueueAlign 对齐后的字节数
+   */
+  [[nodiscard]] static constexpr auto GetPortStride(uint32_t queue_size)
+      -> size_t {
+    return AlignUp(GetTxPoolOffset(queue_size) + kTxBufSize * queue_size,
+                   kQueueAlign);
+  }
+
+  /**
+   * @brief 计算 DMA 缓冲区所需的字节数
+   *
+   * 端口 p 位于 `p * GetPortStride(queue_size)` 偏移处，控制队列区域
+   * 位于最后（MaxPorts == 1 时不预留）。
+   *
+   * @param queue_size 每个端口队列的描述符数量（2 的幂，默认 16）
+   * @return 所需的 DMA 内存字节数
+   */
+  [[nodiscard]] static constexpr auto CalcDmaSize(uint32_t queue_size = 16)
+      -> size_t {
+    return GetPortStride(queue_size) * MaxPorts +
+           (MaxPorts > 1 ? GetCtrlRegionSize() : 0);
+  }
+
+  /**
+   * @brief 创建并初始化控制台设备
+   *
+   * 内部自动完成：
+   * 1. Transport 初始化和验证
+   * 2. VirtIO 设备初始化序列（重置、特性协商）
+   * 3. 创建各端口与控制队列，并用接收缓冲池填满每个接收队列
+   * 4. 设备激活；多端口模式下发送 DEVICE_READY 并处理设备随后报告的
+   *    端口
+   *
+   * @param mmio_base MMIO 设备基地址
+   * @param vq_dma_buf 预分配的 DMA 缓冲区虚拟地址
+   *        （页对齐，已清零，大小 >= CalcDmaSize()）
+   * @param queue_size 每个端口队列的描述符数量（2 的幂，<= kMaxQueueSize）
+   * @param driver_features 额外的驱动特性位（VERSION_1 自动包含）
+   * @return 成功返回 VirtioConsole 实例，失败返回错误
+   * @see virtio-v1.2#5.3.5 Device Initialization
+   */
+  [[nodiscard]] static auto Create(uint64_t mmio_base, void* vq_dma_buf,
+                                   uint32_t queue_size = 16,
+                                   uint64_t driver_features = 0)
+      -> Expected<VirtioConsole> {
+    if (vq_dma_buf == nullptr || queue_size > kMaxQueueSize ||
+        !IsPowerOfTwo(queue_size)) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+
+    // 1. 创建传输层
+    TransportT<Traits> transport(mmio_base);
+    if (!transport.IsValid()) {
+      return std::unexpected(Error{ErrorCode::kTransportNotInitialized});
+    }
+    if (transport.GetDeviceId() !=
+        static_cast<uint32_t>(DeviceId::kConsole)) {
+      return std::unexpected(Error{ErrorCode::kInvalidDeviceId});
+    }
+    VirtioConsole console(std::move(transport));
+
+    // 2. 设备初始化序列
+    DeviceInitializer<Traits, TransportT<Traits>> initializer(
+        console.transport_);
+
+    uint64_t wanted_features =
+        static_cast<uint64_t>(ReservedFeature::kVersion1) |
+        static_cast<uint64_t>(ReservedFeature::kEventIdx) |
+        static_cast<uint64_t>(ConsoleFeatureBit::kSize) |
+        VirtqueueT<Traits>::kRequiredFeatures | driver_features;
+    if constexpr (MaxPorts > 1) {
+      wanted_features |= static_cast<uint64_t>(ConsoleFeatureBit::kMultiport);
+    }
+    if constexpr (NotificationDataTransport<TransportT<Traits>>) {
+      wanted_features |=
+          static_cast<uint64_t>(ReservedFeature::kNotificationData);
+    }
+    auto negotiated_result = initializer.Init(wanted_features);
+    if (!negotiated_result) {
+      return std::unexpected(negotiated_result.error());
+    }
+    uint64_t negotiated = *negotiated_result;
+    console.negotiated_features_ = negotiated;
+
+    if ((negotiated & static_cast<uint64_t>(ReservedFeature::kVersion1)) == 0) {
+      Traits::Log("Device does not support VERSION_1 (modern mode)");
+      return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
+    }
+    constexpr uint64_t kVqFeatures = VirtqueueT<Traits>::kRequiredFeatures;
+    if ((negotiated & kVqFeatures) != kVqFeatures) {
+      Traits::Log("Device does not support the requested virtqueue format");
+      return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
+    }
+
+    bool event_idx =
+        (negotiated & static_cast<uint64_t>(ReservedFeature::kEventIdx)) != 0;
+    console.notification_data_ =
+        (negotiated &
+         static_cast<uint64_t>(ReservedFeature::kNotificationData)) != 0;
+    console.multiport_ =
+        (negotiated & static_cast<uint64_t>(ConsoleFeatureBit::kMultiport)) !=
+        0;
+
+    // 多端口模式下按设备报告的 max_nr_ports 确定实际端口数
+    uint32_t num_ports = 1;
+    if (console.multiport_) {
+      uint32_t device_ports = console.transport_.ReadConfigU32(
+          static_cast<uint32_t>(ConsoleConfigOffset::kMaxNrPorts));
+      if (device_ports == 0) {
+        device_ports = 1;
+      }
+      num_ports = device_ports < MaxPorts ? device_ports : MaxPorts;
+      Traits::Log("VIRTIO_CONSOLE_F_MULTIPORT negotiated: device=%u, using %u",
+                  device_ports, num_ports);
+    }
+
+    // 3. 创建各端口的收发队列（每个端口占用独立的 DMA 区域）
+    const size_t stride = GetPortStride(queue_size);
+    auto* dma_base = static_cast<uint8_t*>(vq_dma_buf);
+    uint64_t dma_phys = Traits::VirtToPhys(vq_dma_buf);
+    for (uint32_t p = 0; p < num_ports; ++p) {
+      auto& port = console.ports_[p];
+      uint8_t* base = dma_base + p * stride;
+      uint64_t phys = dma_phys + p * stride;
+      port.rx.emplace(base, phys, static_cast<uint16_t>(queue_size),
+                      event_idx);
+      port.tx.emplace(base + GetTxVqOffset(queue_size),
+                      phys + GetTxVqOffset(queue_size),
+                      static_cast<uint16_t>(queue_size), event_idx);
+      if (!port.rx->IsValid() || !port.tx->IsValid()) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
+      port.rx_map =
+          reinterpret_cast<uint16_t*>(base + GetRxMapOffset(queue_size));
+      port.tx_map =
+          reinterpret_cast<uint16_t*>(base + GetTxMapOffset(queue_size));
+      port.rx_pool = base + GetRxPoolOffset(queue_size);
+      port.rx_pool_phys = phys + GetRxPoolOffset(queue_size);
+      port.tx_pool = base + GetTxPoolOffset(queue_size);
+      port.tx_pool_phys = phys + GetTxPoolOffset(queue_size);
+      port.tx_slots.Reset(queue_size);
+
+      auto rx_setup = initializer.SetupQueue(
+          RxQueueIndex(p), port.rx->DescPhys(), port.rx->AvailPhys(),
+          port.rx->UsedPhys(), port.rx->Size());
+      if (!rx_setup) {
+        return std::unexpected(rx_setup.error());
+      }
+      auto tx_setup = initializer.SetupQueue(
+          TxQueueIndex(p), port.tx->DescPhys(), port.tx->AvailPhys(),
+          port.tx->UsedPhys(), port.tx->Size());
+      if (!tx_setup) {
+        return std::unexpected(tx_setup.error());
+      }
+
+      // 发送完成由 Write() / HandleInterrupt() 批量回收，不需要通知
+      port.tx->DisableUsedNotify();
+
+      // 预投递全部接收缓冲区
+      port.rx->BeginBatch();
+      for (uint32_t buf = 0; buf < queue_size; ++buf) {
+        if (!PostRxBuffer(port, static_cast<uint16_t>(buf))) {
+          return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
+        }
+      }
+      port.rx->EndBatch();
+    }
+    console.port_count_ = num_ports;
+
+    // 控制队列位于全部端口区域之后
+    if (console.multiport_) {
+      size_t ctrl_offset = stride * MaxPorts;
+      uint8_t* base = dma_base + ctrl_offset;
+      uint64_t phys = dma_phys + ctrl_offset;
+      console.ctrl_rx_.emplace(base, phys, kCtrlQueueSize, event_idx);
+      console.ctrl_tx_.emplace(base + GetCtrlTxVqOffset(),
+                               phys + GetCtrlTxVqOffset(), kCtrlQueueSize,
+                               event_idx);
+      if (!console.ctrl_rx_->IsValid() || !console.ctrl_tx_->IsValid()) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
+      console.ctrl_dma_ =
+          reinterpret_cast<CtrlDma*>(base + GetCtrlDmaOffset());
+      console.ctrl_dma_phys_ = phys + GetCtrlDmaOffset();
+
+      auto rx_setup = initializer.SetupQueue(
+          kCtrlRxQueueIndex, console.ctrl_rx_->DescPhys(),
+          console.ctrl_rx_->AvailPhys(), console.ctrl_rx_->UsedPhys(),
+          console.ctrl_rx_->Size());
+      if (!rx_setup) {
+        return std::unexpected(rx_setup.error());
+      }
+      auto tx_setup = initializer.SetupQueue(
+          kCtrlTxQueueIndex, console.ctrl_tx_->DescPhys(),
+          console.ctrl_tx_->AvailPhys(), console.ctrl_tx_->UsedPhys(),
+          console.ctrl_tx_->Size());
+      if (!tx_setup) {
+        return std::unexpected(tx_setup.error());
+      }
+      console.ctrl_tx_->DisableUsedNotify();
+
+      console.ctrl_rx_->BeginBatch();
+      for (uint16_t buf = 0; buf < kCtrlQueueSize; ++buf) {
+        if (!console.PostCtrlBuffer(buf)) {
+          return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
+        }
+      }
+      console.ctrl_rx_->EndBatch();
+    } else {
+      // 单端口设备没有控制队列，端口 0 始终存在
+      console.ports_[0].added = true;
+      console.ports_[0].is_console = true;
+      console.ports_[0].host_connected = true;
+    }
+    // 端口队列与已预投递的控制接收缓冲同在 DMA 区域内，激活前一并写回
+    DmaSyncForDevice<Traits>(vq_dma_buf, CalcDmaSize(queue_size));
+
+    // 4. 激活设备
+    auto activate_result = initializer.Activate();
+    if (!activate_result) {
+      return std::unexpected(activate_result.error());
+    }
+    for (uint32_t p = 0; p < num_ports; ++p) {
+      auto& port = console.ports_[p];
+      console.Kick(RxQueueIndex(p), *port.rx, port.rx_old_avail, port.stats);
+    }
+    if (console.multiport_) {
+      ConsoleStats ctrl_stats{};
+      console.Kick(kCtrlRxQueueIndex, *console.ctrl_rx_,
+                   console.ctrl_old_avail_, ctrl_stats);
+      auto ready = console.SendControl(
+          0, ConsoleControlEvent::kDeviceReady, 1);
+      if (!ready) {
+        return std::unexpected(ready.error());
+      }
+      console.ProcessControl();
+    }
+    return console;
+  }
+
+  // ======== 数据收发 ========
+
+  /**
+   * @brief 向端口写入数据
+   *
+   * 数据按 kTxBufSize 切分复制到发送缓冲池，每块一个描述符；整次调用
+   * 只发布一批并最多通知设备一次。发送缓冲池耗尽时先通知设备已入队
+   * 的部分，然后：nonblock 为 true 时返回已入队的字节数（可能为 0），
+   * 否则自旋回收直到有空闲缓冲区。
+   *
+   * @param port_id 端口号（< GetPortCount()，且已由设备添加）
+   * @param data 待写入数据
+   * @param nonblock 缓冲池耗尽时是否立即返回
+   * @return 已入队的字节数；端口无效返回 kInvalidArgument，
+   *         阻塞写入超时且未写入任何数据返回 kTimeout
+   * @see virtio-v1.2#5.3.6 Device Operation
+   */
+  [[nodiscard]] auto Write(uint32_t port_id, std::span<const uint8_t> data,
+                           bool nonblock = false) -> Expected<size_t> {
+    if (!IsPortAdded(port_id)) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    auto& port = ports_[port_id];
+    auto& vq = *port.tx;
+    ReapTx(port);
+
+    size_t written = 0;
+    bool pending = false;
+    bool timed_out = false;
+    vq.BeginBatch();
+    while (written < data.size()) {
+      size_t slot = port.tx_slots.Alloc();
+      if (slot == TxSlotBitmap::kInvalid) {
+        // 先把已入队的缓冲区交给设备，再决定是否等待
+        vq.EndBatch();
+        if (pending) {
+          Kick(TxQueueIndex(port_id), vq, port.tx_old_avail, port.stats);
+          pending = false;
+        }
+        if (nonblock || !WaitTxSlot(port)) {
+          timed_out = !nonblock;
+          break;
+        }
+        vq.BeginBatch();
+        continue;
+      }
+
+      size_t remaining = data.size() - written;
+      size_t chunk = remaining < kTxBufSize ? remaining : kTxBufSize;
+      uint8_t* buf = port.tx_pool + slot * kTxBufSize;
+      __builtin_memcpy(buf, data.data() + written, chunk);
+      DmaSyncForDevice<Traits>(buf, chunk);
+
+      IoVec iov{static_cast<uintptr_t>(port.tx_pool_phys + slot * kTxBufSize),
+                chunk};
+      auto head = vq.SubmitChain(&iov, 1, nullptr, 0);
+      if (!head) {
+        port.tx_slots.Free(slot);
+        break;
+      }
+      port.tx_map[*head] = static_cast<uint16_t>(slot);
+      written += chunk;
+      pending = true;
+      port.stats.tx_bytes += chunk;
+      port.stats.tx_buffers++;
+    }
+    vq.EndBatch();
+    if (pending) {
+      Kick(TxQueueIndex(port_id), vq, port.tx_old_avail, port.stats);
+    }
+
+    if (timed_out && written == 0) {
+      return std::unexpected(Error{ErrorCode::kTimeout});
+    }
+    return written;
+  }
+
+  /**
+   * @brief 从端口读取已到达的数据（不阻塞）
+   *
+   * 依次消费设备已填充的接收缓冲区，读空的缓冲区批量重新投递，
+   * 最多通知设备一次。
+   *
+   * @param port_id 端口号（< GetPortCount()，且已由设备添加）
+   * @param buffer 目标缓冲区
+   * @return 实际读取的字节数（无数据时为 0）；端口无效返回
+   *         kInvalidArgument
+   * @see virtio-v1.2#5.3.6 Device Operation
+   */
+  [[nodiscard]] auto Read(uint32_t port_id, std::span<uint8_t> buffer)
+      -> Expected<size_t> {
+    if (!IsPortAdded(port_id)) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    auto& port = ports_[port_id];
+    auto& vq = *port.rx;
+
+    size_t read = 0;
+    bool reposted = false;
+    vq.BeginBatch();
+    while (read < buffer.size()) {
+      if (!port.rx_pending && !PopRxBuffer(port)) {
+        break;
+      }
+      size_t available = port.rx_len - port.rx_off;
+      size_t wanted = buffer.size() - read;
+      size_t chunk = available < wanted ? available : wanted;
+      __builtin_memcpy(buffer.data() + read,
+                       port.rx_pool + port.rx_buf * kRxBufSize + port.rx_off,
+                       chunk);
+      read += chunk;
+      port.rx_off += static_cast<uint32_t>(chunk);
+      if (port.rx_off == port.rx_len) {
+        port.rx_pending = false;
+        PostRxBuffer(port, port.rx_buf);
+        reposted = true;
+      }
+    }
+    vq.EndBatch();
+    if (reposted) {
+      Kick(RxQueueIndex(port_id), vq, port.rx_old_avail, port.stats);
+    }
+    port.stats.rx_bytes += read;
+    return read;
+  }
+
+  /**
+   * @brief 查询端口就绪状态
+   *
+   * @param port_id 端口号
+   * @return kIn：有未读数据；kOut：发送缓冲池有空闲；
+   *         kHup：端口已被移除或宿主端未连接（仅多端口模式）
+   */
+  [[nodiscard]] auto Readiness(uint32_t port_id) -> PollEvents {
+    if (!IsPortAdded(port_id)) {
+      return PollEvents{PollEvents::kHup};
+    }
+    auto& port = ports_[port_id];
+    ReapTx(port);
+    uint32_t ready = 0;
+    if (port.rx_pending || port.rx->HasUsed()) {
+      ready |= PollEvents::kIn;
+    }
+    // 每个发送缓冲区占用一个描述符，空闲描述符即空闲缓冲区
+    if (port.tx->NumFree() > 0) {
+      ready |= PollEvents::kOut;
+    }
+    if (!port.host_connected) {
+      ready |= PollEvents::kHup;
+    }
+    return PollEvents{ready};
+  }
+
+  // ======== 端口控制 ========
+
+  /**
+   * @brief 通知设备驱动端已打开或关闭端口（VIRTIO_CONSOLE_PORT_OPEN）
+   *
+   * 单端口模式下没有控制队列，直接返回成功。
+   *
+   * @param port_id 端口号
+   * @param open true 表示打开
+   * @return 成功或失败
+   */
+  [[nodiscard]] auto SetPortOpen(uint32_t port_id, bool open)
+      -> Expected<void> {
+    if (!IsPortAdded(port_id)) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    if (!multiport_) {
+      return {};
+    }
+    return SendControl(port_id, ConsoleControlEvent::kPortOpen, open ? 1 : 0);
+  }
+
+  // ======== 中断 ========
+
+  /**
+   * @brief 中断处理
+   *
+   * 确认设备中断，处理控制队列中的端口事件，并回收所有端口已发送
+   * 完成的缓冲区。接收数据留在缓冲区中，由 Read() 读取。
+   */
+  auto HandleInterrupt() -> void {
+    transport_.AcknowledgeInterrupt();
+    if (multiport_) {
+      ProcessControl();
+    }
+    for (uint32_t p = 0; p < port_count_; ++p) {
+      if (ports_[p].added) {
+        ReapTx(ports_[p]);
+      }
+    }
+  }
+
+  // ======== 设备信息 ========
+
+  /**
+   * @brief 检查端口是否已由设备添加
+   */
+  [[nodiscard]] auto IsPortAdded(uint32_t port_id) const -> bool {
+    return port_id < port_count_ && ports_[port_id].added;
+  }
+
+  /**
+   * @brief 检查端口是否为设备指定的控制台端口
+   */
+  [[nodiscard]] auto IsConsolePort(uint32_t port_id) const -> bool {
+    return IsPortAdded(port_id) && ports_[port_id].is_console;
+  }
+
+  /**
+   * @brief 检查宿主端是否已连接端口
+   */
+  [[nodiscard]] auto IsHostConnected(uint32_t port_id) const -> bool {
+    return IsPortAdded(port_id) && ports_[port_id].host_connected;
+  }
+
+  /**
+   * @brief 获取可用的端口数（含尚未由设备添加的端口）
+   */
+  [[nodiscard]] auto GetPortCount() const -> uint32_t { return port_count_; }
+
+  /**
+   * @brief 读取控制台窗口大小
+   *
+   * @return 协商了 VIRTIO_CONSOLE_F_SIZE 时返回配置空间中的 cols/rows，
+   *         否则返回 std::nullopt
+   */
+  [[nodiscard]] auto GetConsoleSize() const -> std::optional<ConsoleSize> {
+    if ((negotiated_features_ &
+         static_cast<uint64_t>(ConsoleFeatureBit::kSize)) == 0) {
+      return std::nullopt;
+    }
+    return ConsoleSize{
+        transport_.ReadConfigU16(
+            static_cast<uint32_t>(ConsoleConfigOffset::kCols)),
+        transport_.ReadConfigU16(
+            static_cast<uint32_t>(ConsoleConfigOffset::kRows))};
+  }
+
+  /**
+   * @brief 获取协商后的特性位
+   */
+  [[nodiscard]] auto GetNegotiatedFeatures() const -> uint64_t {
+    return negotiated_features_;
+  }
+
+  /**
+   * @brief 获取端口统计数据快照
+   */
+  [[nodiscard]] auto GetStats(uint32_t port_id) const -> ConsoleStats {
+    return port_id < port_count_ ? ports_[port_id].stats : ConsoleStats{};
+  }
+
+  /// @name 移动/拷贝控制
+  /// @{
+  VirtioConsole(VirtioConsole&& other) noexcept
+      : transport_(std::move(other.transport_)) {
+    MoveFrom(other);
+  }
+  auto operator=(VirtioConsole&& other) noexcept -> VirtioConsole& {
+    if (this != &other) {
+      transport_ = std::move(other.transport_);
+      MoveFrom(other);
+    }
+    return *this;
+  }
+  VirtioConsole(const VirtioConsole&) = delete;
+  auto operator=(const VirtioConsole&) -> VirtioConsole& = delete;
+  ~VirtioConsole() = default;
+  /// @}
+
+ private:
+  /// 发送缓冲区槽位图类型
+  using TxSlotBitmap = SlotBitmap<kMaxQueueSize>;
+
+  /// 控制队列的描述符数量（也是控制接收缓冲区数量）
+  static constexpr uint16_t kCtrlQueueSize = 16;
+  /// 控制接收缓冲区大小（字节，PORT_NAME 消息超出部分被截断）
+  static constexpr size_t kCtrlBufSize = 64;
+  /// 控制接收队列的传输层索引
+  static constexpr uint16_t kCtrlRxQueueIndex = 2;
+  /// 控制发送队列的传输层索引
+  static constexpr uint16_t kCtrlTxQueueIndex = 3;
+  /// 缓存行大小（非一致性 DMA 平台上设备写入区域按此隔离）
+  static constexpr size_t kDmaLine = DmaCacheLineSize<Traits>();
+
+  /// 等待设备处理的自旋上限
+  static constexpr uint32_t kSpinLimit = [] {
+    if constexpr (SpinWaitTraits<Traits>) {
+      return static_cast<uint32_t>(Traits::kMaxSpinIterations);
+    } else {
+      return uint32_t{100000000};
+    }
+  }();
+
+  /**
+   * @brief 控制队列 DMA 缓冲区
+   *
+   * 设备写入的接收缓冲区与驱动写入的发送消息位于不同缓存行。
+   */
+  struct CtrlDma {
+    ConsoleControl tx_msg;
+    alignas(kDmaLine) uint8_t rx[kCtrlQueueSize][kCtrlBufSize];
+    /// 控制接收描述符链头 → 缓冲区索引（仅 CPU 访问）
+    alignas(kDmaLine) uint16_t rx_map[kCtrlQueueSize];
+  };
+
+  /**
+   * @brief 单个端口的运行状态
+   *
+   * 接收与发送队列互不共享可变状态。
+   */
+  struct Port {
+    /// 接收 Virtqueue
+    std::optional<VirtqueueT<Traits>> rx;
+    /// 发送 Virtqueue
+    std::optional<VirtqueueT<Traits>> tx;
+    /// 接收缓冲池（DMA 内存，queue_size 个 kRxBufSize 字节缓冲区）
+    uint8_t* rx_pool = nullptr;
+    /// rx_pool 的物理地址
+    uint64_t rx_pool_phys = 0;
+    /// 接收描述符链头 → 缓冲区索引（仅 CPU 访问）
+    uint16_t* rx_map = nullptr;
+    /// 发送缓冲池（DMA 内存，queue_size 个 kTxBufSize 字节缓冲区）
+    uint8_t* tx_pool = nullptr;
+    /// tx_pool 的物理地址
+    uint64_t tx_pool_phys = 0;
+    /// 发送描述符链头 → 缓冲区索引（仅 CPU 访问）
+    uint16_t* tx_map = nullptr;
+    /// 发送缓冲区占用位图
+    TxSlotBitmap tx_slots{};
+    /// 正在消费的接收缓冲区索引（rx_pending 为 true 时有效）
+    uint16_t rx_buf = 0;
+    /// 正在消费的接收缓冲区中设备写入的字节数
+    uint32_t rx_len = 0;
+    /// 正在消费的接收缓冲区中已读取的字节数
+    uint32_t rx_off = 0;
+    /// 是否有部分读取的接收缓冲区
+    bool rx_pending = false;
+    /// 上次 Kick 接收队列时的 avail idx
+    uint16_t rx_old_avail = 0;
+    /// 上次 Kick 发送队列时的 avail idx
+    uint16_t tx_old_avail = 0;
+    /// 设备已添加此端口（DEVICE_ADD）
+    bool added = false;
+    /// 设备指定此端口为控制台（CONSOLE_PORT）
+    bool is_console = false;
+    /// 宿主端已连接（PORT_OPEN）
+    bool host_connected = false;
+    /// 统计数据
+    ConsoleStats stats{};
+  };
+
+  /// @name 端口与控制区域内各部分的偏移
+  /// @{
+  [[nodiscard]] static constexpr auto GetVqRegionSize(uint32_t queue_size)
+      -> size_t {
+    // 始终按 event_idx=true 分配，因为特性协商在分配之后
+    return AlignUp(
+        VirtqueueT<Traits>::CalcSize(static_cast<uint16_t>(queue_size), true),
+        kQueueAlign);
+  }
+  [[nodiscard]] static constexpr auto GetTxVqOffset(uint32_t queue_size)
+      -> size_t {
+    return GetVqRegionSize(queue_size);
+  }
+  [[nodiscard]] static constexpr auto GetRxMapOffset(uint32_t queue_size)
+      -> size_t {
+    return 2 * GetVqRegionSize(queue_size);
+  }
+  [[nodiscard]] static constexpr auto GetTxMapOffset(uint32_t queue_size)
+      -> size_t {
+    return GetRxMapOffset(queue_size) + sizeof(uint16_t) * queue_size;
+  }
+  [[nodiscard]] static constexpr auto GetRxPoolOffset(uint32_t queue_size)
+      -> size_t {
+    return AlignUp(GetTxMapOffset(queue_size) + sizeof(uint16_t) * queue_size,
+                   kQueueAlign);
+  }
+  [[nodiscard]] static constexpr auto GetTxPoolOffset(uint32_t queue_size)
+      -> size_t {
+    return AlignUp(GetRxPoolOffset(queue_size) + kRxBufSize * queue_size,
+                   kQueueAlign);
+  }
+  [[nodiscard]] static constexpr auto GetCtrlTxVqOffset() -> size_t {
+    return GetVqRegionSize(kCtrlQueueSize);
+  }
+  [[nodiscard]] static constexpr auto GetCtrlDmaOffset() -> size_t {
+    return 2 * GetVqRegionSize(kCtrlQueueSize);
+  }
+  [[nodiscard]] static constexpr auto GetCtrlRegionSize() -> size_t {
+    return AlignUp(GetCtrlDmaOffset() + sizeof(CtrlDma), kQueueAlign);
+  }
+  /// @}
+
+  /// @brief 端口 p 的接收队列索引
+  [[nodiscard]] static constexpr auto RxQueueIndex(uint32_t port_id)
+      -> uint16_t {
+    return static_cast<uint16_t>(port_id == 0 ? 0 : port_id * 2 + 2);
+  }
+  /// @brief 端口 p 的发送队列索引
+  [[nodiscard]] static constexpr auto TxQueueIndex(uint32_t port_id)
+      -> uint16_t {
+    return static_cast<uint16_t>(RxQueueIndex(port_id) + 1);
+  }
+
+  /**
+   * @brief 私有构造函数
+   *
+   * 只能通过 Create() 静态工厂方法创建实例。
+   */
+  explicit VirtioConsole(TransportT<Traits> transport)
+      : transport_(std::move(transport)) {}
+
+  /**
+   * @brief 把接收缓冲区投递到端口的接收队列
+   *
+   * @param port 端口
+   * @param buf 缓冲区索引
+   * @return 成功返回 true，描述符不足返回 false
+   */
+  static auto PostRxBuffer(Port& port, uint16_t buf) -> bool {
+    IoVec iov{static_cast<uintptr_t>(port.rx_pool_phys + buf * kRxBufSize),
+              kRxBufSize};
+    auto head = port.rx->SubmitChain(nullptr, 0, &iov, 1);
+    if (!head) {
+      return false;
+    }
+    port.rx_map[*head] = buf;
+    return true;
+  }
+
+  /**
+   * @brief 弹出一个已填充的接收缓冲区作为当前读取位置
+   *
+   * 设备写入 0 字节的缓冲区直接重新投递。
+   *
+   * @param port 端口
+   * @return 成功返回 true，Used Ring 为空返回 false
+   */
+  static auto PopRxBuffer(Port& port) -> bool {
+    while (true) {
+      auto used = port.rx->PopUsed();
+      if (!used) {
+        return false;
+      }
+      auto head = static_cast<uint16_t>(used->id);
+      uint16_t buf = port.rx_map[head];
+      uint32_t len = used->len < kRxBufSize ? used->len : kRxBufSize;
+      (void)port.rx->FreeChain(head);
+      if (len == 0) {
+        PostRxBuffer(port, buf);
+        continue;
+      }
+      DmaSyncForCpu<Traits>(port.rx_pool + buf * kRxBufSize, len);
+      port.rx_buf = buf;
+      port.rx_len = len;
+      port.rx_off = 0;
+      port.rx_pending = true;
+      return true;
+    }
+  }
+
+  /**
+   * @brief 回收端口已发送完成的缓冲区
+   *
+   * @param port 端口
+   */
+  static auto ReapTx(Port& port) -> void {
+    while (true) {
+      auto used = port.tx->PopUsed();
+      if (!used) {
+        break;
+      }
+      auto head = static_cast<uint16_t>(used->id);
+      uint16_t slot = port.tx_map[head];
+      (void)port.tx->FreeChain(head);
+      port.tx_slots.Free(slot);
+    }
+  }
+
+  /**
+   * @brief 自旋等待设备释放至少一个发送缓冲区
+   *
+   * @param port 端口
+   * @return 有空闲缓冲区返回 true，超时返回 false
+   */
+  static auto WaitTxSlot(Port& port) -> bool {
+    for (uint32_t i = 0; i < kSpinLimit; ++i) {
+      Traits::Rmb();
+      if (port.tx->HasUsed()) {
+        ReapTx(port);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief 把控制接收缓冲区投递到控制接收队列
+   *
+   * @param buf 缓冲区索引
+   * @return 成功返回 true，描述符不足返回 false
+   */
+  auto PostCtrlBuffer(uint16_t buf) -> bool {
+    IoVec iov{static_cast<uintptr_t>(ctrl_dma_phys_ + offsetof(CtrlDma, rx) +
+                                     buf * kCtrlBufSize),
+              kCtrlBufSize};
+    auto head = ctrl_rx_->SubmitChain(nullptr, 0, &iov, 1);
+    if (!head) {
+      return false;
+    }
+    ctrl_dma_->rx_map[*head] = buf;
+    return true;
+  }
+
+  /**
+   * @brief 处理控制接收队列中的全部消息
+   *
+   * 回复消息（PORT_READY / PORT_OPEN）可能让设备继续投递新消息，
+   * 因此循环到控制接收队列为空为止。缓冲区在处理前复制出消息后
+   * 立即重新投递，避免设备因无缓冲区而丢弃后续消息。
+   *
+   * @see virtio-v1.2#5.3.6.2 Multiport Device Operation
+   */
+  auto ProcessControl() -> void {
+    auto& vq = *ctrl_rx_;
+    ConsoleStats ctrl_stats{};
+    while (true) {
+      auto used = vq.PopUsed();
+      if (!used) {
+        break;
+      }
+      auto head = static_cast<uint16_t>(used->id);
+      uint16_t buf = ctrl_dma_->rx_map[head];
+      (void)vq.FreeChain(head);
+      ConsoleControl msg{};
+      bool valid = used->len >= sizeof(ConsoleControl);
+      if (valid) {
+        DmaSyncForCpu<Traits>(ctrl_dma_->rx[buf], sizeof(ConsoleControl));
+        __builtin_memcpy(&msg, ctrl_dma_->rx[buf], sizeof(ConsoleControl));
+      }
+      PostCtrlBuffer(buf);
+      Kick(kCtrlRxQueueIndex, vq, ctrl_old_avail_, ctrl_stats);
+      if (valid) {
+        HandleControl(msg);
+      }
+    }
+  }
+
+  /**
+   * @brief 处理一条控制消息
+   *
+   * @param msg 设备发送的控制消息
+   */
+  auto HandleControl(const ConsoleControl& msg) -> void {
+    auto event = static_cast<ConsoleControlEvent>(msg.event);
+    if (event == ConsoleControlEvent::kDeviceAdd) {
+      // 超出 MaxPorts 的端口回复未就绪，设备不会再向其投递数据
+      bool usable = msg.id < port_count_;
+      if (usable) {
+        ports_[msg.id].added = true;
+      }
+      (void)SendControl(msg.id, ConsoleControlEvent::kPortReady,
+                        usable ? 1 : 0);
+      return;
+    }
+    if (msg.id >= port_count_) {
+      return;
+    }
+    auto& port = ports_[msg.id];
+    switch (event) {
+      case ConsoleControlEvent::kDeviceRemove:
+        port.added = false;
+        port.host_connected = false;
+        break;
+      case ConsoleControlEvent::kConsolePort:
+        port.is_console = true;
+        // 控制台端口由驱动立即打开
+        (void)SendControl(msg.id, ConsoleControlEvent::kPortOpen, 1);
+        break;
+      case ConsoleControlEvent::kPortOpen:
+        port.host_connected = msg.value != 0;
+        break;
+      default:
+        // RESIZE 通过 GetConsoleSize() 读取，PORT_NAME 不保存
+        break;
+    }
+  }
+
+  /**
+   * @brief 同步发送一条控制消息
+   *
+   * @param port_id 端口号
+   * @param event 事件类型
+   * @param value 事件参数
+   * @return 成功或失败；设备未及时处理返回 kTimeout
+   */
+  [[nodiscard]] auto SendControl(uint32_t port_id, ConsoleControlEvent event,
+                                 uint16_t value) -> Expected<void> {
+    if (!ctrl_tx_.has_value()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+    }
+    ctrl_dma_->tx_msg = {port_id, static_cast<uint16_t>(event), value};
+    DmaSyncForDevice<Traits>(&ctrl_dma_->tx_msg, sizeof(ConsoleControl));
+
+    IoVec readable{
+        static_cast<uintptr_t>(ctrl_dma_phys_ + offsetof(CtrlDma, tx_msg)),
+        sizeof(ConsoleControl)};
+    auto head = ctrl_tx_->SubmitChain(&readable, 1, nullptr, 0);
+    if (!head) {
+      return std::unexpected(head.error());
+    }
+    Traits::Wmb();
+    NotifyVirtqueue(transport_, kCtrlTxQueueIndex, *ctrl_tx_,
+                    notification_data_);
+
+    for (uint32_t i = 0; i < kSpinLimit; ++i) {
+      Traits::Rmb();
+      auto used = ctrl_tx_->PopUsed();
+      if (!used) {
+        continue;
+      }
+      (void)ctrl_tx_->FreeChain(static_cast<uint16_t>(used->id));
+      return {};
+    }
+    return std::unexpected(Error{ErrorCode::kTimeout});
+  }
+
+  /**
+   * @brief 按 Event Index 判断后通知设备，并统计通知与被抑制的通知
+   *
+   * @param queue_index 传输层队列索引
+   * @param vq 对应的 Virtqueue
+   * @param old_avail_idx 上次通知时的 avail idx（更新为当前值）
+   * @param stats 统计数据
+   * @see virtio-v1.2#2.7.10 Available Buffer Notification Suppression
+   */
+  auto Kick(uint16_t queue_index, VirtqueueT<Traits>& vq,
+            uint16_t& old_avail_idx, ConsoleStats& stats) -> void {
+    if (KickVirtqueue<Traits>(transport_, queue_index, vq, old_avail_idx,
+                              notification_data_)) {
+      stats.kicks++;
+    } else {
+      stats.kicks_elided++;
+    }
+  }
+
+  /**
+   * @brief 从另一个实例转移全部队列状态
+   *
+   * 缓冲池与映射表位于调用者提供的 DMA 区域内，移动只转移指针，
+   * 其地址在移动前后不变。
+   *
+   * @param other 源 VirtioConsole 实例
+   */
+  auto MoveFrom(VirtioConsole& other) -> void {
+    negotiated_features_ = other.negotiated_features_;
+    port_count_ = other.port_count_;
+    multiport_ = other.multiport_;
+    notification_data_ = other.notification_data_;
+    for (uint32_t p = 0; p < MaxPorts; ++p) {
+      auto& dst = ports_[p];
+      auto& src = other.ports_[p];
+      dst.rx.reset();
+      dst.tx.reset();
+      if (src.rx.has_value()) {
+        dst.rx.emplace(std::move(*src.rx));
+        src.rx.reset();
+      }
+      if (src.tx.has_value()) {
+        dst.tx.emplace(std::move(*src.tx));
+        src.tx.reset();
+      }
+      dst.rx_pool = src.rx_pool;
+      dst.rx_pool_phys = src.rx_pool_phys;
+      dst.rx_map = src.rx_map;
+      dst.tx_pool = src.tx_pool;
+      dst.tx_pool_phys = src.tx_pool_phys;
+      dst.tx_map = src.tx_map;
+      dst.tx_slots = src.tx_slots;
+      dst.rx_buf = src.rx_buf;
+      dst.rx_len = src.rx_len;
+      dst.rx_off = src.rx_off;
+      dst.rx_pending = src.rx_pending;
+      dst.rx_old_avail = src.rx_old_avail;
+      dst.tx_old_avail = src.tx_old_avail;
+      dst.added = src.added;
+      dst.is_console = src.is_console;
+      dst.host_connected = src.host_connected;
+      dst.stats = src.stats;
+      src.added = false;
+    }
+    ctrl_rx_.reset();
+    ctrl_tx_.reset();
+    if (other.ctrl_rx_.has_value()) {
+      ctrl_rx_.emplace(std::move(*other.ctrl_rx_));
+      other.ctrl_rx_.reset();
+    }
+    if (other.ctrl_tx_.has_value()) {
+      ctrl_tx_.emplace(std::move(*other.ctrl_tx_));
+      other.ctrl_tx_.reset();
+    }
+    ctrl_old_avail_ = other.ctrl_old_avail_;
+    ctrl_dma_ = other.ctrl_dma_;
+    ctrl_dma_phys_ = other.ctrl_dma_phys_;
+    other.port_count_ = 0;
+  }
+
+  /// 传输层实例
+  TransportT<Traits> transport_;
+  /// 协商后的特性位掩码
+  uint64_t negotiated_features_ = 0;
+  /// 端口（仅前 port_count_ 个有效）
+  Port ports_[MaxPorts];
+  /// 可用的端口数
+  uint32_t port_count_ = 0;
+  /// 是否已协商 VIRTIO_CONSOLE_F_MULTIPORT
+  bool multiport_ = false;
+  /// 是否已协商 VIRTIO_F_NOTIFICATION_DATA
+  bool notification_data_ = false;
+  /// 控制接收队列（多端口模式）
+  std::optional<VirtqueueT<Traits>> ctrl_rx_;
+  /// 控制发送队列（多端口模式）
+  std::optional<VirtqueueT<Traits>> ctrl_tx_;
+  /// 上次 Kick 控制接收队列时的 avail idx
+  uint16_t ctrl_old_avail_ = 0;
+  /// 控制队列 DMA 缓冲区
+  CtrlDma* ctrl_dma_ = nullptr;
+  /// ctrl_dma_ 的物理地址
+  uint64_t ctrl_dma_phys_ = 0;
+};
+
+}  // namespace device_framework::detail::virtio::console
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_CONSOLE_HPP_ \
+        */
@@ -0,0 +1,106 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_CONSOLE_DEFS_H_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_CONSOLE_DEFS_H_
+
+#include <cstdint>
+
+namespace device_framework::detail::virtio::console {
+
+/**
+ * @brief 控制台设备特性位定义
+ * @see virtio-v1.2#5.3.3 Feature bits
+ */
+enum class ConsoleFeatureBit : uint64_t {
+  /// 配置空间中 cols/rows 字段有效 (VIRTIO_CONSOLE_F_SIZE)
+  kSize = 1ULL << 0,
+  /// 设备支持多端口与控制队列 (VIRTIO_CONSOLE_F_MULTIPORT)
+  kMultiport = 1ULL << 1,
+  /// 设备支持紧急写入寄存器 (VIRTIO_CONSOLE_F_EMERG_WRITE)
+  kEmergWrite = 1ULL << 2,
+};
+
+/**
+ * @brief 控制台设备配置空间字段偏移量
+ * @see virtio-v1.2#5.3.4 Device configuration layout
+ */
+enum class ConsoleConfigOffset : uint32_t {
+  /// 列数（VIRTIO_CONSOLE_F_SIZE）
+  kCols = 0,
+  /// 行数（VIRTIO_CONSOLE_F_SIZE）
+  kRows = 2,
+  /// 最大端口数（VIRTIO_CONSOLE_F_MULTIPORT）
+  kMaxNrPorts = 4,
+  /// 紧急写入寄存器（VIRTIO_CONSOLE_F_EMERG_WRITE）
+  kEmergWrite = 8,
+};
+
+/**
+ * @brief 控制消息事件类型
+ * @see virtio-v1.2#5.3.6.2 Multiport Device Operation
+ */
+enum class ConsoleControlEvent : uint16_t {
+  /// 驱动已就绪 (VIRTIO_CONSOLE_DEVICE_READY)
+  kDeviceReady = 0,
+  /// 设备新增端口 (VIRTIO_CONSOLE_DEVICE_ADD)
+  kDeviceAdd = 1,
+  /// 设备移除端口 (VIRTIO_CONSOLE_DEVICE_REMOVE)
+  kDeviceRemove = 2,
+  /// 驱动端口就绪 (VIRTIO_CONSOLE_PORT_READY)
+  kPortReady = 3,
+  /// 端口为控制台 (VIRTIO_CONSOLE_CONSOLE_PORT)
+  kConsolePort = 4,
+  /// 控制台窗口大小变化 (VIRTIO_CONSOLE_RESIZE)
+  kResize = 5,
+  /// 端口打开/关闭 (VIRTIO_CONSOLE_PORT_OPEN)
+  kPortOpen = 6,
+  /// 端口名称 (VIRTIO_CONSOLE_PORT_NAME)
+  kPortName = 7,
+};
+
+/**
+ * @brief 控制消息
+ * @see virtio-v1.2#5.3.6.2 Multiport Device Operation
+ *
+ * @note 协议中所有字段采用小端格式；PORT_NAME 消息在此结构之后附带名称
+ */
+struct ConsoleControl {
+  /// 端口号
+  uint32_t id;
+  /// 事件类型 (ConsoleControlEvent)
+  uint16_t event;
+  /// 事件参数
+  uint16_t value;
+} __attribute__((packed));
+
+/**
+ * @brief 控制台窗口大小
+ */
+struct ConsoleSize {
+  /// 列数
+  uint16_t cols;
+  /// 行数
+  uint16_t rows;
+};
+
+/**
+ * @brief 控制台端口统计数据
+ */
+struct ConsoleStats {
+  /// 已读取的字节数
+  uint64_t rx_bytes{0};
+  /// 已提交发送的字节数
+  uint64_t tx_bytes{0};
+  /// 已提交的发送缓冲区数（每个描述符一个）
+  uint64_t tx_buffers{0};
+  /// 实际发出的队列通知次数
+  uint64_t kicks{0};
+  /// 借助 Event Index 省略的 Kick 次数
+  uint64_t kicks_elided{0};
+};
+
+}  // namespace device_framework::detail::virtio::console
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_CONSOLE_DEFS_H_ */
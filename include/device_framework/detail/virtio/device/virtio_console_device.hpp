@@ -0,0 +1,197 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_CONSOLE_DEVICE_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_CONSOLE_DEVICE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "device_framework/detail/virtio/device/virtio_console.hpp"
+#include "device_framework/expected.hpp"
+#include "device_framework/ops/char_device.hpp"
+
+namespace device_framework::detail::virtio::console {
+
+/**
+ * @brief VirtIO 控制台端口字符设备适配器
+ *
+ * 将 VirtioConsole 的一个端口适配到统一的 CharDevice 接口，
+ * Open/Read/Write/Poll 语义与 UartDevice 一致：
+ * - Read 不阻塞，返回已到达的字节数
+ * - Write 默认等待到全部数据入队；以 OpenFlags::kNonBlock 打开时
+ *   发送缓冲池耗尽即返回已入队的字节数
+ *
+ * 不持有驱动：同一 VirtioConsole 的多个端口可分别构造适配器，驱动
+ * 对象的生命周期须覆盖所有适配器。
+ *
+ * 使用示例：
+ * @code
+ * auto console = VirtioConsole<MyTraits>::Create(mmio_base, dma_buf);
+ * VirtioConsoleDevice<MyTraits> tty(*console, 0);
+ * tty.OpenReadWrite();
+ * tty.Write(log_buffer);  // 一个描述符 + 一次 Kick
+ * @endcode
+ *
+ * @tparam Traits 平台环境特征类型
+ * @tparam TransportT 传输层模板（默认 MmioTransport）
+ * @tparam VirtqueueT Virtqueue 模板（默认 SplitVirtqueue）
+ * @tparam MaxPorts 驱动支持的最大端口数（见 VirtioConsole）
+ * @see CharDevice
+ * @see VirtioConsole
+ */
+template <VirtioTraits Traits = NullVirtioTraits,
+          template <class> class TransportT = MmioTransport,
+          template <class> class VirtqueueT = SplitVirtqueue,
+          uint32_t MaxPorts = 4>
+class VirtioConsoleDevice
+    : public CharDevice<
+          VirtioConsoleDevice<Traits, TransportT, VirtqueueT, MaxPorts>> {
+ public:
+  /// 底层驱动类型别名
+  using DriverType = VirtioConsole<Traits, TransportT, VirtqueueT, MaxPorts>;
+
+  /**
+   * @brief 构造端口字符设备
+   *
+   * @param driver 已初始化的控制台驱动
+   * @param port_id 端口号
+   */
+  VirtioConsoleDevice(DriverType& driver, uint32_t port_id)
+      : driver_(&driver), port_id_(port_id) {}
+
+  /// @brief 直接访问底层 VirtioConsole 驱动
+  [[nodiscard]] auto GetDriver() -> DriverType& { return *driver_; }
+  [[nodiscard]] auto GetDriver() const -> const DriverType& {
+    return *driver_;
+  }
+
+  /// @brief 获取端口号
+  [[nodiscard]] auto GetPortId() const -> uint32_t { return port_id_; }
+
+  /// @name 移动/拷贝控制
+  /// @{
+  VirtioConsoleDevice(VirtioConsoleDevice&&) noexcept = default;
+  auto operator=(VirtioConsoleDevice&&) noexcept
+      -> VirtioConsoleDevice& = default;
+  VirtioConsoleDevice(const VirtioConsoleDevice&) = delete;
+  auto operator=(const VirtioConsoleDevice&) -> VirtioConsoleDevice& = delete;
+  ~VirtioConsoleDevice() = default;
+  /// @}
+
+ protected:
+  /**
+   * @brief 打开端口，并通知设备驱动端已就绪（多端口模式）
+   */
+  auto DoOpen(OpenFlags flags) -> Expected<void> {
+    if (!flags.CanRead() && !flags.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    auto result = driver_->SetPortOpen(port_id_, true);
+    if (!result) {
+      return std::unexpected(result.error());
+    }
+    flags_ = flags;
+    return {};
+  }
+
+  /**
+   * @brief 释放端口，并通知设备驱动端已关闭（多端口模式）
+   */
+  auto DoRelease() -> Expected<void> {
+    auto result = driver_->SetPortOpen(port_id_, false);
+    if (!result) {
+      return std::unexpected(result.error());
+    }
+    return {};
+  }
+
+  auto DoCharRead(std::span<uint8_t> buffer) -> Expected<size_t> {
+    if (!flags_.CanRead()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    return driver_->Read(port_id_, buffer);
+  }
+
+  /**
+   * @brief 写入端口
+   *
+   * @return 已入队的字节数
+   */
+  auto DoCharWrite(std::span<const uint8_t> data) -> Expected<size_t> {
+    if (!flags_.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    return driver_->Write(port_id_, data, flags_.IsNonBlock());
+  }
+
+  /**
+   * @brief 查询就绪状态并刷新 GetPollReady() 缓存
+   */
+  auto DoPoll(PollEvents requested) -> Expected<PollEvents> {
+    return this->RefreshPollReady(
+               [this] { return driver_->Readiness(port_id_); }) &
+           requested;
+  }
+
+  /**
+   * @brief 控制台中断处理（简化版）
+   *
+   * 处理控制消息并回收发送缓冲区，接收数据留给 Read() 读取。
+   */
+  auto DoHandleInterrupt() -> void {
+    driver_->HandleInterrupt();
+    this->RefreshPollReady(
+        [this] { return driver_->Readiness(port_id_); });
+  }
+
+  /**
+   * @brief 控制台中断处理（带回调版）
+   *
+   * 处理控制消息后读出本端口全部已到达的数据，对每个字节调用
+   * on_complete 回调，之后向就绪等待者报告当前状态。
+   *
+   * @tparam CompletionCallback 签名：void(uint8_t ch)
+   * @param on_complete 每接收一个字节调用一次的回调函数
+   */
+  template <typename CompletionCallback>
+  auto DoHandleInterrupt(CompletionCallback&& on_complete) -> void {
+    driver_->HandleInterrupt();
+    uint8_t chunk[kRxChunkSize];
+    while (true) {
+      auto count = driver_->Read(port_id_, chunk);
+      if (!count || *count == 0) {
+        break;
+      }
+      for (size_t i = 0; i < *count; ++i) {
+        on_complete(chunk[i]);
+      }
+    }
+    this->RefreshPollReady(
+        [this] { return driver_->Readiness(port_id_); });
+  }
+
+ private:
+  /// @brief CRTP 基类需要访问 DoXxx 方法
+  template <class>
+  friend class ::device_framework::DeviceOperationsBase;
+  template <class>
+  friend class ::device_framework::CharDevice;
+
+  /// 中断处理中每次批量读取的字节数
+  static constexpr size_t kRxChunkSize = 64;
+
+  /// 底层驱动（不持有）
+  DriverType* driver_;
+  /// 端口号
+  uint32_t port_id_;
+  /// 打开标志
+  OpenFlags flags_{0};
+};
+
+}  // namespace device_framework::detail::virtio::console
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_CONSOLE_DEVICE_HPP_ \
+        */
@@ -0,0 +1,775 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_GPU_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_GPU_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "device_framework/defs.h"
+#include "device_framework/detail/virtio/defs.h"
+#include "device_framework/detail/virtio/device/device_initializer.hpp"
+#include "device_framework/detail/virtio/device/virtio_gpu_defs.h"
+#include "device_framework/detail/virtio/traits.hpp"
+#include "device_framework/detail/virtio/transport/mmio.hpp"
+#include "device_framework/detail/virtio/virt_queue/misc.hpp"
+#include "device_framework/detail/virtio/virt_queue/split.hpp"
+#include "device_framework/expected.hpp"
+
+namespace device_framework::detail::virtio::gpu {
+
+/**
+ * @brief Virtio GPU 设备驱动（2D 帧缓冲）
+ *
+ * Create() 在调用者提供的后备存储上创建一个 2D 资源，挂接为扫描输出 0。
+ * 之后调用者直接写后备存储，用 MarkDirty() 标记修改过的区域，
+ * Present() 把脏区域提交到显示端：
+ * - 脏矩形合并：相交或相邻的矩形合并为外接矩形，最多保留
+ *   kMaxDirtyRects 个，超出时并入外接面积增长最小的矩形
+ * - 批量提交：每个脏矩形一条 TRANSFER_TO_HOST_2D，加上对所有脏矩形
+ *   外接矩形的一条 RESOURCE_FLUSH，整批只发布一次、Kick 一次
+ * - 异步完成：Present() 不等待设备处理，已完成的命令在下一次 Present()、
+ *   WaitIdle() 或 HandleInterrupt() 中回收；设备返回的错误响应在随后
+ *   的 Present() / WaitIdle() 中报告一次
+ *
+ * 光标队列（cursorq）未使用，不进行配置。
+ *
+ * @tparam Traits 平台环境特征类型
+ * @tparam TransportT 传输层模板（默认 MmioTransport）
+ * @tparam VirtqueueT Virtqueue 模板（默认 SplitVirtqueue）
+ * @see virtio-v1.2#5.7 GPU Device
+ */
+template <VirtioTraits Traits = NullVirtioTraits,
+          template <class> class TransportT = MmioTransport,
+          template <class> class VirtqueueT = SplitVirtqueue>
+class VirtioGpu {
+ public:
+  /// 单帧最多保留的脏矩形数
+  static constexpr size_t kMaxDirtyRects = 8;
+
+  /// 控制队列的最大描述符数量
+  static constexpr uint32_t kMaxQueueSize = 256;
+
+  /// 控制队列的最小描述符数量（一帧的全部命令必须能同时在途）
+  static constexpr uint32_t kMinQueueSize = 32;
+
+  /// 帧缓冲每像素字节数
+  static constexpr uint32_t kBytesPerPixel = 4;
+
+  /// 帧缓冲像素格式
+  static constexpr GpuFormat kFormat = GpuFormat::kB8G8R8X8Unorm;
+
+  /// 设备未报告显示模式时使用的默认分辨率
+  static constexpr uint32_t kDefaultWidth = 1024;
+  static constexpr uint32_t kDefaultHeight = 768;
+
+  /// DMA 布局的对齐要求（字节）
+  static constexpr size_t kQueueAlign = 4096;
+
+  /**
+   * @brief 计算 DMA 缓冲区所需的字节数
+   *
+   * 区域内依次为控制 Virtqueue、queue_size / 2 个命令槽与描述符链头
+   * 映射表。帧缓冲后备存储不在其中，由调用者另行提供。
+   *
+   * @param queue_size 控制队列的描述符数量（2 的幂，默认 64）
+   * @return 所需的 DMA 内存字节数
+   */
+  [[nodiscard]] static constexpr auto CalcDmaSize(uint32_t queue_size = 64)
+      -> size_t {
+    return AlignUp(GetHeadMapOffset(queue_size) + sizeof(uint16_t) * queue_size,
+                   kQueueAlign);
+  }
+
+  /**
+   * @brief 计算帧缓冲后备存储所需的字节数
+   *
+   * @param width 宽度（像素）
+   * @param height 高度（像素）
+   * @return 后备存储字节数
+   */
+  [[nodiscard]] static constexpr auto CalcFramebufferSize(uint32_t width,
+                                                          uint32_t height)
+      -> size_t {
+    return static_cast<size_t>(width) * height * kBytesPerPixel;
+  }
+
+  /**
+   * @brief 创建并初始化 GPU 设备
+   *
+   * 内部自动完成：
+   * 1. Transport 初始化和验证
+   * 2. VirtIO 设备初始化序列（重置、特性协商）与控制队列创建
+   * 3. GET_DISPLAY_INFO 查询扫描输出 0 的首选分辨率
+   * 4. 以一批命令完成 RESOURCE_CREATE_2D、RESOURCE_ATTACH_BACKING 与
+   *    SET_SCANOUT
+   *
+   * @param mmio_base MMIO 设备基地址
+   * @param vq_dma_buf 预分配的 DMA 缓冲区虚拟地址
+   *        （页对齐，已清零，大小 >= CalcDmaSize()）
+   * @param fb_buf 帧缓冲后备存储虚拟地址（页对齐，物理连续）
+   * @param fb_size 后备存储大小（>= CalcFramebufferSize(width, height)）
+   * @param width 期望宽度（0 表示使用设备报告的首选宽度）
+   * @param height 期望高度（0 表示使用设备报告的首选高度）
+   * @param queue_size 控制队列的描述符数量
+   *        （2 的幂，kMinQueueSize..kMaxQueueSize）
+   * @param driver_features 额外的驱动特性位（VERSION_1 自动包含）
+   * @return 成功返回 VirtioGpu 实例，失败返回错误
+   * @see virtio-v1.2#5.7.5 Device Initialization
+   */
+  [[nodiscard]] static auto Create(uint64_t mmio_base, void* vq_dma_buf,
+                                   void* fb_buf, size_t fb_size,
+                                   uint32_t width = 0, uint32_t height = 0,
+                                   uint32_t queue_size = 64,
+                                   uint64_t driver_features = 0)
+      -> Expected<VirtioGpu> {
+    if (vq_dma_buf == nullptr || fb_buf == nullptr ||
+        queue_size < kMinQueueSize || queue_size > kMaxQueueSize ||
+        !IsPowerOfTwo(queue_size)) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+
+    // 1. 创建传输层
+    TransportT<Traits> transport(mmio_base);
+    if (!transport.IsValid()) {
+      return std::unexpected(Error{ErrorCode::kTransportNotInitialized});
+    }
+    if (transport.GetDeviceId() != static_cast<uint32_t>(DeviceId::kGpu)) {
+      return std::unexpected(Error{ErrorCode::kInvalidDeviceId});
+    }
+    VirtioGpu gpu(std::move(transport));
+
+    // 2. 设备初始化序列
+    DeviceInitializer<Traits, TransportT<Traits>> initializer(gpu.transport_);
+
+    uint64_t wanted_features =
+        static_cast<uint64_t>(ReservedFeature::kVersion1) |
+        static_cast<uint64_t>(ReservedFeature::kEventIdx) |
+        VirtqueueT<Traits>::kRequiredFeatures | driver_features;
+    if constexpr (NotificationDataTransport<TransportT<Traits>>) {
+      wanted_features |=
+          static_cast<uint64_t>(ReservedFeature::kNotificationData);
+    }
+    auto negotiated_result = initializer.Init(wanted_features);
+    if (!negotiated_result) {
+      return std::unexpected(negotiated_result.error());
+    }
+    uint64_t negotiated = *negotiated_result;
+    gpu.negotiated_features_ = negotiated;
+
+    if ((negotiated & static_cast<uint64_t>(ReservedFeature::kVersion1)) == 0) {
+      Traits::Log("Device does not support VERSION_1 (modern mode)");
+      return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
+    }
+    constexpr uint64_t kVqFeatures = VirtqueueT<Traits>::kRequiredFeatures;
+    if ((negotiated & kVqFeatures) != kVqFeatures) {
+      Traits::Log("Device does not support the requested virtqueue format");
+      return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
+    }
+
+    bool event_idx =
+        (negotiated & static_cast<uint64_t>(ReservedFeature::kEventIdx)) != 0;
+    gpu.notification_data_ =
+        (negotiated &
+         static_cast<uint64_t>(ReservedFeature::kNotificationData)) != 0;
+
+    auto* dma_base = static_cast<uint8_t*>(vq_dma_buf);
+    uint64_t dma_phys = Traits::VirtToPhys(vq_dma_buf);
+    gpu.ctrl_.emplace(dma_base, dma_phys, static_cast<uint16_t>(queue_size),
+                      event_idx);
+    if (!gpu.ctrl_->IsValid()) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    gpu.slots_ =
+        reinterpret_cast<CmdSlot*>(dma_base + GetSlotOffset(queue_size));
+    gpu.slots_phys_ = dma_phys + GetSlotOffset(queue_size);
+    gpu.head_map_ =
+        reinterpret_cast<uint16_t*>(dma_base + GetHeadMapOffset(queue_size));
+    gpu.slot_count_ = queue_size / 2;
+    gpu.slot_bitmap_.Reset(gpu.slot_count_);
+
+    auto setup = initializer.SetupQueue(kCtrlQueueIndex, gpu.ctrl_->DescPhys(),
+                                        gpu.ctrl_->AvailPhys(),
+                                        gpu.ctrl_->UsedPhys(),
+                                        gpu.ctrl_->Size());
+    if (!setup) {
+      return std::unexpected(setup.error());
+    }
+    // 命令完成由 Present() / WaitIdle() 轮询回收，不需要 Used Buffer 通知
+    gpu.ctrl_->DisableUsedNotify();
+    DmaSyncForDevice<Traits>(vq_dma_buf, CalcDmaSize(queue_size));
+
+    auto activate_result = initializer.Activate();
+    if (!activate_result) {
+      return std::unexpected(activate_result.error());
+    }
+
+    // 3. 查询首选分辨率
+    if (width == 0 || height == 0) {
+      auto mode = gpu.GetDisplayMode();
+      if (!mode) {
+        return std::unexpected(mode.error());
+      }
+      width = width != 0 ? width : mode->width;
+      height = height != 0 ? height : mode->height;
+    }
+    if (CalcFramebufferSize(width, height) > fb_size) {
+      Traits::Log("Framebuffer %ux%u does not fit in %u bytes", width, height,
+                  static_cast<uint32_t>(fb_size));
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    gpu.width_ = width;
+    gpu.height_ = height;
+    gpu.stride_ = width * kBytesPerPixel;
+    gpu.fb_ = static_cast<uint8_t*>(fb_buf);
+    gpu.fb_phys_ = Traits::VirtToPhys(fb_buf);
+    gpu.fb_size_ = CalcFramebufferSize(width, height);
+
+    // 4. 一批命令完成资源创建、后备存储挂接与扫描输出设置
+    auto resource_result = gpu.SetupScanout();
+    if (!resource_result) {
+      return std::unexpected(resource_result.error());
+    }
+    return gpu;
+  }
+
+  // ======== 绘制与提交 ========
+
+  /**
+   * @brief 标记需要刷新到显示端的区域
+   *
+   * 区域先裁剪到帧缓冲范围内，再与已有脏矩形合并：与任一矩形相交或
+   * 相邻时合并为外接矩形（并继续与其余矩形合并）；否则作为新矩形
+   * 加入，已满 kMaxDirtyRects 时并入外接面积增长最小的矩形。
+   *
+   * @param rect 脏区域（像素）
+   */
+  auto MarkDirty(const FramebufferRect& rect) -> void {
+    if (rect.x >= width_ || rect.y >= height_ || rect.width == 0 ||
+        rect.height == 0) {
+      return;
+    }
+    FramebufferRect clipped = rect;
+    if (clipped.width > width_ - clipped.x) {
+      clipped.width = width_ - clipped.x;
+    }
+    if (clipped.height > height_ - clipped.y) {
+      clipped.height = height_ - clipped.y;
+    }
+
+    // 合并后的矩形可能与其余矩形相交，重新扫描直到不再合并
+    bool merged = true;
+    while (merged) {
+      merged = false;
+      for (size_t i = 0; i < dirty_count_; ++i) {
+        if (Touches(dirty_[i], clipped)) {
+          clipped = Union(dirty_[i], clipped);
+          dirty_[i] = dirty_[--dirty_count_];
+          stats_.rects_merged++;
+          merged = true;
+          break;
+        }
+      }
+    }
+    if (dirty_count_ < kMaxDirtyRects) {
+      dirty_[dirty_count_++] = clipped;
+      return;
+    }
+
+    size_t best = 0;
+    uint64_t best_growth = UINT64_MAX;
+    for (size_t i = 0; i < dirty_count_; ++i) {
+      uint64_t growth = Area(Union(dirty_[i], clipped)) - Area(dirty_[i]);
+      if (growth < best_growth) {
+        best_growth = growth;
+        best = i;
+      }
+    }
+    dirty_[best] = Union(dirty_[best], clipped);
+    stats_.rects_merged++;
+  }
+
+  /// @brief 把整个帧缓冲标记为脏区域
+  auto MarkAllDirty() -> void { MarkDirty({0, 0, width_, height_}); }
+
+  /**
+   * @brief 把已标记的脏区域提交到显示端
+   *
+   * 每个脏矩形一条 TRANSFER_TO_HOST_2D，随后一条覆盖全部脏矩形的
+   * RESOURCE_FLUSH，整批发布一次并按 Event Index 最多通知设备一次。
+   * 命令槽不足时先自旋回收之前提交的命令。
+   *
+   * @return 成功或失败；之前提交的命令收到错误响应时返回 kDeviceError，
+   *         等待命令槽超时返回 kTimeout
+   * @see virtio-v1.2#5.7.6.8 Device Operation: controlq
+   */
+  [[nodiscard]] auto Present() -> Expected<void> {
+    Reap();
+    if (dirty_count_ != 0) {
+      if (!WaitSlots(dirty_count_ + 1)) {
+        return std::unexpected(Error{ErrorCode::kTimeout});
+      }
+      FramebufferRect bounds = dirty_[0];
+      ctrl_->BeginBatch();
+      for (size_t i = 0; i < dirty_count_; ++i) {
+        const auto& rect = dirty_[i];
+        bounds = Union(bounds, rect);
+        uint64_t offset =
+            static_cast<uint64_t>(rect.y) * stride_ + rect.x * kBytesPerPixel;
+        // 非一致性 DMA 平台：把矩形覆盖的行写回内存
+        DmaSyncForDevice<Traits>(
+            fb_ + offset, static_cast<size_t>(rect.height - 1) * stride_ +
+                              rect.width * kBytesPerPixel);
+
+        GpuTransferToHost2d transfer{};
+        transfer.hdr.type =
+            static_cast<uint32_t>(GpuCtrlType::kTransferToHost2d);
+        transfer.r = ToGpuRect(rect);
+        transfer.offset = offset;
+        transfer.resource_id = kResourceId;
+        (void)Enqueue(&transfer, sizeof(transfer), sizeof(GpuCtrlHdr));
+      }
+      GpuResourceFlush flush{};
+      flush.hdr.type = static_cast<uint32_t>(GpuCtrlType::kResourceFlush);
+      flush.r = ToGpuRect(bounds);
+      flush.resource_id = kResourceId;
+      (void)Enqueue(&flush, sizeof(flush), sizeof(GpuCtrlHdr));
+      ctrl_->EndBatch();
+      Kick();
+      stats_.batches++;
+      dirty_count_ = 0;
+    }
+    return TakeError();
+  }
+
+  /**
+   * @brief 等待所有已提交的命令完成
+   *
+   * @return 成功或失败；有命令收到错误响应时返回 kDeviceError，
+   *         超时返回 kTimeout
+   */
+  [[nodiscard]] auto WaitIdle() -> Expected<void> {
+    if (!WaitSlots(slot_count_)) {
+      return std::unexpected(Error{ErrorCode::kTimeout});
+    }
+    return TakeError();
+  }
+
+  // ======== 中断 ========
+
+  /**
+   * @brief 中断处理
+   *
+   * 确认设备中断并回收已完成的命令（含配置变更中断）。
+   */
+  auto HandleInterrupt() -> void {
+    transport_.AcknowledgeInterrupt();
+    Reap();
+  }
+
+  // ======== 设备信息 ========
+
+  /**
+   * @brief 获取帧缓冲布局
+   */
+  [[nodiscard]] auto GetInfo() const -> FramebufferInfo {
+    return {width_, height_, stride_, kBytesPerPixel * 8, fb_size_};
+  }
+
+  /// @brief 获取帧缓冲后备存储虚拟地址
+  [[nodiscard]] auto GetFramebuffer() const -> uint8_t* { return fb_; }
+
+  /// @brief 获取当前保留的脏矩形数
+  [[nodiscard]] auto GetDirtyCount() const -> size_t { return dirty_count_; }
+
+  /// @brief 获取第 i 个脏矩形（i < GetDirtyCount()）
+  [[nodiscard]] auto GetDirtyRect(size_t i) const -> FramebufferRect {
+    return dirty_[i];
+  }
+
+  /**
+   * @brief 获取协商后的特性位
+   */
+  [[nodiscard]] auto GetNegotiatedFeatures() const -> uint64_t {
+    return negotiated_features_;
+  }
+
+  /**
+   * @brief 获取统计数据快照
+   */
+  [[nodiscard]] auto GetStats() const -> GpuStats { return stats_; }
+
+  /// @name 移动/拷贝控制
+  /// @{
+  VirtioGpu(VirtioGpu&& other) noexcept
+      : transport_(std::move(other.transport_)) {
+    MoveFrom(other);
+  }
+  auto operator=(VirtioGpu&& other) noexcept -> VirtioGpu& {
+    if (this != &other) {
+      transport_ = std::move(other.transport_);
+      MoveFrom(other);
+    }
+    return *this;
+  }
+  VirtioGpu(const VirtioGpu&) = delete;
+  auto operator=(const VirtioGpu&) -> VirtioGpu& = delete;
+  ~VirtioGpu() = default;
+  /// @}
+
+ private:
+  /// 命令槽位图类型（每条命令占用两个描述符）
+  using CmdSlotBitmap = SlotBitmap<kMaxQueueSize / 2>;
+
+  /// 控制队列的传输层索引
+  static constexpr uint16_t kCtrlQueueIndex = 0;
+  /// 帧缓冲使用的资源 ID
+  static constexpr uint32_t kResourceId = 1;
+  /// 帧缓冲使用的扫描输出
+  static constexpr uint32_t kScanoutId = 0;
+  /// 单条命令请求的最大长度（字节）
+  static constexpr size_t kMaxRequestLen = 64;
+  /// 命令槽内请求/响应的对齐（不小于一个缓存行）
+  static constexpr size_t kSlotDmaAlign =
+      DmaCacheLineSize<Traits>() > kDefaultCacheLineSize
+          ? DmaCacheLineSize<Traits>()
+          : kDefaultCacheLineSize;
+
+  /// 等待设备处理的自旋上限
+  static constexpr uint32_t kSpinLimit = [] {
+    if constexpr (SpinWaitTraits<Traits>) {
+      return static_cast<uint32_t>(Traits::kMaxSpinIterations);
+    } else {
+      return uint32_t{100000000};
+    }
+  }();
+
+  /**
+   * @brief 命令槽（DMA 内存）
+   *
+   * 设备写入的响应与驱动写入的请求位于不同缓存行。
+   */
+  struct CmdSlot {
+    alignas(kSlotDmaAlign) uint8_t request[kMaxRequestLen];
+    alignas(kSlotDmaAlign) uint8_t response[sizeof(GpuRespDisplayInfo)];
+  };
+
+  /// @name DMA 区域内各部分的偏移
+  /// @{
+  [[nodiscard]] static constexpr auto GetSlotOffset(uint32_t queue_size)
+      -> size_t {
+    // 始终按 event_idx=true 分配，因为特性协商在分配之后
+    return AlignUp(
+        VirtqueueT<Traits>::CalcSize(static_cast<uint16_t>(queue_size), true),
+        alignof(CmdSlot));
+  }
+  [[nodiscard]] static constexpr auto GetHeadMapOffset(uint32_t queue_size)
+      -> size_t {
+    return GetSlotOffset(queue_size) + sizeof(CmdSlot) * (queue_size / 2);
+  }
+  /// @}
+
+  /**
+   * @brief 私有构造函数
+   *
+   * 只能通过 Create() 静态工厂方法创建实例。
+   */
+  explicit VirtioGpu(TransportT<Traits> transport)
+      : transport_(std::move(transport)) {}
+
+  /// @brief 判断两个矩形是否相交或相邻
+  [[nodiscard]] static constexpr auto Touches(const FramebufferRect& a,
+                                              const FramebufferRect& b)
+      -> bool {
+    return a.x <= b.x + b.width && b.x <= a.x + a.width &&
+           a.y <= b.y + b.height && b.y <= a.y + a.height;
+  }
+
+  /// @brief 两个矩形的外接矩形
+  [[nodiscard]] static constexpr auto Union(const FramebufferRect& a,
+                                            const FramebufferRect& b)
+      -> FramebufferRect {
+    uint32_t x0 = a.x < b.x ? a.x : b.x;
+    uint32_t y0 = a.y < b.y ? a.y : b.y;
+    uint32_t x1 = a.x + a.width > b.x + b.width ? a.x + a.width : b.x + b.width;
+    uint32_t y1 =
+        a.y + a.height > b.y + b.height ? a.y + a.height : b.y + b.height;
+    return {x0, y0, x1 - x0, y1 - y0};
+  }
+
+  /// @brief 矩形面积（像素）
+  [[nodiscard]] static constexpr auto Area(const FramebufferRect& rect)
+      -> uint64_t {
+    return static_cast<uint64_t>(rect.width) * rect.height;
+  }
+
+  /// @brief 转换为协议矩形
+  [[nodiscard]] static constexpr auto ToGpuRect(const FramebufferRect& rect)
+      -> GpuRect {
+    return {rect.x, rect.y, rect.width, rect.height};
+  }
+
+  /**
+   * @brief 查询扫描输出 0 的首选分辨率（同步）
+   *
+   * @return 首选宽高；设备未报告时返回默认分辨率
+   */
+  [[nodiscard]] auto GetDisplayMode() -> Expected<FramebufferRect> {
+    GpuCtrlHdr request{};
+    request.type = static_cast<uint32_t>(GpuCtrlType::kGetDisplayInfo);
+    auto slot = Enqueue(&request, sizeof(request), sizeof(GpuRespDisplayInfo));
+    if (!slot) {
+      return std::unexpected(slot.error());
+    }
+    Kick();
+    auto wait_result = WaitIdle();
+    if (!wait_result) {
+      return std::unexpected(wait_result.error());
+    }
+    const auto* info =
+        reinterpret_cast<const GpuRespDisplayInfo*>(slots_[*slot].response);
+    const auto& mode = info->pmodes[kScanoutId];
+    if (mode.enabled == 0 || mode.r.width == 0 || mode.r.height == 0) {
+      return FramebufferRect{0, 0, kDefaultWidth, kDefaultHeight};
+    }
+    return FramebufferRect{0, 0, mode.r.width, mode.r.height};
+  }
+
+  /**
+   * @brief 创建帧缓冲资源、挂接后备存储并设置扫描输出（一批命令）
+   *
+   * @return 成功或失败；设备返回错误响应时返回 kDeviceError
+   */
+  [[nodiscard]] auto SetupScanout() -> Expected<void> {
+    GpuResourceCreate2d create{};
+    create.hdr.type = static_cast<uint32_t>(GpuCtrlType::kResourceCreate2d);
+    create.resource_id = kResourceId;
+    create.format = static_cast<uint32_t>(kFormat);
+    create.width = width_;
+    create.height = height_;
+
+    struct {
+      GpuResourceAttachBacking attach;
+      GpuMemEntry entry;
+    } __attribute__((packed)) backing{};
+    backing.attach.hdr.type =
+        static_cast<uint32_t>(GpuCtrlType::kResourceAttachBacking);
+    backing.attach.resource_id = kResourceId;
+    backing.attach.nr_entries = 1;
+    backing.entry = {fb_phys_, static_cast<uint32_t>(fb_size_), 0};
+
+    GpuSetScanout scanout{};
+    scanout.hdr.type = static_cast<uint32_t>(GpuCtrlType::kSetScanout);
+    scanout.r = {0, 0, width_, height_};
+    scanout.scanout_id = kScanoutId;
+    scanout.resource_id = kResourceId;
+
+    ctrl_->BeginBatch();
+    auto r1 = Enqueue(&create, sizeof(create), sizeof(GpuCtrlHdr));
+    auto r2 = Enqueue(&backing, sizeof(backing), sizeof(GpuCtrlHdr));
+    auto r3 = Enqueue(&scanout, sizeof(scanout), sizeof(GpuCtrlHdr));
+    ctrl_->EndBatch();
+    Kick();
+    stats_.batches++;
+    if (!r1 || !r2 || !r3) {
+      return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
+    }
+    return WaitIdle();
+  }
+
+  /**
+   * @brief 把一条命令放入空闲命令槽并提交（不通知设备）
+   *
+   * 调用者须保证有空闲命令槽（见 WaitSlots()）。
+   *
+   * @param request 请求数据
+   * @param request_len 请求长度（<= kMaxRequestLen）
+   * @param response_len 期望的响应长度
+   * @return 成功返回命令槽索引，失败返回错误
+   */
+  [[nodiscard]] auto Enqueue(const void* request, size_t request_len,
+                             size_t response_len) -> Expected<size_t> {
+    size_t slot = slot_bitmap_.Alloc();
+    if (slot == CmdSlotBitmap::kInvalid) {
+      return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
+    }
+    auto& cmd = slots_[slot];
+    __builtin_memcpy(cmd.request, request, request_len);
+    DmaSyncForDevice<Traits>(cmd.request, request_len);
+
+    uint64_t phys = slots_phys_ + slot * sizeof(CmdSlot);
+    IoVec readable{static_cast<uintptr_t>(phys + offsetof(CmdSlot, request)),
+                   request_len};
+    IoVec writable{static_cast<uintptr_t>(phys + offsetof(CmdSlot, response)),
+                   response_len};
+    auto head = ctrl_->SubmitChain(&readable, 1, &writable, 1);
+    if (!head) {
+      slot_bitmap_.Free(slot);
+      return std::unexpected(head.error());
+    }
+    head_map_[*head] = static_cast<uint16_t>(slot);
+    inflight_++;
+    stats_.commands++;
+    return slot;
+  }
+
+  /**
+   * @brief 回收已完成的命令并检查响应
+   *
+   * @return 本次回收的命令数
+   */
+  auto Reap() -> size_t {
+    size_t reaped = 0;
+    while (true) {
+      auto used = ctrl_->PopUsed();
+      if (!used) {
+        break;
+      }
+      auto head = static_cast<uint16_t>(used->id);
+      uint16_t slot = head_map_[head];
+      auto* response = reinterpret_cast<GpuCtrlHdr*>(slots_[slot].response);
+      DmaSyncForCpu<Traits>(response, sizeof(GpuRespDisplayInfo));
+      if (response->type >=
+          static_cast<uint32_t>(GpuCtrlType::kRespErrUnspec)) {
+        stats_.errors++;
+        error_pending_ = true;
+      }
+      (void)ctrl_->FreeChain(head);
+      slot_bitmap_.Free(slot);
+      inflight_--;
+      ++reaped;
+    }
+    return reaped;
+  }
+
+  /**
+   * @brief 自旋回收直到至少有 count 个空闲命令槽
+   *
+   * @param count 需要的空闲命令槽数（<= slot_count_）
+   * @return 成功返回 true，超时返回 false
+   */
+  auto WaitSlots(size_t count) -> bool {
+    for (uint32_t i = 0; i < kSpinLimit; ++i) {
+      if (slot_count_ - inflight_ >= count) {
+        return true;
+      }
+      Traits::Rmb();
+      Reap();
+    }
+    return slot_count_ - inflight_ >= count;
+  }
+
+  /// @brief 取出并清除待报告的错误响应
+  [[nodiscard]] auto TakeError() -> Expected<void> {
+    if (error_pending_) {
+      error_pending_ = false;
+      return std::unexpected(Error{ErrorCode::kDeviceError});
+    }
+    return {};
+  }
+
+  /**
+   * @brief 按 Event Index 判断后通知设备，并统计通知与被抑制的通知
+   *
+   * @see virtio-v1.2#2.7.10 Available Buffer Notification Suppression
+   */
+  auto Kick() -> void {
+    if (KickVirtqueue<Traits>(transport_, kCtrlQueueIndex, *ctrl_,
+                              old_avail_idx_, notification_data_)) {
+      stats_.kicks++;
+    } else {
+      stats_.kicks_elided++;
+    }
+  }
+
+  /**
+   * @brief 从另一个实例转移全部状态
+   *
+   * 命令槽与映射表位于调用者提供的 DMA 区域内，移动只转移指针，
+   * 其地址在移动前后不变。
+   *
+   * @param other 源 VirtioGpu 实例
+   */
+  auto MoveFrom(VirtioGpu& other) -> void {
+    negotiated_features_ = other.negotiated_features_;
+    notification_data_ = other.notification_data_;
+    ctrl_.reset();
+    if (other.ctrl_.has_value()) {
+      ctrl_.emplace(std::move(*other.ctrl_));
+      other.ctrl_.reset();
+    }
+    old_avail_idx_ = other.old_avail_idx_;
+    slots_ = other.slots_;
+    slots_phys_ = other.slots_phys_;
+    head_map_ = other.head_map_;
+    slot_bitmap_ = other.slot_bitmap_;
+    slot_count_ = other.slot_count_;
+    inflight_ = other.inflight_;
+    error_pending_ = other.error_pending_;
+    fb_ = other.fb_;
+    fb_phys_ = other.fb_phys_;
+    fb_size_ = other.fb_size_;
+    width_ = other.width_;
+    height_ = other.height_;
+    stride_ = other.stride_;
+    for (size_t i = 0; i < other.dirty_count_; ++i) {
+      dirty_[i] = other.dirty_[i];
+    }
+    dirty_count_ = other.dirty_count_;
+    stats_ = other.stats_;
+    other.dirty_count_ = 0;
+    other.inflight_ = 0;
+  }
+
+  /// 传输层实例
+  TransportT<Traits> transport_;
+  /// 协商后的特性位掩码
+  uint64_t negotiated_features_ = 0;
+  /// 是否已协商 VIRTIO_F_NOTIFICATION_DATA
+  bool notification_data_ = false;
+  /// 控制队列
+  std::optional<VirtqueueT<Traits>> ctrl_;
+  /// 上次 Kick 控制队列时的 avail idx
+  uint16_t old_avail_idx_ = 0;
+  /// 命令槽数组（DMA 内存）
+  CmdSlot* slots_ = nullptr;
+  /// slots_ 的物理地址
+  uint64_t slots_phys_ = 0;
+  /// 描述符链头 → 命令槽索引（仅 CPU 访问）
+  uint16_t* head_map_ = nullptr;
+  /// 命令槽占用位图
+  CmdSlotBitmap slot_bitmap_{};
+  /// 命令槽数量
+  size_t slot_count_ = 0;
+  /// 在途命令数
+  size_t inflight_ = 0;
+  /// 是否有尚未报告的错误响应
+  bool error_pending_ = false;
+  /// 帧缓冲后备存储
+  uint8_t* fb_ = nullptr;
+  /// fb_ 的物理地址
+  uint64_t fb_phys_ = 0;
+  /// 帧缓冲字节数
+  size_t fb_size_ = 0;
+  /// 宽度（像素）
+  uint32_t width_ = 0;
+  /// 高度（像素）
+  uint32_t height_ = 0;
+  /// 行间距（字节）
+  uint32_t stride_ = 0;
+  /// 待提交的脏矩形
+  FramebufferRect dirty_[kMaxDirtyRects]{};
+  /// 脏矩形数
+  size_t dirty_count_ = 0;
+  /// 统计数据
+  GpuStats stats_{};
+};
+
+}  // namespace device_framework::detail::virtio::gpu
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_GPU_HPP_ \
+        */
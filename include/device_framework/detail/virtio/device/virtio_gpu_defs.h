@@ -0,0 +1,225 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_GPU_DEFS_H_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_GPU_DEFS_H_
+
+#include <cstdint>
+
+namespace device_framework::detail::virtio::gpu {
+
+/**
+ * @brief GPU 设备特性位定义
+ * @see virtio-v1.2#5.7.3 Feature bits
+ */
+enum class GpuFeatureBit : uint64_t {
+  /// 支持 3D 模式 (VIRTIO_GPU_F_VIRGL)
+  kVirgl = 1ULL << 0,
+  /// 支持 EDID 查询 (VIRTIO_GPU_F_EDID)
+  kEdid = 1ULL << 1,
+  /// 支持资源 UUID 分配 (VIRTIO_GPU_F_RESOURCE_UUID)
+  kResourceUuid = 1ULL << 2,
+  /// 支持 blob 资源 (VIRTIO_GPU_F_RESOURCE_BLOB)
+  kResourceBlob = 1ULL << 3,
+  /// 支持多种上下文类型 (VIRTIO_GPU_F_CONTEXT_INIT)
+  kContextInit = 1ULL << 4,
+};
+
+/**
+ * @brief GPU 设备配置空间字段偏移量
+ * @see virtio-v1.2#5.7.4 Device configuration layout
+ */
+enum class GpuConfigOffset : uint32_t {
+  /// 待处理事件（只读）
+  kEventsRead = 0,
+  /// 清除事件（只写）
+  kEventsClear = 4,
+  /// 支持的扫描输出数
+  kNumScanouts = 8,
+  /// 支持的能力集数
+  kNumCapsets = 12,
+};
+
+/**
+ * @brief 控制队列命令与响应类型
+ * @see virtio-v1.2#5.7.6.7 Device Operation: Request header
+ */
+enum class GpuCtrlType : uint32_t {
+  /// @name 2D 命令
+  /// @{
+  kGetDisplayInfo = 0x0100,
+  kResourceCreate2d = 0x0101,
+  kResourceUnref = 0x0102,
+  kSetScanout = 0x0103,
+  kResourceFlush = 0x0104,
+  kTransferToHost2d = 0x0105,
+  kResourceAttachBacking = 0x0106,
+  kResourceDetachBacking = 0x0107,
+  /// @}
+
+  /// @name 成功响应
+  /// @{
+  kRespOkNodata = 0x1100,
+  kRespOkDisplayInfo = 0x1101,
+  /// @}
+
+  /// @name 错误响应
+  /// @{
+  kRespErrUnspec = 0x1200,
+  kRespErrOutOfMemory = 0x1201,
+  kRespErrInvalidScanoutId = 0x1202,
+  kRespErrInvalidResourceId = 0x1203,
+  kRespErrInvalidContextId = 0x1204,
+  kRespErrInvalidParameter = 0x1205,
+  /// @}
+};
+
+/**
+ * @brief 2D 资源像素格式（按字节顺序命名）
+ * @see virtio-v1.2#5.7.6.8 Device Operation: controlq
+ */
+enum class GpuFormat : uint32_t {
+  kB8G8R8A8Unorm = 1,
+  kB8G8R8X8Unorm = 2,
+  kA8R8G8B8Unorm = 3,
+  kX8R8G8B8Unorm = 4,
+  kR8G8B8A8Unorm = 67,
+  kX8B8G8R8Unorm = 68,
+  kA8B8G8R8Unorm = 121,
+  kR8G8B8X8Unorm = 134,
+};
+
+/// 最大扫描输出数 (VIRTIO_GPU_MAX_SCANOUTS)
+static constexpr uint32_t kGpuMaxScanouts = 16;
+
+/**
+ * @brief 控制队列请求/响应头
+ * @see virtio-v1.2#5.7.6.7 Device Operation: Request header
+ *
+ * @note 协议中所有字段采用小端格式
+ */
+struct GpuCtrlHdr {
+  /// 命令或响应类型 (GpuCtrlType)
+  uint32_t type;
+  /// 标志位（VIRTIO_GPU_FLAG_FENCE 等）
+  uint32_t flags;
+  /// 栅栏 ID
+  uint64_t fence_id;
+  /// 3D 上下文 ID（2D 命令为 0）
+  uint32_t ctx_id;
+  /// 上下文环索引
+  uint8_t ring_idx;
+  uint8_t padding[3];
+} __attribute__((packed));
+
+static_assert(sizeof(GpuCtrlHdr) == 24, "virtio_gpu_ctrl_hdr must be 24 bytes");
+
+/**
+ * @brief 矩形区域（像素）
+ */
+struct GpuRect {
+  uint32_t x;
+  uint32_t y;
+  uint32_t width;
+  uint32_t height;
+} __attribute__((packed));
+
+/**
+ * @brief VIRTIO_GPU_CMD_GET_DISPLAY_INFO 的响应
+ */
+struct GpuRespDisplayInfo {
+  GpuCtrlHdr hdr;
+  struct {
+    /// 扫描输出的首选位置与大小
+    GpuRect r;
+    /// 是否已连接显示器
+    uint32_t enabled;
+    uint32_t flags;
+  } __attribute__((packed)) pmodes[kGpuMaxScanouts];
+} __attribute__((packed));
+
+/**
+ * @brief VIRTIO_GPU_CMD_RESOURCE_CREATE_2D
+ */
+struct GpuResourceCreate2d {
+  GpuCtrlHdr hdr;
+  uint32_t resource_id;
+  /// 像素格式 (GpuFormat)
+  uint32_t format;
+  uint32_t width;
+  uint32_t height;
+} __attribute__((packed));
+
+/**
+ * @brief VIRTIO_GPU_CMD_SET_SCANOUT
+ */
+struct GpuSetScanout {
+  GpuCtrlHdr hdr;
+  GpuRect r;
+  uint32_t scanout_id;
+  uint32_t resource_id;
+} __attribute__((packed));
+
+/**
+ * @brief VIRTIO_GPU_CMD_RESOURCE_FLUSH
+ */
+struct GpuResourceFlush {
+  GpuCtrlHdr hdr;
+  GpuRect r;
+  uint32_t resource_id;
+  uint32_t padding;
+} __attribute__((packed));
+
+/**
+ * @brief VIRTIO_GPU_CMD_TRANSFER_TO_HOST_2D
+ */
+struct GpuTransferToHost2d {
+  GpuCtrlHdr hdr;
+  GpuRect r;
+  /// 矩形首像素在后备存储中的字节偏移
+  uint64_t offset;
+  uint32_t resource_id;
+  uint32_t padding;
+} __attribute__((packed));
+
+/**
+ * @brief 后备存储的一个物理连续段
+ */
+struct GpuMemEntry {
+  uint64_t addr;
+  uint32_t length;
+  uint32_t padding;
+} __attribute__((packed));
+
+/**
+ * @brief VIRTIO_GPU_CMD_RESOURCE_ATTACH_BACKING（后随 nr_entries 个
+ *        GpuMemEntry）
+ */
+struct GpuResourceAttachBacking {
+  GpuCtrlHdr hdr;
+  uint32_t resource_id;
+  uint32_t nr_entries;
+} __attribute__((packed));
+
+/**
+ * @brief GPU 设备统计数据
+ */
+struct GpuStats {
+  /// 已提交的控制命令数
+  uint64_t commands{0};
+  /// 已提交的命令批次数
+  uint64_t batches{0};
+  /// 实际发出的队列通知次数
+  uint64_t kicks{0};
+  /// 借助 Event Index 省略的 Kick 次数
+  uint64_t kicks_elided{0};
+  /// 因相交或相邻而被合并的脏矩形数
+  uint64_t rects_merged{0};
+  /// 设备返回错误响应的命令数
+  uint64_t errors{0};
+};
+
+}  // namespace device_framework::detail::virtio::gpu
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_GPU_DEFS_H_ */
@@ -0,0 +1,234 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_GPU_DEVICE_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_GPU_DEVICE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "device_framework/detail/virtio/device/virtio_gpu.hpp"
+#include "device_framework/expected.hpp"
+#include "device_framework/ops/framebuffer_device.hpp"
+
+namespace device_framework::detail::virtio::gpu {
+
+/**
+ * @brief VirtIO GPU 帧缓冲设备适配器
+ *
+ * 将底层 VirtioGpu 驱动适配到统一的 FramebufferDevice 接口：
+ * - Mmap 返回后备存储的虚拟地址（后备存储由调用者提供且物理连续，
+ *   页表映射由调用者完成），调用者直接绘制后 MarkDirty() + Present()
+ * - Read/Write 按字节偏移访问后备存储，Write 自动标记被覆盖的行
+ *
+ * 使用示例：
+ * @code
+ * auto fb = VirtioGpuDevice<MyTraits>::Create(mmio_base, dma_buf, fb_buf,
+ *                                             fb_size);
+ * fb->OpenReadWrite();
+ * auto pixels = fb->Mmap(0, fb_size, ProtFlags{ProtFlags::kWrite},
+ *                        MapFlags{MapFlags::kShared}, 0);
+ * // ... 绘制 ...
+ * fb->MarkDirty({x, y, w, h});
+ * fb->Present();  // 一批命令 + 一次 Kick
+ * @endcode
+ *
+ * @tparam Traits 平台环境特征类型
+ * @tparam TransportT 传输层模板（默认 MmioTransport）
+ * @tparam VirtqueueT Virtqueue 模板（默认 SplitVirtqueue）
+ * @see FramebufferDevice
+ * @see VirtioGpu
+ */
+template <VirtioTraits Traits = NullVirtioTraits,
+          template <class> class TransportT = MmioTransport,
+          template <class> class VirtqueueT = SplitVirtqueue>
+class VirtioGpuDevice
+    : public FramebufferDevice<
+          VirtioGpuDevice<Traits, TransportT, VirtqueueT>> {
+ public:
+  /// 底层驱动类型别名
+  using DriverType = VirtioGpu<Traits, TransportT, VirtqueueT>;
+
+  /**
+   * @brief 创建并初始化 VirtIO GPU 设备（统一接口版）
+   *
+   * 参数含义见 VirtioGpu::Create()。
+   *
+   * @return 成功返回 VirtioGpuDevice 实例，失败返回错误
+   */
+  [[nodiscard]] static auto Create(uint64_t mmio_base, void* vq_dma_buf,
+                                   void* fb_buf, size_t fb_size,
+                                   uint32_t width = 0, uint32_t height = 0,
+                                   uint32_t queue_size = 64,
+                                   uint64_t driver_features = 0)
+      -> Expected<VirtioGpuDevice> {
+    auto gpu_result =
+        DriverType::Create(mmio_base, vq_dma_buf, fb_buf, fb_size, width,
+                           height, queue_size, driver_features);
+    if (!gpu_result) {
+      return std::unexpected(gpu_result.error());
+    }
+    return VirtioGpuDevice(std::move(*gpu_result));
+  }
+
+  /**
+   * @brief 获取 DMA 缓冲区所需大小
+   */
+  [[nodiscard]] static constexpr auto CalcDmaSize(uint32_t queue_size = 64)
+      -> size_t {
+    return DriverType::CalcDmaSize(queue_size);
+  }
+
+  /// @brief 直接访问底层 VirtioGpu 驱动
+  [[nodiscard]] auto GetDriver() -> DriverType& { return driver_; }
+  [[nodiscard]] auto GetDriver() const -> const DriverType& { return driver_; }
+
+  /// @name 移动/拷贝控制
+  /// @{
+  VirtioGpuDevice(VirtioGpuDevice&&) noexcept = default;
+  auto operator=(VirtioGpuDevice&&) noexcept -> VirtioGpuDevice& = default;
+  VirtioGpuDevice(const VirtioGpuDevice&) = delete;
+  auto operator=(const VirtioGpuDevice&) -> VirtioGpuDevice& = delete;
+  ~VirtioGpuDevice() = default;
+  /// @}
+
+ protected:
+  /**
+   * @brief 打开设备
+   */
+  auto DoOpen(OpenFlags flags) -> Expected<void> {
+    if (!flags.CanRead() && !flags.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    flags_ = flags;
+    return {};
+  }
+
+  /**
+   * @brief 释放设备
+   */
+  auto DoRelease() -> Expected<void> { return {}; }
+
+  /**
+   * @brief 从后备存储读取像素数据
+   *
+   * @param buffer 目标缓冲区
+   * @param offset 帧缓冲内的字节偏移
+   * @return 实际读取的字节数（到达帧缓冲末尾时为 0）
+   */
+  auto DoRead(std::span<uint8_t> buffer, size_t offset) -> Expected<size_t> {
+    if (!flags_.CanRead()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    size_t count = ClampLength(buffer.size(), offset);
+    if (count != 0) {
+      __builtin_memcpy(buffer.data(), driver_.GetFramebuffer() + offset,
+                       count);
+    }
+    return count;
+  }
+
+  /**
+   * @brief 向后备存储写入像素数据，并标记被覆盖的行
+   *
+   * @param data 待写入数据
+   * @param offset 帧缓冲内的字节偏移
+   * @return 实际写入的字节数（到达帧缓冲末尾时为 0）
+   */
+  auto DoWrite(std::span<const uint8_t> data, size_t offset)
+      -> Expected<size_t> {
+    if (!flags_.CanWrite()) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    size_t count = ClampLength(data.size(), offset);
+    if (count != 0) {
+      __builtin_memcpy(driver_.GetFramebuffer() + offset, data.data(), count);
+      auto info = driver_.GetInfo();
+      auto first_row = static_cast<uint32_t>(offset / info.stride);
+      auto last_row = static_cast<uint32_t>((offset + count - 1) / info.stride);
+      driver_.MarkDirty({0, first_row, info.width, last_row - first_row + 1});
+    }
+    return count;
+  }
+
+  /**
+   * @brief 映射帧缓冲后备存储
+   *
+   * 后备存储常驻且物理连续，直接返回其虚拟地址；不支持 MAP_FIXED
+   * 指定其他地址，offset 须按页对齐。
+   *
+   * @return 映射区域起始虚拟地址
+   */
+  auto DoMmap(uintptr_t addr, size_t length, ProtFlags prot, MapFlags flags,
+              size_t offset) -> Expected<uintptr_t> {
+    size_t size = driver_.GetInfo().size;
+    if (length == 0 || offset > size || length > size - offset ||
+        offset % kPageSize != 0) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    if ((prot.value & ProtFlags::kExec) != 0 ||
+        ((prot.value & ProtFlags::kWrite) != 0 && !flags_.CanWrite()) ||
+        ((prot.value & ProtFlags::kRead) != 0 && !flags_.CanRead())) {
+      return std::unexpected(Error{ErrorCode::kDevicePermissionDenied});
+    }
+    auto base = reinterpret_cast<uintptr_t>(driver_.GetFramebuffer()) + offset;
+    if ((flags.value & MapFlags::kFixed) != 0 && addr != base) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    return base;
+  }
+
+  auto DoGetInfo() -> Expected<FramebufferInfo> { return driver_.GetInfo(); }
+
+  auto DoMarkDirty(const FramebufferRect& rect) -> Expected<void> {
+    driver_.MarkDirty(rect);
+    return {};
+  }
+
+  auto DoPresent() -> Expected<void> { return driver_.Present(); }
+
+  /**
+   * @brief GPU 中断处理：确认中断并回收已完成的命令
+   */
+  auto DoHandleInterrupt() -> void { driver_.HandleInterrupt(); }
+
+ private:
+  /// @brief CRTP 基类需要访问 DoXxx 方法
+  template <class>
+  friend class ::device_framework::DeviceOperationsBase;
+  template <class>
+  friend class ::device_framework::FramebufferDevice;
+
+  /// Mmap 偏移的对齐要求（字节）
+  static constexpr size_t kPageSize = 4096;
+
+  /**
+   * @brief 私有构造函数
+   *
+   * 只能通过 Create() 静态工厂方法创建实例。
+   */
+  explicit VirtioGpuDevice(DriverType driver) : driver_(std::move(driver)) {}
+
+  /// @brief 把访问长度裁剪到帧缓冲末尾
+  [[nodiscard]] auto ClampLength(size_t length, size_t offset) const
+      -> size_t {
+    size_t size = driver_.GetInfo().size;
+    if (offset >= size) {
+      return 0;
+    }
+    return length < size - offset ? length : size - offset;
+  }
+
+  /// 底层驱动
+  DriverType driver_;
+  /// 打开标志
+  OpenFlags flags_{0};
+};
+
+}  // namespace device_framework::detail::virtio::gpu
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_GPU_DEVICE_HPP_ \
+        */
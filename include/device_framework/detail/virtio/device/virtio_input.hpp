@@ -0,0 +1,666 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_INPUT_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_INPUT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "device_framework/detail/virtio/defs.h"
+#include "device_framework/detail/virtio/device/device_initializer.hpp"
+#include "device_framework/detail/virtio/device/virtio_input_defs.h"
+#include "device_framework/detail/virtio/traits.hpp"
+#include "device_framework/detail/virtio/transport/mmio.hpp"
+#include "device_framework/detail/virtio/transport/transport.hpp"
+#include "device_framework/detail/virtio/virt_queue/misc.hpp"
+#include "device_framework/detail/virtio/virt_queue/split.hpp"
+#include "device_framework/expected.hpp"
+
+namespace device_framework::detail::virtio::input {
+
+/**
+ * @brief Virtio 输入设备驱动
+ *
+ * 事件队列（eventq）始终预投递满：DMA 区域内一组固定的 InputEvent
+ * 缓冲区，每个占一个描述符。
+ * - 批量读取：Read() 一次取出所有已到达的事件（受调用者缓冲区容量限制），
+ *   随后把消耗的缓冲区以一批重新投递，整批只发布一次、按 Event Index
+ *   最多通知设备一次
+ * - 低中断率：HandleInterrupt() 关闭 Used Buffer 通知，直到 Read() 把
+ *   事件环读空才重新开启；高频指针设备在读者处理期间产生的事件
+ *   不会再触发中断
+ * - 配置缓存：LoadConfig() 一次读出设备名称、序列号、设备标识、属性位图、
+ *   各事件类型的事件码位图与绝对坐标轴范围，之后的查询只访问缓存
+ *
+ * 状态队列（statusq，LED/力反馈）未使用，不进行配置。
+ *
+ * @tparam Traits 平台环境特征类型
+ * @tparam TransportT 传输层模板（默认 MmioTransport，须支持配置空间写入）
+ * @tparam VirtqueueT Virtqueue 模板（默认 SplitVirtqueue）
+ * @see virtio-v1.2#5.8 Input Device
+ */
+template <VirtioTraits Traits = NullVirtioTraits,
+          template <class> class TransportT = MmioTransport,
+          template <class> class VirtqueueT = SplitVirtqueue>
+class VirtioInput {
+  static_assert(ConfigWriteTransport<TransportT<Traits>>,
+                "VirtioInput needs config space writes (select/subsel)");
+
+ public:
+  /// 事件队列的最大描述符数量
+  static constexpr uint32_t kMaxQueueSize = 256;
+
+  /// DMA 布局的对齐要求（字节）
+  static constexpr size_t kQueueAlign = 4096;
+
+  /**
+   * @brief 计算 DMA 缓冲区所需的字节数
+   *
+   * 区域内依次为事件 Virtqueue、描述符链头映射表与 queue_size 个
+   * InputEvent 缓冲区。
+   *
+   * @param queue_size 事件队列的描述符数量（2 的幂，默认 64）
+   * @return 所需的 DMA 内存字节数
+   */
+  [[nodiscard]] static constexpr auto CalcDmaSize(uint32_t queue_size = 64)
+      -> size_t {
+    return AlignUp(GetEventOffset(queue_size) + sizeof(InputEvent) * queue_size,
+                   kQueueAlign);
+  }
+
+  /**
+   * @brief 创建并初始化输入设备
+   *
+   * 内部自动完成：
+   * 1. Transport 初始化和验证
+   * 2. VirtIO 设备初始化序列（重置、特性协商）与事件队列创建
+   * 3. 以一批投递全部事件缓冲区
+   *
+   * 配置空间在 LoadConfig() 中读取（通常由 VirtioInputDevice 在打开时
+   * 调用）。
+   *
+   * @param mmio_base MMIO 设备基地址
+   * @param vq_dma_buf 预分配的 DMA 缓冲区虚拟地址
+   *        （页对齐，已清零，大小 >= CalcDmaSize()）
+   * @param queue_size 事件队列的描述符数量（2 的幂，<= kMaxQueueSize）
+   * @param driver_features 额外的驱动特性位（VERSION_1 自动包含）
+   * @return 成功返回 VirtioInput 实例，失败返回错误
+   * @see virtio-v1.2#5.8.5 Device Initialization
+   */
+  [[nodiscard]] static auto Create(uint64_t mmio_base, void* vq_dma_buf,
+                                   uint32_t queue_size = 64,
+                                   uint64_t driver_features = 0)
+      -> Expected<VirtioInput> {
+    if (vq_dma_buf == nullptr || queue_size == 0 ||
+        queue_size > kMaxQueueSize || !IsPowerOfTwo(queue_size)) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+
+    // 1. 创建传输层
+    TransportT<Traits> transport(mmio_base);
+    if (!transport.IsValid()) {
+      return std::unexpected(Error{ErrorCode::kTransportNotInitialized});
+    }
+    if (transport.GetDeviceId() != static_cast<uint32_t>(DeviceId::kInput)) {
+      return std::unexpected(Error{ErrorCode::kInvalidDeviceId});
+    }
+    VirtioInput input(std::move(transport));
+
+    // 2. 设备初始化序列
+    DeviceInitializer<Traits, TransportT<Traits>> initializer(
+        input.transport_);
+
+    uint64_t wanted_features =
+        static_cast<uint64_t>(ReservedFeature::kVersion1) |
+        static_cast<uint64_t>(ReservedFeature::kEventIdx) |
+        VirtqueueT<Traits>::kRequiredFeatures | driver_features;
+    if constexpr (NotificationDataTransport<TransportT<Traits>>) {
+      wanted_features |=
+          static_cast<uint64_t>(ReservedFeature::kNotificationData);
+    }
+    auto negotiated_result = initializer.Init(wanted_features);
+    if (!negotiated_result) {
+      return std::unexpected(negotiated_result.error());
+    }
+    uint64_t negotiated = *negotiated_result;
+    input.negotiated_features_ = negotiated;
+
+    if ((negotiated & static_cast<uint64_t>(ReservedFeature::kVersion1)) == 0) {
+      Traits::Log("Device does not support VERSION_1 (modern mode)");
+      return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
+    }
+    constexpr uint64_t kVqFeatures = VirtqueueT<Traits>::kRequiredFeatures;
+    if ((negotiated & kVqFeatures) != kVqFeatures) {
+      Traits::Log("Device does not support the requested virtqueue format");
+      return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
+    }
+
+    bool event_idx =
+        (negotiated & static_cast<uint64_t>(ReservedFeature::kEventIdx)) != 0;
+    input.notification_data_ =
+        (negotiated &
+         static_cast<uint64_t>(ReservedFeature::kNotificationData)) != 0;
+
+    auto* dma_base = static_cast<uint8_t*>(vq_dma_buf);
+    uint64_t dma_phys = Traits::VirtToPhys(vq_dma_buf);
+    input.eventq_.emplace(dma_base, dma_phys,
+                          static_cast<uint16_t>(queue_size), event_idx);
+    if (!input.eventq_->IsValid()) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    input.head_map_ =
+        reinterpret_cast<uint16_t*>(dma_base + GetHeadMapOffset(queue_size));
+    input.events_ =
+        reinterpret_cast<InputEvent*>(dma_base + GetEventOffset(queue_size));
+    input.events_phys_ = dma_phys + GetEventOffset(queue_size);
+
+    auto setup = initializer.SetupQueue(
+        kEventQueueIndex, input.eventq_->DescPhys(),
+        input.eventq_->AvailPhys(), input.eventq_->UsedPhys(),
+        input.eventq_->Size());
+    if (!setup) {
+      return std::unexpected(setup.error());
+    }
+
+    // 3. 预投递全部事件缓冲区（DRIVER_OK 之前，无需通知设备）
+    input.eventq_->BeginBatch();
+    for (uint32_t slot = 0; slot < queue_size; ++slot) {
+      if (!input.PostBuffer(static_cast<uint16_t>(slot))) {
+        return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
+      }
+    }
+    input.eventq_->EndBatch();
+    input.old_avail_idx_ = input.eventq_->AvailIdx();
+    DmaSyncForDevice<Traits>(vq_dma_buf, CalcDmaSize(queue_size));
+
+    auto activate_result = initializer.Activate();
+    if (!activate_result) {
+      return std::unexpected(activate_result.error());
+    }
+    return input;
+  }
+
+  // ======== 配置缓存 ========
+
+  /**
+   * @brief 读取并缓存设备配置
+   *
+   * 依次选择 ID_NAME、ID_SERIAL、ID_DEVIDS、PROP_BITS、每种事件类型的
+   * EV_BITS 以及每个受支持坐标轴的 ABS_INFO。每项读取前后比较
+   * config_generation，不一致时重读该项。
+   *
+   * @return 成功或失败（配置持续变化时返回 kTimeout）
+   * @see virtio-v1.2#5.8.5 Device Initialization
+   */
+  [[nodiscard]] auto LoadConfig() -> Expected<void> {
+    config_loaded_ = false;
+    uint8_t data[kInputConfigDataSize];
+
+    auto size = ReadConfigBlock(InputConfigSelect::kIdName, 0, data);
+    if (!size) {
+      return std::unexpected(size.error());
+    }
+    CopyString(name_, data, *size);
+
+    size = ReadConfigBlock(InputConfigSelect::kIdSerial, 0, data);
+    if (!size) {
+      return std::unexpected(size.error());
+    }
+    CopyString(serial_, data, *size);
+
+    devids_ = {};
+    size = ReadConfigBlock(InputConfigSelect::kIdDevids, 0, data);
+    if (!size) {
+      return std::unexpected(size.error());
+    }
+    __builtin_memcpy(&devids_, data,
+                     *size < sizeof(devids_) ? *size : sizeof(devids_));
+
+    prop_bits_ = 0;
+    size = ReadConfigBlock(InputConfigSelect::kPropBits, 0, data);
+    if (!size) {
+      return std::unexpected(size.error());
+    }
+    __builtin_memcpy(&prop_bits_, data,
+                     *size < sizeof(prop_bits_) ? *size : sizeof(prop_bits_));
+
+    ev_types_ = 0;
+    for (size_t i = 0; i < kEvBitsCacheSize; ++i) {
+      ev_bits_[i] = 0;
+    }
+    for (uint32_t type = 0; type < kInputEventTypeCount; ++type) {
+      size = ReadConfigBlock(InputConfigSelect::kEvBits,
+                             static_cast<uint8_t>(type), data);
+      if (!size) {
+        return std::unexpected(size.error());
+      }
+      if (*size == 0) {
+        continue;
+      }
+      ev_types_ |= 1U << type;
+      size_t capacity = kEvBitsCapacity[type];
+      __builtin_memcpy(ev_bits_ + EvBitsOffset(type), data,
+                       *size < capacity ? *size : capacity);
+    }
+
+    for (uint32_t axis = 0; axis < kInputAbsAxisCount; ++axis) {
+      abs_info_[axis] = {};
+      if (!HasEventCode(static_cast<uint16_t>(InputEventType::kAbs),
+                        static_cast<uint16_t>(axis))) {
+        continue;
+      }
+      size = ReadConfigBlock(InputConfigSelect::kAbsInfo,
+                             static_cast<uint8_t>(axis), data);
+      if (!size) {
+        return std::unexpected(size.error());
+      }
+      __builtin_memcpy(&abs_info_[axis], data,
+                       *size < sizeof(InputAbsInfo) ? *size
+                                                    : sizeof(InputAbsInfo));
+    }
+    transport_.WriteConfigU8(static_cast<uint32_t>(InputConfigOffset::kSelect),
+                             static_cast<uint8_t>(InputConfigSelect::kUnset));
+    config_loaded_ = true;
+    return {};
+  }
+
+  /// @brief 配置是否已由 LoadConfig() 缓存
+  [[nodiscard]] auto IsConfigLoaded() const -> bool { return config_loaded_; }
+
+  /// @brief 设备名称（以 NUL 结尾）
+  [[nodiscard]] auto GetName() const -> const char* { return name_; }
+
+  /// @brief 设备序列号（以 NUL 结尾，设备未提供时为空串）
+  [[nodiscard]] auto GetSerial() const -> const char* { return serial_; }
+
+  /// @brief 设备标识
+  [[nodiscard]] auto GetDevIds() const -> InputDevIds { return devids_; }
+
+  /**
+   * @brief 检查设备属性（INPUT_PROP_*）
+   *
+   * @param prop 属性编号
+   */
+  [[nodiscard]] auto HasProperty(uint32_t prop) const -> bool {
+    return prop < 32 && (prop_bits_ & (1U << prop)) != 0;
+  }
+
+  /**
+   * @brief 检查设备是否产生某类事件
+   *
+   * @param type 事件类型（InputEventType）
+   */
+  [[nodiscard]] auto HasEventType(uint16_t type) const -> bool {
+    return type < kInputEventTypeCount && (ev_types_ & (1U << type)) != 0;
+  }
+
+  /**
+   * @brief 检查设备是否产生某个事件码
+   *
+   * 超出缓存容量（Linux evdev 定义范围）的事件码返回 false。
+   *
+   * @param type 事件类型（InputEventType）
+   * @param code 事件码
+   */
+  [[nodiscard]] auto HasEventCode(uint16_t type, uint16_t code) const -> bool {
+    if (type >= kInputEventTypeCount || code / 8U >= kEvBitsCapacity[type]) {
+      return false;
+    }
+    return (ev_bits_[EvBitsOffset(type) + code / 8U] & (1U << (code % 8U))) !=
+           0;
+  }
+
+  /**
+   * @brief 获取绝对坐标轴的取值范围
+   *
+   * @param axis 坐标轴编号（ABS_*）
+   * @return 取值范围；设备不支持该坐标轴时返回 kInvalidArgument
+   */
+  [[nodiscard]] auto GetAbsInfo(uint16_t axis) const -> Expected<InputAbsInfo> {
+    if (axis >= kInputAbsAxisCount ||
+        !HasEventCode(static_cast<uint16_t>(InputEventType::kAbs), axis)) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    return abs_info_[axis];
+  }
+
+  // ======== 事件读取 ========
+
+  /**
+   * @brief 批量读取已到达的事件
+   *
+   * 取出的事件缓冲区以一批重新投递并最多通知设备一次。事件环读空后
+   * 重新开启 Used Buffer 通知（见 HandleInterrupt()）。
+   *
+   * @param events 事件输出缓冲区
+   * @return 读出的事件数（没有事件时为 0，不阻塞）
+   */
+  auto Read(std::span<InputEvent> events) -> size_t {
+    size_t count = 0;
+    bool drained = false;
+    while (count < events.size()) {
+      auto used = eventq_->PopUsed();
+      if (!used) {
+        drained = true;
+        break;
+      }
+      auto head = static_cast<uint16_t>(used->id);
+      uint16_t slot = head_map_[head];
+      (void)eventq_->FreeChain(head);
+      if (used->len >= sizeof(InputEvent)) {
+        DmaSyncForCpu<Traits>(&events_[slot], sizeof(InputEvent));
+        events[count++] = events_[slot];
+      }
+      refill_[refill_count_++] = slot;
+    }
+    Refill();
+
+    if (count != 0) {
+      stats_.events += count;
+      stats_.reads++;
+    }
+    if (drained && !notify_armed_) {
+      // 重新开启通知后可能已有新事件到达，由调用者下次 Read() 取出
+      notify_armed_ = true;
+      (void)eventq_->EnableUsedNotify();
+    }
+    return count;
+  }
+
+  /**
+   * @brief 是否有尚未读取的事件
+   */
+  [[nodiscard]] auto HasEvents() const -> bool { return eventq_->HasUsed(); }
+
+  // ======== 中断 ========
+
+  /**
+   * @brief 中断处理
+   *
+   * 确认设备中断，并在事件环被 Read() 读空之前关闭 Used Buffer 通知。
+   */
+  auto HandleInterrupt() -> void {
+    transport_.AcknowledgeInterrupt();
+    stats_.interrupts++;
+    if (notify_armed_ && eventq_->HasUsed()) {
+      notify_armed_ = false;
+      eventq_->DisableUsedNotify();
+    }
+  }
+
+  // ======== 设备信息 ========
+
+  /**
+   * @brief 获取协商后的特性位
+   */
+  [[nodiscard]] auto GetNegotiatedFeatures() const -> uint64_t {
+    return negotiated_features_;
+  }
+
+  /**
+   * @brief 获取统计数据快照
+   */
+  [[nodiscard]] auto GetStats() const -> InputStats { return stats_; }
+
+  /// @name 移动/拷贝控制
+  /// @{
+  VirtioInput(VirtioInput&& other) noexcept
+      : transport_(std::move(other.transport_)) {
+    MoveFrom(other);
+  }
+  auto operator=(VirtioInput&& other) noexcept -> VirtioInput& {
+    if (this != &other) {
+      transport_ = std::move(other.transport_);
+      MoveFrom(other);
+    }
+    return *this;
+  }
+  VirtioInput(const VirtioInput&) = delete;
+  auto operator=(const VirtioInput&) -> VirtioInput& = delete;
+  ~VirtioInput() = default;
+  /// @}
+
+ private:
+  /// 事件队列的传输层索引
+  static constexpr uint16_t kEventQueueIndex = 0;
+  /// 配置读取的最大重试次数（config_generation 持续变化时）
+  static constexpr uint32_t kMaxConfigRetries = 1000;
+  /// 事件缓冲区数组的对齐（不小于一个缓存行）
+  static constexpr size_t kEventDmaAlign =
+      DmaCacheLineSize<Traits>() > kDefaultCacheLineSize
+          ? DmaCacheLineSize<Traits>()
+          : kDefaultCacheLineSize;
+
+  /**
+   * @brief 各事件类型缓存的事件码位图字节数
+   *
+   * 按 Linux evdev 的 *_CNT 取整到字节，未定义的类型只记录是否支持。
+   */
+  static constexpr uint8_t kEvBitsCapacity[kInputEventTypeCount] = {
+      2,  96, 2, 8, 1, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+      0,  2,  1, 0, 1, 16, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+  };
+
+  /// @brief 事件类型 type 的位图在 ev_bits_ 中的偏移
+  [[nodiscard]] static constexpr auto EvBitsOffset(uint32_t type) -> size_t {
+    size_t offset = 0;
+    for (uint32_t i = 0; i < type; ++i) {
+      offset += kEvBitsCapacity[i];
+    }
+    return offset;
+  }
+
+  /// ev_bits_ 总字节数
+  static constexpr size_t kEvBitsCacheSize =
+      EvBitsOffset(kInputEventTypeCount);
+
+  /// @name DMA 区域内各部分的偏移
+  /// @{
+  [[nodiscard]] static constexpr auto GetHeadMapOffset(uint32_t queue_size)
+      -> size_t {
+    // 始终按 event_idx=true 分配，因为特性协商在分配之后
+    return AlignUp(
+        VirtqueueT<Traits>::CalcSize(static_cast<uint16_t>(queue_size), true),
+        alignof(uint16_t));
+  }
+  [[nodiscard]] static constexpr auto GetEventOffset(uint32_t queue_size)
+      -> size_t {
+    // 设备写入的事件缓冲区不与 CPU 写入的映射表共享缓存行
+    return AlignUp(GetHeadMapOffset(queue_size) + sizeof(uint16_t) * queue_size,
+                   kEventDmaAlign);
+  }
+  /// @}
+
+  /**
+   * @brief 私有构造函数
+   *
+   * 只能通过 Create() 静态工厂方法创建实例。
+   */
+  explicit VirtioInput(TransportT<Traits> transport)
+      : transport_(std::move(transport)) {}
+
+  /**
+   * @brief 读取一项配置
+   *
+   * @param select 选择器
+   * @param subsel 子选择器
+   * @param data 输出缓冲区
+   * @return 该项的有效字节数（0 表示设备不支持）
+   */
+  [[nodiscard]] auto ReadConfigBlock(InputConfigSelect select, uint8_t subsel,
+                                     uint8_t (&data)[kInputConfigDataSize])
+      -> Expected<size_t> {
+    for (uint32_t retry = 0; retry < kMaxConfigRetries; ++retry) {
+      uint32_t generation = transport_.GetConfigGeneration();
+      transport_.WriteConfigU8(
+          static_cast<uint32_t>(InputConfigOffset::kSelect),
+          static_cast<uint8_t>(select));
+      transport_.WriteConfigU8(
+          static_cast<uint32_t>(InputConfigOffset::kSubsel), subsel);
+      size_t size = transport_.ReadConfigU8(
+          static_cast<uint32_t>(InputConfigOffset::kSize));
+      if (size > kInputConfigDataSize) {
+        size = kInputConfigDataSize;
+      }
+      for (size_t i = 0; i < size; ++i) {
+        data[i] = transport_.ReadConfigU8(
+            static_cast<uint32_t>(InputConfigOffset::kData) +
+            static_cast<uint32_t>(i));
+      }
+      if (transport_.GetConfigGeneration() == generation) {
+        return size;
+      }
+    }
+    return std::unexpected(Error{ErrorCode::kTimeout});
+  }
+
+  /// @brief 复制配置字符串并补 NUL
+  static auto CopyString(char (&dst)[kInputConfigDataSize + 1],
+                         const uint8_t* src, size_t size) -> void {
+    for (size_t i = 0; i < size; ++i) {
+      dst[i] = static_cast<char>(src[i]);
+    }
+    dst[size] = '\0';
+  }
+
+  /**
+   * @brief 把一个事件缓冲区投递到事件队列（不发布、不通知）
+   *
+   * @param slot 事件缓冲区索引
+   * @return 成功返回 true，描述符不足返回 false
+   */
+  auto PostBuffer(uint16_t slot) -> bool {
+    IoVec iov{static_cast<uintptr_t>(events_phys_ + slot * sizeof(InputEvent)),
+              sizeof(InputEvent)};
+    auto head = eventq_->SubmitChain(nullptr, 0, &iov, 1);
+    if (!head) {
+      return false;
+    }
+    head_map_[*head] = slot;
+    return true;
+  }
+
+  /**
+   * @brief 以一批重新投递已消耗的事件缓冲区并通知设备
+   */
+  auto Refill() -> void {
+    if (refill_count_ == 0) {
+      return;
+    }
+    eventq_->BeginBatch();
+    size_t posted = 0;
+    while (posted < refill_count_ && PostBuffer(refill_[posted])) {
+      ++posted;
+    }
+    eventq_->EndBatch();
+    // 描述符不足时（不应发生）保留未投递的缓冲区，下次再试
+    for (size_t i = posted; i < refill_count_; ++i) {
+      refill_[i - posted] = refill_[i];
+    }
+    refill_count_ -= posted;
+    stats_.refills += posted;
+    stats_.refill_batches++;
+    Kick();
+  }
+
+  /**
+   * @brief 按 Event Index 判断后通知设备，并统计通知与被抑制的通知
+   *
+   * @see virtio-v1.2#2.7.10 Available Buffer Notification Suppression
+   */
+  auto Kick() -> void {
+    if (KickVirtqueue<Traits>(transport_, kEventQueueIndex, *eventq_,
+                              old_avail_idx_, notification_data_)) {
+      stats_.kicks++;
+    } else {
+      stats_.kicks_elided++;
+    }
+  }
+
+  /**
+   * @brief 从另一个实例转移全部状态
+   *
+   * 映射表与事件缓冲区位于调用者提供的 DMA 区域内，移动只转移指针。
+   *
+   * @param other 源 VirtioInput 实例
+   */
+  auto MoveFrom(VirtioInput& other) -> void {
+    negotiated_features_ = other.negotiated_features_;
+    notification_data_ = other.notification_data_;
+    eventq_.reset();
+    if (other.eventq_.has_value()) {
+      eventq_.emplace(std::move(*other.eventq_));
+      other.eventq_.reset();
+    }
+    old_avail_idx_ = other.old_avail_idx_;
+    head_map_ = other.head_map_;
+    events_ = other.events_;
+    events_phys_ = other.events_phys_;
+    for (size_t i = 0; i < other.refill_count_; ++i) {
+      refill_[i] = other.refill_[i];
+    }
+    refill_count_ = other.refill_count_;
+    notify_armed_ = other.notify_armed_;
+    config_loaded_ = other.config_loaded_;
+    __builtin_memcpy(name_, other.name_, sizeof(name_));
+    __builtin_memcpy(serial_, other.serial_, sizeof(serial_));
+    devids_ = other.devids_;
+    prop_bits_ = other.prop_bits_;
+    ev_types_ = other.ev_types_;
+    __builtin_memcpy(ev_bits_, other.ev_bits_, sizeof(ev_bits_));
+    __builtin_memcpy(abs_info_, other.abs_info_, sizeof(abs_info_));
+    stats_ = other.stats_;
+    other.refill_count_ = 0;
+  }
+
+  /// 传输层实例
+  TransportT<Traits> transport_;
+  /// 协商后的特性位掩码
+  uint64_t negotiated_features_ = 0;
+  /// 是否已协商 VIRTIO_F_NOTIFICATION_DATA
+  bool notification_data_ = false;
+  /// 事件队列
+  std::optional<VirtqueueT<Traits>> eventq_;
+  /// 上次 Kick 事件队列时的 avail idx
+  uint16_t old_avail_idx_ = 0;
+  /// 描述符链头 → 事件缓冲区索引（仅 CPU 访问）
+  uint16_t* head_map_ = nullptr;
+  /// 事件缓冲区数组（DMA 内存，设备只写）
+  InputEvent* events_ = nullptr;
+  /// events_ 的物理地址
+  uint64_t events_phys_ = 0;
+  /// 待重新投递的事件缓冲区索引
+  uint16_t refill_[kMaxQueueSize]{};
+  /// 待重新投递的缓冲区数
+  size_t refill_count_ = 0;
+  /// Used Buffer 通知是否开启
+  bool notify_armed_ = true;
+  /// 配置是否已缓存
+  bool config_loaded_ = false;
+  /// 设备名称
+  char name_[kInputConfigDataSize + 1]{};
+  /// 序列号
+  char serial_[kInputConfigDataSize + 1]{};
+  /// 设备标识
+  InputDevIds devids_{};
+  /// 属性位图（INPUT_PROP_CNT = 32）
+  uint32_t prop_bits_ = 0;
+  /// 受支持的事件类型位图
+  uint32_t ev_types_ = 0;
+  /// 各事件类型的事件码位图（按 EvBitsOffset() 排列）
+  uint8_t ev_bits_[kEvBitsCacheSize]{};
+  /// 绝对坐标轴取值范围
+  InputAbsInfo abs_info_[kInputAbsAxisCount]{};
+  /// 统计数据
+  InputStats stats_{};
+};
+
+}  // namespace device_framework::detail::virtio::input
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_INPUT_HPP_ \
+        */
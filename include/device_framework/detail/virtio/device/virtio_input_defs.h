@@ -0,0 +1,144 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_INPUT_DEFS_H_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_INPUT_DEFS_H_
+
+#include <cstdint>
+
+namespace device_framework::detail::virtio::input {
+
+/**
+ * @brief 输入设备配置空间字段偏移量
+ * @see virtio-v1.2#5.8.4 Device configuration layout
+ */
+enum class InputConfigOffset : uint32_t {
+  /// 选择器（InputConfigSelect）
+  kSelect = 0,
+  /// 子选择器（事件类型或坐标轴编号）
+  kSubsel = 1,
+  /// 所选内容的有效字节数（0 表示不支持）
+  kSize = 2,
+  /// 数据区（字符串、位图或结构体）
+  kData = 8,
+};
+
+/// 配置空间数据区的最大字节数
+static constexpr uint32_t kInputConfigDataSize = 128;
+
+/**
+ * @brief 配置空间选择器取值
+ * @see virtio-v1.2#5.8.4 Device configuration layout
+ */
+enum class InputConfigSelect : uint8_t {
+  /// 未选择 (VIRTIO_INPUT_CFG_UNSET)
+  kUnset = 0x00,
+  /// 设备名称字符串 (VIRTIO_INPUT_CFG_ID_NAME)
+  kIdName = 0x01,
+  /// 序列号字符串 (VIRTIO_INPUT_CFG_ID_SERIAL)
+  kIdSerial = 0x02,
+  /// 总线/厂商/产品/版本 (VIRTIO_INPUT_CFG_ID_DEVIDS)
+  kIdDevids = 0x03,
+  /// 设备属性位图 (VIRTIO_INPUT_CFG_PROP_BITS)
+  kPropBits = 0x10,
+  /// subsel 指定事件类型的事件码位图 (VIRTIO_INPUT_CFG_EV_BITS)
+  kEvBits = 0x11,
+  /// subsel 指定坐标轴的取值范围 (VIRTIO_INPUT_CFG_ABS_INFO)
+  kAbsInfo = 0x12,
+};
+
+/**
+ * @brief 事件类型（与 Linux evdev 相同）
+ * @see virtio-v1.2#5.8.6 Device Operation
+ */
+enum class InputEventType : uint16_t {
+  /// 同步事件，标记一组事件的结束 (EV_SYN)
+  kSyn = 0x00,
+  /// 按键 (EV_KEY)
+  kKey = 0x01,
+  /// 相对坐标 (EV_REL)
+  kRel = 0x02,
+  /// 绝对坐标 (EV_ABS)
+  kAbs = 0x03,
+  /// 杂项 (EV_MSC)
+  kMsc = 0x04,
+  /// 开关 (EV_SW)
+  kSw = 0x05,
+  /// LED (EV_LED)
+  kLed = 0x11,
+  /// 声音 (EV_SND)
+  kSnd = 0x12,
+  /// 自动重复 (EV_REP)
+  kRep = 0x14,
+  /// 力反馈 (EV_FF)
+  kFf = 0x15,
+};
+
+/// 事件类型数量 (EV_CNT)
+static constexpr uint32_t kInputEventTypeCount = 0x20;
+
+/// 绝对坐标轴数量 (ABS_CNT)
+static constexpr uint32_t kInputAbsAxisCount = 0x40;
+
+/**
+ * @brief 输入事件
+ * @see virtio-v1.2#5.8.6 Device Operation
+ *
+ * @note 协议中所有字段采用小端格式
+ */
+struct InputEvent {
+  /// 事件类型 (InputEventType)
+  uint16_t type;
+  /// 事件码
+  uint16_t code;
+  /// 事件值
+  uint32_t value;
+} __attribute__((packed));
+
+static_assert(sizeof(InputEvent) == 8, "InputEvent must be 8 bytes");
+
+/**
+ * @brief 设备标识 (VIRTIO_INPUT_CFG_ID_DEVIDS)
+ */
+struct InputDevIds {
+  uint16_t bustype;
+  uint16_t vendor;
+  uint16_t product;
+  uint16_t version;
+} __attribute__((packed));
+
+/**
+ * @brief 绝对坐标轴取值范围 (VIRTIO_INPUT_CFG_ABS_INFO)
+ */
+struct InputAbsInfo {
+  uint32_t min;
+  uint32_t max;
+  uint32_t fuzz;
+  uint32_t flat;
+  uint32_t res;
+} __attribute__((packed));
+
+/**
+ * @brief 输入设备统计数据
+ */
+struct InputStats {
+  /// 已读取的事件数
+  uint64_t events{0};
+  /// 读出至少一个事件的 Read() 次数
+  uint64_t reads{0};
+  /// 重新投递的事件缓冲区数
+  uint64_t refills{0};
+  /// 批量重新投递的次数
+  uint64_t refill_batches{0};
+  /// 实际发出的队列通知次数
+  uint64_t kicks{0};
+  /// 借助 Event Index 省略的 Kick 次数
+  uint64_t kicks_elided{0};
+  /// 处理的设备中断次数
+  uint64_t interrupts{0};
+};
+
+}  // namespace device_framework::detail::virtio::input
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_INPUT_DEFS_H_ */
@@ -0,0 +1,200 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_INPUT_DEVICE_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_INPUT_DEVICE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "device_framework/detail/virtio/device/virtio_input.hpp"
+#include "device_framework/expected.hpp"
+#include "device_framework/ops/char_device.hpp"
+
+namespace device_framework::detail::virtio::input {
+
+/**
+ * @brief VirtIO 输入设备字符设备适配器
+ *
+ * 将底层 VirtioInput 驱动适配到统一的 CharDevice 接口，语义与 evdev 一致：
+ * - Open 时读取并缓存设备配置（名称、事件码位图等）
+ * - Read 以 InputEvent（8 字节）为单位返回已到达的事件，不阻塞；
+ *   缓冲区长度不足一个事件时返回 kInvalidArgument
+ * - Write 不支持（状态队列未使用）
+ *
+ * 使用示例：
+ * @code
+ * auto dev = VirtioInputDevice<MyTraits>::Create(mmio_base, dma_buf);
+ * dev->OpenReadOnly();
+ * alignas(InputEvent) uint8_t buf[64 * sizeof(InputEvent)];
+ * auto bytes = dev->Read(buf);  // 一次取出多个事件
+ * @endcode
+ *
+ * @tparam Traits 平台环境特征类型
+ * @tparam TransportT 传输层模板（默认 MmioTransport）
+ * @tparam VirtqueueT Virtqueue 模板（默认 SplitVirtqueue）
+ * @see CharDevice
+ * @see VirtioInput
+ */
+template <VirtioTraits Traits = NullVirtioTraits,
+          template <class> class TransportT = MmioTransport,
+          template <class> class VirtqueueT = SplitVirtqueue>
+class VirtioInputDevice
+    : public CharDevice<VirtioInputDevice<Traits, TransportT, VirtqueueT>> {
+ public:
+  /// 底层驱动类型别名
+  using DriverType = VirtioInput<Traits, TransportT, VirtqueueT>;
+
+  /**
+   * @brief 创建并初始化 VirtIO 输入设备（统一接口版）
+   *
+   * 参数含义见 VirtioInput::Create()。
+   *
+   * @return 成功返回 VirtioInputDevice 实例，失败返回错误
+   */
+  [[nodiscard]] static auto Create(uint64_t mmio_base, void* vq_dma_buf,
+                                   uint32_t queue_size = 64,
+                                   uint64_t driver_features = 0)
+      -> Expected<VirtioInputDevice> {
+    auto input_result = DriverType::Create(mmio_base, vq_dma_buf, queue_size,
+                                           driver_features);
+    if (!input_result) {
+      return std::unexpected(input_result.error());
+    }
+    return VirtioInputDevice(std::move(*input_result));
+  }
+
+  /**
+   * @brief 获取 DMA 缓冲区所需大小
+   */
+  [[nodiscard]] static constexpr auto CalcDmaSize(uint32_t queue_size = 64)
+      -> size_t {
+    return DriverType::CalcDmaSize(queue_size);
+  }
+
+  /// @brief 直接访问底层 VirtioInput 驱动
+  [[nodiscard]] auto GetDriver() -> DriverType& { return driver_; }
+  [[nodiscard]] auto GetDriver() const -> const DriverType& { return driver_; }
+
+  /// @name 移动/拷贝控制
+  /// @{
+  VirtioInputDevice(VirtioInputDevice&&) noexcept = default;
+  auto operator=(VirtioInputDevice&&) noexcept -> VirtioInputDevice& = default;
+  VirtioInputDevice(const VirtioInputDevice&) = delete;
+  auto operator=(const VirtioInputDevice&) -> VirtioInputDevice& = delete;
+  ~VirtioInputDevice() = default;
+  /// @}
+
+ protected:
+  /**
+   * @brief 打开设备并缓存设备配置
+   */
+  auto DoOpen(OpenFlags flags) -> Expected<void> {
+    if (!flags.CanRead()) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    auto result = driver_.LoadConfig();
+    if (!result) {
+      return std::unexpected(result.error());
+    }
+    return {};
+  }
+
+  /**
+   * @brief 释放设备
+   */
+  auto DoRelease() -> Expected<void> { return {}; }
+
+  /**
+   * @brief 批量读取事件
+   *
+   * @param buffer 目标缓冲区（按 InputEvent 解释，尾部不足一个事件的
+   *        字节不使用）
+   * @return 读出的字节数（sizeof(InputEvent) 的整数倍）
+   */
+  auto DoCharRead(std::span<uint8_t> buffer) -> Expected<size_t> {
+    size_t capacity = buffer.size() / sizeof(InputEvent);
+    if (capacity == 0) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    size_t count = driver_.Read(
+        std::span(reinterpret_cast<InputEvent*>(buffer.data()), capacity));
+    return count * sizeof(InputEvent);
+  }
+
+  /**
+   * @brief 查询就绪状态并刷新 GetPollReady() 缓存
+   */
+  auto DoPoll(PollEvents requested) -> Expected<PollEvents> {
+    return this->RefreshPollReady([this] { return Readiness(); }) &
+           requested;
+  }
+
+  /**
+   * @brief 输入设备中断处理（简化版）
+   *
+   * 关闭后续中断直到事件被读空，事件留给 Read() 读取。
+   */
+  auto DoHandleInterrupt() -> void {
+    driver_.HandleInterrupt();
+    this->RefreshPollReady([this] { return Readiness(); });
+  }
+
+  /**
+   * @brief 输入设备中断处理（带回调版）
+   *
+   * 读出全部已到达的事件，对每个事件调用 on_complete 回调。
+   *
+   * @tparam CompletionCallback 签名：void(const InputEvent& event)
+   * @param on_complete 每个事件调用一次的回调函数
+   */
+  template <typename CompletionCallback>
+  auto DoHandleInterrupt(CompletionCallback&& on_complete) -> void {
+    driver_.HandleInterrupt();
+    InputEvent chunk[kEventChunkSize];
+    while (true) {
+      size_t count = driver_.Read(chunk);
+      if (count == 0) {
+        break;
+      }
+      for (size_t i = 0; i < count; ++i) {
+        on_complete(chunk[i]);
+      }
+    }
+    this->RefreshPollReady([this] { return Readiness(); });
+  }
+
+ private:
+  /// @brief CRTP 基类需要访问 DoXxx 方法
+  template <class>
+  friend class ::device_framework::DeviceOperationsBase;
+  template <class>
+  friend class ::device_framework::CharDevice;
+
+  /// 中断处理中每次批量读取的事件数
+  static constexpr size_t kEventChunkSize = 32;
+
+  /**
+   * @brief 私有构造函数
+   *
+   * 只能通过 Create() 静态工厂方法创建实例。
+   */
+  explicit VirtioInputDevice(DriverType driver)
+      : driver_(std::move(driver)) {}
+
+  /// @brief 当前就绪状态
+  [[nodiscard]] auto Readiness() const -> PollEvents {
+    return PollEvents{driver_.HasEvents() ? PollEvents::kIn : 0U};
+  }
+
+  /// 底层驱动
+  DriverType driver_;
+};
+
+}  // namespace device_framework::detail::virtio::input
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_INPUT_DEVICE_HPP_ \
+        */
@@ -0,0 +1,1016 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_NET_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_NET_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "device_framework/detail/virtio/defs.h"
+#include "device_framework/detail/virtio/device/device_initializer.hpp"
+#include "device_framework/detail/virtio/device/virtio_net_defs.h"
+#include "device_framework/detail/virtio/traits.hpp"
+#include "device_framework/detail/virtio/transport/mmio.hpp"
+#include "device_framework/detail/virtio/virt_queue/misc.hpp"
+#include "device_framework/detail/virtio/virt_queue/split.hpp"
+#include "device_framework/expected.hpp"
+
+namespace device_framework::detail::virtio::net {
+
+/**
+ * @brief Virtio 网络设备驱动
+ *
+ * 每个队列对由一个接收队列（rx, 索引 2i）和一个发送队列（tx, 索引
+ * 2i+1）组成，可选的控制队列位于所有队列对之后。
+ *
+ * 该类封装了 VirtIO 网络设备的完整生命周期：
+ * - 传输层、Virtqueue 的创建与设备初始化序列（同 VirtioBlk）
+ * - 固定接收缓冲池：Create() 时把每个接收描述符都挂上一个 kRxBufSize
+ *   字节的缓冲区，Receive() 回调返回后原地重新投递，运行期不分配内存
+ * - VIRTIO_NET_F_MRG_RXBUF：一个接收包可跨多个缓冲区
+ * - 发送卸载：透传调用者提供的 NetHdr（校验和 / TSO）
+ * - 批量发送：Transmit() 只入队，KickTx() 一次通知；发送完成不产生
+ *   中断，由 ReapTx() 批量回收
+ * - Event Index 通知抑制与可选多队列（VIRTIO_NET_F_MQ）
+ *
+ * 同一队列对的收发可以在不同上下文中进行（收发队列互不共享状态），
+ * 但各自的提交与回收必须串行。
+ *
+ * @tparam Traits 平台环境特征类型
+ * @tparam TransportT 传输层模板（默认 MmioTransport）
+ * @tparam VirtqueueT Virtqueue 模板（默认 SplitVirtqueue）
+ * @see virtio-v1.2#5.1 Network Device
+ */
+template <VirtioTraits Traits = NullVirtioTraits,
+          template <class> class TransportT = MmioTransport,
+          template <class> class VirtqueueT = SplitVirtqueue>
+class VirtioNet {
+ public:
+  /// 发送回调中使用的用户自定义上下文指针类型
+  using UserData = void*;
+
+  /// 每个设备支持的最大队列对数（VIRTIO_NET_F_MQ）
+  static constexpr uint16_t kMaxQueuePairs = 4;
+
+  /// 每个队列的最大描述符数量
+  static constexpr uint32_t kMaxQueueSize = 1024;
+
+  /// 接收缓冲区大小（字节）：可容纳包头 + 1514 字节以太网帧
+  static constexpr size_t kRxBufSize = 2048;
+
+  /// 单个接收包最多占用的缓冲区数（64 KiB GSO 包合并到 kRxBufSize 缓冲区）
+  static constexpr size_t kMaxRxSegments =
+      (65535 + sizeof(NetHdr) + kRxBufSize - 1) / kRxBufSize;
+
+  /// 单个发送包最多的数据 IoVec 数量（不含包头）
+  static constexpr size_t kMaxTxSegments = 16;
+
+  /// DMA 布局中每个队列对区域的对齐要求（字节）
+  static constexpr size_t kQueueAlign = 4096;
+
+  /**
+   * @brief 接收包的一个数据段（指向接收缓冲池，回调返回后失效）
+   */
+  struct RxSegment {
+    /// 数据起始地址
+    const uint8_t* data;
+    /// 数据长度（字节）
+    size_t len;
+  };
+
+  /**
+   * @brief 传递给接收回调的包描述
+   */
+  struct RxPacket {
+    /// 设备写入的包头（位于第一个缓冲区开头）
+    const NetHdr* hdr;
+    /// 以太网帧数据段（不含包头）
+    RxSegment segments[kMaxRxSegments];
+    /// segments 中的有效段数
+    size_t segment_count;
+    /// 以太网帧总长度（字节）
+    size_t length;
+  };
+
+  /**
+   * @brief 获取相邻队列对区域的间距
+   *
+   * 区域内依次为接收 Virtqueue、发送 Virtqueue、发送包头数组、
+   * 描述符链头映射表、发送 token 数组，以及 queue_size 个接收缓冲区。
+   *
+   * @param queue_size 每个队列的描述符数量（2 的幂）
+   * @return 单个队列对区域按 kQueueAlign 对齐后的字节数
+   */
+  [[nodiscard]] static constexpr auto GetQueueStride(uint32_t queue_size)
+      -> size_t {
+    return AlignUp(GetRxPoolOffset(queue_size) + kRxBufSize * queue_size,
+                   kQueueAlign);
+  }
+
+  /**
+   * @brief 计算 DMA 缓冲区所需的字节数
+   *
+   * 调用者应据此预分配页对齐、已清零的 DMA 内存。队列对 i 位于
+   * `i * GetQueueStride(queue_size)` 偏移处，控制队列区域位于最后。
+   *
+   * @param queue_pairs 请求的队列对数
+   * @param queue_size 每个队列的描述符数量（2 的幂，默认 128）
+   * @return 所需的 DMA 内存字节数
+   */
+  [[nodiscard]] static constexpr auto CalcDmaSize(uint16_t queue_pairs = 1,
+                                                  uint32_t queue_size = 128)
+      -> size_t {
+    return GetQueueStride(queue_size) * queue_pairs + GetCtrlRegionSize();
+  }
+
+  /**
+   * @brief 创建并初始化网络设备
+   *
+   * 内部自动完成：
+   * 1. Transport 初始化和验证
+   * 2. VirtIO 设备初始化序列（重置、特性协商）
+   * 3. 创建收发队列，并用接收缓冲池填满每个接收队列
+   * 4. 设备激活；queue_pairs > 1 时通过控制队列启用多队列
+   *
+   * 默认请求 MAC、STATUS、MRG_RXBUF 以及发送方向的校验和 / TSO 卸载；
+   * 接收方向的卸载（kGuestCsum、kGuestTso4 等）需通过 driver_features
+   * 显式请求，此时接收回调须按 NetHdr::flags 处理部分校验和的包。
+   * 接收 TSO 包要求协商 MRG_RXBUF，否则 Create() 失败。
+   *
+   * @param mmio_base MMIO 设备基地址
+   * @param vq_dma_buf 预分配的 DMA 缓冲区虚拟地址
+   *        （页对齐，已清零，大小 >= CalcDmaSize()）
+   * @param queue_pairs 期望的队列对数
+   * @param queue_size 每个队列的描述符数量（2 的幂，<= kMaxQueueSize）
+   * @param driver_features 额外的驱动特性位（VERSION_1 自动包含）
+   * @return 成功返回 VirtioNet 实例，失败返回错误
+   * @see virtio-v1.2#5.1.5 Device Initialization
+   */
+  [[nodiscard]] static auto Create(uint64_t mmio_base, void* vq_dma_buf,
+                                   uint16_t queue_pairs = 1,
+                                   uint32_t queue_size = 128,
+                                   uint64_t driver_features = 0)
+      -> Expected<VirtioNet> {
+    if (queue_pairs == 0 || vq_dma_buf == nullptr ||
+        queue_size > kMaxQueueSize || !IsPowerOfTwo(queue_size)) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    if (queue_pairs > kMaxQueuePairs) {
+      Traits::Log("Requested %u queue pairs, limited to %u", queue_pairs,
+                  kMaxQueuePairs);
+      queue_pairs = kMaxQueuePairs;
+    }
+
+    // 1. 创建传输层
+    TransportT<Traits> transport(mmio_base);
+    if (!transport.IsValid()) {
+      return std::unexpected(Error{ErrorCode::kTransportNotInitialized});
+    }
+    if (transport.GetDeviceId() !=
+        static_cast<uint32_t>(DeviceId::kNetwork)) {
+      return std::unexpected(Error{ErrorCode::kInvalidDeviceId});
+    }
+    VirtioNet net(std::move(transport));
+
+    // 2. 设备初始化序列
+    DeviceInitializer<Traits, TransportT<Traits>> initializer(net.transport_);
+
+    uint64_t wanted_features =
+        static_cast<uint64_t>(ReservedFeature::kVersion1) |
+        static_cast<uint64_t>(ReservedFeature::kEventIdx) |
+        static_cast<uint64_t>(NetFeatureBit::kMac) |
+        static_cast<uint64_t>(NetFeatureBit::kStatus) |
+        static_cast<uint64_t>(NetFeatureBit::kMrgRxbuf) |
+        static_cast<uint64_t>(NetFeatureBit::kCsum) |
+        static_cast<uint64_t>(NetFeatureBit::kHostTso4) |
+        static_cast<uint64_t>(NetFeatureBit::kHostTso6) |
+        VirtqueueT<Traits>::kRequiredFeatures | driver_features;
+    if (queue_pairs > 1) {
+      wanted_features |= static_cast<uint64_t>(NetFeatureBit::kCtrlVq) |
+                         static_cast<uint64_t>(NetFeatureBit::kMq);
+    }
+    if constexpr (NotificationDataTransport<TransportT<Traits>>) {
+      wanted_features |=
+          static_cast<uint64_t>(ReservedFeature::kNotificationData);
+    }
+    auto negotiated_result = initializer.Init(wanted_features);
+    if (!negotiated_result) {
+      return std::unexpected(negotiated_result.error());
+    }
+    uint64_t negotiated = *negotiated_result;
+    net.negotiated_features_ = negotiated;
+
+    if ((negotiated & static_cast<uint64_t>(ReservedFeature::kVersion1)) == 0) {
+      Traits::Log("Device does not support VERSION_1 (modern mode)");
+      return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
+    }
+    constexpr uint64_t kVqFeatures = VirtqueueT<Traits>::kRequiredFeatures;
+    if ((negotiated & kVqFeatures) != kVqFeatures) {
+      Traits::Log("Device does not support the requested virtqueue format");
+      return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
+    }
+    // 不合并缓冲区时单个接收缓冲区必须能容纳整个 GSO 包
+    constexpr uint64_t kGuestGso =
+        static_cast<uint64_t>(NetFeatureBit::kGuestTso4) |
+        static_cast<uint64_t>(NetFeatureBit::kGuestTso6) |
+        static_cast<uint64_t>(NetFeatureBit::kGuestUfo);
+    if ((negotiated & kGuestGso) != 0 &&
+        (negotiated & static_cast<uint64_t>(NetFeatureBit::kMrgRxbuf)) == 0) {
+      Traits::Log("Guest GSO requires VIRTIO_NET_F_MRG_RXBUF");
+      return std::unexpected(Error{ErrorCode::kFeatureNegotiationFailed});
+    }
+
+    bool event_idx =
+        (negotiated & static_cast<uint64_t>(ReservedFeature::kEventIdx)) != 0;
+    net.notification_data_ =
+        (negotiated &
+         static_cast<uint64_t>(ReservedFeature::kNotificationData)) != 0;
+
+    // 根据设备报告的 max_virtqueue_pairs 确定实际队列对数与控制队列索引
+    uint16_t num_pairs = 1;
+    uint16_t device_pairs = 1;
+    if ((negotiated & static_cast<uint64_t>(NetFeatureBit::kMq)) != 0) {
+      device_pairs = net.transport_.ReadConfigU16(
+          static_cast<uint32_t>(NetConfigOffset::kMaxVirtqueuePairs));
+      if (device_pairs == 0) {
+        device_pairs = 1;
+      }
+      num_pairs = device_pairs < queue_pairs ? device_pairs : queue_pairs;
+      Traits::Log("VIRTIO_NET_F_MQ negotiated: device=%u, using %u pairs",
+                  device_pairs, num_pairs);
+    } else if (queue_pairs > 1) {
+      Traits::Log("Device does not support VIRTIO_NET_F_MQ, using 1 pair");
+    }
+
+    // 3. 创建收发队列（每个队列对占用独立的 DMA 区域）
+    const size_t stride = GetQueueStride(queue_size);
+    auto* dma_base = static_cast<uint8_t*>(vq_dma_buf);
+    uint64_t dma_phys = Traits::VirtToPhys(vq_dma_buf);
+    for (uint16_t i = 0; i < num_pairs; ++i) {
+      auto& pair = net.pairs_[i];
+      uint8_t* base = dma_base + i * stride;
+      uint64_t phys = dma_phys + i * stride;
+      pair.rx.emplace(base, phys, static_cast<uint16_t>(queue_size),
+                      event_idx);
+      pair.tx.emplace(base + GetTxVqOffset(queue_size),
+                      phys + GetTxVqOffset(queue_size),
+                      static_cast<uint16_t>(queue_size), event_idx);
+      if (!pair.rx->IsValid() || !pair.tx->IsValid()) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
+      pair.tx_hdrs =
+          reinterpret_cast<NetHdr*>(base + GetTxHdrOffset(queue_size));
+      pair.tx_hdrs_phys = phys + GetTxHdrOffset(queue_size);
+      pair.tx_map =
+          reinterpret_cast<uint16_t*>(base + GetTxMapOffset(queue_size));
+      pair.rx_map =
+          reinterpret_cast<uint16_t*>(base + GetRxMapOffset(queue_size));
+      pair.tx_tokens =
+          reinterpret_cast<UserData*>(base + GetTxTokenOffset(queue_size));
+      pair.rx_pool = base + GetRxPoolOffset(queue_size);
+      pair.rx_pool_phys = phys + GetRxPoolOffset(queue_size);
+      pair.tx_slots.Reset(queue_size);
+
+      auto rx_setup = initializer.SetupQueue(
+          RxQueueIndex(i), pair.rx->DescPhys(), pair.rx->AvailPhys(),
+          pair.rx->UsedPhys(), pair.rx->Size());
+      if (!rx_setup) {
+        return std::unexpected(rx_setup.error());
+      }
+      auto tx_setup = initializer.SetupQueue(
+          TxQueueIndex(i), pair.tx->DescPhys(), pair.tx->AvailPhys(),
+          pair.tx->UsedPhys(), pair.tx->Size());
+      if (!tx_setup) {
+        return std::unexpected(tx_setup.error());
+      }
+
+      // 发送完成由 ReapTx() 批量回收，不需要 Used Buffer 通知
+      pair.tx->DisableUsedNotify();
+
+      // 预投递全部接收缓冲区
+      pair.rx->BeginBatch();
+      for (uint32_t buf = 0; buf < queue_size; ++buf) {
+        if (!net.PostRxBuffer(pair, static_cast<uint16_t>(buf))) {
+          return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
+        }
+      }
+      pair.rx->EndBatch();
+    }
+    net.pair_count_ = num_pairs;
+
+    // 控制队列位于设备全部队列对之后
+    if ((negotiated & static_cast<uint64_t>(NetFeatureBit::kCtrlVq)) != 0) {
+      size_t ctrl_offset = stride * queue_pairs;
+      net.ctrl_queue_index_ = static_cast<uint16_t>(device_pairs * 2);
+      net.ctrl_.emplace(dma_base + ctrl_offset, dma_phys + ctrl_offset,
+                        kCtrlQueueSize, event_idx);
+      if (!net.ctrl_->IsValid()) {
+        return std::unexpected(Error{ErrorCode::kInvalidArgument});
+      }
+      net.ctrl_dma_ = dma_base + ctrl_offset + GetCtrlDmaOffset();
+      net.ctrl_dma_phys_ = dma_phys + ctrl_offset + GetCtrlDmaOffset();
+      auto ctrl_setup = initializer.SetupQueue(
+          net.ctrl_queue_index_, net.ctrl_->DescPhys(),
+          net.ctrl_->AvailPhys(), net.ctrl_->UsedPhys(), net.ctrl_->Size());
+      if (!ctrl_setup) {
+        return std::unexpected(ctrl_setup.error());
+      }
+      net.ctrl_->DisableUsedNotify();
+    }
+    // 激活前把各队列对与控制队列的环形结构刷到设备可见的内存
+    DmaSyncForDevice<Traits>(vq_dma_buf, CalcDmaSize(queue_pairs, queue_size));
+
+    // 4. 激活设备
+    auto activate_result = initializer.Activate();
+    if (!activate_result) {
+      return std::unexpected(activate_result.error());
+    }
+    for (uint16_t i = 0; i < num_pairs; ++i) {
+      net.Kick(RxQueueIndex(i), *net.pairs_[i].rx, net.pairs_[i].rx_old_avail,
+               net.pairs_[i].stats);
+    }
+    if (num_pairs > 1) {
+      auto mq_result = net.SetQueuePairs(num_pairs);
+      if (!mq_result) {
+        return std::unexpected(mq_result.error());
+      }
+    }
+
+    if ((negotiated & static_cast<uint64_t>(NetFeatureBit::kMac)) != 0) {
+      for (size_t i = 0; i < kMacLen; ++i) {
+        net.mac_[i] = net.transport_.ReadConfigU8(
+            static_cast<uint32_t>(NetConfigOffset::kMac) +
+            static_cast<uint32_t>(i));
+      }
+    }
+    return net;
+  }
+
+  // ======== 接收 ========
+
+  /**
+   * @brief 处理接收队列中已到达的包
+   *
+   * 对每个包调用一次 on_packet，回调返回后包所占的缓冲区立即重新投递
+   * 给设备（批量发布，一次 Kick）。回调不得保留 RxPacket 中的指针。
+   * 处理完成后恢复接收通知；若恢复期间又有新包到达则继续处理，
+   * 直到队列为空或达到 budget。
+   *
+   * @tparam PacketCallback 签名要求：void(const RxPacket& packet)
+   * @param pair_index 队列对索引（< GetQueuePairCount()）
+   * @param on_packet 接收回调
+   * @param budget 本次最多处理的包数
+   * @return 本次处理（含丢弃）的包数
+   * @see virtio-v1.2#5.1.6.4 Processing of Incoming Packets
+   */
+  template <typename PacketCallback>
+  auto Receive(uint16_t pair_index, PacketCallback&& on_packet,
+               size_t budget = SIZE_MAX) -> size_t {
+    if (pair_index >= pair_count_) {
+      return 0;
+    }
+    auto& pair = pairs_[pair_index];
+    auto& vq = *pair.rx;
+
+    size_t processed = 0;
+    do {
+      vq.BeginBatch();
+      while (processed < budget && vq.HasUsed()) {
+        ReceiveOne(pair, on_packet);
+        ++processed;
+      }
+      vq.EndBatch();
+      if (processed >= budget) {
+        break;
+      }
+    } while (!vq.EnableUsedNotify());
+
+    if (processed > 0) {
+      Kick(RxQueueIndex(pair_index), vq, pair.rx_old_avail, pair.stats);
+    }
+    return processed;
+  }
+
+  // ======== 发送 ========
+
+  /**
+   * @brief 提交一个待发送的包（仅入队描述符，不触发硬件通知）
+   *
+   * 包头复制到驱动管理的包头数组中，帧数据缓冲区须保持有效直到 ReapTx()
+   * 为其 token 调用回调。调用者需随后调用 KickTx() 通知设备。
+   *
+   * 发送队列满时返回 kNoFreeDescriptors，调用者应先调用 ReapTx() 回收。
+   *
+   * @param pair_index 队列对索引（< GetQueuePairCount()）
+   * @param frame 以太网帧数据 IoVec 数组（物理地址 + 长度）
+   * @param frame_count frame 数组中的元素数量（1..kMaxTxSegments）
+   * @param hdr 卸载参数（校验和 / GSO），nullptr 表示无卸载
+   * @param token 用户自定义上下文指针，在 ReapTx 回调时原样传回
+   * @return 成功或失败
+   * @see virtio-v1.2#5.1.6.2 Packet Transmission
+   */
+  [[nodiscard]] auto Transmit(uint16_t pair_index, const IoVec* frame,
+                              size_t frame_count, const NetHdr* hdr = nullptr,
+                              UserData token = nullptr) -> Expected<void> {
+    if (pair_index >= pair_count_ || frame == nullptr || frame_count == 0 ||
+        frame_count > kMaxTxSegments) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    auto& pair = pairs_[pair_index];
+    auto& vq = *pair.tx;
+
+    if (vq.NumFree() < frame_count + 1) {
+      pair.stats.queue_full_errors++;
+      return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
+    }
+    size_t slot = pair.tx_slots.Alloc();
+    if (slot == TxSlotBitmap::kInvalid) {
+      pair.stats.queue_full_errors++;
+      return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
+    }
+
+    NetHdr* slot_hdr = &pair.tx_hdrs[slot];
+    if (hdr != nullptr) {
+      *slot_hdr = *hdr;
+      slot_hdr->num_buffers = 0;
+    } else {
+      *slot_hdr = {};
+    }
+    DmaSyncForDevice<Traits>(slot_hdr, sizeof(NetHdr));
+
+    IoVec iovs[kMaxTxSegments + 1];
+    iovs[0] = {static_cast<uintptr_t>(pair.tx_hdrs_phys +
+                                      slot * sizeof(NetHdr)),
+               sizeof(NetHdr)};
+    size_t bytes = 0;
+    for (size_t i = 0; i < frame_count; ++i) {
+      iovs[i + 1] = frame[i];
+      bytes += frame[i].len;
+    }
+
+    auto head = vq.SubmitChain(iovs, frame_count + 1, nullptr, 0);
+    if (!head) {
+      pair.tx_slots.Free(slot);
+      pair.stats.queue_full_errors++;
+      return std::unexpected(head.error());
+    }
+    pair.tx_map[*head] = static_cast<uint16_t>(slot);
+    pair.tx_tokens[slot] = token;
+    pair.stats.tx_bytes += bytes;
+    return {};
+  }
+
+  /**
+   * @brief 通知设备发送队列中有新的待发送包
+   *
+   * 借助 Event Index，若设备尚未处理到上次通知的位置则省略通知。
+   *
+   * @param pair_index 队列对索引（< GetQueuePairCount()）
+   * @see virtio-v1.2#2.7.13 Supplying Buffers to The Device
+   */
+  auto KickTx(uint16_t pair_index) -> void {
+    if (pair_index >= pair_count_) {
+      return;
+    }
+    auto& pair = pairs_[pair_index];
+    Kick(TxQueueIndex(pair_index), *pair.tx, pair.tx_old_avail, pair.stats);
+  }
+
+  /**
+   * @brief 批量回收已发送完成的包
+   *
+   * 发送队列不产生完成中断，调用者可在每次提交前、定时器或 Receive()
+   * 之后调用此方法，一次回收所有已完成的包。
+   *
+   * @tparam TxCallback 签名要求：void(UserData token)
+   * @param pair_index 队列对索引（< GetQueuePairCount()）
+   * @param on_complete 完成回调（每个包调用一次）
+   * @return 本次回收的包数
+   */
+  template <typename TxCallback>
+  auto ReapTx(uint16_t pair_index, TxCallback&& on_complete) -> size_t {
+    if (pair_index >= pair_count_) {
+      return 0;
+    }
+    auto& pair = pairs_[pair_index];
+    auto& vq = *pair.tx;
+
+    size_t reaped = 0;
+    while (true) {
+      auto used = vq.PopUsed();
+      if (!used) {
+        break;
+      }
+      auto head = static_cast<uint16_t>(used->id);
+      uint16_t slot = pair.tx_map[head];
+      UserData token = pair.tx_tokens[slot];
+      (void)vq.FreeChain(head);
+      pair.tx_slots.Free(slot);
+      ++reaped;
+      on_complete(token);
+    }
+    pair.stats.tx_packets += reaped;
+    return reaped;
+  }
+
+  /// @brief 批量回收已发送完成的包（不关心 token）
+  auto ReapTx(uint16_t pair_index) -> size_t {
+    return ReapTx(pair_index, [](UserData) {});
+  }
+
+  // ======== 中断 ========
+
+  /**
+   * @brief 中断处理
+   *
+   * 确认设备中断，然后对每个队列对处理接收包并回收已完成的发送包。
+   *
+   * @tparam PacketCallback 签名要求：void(const RxPacket& packet)
+   * @tparam TxCallback 签名要求：void(UserData token)
+   * @param on_packet 接收回调
+   * @param on_tx_complete 发送完成回调
+   */
+  template <typename PacketCallback, typename TxCallback>
+  auto HandleInterrupt(PacketCallback&& on_packet, TxCallback&& on_tx_complete)
+      -> void {
+    transport_.AcknowledgeInterrupt();
+    if (pair_count_ > 0) {
+      pairs_[0].stats.interrupts_handled++;
+    }
+    for (uint16_t i = 0; i < pair_count_; ++i) {
+      Receive(i, on_packet);
+      ReapTx(i, on_tx_complete);
+    }
+  }
+
+  // ======== 设备信息 ========
+
+  /**
+   * @brief 获取设备 MAC 地址
+   *
+   * @return 6 字节 MAC 地址；未协商 VIRTIO_NET_F_MAC 时全为 0
+   */
+  [[nodiscard]] auto GetMac() const -> const uint8_t (&)[kMacLen] {
+    return mac_;
+  }
+
+  /**
+   * @brief 查询链路状态
+   *
+   * @return 链路已连接返回 true；未协商 VIRTIO_NET_F_STATUS 时始终为 true
+   */
+  [[nodiscard]] auto IsLinkUp() const -> bool {
+    if ((negotiated_features_ &
+         static_cast<uint64_t>(NetFeatureBit::kStatus)) == 0) {
+      return true;
+    }
+    return (transport_.ReadConfigU16(
+                static_cast<uint32_t>(NetConfigOffset::kStatus)) &
+            kNetStatusLinkUp) != 0;
+  }
+
+  /**
+   * @brief 获取协商后的特性位
+   */
+  [[nodiscard]] auto GetNegotiatedFeatures() const -> uint64_t {
+    return negotiated_features_;
+  }
+
+  /**
+   * @brief 获取实际使用的队列对数
+   */
+  [[nodiscard]] auto GetQueuePairCount() const -> uint16_t {
+    return pair_count_;
+  }
+
+  /**
+   * @brief 获取所有队列对统计数据之和的快照
+   */
+  [[nodiscard]] auto GetStats() const -> NetStats {
+    NetStats total{};
+    for (uint16_t i = 0; i < pair_count_; ++i) {
+      const auto& stats = pairs_[i].stats;
+      total.rx_packets += stats.rx_packets;
+      total.rx_bytes += stats.rx_bytes;
+      total.rx_dropped += stats.rx_dropped;
+      total.tx_packets += stats.tx_packets;
+      total.tx_bytes += stats.tx_bytes;
+      total.kicks_elided += stats.kicks_elided;
+      total.interrupts_handled += stats.interrupts_handled;
+      total.queue_full_errors += stats.queue_full_errors;
+    }
+    return total;
+  }
+
+  /// @name 移动/拷贝控制
+  /// @{
+  VirtioNet(VirtioNet&& other) noexcept
+      : transport_(std::move(other.transport_)) {
+    MoveFrom(other);
+  }
+  auto operator=(VirtioNet&& other) noexcept -> VirtioNet& {
+    if (this != &other) {
+      transport_ = std::move(other.transport_);
+      MoveFrom(other);
+    }
+    return *this;
+  }
+  VirtioNet(const VirtioNet&) = delete;
+  auto operator=(const VirtioNet&) -> VirtioNet& = delete;
+  ~VirtioNet() = default;
+  /// @}
+
+ private:
+  /// 发送包头槽位图类型
+  using TxSlotBitmap = SlotBitmap<kMaxQueueSize>;
+
+  /// 控制队列的描述符数量
+  static constexpr uint16_t kCtrlQueueSize = 16;
+  /// 单条控制命令的最大数据长度（字节）
+  static constexpr size_t kMaxCtrlDataLen = 64;
+  /// 缓存行大小（非一致性 DMA 平台上设备写入区域按此隔离）
+  static constexpr size_t kDmaLine = DmaCacheLineSize<Traits>();
+
+  /**
+   * @brief 控制命令 DMA 缓冲区
+   *
+   * 设备写入的 ack 与驱动写入的命令头/数据位于不同缓存行。
+   */
+  struct CtrlDma {
+    NetCtrlHdr hdr;
+    uint8_t data[kMaxCtrlDataLen];
+    alignas(kDmaLine) uint8_t ack;
+  };
+
+  /**
+   * @brief 单个队列对的运行状态
+   *
+   * 接收与发送队列互不共享可变状态。
+   */
+  struct QueuePair {
+    /// 接收 Virtqueue
+    std::optional<VirtqueueT<Traits>> rx;
+    /// 发送 Virtqueue
+    std::optional<VirtqueueT<Traits>> tx;
+    /// 接收缓冲池（DMA 内存，queue_size 个 kRxBufSize 字节缓冲区）
+    uint8_t* rx_pool = nullptr;
+    /// rx_pool 的物理地址
+    uint64_t rx_pool_phys = 0;
+    /// 接收描述符链头 → 缓冲区索引（仅 CPU 访问）
+    uint16_t* rx_map = nullptr;
+    /// 发送包头数组（DMA 内存，槽 i 使用第 i 项）
+    NetHdr* tx_hdrs = nullptr;
+    /// tx_hdrs 的物理地址
+    uint64_t tx_hdrs_phys = 0;
+    /// 发送描述符链头 → 包头槽索引（仅 CPU 访问）
+    uint16_t* tx_map = nullptr;
+    /// 各包头槽的用户 token（仅 CPU 访问）
+    UserData* tx_tokens = nullptr;
+    /// 包头槽占用位图
+    TxSlotBitmap tx_slots{};
+    /// 上次 Kick 接收队列时的 avail idx
+    uint16_t rx_old_avail = 0;
+    /// 上次 Kick 发送队列时的 avail idx
+    uint16_t tx_old_avail = 0;
+    /// 统计数据
+    NetStats stats{};
+  };
+
+  /// @name 队列对区域内各部分的偏移
+  /// @{
+  [[nodiscard]] static constexpr auto GetVqRegionSize(uint32_t queue_size)
+      -> size_t {
+    // 始终按 event_idx=true 分配，因为特性协商在分配之后
+    return AlignUp(
+        VirtqueueT<Traits>::CalcSize(static_cast<uint16_t>(queue_size), true),
+        kQueueAlign);
+  }
+  [[nodiscard]] static constexpr auto GetTxVqOffset(uint32_t queue_size)
+      -> size_t {
+    return GetVqRegionSize(queue_size);
+  }
+  [[nodiscard]] static constexpr auto GetTxHdrOffset(uint32_t queue_size)
+      -> size_t {
+    return 2 * GetVqRegionSize(queue_size);
+  }
+  [[nodiscard]] static constexpr auto GetTxMapOffset(uint32_t queue_size)
+      -> size_t {
+    return GetTxHdrOffset(queue_size) + sizeof(NetHdr) * queue_size;
+  }
+  [[nodiscard]] static constexpr auto GetRxMapOffset(uint32_t queue_size)
+      -> size_t {
+    return GetTxMapOffset(queue_size) + sizeof(uint16_t) * queue_size;
+  }
+  [[nodiscard]] static constexpr auto GetTxTokenOffset(uint32_t queue_size)
+      -> size_t {
+    return AlignUp(GetRxMapOffset(queue_size) + sizeof(uint16_t) * queue_size,
+                   alignof(UserData));
+  }
+  [[nodiscard]] static constexpr auto GetRxPoolOffset(uint32_t queue_size)
+      -> size_t {
+    return AlignUp(GetTxTokenOffset(queue_size) + sizeof(UserData) * queue_size,
+                   kQueueAlign);
+  }
+  [[nodiscard]] static constexpr auto GetCtrlDmaOffset() -> size_t {
+    return AlignUp(VirtqueueT<Traits>::CalcSize(kCtrlQueueSize, true),
+                   alignof(CtrlDma));
+  }
+  [[nodiscard]] static constexpr auto GetCtrlRegionSize() -> size_t {
+    return AlignUp(GetCtrlDmaOffset() + sizeof(CtrlDma), kQueueAlign);
+  }
+  /// @}
+
+  /// @brief 队列对 i 的接收队列索引
+  [[nodiscard]] static constexpr auto RxQueueIndex(uint16_t pair_index)
+      -> uint16_t {
+    return static_cast<uint16_t>(pair_index * 2);
+  }
+  /// @brief 队列对 i 的发送队列索引
+  [[nodiscard]] static constexpr auto TxQueueIndex(uint16_t pair_index)
+      -> uint16_t {
+    return static_cast<uint16_t>(pair_index * 2 + 1);
+  }
+
+  /**
+   * @brief 私有构造函数
+   *
+   * 只能通过 Create() 静态工厂方法创建实例。
+   */
+  explicit VirtioNet(TransportT<Traits> transport)
+      : transport_(std::move(transport)) {}
+
+  /**
+   * @brief 把接收缓冲区投递到接收队列
+   *
+   * @param pair 队列对
+   * @param buf 缓冲区索引
+   * @return 成功返回 true，描述符不足返回 false
+   */
+  auto PostRxBuffer(QueuePair& pair, uint16_t buf) -> bool {
+    IoVec iov{static_cast<uintptr_t>(pair.rx_pool_phys + buf * kRxBufSize),
+              kRxBufSize};
+    auto head = pair.rx->SubmitChain(nullptr, 0, &iov, 1);
+    if (!head) {
+      return false;
+    }
+    pair.rx_map[*head] = buf;
+    return true;
+  }
+
+  /**
+   * @brief 弹出一个已使用的接收缓冲区
+   *
+   * @param pair 队列对
+   * @param[out] buf 缓冲区索引
+   * @param[out] len 设备写入的字节数
+   * @return 成功返回 true，Used Ring 为空返回 false
+   */
+  auto PopRxBuffer(QueuePair& pair, uint16_t& buf, uint32_t& len) -> bool {
+    auto used = pair.rx->PopUsed();
+    if (!used) {
+      return false;
+    }
+    auto head = static_cast<uint16_t>(used->id);
+    buf = pair.rx_map[head];
+    len = used->len < kRxBufSize ? used->len : kRxBufSize;
+    (void)pair.rx->FreeChain(head);
+    DmaSyncForCpu<Traits>(pair.rx_pool + buf * kRxBufSize, len);
+    return true;
+  }
+
+  /**
+   * @brief 处理一个接收包并重新投递其缓冲区
+   *
+   * @param pair 队列对
+   * @param on_packet 接收回调
+   */
+  template <typename PacketCallback>
+  auto ReceiveOne(QueuePair& pair, PacketCallback& on_packet) -> void {
+    uint16_t bufs[kMaxRxSegments];
+    uint16_t buf = 0;
+    uint32_t len = 0;
+    if (!PopRxBuffer(pair, buf, len)) {
+      return;
+    }
+    bufs[0] = buf;
+    size_t buf_count = 1;
+    bool valid = len >= sizeof(NetHdr);
+
+    RxPacket packet{};
+    if (valid) {
+      const auto* hdr =
+          reinterpret_cast<const NetHdr*>(pair.rx_pool + buf * kRxBufSize);
+      packet.hdr = hdr;
+      packet.segments[0] = {pair.rx_pool + buf * kRxBufSize + sizeof(NetHdr),
+                            len - sizeof(NetHdr)};
+      packet.length = len - sizeof(NetHdr);
+
+      // 未协商 MRG_RXBUF 时 num_buffers 由设备置 1
+      size_t num_buffers = hdr->num_buffers == 0 ? 1 : hdr->num_buffers;
+      valid = num_buffers <= kMaxRxSegments;
+      // 即使包无效也要收回设备已填充的全部缓冲区
+      for (size_t i = 1; i < num_buffers; ++i) {
+        if (!PopRxBuffer(pair, buf, len)) {
+          valid = false;
+          break;
+        }
+        if (buf_count < kMaxRxSegments) {
+          bufs[buf_count] = buf;
+          packet.segments[buf_count] = {pair.rx_pool + buf * kRxBufSize, len};
+          packet.length += len;
+          ++buf_count;
+        } else {
+          PostRxBuffer(pair, buf);
+        }
+      }
+      packet.segment_count = buf_count;
+    }
+
+    if (valid) {
+      pair.stats.rx_packets++;
+      pair.stats.rx_bytes += packet.length;
+      on_packet(static_cast<const RxPacket&>(packet));
+    } else {
+      pair.stats.rx_dropped++;
+    }
+    for (size_t i = 0; i < buf_count; ++i) {
+      PostRxBuffer(pair, bufs[i]);
+    }
+  }
+
+  /**
+   * @brief 按 Event Index 判断后通知设备，并统计被抑制的通知
+   *
+   * @param queue_index 传输层队列索引
+   * @param vq 对应的 Virtqueue
+   * @param old_avail_idx 上次通知时的 avail idx（更新为当前值）
+   * @param stats 统计数据
+   * @see virtio-v1.2#2.7.10 Available Buffer Notification Suppression
+   */
+  auto Kick(uint16_t queue_index, VirtqueueT<Traits>& vq,
+            uint16_t& old_avail_idx, NetStats& stats) -> void {
+    if (!KickVirtqueue<Traits>(transport_, queue_index, vq, old_avail_idx,
+                               notification_data_)) {
+      stats.kicks_elided++;
+    }
+  }
+
+  /**
+   * @brief 通过控制队列设置启用的队列对数
+   *
+   * @param pairs 队列对数
+   * @return 成功或失败
+   * @see virtio-v1.2#5.1.6.5.5 Automatic receive steering in multiqueue mode
+   */
+  [[nodiscard]] auto SetQueuePairs(uint16_t pairs) -> Expected<void> {
+    uint8_t data[sizeof(uint16_t)] = {static_cast<uint8_t>(pairs & 0xFF),
+                                      static_cast<uint8_t>(pairs >> 8)};
+    return SendCtrl(kNetCtrlMq, kNetCtrlMqVqPairsSet, data, sizeof(data));
+  }
+
+  /**
+   * @brief 同步发送一条控制命令
+   *
+   * @param cls 命令类别
+   * @param cmd 命令
+   * @param data 命令数据
+   * @param len 数据长度（<= kMaxCtrlDataLen）
+   * @return 成功或失败；设备未确认时返回 kDeviceError
+   * @see virtio-v1.2#5.1.6.5 Control Virtqueue
+   */
+  [[nodiscard]] auto SendCtrl(uint8_t cls, uint8_t cmd, const uint8_t* data,
+                              size_t len) -> Expected<void> {
+    if (!ctrl_.has_value()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+    }
+    if (len > kMaxCtrlDataLen) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    auto* dma = reinterpret_cast<CtrlDma*>(ctrl_dma_);
+    dma->hdr = {cls, cmd};
+    for (size_t i = 0; i < len; ++i) {
+      dma->data[i] = data[i];
+    }
+    dma->ack = 0xFF;
+    DmaSyncForDevice<Traits>(dma, sizeof(CtrlDma));
+
+    IoVec readable[2] = {
+        {static_cast<uintptr_t>(ctrl_dma_phys_ + offsetof(CtrlDma, hdr)),
+         sizeof(NetCtrlHdr)},
+        {static_cast<uintptr_t>(ctrl_dma_phys_ + offsetof(CtrlDma, data)),
+         len},
+    };
+    IoVec writable{
+        static_cast<uintptr_t>(ctrl_dma_phys_ + offsetof(CtrlDma, ack)), 1};
+    auto head =
+        ctrl_->SubmitChain(readable, len > 0 ? 2 : 1, &writable, 1);
+    if (!head) {
+      return std::unexpected(head.error());
+    }
+    Traits::Wmb();
+    NotifyVirtqueue(transport_, ctrl_queue_index_, *ctrl_, notification_data_);
+
+    constexpr uint32_t spin_limit = [] {
+      if constexpr (SpinWaitTraits<Traits>) {
+        return static_cast<uint32_t>(Traits::kMaxSpinIterations);
+      } else {
+        return uint32_t{100000000};
+      }
+    }();
+    for (uint32_t i = 0; i < spin_limit; ++i) {
+      Traits::Rmb();
+      auto used = ctrl_->PopUsed();
+      if (!used) {
+        continue;
+      }
+      (void)ctrl_->FreeChain(static_cast<uint16_t>(used->id));
+      DmaSyncForCpu<Traits>(&dma->ack, 1);
+      if (dma->ack != kNetCtrlOk) {
+        return std::unexpected(Error{ErrorCode::kDeviceError});
+      }
+      return {};
+    }
+    return std::unexpected(Error{ErrorCode::kTimeout});
+  }
+
+  /**
+   * @brief 从另一个实例转移全部队列状态
+   *
+   * 缓冲池、包头数组与映射表位于调用者提供的 DMA 区域内，移动只转移
+   * 指针，其地址在移动前后不变。
+   *
+   * @param other 源 VirtioNet 实例
+   */
+  auto MoveFrom(VirtioNet& other) -> void {
+    negotiated_features_ = other.negotiated_features_;
+    pair_count_ = other.pair_count_;
+    notification_data_ = other.notification_data_;
+    for (size_t i = 0; i < kMacLen; ++i) {
+      mac_[i] = other.mac_[i];
+    }
+    for (uint16_t p = 0; p < kMaxQueuePairs; ++p) {
+      auto& dst = pairs_[p];
+      auto& src = other.pairs_[p];
+      dst.rx.reset();
+      dst.tx.reset();
+      if (src.rx.has_value()) {
+        dst.rx.emplace(std::move(*src.rx));
+        src.rx.reset();
+      }
+      if (src.tx.has_value()) {
+        dst.tx.emplace(std::move(*src.tx));
+        src.tx.reset();
+      }
+      dst.rx_pool = src.rx_pool;
+      dst.rx_pool_phys = src.rx_pool_phys;
+      dst.rx_map = src.rx_map;
+      dst.tx_hdrs = src.tx_hdrs;
+      dst.tx_hdrs_phys = src.tx_hdrs_phys;
+      dst.tx_map = src.tx_map;
+      dst.tx_tokens = src.tx_tokens;
+      dst.tx_slots = src.tx_slots;
+      dst.rx_old_avail = src.rx_old_avail;
+      dst.tx_old_avail = src.tx_old_avail;
+      dst.stats = src.stats;
+    }
+    ctrl_.reset();
+    if (other.ctrl_.has_value()) {
+      ctrl_.emplace(std::move(*other.ctrl_));
+      other.ctrl_.reset();
+    }
+    ctrl_queue_index_ = other.ctrl_queue_index_;
+    ctrl_dma_ = other.ctrl_dma_;
+    ctrl_dma_phys_ = other.ctrl_dma_phys_;
+    other.pair_count_ = 0;
+  }
+
+  /// 传输层实例
+  TransportT<Traits> transport_;
+  /// 协商后的特性位掩码
+  uint64_t negotiated_features_ = 0;
+  /// 队列对（仅前 pair_count_ 个有效）
+  QueuePair pairs_[kMaxQueuePairs];
+  /// 实际使用的队列对数
+  uint16_t pair_count_ = 0;
+  /// 是否已协商 VIRTIO_F_NOTIFICATION_DATA
+  bool notification_data_ = false;
+  /// 设备 MAC 地址
+  uint8_t mac_[kMacLen]{};
+  /// 控制队列（协商 VIRTIO_NET_F_CTRL_VQ 时创建）
+  std::optional<VirtqueueT<Traits>> ctrl_;
+  /// 控制队列的传输层索引
+  uint16_t ctrl_queue_index_ = 0;
+  /// 控制命令 DMA 缓冲区
+  uint8_t* ctrl_dma_ = nullptr;
+  /// ctrl_dma_ 的物理地址
+  uint64_t ctrl_dma_phys_ = 0;
+};
+
+}  // namespace device_framework::detail::virtio::net
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_NET_HPP_ \
+        */
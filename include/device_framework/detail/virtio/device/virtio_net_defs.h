@@ -0,0 +1,177 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_NET_DEFS_H_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_NET_DEFS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace device_framework::detail::virtio::net {
+
+/**
+ * @brief 网络设备特性位定义
+ * @see virtio-v1.2#5.1.3 Feature bits
+ *
+ * kGuest* 表示驱动能接收的卸载形式（设备 → 驱动），
+ * kHost* 表示设备能代为完成的卸载（驱动 → 设备）。
+ */
+enum class NetFeatureBit : uint64_t {
+  /// 设备可处理部分校验和的发送包 (VIRTIO_NET_F_CSUM)
+  kCsum = 1ULL << 0,
+  /// 驱动可处理部分校验和的接收包 (VIRTIO_NET_F_GUEST_CSUM)
+  kGuestCsum = 1ULL << 1,
+  /// 设备配置空间中 mtu 字段有效 (VIRTIO_NET_F_MTU)
+  kMtu = 1ULL << 3,
+  /// 设备配置空间中 mac 字段有效 (VIRTIO_NET_F_MAC)
+  kMac = 1ULL << 5,
+  /// 驱动可接收 TSOv4 (VIRTIO_NET_F_GUEST_TSO4)
+  kGuestTso4 = 1ULL << 7,
+  /// 驱动可接收 TSOv6 (VIRTIO_NET_F_GUEST_TSO6)
+  kGuestTso6 = 1ULL << 8,
+  /// 驱动可接收带 ECN 的 TSO (VIRTIO_NET_F_GUEST_ECN)
+  kGuestEcn = 1ULL << 9,
+  /// 驱动可接收 UFO (VIRTIO_NET_F_GUEST_UFO)
+  kGuestUfo = 1ULL << 10,
+  /// 设备可完成 TSOv4 分段 (VIRTIO_NET_F_HOST_TSO4)
+  kHostTso4 = 1ULL << 11,
+  /// 设备可完成 TSOv6 分段 (VIRTIO_NET_F_HOST_TSO6)
+  kHostTso6 = 1ULL << 12,
+  /// 设备可完成带 ECN 的 TSO 分段 (VIRTIO_NET_F_HOST_ECN)
+  kHostEcn = 1ULL << 13,
+  /// 设备可完成 UFO 分段 (VIRTIO_NET_F_HOST_UFO)
+  kHostUfo = 1ULL << 14,
+  /// 驱动可将一个接收包合并到多个缓冲区 (VIRTIO_NET_F_MRG_RXBUF)
+  kMrgRxbuf = 1ULL << 15,
+  /// 设备配置空间中 status 字段有效 (VIRTIO_NET_F_STATUS)
+  kStatus = 1ULL << 16,
+  /// 存在控制队列 (VIRTIO_NET_F_CTRL_VQ)
+  kCtrlVq = 1ULL << 17,
+  /// 控制队列支持接收模式设置 (VIRTIO_NET_F_CTRL_RX)
+  kCtrlRx = 1ULL << 18,
+  /// 控制队列支持 VLAN 过滤 (VIRTIO_NET_F_CTRL_VLAN)
+  kCtrlVlan = 1ULL << 19,
+  /// 驱动可发送免费 ARP (VIRTIO_NET_F_GUEST_ANNOUNCE)
+  kGuestAnnounce = 1ULL << 21,
+  /// 设备支持多队列对 (VIRTIO_NET_F_MQ)
+  kMq = 1ULL << 22,
+  /// 控制队列支持设置 MAC 地址 (VIRTIO_NET_F_CTRL_MAC_ADDR)
+  kCtrlMacAddr = 1ULL << 23,
+};
+
+/**
+ * @brief 网络设备配置空间字段偏移量
+ * @see virtio-v1.2#5.1.4 Device configuration layout
+ */
+enum class NetConfigOffset : uint32_t {
+  /// MAC 地址（6 字节，VIRTIO_NET_F_MAC）
+  kMac = 0,
+  /// 链路状态（VIRTIO_NET_F_STATUS）
+  kStatus = 6,
+  /// 最大队列对数（VIRTIO_NET_F_MQ）
+  kMaxVirtqueuePairs = 8,
+  /// MTU（VIRTIO_NET_F_MTU）
+  kMtu = 10,
+};
+
+/// 配置空间 status 字段：链路已连接 (VIRTIO_NET_S_LINK_UP)
+static constexpr uint16_t kNetStatusLinkUp = 1;
+
+/// MAC 地址长度（字节）
+static constexpr size_t kMacLen = 6;
+
+/**
+ * @brief 网络包头
+ * @see virtio-v1.2#5.1.6 Device Operation
+ *
+ * 每个收发包都以此结构开头。协商 VIRTIO_F_VERSION_1 后始终包含
+ * num_buffers 字段（共 12 字节）。
+ *
+ * @note 协议中所有字段采用小端格式
+ */
+struct NetHdr {
+  /// 包头标志位
+  enum Flags : uint8_t {
+    /// csum_start/csum_offset 有效，需补全校验和
+    /// (VIRTIO_NET_HDR_F_NEEDS_CSUM)
+    kNeedsCsum = 1,
+    /// 校验和已验证 (VIRTIO_NET_HDR_F_DATA_VALID)
+    kDataValid = 2,
+  };
+
+  /// GSO 类型
+  enum GsoType : uint8_t {
+    /// 非 GSO 包 (VIRTIO_NET_HDR_GSO_NONE)
+    kGsoNone = 0,
+    /// TCPv4 分段 (VIRTIO_NET_HDR_GSO_TCPV4)
+    kGsoTcpV4 = 1,
+    /// UDP 分片 (VIRTIO_NET_HDR_GSO_UDP)
+    kGsoUdp = 3,
+    /// TCPv6 分段 (VIRTIO_NET_HDR_GSO_TCPV6)
+    kGsoTcpV6 = 4,
+    /// 附加 ECN 标志 (VIRTIO_NET_HDR_GSO_ECN)
+    kGsoEcn = 0x80,
+  };
+
+  /// 标志位 (Flags)
+  uint8_t flags;
+  /// GSO 类型 (GsoType)
+  uint8_t gso_type;
+  /// 以太网头 + IP 头 + 传输层头的总长度
+  uint16_t hdr_len;
+  /// GSO 分段的负载大小
+  uint16_t gso_size;
+  /// 校验和计算的起始偏移
+  uint16_t csum_start;
+  /// 校验和字段相对 csum_start 的偏移
+  uint16_t csum_offset;
+  /// 接收包占用的缓冲区数量（VIRTIO_NET_F_MRG_RXBUF，发送时为 0）
+  uint16_t num_buffers;
+} __attribute__((packed));
+
+static_assert(sizeof(NetHdr) == 12, "virtio_net_hdr must be 12 bytes");
+
+/**
+ * @brief 控制队列命令头
+ * @see virtio-v1.2#5.1.6.5 Control Virtqueue
+ */
+struct NetCtrlHdr {
+  /// 命令类别
+  uint8_t cls;
+  /// 命令
+  uint8_t cmd;
+} __attribute__((packed));
+
+/// 控制命令类别：多队列 (VIRTIO_NET_CTRL_MQ)
+static constexpr uint8_t kNetCtrlMq = 4;
+/// 多队列命令：设置启用的队列对数 (VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET)
+static constexpr uint8_t kNetCtrlMqVqPairsSet = 0;
+/// 控制命令确认：成功 (VIRTIO_NET_OK)
+static constexpr uint8_t kNetCtrlOk = 0;
+
+/**
+ * @brief 网络设备统计数据
+ */
+struct NetStats {
+  /// 已接收的包数
+  uint64_t rx_packets{0};
+  /// 已接收的字节数（不含包头）
+  uint64_t rx_bytes{0};
+  /// 因格式错误或缓冲区不足丢弃的接收包数
+  uint64_t rx_dropped{0};
+  /// 已发送完成的包数
+  uint64_t tx_packets{0};
+  /// 已提交发送的字节数（不含包头）
+  uint64_t tx_bytes{0};
+  /// 借助 Event Index 省略的 Kick 次数
+  uint64_t kicks_elided{0};
+  /// 已处理的中断次数
+  uint64_t interrupts_handled{0};
+  /// 发送队列满导致入队失败的次数
+  uint64_t queue_full_errors{0};
+};
+
+}  // namespace device_framework::detail::virtio::net
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_DEVICE_VIRTIO_NET_DEFS_H_ */
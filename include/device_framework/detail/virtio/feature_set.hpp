@@ -0,0 +1,117 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_FEATURE_SET_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_FEATURE_SET_HPP_
+
+#include <concepts>
+#include <cstdint>
+
+namespace device_framework::detail::virtio {
+
+/**
+ * @brief 编译期特性集约束
+ *
+ * 特性集描述驱动在编译期就能确定的可选特性：
+ * - kKnown：编译期已确定开关状态的特性位
+ * - kEnabled：kKnown 中确定开启的特性位（必须是 kKnown 的子集）
+ *
+ * 未包含在 kKnown 中的特性仍按运行时协商结果处理。
+ * 驱动据此用 `if constexpr` 裁剪热路径上的特性分支。
+ */
+template <typename T>
+concept FeatureSetPolicy = requires {
+  { T::kKnown } -> std::convertible_to<uint64_t>;
+  { T::kEnabled } -> std::convertible_to<uint64_t>;
+} && ((T::kEnabled & ~T::kKnown) == 0);
+
+/**
+ * @brief 全部可选特性按运行时协商结果处理（默认特性集）
+ */
+struct RuntimeFeatures {
+  static constexpr uint64_t kKnown = 0;
+  static constexpr uint64_t kEnabled = 0;
+};
+
+/**
+ * @brief 固定特性集：列出的特性必须协商成功，其余可选特性一律关闭
+ *
+ * 适用于设备型号已知的固定平台：驱动只请求列出的特性，设备不支持
+ * 其中任一特性时 Create() 失败；未列出的特性相关代码在编译期消除。
+ *
+ * @code
+ * using Features = FeatureSet<ReservedFeature::kEventIdx,
+ *                             ReservedFeature::kIndirectDesc,
+ *                             blk::BlkFeatureBit::kFlush>;
+ * using Blk = blk::VirtioBlk<MyTraits, MmioTransport, SplitVirtqueue, 64,
+ *                            Features>;
+ * @endcode
+ *
+ * @tparam Features 特性位枚举值（ReservedFeature 或设备特性枚举）
+ */
+template <auto... Features>
+struct FeatureSet {
+  static constexpr uint64_t kKnown = ~uint64_t{0};
+  static constexpr uint64_t kEnabled =
+      (uint64_t{0} | ... | static_cast<uint64_t>(Features));
+};
+
+/// 特性在编译期的状态
+enum class FeatureMode : uint8_t {
+  /// 由运行时协商结果决定
+  kRuntime,
+  /// 确定开启
+  kAlways,
+  /// 确定关闭
+  kNever,
+};
+
+/**
+ * @brief 查询特性在特性集中的编译期状态
+ *
+ * @tparam Set 特性集
+ * @tparam Feature 单个特性位枚举值
+ */
+template <FeatureSetPolicy Set, auto Feature>
+inline constexpr FeatureMode kFeatureMode =
+    (Set::kKnown & static_cast<uint64_t>(Feature)) == 0 ? FeatureMode::kRuntime
+    : (Set::kEnabled & static_cast<uint64_t>(Feature)) != 0
+        ? FeatureMode::kAlways
+        : FeatureMode::kNever;
+
+/**
+ * @brief 判断特性是否生效
+ *
+ * 编译期已确定的特性直接返回常量，不读取 negotiated。
+ *
+ * @param negotiated 运行时协商得到的特性位
+ */
+template <FeatureSetPolicy Set, auto Feature>
+[[nodiscard]] constexpr auto FeatureActive(uint64_t negotiated) -> bool {
+  if constexpr (kFeatureMode<Set, Feature> == FeatureMode::kRuntime) {
+    return (negotiated & static_cast<uint64_t>(Feature)) != 0;
+  } else {
+    return kFeatureMode<Set, Feature> == FeatureMode::kAlways;
+  }
+}
+
+/**
+ * @brief 按特性集调整驱动请求的特性位
+ *
+ * 去掉编译期确定关闭的特性，加入确定开启的特性；mandatory 中的
+ * 特性位（如 VERSION_1、Virtqueue 格式所需特性）始终保留。
+ *
+ * @param wanted 驱动原本请求的特性位
+ * @param mandatory 不受特性集影响的必需特性位
+ */
+template <FeatureSetPolicy Set>
+[[nodiscard]] constexpr auto ApplyFeatureSet(uint64_t wanted,
+                                             uint64_t mandatory) -> uint64_t {
+  return (wanted & ~(Set::kKnown & ~mandatory)) | Set::kEnabled;
+}
+
+}  // namespace device_framework::detail::virtio
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_FEATURE_SET_HPP_ \
+        */
@@ -5,6 +5,8 @@
 #ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_TRANSPORT_MMIO_HPP_
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_TRANSPORT_MMIO_HPP_
 
+#include <cstdint>
+
 #include "device_framework/detail/mmio_accessor.hpp"
 #include "device_framework/detail/virtio/transport/transport.hpp"
 #include "device_framework/expected.hpp"
@@ -54,9 +56,20 @@ static constexpr uint32_t kMmioVersionModern = 0x02;
  * - 队列重置（可选，需要 VIRTIO_F_RING_RESET 特性）
  * - 设备特定配置空间（从 0x100 开始）
  *
+ * 前 kMaxCachedQueues 个队列的 QueueNumMax 与就绪状态缓存在驱动侧，
+ * 并记录最近一次写入的 QueueSel，重复选择同一队列时不再写寄存器；
+ * 运行期的 GetQueueNumMax()/GetQueueReady() 因此不产生 MMIO 访问。
+ *
+ * 寄存器经 Accessor 访问：默认的 MmioAccessor 直接读写内存映射地址；
+ * 宿主机构建可替换为转发到软件设备模型的访问器，驱动代码不变。
+ *
+ * @tparam Traits 平台环境特征类型
+ * @tparam Accessor 寄存器访问器（接口同 MmioAccessor：以基地址构造，
+ *         提供 Read<T>(offset)、Write<T>(offset, val) 与 base()）
  * @see virtio-v1.2#4.2 Virtio Over MMIO
  */
-template <VirtioTraits Traits = NullVirtioTraits>
+template <VirtioTraits Traits = NullVirtioTraits,
+          class Accessor = MmioAccessor>
 class MmioTransport final : public Transport<Traits> {
  public:
   /**
@@ -108,6 +121,9 @@ class MmioTransport final : public Transport<Traits> {
     kConfig = 0x100,
   };
 
+  /// 在驱动侧缓存状态的队列数（更高编号的队列每次访问寄存器）
+  static constexpr uint32_t kMaxCachedQueues = 16;
+
   /**
    * @brief 构造函数
    *
@@ -124,32 +140,35 @@ class MmioTransport final : public Transport<Traits> {
    */
   explicit MmioTransport(uint64_t base)
       : mmio_(base), is_valid_(false), device_id_(0), vendor_id_(0) {
+    for (auto& num_max : queue_num_max_) {
+      num_max = kNoQueue;
+    }
     if (base == 0) {
       Traits::Log("MMIO base address is null");
       return;
     }
 
-    auto magic = mmio_.Read<uint32_t>(MmioReg::kMagicValue);
+    auto magic = mmio_.template Read<uint32_t>(MmioReg::kMagicValue);
     if (magic != kMmioMagicValue) {
       Traits::Log("MMIO magic value mismatch: expected 0x%08x, got 0x%08x",
                   kMmioMagicValue, magic);
       return;
     }
 
-    auto version = mmio_.Read<uint32_t>(MmioReg::kVersion);
+    auto version = mmio_.template Read<uint32_t>(MmioReg::kVersion);
     if (version != kMmioVersionModern) {
       Traits::Log("MMIO version not supported: expected %u, got %u",
                   kMmioVersionModern, version);
       return;
     }
 
-    device_id_ = mmio_.Read<uint32_t>(MmioReg::kDeviceId);
+    device_id_ = mmio_.template Read<uint32_t>(MmioReg::kDeviceId);
     if (device_id_ == 0) {
       Traits::Log("MMIO device ID is 0, no device found");
       return;
     }
 
-    vendor_id_ = mmio_.Read<uint32_t>(MmioReg::kVendorId);
+    vendor_id_ = mmio_.template Read<uint32_t>(MmioReg::kVendorId);
     this->Reset();
     is_valid_ = true;
 
@@ -169,7 +188,12 @@ class MmioTransport final : public Transport<Traits> {
         mmio_(other.mmio_),
         is_valid_(other.is_valid_),
         device_id_(other.device_id_),
-        vendor_id_(other.vendor_id_) {
+        vendor_id_(other.vendor_id_),
+        selected_queue_(other.selected_queue_) {
+    for (uint32_t i = 0; i < kMaxCachedQueues; ++i) {
+      queue_num_max_[i] = other.queue_num_max_[i];
+      queue_ready_[i] = other.queue_ready_[i];
+    }
     other.is_valid_ = false;
   }
   auto operator=(MmioTransport&&) noexcept -> MmioTransport& = delete;
@@ -182,11 +206,25 @@ class MmioTransport final : public Transport<Traits> {
   [[nodiscard]] auto GetVendorId() const -> uint32_t { return vendor_id_; }
 
   [[nodiscard]] auto GetStatus() const -> uint32_t {
-    return mmio_.Read<uint32_t>(MmioReg::kStatus);
+    return mmio_.template Read<uint32_t>(MmioReg::kStatus);
   }
 
+  /**
+   * @brief 写入设备状态
+   *
+   * 写入 0（复位）时同时清除队列就绪状态缓存；复位后设备的 QueueSel
+   * 值未定义，选择缓存一并失效。
+   *
+   * @see virtio-v1.2#4.2.3.1 Device Initialization
+   */
   auto SetStatus(uint32_t status) -> void {
-    mmio_.Write<uint32_t>(MmioReg::kStatus, status);
+    mmio_.template Write<uint32_t>(MmioReg::kStatus, status);
+    if (status == 0) {
+      for (auto& ready : queue_ready_) {
+        ready = false;
+      }
+      selected_queue_ = kNoQueue;
+    }
   }
 
   /**
@@ -199,11 +237,11 @@ class MmioTransport final : public Transport<Traits> {
    * @see virtio-v1.2#4.2.2.1
    */
   [[nodiscard]] auto GetDeviceFeatures() -> uint64_t {
-    mmio_.Write<uint32_t>(MmioReg::kDeviceFeaturesSel, 0);
-    uint64_t lo = mmio_.Read<uint32_t>(MmioReg::kDeviceFeatures);
+    mmio_.template Write<uint32_t>(MmioReg::kDeviceFeaturesSel, 0);
+    uint64_t lo = mmio_.template Read<uint32_t>(MmioReg::kDeviceFeatures);
 
-    mmio_.Write<uint32_t>(MmioReg::kDeviceFeaturesSel, 1);
-    uint64_t hi = mmio_.Read<uint32_t>(MmioReg::kDeviceFeatures);
+    mmio_.template Write<uint32_t>(MmioReg::kDeviceFeaturesSel, 1);
+    uint64_t hi = mmio_.template Read<uint32_t>(MmioReg::kDeviceFeatures);
 
     return (hi << 32) | lo;
   }
@@ -215,18 +253,19 @@ class MmioTransport final : public Transport<Traits> {
    * @see virtio-v1.2#4.2.2.1
    */
   auto SetDriverFeatures(uint64_t features) -> void {
-    mmio_.Write<uint32_t>(MmioReg::kDriverFeaturesSel, 0);
-    mmio_.Write<uint32_t>(MmioReg::kDriverFeatures,
-                          static_cast<uint32_t>(features));
+    mmio_.template Write<uint32_t>(MmioReg::kDriverFeaturesSel, 0);
+    mmio_.template Write<uint32_t>(MmioReg::kDriverFeatures,
+                                   static_cast<uint32_t>(features));
 
-    mmio_.Write<uint32_t>(MmioReg::kDriverFeaturesSel, 1);
-    mmio_.Write<uint32_t>(MmioReg::kDriverFeatures,
-                          static_cast<uint32_t>(features >> 32));
+    mmio_.template Write<uint32_t>(MmioReg::kDriverFeaturesSel, 1);
+    mmio_.template Write<uint32_t>(MmioReg::kDriverFeatures,
+                                   static_cast<uint32_t>(features >> 32));
   }
 
   /**
    * @brief 获取队列最大容量
    *
+   * 首次查询时读取寄存器并缓存（QueueNumMax 在设备生命周期内不变）。
    * 涉及硬件寄存器写入，因此不能声明为 const。
    *
    * @param queue_idx 队列索引
@@ -234,13 +273,21 @@ class MmioTransport final : public Transport<Traits> {
    * @see virtio-v1.2#4.2.3.2
    */
   [[nodiscard]] auto GetQueueNumMax(uint32_t queue_idx) -> uint32_t {
-    mmio_.Write<uint32_t>(MmioReg::kQueueSel, queue_idx);
-    return mmio_.Read<uint32_t>(MmioReg::kQueueNumMax);
+    if (queue_idx < kMaxCachedQueues &&
+        queue_num_max_[queue_idx] != kNoQueue) {
+      return queue_num_max_[queue_idx];
+    }
+    SelectQueue(queue_idx);
+    uint32_t num_max = mmio_.template Read<uint32_t>(MmioReg::kQueueNumMax);
+    if (queue_idx < kMaxCachedQueues) {
+      queue_num_max_[queue_idx] = num_max;
+    }
+    return num_max;
   }
 
   auto SetQueueNum(uint32_t queue_idx, uint32_t num) -> void {
-    mmio_.Write<uint32_t>(MmioReg::kQueueSel, queue_idx);
-    mmio_.Write<uint32_t>(MmioReg::kQueueNum, num);
+    SelectQueue(queue_idx);
+    mmio_.template Write<uint32_t>(MmioReg::kQueueNum, num);
   }
 
   /**
@@ -250,10 +297,11 @@ class MmioTransport final : public Transport<Traits> {
    * @param addr 描述符表的 64 位物理地址
    */
   auto SetQueueDesc(uint32_t queue_idx, uint64_t addr) -> void {
-    mmio_.Write<uint32_t>(MmioReg::kQueueSel, queue_idx);
-    mmio_.Write<uint32_t>(MmioReg::kQueueDescLow, static_cast<uint32_t>(addr));
-    mmio_.Write<uint32_t>(MmioReg::kQueueDescHigh,
-                          static_cast<uint32_t>(addr >> 32));
+    SelectQueue(queue_idx);
+    mmio_.template Write<uint32_t>(MmioReg::kQueueDescLow,
+                                   static_cast<uint32_t>(addr));
+    mmio_.template Write<uint32_t>(MmioReg::kQueueDescHigh,
+                                   static_cast<uint32_t>(addr >> 32));
   }
 
   /**
@@ -263,11 +311,11 @@ class MmioTransport final : public Transport<Traits> {
    * @param addr Available Ring 的 64 位物理地址
    */
   auto SetQueueAvail(uint32_t queue_idx, uint64_t addr) -> void {
-    mmio_.Write<uint32_t>(MmioReg::kQueueSel, queue_idx);
-    mmio_.Write<uint32_t>(MmioReg::kQueueDriverLow,
-                          static_cast<uint32_t>(addr));
-    mmio_.Write<uint32_t>(MmioReg::kQueueDriverHigh,
-                          static_cast<uint32_t>(addr >> 32));
+    SelectQueue(queue_idx);
+    mmio_.template Write<uint32_t>(MmioReg::kQueueDriverLow,
+                                   static_cast<uint32_t>(addr));
+    mmio_.template Write<uint32_t>(MmioReg::kQueueDriverHigh,
+                                   static_cast<uint32_t>(addr >> 32));
   }
 
   /**
@@ -277,34 +325,65 @@ class MmioTransport final : public Transport<Traits> {
    * @param addr Used Ring 的 64 位物理地址
    */
   auto SetQueueUsed(uint32_t queue_idx, uint64_t addr) -> void {
-    mmio_.Write<uint32_t>(MmioReg::kQueueSel, queue_idx);
-    mmio_.Write<uint32_t>(MmioReg::kQueueDeviceLow,
-                          static_cast<uint32_t>(addr));
-    mmio_.Write<uint32_t>(MmioReg::kQueueDeviceHigh,
-                          static_cast<uint32_t>(addr >> 32));
+    SelectQueue(queue_idx);
+    mmio_.template Write<uint32_t>(MmioReg::kQueueDeviceLow,
+                                   static_cast<uint32_t>(addr));
+    mmio_.template Write<uint32_t>(MmioReg::kQueueDeviceHigh,
+                                   static_cast<uint32_t>(addr >> 32));
   }
 
+  /**
+   * @brief 查询队列是否已就绪
+   *
+   * 缓存范围内的队列直接返回最近一次 SetQueueReady() 写入的值。
+   *
+   * @param queue_idx 队列索引
+   */
   [[nodiscard]] auto GetQueueReady(uint32_t queue_idx) -> bool {
-    mmio_.Write<uint32_t>(MmioReg::kQueueSel, queue_idx);
-    return mmio_.Read<uint32_t>(MmioReg::kQueueReady) != 0;
+    if (queue_idx < kMaxCachedQueues) {
+      return queue_ready_[queue_idx];
+    }
+    SelectQueue(queue_idx);
+    return mmio_.template Read<uint32_t>(MmioReg::kQueueReady) != 0;
   }
 
   auto SetQueueReady(uint32_t queue_idx, bool ready) -> void {
-    mmio_.Write<uint32_t>(MmioReg::kQueueSel, queue_idx);
-    mmio_.Write<uint32_t>(MmioReg::kQueueReady, ready ? 1 : 0);
+    SelectQueue(queue_idx);
+    mmio_.template Write<uint32_t>(MmioReg::kQueueReady, ready ? 1 : 0);
+    if (queue_idx < kMaxCachedQueues) {
+      queue_ready_[queue_idx] = ready;
+    }
   }
 
   /// 通知设备有新的可用缓冲区
   auto NotifyQueue(uint32_t queue_idx) -> void {
-    mmio_.Write<uint32_t>(MmioReg::kQueueNotify, queue_idx);
+    mmio_.template Write<uint32_t>(MmioReg::kQueueNotify, queue_idx);
+  }
+
+  /**
+   * @brief 携带通知数据通知设备（需 VIRTIO_F_NOTIFICATION_DATA）
+   *
+   * 写入 QueueNotify 的 32 位值为 vqn | (next_off_wrap << 16)，设备据此
+   * 得知下一个可用位置，无需再读取 Available Ring。
+   *
+   * @param queue_idx 队列索引
+   * @param next_off_wrap Virtqueue 的通知数据（见 NotificationData()）
+   * @see virtio-v1.2#2.9 Driver Notifications
+   * @see virtio-v1.2#4.2.3.3 Available Buffer Notifications
+   */
+  auto NotifyQueueWithData(uint32_t queue_idx, uint16_t next_off_wrap)
+      -> void {
+    mmio_.template Write<uint32_t>(
+        MmioReg::kQueueNotify,
+        (queue_idx & 0xFFFF) | (static_cast<uint32_t>(next_off_wrap) << 16));
   }
 
   [[nodiscard]] auto GetInterruptStatus() const -> uint32_t {
-    return mmio_.Read<uint32_t>(MmioReg::kInterruptStatus);
+    return mmio_.template Read<uint32_t>(MmioReg::kInterruptStatus);
   }
 
   auto AckInterrupt(uint32_t ack_bits) -> void {
-    mmio_.Write<uint32_t>(MmioReg::kInterruptAck, ack_bits);
+    mmio_.template Write<uint32_t>(MmioReg::kInterruptAck, ack_bits);
   }
 
   /**
@@ -314,7 +393,7 @@ class MmioTransport final : public Transport<Traits> {
    * @see virtio-v1.2#4.2.2.2
    */
   [[nodiscard]] auto ReadConfigU8(uint32_t offset) const -> uint8_t {
-    return mmio_.Read<uint8_t>(MmioReg::kConfig + offset);
+    return mmio_.template Read<uint8_t>(MmioReg::kConfig + offset);
   }
 
   /**
@@ -323,7 +402,7 @@ class MmioTransport final : public Transport<Traits> {
    * @param offset 相对于配置空间起始的偏移量
    */
   [[nodiscard]] auto ReadConfigU16(uint32_t offset) const -> uint16_t {
-    return mmio_.Read<uint16_t>(MmioReg::kConfig + offset);
+    return mmio_.template Read<uint16_t>(MmioReg::kConfig + offset);
   }
 
   /**
@@ -332,7 +411,7 @@ class MmioTransport final : public Transport<Traits> {
    * @param offset 相对于配置空间起始的偏移量
    */
   [[nodiscard]] auto ReadConfigU32(uint32_t offset) const -> uint32_t {
-    return mmio_.Read<uint32_t>(MmioReg::kConfig + offset);
+    return mmio_.template Read<uint32_t>(MmioReg::kConfig + offset);
   }
 
   /**
@@ -359,10 +438,9 @@ class MmioTransport final : public Transport<Traits> {
     do {
       gen1 = GetConfigGeneration();
 
-      auto* ptr = reinterpret_cast<volatile uint32_t*>(
-          mmio_.base() + MmioReg::kConfig + offset);
-      uint64_t lo = ptr[0];
-      uint64_t hi = ptr[1];
+      uint64_t lo = mmio_.template Read<uint32_t>(MmioReg::kConfig + offset);
+      uint64_t hi =
+          mmio_.template Read<uint32_t>(MmioReg::kConfig + offset + 4);
       value = (hi << 32) | lo;
 
       gen2 = GetConfigGeneration();
@@ -371,16 +449,37 @@ class MmioTransport final : public Transport<Traits> {
     return value;
   }
 
+  /**
+   * @brief 写入配置空间 8 位值
+   *
+   * @param offset 相对于配置空间起始的偏移量
+   * @param value 写入值
+   */
+  auto WriteConfigU8(uint32_t offset, uint8_t value) -> void {
+    mmio_.template Write<uint8_t>(MmioReg::kConfig + offset, value);
+  }
+
   [[nodiscard]] auto GetConfigGeneration() const -> uint32_t {
-    return mmio_.Read<uint32_t>(MmioReg::kConfigGeneration);
+    return mmio_.template Read<uint32_t>(MmioReg::kConfigGeneration);
   }
 
   /// 获取 MMIO 基地址
   [[nodiscard]] auto base() const -> uint64_t { return mmio_.base(); }
 
  private:
+  /// 缓存中的"未知"标记（QueueNumMax 未读取 / QueueSel 未知）
+  static constexpr uint32_t kNoQueue = UINT32_MAX;
+
+  /// 选择队列（与最近一次选择相同时不写寄存器）
+  auto SelectQueue(uint32_t queue_idx) -> void {
+    if (selected_queue_ != queue_idx) {
+      mmio_.template Write<uint32_t>(MmioReg::kQueueSel, queue_idx);
+      selected_queue_ = queue_idx;
+    }
+  }
+
   /// MMIO 寄存器访问器
-  MmioAccessor mmio_;
+  Accessor mmio_;
 
   /// 设备是否成功初始化
   bool is_valid_;
@@ -390,6 +489,13 @@ class MmioTransport final : public Transport<Traits> {
 
   /// 供应商 ID（缓存以避免重复读取）
   uint32_t vendor_id_;
+
+  /// 最近一次写入的 QueueSel
+  uint32_t selected_queue_ = kNoQueue;
+  /// 各队列的 QueueNumMax（kNoQueue 表示尚未读取）
+  uint32_t queue_num_max_[kMaxCachedQueues];
+  /// 各队列最近一次写入的 QueueReady
+  bool queue_ready_[kMaxCachedQueues]{};
 };
 
 }  // namespace device_framework::detail::virtio
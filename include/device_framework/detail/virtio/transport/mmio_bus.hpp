@@ -0,0 +1,190 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_TRANSPORT_MMIO_BUS_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_TRANSPORT_MMIO_BUS_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "device_framework/detail/mmio_accessor.hpp"
+#include "device_framework/detail/virtio/traits.hpp"
+#include "device_framework/detail/virtio/transport/mmio.hpp"
+
+namespace device_framework::detail::virtio {
+
+/**
+ * @brief 扫描得到的 virtio-mmio 设备
+ */
+struct VirtioMmioDeviceInfo {
+  /// MMIO 寄存器基地址
+  uint64_t base = 0;
+  /// Device ID（如块设备为 2）
+  uint32_t device_id = 0;
+  /// Vendor ID
+  uint32_t vendor_id = 0;
+  /// 在扫描范围内的槽位号（平台通常据此推算 IRQ 号）
+  uint32_t slot = 0;
+};
+
+/**
+ * @brief virtio-mmio 设备枚举与批量探测
+ *
+ * Scan() 一次遍历 [base, base + count * stride) 中的所有槽位，每个槽位
+ * 最多读取 4 个寄存器（魔数、版本、Device ID、Vendor ID），把存在的
+ * Modern 设备记录在紧凑的表中；之后的查找只访问这张表。
+ *
+ * 设备初始化（复位、特性协商）通过 Probe() 分发：所有核可同时调用
+ * Probe()，以原子游标认领表项，各自对认领到的设备执行探测回调（通常
+ * 是某个驱动的 Create()，内部由 DeviceInitializer 完成初始化序列），
+ * 因此总启动时间随核数摊薄，而非随设备数线性增长。单核调用时即按表序
+ * 依次探测。
+ *
+ * @tparam Traits 平台环境特征类型
+ * @tparam MaxDevices 表容量（超出的设备被忽略并记录日志）
+ * @warning Scan() 须在 Probe() 之前完成，且不得与 Probe() 并发
+ */
+template <VirtioTraits Traits = NullVirtioTraits, size_t MaxDevices = 32>
+class VirtioMmioBus {
+ public:
+  /**
+   * @brief 扫描一段等间距的 virtio-mmio 槽位
+   *
+   * 魔数不匹配、版本不是 Modern 或 Device ID 为 0（空槽位）的槽位被跳过。
+   * 不写任何设备寄存器。
+   *
+   * @param base 第一个槽位的基地址
+   * @param stride 槽位间隔（字节）
+   * @param count 槽位数
+   * @return 设备表
+   * @see virtio-v1.2#4.2.2 MMIO Device Register Layout
+   */
+  [[nodiscard]] static auto Scan(uint64_t base, uint64_t stride, size_t count)
+      -> VirtioMmioBus {
+    using Reg = typename MmioTransport<Traits>::MmioReg;
+    VirtioMmioBus bus;
+    for (size_t i = 0; i < count; ++i) {
+      MmioAccessor mmio(base + i * stride);
+      if (mmio.Read<uint32_t>(Reg::kMagicValue) != kMmioMagicValue ||
+          mmio.Read<uint32_t>(Reg::kVersion) != kMmioVersionModern) {
+        continue;
+      }
+      auto device_id = mmio.Read<uint32_t>(Reg::kDeviceId);
+      if (device_id == 0) {
+        continue;
+      }
+      if (bus.count_ == MaxDevices) {
+        Traits::Log("VirtioMmioBus full, ignoring device at slot %u",
+                    static_cast<unsigned>(i));
+        continue;
+      }
+      bus.devices_[bus.count_++] = {mmio.base(), device_id,
+                                    mmio.Read<uint32_t>(Reg::kVendorId),
+                                    static_cast<uint32_t>(i)};
+    }
+    return bus;
+  }
+
+  /// @brief 扫描到的全部设备（按槽位顺序）
+  [[nodiscard]] auto Devices() const -> std::span<const VirtioMmioDeviceInfo> {
+    return {devices_, count_};
+  }
+
+  /**
+   * @brief 查找指定类型的第 nth 个设备
+   *
+   * @param device_id Device ID
+   * @param nth 同类设备中的序号（从 0 开始）
+   * @return 设备信息，不存在时返回 std::nullopt
+   */
+  [[nodiscard]] auto Find(uint32_t device_id, size_t nth = 0) const
+      -> std::optional<VirtioMmioDeviceInfo> {
+    for (size_t i = 0; i < count_; ++i) {
+      if (devices_[i].device_id == device_id && nth-- == 0) {
+        return devices_[i];
+      }
+    }
+    return std::nullopt;
+  }
+
+  /// @brief 指定类型的设备数
+  [[nodiscard]] auto Count(uint32_t device_id) const -> size_t {
+    size_t n = 0;
+    for (size_t i = 0; i < count_; ++i) {
+      n += devices_[i].device_id == device_id ? 1 : 0;
+    }
+    return n;
+  }
+
+  /**
+   * @brief 认领并探测尚未处理的设备
+   *
+   * 可在多个核上同时调用：每个表项只会被一个调用者认领。回调返回
+   * true 表示已有驱动接管该设备。
+   *
+   * @tparam ProbeFn 签名：bool(const VirtioMmioDeviceInfo& info)
+   * @param probe 探测回调（通常按 device_id 选择驱动并调用其 Create()）
+   * @return 本次调用中回调返回 true 的设备数
+   */
+  template <typename ProbeFn>
+  auto Probe(ProbeFn&& probe) -> size_t {
+    size_t bound = 0;
+    while (true) {
+      size_t i = next_.fetch_add(1, std::memory_order_relaxed);
+      if (i >= count_) {
+        break;
+      }
+      bound += probe(static_cast<const VirtioMmioDeviceInfo&>(devices_[i]))
+                   ? 1
+                   : 0;
+      probed_.fetch_add(1, std::memory_order_release);
+    }
+    return bound;
+  }
+
+  /**
+   * @brief 所有设备是否都已探测完成
+   *
+   * 启动核在其他核参与 Probe() 后以此等待探测结束。
+   */
+  [[nodiscard]] auto IsProbeComplete() const -> bool {
+    return probed_.load(std::memory_order_acquire) >= count_;
+  }
+
+  /// @name 构造/析构函数
+  /// @{
+  VirtioMmioBus() = default;
+  ~VirtioMmioBus() = default;
+  VirtioMmioBus(const VirtioMmioBus&) = delete;
+  auto operator=(const VirtioMmioBus&) -> VirtioMmioBus& = delete;
+  /// 移动仅在探测开始前进行（Scan() 返回时）
+  VirtioMmioBus(VirtioMmioBus&& other) noexcept
+      : count_(other.count_),
+        next_(other.next_.load(std::memory_order_relaxed)),
+        probed_(other.probed_.load(std::memory_order_relaxed)) {
+    for (size_t i = 0; i < count_; ++i) {
+      devices_[i] = other.devices_[i];
+    }
+  }
+  auto operator=(VirtioMmioBus&&) noexcept -> VirtioMmioBus& = delete;
+  /// @}
+
+ private:
+  /// 设备表
+  VirtioMmioDeviceInfo devices_[MaxDevices]{};
+  /// 表中的设备数
+  size_t count_ = 0;
+  /// 下一个待认领的表项
+  std::atomic<size_t> next_{0};
+  /// 已探测完成的表项数
+  std::atomic<size_t> probed_{0};
+};
+
+}  // namespace device_framework::detail::virtio
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_TRANSPORT_MMIO_BUS_HPP_ \
+        */
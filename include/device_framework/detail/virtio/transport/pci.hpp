@@ -5,57 +5,843 @@
 #ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_TRANSPORT_PCI_HPP_
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_TRANSPORT_PCI_HPP_
 
+#include "device_framework/detail/mmio_accessor.hpp"
 #include "device_framework/detail/virtio/transport/transport.hpp"
+#include "device_framework/expected.hpp"
 
 namespace device_framework::detail::virtio {
 
 /**
- * @brief Virtio PCI 传输层（占位）
- * @todo 实现 PCI Modern (1.0+) 传输层
- * @see virtio-v1.2#4.1
+ * @brief virtio PCI 设备的 PCI Vendor ID
+ * @see virtio-v1.2#4.1.2 PCI Device Discovery
+ */
+static constexpr uint16_t kPciVendorVirtio = 0x1AF4;
+
+/**
+ * @brief Modern virtio PCI Device ID 基值（Device ID = 0x1040 + virtio ID）
+ * @see virtio-v1.2#4.1.2 PCI Device Discovery
+ */
+static constexpr uint16_t kPciDeviceIdModernBase = 0x1040;
+
+/**
+ * @brief MSI-X 向量未映射（queue_msix_vector / config_msix_vector 的复位值）
+ * @see virtio-v1.2#4.1.4.3 Common configuration structure layout
+ */
+static constexpr uint16_t kPciNoVector = 0xFFFF;
+
+/**
+ * @brief virtio PCI function 的 capability 布局
+ *
+ * 由 PciTransport::ReadLayout() 从配置空间解析得到，记录各 virtio
+ * capability 指向的 BAR 区域（虚拟地址）。枚举时缓存此布局，构造
+ * PciTransport 时即可跳过 capability 链表遍历。
+ *
+ * @see virtio-v1.2#4.1.4 Virtio Structure PCI Capabilities
+ */
+struct VirtioPciLayout {
+  /// common config 区域地址
+  uint64_t common = 0;
+  /// notify 区域基地址
+  uint64_t notify = 0;
+  /// ISR status 区域地址
+  uint64_t isr = 0;
+  /// device config 区域地址（无设备特定配置时为 0）
+  uint64_t device = 0;
+  /// MSI-X 表地址（不支持 MSI-X 时为 0）
+  uint64_t msix_table = 0;
+  /// 队列通知偏移倍数
+  uint32_t notify_off_multiplier = 0;
+  /// MSI-X 表向量数
+  uint32_t msix_table_size = 0;
+  /// MSI-X capability 在配置空间中的偏移（0 表示不支持）
+  uint8_t msix_cap = 0;
+  /// virtio Device ID（0 表示不是可用的 virtio 设备）
+  uint32_t device_id = 0;
+  /// PCI Subsystem Vendor ID
+  uint32_t vendor_id = 0;
+
+  /// @brief 识别为 virtio 设备且 common/notify/ISR 区域齐全
+  [[nodiscard]] auto IsComplete() const -> bool {
+    return device_id != 0 && common != 0 && notify != 0 && isr != 0;
+  }
+};
+
+/**
+ * @brief Virtio PCI 传输层
+ *
+ * 仅支持 Modern virtio-pci（virtio 1.0+）。构造时遍历 PCI 配置空间的
+ * capability 链表，定位以下 vendor-specific capability 指向的 BAR 区域：
+ * - common config：特性协商、设备状态与队列配置
+ * - notify：队列通知地址 = notify 基地址 + queue_notify_off ×
+ *   notify_off_multiplier
+ * - ISR status：INTx 中断状态（读取即清除）
+ * - device config：设备特定配置空间
+ *
+ * 配置空间通过 ECAM 映射访问（构造参数为该 function 的 4KB ECAM
+ * 配置空间地址），BAR 须已由固件或平台代码分配；BAR 中的物理地址经
+ * Traits::PhysToVirt() 转换后访问。
+ *
+ * 设备提供 MSI-X capability 时，队列启用时（设备复位之后、DRIVER_OK
+ * 之前）将配置变更中断映射到向量 0，队列 n 映射到向量 n + 1（向量不足
+ * 时共享最后一个向量）；设备复位会把两者恢复为 kPciNoVector。
+ * 平台以 SetMsixEntry() 填写各向量的消息地址/数据并调用 EnableMsix()
+ * 后，每个队列的完成中断独立投递，驱动按队列处理中断时无需读取共享的
+ * ISR status。
+ *
+ * @tparam Traits 平台环境特征类型
+ * @see virtio-v1.2#4.1 Virtio Over PCI Bus
  */
 template <VirtioTraits Traits = NullVirtioTraits>
 class PciTransport final : public Transport<Traits> {
  public:
-  [[nodiscard]] auto IsValid() const -> bool { return false; }
-  [[nodiscard]] auto GetDeviceId() const -> uint32_t { return 0; }
-  [[nodiscard]] auto GetVendorId() const -> uint32_t { return 0; }
+  /**
+   * @brief PCI 配置空间头部偏移量（Type 0）
+   * @see PCI Local Bus Specification 3.0 §6.1
+   */
+  enum PciReg : size_t {
+    kVendorId = 0x00,
+    kDeviceId = 0x02,
+    kCommand = 0x04,
+    kPciStatus = 0x06,
+    kBar0 = 0x10,
+    kSubsystemVendorId = 0x2C,
+    kSubsystemId = 0x2E,
+    kCapabilitiesPtr = 0x34,
+  };
+
+  /**
+   * @brief virtio_pci_cap.cfg_type
+   * @see virtio-v1.2#4.1.4 Virtio Structure PCI Capabilities
+   */
+  enum PciCapType : uint8_t {
+    kCommonCfg = 1,
+    kNotifyCfg = 2,
+    kIsrCfg = 3,
+    kDeviceCfg = 4,
+    kPciCfg = 5,
+  };
+
+  /**
+   * @brief common config 结构偏移量
+   * @see virtio-v1.2#4.1.4.3 Common configuration structure layout
+   */
+  enum CommonCfg : size_t {
+    kDeviceFeatureSelect = 0x00,
+    kDeviceFeature = 0x04,
+    kDriverFeatureSelect = 0x08,
+    kDriverFeature = 0x0C,
+    kConfigMsixVector = 0x10,
+    kNumQueues = 0x12,
+    kDeviceStatus = 0x14,
+    kConfigGeneration = 0x15,
+    kQueueSelect = 0x16,
+    kQueueSize = 0x18,
+    kQueueMsixVector = 0x1A,
+    kQueueEnable = 0x1C,
+    kQueueNotifyOff = 0x1E,
+    kQueueDesc = 0x20,
+    kQueueDriver = 0x28,
+    kQueueDevice = 0x30,
+    kQueueNotifConfigData = 0x38,
+    kQueueReset = 0x3A,
+  };
+
+  /// 缓存通知偏移量的队列数（更高编号的队列每次通知时读取 common config）
+  static constexpr uint32_t kMaxCachedQueues = 16;
+
+  /**
+   * @brief 构造函数
+   *
+   * 在构造时完成以下初始化：
+   * 1. 验证 PCI Vendor ID 与 Device ID（仅 Modern/过渡设备）
+   * 2. 遍历 capability 链表，定位 common/notify/ISR/device config 区域
+   * 3. 打开 Memory Space 与 Bus Master
+   * 4. 执行设备重置，并将配置变更中断映射到 MSI-X 向量 0（若支持）
+   *
+   * @param ecam_base 该 PCI function 配置空间的 ECAM 映射地址
+   *
+   * @post 构造完成后应调用 IsValid() 检查初始化是否成功
+   * @see virtio-v1.2#4.1.2 PCI Device Discovery
+   * @see virtio-v1.2#4.1.4 Virtio Structure PCI Capabilities
+   */
+  explicit PciTransport(uint64_t ecam_base)
+      : PciTransport(ecam_base, ReadLayout(ecam_base)) {}
+
+  /**
+   * @brief 以已缓存的 capability 布局构造
+   *
+   * 跳过设备识别与 capability 遍历（通常布局来自 VirtioPciBus::Scan()），
+   * 只执行上面的第 3、4 步。
+   *
+   * @param ecam_base 该 PCI function 配置空间的 ECAM 映射地址
+   * @param layout ReadLayout() 得到的布局
+   */
+  PciTransport(uint64_t ecam_base, const VirtioPciLayout& layout)
+      : cfg_(ecam_base),
+        common_(layout.common),
+        notify_(layout.notify),
+        isr_(layout.isr),
+        device_(layout.device),
+        msix_table_(layout.msix_table),
+        notify_off_multiplier_(layout.notify_off_multiplier),
+        msix_cap_(layout.msix_cap),
+        msix_table_size_(layout.msix_table_size),
+        is_valid_(false),
+        msix_enabled_(false),
+        device_id_(layout.device_id),
+        vendor_id_(layout.vendor_id) {
+    if (ecam_base == 0 || !layout.IsComplete()) {
+      return;
+    }
+
+    // Memory Space (bit 1) + Bus Master (bit 2)
+    cfg_.Write<uint16_t>(
+        PciReg::kCommand,
+        static_cast<uint16_t>(cfg_.Read<uint16_t>(PciReg::kCommand) | 0x6));
 
-  [[nodiscard]] auto GetStatus() const -> uint32_t { return 0; }
-  auto SetStatus(uint32_t /*status*/) -> void {}
+    this->Reset();
+    is_valid_ = true;
 
-  [[nodiscard]] auto GetDeviceFeatures() -> uint64_t { return 0; }
-  auto SetDriverFeatures(uint64_t /*features*/) -> void {}
+    Traits::Log(
+        "PCI device initialized: DeviceID=0x%08x, VendorID=0x%08x, "
+        "MSI-X vectors=%u",
+        device_id_, vendor_id_, msix_table_size_);
+  }
+
+  /**
+   * @brief 识别 virtio PCI function 并解析其 capability 布局
+   *
+   * 只读取配置空间，不写任何寄存器。不是 virtio 设备或缺少必需
+   * capability 时返回的布局 IsComplete() 为 false。
+   *
+   * @param ecam_base 该 PCI function 配置空间的 ECAM 映射地址
+   * @see virtio-v1.2#4.1.2 PCI Device Discovery
+   */
+  [[nodiscard]] static auto ReadLayout(uint64_t ecam_base) -> VirtioPciLayout {
+    VirtioPciLayout layout;
+    if (ecam_base == 0) {
+      Traits::Log("PCI config space address is null");
+      return layout;
+    }
+    MmioAccessor cfg(ecam_base);
+
+    auto pci_vendor = cfg.Read<uint16_t>(PciReg::kVendorId);
+    if (pci_vendor != kPciVendorVirtio) {
+      Traits::Log("PCI vendor mismatch: expected 0x%04x, got 0x%04x",
+                  kPciVendorVirtio, pci_vendor);
+      return layout;
+    }
+
+    // 0x1000 ~ 0x103F 为过渡设备，virtio ID 取自 Subsystem ID
+    auto pci_device = cfg.Read<uint16_t>(PciReg::kDeviceId);
+    uint32_t device_id = 0;
+    if (pci_device >= kPciDeviceIdModernBase) {
+      device_id = pci_device - kPciDeviceIdModernBase;
+    } else if (pci_device >= 0x1000) {
+      device_id = cfg.Read<uint16_t>(PciReg::kSubsystemId);
+    }
+    if (device_id == 0) {
+      Traits::Log("PCI device 0x%04x is not a virtio device", pci_device);
+      return layout;
+    }
 
-  [[nodiscard]] auto GetQueueNumMax(uint32_t /*queue_idx*/) -> uint32_t {
-    return 0;
+    if (ParseCapabilities(cfg, layout)) {
+      layout.device_id = device_id;
+      layout.vendor_id = cfg.Read<uint16_t>(PciReg::kSubsystemVendorId);
+    }
+    return layout;
   }
-  auto SetQueueNum(uint32_t /*queue_idx*/, uint32_t /*num*/) -> void {}
-  auto SetQueueDesc(uint32_t /*queue_idx*/, uint64_t /*addr*/) -> void {}
-  auto SetQueueAvail(uint32_t /*queue_idx*/, uint64_t /*addr*/) -> void {}
-  auto SetQueueUsed(uint32_t /*queue_idx*/, uint64_t /*addr*/) -> void {}
-  [[nodiscard]] auto GetQueueReady(uint32_t /*queue_idx*/) -> bool {
-    return false;
+
+  /**
+   * @brief 检查设备是否成功初始化
+   */
+  [[nodiscard]] auto IsValid() const -> bool { return is_valid_; }
+
+  /// @name 构造/析构函数
+  /// @{
+  PciTransport(PciTransport&& other) noexcept
+      : Transport<Traits>(std::move(other)),
+        cfg_(other.cfg_),
+        common_(other.common_),
+        notify_(other.notify_),
+        isr_(other.isr_),
+        device_(other.device_),
+        msix_table_(other.msix_table_),
+        notify_off_multiplier_(other.notify_off_multiplier_),
+        msix_cap_(other.msix_cap_),
+        msix_table_size_(other.msix_table_size_),
+        is_valid_(other.is_valid_),
+        msix_enabled_(other.msix_enabled_),
+        device_id_(other.device_id_),
+        vendor_id_(other.vendor_id_) {
+    for (uint32_t i = 0; i < kMaxCachedQueues; ++i) {
+      notify_off_[i] = other.notify_off_[i];
+    }
+    other.is_valid_ = false;
   }
-  auto SetQueueReady(uint32_t /*queue_idx*/, bool /*ready*/) -> void {}
+  auto operator=(PciTransport&&) noexcept -> PciTransport& = delete;
+  PciTransport(const PciTransport&) = delete;
+  auto operator=(const PciTransport&) -> PciTransport& = delete;
+  /// @}
+
+  [[nodiscard]] auto GetDeviceId() const -> uint32_t { return device_id_; }
 
-  auto NotifyQueue(uint32_t /*queue_idx*/) -> void {}
-  [[nodiscard]] auto GetInterruptStatus() const -> uint32_t { return 0; }
+  /// 返回 PCI Subsystem Vendor ID
+  [[nodiscard]] auto GetVendorId() const -> uint32_t { return vendor_id_; }
+
+  [[nodiscard]] auto GetStatus() const -> uint32_t {
+    return common_.Read<uint8_t>(CommonCfg::kDeviceStatus);
+  }
+
+  /**
+   * @brief 写入设备状态
+   *
+   * 写入 0（复位）时等待设备读回 0，确认复位已完成。
+   *
+   * @see virtio-v1.2#4.1.4.3.2 Driver Requirements: Common configuration
+   *      structure layout
+   */
+  auto SetStatus(uint32_t status) -> void {
+    common_.Write<uint8_t>(CommonCfg::kDeviceStatus,
+                           static_cast<uint8_t>(status));
+    if (status != 0) {
+      return;
+    }
+    uint32_t spins = 0;
+    while (GetStatus() != 0 && ++spins < kMaxResetSpins) {
+    }
+    if (spins == kMaxResetSpins) {
+      Traits::Log("PCI device reset did not complete");
+    }
+  }
+
+  /**
+   * @brief 读取 64 位设备特性
+   *
+   * @return 设备支持的 64 位特性位
+   * @see virtio-v1.2#4.1.4.3
+   */
+  [[nodiscard]] auto GetDeviceFeatures() -> uint64_t {
+    common_.Write<uint32_t>(CommonCfg::kDeviceFeatureSelect, 0);
+    uint64_t lo = common_.Read<uint32_t>(CommonCfg::kDeviceFeature);
+
+    common_.Write<uint32_t>(CommonCfg::kDeviceFeatureSelect, 1);
+    uint64_t hi = common_.Read<uint32_t>(CommonCfg::kDeviceFeature);
+
+    return (hi << 32) | lo;
+  }
+
+  /**
+   * @brief 写入 64 位驱动特性
+   *
+   * @param features 驱动程序接受的特性位
+   * @see virtio-v1.2#4.1.4.3
+   */
+  auto SetDriverFeatures(uint64_t features) -> void {
+    common_.Write<uint32_t>(CommonCfg::kDriverFeatureSelect, 0);
+    common_.Write<uint32_t>(CommonCfg::kDriverFeature,
+                            static_cast<uint32_t>(features));
+
+    common_.Write<uint32_t>(CommonCfg::kDriverFeatureSelect, 1);
+    common_.Write<uint32_t>(CommonCfg::kDriverFeature,
+                            static_cast<uint32_t>(features >> 32));
+  }
+
+  /**
+   * @brief 获取队列最大容量
+   *
+   * PCI 传输层中 queue_size 复位值即设备支持的最大值；不存在的队列
+   * 返回 0。
+   *
+   * @param queue_idx 队列索引
+   * @return 队列最大大小
+   */
+  [[nodiscard]] auto GetQueueNumMax(uint32_t queue_idx) -> uint32_t {
+    if (queue_idx >= common_.Read<uint16_t>(CommonCfg::kNumQueues)) {
+      return 0;
+    }
+    SelectQueue(queue_idx);
+    return common_.Read<uint16_t>(CommonCfg::kQueueSize);
+  }
+
+  auto SetQueueNum(uint32_t queue_idx, uint32_t num) -> void {
+    SelectQueue(queue_idx);
+    common_.Write<uint16_t>(CommonCfg::kQueueSize, static_cast<uint16_t>(num));
+  }
+
+  /**
+   * @brief 设置描述符表物理地址
+   *
+   * @param queue_idx 队列索引
+   * @param addr 描述符表的 64 位物理地址
+   */
+  auto SetQueueDesc(uint32_t queue_idx, uint64_t addr) -> void {
+    SelectQueue(queue_idx);
+    Write64(CommonCfg::kQueueDesc, addr);
+  }
+
+  /**
+   * @brief 设置 Available Ring（driver area）物理地址
+   *
+   * @param queue_idx 队列索引
+   * @param addr Available Ring 的 64 位物理地址
+   */
+  auto SetQueueAvail(uint32_t queue_idx, uint64_t addr) -> void {
+    SelectQueue(queue_idx);
+    Write64(CommonCfg::kQueueDriver, addr);
+  }
+
+  /**
+   * @brief 设置 Used Ring（device area）物理地址
+   *
+   * @param queue_idx 队列索引
+   * @param addr Used Ring 的 64 位物理地址
+   */
+  auto SetQueueUsed(uint32_t queue_idx, uint64_t addr) -> void {
+    SelectQueue(queue_idx);
+    Write64(CommonCfg::kQueueDevice, addr);
+  }
+
+  [[nodiscard]] auto GetQueueReady(uint32_t queue_idx) -> bool {
+    SelectQueue(queue_idx);
+    return common_.Read<uint16_t>(CommonCfg::kQueueEnable) != 0;
+  }
+
+  /**
+   * @brief 启用队列
+   *
+   * 启用前映射该队列与配置变更中断的 MSI-X 向量（设备复位后两者均为
+   * kPciNoVector，每次初始化都须在 DRIVER_OK 之前重新写入），并缓存其
+   * queue_notify_off，使 NotifyQueue() 不必再访问 common config。
+   *
+   * @param queue_idx 队列索引
+   * @param ready 为 false 时不做任何操作（PCI 传输层不允许写 0 禁用
+   *        队列，须通过设备复位或 queue_reset）
+   * @see virtio-v1.2#4.1.4.3.2
+   */
+  auto SetQueueReady(uint32_t queue_idx, bool ready) -> void {
+    if (!ready) {
+      return;
+    }
+    SelectQueue(queue_idx);
+    if (msix_table_size_ != 0) {
+      if (common_.Read<uint16_t>(CommonCfg::kConfigMsixVector) != 0) {
+        common_.Write<uint16_t>(CommonCfg::kConfigMsixVector, 0);
+        if (common_.Read<uint16_t>(CommonCfg::kConfigMsixVector) != 0) {
+          Traits::Log("Config MSI-X vector 0 rejected by device");
+        }
+      }
+      uint16_t vector = queue_idx + 1 < msix_table_size_
+                            ? static_cast<uint16_t>(queue_idx + 1)
+                            : static_cast<uint16_t>(msix_table_size_ - 1);
+      common_.Write<uint16_t>(CommonCfg::kQueueMsixVector, vector);
+      if (common_.Read<uint16_t>(CommonCfg::kQueueMsixVector) != vector) {
+        Traits::Log("Queue %u: MSI-X vector %u rejected by device", queue_idx,
+                    vector);
+      }
+    }
+    if (queue_idx < kMaxCachedQueues) {
+      notify_off_[queue_idx] =
+          common_.Read<uint16_t>(CommonCfg::kQueueNotifyOff);
+    }
+    common_.Write<uint16_t>(CommonCfg::kQueueEnable, 1);
+  }
+
+  /**
+   * @brief 通知设备有新的可用缓冲区
+   *
+   * @see virtio-v1.2#4.1.5.2 Available Buffer Notifications
+   */
+  auto NotifyQueue(uint32_t queue_idx) -> void {
+    notify_.Write<uint16_t>(
+        static_cast<size_t>(NotifyOffset(queue_idx)) * notify_off_multiplier_,
+        static_cast<uint16_t>(queue_idx));
+  }
+
+  /**
+   * @brief 携带通知数据通知设备（需 VIRTIO_F_NOTIFICATION_DATA）
+   *
+   * 向队列的通知地址写入 32 位通知数据 vqn | (next_off_wrap << 16)。
+   *
+   * @param queue_idx 队列索引
+   * @param next_off_wrap Virtqueue 的通知数据（见 NotificationData()）
+   * @see virtio-v1.2#4.1.5.2 Available Buffer Notifications
+   */
+  auto NotifyQueueWithData(uint32_t queue_idx, uint16_t next_off_wrap)
+      -> void {
+    notify_.Write<uint32_t>(
+        static_cast<size_t>(NotifyOffset(queue_idx)) * notify_off_multiplier_,
+        (queue_idx & 0xFFFF) | (static_cast<uint32_t>(next_off_wrap) << 16));
+  }
+
+  /**
+   * @brief 读取 ISR status
+   *
+   * @warning 读取即清除设备的 ISR status 并撤销 INTx 中断；
+   *          启用 MSI-X 后队列中断不再更新此寄存器
+   * @see virtio-v1.2#4.1.4.5 ISR status capability
+   */
+  [[nodiscard]] auto GetInterruptStatus() const -> uint32_t {
+    return isr_.Read<uint8_t>(0);
+  }
+
+  /// ISR status 在读取时已清除，无需单独确认
   auto AckInterrupt(uint32_t /*ack_bits*/) -> void {}
 
-  [[nodiscard]] auto ReadConfigU8(uint32_t /*offset*/) const -> uint8_t {
-    return 0;
+  /**
+   * @brief 读取配置空间 8 位值
+   *
+   * @param offset 相对于 device config 区域起始的偏移量
+   * @see virtio-v1.2#4.1.4.6 Device-specific configuration
+   */
+  [[nodiscard]] auto ReadConfigU8(uint32_t offset) const -> uint8_t {
+    return device_.Read<uint8_t>(offset);
+  }
+
+  /**
+   * @brief 读取配置空间 16 位值
+   *
+   * @param offset 相对于 device config 区域起始的偏移量
+   */
+  [[nodiscard]] auto ReadConfigU16(uint32_t offset) const -> uint16_t {
+    return device_.Read<uint16_t>(offset);
+  }
+
+  /**
+   * @brief 读取配置空间 32 位值
+   *
+   * @param offset 相对于 device config 区域起始的偏移量
+   */
+  [[nodiscard]] auto ReadConfigU32(uint32_t offset) const -> uint32_t {
+    return device_.Read<uint32_t>(offset);
+  }
+
+  /**
+   * @brief 读取配置空间 64 位值
+   *
+   * 以两次 32 位读取完成，并借助 config_generation 保证一致性
+   * （与 MmioTransport::ReadConfigU64 相同）。
+   *
+   * @param offset 相对于 device config 区域起始的偏移量
+   * @see virtio-v1.2#2.5.1 Driver Requirements: Device Configuration Space
+   */
+  [[nodiscard]] auto ReadConfigU64(uint32_t offset) const -> uint64_t {
+    uint32_t gen1;
+    uint32_t gen2;
+    uint64_t value;
+
+    static constexpr uint32_t kMaxConfigRetries = 1000;
+    uint32_t retries = 0;
+    do {
+      gen1 = GetConfigGeneration();
+
+      uint64_t lo = device_.Read<uint32_t>(offset);
+      uint64_t hi = device_.Read<uint32_t>(offset + 4);
+      value = (hi << 32) | lo;
+
+      gen2 = GetConfigGeneration();
+    } while (gen1 != gen2 && ++retries < kMaxConfigRetries);
+
+    return value;
+  }
+
+  /**
+   * @brief 写入配置空间 8 位值
+   *
+   * @param offset 相对于 device config 区域起始的偏移量
+   * @param value 写入值
+   */
+  auto WriteConfigU8(uint32_t offset, uint8_t value) -> void {
+    device_.Write<uint8_t>(offset, value);
+  }
+
+  [[nodiscard]] auto GetConfigGeneration() const -> uint32_t {
+    return common_.Read<uint8_t>(CommonCfg::kConfigGeneration);
+  }
+
+  /// @name MSI-X
+  /// @{
+
+  /// @brief 设备 MSI-X 表的向量数（不支持 MSI-X 时为 0）
+  [[nodiscard]] auto GetMsixTableSize() const -> uint32_t {
+    return msix_table_size_;
+  }
+
+  /**
+   * @brief 读取配置变更中断当前映射的 MSI-X 向量
+   *
+   * @return 向量号，未映射返回 kPciNoVector
+   */
+  [[nodiscard]] auto GetConfigMsixVector() -> uint16_t {
+    return common_.Read<uint16_t>(CommonCfg::kConfigMsixVector);
+  }
+
+  /**
+   * @brief 读取队列当前映射的 MSI-X 向量
+   *
+   * @param queue_idx 队列索引
+   * @return 向量号，未映射返回 kPciNoVector
+   */
+  [[nodiscard]] auto GetQueueMsixVector(uint32_t queue_idx) -> uint16_t {
+    SelectQueue(queue_idx);
+    return common_.Read<uint16_t>(CommonCfg::kQueueMsixVector);
+  }
+
+  /**
+   * @brief 填写 MSI-X 表项并取消屏蔽
+   *
+   * @param vector 向量号（< GetMsixTableSize()）
+   * @param address 消息地址（中断控制器的 MSI 门铃地址）
+   * @param data 消息数据（通常为中断号）
+   * @return 向量号越界或设备不支持 MSI-X 返回 kInvalidArgument
+   * @see PCI Local Bus Specification 3.0 §6.8.2.6 MSI-X Table
+   */
+  auto SetMsixEntry(uint32_t vector, uint64_t address, uint32_t data)
+      -> Expected<void> {
+    if (vector >= msix_table_size_) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    size_t entry = static_cast<size_t>(vector) * kMsixEntrySize;
+    msix_table_.Write<uint32_t>(entry + 0x0, static_cast<uint32_t>(address));
+    msix_table_.Write<uint32_t>(entry + 0x4,
+                                static_cast<uint32_t>(address >> 32));
+    msix_table_.Write<uint32_t>(entry + 0x8, data);
+    // Vector Control bit 0 = Mask
+    msix_table_.Write<uint32_t>(entry + 0xC, 0);
+    return {};
+  }
+
+  /**
+   * @brief 启用/禁用 MSI-X
+   *
+   * 启用前应已通过 SetMsixEntry() 填写所有被映射的向量。
+   *
+   * @param enable true 启用，false 回退到 INTx + ISR status
+   * @return 设备不支持 MSI-X 返回 kNotSupported
+   */
+  auto EnableMsix(bool enable) -> Expected<void> {
+    if (msix_table_size_ == 0) {
+      return std::unexpected(Error{ErrorCode::kNotSupported});
+    }
+    // Message Control: bit 15 = MSI-X Enable, bit 14 = Function Mask
+    auto control = cfg_.Read<uint16_t>(msix_cap_ + 2);
+    control = static_cast<uint16_t>(enable ? (control | 0x8000) & ~0x4000
+                                           : control & ~0x8000);
+    cfg_.Write<uint16_t>(msix_cap_ + 2, control);
+    msix_enabled_ = enable;
+    return {};
   }
-  [[nodiscard]] auto ReadConfigU16(uint32_t /*offset*/) const -> uint16_t {
-    return 0;
+
+  /**
+   * @brief 每个队列是否使用独立的中断向量
+   *
+   * 为 true 时队列完成中断不更新 ISR status，按队列的中断处理不应读取它。
+   *
+   * @see virtio-v1.2#4.1.4.5.2 Driver Requirements: ISR status capability
+   */
+  [[nodiscard]] auto UsesQueueVectors() const -> bool {
+    return msix_enabled_;
+  }
+
+  /// @}
+
+  /// 获取 ECAM 配置空间地址
+  [[nodiscard]] auto base() const -> uint64_t { return cfg_.base(); }
+
+ private:
+  /// PCI capability ID：MSI-X
+  static constexpr uint8_t kCapIdMsix = 0x11;
+  /// PCI capability ID：Vendor Specific（virtio_pci_cap）
+  static constexpr uint8_t kCapIdVendor = 0x09;
+  /// MSI-X 表项大小（字节）
+  static constexpr size_t kMsixEntrySize = 16;
+  /// capability 链表遍历上限（防止环形链表）
+  static constexpr uint32_t kMaxCapabilities = 48;
+  /// 等待复位完成的轮询上限
+  static constexpr uint32_t kMaxResetSpins = 1000000;
+
+  /**
+   * @brief 遍历 capability 链表
+   *
+   * 同一类型出现多次时使用第一个可用的（BAR 已分配的内存 BAR）。
+   *
+   * @param cfg 配置空间访问器
+   * @param layout 解析结果
+   * @return common/notify/ISR config 均已找到返回 true
+   * @see virtio-v1.2#4.1.4 Virtio Structure PCI Capabilities
+   */
+  static auto ParseCapabilities(MmioAccessor cfg, VirtioPciLayout& layout)
+      -> bool {
+    // Status bit 4 = Capabilities List
+    if ((cfg.Read<uint16_t>(PciReg::kPciStatus) & 0x10) == 0) {
+      Traits::Log("PCI device has no capability list");
+      return false;
+    }
+
+    uint8_t cap = cfg.Read<uint8_t>(PciReg::kCapabilitiesPtr) & ~0x3;
+    for (uint32_t n = 0; cap != 0 && n < kMaxCapabilities; ++n) {
+      uint8_t cap_id = cfg.Read<uint8_t>(cap);
+      if (cap_id == kCapIdMsix) {
+        ParseMsix(cfg, cap, layout);
+      } else if (cap_id == kCapIdVendor) {
+        ParseVirtioCap(cfg, cap, layout);
+      }
+      cap = cfg.Read<uint8_t>(cap + 1) & ~0x3;
+    }
+
+    if (layout.common == 0 || layout.notify == 0 || layout.isr == 0) {
+      Traits::Log("PCI device lacks common/notify/ISR capability");
+      return false;
+    }
+    // 无设备特定配置的设备（如 entropy）可以不提供 device config
+    return true;
   }
-  [[nodiscard]] auto ReadConfigU32(uint32_t /*offset*/) const -> uint32_t {
-    return 0;
+
+  /**
+   * @brief 解析一个 virtio_pci_cap
+   *
+   * @param cfg 配置空间访问器
+   * @param cap capability 在配置空间中的偏移
+   * @param layout 解析结果
+   */
+  static auto ParseVirtioCap(MmioAccessor cfg, uint8_t cap,
+                             VirtioPciLayout& layout) -> void {
+    auto cfg_type = cfg.Read<uint8_t>(cap + 3);
+    auto bar = cfg.Read<uint8_t>(cap + 4);
+    auto offset = cfg.Read<uint32_t>(cap + 8);
+
+    uint64_t* region = nullptr;
+    switch (cfg_type) {
+      case PciCapType::kCommonCfg:
+        region = &layout.common;
+        break;
+      case PciCapType::kNotifyCfg:
+        region = &layout.notify;
+        break;
+      case PciCapType::kIsrCfg:
+        region = &layout.isr;
+        break;
+      case PciCapType::kDeviceCfg:
+        region = &layout.device;
+        break;
+      default:
+        return;
+    }
+    if (*region != 0) {
+      return;
+    }
+    uint64_t bar_base = BarAddress(cfg, bar);
+    if (bar_base == 0) {
+      return;
+    }
+    *region = bar_base + offset;
+    if (cfg_type == PciCapType::kNotifyCfg) {
+      layout.notify_off_multiplier = cfg.Read<uint32_t>(cap + 16);
+    }
   }
-  [[nodiscard]] auto ReadConfigU64(uint32_t /*offset*/) const -> uint64_t {
-    return 0;
+
+  /**
+   * @brief 解析 MSI-X capability
+   *
+   * @param cfg 配置空间访问器
+   * @param cap capability 在配置空间中的偏移
+   * @param layout 解析结果
+   */
+  static auto ParseMsix(MmioAccessor cfg, uint8_t cap, VirtioPciLayout& layout)
+      -> void {
+    auto table = cfg.Read<uint32_t>(cap + 4);
+    uint64_t bar_base = BarAddress(cfg, table & 0x7);
+    if (bar_base == 0) {
+      return;
+    }
+    layout.msix_cap = cap;
+    // Table Size 字段为 N - 1
+    layout.msix_table_size = (cfg.Read<uint16_t>(cap + 2) & 0x7FF) + 1U;
+    layout.msix_table = bar_base + (table & ~0x7U);
   }
-  [[nodiscard]] auto GetConfigGeneration() const -> uint32_t { return 0; }
+
+  /**
+   * @brief 读取内存 BAR 的虚拟地址
+   *
+   * @param cfg 配置空间访问器
+   * @param bar BAR 编号（0 ~ 5）
+   * @return 虚拟地址；I/O BAR、未分配或编号非法返回 0
+   */
+  [[nodiscard]] static auto BarAddress(MmioAccessor cfg, uint8_t bar)
+      -> uint64_t {
+    if (bar > 5) {
+      return 0;
+    }
+    size_t reg = PciReg::kBar0 + bar * 4U;
+    uint32_t lo = cfg.Read<uint32_t>(reg);
+    // bit 0 = I/O Space
+    if ((lo & 0x1) != 0) {
+      return 0;
+    }
+    uint64_t phys = lo & ~0xFULL;
+    // bits 2:1 = 0b10 表示 64 位 BAR
+    if (((lo >> 1) & 0x3) == 0x2 && bar < 5) {
+      phys |= static_cast<uint64_t>(cfg.Read<uint32_t>(reg + 4)) << 32;
+    }
+    if (phys == 0) {
+      return 0;
+    }
+    return reinterpret_cast<uint64_t>(
+        Traits::PhysToVirt(static_cast<uintptr_t>(phys)));
+  }
+
+  /// 队列的 queue_notify_off（缓存范围外的队列读取 common config）
+  auto NotifyOffset(uint32_t queue_idx) -> uint16_t {
+    if (queue_idx < kMaxCachedQueues) {
+      return notify_off_[queue_idx];
+    }
+    SelectQueue(queue_idx);
+    return common_.Read<uint16_t>(CommonCfg::kQueueNotifyOff);
+  }
+
+  auto SelectQueue(uint32_t queue_idx) -> void {
+    common_.Write<uint16_t>(CommonCfg::kQueueSelect,
+                            static_cast<uint16_t>(queue_idx));
+  }
+
+  /// 以两次 32 位写入 64 位 common config 字段（低位在前）
+  auto Write64(size_t offset, uint64_t value) -> void {
+    common_.Write<uint32_t>(offset, static_cast<uint32_t>(value));
+    common_.Write<uint32_t>(offset + 4, static_cast<uint32_t>(value >> 32));
+  }
+
+  /// ECAM 配置空间访问器
+  MmioAccessor cfg_;
+  /// common config 区域
+  MmioAccessor common_;
+  /// notify 区域基地址
+  MmioAccessor notify_;
+  /// ISR status 区域
+  MmioAccessor isr_;
+  /// device config 区域
+  MmioAccessor device_;
+  /// MSI-X 表
+  MmioAccessor msix_table_;
+
+  /// 队列通知偏移倍数
+  uint32_t notify_off_multiplier_;
+  /// 已启用队列的 queue_notify_off 缓存
+  uint16_t notify_off_[kMaxCachedQueues]{};
+
+  /// MSI-X capability 在配置空间中的偏移（0 表示不支持）
+  uint8_t msix_cap_;
+  /// MSI-X 表向量数
+  uint32_t msix_table_size_;
+
+  /// 设备是否成功初始化
+  bool is_valid_;
+  /// MSI-X 是否已启用
+  bool msix_enabled_;
+
+  /// virtio Device ID
+  uint32_t device_id_;
+  /// PCI Subsystem Vendor ID
+  uint32_t vendor_id_;
 };
 
 }  // namespace device_framework::detail::virtio
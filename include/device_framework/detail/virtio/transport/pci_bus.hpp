@@ -0,0 +1,203 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_TRANSPORT_PCI_BUS_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_TRANSPORT_PCI_BUS_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "device_framework/detail/mmio_accessor.hpp"
+#include "device_framework/detail/pci_config_accessor.hpp"
+#include "device_framework/detail/virtio/traits.hpp"
+#include "device_framework/detail/virtio/transport/pci.hpp"
+
+namespace device_framework::detail::virtio {
+
+/**
+ * @brief 扫描得到的 virtio PCI function
+ */
+struct VirtioPciDeviceInfo {
+  /// function 配置空间的 ECAM 映射地址（PciTransport 构造参数）
+  uint64_t ecam = 0;
+  /// PCI 段组号
+  uint16_t segment = 0;
+  /// 总线号
+  uint8_t bus = 0;
+  /// 设备号
+  uint8_t device = 0;
+  /// function 号
+  uint8_t function = 0;
+  /// 已解析的 capability 布局（含 virtio Device ID）
+  VirtioPciLayout layout{};
+
+  /// @brief virtio Device ID（如块设备为 2）
+  [[nodiscard]] auto device_id() const -> uint32_t {
+    return layout.device_id;
+  }
+};
+
+/**
+ * @brief virtio PCI 设备枚举与批量探测
+ *
+ * Scan() 通过 ECAM 一次遍历窗口内的所有总线，对 Vendor ID 为 virtio
+ * 的 function 解析 capability 链表，把 BAR 区域地址缓存在紧凑的表中；
+ * 之后以 CreateTransport() 构造 PciTransport 时不再遍历配置空间。
+ *
+ * Probe() 的多核认领语义与 VirtioMmioBus::Probe() 相同。
+ *
+ * BAR 须在 Scan() 之前由固件或平台代码分配完毕（未分配的 BAR 不会
+ * 出现在布局中）。
+ *
+ * @tparam Traits 平台环境特征类型
+ * @tparam MaxDevices 表容量（超出的设备被忽略并记录日志）
+ * @warning Scan() 须在 Probe() 之前完成，且不得与 Probe() 并发
+ * @see VirtioMmioBus
+ */
+template <VirtioTraits Traits = NullVirtioTraits, size_t MaxDevices = 32>
+class VirtioPciBus {
+ public:
+  /**
+   * @brief 扫描一段 ECAM 窗口中的 virtio PCI function
+   *
+   * 非 virtio 的 function 只读取 Vendor ID 与 Header Type；缺少必需
+   * capability 的 virtio function 被跳过。不写任何配置寄存器。
+   *
+   * @param ecam ECAM 窗口访问器
+   * @return 设备表
+   */
+  [[nodiscard]] static auto Scan(const PciConfigAccessor& ecam)
+      -> VirtioPciBus {
+    VirtioPciBus bus;
+    ecam.ForEachFunction(
+        [&](uint8_t bus_no, uint8_t dev, uint8_t fn, MmioAccessor cfg) {
+          if (cfg.Read<uint16_t>(PciTransport<Traits>::PciReg::kVendorId) !=
+              kPciVendorVirtio) {
+            return;
+          }
+          auto layout = PciTransport<Traits>::ReadLayout(cfg.base());
+          if (!layout.IsComplete()) {
+            return;
+          }
+          if (bus.count_ == MaxDevices) {
+            Traits::Log("VirtioPciBus full, ignoring device %02x:%02x.%u",
+                        bus_no, dev, fn);
+            return;
+          }
+          bus.devices_[bus.count_++] = {cfg.base(), ecam.segment(), bus_no,
+                                        dev,        fn,             layout};
+        });
+    return bus;
+  }
+
+  /// @brief 扫描到的全部设备（按总线/设备/function 顺序）
+  [[nodiscard]] auto Devices() const -> std::span<const VirtioPciDeviceInfo> {
+    return {devices_, count_};
+  }
+
+  /**
+   * @brief 查找指定类型的第 nth 个设备
+   *
+   * @param device_id virtio Device ID
+   * @param nth 同类设备中的序号（从 0 开始）
+   * @return 设备信息，不存在时返回 std::nullopt
+   */
+  [[nodiscard]] auto Find(uint32_t device_id, size_t nth = 0) const
+      -> std::optional<VirtioPciDeviceInfo> {
+    for (size_t i = 0; i < count_; ++i) {
+      if (devices_[i].device_id() == device_id && nth-- == 0) {
+        return devices_[i];
+      }
+    }
+    return std::nullopt;
+  }
+
+  /// @brief 指定类型的设备数
+  [[nodiscard]] auto Count(uint32_t device_id) const -> size_t {
+    size_t n = 0;
+    for (size_t i = 0; i < count_; ++i) {
+      n += devices_[i].device_id() == device_id ? 1 : 0;
+    }
+    return n;
+  }
+
+  /**
+   * @brief 以缓存的布局构造传输层
+   *
+   * @param info Scan() 得到的设备信息
+   */
+  [[nodiscard]] static auto CreateTransport(const VirtioPciDeviceInfo& info)
+      -> PciTransport<Traits> {
+    return PciTransport<Traits>(info.ecam, info.layout);
+  }
+
+  /**
+   * @brief 认领并探测尚未处理的设备
+   *
+   * 可在多个核上同时调用：每个表项只会被一个调用者认领。回调返回
+   * true 表示已有驱动接管该设备。
+   *
+   * @tparam ProbeFn 签名：bool(const VirtioPciDeviceInfo& info)
+   * @param probe 探测回调（通常按 device_id() 选择驱动）
+   * @return 本次调用中回调返回 true 的设备数
+   */
+  template <typename ProbeFn>
+  auto Probe(ProbeFn&& probe) -> size_t {
+    size_t bound = 0;
+    while (true) {
+      size_t i = next_.fetch_add(1, std::memory_order_relaxed);
+      if (i >= count_) {
+        break;
+      }
+      bound += probe(static_cast<const VirtioPciDeviceInfo&>(devices_[i]))
+                   ? 1
+                   : 0;
+      probed_.fetch_add(1, std::memory_order_release);
+    }
+    return bound;
+  }
+
+  /**
+   * @brief 所有设备是否都已探测完成
+   */
+  [[nodiscard]] auto IsProbeComplete() const -> bool {
+    return probed_.load(std::memory_order_acquire) >= count_;
+  }
+
+  /// @name 构造/析构函数
+  /// @{
+  VirtioPciBus() = default;
+  ~VirtioPciBus() = default;
+  VirtioPciBus(const VirtioPciBus&) = delete;
+  auto operator=(const VirtioPciBus&) -> VirtioPciBus& = delete;
+  /// 移动仅在探测开始前进行（Scan() 返回时）
+  VirtioPciBus(VirtioPciBus&& other) noexcept
+      : count_(other.count_),
+        next_(other.next_.load(std::memory_order_relaxed)),
+        probed_(other.probed_.load(std::memory_order_relaxed)) {
+    for (size_t i = 0; i < count_; ++i) {
+      devices_[i] = other.devices_[i];
+    }
+  }
+  auto operator=(VirtioPciBus&&) noexcept -> VirtioPciBus& = delete;
+  /// @}
+
+ private:
+  /// 设备表
+  VirtioPciDeviceInfo devices_[MaxDevices]{};
+  /// 表中的设备数
+  size_t count_ = 0;
+  /// 下一个待认领的表项
+  std::atomic<size_t> next_{0};
+  /// 已探测完成的表项数
+  std::atomic<size_t> probed_{0};
+};
+
+}  // namespace device_framework::detail::virtio
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_TRANSPORT_PCI_BUS_HPP_ \
+        */
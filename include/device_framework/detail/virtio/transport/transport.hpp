@@ -65,6 +65,44 @@ concept TransportConcept =
       { ct.GetConfigGeneration() } -> std::same_as<uint32_t>;
     };
 
+/**
+ * @brief 可选：逐队列中断向量（如 PCI MSI-X）
+ *
+ * UsesQueueVectors() 为 true 时，每个队列的完成中断通过独立的向量投递，
+ * 且不更新共享的中断状态寄存器；驱动按队列处理中断时应跳过对它的
+ * 读取与确认。
+ */
+template <typename T>
+concept QueueVectorTransport = requires(const T ct) {
+  { ct.UsesQueueVectors() } -> std::same_as<bool>;
+};
+
+/**
+ * @brief 可选：携带通知数据的队列通知（VIRTIO_F_NOTIFICATION_DATA）
+ *
+ * 满足此约束的传输层允许驱动协商 VIRTIO_F_NOTIFICATION_DATA，并以
+ * NotifyQueueWithData() 代替 NotifyQueue()。
+ *
+ * @see virtio-v1.2#2.9 Driver Notifications
+ */
+template <typename T>
+concept NotificationDataTransport = requires(T t, uint32_t u32, uint16_t u16) {
+  { t.NotifyQueueWithData(u32, u16) } -> std::same_as<void>;
+};
+
+/**
+ * @brief 可选：写入设备配置空间
+ *
+ * 部分设备（如 virtio-input 的 select/subsel）需要驱动写入配置空间字段
+ * 来选择随后读取的内容；驱动这类设备的传输层必须满足此约束。
+ *
+ * @see virtio-v1.2#2.5 Device Configuration Space
+ */
+template <typename T>
+concept ConfigWriteTransport = requires(T t, uint32_t u32, uint8_t u8) {
+  { t.WriteConfigU8(u32, u8) } -> std::same_as<void>;
+};
+
 /**
  * @brief Virtio 传输层基类（零虚表开销，C++23 Deducing this）
  *
@@ -5,9 +5,13 @@
 #ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_VIRT_QUEUE_MISC_HPP_
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_VIRT_QUEUE_MISC_HPP_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
+#include "device_framework/detail/virtio/transport/transport.hpp"
+#include "device_framework/dma_buffer_pool.hpp"
+
 namespace device_framework::detail::virtio {
 
 /**
@@ -48,6 +52,301 @@ struct IoVec {
   size_t len;
 };
 
+/**
+ * @brief 由 DMA 缓冲区句柄构建 IoVec（使用缓存的物理地址，无地址转换）
+ *
+ * @param buffer DMA 缓冲区句柄
+ * @return 覆盖整个缓冲区的 IoVec
+ */
+[[nodiscard]] inline auto ToIoVec(const DmaBuffer& buffer) -> IoVec {
+  return {buffer.phys, buffer.size};
+}
+
+/**
+ * @brief 检查是否需要发送通知（vring_need_event）
+ *
+ * 基于 virtio 规范中的 vring_need_event 算法：检查 event_idx
+ * 是否落在 (old, new] 区间内（含 uint16_t 回绕处理）。
+ *
+ * @param event_idx 设备/驱动期望的通知阈值
+ * @param new_idx 当前索引
+ * @param old_idx 上次通知时的索引
+ * @return true 表示需要发送通知
+ * @see virtio-v1.2#2.7.10 Available Buffer Notification Suppression
+ */
+[[nodiscard]] constexpr auto VringNeedEvent(uint16_t event_idx,
+                                            uint16_t new_idx,
+                                            uint16_t old_idx) -> bool {
+  return static_cast<uint16_t>(new_idx - event_idx - 1) <
+         static_cast<uint16_t>(new_idx - old_idx);
+}
+
+/**
+ * @brief 向设备发送队列通知
+ *
+ * notification_data 为 true 且传输层支持时随通知携带下一个可用位置，
+ * 设备无需再读取 Available Ring 的索引。
+ *
+ * @param transport 传输层
+ * @param queue_index 传输层队列索引
+ * @param vq 对应的 Virtqueue
+ * @param notification_data 是否已协商 VIRTIO_F_NOTIFICATION_DATA
+ * @see virtio-v1.2#2.9 Driver Notifications
+ */
+template <class TransportImpl, class Vq>
+auto NotifyVirtqueue(TransportImpl& transport, uint16_t queue_index,
+                     const Vq& vq,
+                     [[maybe_unused]] bool notification_data) -> void {
+  if constexpr (NotificationDataTransport<TransportImpl>) {
+    if (notification_data) {
+      transport.NotifyQueueWithData(queue_index, vq.NotificationData());
+      return;
+    }
+  }
+  transport.NotifyQueue(queue_index);
+}
+
+/**
+ * @brief 按 Event Index 判断后通知设备
+ *
+ * 先以写屏障发布 Available Ring 的更新；队列启用 EVENT_IDX 时读取
+ * avail_event，仅当 (old_avail_idx, 当前 avail idx] 越过它时才通知。
+ *
+ * @tparam Traits 平台环境特性
+ * @param transport 传输层
+ * @param queue_index 传输层队列索引
+ * @param vq 对应的 Virtqueue
+ * @param old_avail_idx 上次通知时的 avail idx（更新为当前值）
+ * @param notification_data 是否已协商 VIRTIO_F_NOTIFICATION_DATA
+ * @return true 表示已通知设备，false 表示通知被抑制
+ * @see virtio-v1.2#2.7.10 Available Buffer Notification Suppression
+ */
+template <class Traits, class TransportImpl, class Vq>
+auto KickVirtqueue(TransportImpl& transport, uint16_t queue_index, Vq& vq,
+                   uint16_t& old_avail_idx, bool notification_data) -> bool {
+  // 写屏障：确保 Available Ring 更新对设备可见
+  Traits::Wmb();
+
+  uint16_t new_idx = vq.AvailIdx();
+  uint16_t old_idx = old_avail_idx;
+  old_avail_idx = new_idx;
+  auto* avail_event_ptr = vq.EventIdxEnabled() ? vq.UsedAvailEvent() : nullptr;
+  if (avail_event_ptr != nullptr) {
+    DmaSyncForCpu<Traits>(avail_event_ptr, sizeof(uint16_t));
+    if (!VringNeedEvent(*avail_event_ptr, new_idx, old_idx)) {
+      return false;
+    }
+  }
+  NotifyVirtqueue(transport, queue_index, vq, notification_data);
+  return true;
+}
+
+/**
+ * @brief 两级分层位图（摘要字 + 叶子字）
+ *
+ * 每个叶子字管理 64 个位，摘要字的第 w 位表示叶子字 w 已满，
+ * 分配和释放都只需两次 ctz / 位运算，与容量无关（O(1)）。
+ *
+ * @tparam N 位图容量（1 <= N <= 4096）
+ */
+template <size_t N>
+class SlotBitmap {
+ public:
+  static_assert(N >= 1 && N <= 64 * 64, "SlotBitmap supports 1..4096 slots");
+
+  /// 分配失败时的返回值
+  static constexpr size_t kInvalid = N;
+
+  /// 构造空位图（全部 N 位可分配）
+  constexpr SlotBitmap() { Reset(); }
+
+  /**
+   * @brief 清空位图，并将 [capacity, N) 标记为永久占用
+   *
+   * @param capacity 可分配的位数（超过 N 时按 N 处理）
+   */
+  constexpr auto Reset(size_t capacity = N) -> void {
+    if (capacity > N) {
+      capacity = N;
+    }
+    summary_ = 0;
+    for (size_t w = 0; w < kWords; ++w) {
+      size_t base = w * 64;
+      uint64_t reserved = 0;
+      if (capacity <= base) {
+        reserved = ~uint64_t{0};
+      } else if (capacity - base < 64) {
+        reserved = ~uint64_t{0} << (capacity - base);
+      }
+      leaf_[w] = reserved | ~LeafMask(w);
+      if (leaf_[w] == ~uint64_t{0}) {
+        summary_ |= uint64_t{1} << w;
+      }
+    }
+  }
+
+  /**
+   * @brief 分配编号最小的空闲位
+   * @return 位索引，无空闲位时返回 kInvalid
+   */
+  [[nodiscard]] constexpr auto Alloc() -> size_t {
+    uint64_t not_full = ~summary_ & kSummaryMask;
+    if (not_full == 0) {
+      return kInvalid;
+    }
+    auto w = static_cast<size_t>(__builtin_ctzll(not_full));
+    auto bit = static_cast<size_t>(__builtin_ctzll(~leaf_[w]));
+    leaf_[w] |= uint64_t{1} << bit;
+    if (leaf_[w] == ~uint64_t{0}) {
+      summary_ |= uint64_t{1} << w;
+    }
+    return w * 64 + bit;
+  }
+
+  /**
+   * @brief 释放指定位
+   * @param idx 位索引（越界时忽略）
+   */
+  constexpr auto Free(size_t idx) -> void {
+    if (idx >= N) {
+      return;
+    }
+    leaf_[idx / 64] &= ~(uint64_t{1} << (idx % 64));
+    summary_ &= ~(uint64_t{1} << (idx / 64));
+  }
+
+  /**
+   * @brief 检查指定位是否被占用
+   * @param idx 位索引
+   * @return 被占用返回 true；越界返回 false
+   */
+  [[nodiscard]] constexpr auto Test(size_t idx) const -> bool {
+    return idx < N && (leaf_[idx / 64] & (uint64_t{1} << (idx % 64))) != 0;
+  }
+
+ private:
+  /// 叶子字数量
+  static constexpr size_t kWords = (N + 63) / 64;
+  /// 摘要字中有效位的掩码
+  static constexpr uint64_t kSummaryMask =
+      kWords == 64 ? ~uint64_t{0} : (uint64_t{1} << kWords) - 1;
+
+  /**
+   * @brief 叶子字 w 中有效位的掩码（最后一个叶子字可能不满 64 位）
+   */
+  [[nodiscard]] static constexpr auto LeafMask(size_t w) -> uint64_t {
+    size_t bits = N - w * 64;
+    return bits >= 64 ? ~uint64_t{0} : (uint64_t{1} << bits) - 1;
+  }
+
+  /// 摘要字（bit w = 1 表示 leaf_[w] 已满）
+  uint64_t summary_ = 0;
+  /// 叶子字（bit i = 1 表示对应位被占用）
+  uint64_t leaf_[kWords] = {};
+};
+
+/**
+ * @brief 可并发分配/释放的位图
+ *
+ * 接口与 SlotBitmap 相同，Alloc()/Free()/Test() 以原子操作访问叶子字，
+ * 可由多个核同时调用。不维护摘要字，Alloc() 依次尝试各叶子字
+ * （O(N / 64)，N <= 256 时至多 4 个字）。Reset() 与拷贝不是线程安全的。
+ *
+ * @tparam N 位图容量（1 <= N <= 4096）
+ */
+template <size_t N>
+class AtomicSlotBitmap {
+ public:
+  static_assert(N >= 1 && N <= 64 * 64,
+                "AtomicSlotBitmap supports 1..4096 slots");
+
+  /// 分配失败时的返回值
+  static constexpr size_t kInvalid = N;
+
+  /// 构造空位图（全部 N 位可分配）
+  constexpr AtomicSlotBitmap() { Reset(); }
+
+  /**
+   * @brief 清空位图，并将 [capacity, N) 标记为永久占用
+   *
+   * @param capacity 可分配的位数（超过 N 时按 N 处理）
+   */
+  constexpr auto Reset(size_t capacity = N) -> void {
+    if (capacity > N) {
+      capacity = N;
+    }
+    for (size_t w = 0; w < kWords; ++w) {
+      size_t base = w * 64;
+      uint64_t reserved = 0;
+      if (capacity <= base) {
+        reserved = ~uint64_t{0};
+      } else if (capacity - base < 64) {
+        reserved = ~uint64_t{0} << (capacity - base);
+      }
+      leaf_[w] = reserved;
+    }
+  }
+
+  /**
+   * @brief 分配编号最小的可用空闲位（线程安全）
+   * @return 位索引，无空闲位时返回 kInvalid
+   */
+  [[nodiscard]] auto Alloc() -> size_t {
+    for (size_t w = 0; w < kWords; ++w) {
+      std::atomic_ref<uint64_t> leaf(leaf_[w]);
+      uint64_t value = leaf.load(std::memory_order_relaxed);
+      while (value != ~uint64_t{0}) {
+        auto bit = static_cast<size_t>(__builtin_ctzll(~value));
+        if (leaf.compare_exchange_weak(value, value | (uint64_t{1} << bit),
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+          return w * 64 + bit;
+        }
+      }
+    }
+    return kInvalid;
+  }
+
+  /**
+   * @brief 释放指定位（线程安全）
+   *
+   * 释放前对该位对应资源的写入对之后 Alloc() 到该位的核可见。
+   *
+   * @param idx 位索引（越界时忽略）
+   */
+  auto Free(size_t idx) -> void {
+    if (idx >= N) {
+      return;
+    }
+    std::atomic_ref<uint64_t>(leaf_[idx / 64])
+        .fetch_and(~(uint64_t{1} << (idx % 64)), std::memory_order_release);
+  }
+
+  /**
+   * @brief 检查指定位是否被占用（线程安全）
+   * @param idx 位索引
+   * @return 被占用返回 true；越界返回 false
+   */
+  [[nodiscard]] auto Test(size_t idx) const -> bool {
+    if (idx >= N) {
+      return false;
+    }
+    // atomic_ref 在 C++23 中不接受 const 类型，load 不修改叶子字
+    uint64_t value =
+        std::atomic_ref<uint64_t>(const_cast<uint64_t&>(leaf_[idx / 64]))
+            .load(std::memory_order_acquire);
+    return (value & (uint64_t{1} << (idx % 64))) != 0;
+  }
+
+ private:
+  /// 叶子字数量
+  static constexpr size_t kWords = (N + 63) / 64;
+
+  /// 叶子字（bit i = 1 表示对应位被占用）
+  alignas(std::atomic_ref<uint64_t>::required_alignment) uint64_t
+      leaf_[kWords] = {};
+};
+
 }  // namespace device_framework::detail::virtio
 
 #endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_VIRT_QUEUE_MISC_HPP_ */
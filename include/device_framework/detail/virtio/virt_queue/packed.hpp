@@ -0,0 +1,752 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_VIRT_QUEUE_PACKED_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_VIRT_QUEUE_PACKED_HPP_
+
+#include <utility>
+
+#include "device_framework/detail/virtio/defs.h"
+#include "device_framework/detail/virtio/traits.hpp"
+#include "device_framework/detail/virtio/virt_queue/misc.hpp"
+#include "device_framework/detail/virtio/virt_queue/virtqueue_base.hpp"
+#include "device_framework/expected.hpp"
+
+namespace device_framework::detail::virtio {
+
+/**
+ * @brief Packed Virtqueue 管理类
+ *
+ * 管理 packed virtqueue 的描述符提交与已用描述符回收。
+ * 驱动与设备共享同一个描述符环，请求提交与完成都只访问环上连续的条目，
+ * 相比 split virtqueue 的 desc/avail/used 三段内存具有更好的缓存局部性。
+ * 使用预分配的 DMA 内存，自身不进行任何堆内存分配。
+ *
+ * 内存布局（在 DMA 缓冲区中连续排列）：
+ * ```
+ * [Descriptor Ring]            aligned to 16
+ * [Driver Event Suppression]   aligned to 4
+ * [Device Event Suppression]   aligned to 4
+ * [Buffer ID State]            驱动私有，设备不访问
+ * ```
+ *
+ * 与 SplitVirtqueue 提供相同的 SubmitChain/HasUsed/PopUsed/FreeChain
+ * 接口与 CalcSize 约定，可直接作为 VirtioBlk 的 VirtqueueT 模板参数。
+ * SubmitChain 返回的是 Buffer ID（而非环上的位置），PopUsed 返回的
+ * UsedElem::id 与之对应，FreeChain 以 Buffer ID 归还描述符。
+ *
+ * @note 事件抑制结构保持 RING_EVENT_FLAGS_ENABLE（全零初始化），
+ *       AvailUsedEvent()/UsedAvailEvent() 返回 nullptr，
+ *       上层将回退为每次 Kick 都通知设备。
+ * @note 非一致性 DMA 平台（Traits 满足 DmaCoherencyTraits）上，
+ *       Device Event Suppression 与驱动私有状态按缓存行对齐，事件抑制结构
+ *       与间接描述符表执行缓存维护。描述符环由驱动与设备交替写入相邻条目，
+ *       无法以缓存行为单位维护，该部分须映射为不可缓存。
+ *
+ * @warning 非线程安全：此类的所有方法均不是线程安全的。
+ *          如果多个线程/核需要访问同一个 virtqueue，
+ *          调用者必须使用外部同步机制（如自旋锁或互斥锁）。
+ *
+ * @tparam Traits 平台环境特征类型
+ * @see virtio-v1.2#2.8 Packed Virtqueues
+ */
+template <VirtioTraits Traits = NullVirtioTraits>
+class PackedVirtqueue final : public VirtqueueBase<Traits> {
+ public:
+  /// 使用此 virtqueue 必须协商的特性位
+  static constexpr uint64_t kRequiredFeatures =
+      static_cast<uint64_t>(ReservedFeature::kRingPacked);
+
+  /**
+   * @brief Packed Descriptor Flags
+   * @see virtio-v1.2#2.8.1 Driver and Device Ring Wrap Counters
+   */
+  enum DescFlags : uint16_t {
+    /// 标记缓冲区通过下一个描述符继续
+    kDescFNext = 1,
+    /// 标记缓冲区为设备只写(否则为设备只读)
+    kDescFWrite = 2,
+    /// 标记缓冲区包含描述符列表(间接描述符)
+    kDescFIndirect = 4,
+    /// Available 标志位（bit 7）
+    kDescFAvail = 1 << 7,
+    /// Used 标志位（bit 15）
+    kDescFUsed = 1 << 15,
+  };
+
+  /**
+   * @brief Event Suppression Flags
+   * @see virtio-v1.2#2.8.10 Driver and Device Event Suppression
+   */
+  enum EventFlags : uint16_t {
+    /// 启用事件（通知/中断）
+    kEventFlagsEnable = 0,
+    /// 禁用事件
+    kEventFlagsDisable = 1,
+    /// 仅在 off_wrap 指定的描述符处触发事件（需 VIRTIO_F_EVENT_IDX）
+    kEventFlagsDesc = 2,
+  };
+
+  /**
+   * @brief Packed Virtqueue 描述符环条目
+   *
+   * 驱动写入时描述一个可用缓冲区，设备完成后原位写回为已用描述符
+   * （id 为 Buffer ID，len 为设备写入的字节数）。
+   *
+   * @note 16 字节对齐
+   * @see virtio-v1.2#2.8 Packed Virtqueues
+   */
+  struct Desc {
+    /// Descriptor Ring 对齐要求(字节)
+    static constexpr size_t kAlign = 16;
+    /// 缓冲区的客户机物理地址 (little-endian)
+    uint64_t addr;
+    /// 缓冲区长度(字节) (little-endian)
+    uint32_t len;
+    /// Buffer ID (little-endian)
+    uint16_t id;
+    /// 标志位: DescFlags (little-endian)
+    uint16_t flags;
+  } __attribute__((packed));
+
+  /**
+   * @brief 事件抑制结构
+   *
+   * Driver Event Suppression 由驱动写入、设备读取（控制设备中断）；
+   * Device Event Suppression 由设备写入、驱动读取（控制驱动通知）。
+   *
+   * @note 4 字节对齐
+   * @see virtio-v1.2#2.8.10 Driver and Device Event Suppression
+   */
+  struct EventSuppress {
+    /// Event Suppression 区域对齐要求(字节)
+    static constexpr size_t kAlign = 4;
+    /// bit 0-14: 描述符环偏移，bit 15: wrap counter (little-endian)
+    uint16_t off_wrap;
+    /// 标志位: EventFlags (little-endian)
+    uint16_t flags;
+  } __attribute__((packed));
+
+  /**
+   * @brief 已完成的缓冲区信息
+   *
+   * 与 SplitVirtqueue::UsedElem 字段一致，供上层统一处理。
+   */
+  struct UsedElem {
+    /// Buffer ID（SubmitChain 的返回值）
+    uint32_t id;
+    /// 设备写入描述符链的总字节数
+    uint32_t len;
+  };
+
+  /**
+   * @brief 计算给定队列大小所需的 DMA 内存字节数
+   *
+   * @param queue_size 队列大小（1 ~ 32768）
+   * @param event_idx 是否启用 VIRTIO_F_EVENT_IDX 特性（不影响 packed 布局，
+   *        保留此参数以与 SplitVirtqueue::CalcSize 保持一致）
+   * @return 所需的 DMA 内存字节数
+   * @see virtio-v1.2#2.8 Packed Virtqueues
+   */
+  [[nodiscard]] static constexpr auto CalcSize(uint16_t queue_size,
+                                               bool event_idx = true)
+      -> size_t {
+    (void)event_idx;
+    return StateOffset(queue_size) + sizeof(BufferState) * queue_size;
+  }
+
+  /**
+   * @brief 从预分配的 DMA 缓冲区构造 PackedVirtqueue
+   *
+   * @param dma_buf  DMA 缓冲区虚拟地址（必须已清零，大小 >= CalcSize()）
+   * @param phys_base DMA 缓冲区的客户机物理基地址
+   * @param queue_size 队列大小（1 ~ 32768）
+   * @param event_idx 是否启用 VIRTIO_F_EVENT_IDX 特性
+   * @see virtio-v1.2#2.8
+   */
+  PackedVirtqueue(void* dma_buf, uint64_t phys_base, uint16_t queue_size,
+                  bool event_idx)
+      : queue_size_(queue_size),
+        phys_base_(phys_base),
+        event_idx_enabled_(event_idx) {
+    if (dma_buf == nullptr || queue_size == 0 || queue_size > kMaxQueueSize) {
+      return;
+    }
+
+    auto* base = static_cast<uint8_t*>(dma_buf);
+    desc_ = reinterpret_cast<volatile Desc*>(base);
+    driver_event_ = reinterpret_cast<volatile EventSuppress*>(
+        base + DriverEventOffset(queue_size));
+    device_event_ = reinterpret_cast<volatile EventSuppress*>(
+        base + DeviceEventOffset(queue_size));
+    state_ = reinterpret_cast<BufferState*>(base + StateOffset(queue_size));
+
+    for (uint16_t i = 0; i < queue_size; ++i) {
+      state_[i].next = static_cast<uint16_t>(i + 1);
+      state_[i].num = 0;
+    }
+    // 末尾 Buffer ID 使用 sentinel 值，避免越界索引
+    state_[queue_size - 1].next = 0xFFFF;
+    // 写回清零产生的脏缓存行，避免之后覆盖设备写入的事件抑制结构
+    DmaSyncForDevice<Traits>(base, StateOffset(queue_size));
+    free_id_ = 0;
+    num_free_ = queue_size;
+    next_avail_ = 0;
+    avail_wrap_ = true;
+    last_used_ = 0;
+    used_wrap_ = true;
+
+    is_valid_ = true;
+  }
+
+  /**
+   * @brief 检查 virtqueue 是否成功初始化
+   */
+  [[nodiscard]] auto IsValid() const -> bool { return is_valid_; }
+
+  /**
+   * @brief 检查描述符环中是否有已完成的缓冲区
+   *
+   * 当 last_used 位置描述符的 AVAIL 与 USED 标志位相等，
+   * 且等于驱动的 used wrap counter 时，表示该描述符已被设备使用。
+   *
+   * @return true 表示有已完成的缓冲区可用，false 表示没有
+   * @see virtio-v1.2#2.8.1 Driver and Device Ring Wrap Counters
+   */
+  [[nodiscard]] auto HasUsed() const -> bool {
+    uint16_t flags = desc_[last_used_].flags;
+    bool avail = (flags & kDescFAvail) != 0;
+    bool used = (flags & kDescFUsed) != 0;
+    return avail == used && used == used_wrap_;
+  }
+
+  /**
+   * @brief 从描述符环弹出一个已完成的元素
+   *
+   * 读取设备写回的已用描述符，并按该 Buffer ID 对应链的描述符数量
+   * 推进 last_used 位置（跨越环尾时翻转 used wrap counter）。
+   *
+   * @return 成功返回 UsedElem{id, len}；
+   *         无可用元素时返回 ErrorCode::kNoUsedBuffers
+   *
+   * @warning 非线程安全
+   * @see virtio-v1.2#2.8 Packed Virtqueues
+   */
+  [[nodiscard]] auto PopUsed() -> Expected<UsedElem> {
+    if (!HasUsed()) {
+      return std::unexpected(Error{ErrorCode::kNoUsedBuffers});
+    }
+
+    // 读屏障：确保在读取 flags 之后再读取 id/len
+    Traits::Rmb();
+
+    UsedElem elem;
+    elem.id = desc_[last_used_].id;
+    elem.len = desc_[last_used_].len;
+    if (elem.id >= queue_size_ || state_[elem.id].num == 0) {
+      return std::unexpected(Error{ErrorCode::kInvalidDescriptor});
+    }
+
+    uint32_t next = last_used_ + state_[elem.id].num;
+    if (next >= queue_size_) {
+      next -= queue_size_;
+      used_wrap_ = !used_wrap_;
+    }
+    last_used_ = static_cast<uint16_t>(next);
+    ++last_used_idx_;
+
+    return elem;
+  }
+
+  /**
+   * @brief 提交 Scatter-Gather 描述符链
+   *
+   * 从 next_avail 位置开始按顺序写入 readable（设备只读）和
+   * writable（设备可写）缓冲区描述符，所有描述符携带同一 Buffer ID。
+   * 链头描述符的 flags 在写屏障之后最后写入，保证设备看到的是完整的链。
+   *
+   * 调用者在调用此方法后仍需调用内存屏障 + Transport::NotifyQueue() 通知设备。
+   *
+   * @param readable 设备只读缓冲区数组（如请求头、写入数据）
+   * @param readable_count readable 数组中的元素数量
+   * @param writable 设备可写缓冲区数组（如读取数据、状态字节）
+   * @param writable_count writable 数组中的元素数量
+   * @return 成功返回 Buffer ID（可用作 token）；失败返回错误
+   *
+   * @pre readable_count + writable_count > 0
+   * @pre readable_count + writable_count <= NumFree()
+   * @post 描述符链已对设备可见
+   *
+   * @warning 非线程安全
+   * @see virtio-v1.2#2.8.6 Next Flag: Descriptor Chaining
+   */
+  [[nodiscard]] auto SubmitChain(const IoVec* readable, size_t readable_count,
+                                 const IoVec* writable, size_t writable_count)
+      -> Expected<uint16_t> {
+    size_t total = readable_count + writable_count;
+    if (total == 0) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    if (num_free_ < total || free_id_ >= queue_size_) {
+      return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
+    }
+
+    uint16_t id = free_id_;
+    free_id_ = state_[id].next;
+    state_[id].num = static_cast<uint16_t>(total);
+    num_free_ -= static_cast<uint16_t>(total);
+
+    uint16_t head = next_avail_;
+    uint16_t head_flags = 0;
+    uint16_t pos = next_avail_;
+    bool wrap = avail_wrap_;
+
+    for (size_t i = 0; i < total; ++i) {
+      const IoVec& iov =
+          i < readable_count ? readable[i] : writable[i - readable_count];
+
+      uint16_t flags = wrap ? kDescFAvail : kDescFUsed;
+      if (i >= readable_count) {
+        flags |= kDescFWrite;
+      }
+      if (i + 1 < total) {
+        flags |= kDescFNext;
+      }
+
+      desc_[pos].addr = iov.phys_addr;
+      desc_[pos].len = static_cast<uint32_t>(iov.len);
+      desc_[pos].id = id;
+      if (i == 0) {
+        head_flags = flags;
+      } else {
+        desc_[pos].flags = flags;
+      }
+
+      if (++pos >= queue_size_) {
+        pos = 0;
+        wrap = !wrap;
+      }
+    }
+
+    next_avail_ = pos;
+    avail_wrap_ = wrap;
+    avail_idx_ = static_cast<uint16_t>(avail_idx_ + total);
+
+    PublishHead(head, head_flags);
+
+    return id;
+  }
+
+  /**
+   * @brief 通过间接描述符表提交 Scatter-Gather 请求
+   *
+   * 将 readable 和 writable 缓冲区写入调用者提供的间接描述符表，
+   * 然后仅占用一个环上描述符（flags 含 kDescFIndirect）指向该表。
+   * 需已协商 VIRTIO_F_INDIRECT_DESC。
+   *
+   * 间接表在设备处理完成（PopUsed 返回对应 id）之前不得被修改或复用。
+   *
+   * @param table 间接描述符表（DMA 可访问，16 字节对齐，
+   *        容量 >= readable_count + writable_count）
+   * @param table_phys 间接描述符表的物理地址
+   * @param readable 设备只读缓冲区数组
+   * @param readable_count readable 数组中的元素数量
+   * @param writable 设备可写缓冲区数组
+   * @param writable_count writable 数组中的元素数量
+   * @return 成功返回 Buffer ID；失败返回错误
+   *
+   * @pre readable_count + writable_count > 0
+   * @pre readable_count + writable_count <= Size()
+   * @post 单个间接描述符已对设备可见
+   *
+   * @warning 非线程安全
+   * @see virtio-v1.2#2.8.7 Indirect Flag: Scatter-Gather Support
+   */
+  [[nodiscard]] auto SubmitChainIndirect(volatile Desc* table,
+                                         uint64_t table_phys,
+                                         const IoVec* readable,
+                                         size_t readable_count,
+                                         const IoVec* writable,
+                                         size_t writable_count)
+      -> Expected<uint16_t> {
+    size_t total = readable_count + writable_count;
+    if (table == nullptr || total == 0 || total > queue_size_) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    if (num_free_ == 0 || free_id_ >= queue_size_) {
+      return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
+    }
+
+    // 间接表中的描述符按顺序排列，设备忽略其 NEXT/AVAIL/USED 标志
+    for (size_t i = 0; i < total; ++i) {
+      bool is_writable = i >= readable_count;
+      const IoVec& iov =
+          is_writable ? writable[i - readable_count] : readable[i];
+
+      table[i].addr = iov.phys_addr;
+      table[i].len = static_cast<uint32_t>(iov.len);
+      table[i].id = 0;
+      table[i].flags = is_writable ? kDescFWrite : 0;
+    }
+
+    uint16_t id = free_id_;
+    free_id_ = state_[id].next;
+    state_[id].num = 1;
+    --num_free_;
+
+    uint16_t head = next_avail_;
+    DmaSyncForDevice<Traits>(table, sizeof(Desc) * total);
+
+    desc_[head].addr = table_phys;
+    desc_[head].len = static_cast<uint32_t>(sizeof(Desc) * total);
+    desc_[head].id = id;
+    uint16_t head_flags = static_cast<uint16_t>(
+        kDescFIndirect | (avail_wrap_ ? kDescFAvail : kDescFUsed));
+
+    if (++next_avail_ >= queue_size_) {
+      next_avail_ = 0;
+      avail_wrap_ = !avail_wrap_;
+    }
+    ++avail_idx_;
+
+    PublishHead(head, head_flags);
+
+    return id;
+  }
+
+  /**
+   * @brief 进入批量提交模式
+   *
+   * 之后的 SubmitChain/SubmitChainIndirect 中，本批第一条链的链头 flags
+   * 延迟到 EndBatch() 写入，其余链直接写入 flags，且都不执行写屏障。
+   * 设备按环顺序读取描述符，在第一条链可用之前不会越过它。
+   *
+   * @warning 非线程安全
+   * @see virtio-v1.2#2.8.21.3.2 Notifying The Device
+   */
+  auto BeginBatch() -> void { batching_ = true; }
+
+  /**
+   * @brief 结束批量提交模式，以一次写屏障使整批描述符链可用
+   *
+   * @warning 非线程安全
+   */
+  auto EndBatch() -> void {
+    batching_ = false;
+    if (!batch_head_pending_) {
+      return;
+    }
+    batch_head_pending_ = false;
+
+    // 写屏障：确保整批描述符在第一条链头 flags 之前对设备可见
+    Traits::Wmb();
+
+    desc_[batch_head_].flags = batch_head_flags_;
+  }
+
+  /**
+   * @brief 释放 Buffer ID 对应的整条描述符链
+   *
+   * 归还该链占用的描述符数量与 Buffer ID。必须在 PopUsed() 之后调用。
+   *
+   * @param id Buffer ID（PopUsed() 返回的 UsedElem::id）
+   * @return 成功或失败（如 id 无效或未在使用中）
+   *
+   * @warning 非线程安全
+   * @see virtio-v1.2#2.8 Packed Virtqueues
+   */
+  auto FreeChain(uint16_t id) -> Expected<void> {
+    if (id >= queue_size_ || state_[id].num == 0) {
+      return std::unexpected(Error{ErrorCode::kInvalidDescriptor});
+    }
+
+    num_free_ += state_[id].num;
+    state_[id].num = 0;
+    state_[id].next = free_id_;
+    free_id_ = id;
+
+    return {};
+  }
+
+  /**
+   * @brief 获取描述符环的物理地址
+   * @see virtio-v1.2#2.8
+   */
+  [[nodiscard]] auto DescPhys() const -> uint64_t { return phys_base_; }
+
+  /**
+   * @brief 获取 Driver Event Suppression 区域的物理地址
+   *
+   * 对应传输层的 QueueDriver 寄存器（split 中为 Available Ring）。
+   *
+   * @see virtio-v1.2#2.8.10
+   */
+  [[nodiscard]] auto AvailPhys() const -> uint64_t {
+    return phys_base_ + DriverEventOffset(queue_size_);
+  }
+
+  /**
+   * @brief 获取 Device Event Suppression 区域的物理地址
+   *
+   * 对应传输层的 QueueDevice 寄存器（split 中为 Used Ring）。
+   *
+   * @see virtio-v1.2#2.8.10
+   */
+  [[nodiscard]] auto UsedPhys() const -> uint64_t {
+    return phys_base_ + DeviceEventOffset(queue_size_);
+  }
+
+  /**
+   * @brief 获取队列大小
+   */
+  [[nodiscard]] auto Size() const -> uint16_t { return queue_size_; }
+
+  /**
+   * @brief 获取当前空闲描述符数量
+   */
+  [[nodiscard]] auto NumFree() const -> uint16_t { return num_free_; }
+
+  /**
+   * @brief split 风格 used_event 字段（packed 布局中不存在）
+   *
+   * @return 始终返回 nullptr，上层据此跳过 used_event 更新
+   */
+  [[nodiscard]] auto AvailUsedEvent() -> volatile uint16_t* { return nullptr; }
+
+  [[nodiscard]] auto AvailUsedEvent() const -> const volatile uint16_t* {
+    return nullptr;
+  }
+
+  /**
+   * @brief split 风格 avail_event 字段（packed 布局中不存在）
+   *
+   * @return 始终返回 nullptr，上层据此回退为每次都通知设备
+   */
+  [[nodiscard]] auto UsedAvailEvent() -> volatile uint16_t* { return nullptr; }
+
+  [[nodiscard]] auto UsedAvailEvent() const -> const volatile uint16_t* {
+    return nullptr;
+  }
+
+  /**
+   * @brief 请求设备暂停 Used Buffer 通知（进入轮询模式）
+   *
+   * 将 Driver Event Suppression 的 flags 设为 kEventFlagsDisable。
+   *
+   * @see virtio-v1.2#2.8.10 Event Suppression Structure Format
+   */
+  auto DisableUsedNotify() -> void {
+    driver_event_->flags = kEventFlagsDisable;
+    DmaSyncForDevice<Traits>(driver_event_, sizeof(EventSuppress));
+  }
+
+  /**
+   * @brief 恢复 Used Buffer 通知（退出轮询模式）
+   *
+   * 恢复通知后再次检查描述符环：若期间已有新完成的缓冲区，
+   * 调用者需继续轮询处理。
+   *
+   * @return 没有待处理的已用缓冲区返回 true，否则返回 false
+   * @see virtio-v1.2#2.8.10 Event Suppression Structure Format
+   */
+  [[nodiscard]] auto EnableUsedNotify() -> bool {
+    driver_event_->flags = kEventFlagsEnable;
+    DmaSyncForDevice<Traits>(driver_event_, sizeof(EventSuppress));
+
+    // 全屏障：确保通知恢复对设备可见后再读取描述符环
+    Traits::Mb();
+
+    return !HasUsed();
+  }
+
+  /**
+   * @brief 获取 Driver Event Suppression 结构
+   * @see virtio-v1.2#2.8.10
+   */
+  [[nodiscard]] auto DriverEvent() -> volatile EventSuppress* {
+    return driver_event_;
+  }
+
+  /**
+   * @brief 获取 Device Event Suppression 结构
+   * @see virtio-v1.2#2.8.10
+   */
+  [[nodiscard]] auto DeviceEvent() const -> const volatile EventSuppress* {
+    return device_event_;
+  }
+
+  /**
+   * @brief 检查是否启用了 VIRTIO_F_EVENT_IDX 特性
+   */
+  [[nodiscard]] auto EventIdxEnabled() const -> bool {
+    return event_idx_enabled_;
+  }
+
+  /**
+   * @brief 获取已提交描述符总数（模 2^16）
+   */
+  [[nodiscard]] auto AvailIdx() const -> uint16_t { return avail_idx_; }
+
+  /**
+   * @brief VIRTIO_F_NOTIFICATION_DATA 的 next_off/next_wrap 字段
+   *
+   * bit 0-14：下一个可写入的描述符位置，bit 15：Driver Ring Wrap Counter。
+   *
+   * @see virtio-v1.2#2.9 Driver Notifications
+   */
+  [[nodiscard]] auto NotificationData() const -> uint16_t {
+    return static_cast<uint16_t>((next_avail_ & 0x7FFF) |
+                                 (avail_wrap_ ? 0x8000 : 0));
+  }
+
+  /**
+   * @brief 获取已回收的缓冲区总数（模 2^16）
+   */
+  [[nodiscard]] auto LastUsedIdx() const -> uint16_t { return last_used_idx_; }
+
+  /// @name 构造/析构函数
+  /// @{
+  PackedVirtqueue(const PackedVirtqueue&) = delete;
+  auto operator=(const PackedVirtqueue&) -> PackedVirtqueue& = delete;
+  auto operator=(PackedVirtqueue&&) -> PackedVirtqueue& = delete;
+  PackedVirtqueue(PackedVirtqueue&& other) noexcept
+      : VirtqueueBase<Traits>(std::move(other)),
+        desc_(other.desc_),
+        driver_event_(other.driver_event_),
+        device_event_(other.device_event_),
+        state_(other.state_),
+        queue_size_(other.queue_size_),
+        free_id_(other.free_id_),
+        num_free_(other.num_free_),
+        next_avail_(other.next_avail_),
+        last_used_(other.last_used_),
+        avail_idx_(other.avail_idx_),
+        last_used_idx_(other.last_used_idx_),
+        avail_wrap_(other.avail_wrap_),
+        used_wrap_(other.used_wrap_),
+        batch_head_(other.batch_head_),
+        batch_head_flags_(other.batch_head_flags_),
+        batch_head_pending_(other.batch_head_pending_),
+        batching_(other.batching_),
+        phys_base_(other.phys_base_),
+        event_idx_enabled_(other.event_idx_enabled_),
+        is_valid_(other.is_valid_) {
+    other.is_valid_ = false;
+    other.desc_ = nullptr;
+    other.driver_event_ = nullptr;
+    other.device_event_ = nullptr;
+    other.state_ = nullptr;
+  }
+  ~PackedVirtqueue() = default;
+  /// @}
+
+ private:
+  /**
+   * @brief 写入链头 flags，使描述符链对设备可用
+   *
+   * 批量模式下第一条链的链头 flags 被暂存，由 EndBatch() 写入。
+   *
+   * @param head 链头在描述符环中的位置
+   * @param flags 链头 flags
+   */
+  auto PublishHead(uint16_t head, uint16_t flags) -> void {
+    if (batching_) {
+      if (!batch_head_pending_) {
+        batch_head_pending_ = true;
+        batch_head_ = head;
+        batch_head_flags_ = flags;
+      } else {
+        desc_[head].flags = flags;
+      }
+      return;
+    }
+
+    // 写屏障：确保链中其他描述符（及间接表）在链头 flags 之前对设备可见
+    Traits::Wmb();
+
+    desc_[head].flags = flags;
+  }
+
+  /// packed virtqueue 最大队列大小
+  static constexpr uint16_t kMaxQueueSize = 32768;
+
+  /**
+   * @brief Buffer ID 的驱动私有状态
+   */
+  struct BufferState {
+    /// 空闲链表中下一个 Buffer ID
+    uint16_t next;
+    /// 该 Buffer ID 占用的描述符数量（0 表示空闲）
+    uint16_t num;
+  };
+
+  [[nodiscard]] static constexpr auto DriverEventOffset(uint16_t queue_size)
+      -> size_t {
+    return AlignUp(static_cast<size_t>(sizeof(Desc)) * queue_size,
+                   EventSuppress::kAlign);
+  }
+
+  /// 驱动写入区域与设备写入区域之间的对齐（DMA 一致的平台为 1）
+  static constexpr size_t kDmaLine = DmaCacheLineSize<Traits>();
+
+  [[nodiscard]] static constexpr auto DeviceEventOffset(uint16_t queue_size)
+      -> size_t {
+    return AlignUp(DriverEventOffset(queue_size) + sizeof(EventSuppress),
+                   kDmaLine);
+  }
+
+  [[nodiscard]] static constexpr auto StateOffset(uint16_t queue_size)
+      -> size_t {
+    return AlignUp(DeviceEventOffset(queue_size) + sizeof(EventSuppress),
+                   alignof(BufferState) > kDmaLine ? alignof(BufferState)
+                                                   : kDmaLine);
+  }
+
+  /// 描述符环指针（指向 DMA 内存）
+  volatile Desc* desc_ = nullptr;
+  /// Driver Event Suppression 指针（指向 DMA 内存）
+  volatile EventSuppress* driver_event_ = nullptr;
+  /// Device Event Suppression 指针（指向 DMA 内存）
+  volatile EventSuppress* device_event_ = nullptr;
+  /// Buffer ID 状态数组（驱动私有）
+  BufferState* state_ = nullptr;
+
+  /// 队列大小（描述符数量）
+  uint16_t queue_size_ = 0;
+  /// 空闲 Buffer ID 链表头
+  uint16_t free_id_ = 0;
+  /// 空闲描述符数量
+  uint16_t num_free_ = 0;
+  /// 下一个可写入的描述符位置
+  uint16_t next_avail_ = 0;
+  /// 下一个待回收的描述符位置
+  uint16_t last_used_ = 0;
+  /// 已提交描述符计数（模 2^16）
+  uint16_t avail_idx_ = 0;
+  /// 已回收缓冲区计数（模 2^16）
+  uint16_t last_used_idx_ = 0;
+  /// Driver Ring Wrap Counter
+  bool avail_wrap_ = true;
+  /// Device Ring Wrap Counter（驱动侧镜像）
+  bool used_wrap_ = true;
+  /// 批量模式下暂存的第一条链头位置
+  uint16_t batch_head_ = 0;
+  /// 批量模式下暂存的第一条链头 flags
+  uint16_t batch_head_flags_ = 0;
+  /// 是否有暂存的链头 flags 等待 EndBatch() 写入
+  bool batch_head_pending_ = false;
+  /// 是否处于批量提交模式
+  bool batching_ = false;
+
+  /// DMA 内存物理基地址（客户机物理地址）
+  uint64_t phys_base_ = 0;
+  /// 是否启用 VIRTIO_F_EVENT_IDX 特性
+  bool event_idx_enabled_ = false;
+  /// 初始化是否成功
+  bool is_valid_ = false;
+};
+
+}  // namespace device_framework::detail::virtio
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_VIRT_QUEUE_PACKED_HPP_ */
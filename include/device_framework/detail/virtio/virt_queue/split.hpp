@@ -5,6 +5,7 @@
 #ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_VIRT_QUEUE_SPLIT_HPP_
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DETAIL_VIRTIO_VIRT_QUEUE_SPLIT_HPP_
 
+#include <atomic>
 #include <utility>
 
 #include "device_framework/detail/virtio/traits.hpp"
@@ -27,11 +28,16 @@ namespace device_framework::detail::virtio {
  * [Used Ring]         aligned to 4
  * ```
  *
+ * 非一致性 DMA 平台（Traits 满足 DmaCoherencyTraits）上，Used Ring
+ * 额外按缓存行对齐，使驱动写入的区域与设备写入的 Used Ring 不共享
+ * 缓存行；环上的写入与读取都会执行相应的缓存维护。
+ *
  * @warning 非线程安全：此类的所有方法均不是线程安全的。
  *          如果多个线程/核需要访问同一个
  * virtqueue，调用者必须使用外部同步机制（如自旋锁或互斥锁）。
  * @warning 单生产者-单消费者：描述符分配和提交应由同一线程执行，
  *                          已用缓冲区回收应由另一线程执行（通常在中断处理程序中）。
+ * @note 例外：SubmitIndirectAt() 支持多个生产者并发提交（见其说明）。
  *
  * @tparam Traits 平台环境特征类型
  * @see virtio-v1.2#2.7
@@ -39,6 +45,9 @@ namespace device_framework::detail::virtio {
 template <VirtioTraits Traits = NullVirtioTraits>
 class SplitVirtqueue final : public VirtqueueBase<Traits> {
  public:
+  /// 使用此 virtqueue 必须协商的特性位（split 为默认格式，无额外要求）
+  static constexpr uint64_t kRequiredFeatures = 0;
+
   /**
    * @brief Descriptor Flags
    * @see virtio-v1.2#2.7.5 The Virtqueue Descriptor Table
@@ -224,7 +233,8 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
 
     // 按对齐要求排列
     size_t avail_off = AlignUp(desc_total, Avail::kAlign);
-    size_t used_off = AlignUp(avail_off + avail_total, used_align);
+    size_t used_off =
+        AlignUp(avail_off + avail_total, UsedRingAlign(used_align));
 
     return used_off + used_total;
   }
@@ -260,7 +270,8 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
     if (event_idx) {
       used_total += sizeof(uint16_t);
     }
-    used_offset_ = AlignUp(avail_offset_ + avail_total, used_align);
+    used_offset_ =
+        AlignUp(avail_offset_ + avail_total, UsedRingAlign(used_align));
 
     auto* base = static_cast<uint8_t*>(dma_buf);
     desc_ = reinterpret_cast<volatile Desc*>(base + desc_offset_);
@@ -275,6 +286,8 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
     free_head_ = 0;
     num_free_ = queue_size;
     last_used_idx_ = 0;
+    // 写回清零与初始化产生的脏缓存行，避免之后覆盖设备写入的 Used Ring
+    DmaSyncForDevice<Traits>(base, used_offset_ + used_total);
 
     is_valid_ = true;
   }
@@ -373,6 +386,10 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
    *
    * @note 调用者必须在调用此方法前确保描述符写入已完成
    * @note 调用者必须在调用此方法后通知设备（如 Transport::NotifyQueue()）
+   * @note 批量模式下（见 BeginBatch()）只写入 ring 条目，idx 由 EndBatch()
+   *       统一发布
+   * @note 非一致性 DMA 平台上，通过 GetDesc() 填写的描述符需由调用者
+   *       自行调用 DmaSyncForDevice()；ring 条目与 idx 由此方法处理
    *
    * @see Traits::Wmb() 用于确保 ring 写入在 idx 更新之前对设备可见
    *
@@ -380,13 +397,53 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
    * @see virtio-v1.2#2.7.13 Supplying Buffers to The Device
    */
   auto Submit(uint16_t head) -> void {
-    uint16_t idx = avail_->idx;
+    auto idx = static_cast<uint16_t>(avail_->idx + batch_pending_);
     avail_->ring[idx % queue_size_] = head;
+    DmaSyncForDevice<Traits>(&avail_->ring[idx % queue_size_],
+                             sizeof(uint16_t));
 
-    // 写屏障：确保 ring 写入在 idx 更新之前对设备可见
+    if (batching_) {
+      ++batch_pending_;
+      return;
+    }
+
+    // 写屏障：确保描述符与 ring 写入在 idx 更新之前对设备可见
     Traits::Wmb();
 
     avail_->idx = idx + 1;
+    DmaSyncForDevice<Traits>(&avail_->idx, sizeof(uint16_t));
+  }
+
+  /**
+   * @brief 进入批量提交模式
+   *
+   * 之后的 Submit/SubmitChain/SubmitChainIndirect 只写入描述符和 ring 条目，
+   * 不执行写屏障、不更新 avail->idx，直到 EndBatch() 一次性发布。
+   *
+   * @warning 非线程安全
+   */
+  auto BeginBatch() -> void { batching_ = true; }
+
+  /**
+   * @brief 结束批量提交模式，以一次写屏障发布全部 ring 条目
+   *
+   * 调用者随后仍需通知设备（如 Transport::NotifyQueue()）。
+   *
+   * @warning 非线程安全
+   * @see virtio-v1.2#2.7.13.3 Updating idx
+   */
+  auto EndBatch() -> void {
+    batching_ = false;
+    if (batch_pending_ == 0) {
+      return;
+    }
+
+    // 写屏障：确保整批描述符与 ring 写入在 idx 更新之前对设备可见
+    Traits::Wmb();
+
+    avail_->idx = static_cast<uint16_t>(avail_->idx + batch_pending_);
+    DmaSyncForDevice<Traits>(&avail_->idx, sizeof(uint16_t));
+    batch_pending_ = 0;
   }
 
   /**
@@ -399,6 +456,7 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
    * @see virtio-v1.2#2.7.14 Receiving Used Buffers From The Device
    */
   [[nodiscard]] auto HasUsed() const -> bool {
+    DmaSyncForCpu<Traits>(&used_->idx, sizeof(uint16_t));
     return last_used_idx_ != used_->idx;
   }
 
@@ -422,6 +480,7 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
     }
 
     uint16_t idx = last_used_idx_ % queue_size_;
+    DmaSyncForCpu<Traits>(&used_->ring[idx], sizeof(UsedElem));
     UsedElem elem;
     elem.id = used_->ring[idx].id;
     elem.len = used_->ring[idx].len;
@@ -484,6 +543,7 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
 
       if (prev_idx != 0xFFFF) {
         desc_[prev_idx].next = idx;
+        DmaSyncForDevice<Traits>(&desc_[prev_idx], sizeof(Desc));
       }
       prev_idx = idx;
     }
@@ -499,21 +559,140 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
 
       if (prev_idx != 0xFFFF) {
         desc_[prev_idx].next = idx;
+        DmaSyncForDevice<Traits>(&desc_[prev_idx], sizeof(Desc));
       }
       prev_idx = idx;
     }
 
     desc_[prev_idx].flags =
         desc_[prev_idx].flags & ~static_cast<uint16_t>(kDescFNext);
+    DmaSyncForDevice<Traits>(&desc_[prev_idx], sizeof(Desc));
 
-    // 写屏障：确保描述符写入在 Available Ring 更新之前对设备可见
-    Traits::Wmb();
+    // 描述符写入与 ring 条目一起由 Submit() 中的写屏障排序
+    Submit(head);
+
+    return head;
+  }
 
+  /**
+   * @brief 通过间接描述符表提交 Scatter-Gather 请求
+   *
+   * 将 readable 和 writable 缓冲区写入调用者提供的间接描述符表，
+   * 然后仅占用一个环上描述符（flags = kDescFIndirect）指向该表并提交到
+   * Available Ring。需已协商 VIRTIO_F_INDIRECT_DESC。
+   *
+   * 间接表在设备处理完成（PopUsed 返回对应 head）之前不得被修改或复用。
+   *
+   * @param table 间接描述符表（DMA 可访问，16 字节对齐，
+   *        容量 >= readable_count + writable_count）
+   * @param table_phys 间接描述符表的物理地址
+   * @param readable 设备只读缓冲区数组
+   * @param readable_count readable 数组中的元素数量
+   * @param writable 设备可写缓冲区数组
+   * @param writable_count writable 数组中的元素数量
+   * @return 成功返回描述符链头索引；失败返回错误
+   *
+   * @pre readable_count + writable_count > 0
+   * @pre readable_count + writable_count <= Size()
+   * @post 单个间接描述符已提交到 Available Ring
+   *
+   * @warning 非线程安全
+   * @see virtio-v1.2#2.7.5.3 Indirect Descriptors
+   */
+  [[nodiscard]] auto SubmitChainIndirect(volatile Desc* table,
+                                         uint64_t table_phys,
+                                         const IoVec* readable,
+                                         size_t readable_count,
+                                         const IoVec* writable,
+                                         size_t writable_count)
+      -> Expected<uint16_t> {
+    size_t total = readable_count + writable_count;
+    if (table == nullptr || total == 0 || total > queue_size_) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    if (num_free_ == 0) {
+      return std::unexpected(Error{ErrorCode::kNoFreeDescriptors});
+    }
+
+    uint16_t head = free_head_;
+    free_head_ = desc_[free_head_].next;
+    --num_free_;
+
+    WriteIndirect(head, table, table_phys, readable, readable_count, writable,
+                  writable_count);
+
+    // 间接表与描述符写入与 ring 条目一起由 Submit() 中的写屏障排序
     Submit(head);
 
     return head;
   }
 
+  /**
+   * @brief 多生产者并发提交：通过间接描述符表提交到调用者独占的描述符
+   *
+   * 与 SubmitChainIndirect() 相同地填写间接表和环上描述符 head，但不经过
+   * 空闲链表：head 由调用者静态分配（例如请求槽 i 固定使用描述符 i），
+   * 因此描述符的构建不需要任何共享状态。随后原子地预留一个 Available
+   * Ring 位置写入 head，并按预留顺序发布 avail->idx：只有这一步在
+   * 生产者之间串行（等待先预留的生产者发布完毕）。
+   *
+   * 多个生产者可同时以不同的 head 调用此方法；回收（HasUsed/PopUsed）
+   * 仍须由单一消费者执行。
+   *
+   * @param head 调用者独占的环上描述符索引（< Size()）
+   * @param table 间接描述符表（DMA 可访问，16 字节对齐，
+   *        容量 >= readable_count + writable_count）
+   * @param table_phys 间接描述符表的物理地址
+   * @param readable 设备只读缓冲区数组
+   * @param readable_count readable 数组中的元素数量
+   * @param writable 设备可写缓冲区数组
+   * @param writable_count writable 数组中的元素数量
+   * @return 成功或失败
+   *
+   * @pre 同一 virtqueue 上不混用 AllocDesc()/SubmitChain()/
+   *      SubmitChainIndirect()/批量模式
+   * @pre 同时在途的 head 不超过 Size() 个（环上位置不会被覆盖）
+   * @warning 已预留位置但尚未发布的生产者会阻塞之后的生产者，
+   *          调用期间不得被同一队列的其他提交者（如中断处理程序）抢占
+   * @see virtio-v1.2#2.7.13 Supplying Buffers to The Device
+   */
+  [[nodiscard]] auto SubmitIndirectAt(uint16_t head, volatile Desc* table,
+                                      uint64_t table_phys,
+                                      const IoVec* readable,
+                                      size_t readable_count,
+                                      const IoVec* writable,
+                                      size_t writable_count)
+      -> Expected<void> {
+    size_t total = readable_count + writable_count;
+    if (table == nullptr || head >= queue_size_ || total == 0 ||
+        total > queue_size_) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+
+    WriteIndirect(head, table, table_phys, readable, readable_count, writable,
+                  writable_count);
+
+    // 预留 ring 位置：在途请求不超过 Size() 个，该位置已被设备读取
+    uint16_t pos = std::atomic_ref<uint16_t>(avail_reserved_)
+                       .fetch_add(1, std::memory_order_relaxed);
+    avail_->ring[pos % queue_size_] = head;
+    DmaSyncForDevice<Traits>(&avail_->ring[pos % queue_size_],
+                             sizeof(uint16_t));
+
+    // 按预留顺序发布：等待先预留的生产者发布其 ring 条目
+    std::atomic_ref<uint16_t> published(avail_published_);
+    while (published.load(std::memory_order_acquire) != pos) {
+    }
+
+    // 写屏障：确保描述符与 ring 写入在 idx 更新之前对设备可见
+    Traits::Wmb();
+
+    avail_->idx = static_cast<uint16_t>(pos + 1);
+    DmaSyncForDevice<Traits>(&avail_->idx, sizeof(uint16_t));
+    published.store(static_cast<uint16_t>(pos + 1), std::memory_order_release);
+    return {};
+  }
+
   /**
    * @brief 释放整条描述符链
    *
@@ -556,6 +735,53 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
     return {};
   }
 
+  /**
+   * @brief 请求设备暂停 Used Buffer 通知（进入轮询模式）
+   *
+   * 未启用 EVENT_IDX 时设置 VIRTQ_AVAIL_F_NO_INTERRUPT；启用时设备忽略
+   * 该标志，改为将 used_event 推到当前位置之后半个索引空间，
+   * 在此之前设备不会发送通知。设备可能仍会发送少量通知，调用者需容忍。
+   *
+   * @see virtio-v1.2#2.7.7 Used Buffer Notification Suppression
+   */
+  auto DisableUsedNotify() -> void {
+    if (event_idx_enabled_) {
+      *avail_->used_event(queue_size_) =
+          static_cast<uint16_t>(last_used_idx_ + 0x8000);
+      DmaSyncForDevice<Traits>(avail_->used_event(queue_size_),
+                               sizeof(uint16_t));
+    } else {
+      avail_->flags = avail_->flags | kAvailFNoInterrupt;
+      DmaSyncForDevice<Traits>(&avail_->flags, sizeof(uint16_t));
+    }
+  }
+
+  /**
+   * @brief 恢复 Used Buffer 通知（退出轮询模式）
+   *
+   * 恢复通知后再次检查 Used Ring：若期间已有新完成的缓冲区，
+   * 设备不会为其补发通知，调用者需继续轮询处理。
+   *
+   * @return Used Ring 为空返回 true；已有待处理的缓冲区返回 false
+   * @see virtio-v1.2#2.7.7 Used Buffer Notification Suppression
+   */
+  [[nodiscard]] auto EnableUsedNotify() -> bool {
+    if (event_idx_enabled_) {
+      *avail_->used_event(queue_size_) = last_used_idx_;
+      DmaSyncForDevice<Traits>(avail_->used_event(queue_size_),
+                               sizeof(uint16_t));
+    } else {
+      avail_->flags =
+          avail_->flags & ~static_cast<uint16_t>(kAvailFNoInterrupt);
+      DmaSyncForDevice<Traits>(&avail_->flags, sizeof(uint16_t));
+    }
+
+    // 全屏障：确保通知恢复对设备可见后再读取 used->idx
+    Traits::Mb();
+
+    return !HasUsed();
+  }
+
   /**
    * @brief 获取描述符表的物理地址
    * @see virtio-v1.2#2.7.5
@@ -630,6 +856,17 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
    */
   [[nodiscard]] auto AvailIdx() const -> uint16_t { return avail_->idx; }
 
+  /**
+   * @brief VIRTIO_F_NOTIFICATION_DATA 的 next_off/next_wrap 字段
+   *
+   * Split Virtqueue 中即完整的 16 位 Available Ring 索引。
+   *
+   * @see virtio-v1.2#2.9 Driver Notifications
+   */
+  [[nodiscard]] auto NotificationData() const -> uint16_t {
+    return avail_->idx;
+  }
+
   /**
    * @brief 获取驱动程序上次处理到的 Used Ring 索引
    */
@@ -653,6 +890,10 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
         desc_offset_(other.desc_offset_),
         avail_offset_(other.avail_offset_),
         used_offset_(other.used_offset_),
+        batch_pending_(other.batch_pending_),
+        batching_(other.batching_),
+        avail_reserved_(other.avail_reserved_),
+        avail_published_(other.avail_published_),
         event_idx_enabled_(other.event_idx_enabled_),
         is_valid_(other.is_valid_) {
     other.is_valid_ = false;
@@ -664,6 +905,45 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
   /// @}
 
  private:
+  /**
+   * @brief Used Ring 的实际对齐（非一致性 DMA 平台上不小于缓存行）
+   *
+   * @param used_align 调用者要求的对齐
+   */
+  [[nodiscard]] static constexpr auto UsedRingAlign(size_t used_align)
+      -> size_t {
+    constexpr size_t kLine = DmaCacheLineSize<Traits>();
+    return used_align > kLine ? used_align : kLine;
+  }
+
+  /**
+   * @brief 填写间接描述符表及指向它的环上描述符 head
+   *
+   * @pre table 容量 >= readable_count + writable_count > 0
+   */
+  auto WriteIndirect(uint16_t head, volatile Desc* table, uint64_t table_phys,
+                     const IoVec* readable, size_t readable_count,
+                     const IoVec* writable, size_t writable_count) -> void {
+    size_t total = readable_count + writable_count;
+    for (size_t i = 0; i < total; ++i) {
+      bool is_writable = i >= readable_count;
+      const IoVec& iov =
+          is_writable ? writable[i - readable_count] : readable[i];
+
+      table[i].addr = iov.phys_addr;
+      table[i].len = static_cast<uint32_t>(iov.len);
+      table[i].flags = static_cast<uint16_t>(
+          (is_writable ? kDescFWrite : 0) | (i + 1 < total ? kDescFNext : 0));
+      table[i].next = static_cast<uint16_t>(i + 1);
+    }
+
+    desc_[head].addr = table_phys;
+    desc_[head].len = static_cast<uint32_t>(sizeof(Desc) * total);
+    desc_[head].flags = kDescFIndirect;
+    DmaSyncForDevice<Traits>(table, sizeof(Desc) * total);
+    DmaSyncForDevice<Traits>(&desc_[head], sizeof(Desc));
+  }
+
   /// 描述符表指针（指向 DMA 内存）
   volatile Desc* desc_ = nullptr;
   /// Available Ring 指针（指向 DMA 内存）
@@ -688,6 +968,14 @@ class SplitVirtqueue final : public VirtqueueBase<Traits> {
   size_t avail_offset_ = 0;
   /// Used Ring 在 DMA 内存中的偏移量（字节）
   size_t used_offset_ = 0;
+  /// 批量模式下已写入 ring 但尚未发布的条目数
+  uint16_t batch_pending_ = 0;
+  /// 是否处于批量提交模式
+  bool batching_ = false;
+  /// 并发提交：已预留的 Available Ring 位置（原子访问）
+  uint16_t avail_reserved_ = 0;
+  /// 并发提交：已发布的 avail idx（原子访问，按预留顺序推进）
+  uint16_t avail_published_ = 0;
   /// 是否启用 VIRTIO_F_EVENT_IDX 特性
   bool event_idx_enabled_ = false;
   /// 初始化是否成功
@@ -21,21 +21,26 @@ namespace device_framework::detail::virtio {
  * 派生类的具体实现，零虚表开销，无需传统 CRTP 的 static_cast。
  *
  * 派生类应提供以下方法（隐式接口）：
+ * - kRequiredFeatures: static constexpr uint64_t，必须协商的特性位
  * - IsValid() const -> bool
  * - Size() const -> uint16_t
  * - NumFree() const -> uint16_t
- * - AllocDesc() -> Expected<uint16_t>
- * - FreeDesc(uint16_t) -> Expected<void>
- * - Submit(uint16_t head) -> void
  * - HasUsed() const -> bool
  * - PopUsed() -> Expected<UsedElem>
  * - SubmitChain(const IoVec*, size_t, const IoVec*, size_t)
  *     -> Expected<uint16_t>
+ * - SubmitChainIndirect(volatile Desc*, uint64_t, const IoVec*, size_t,
+ *     const IoVec*, size_t) -> Expected<uint16_t>
+ * - BeginBatch() / EndBatch()：批量提交，整批只执行一次写屏障并发布一次
+ * - DisableUsedNotify() / EnableUsedNotify() -> bool：Used Buffer 通知抑制
  * - FreeChain(uint16_t head) -> Expected<void>
  * - DescPhys() const -> uint64_t
  * - AvailPhys() const -> uint64_t
  * - UsedPhys() const -> uint64_t
  *
+ * SplitVirtqueue 另外提供 AllocDesc/FreeDesc/Submit 等逐描述符操作；
+ * PackedVirtqueue 的描述符按环顺序使用，不提供这些方法。
+ *
  * @tparam Traits 平台环境特征类型
  * @see virtio-v1.2#2.7 / #2.8
  */
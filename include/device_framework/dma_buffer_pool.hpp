@@ -0,0 +1,332 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DMA_BUFFER_POOL_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DMA_BUFFER_POOL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "device_framework/expected.hpp"
+#include "device_framework/traits.hpp"
+
+namespace device_framework {
+
+/**
+ * @brief DMA 缓冲区句柄
+ *
+ * 同时携带虚拟地址与物理地址，驱动可直接用 phys 构建描述符，
+ * 无需每次请求都调用 Traits::VirtToPhys。缓冲区在物理上连续。
+ *
+ * 句柄可由 DmaBufferPool 分配，也可由调用者为自行管理的连续 DMA 内存
+ * 直接构造（index 保持 kNoIndex）。
+ */
+struct DmaBuffer {
+  /// 不属于任何缓冲池的句柄
+  static constexpr uint32_t kNoIndex = UINT32_MAX;
+
+  /// 虚拟地址
+  uint8_t* virt = nullptr;
+  /// 物理地址（DMA 地址）
+  uintptr_t phys = 0;
+  /// 缓冲区大小（字节）
+  size_t size = 0;
+  /// 在所属缓冲池中的索引
+  uint32_t index = kNoIndex;
+
+  /// @brief 缓冲区内容
+  [[nodiscard]] auto Data() const -> std::span<uint8_t> {
+    return {virt, size};
+  }
+
+  /// @brief 句柄是否有效
+  [[nodiscard]] auto IsValid() const -> bool { return virt != nullptr; }
+
+  /**
+   * @brief 截取子缓冲区（同一物理连续区域内，不做越界检查）
+   *
+   * @param offset 起始偏移（字节）
+   * @param len 长度（字节）
+   */
+  [[nodiscard]] auto Slice(size_t offset, size_t len) const -> DmaBuffer {
+    return {virt + offset, phys + offset, len, index};
+  }
+};
+
+/**
+ * @brief 预注册区域的定长 DMA 缓冲池
+ *
+ * 调用者通过 AddRegion() 注册物理连续的 DMA 内存区域，注册时只做一次
+ * 虚拟→物理地址转换并缓存；区域按 buffer_size（向上对齐到 alignment）
+ * 切分为定长缓冲区。Alloc()/Free() 使用带版本号的无锁栈（Treiber stack），
+ * 可在多核与中断上下文中并发调用。
+ *
+ * @tparam Traits 平台环境特征类型（需满足 DmaTraits）
+ * @tparam MaxBuffers 缓冲区数量上限
+ * @tparam MaxRegions 可注册的区域数量上限
+ * @warning AddRegion() 应在初始化阶段调用，不得与其他 AddRegion() 并发；
+ *          缓冲池在有缓冲区被借出时不得移动
+ */
+template <DmaTraits Traits, size_t MaxBuffers = 256, size_t MaxRegions = 4>
+class DmaBufferPool {
+ public:
+  static_assert(MaxBuffers >= 1 && MaxBuffers < UINT32_MAX,
+                "MaxBuffers must be in [1, UINT32_MAX)");
+  static_assert(MaxRegions >= 1, "MaxRegions must be at least 1");
+
+  /**
+   * @brief 创建缓冲池
+   *
+   * @param buffer_size 每个缓冲区的字节数
+   * @param alignment 缓冲区起始地址（虚拟与物理）的对齐要求，2 的幂
+   * @return 成功返回空缓冲池（需随后 AddRegion()），参数非法返回
+   *         kInvalidArgument
+   */
+  [[nodiscard]] static auto Create(size_t buffer_size, size_t alignment = 64)
+      -> Expected<DmaBufferPool> {
+    if (buffer_size == 0 || alignment == 0 ||
+        (alignment & (alignment - 1)) != 0) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    return DmaBufferPool(buffer_size, alignment);
+  }
+
+  /**
+   * @brief 注册一段物理连续的 DMA 内存区域
+   *
+   * 区域起始地址按 alignment 向上对齐后切分缓冲区，剩余不足一个
+   * 缓冲区的尾部不使用；缓冲区总数达到 MaxBuffers 后多余部分忽略。
+   *
+   * @param base 区域起始虚拟地址
+   * @param size 区域大小（字节）
+   * @return 新增的缓冲区数；参数非法返回 kInvalidArgument，区域表已满
+   *         或区域容纳不下任何缓冲区返回 kOutOfMemory
+   */
+  [[nodiscard]] auto AddRegion(void* base, size_t size) -> Expected<size_t> {
+    if (base == nullptr || size == 0) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    if (region_count_ >= MaxRegions || buffer_count_ >= MaxBuffers) {
+      return std::unexpected(Error{ErrorCode::kOutOfMemory});
+    }
+    auto addr = reinterpret_cast<uintptr_t>(base);
+    auto aligned = (addr + alignment_ - 1) & ~(alignment_ - 1);
+    size_t skip = aligned - addr;
+    if (skip >= size || (size - skip) / stride_ == 0) {
+      return std::unexpected(Error{ErrorCode::kOutOfMemory});
+    }
+    // 区域物理连续：整段只转换一次
+    uintptr_t phys = Traits::VirtToPhys(reinterpret_cast<void*>(aligned));
+    if ((phys & (alignment_ - 1)) != 0) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+
+    size_t count = (size - skip) / stride_;
+    if (count > MaxBuffers - buffer_count_) {
+      count = MaxBuffers - buffer_count_;
+    }
+    regions_[region_count_++] = {aligned, phys, count * stride_};
+
+    for (size_t i = 0; i < count; ++i) {
+      auto idx = static_cast<uint32_t>(buffer_count_ + i);
+      buffers_[idx] = {reinterpret_cast<uint8_t*>(aligned + i * stride_),
+                       phys + i * stride_};
+      Push(idx);
+    }
+    buffer_count_ += count;
+    return count;
+  }
+
+  /**
+   * @brief 分配一个缓冲区（无锁）
+   *
+   * @return 缓冲区句柄（size 为 GetBufferSize()），已耗尽返回 kOutOfMemory
+   */
+  [[nodiscard]] auto Alloc() -> Expected<DmaBuffer> {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    while (true) {
+      auto idx = static_cast<uint32_t>(head & kIndexMask);
+      if (idx == kEmpty) {
+        return std::unexpected(Error{ErrorCode::kOutOfMemory});
+      }
+      uint32_t next = next_[idx].load(std::memory_order_relaxed);
+      uint64_t desired = NextTag(head) | next;
+      if (head_.compare_exchange_weak(head, desired,
+                                      std::memory_order_acquire,
+                                      std::memory_order_acquire)) {
+        free_count_.fetch_sub(1, std::memory_order_relaxed);
+        return DmaBuffer{buffers_[idx].virt, buffers_[idx].phys, buffer_size_,
+                         idx};
+      }
+    }
+  }
+
+  /**
+   * @brief 归还缓冲区（无锁）
+   *
+   * @param buffer Alloc() 返回的句柄（或其 Slice()）
+   * @return 成功；句柄不属于本缓冲池返回 kInvalidArgument
+   * @warning 不检测重复归还
+   */
+  auto Free(const DmaBuffer& buffer) -> Expected<void> {
+    if (!Contains(buffer.index, buffer.virt)) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    Push(buffer.index);
+    return {};
+  }
+
+  /**
+   * @brief 查询已注册区域内地址的物理地址（不调用 Traits::VirtToPhys）
+   *
+   * @param ptr 已注册区域内的虚拟地址
+   * @return 物理地址；不在任何已注册区域内返回 kInvalidArgument
+   */
+  [[nodiscard]] auto Translate(const void* ptr) const -> Expected<uintptr_t> {
+    auto addr = reinterpret_cast<uintptr_t>(ptr);
+    for (size_t i = 0; i < region_count_; ++i) {
+      const auto& region = regions_[i];
+      if (addr >= region.virt && addr - region.virt < region.size) {
+        return region.phys + (addr - region.virt);
+      }
+    }
+    return std::unexpected(Error{ErrorCode::kInvalidArgument});
+  }
+
+  /// @brief 每个缓冲区的字节数
+  [[nodiscard]] auto GetBufferSize() const -> size_t { return buffer_size_; }
+
+  /// @brief 已注册的缓冲区总数
+  [[nodiscard]] auto GetCapacity() const -> size_t { return buffer_count_; }
+
+  /// @brief 空闲缓冲区数（并发场景下为近似值）
+  [[nodiscard]] auto GetFreeCount() const -> size_t {
+    return free_count_.load(std::memory_order_relaxed);
+  }
+
+  /// @name 移动/拷贝控制
+  /// @{
+  DmaBufferPool(DmaBufferPool&& other) noexcept
+      : buffer_size_(other.buffer_size_),
+        alignment_(other.alignment_),
+        stride_(other.stride_),
+        region_count_(other.region_count_),
+        buffer_count_(other.buffer_count_),
+        head_(other.head_.load(std::memory_order_relaxed)),
+        free_count_(other.free_count_.load(std::memory_order_relaxed)) {
+    for (size_t i = 0; i < region_count_; ++i) {
+      regions_[i] = other.regions_[i];
+    }
+    for (size_t i = 0; i < buffer_count_; ++i) {
+      buffers_[i] = other.buffers_[i];
+      next_[i].store(other.next_[i].load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+    }
+    other.region_count_ = 0;
+    other.buffer_count_ = 0;
+    other.head_.store(kEmpty, std::memory_order_relaxed);
+    other.free_count_.store(0, std::memory_order_relaxed);
+  }
+  auto operator=(DmaBufferPool&&) -> DmaBufferPool& = delete;
+  DmaBufferPool(const DmaBufferPool&) = delete;
+  auto operator=(const DmaBufferPool&) -> DmaBufferPool& = delete;
+  ~DmaBufferPool() = default;
+  /// @}
+
+ private:
+  /// 空栈标记（栈顶字的低 32 位）
+  static constexpr uint32_t kEmpty = UINT32_MAX;
+  /// 栈顶字中索引部分的掩码（高 32 位为防 ABA 的版本号）
+  static constexpr uint64_t kIndexMask = 0xFFFFFFFFULL;
+
+  /**
+   * @brief 已注册区域
+   */
+  struct Region {
+    /// 起始虚拟地址（已对齐）
+    uintptr_t virt;
+    /// 起始物理地址
+    uintptr_t phys;
+    /// 切分使用的字节数
+    size_t size;
+  };
+
+  /**
+   * @brief 缓冲区地址缓存
+   */
+  struct Buffer {
+    /// 虚拟地址
+    uint8_t* virt;
+    /// 物理地址
+    uintptr_t phys;
+  };
+
+  /// @brief 只能通过 Create() 工厂方法创建
+  DmaBufferPool(size_t buffer_size, size_t alignment)
+      : buffer_size_(buffer_size),
+        alignment_(alignment),
+        stride_((buffer_size + alignment - 1) & ~(alignment - 1)) {}
+
+  /**
+   * @brief 句柄的地址是否位于 index 对应缓冲区内（兼容 Slice()）
+   */
+  [[nodiscard]] auto Contains(uint32_t index, const uint8_t* virt) const
+      -> bool {
+    if (index >= buffer_count_) {
+      return false;
+    }
+    const auto* start = buffers_[index].virt;
+    return virt >= start && virt < start + buffer_size_;
+  }
+
+  /// @brief 栈顶字的下一个版本号（高 32 位加一）
+  [[nodiscard]] static constexpr auto NextTag(uint64_t head) -> uint64_t {
+    return (head & ~kIndexMask) + (kIndexMask + 1);
+  }
+
+  /**
+   * @brief 将缓冲区压入空闲栈
+   */
+  auto Push(uint32_t idx) -> void {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    while (true) {
+      next_[idx].store(static_cast<uint32_t>(head & kIndexMask),
+                       std::memory_order_relaxed);
+      uint64_t desired = NextTag(head) | idx;
+      if (head_.compare_exchange_weak(head, desired,
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+        free_count_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+  }
+
+  /// 每个缓冲区的字节数
+  size_t buffer_size_;
+  /// 对齐要求
+  size_t alignment_;
+  /// 相邻缓冲区的间距（buffer_size 向上对齐到 alignment）
+  size_t stride_;
+  /// 已注册区域
+  Region regions_[MaxRegions]{};
+  /// 已注册区域数
+  size_t region_count_ = 0;
+  /// 缓冲区地址缓存
+  Buffer buffers_[MaxBuffers]{};
+  /// 已注册缓冲区数
+  size_t buffer_count_ = 0;
+  /// 空闲栈中每个缓冲区的下一项
+  std::atomic<uint32_t> next_[MaxBuffers]{};
+  /// 空闲栈栈顶（高 32 位版本号 | 低 32 位索引）
+  std::atomic<uint64_t> head_{kEmpty};
+  /// 空闲缓冲区数
+  std::atomic<size_t> free_count_{0};
+};
+
+}  // namespace device_framework
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_DMA_BUFFER_POOL_HPP_ */
@@ -38,6 +38,8 @@ enum class ErrorCode : uint32_t {
   kTimeout = 0x005,
   /// 提供的内存不足
   kOutOfMemory = 0x006,
+  /// 操作已取消（如设备静默时仍在途的请求）
+  kCanceled = 0x007,
   /// @}
 
   /// @name 传输层错误 (0x100–0x1FF)
@@ -86,6 +88,18 @@ enum class ErrorCode : uint32_t {
   kDeviceBlockOutOfRange = 0x305,
   /// 读取失败
   kDeviceReadFailed = 0x306,
+  /// 设备忙，暂时无法接受新请求
+  kDeviceBusy = 0x307,
+  /// @}
+
+  /// @name ACPI 错误 (0x400–0x4FF)
+  /// @{
+  /// 无效的表签名
+  kAcpiInvalidSignature = 0x400,
+  /// 表校验和错误
+  kAcpiChecksumMismatch = 0x401,
+  /// 未找到指定的表
+  kAcpiTableNotFound = 0x402,
   /// @}
 };
 
@@ -112,6 +126,8 @@ constexpr auto GetErrorMessage(ErrorCode code) -> const char* {
       return "Operation timed out";
     case ErrorCode::kOutOfMemory:
       return "Out of memory";
+    case ErrorCode::kCanceled:
+      return "Operation canceled";
 
     // 传输层错误 (0x100–0x1FF)
     case ErrorCode::kInvalidMagic:
@@ -154,6 +170,16 @@ constexpr auto GetErrorMessage(ErrorCode code) -> const char* {
       return "Block number out of range";
     case ErrorCode::kDeviceReadFailed:
       return "Device read failed";
+    case ErrorCode::kDeviceBusy:
+      return "Device busy";
+
+    // ACPI 错误 (0x400–0x4FF)
+    case ErrorCode::kAcpiInvalidSignature:
+      return "Invalid ACPI table signature";
+    case ErrorCode::kAcpiChecksumMismatch:
+      return "ACPI table checksum mismatch";
+    case ErrorCode::kAcpiTableNotFound:
+      return "ACPI table not found";
 
     default:
       return "Unknown error";
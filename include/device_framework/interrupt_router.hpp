@@ -0,0 +1,313 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_INTERRUPT_ROUTER_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_INTERRUPT_ROUTER_HPP_
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "device_framework/expected.hpp"
+
+namespace device_framework {
+
+/**
+ * @brief 类型擦除后的中断源
+ *
+ * 以函数指针 + 上下文描述一个设备的中断处理，不依赖 RTTI 或虚函数。
+ * 通常由 InterruptRouter::MakeSource() 根据设备类型生成；需要带回调的
+ * HandleInterrupt 时，可直接用无捕获 lambda 填写 handle。
+ */
+struct InterruptSource {
+  /// 原样传给各函数的上下文（通常为设备对象指针）
+  void* context = nullptr;
+  /// 完整的中断处理
+  void (*handle)(void* context) = nullptr;
+  /// 廉价的挂起检查（只读状态寄存器）；为空表示总是调用 handle
+  bool (*pending)(void* context) = nullptr;
+  /// 只确认中断、推迟完整处理；为空表示不支持合并
+  void (*acknowledge)(void* context) = nullptr;
+};
+
+/**
+ * @brief 可选：廉价的中断挂起查询
+ *
+ * 设备自身或其 GetDriver() 满足此约束时，MakeSource() 生成的中断源
+ * 先检查挂起状态，再调用完整处理。
+ */
+template <typename T>
+concept InterruptPendingQuery = requires(T& device) {
+  { device.IsInterruptPending() } -> std::same_as<bool>;
+};
+
+/**
+ * @brief 可选：只确认中断、推迟完整处理
+ *
+ * 设备自身或其 GetDriver() 满足此约束时，其中断源支持合并阈值。
+ */
+template <typename T>
+concept InterruptAcknowledge = requires(T& device) {
+  { device.AcknowledgeInterrupt() } -> std::same_as<void>;
+};
+
+/**
+ * @brief IRQ 号到设备中断处理的分发表
+ *
+ * 每个 IRQ 对应一条共享该中断线的中断源链。Dispatch() 沿链先做廉价的
+ * 挂起检查，只对确有中断的设备调用完整处理，ISR 开销只随挂起设备数
+ * 增长，而不随挂在同一中断线上的设备总数增长。
+ *
+ * 合并阈值 coalesce > 1 且中断源支持 acknowledge 时，前 coalesce - 1 次
+ * 中断只确认不处理，第 coalesce 次才调用完整处理；被推迟的工作由
+ * Flush()（如定时器节拍中调用）兜底，避免低负载时完成被无限延迟。
+ *
+ * @tparam MaxIrqs 可路由的 IRQ 号上限（IRQ 号 < MaxIrqs）
+ * @tparam MaxSources 中断源数量上限
+ * @warning Attach()/Detach() 应在初始化阶段调用，不得与 Dispatch()/
+ *          Flush() 并发；同一 IRQ 的 Dispatch() 与 Flush() 须在同一核上
+ *          串行执行（中断控制器的 claim/complete 保证同一 IRQ 不会在
+ *          多个核上同时分发）
+ */
+template <size_t MaxIrqs = 64, size_t MaxSources = 32>
+class InterruptRouter {
+ public:
+  static_assert(MaxIrqs >= 1 && MaxIrqs <= UINT16_MAX,
+                "MaxIrqs must be in [1, UINT16_MAX]");
+  static_assert(MaxSources >= 1 && MaxSources < UINT16_MAX,
+                "MaxSources must be in [1, UINT16_MAX)");
+
+  /**
+   * @brief 根据设备类型生成中断源
+   *
+   * handle 调用 device.HandleInterrupt()；pending / acknowledge 依次在
+   * 设备和 device.GetDriver() 上查找 IsInterruptPending() /
+   * AcknowledgeInterrupt()，均未提供时留空。
+   *
+   * @tparam Device 设备或驱动类型
+   * @param device 设备对象（须比路由表项存活更久）
+   */
+  template <typename Device>
+  [[nodiscard]] static auto MakeSource(Device& device) -> InterruptSource {
+    InterruptSource source{};
+    source.context = &device;
+    source.handle = [](void* context) {
+      static_cast<Device*>(context)->HandleInterrupt();
+    };
+    if constexpr (InterruptPendingQuery<Device>) {
+      source.pending = [](void* context) {
+        return static_cast<Device*>(context)->IsInterruptPending();
+      };
+    } else if constexpr (InterruptPendingQuery<DriverOf<Device>>) {
+      source.pending = [](void* context) {
+        return static_cast<Device*>(context)->GetDriver().IsInterruptPending();
+      };
+    }
+    if constexpr (InterruptAcknowledge<Device>) {
+      source.acknowledge = [](void* context) {
+        static_cast<Device*>(context)->AcknowledgeInterrupt();
+      };
+    } else if constexpr (InterruptAcknowledge<DriverOf<Device>>) {
+      source.acknowledge = [](void* context) {
+        static_cast<Device*>(context)->GetDriver().AcknowledgeInterrupt();
+      };
+    }
+    return source;
+  }
+
+  /**
+   * @brief 将中断源挂到 IRQ 上
+   *
+   * @param irq IRQ 号
+   * @param source 中断源（handle 必须非空）
+   * @param coalesce 合并阈值，1 表示每次中断都完整处理
+   * @return 表项句柄（用于 Detach/Flush）；参数非法返回 kInvalidArgument，
+   *         要求合并但中断源不支持 acknowledge 返回 kNotSupported，
+   *         表已满返回 kOutOfMemory
+   */
+  auto Attach(uint32_t irq, const InterruptSource& source,
+              uint32_t coalesce = 1) -> Expected<size_t> {
+    if (irq >= MaxIrqs || source.handle == nullptr || coalesce == 0) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    if (coalesce > 1 && source.acknowledge == nullptr) {
+      return std::unexpected(Error{ErrorCode::kNotSupported});
+    }
+    for (size_t i = 0; i < MaxSources; ++i) {
+      auto& entry = entries_[i];
+      if (entry.in_use) {
+        continue;
+      }
+      entry = {source, coalesce, 0, kNone, static_cast<uint16_t>(irq), true};
+      // 追加到链尾，保持挂接顺序即分发顺序
+      uint16_t* link = &heads_[irq];
+      while (*link != kNone) {
+        link = &entries_[*link].next;
+      }
+      *link = static_cast<uint16_t>(i);
+      return i;
+    }
+    return std::unexpected(Error{ErrorCode::kOutOfMemory});
+  }
+
+  /**
+   * @brief 将设备挂到 IRQ 上（见 MakeSource()）
+   */
+  template <typename Device>
+    requires(!std::same_as<std::remove_cv_t<Device>, InterruptSource>)
+  auto Attach(uint32_t irq, Device& device, uint32_t coalesce = 1)
+      -> Expected<size_t> {
+    return Attach(irq, MakeSource(device), coalesce);
+  }
+
+  /**
+   * @brief 摘除中断源（被推迟的工作不再处理）
+   *
+   * @param handle Attach() 返回的句柄
+   * @return 句柄无效返回 kInvalidArgument
+   */
+  auto Detach(size_t handle) -> Expected<void> {
+    if (handle >= MaxSources || !entries_[handle].in_use) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    uint16_t* link = &heads_[entries_[handle].irq];
+    while (*link != handle) {
+      link = &entries_[*link].next;
+    }
+    *link = entries_[handle].next;
+    entries_[handle].in_use = false;
+    return {};
+  }
+
+  /**
+   * @brief 分发一次 IRQ
+   *
+   * 在中断控制器 claim 之后、complete 之前调用。
+   *
+   * @param irq IRQ 号
+   * @return 调用完整处理的中断源数；为 0 且链非空通常意味着伪中断
+   * @note 可在中断上下文中安全调用
+   */
+  auto Dispatch(uint32_t irq) -> size_t {
+    if (irq >= MaxIrqs) {
+      return 0;
+    }
+    size_t handled = 0;
+    for (uint16_t i = heads_[irq]; i != kNone; i = entries_[i].next) {
+      auto& entry = entries_[i];
+      const auto& source = entry.source;
+      if (source.pending != nullptr && !source.pending(source.context)) {
+        continue;
+      }
+      if (entry.coalesce > 1 && ++entry.deferred < entry.coalesce) {
+        source.acknowledge(source.context);
+        continue;
+      }
+      entry.deferred = 0;
+      source.handle(source.context);
+      ++handled;
+    }
+    return handled;
+  }
+
+  /**
+   * @brief 处理所有被合并推迟的中断
+   *
+   * @return 调用完整处理的中断源数
+   */
+  auto Flush() -> size_t {
+    size_t handled = 0;
+    for (size_t i = 0; i < MaxSources; ++i) {
+      handled += Flush(i) ? 1 : 0;
+    }
+    return handled;
+  }
+
+  /**
+   * @brief 处理单个中断源被合并推迟的中断
+   *
+   * @param handle Attach() 返回的句柄
+   * @return 有被推迟的中断并已处理返回 true
+   */
+  auto Flush(size_t handle) -> bool {
+    if (handle >= MaxSources) {
+      return false;
+    }
+    auto& entry = entries_[handle];
+    if (!entry.in_use || entry.deferred == 0) {
+      return false;
+    }
+    entry.deferred = 0;
+    entry.source.handle(entry.source.context);
+    return true;
+  }
+
+  /**
+   * @brief 中断源当前被推迟的中断数
+   *
+   * @param handle Attach() 返回的句柄
+   */
+  [[nodiscard]] auto GetDeferred(size_t handle) const -> uint32_t {
+    return handle < MaxSources && entries_[handle].in_use
+               ? entries_[handle].deferred
+               : 0;
+  }
+
+  /// @name 构造/析构函数
+  /// @{
+  InterruptRouter() {
+    for (auto& head : heads_) {
+      head = kNone;
+    }
+  }
+  ~InterruptRouter() = default;
+  /// 中断源以表项下标链接，表内不含自引用指针，可安全移动/拷贝
+  InterruptRouter(const InterruptRouter&) = default;
+  auto operator=(const InterruptRouter&) -> InterruptRouter& = default;
+  InterruptRouter(InterruptRouter&&) noexcept = default;
+  auto operator=(InterruptRouter&&) noexcept -> InterruptRouter& = default;
+  /// @}
+
+ private:
+  /// 链表结束标记
+  static constexpr uint16_t kNone = UINT16_MAX;
+
+  /// 设备的底层驱动类型（无 GetDriver() 时为 void）
+  template <typename Device>
+  struct DriverOfImpl {
+    using type = void;
+  };
+  template <typename Device>
+    requires requires(Device& device) { device.GetDriver(); }
+  struct DriverOfImpl<Device> {
+    using type = std::remove_reference_t<
+        decltype(std::declval<Device&>().GetDriver())>;
+  };
+  template <typename Device>
+  using DriverOf = typename DriverOfImpl<Device>::type;
+
+  struct Entry {
+    InterruptSource source;
+    /// 合并阈值
+    uint32_t coalesce;
+    /// 已确认但尚未完整处理的中断数
+    uint32_t deferred;
+    /// 同一 IRQ 链上的下一个表项
+    uint16_t next;
+    /// 所属 IRQ 号
+    uint16_t irq;
+    bool in_use;
+  };
+
+  /// 每个 IRQ 的链首表项
+  uint16_t heads_[MaxIrqs];
+  /// 中断源表项
+  Entry entries_[MaxSources]{};
+};
+
+}  // namespace device_framework
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_INTERRUPT_ROUTER_HPP_ */
@@ -6,10 +6,42 @@
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_OPS_BLOCK_DEVICE_HPP_
 
 #include "device_framework/defs.h"
+#include "device_framework/dma_buffer_pool.hpp"
 #include "device_framework/ops/device_ops_base.hpp"
 
 namespace device_framework {
 
+/**
+ * @brief 异步块请求的完成记录
+ *
+ * 由 BlockDevice::Reap() 按完成顺序返回给调用者。
+ */
+struct BlockCompletion {
+  /// 提交请求时传入的用户 token
+  void* token;
+  /// 完成状态（kSuccess 表示成功）
+  ErrorCode status;
+  /// 实际完成的块数（失败时为 0，Flush 恒为 0）
+  size_t block_count;
+};
+
+/**
+ * @brief 块设备 I/O 提示（拓扑信息）
+ *
+ * 各字段以逻辑块（GetBlockSize() 字节）为单位。上层（请求合并、块缓存、
+ * 文件系统）据此对齐和调整请求大小，避免设备侧的读-改-写。
+ */
+struct BlockIoHints {
+  /// 每个物理块包含的逻辑块数的 log2（0 表示物理块与逻辑块一样大）
+  uint8_t physical_block_exp{0};
+  /// 首个按物理块对齐的逻辑块号
+  uint8_t alignment_offset{0};
+  /// 建议的最小 I/O 大小（逻辑块数，0 表示未报告）
+  uint32_t min_io_size{0};
+  /// 最优 I/O 大小（逻辑块数，0 表示未报告）
+  uint32_t opt_io_size{0};
+};
+
 /**
  * @brief 块设备抽象接口
  *
@@ -17,14 +49,30 @@ namespace device_framework {
  * 新增 ReadBlocks/WriteBlocks、Flush 和容量查询接口。
  * 基类的字节级 Read/Write 会自动桥接为块操作（要求对齐）。
  *
+ * 异步接口 SubmitReadBlocks/SubmitWriteBlocks/SubmitFlush 只负责提交，
+ * 完成结果通过 Poll()/Reap() 取回。派生类未覆写 DoSubmit* 时，
+ * 默认实现同步执行对应的 Do* 操作并立即记录完成结果。有待取走的完成
+ * 记录时报告 PollEvents::kIn，可用 RegisterPollWaiter() 等待完成。
+ *
+ * 读写接口均提供 DmaBuffer 重载（零拷贝）：DMA 驱动可覆写 Do*Dma
+ * 直接使用句柄中缓存的物理地址；未覆写时按普通缓冲区处理。
+ *
+ * 基类的 Readv/Writev 桥接为 DoReadBlocksv/DoWriteBlocksv（要求偏移与
+ * 每个缓冲区都按块对齐）：支持分散/聚集的驱动可覆写它们，把多个缓冲区
+ * 合并到同一个请求；未覆写时逐个缓冲区执行 DoReadBlocks/DoWriteBlocks。
+ *
  * @tparam Derived 具体块设备类型
  *
  * @pre  派生类必须实现 DoGetBlockSize 和 DoGetBlockCount
  * @pre  派生类至少实现 DoReadBlocks 或 DoWriteBlocks 之一
+ * @note 异步接口非线程安全，多个上下文并发使用时需由调用者同步
  */
 template <class Derived>
 class BlockDevice : public DeviceOperationsBase<Derived> {
  public:
+  /// 尚未取走的完成记录上限（即同时在途的异步请求上限）
+  static constexpr size_t kMaxCompletions = 16;
+
   /**
    * @brief 获取设备类型
    * @return DeviceType::kBlock
@@ -75,6 +123,50 @@ class BlockDevice : public DeviceOperationsBase<Derived> {
     return self.DoWriteBlocks(block_no, data, block_count);
   }
 
+  /**
+   * @brief 从设备读取指定数量的块到 DMA 缓冲区（零拷贝）
+   *
+   * @param  block_no     起始块号（0-based）
+   * @param  buffer       目标 DMA 缓冲区，size 必须 >= block_count *
+   *                      GetBlockSize()
+   * @param  block_count  要读取的块数
+   * @return Expected<size_t> 实际读取的块数
+   */
+  auto ReadBlocks(this Derived& self, uint64_t block_no,
+                  const DmaBuffer& buffer, size_t block_count)
+      -> Expected<size_t> {
+    if (!self.IsOpened()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotOpen});
+    }
+    auto check = self.ValidateBlockAccess(block_no, buffer.size, block_count);
+    if (!check) {
+      return std::unexpected(check.error());
+    }
+    return self.DoReadBlocksDma(block_no, buffer, block_count);
+  }
+
+  /**
+   * @brief 将 DMA 缓冲区中的数据写入设备（零拷贝）
+   *
+   * @param  block_no     起始块号（0-based）
+   * @param  data         待写入 DMA 缓冲区，size 必须 >= block_count *
+   *                      GetBlockSize()
+   * @param  block_count  要写入的块数
+   * @return Expected<size_t> 实际写入的块数
+   */
+  auto WriteBlocks(this Derived& self, uint64_t block_no,
+                   const DmaBuffer& data, size_t block_count)
+      -> Expected<size_t> {
+    if (!self.IsOpened()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotOpen});
+    }
+    auto check = self.ValidateBlockAccess(block_no, data.size, block_count);
+    if (!check) {
+      return std::unexpected(check.error());
+    }
+    return self.DoWriteBlocksDma(block_no, data, block_count);
+  }
+
   /**
    * @brief 读取单个块
    */
@@ -104,6 +196,148 @@ class BlockDevice : public DeviceOperationsBase<Derived> {
    */
   auto Flush(this Derived& self) -> Expected<void> { return self.DoFlush(); }
 
+  /// @name 异步接口
+  /// @{
+
+  /**
+   * @brief 异步提交块读取请求
+   *
+   * 请求完成前 buffer 必须保持有效。
+   *
+   * @param  block_no     起始块号（0-based）
+   * @param  buffer       目标缓冲区，大小必须 >= block_count * GetBlockSize()
+   * @param  block_count  要读取的块数
+   * @param  token        用户 token，原样出现在对应的 BlockCompletion 中
+   * @return Expected<void> 提交成功返回 void；完成记录已满时返回
+   *         kDeviceBusy，需先调用 Reap() 取走完成结果
+   */
+  auto SubmitReadBlocks(this Derived& self, uint64_t block_no,
+                        std::span<uint8_t> buffer, size_t block_count,
+                        void* token) -> Expected<void> {
+    if (!self.IsOpened()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotOpen});
+    }
+    auto check = self.ValidateBlockAccess(block_no, buffer.size(), block_count);
+    if (!check) {
+      return std::unexpected(check.error());
+    }
+    return self.DoSubmitReadBlocks(block_no, buffer, block_count, token);
+  }
+
+  /**
+   * @brief 异步提交块写入请求
+   *
+   * 请求完成前 data 必须保持有效。
+   *
+   * @param  block_no     起始块号（0-based）
+   * @param  data         待写入数据，大小必须 >= block_count * GetBlockSize()
+   * @param  block_count  要写入的块数
+   * @param  token        用户 token，原样出现在对应的 BlockCompletion 中
+   * @return Expected<void> 提交成功返回 void；完成记录已满时返回 kDeviceBusy
+   */
+  auto SubmitWriteBlocks(this Derived& self, uint64_t block_no,
+                         std::span<const uint8_t> data, size_t block_count,
+                         void* token) -> Expected<void> {
+    if (!self.IsOpened()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotOpen});
+    }
+    auto check = self.ValidateBlockAccess(block_no, data.size(), block_count);
+    if (!check) {
+      return std::unexpected(check.error());
+    }
+    return self.DoSubmitWriteBlocks(block_no, data, block_count, token);
+  }
+
+  /**
+   * @brief 异步提交读取到 DMA 缓冲区的请求（零拷贝）
+   *
+   * 请求完成前 buffer 必须保持有效。
+   *
+   * @return Expected<void> 同 SubmitReadBlocks(std::span) 版本
+   */
+  auto SubmitReadBlocks(this Derived& self, uint64_t block_no,
+                        const DmaBuffer& buffer, size_t block_count,
+                        void* token) -> Expected<void> {
+    if (!self.IsOpened()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotOpen});
+    }
+    auto check = self.ValidateBlockAccess(block_no, buffer.size, block_count);
+    if (!check) {
+      return std::unexpected(check.error());
+    }
+    return self.DoSubmitReadBlocksDma(block_no, buffer, block_count, token);
+  }
+
+  /**
+   * @brief 异步提交 DMA 缓冲区写入请求（零拷贝）
+   *
+   * 请求完成前 data 必须保持有效。
+   *
+   * @return Expected<void> 同 SubmitWriteBlocks(std::span) 版本
+   */
+  auto SubmitWriteBlocks(this Derived& self, uint64_t block_no,
+                         const DmaBuffer& data, size_t block_count,
+                         void* token) -> Expected<void> {
+    if (!self.IsOpened()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotOpen});
+    }
+    auto check = self.ValidateBlockAccess(block_no, data.size, block_count);
+    if (!check) {
+      return std::unexpected(check.error());
+    }
+    return self.DoSubmitWriteBlocksDma(block_no, data, block_count, token);
+  }
+
+  /**
+   * @brief 异步提交 Flush 请求
+   *
+   * @param  token 用户 token，原样出现在对应的 BlockCompletion 中
+   * @return Expected<void> 提交成功返回 void；完成记录已满时返回 kDeviceBusy
+   */
+  auto SubmitFlush(this Derived& self, void* token) -> Expected<void> {
+    if (!self.IsOpened()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotOpen});
+    }
+    return self.DoSubmitFlush(token);
+  }
+
+  /**
+   * @brief 推进设备完成处理，返回待取走的完成记录数
+   *
+   * 可在轮询循环或中断处理中调用，不会取走完成记录。
+   *
+   * @return 当前可通过 Reap() 取走的完成记录数
+   */
+  auto Poll(this Derived& self) -> size_t {
+    self.DoPollCompletions();
+    return self.completion_count_;
+  }
+
+  /**
+   * @brief 取走已完成请求的记录
+   *
+   * 先调用 Poll() 推进完成处理，再按完成顺序填充 completions。
+   *
+   * @param  completions 输出缓冲区
+   * @return 实际写入 completions 的记录数
+   */
+  auto Reap(this Derived& self, std::span<BlockCompletion> completions)
+      -> size_t {
+    self.Poll();
+    size_t reaped = 0;
+    while (reaped < completions.size() && self.completion_count_ > 0) {
+      completions[reaped++] = self.completions_[self.completion_head_];
+      self.completion_head_ = (self.completion_head_ + 1) % kMaxCompletions;
+      --self.completion_count_;
+    }
+    if (self.completion_count_ == 0) {
+      self.UpdatePollReady(PollEvents{});
+    }
+    return reaped;
+  }
+
+  /// @}
+
   /**
    * @brief 获取块大小（字节数）
    */
@@ -125,6 +359,13 @@ class BlockDevice : public DeviceOperationsBase<Derived> {
     return self.GetBlockSize() * self.GetBlockCount();
   }
 
+  /**
+   * @brief 获取 I/O 提示（物理块大小、最小/最优 I/O 大小）
+   */
+  auto GetIoHints(this const Derived& self) -> BlockIoHints {
+    return self.DoGetIoHints();
+  }
+
  protected:
   /**
    * @brief 块读取实现（派生类覆写）
@@ -144,6 +385,96 @@ class BlockDevice : public DeviceOperationsBase<Derived> {
     return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
   }
 
+  /**
+   * @brief DMA 缓冲区块读取实现（DMA 驱动可覆写）
+   * @note  默认按普通缓冲区执行 DoReadBlocks
+   */
+  auto DoReadBlocksDma(this Derived& self, uint64_t block_no,
+                       const DmaBuffer& buffer, size_t block_count)
+      -> Expected<size_t> {
+    return self.DoReadBlocks(block_no, buffer.Data(), block_count);
+  }
+
+  /**
+   * @brief DMA 缓冲区块写入实现（DMA 驱动可覆写）
+   * @note  默认按普通缓冲区执行 DoWriteBlocks
+   */
+  auto DoWriteBlocksDma(this Derived& self, uint64_t block_no,
+                        const DmaBuffer& data, size_t block_count)
+      -> Expected<size_t> {
+    return self.DoWriteBlocks(
+        block_no, std::span<const uint8_t>(data.virt, data.size), block_count);
+  }
+
+  /**
+   * @brief 分散读取实现（支持分散/聚集的驱动可覆写）
+   *
+   * @param  block_no     起始块号
+   * @param  buffers      按块对齐的目标缓冲区列表，总计 block_count 块
+   * @param  block_count  总块数
+   * @return Expected<size_t> 从起点开始连续读取的块数
+   * @note   默认逐个缓冲区执行 DoReadBlocks
+   */
+  auto DoReadBlocksv(this Derived& self, uint64_t block_no,
+                     std::span<const std::span<uint8_t>> buffers,
+                     [[maybe_unused]] size_t block_count) -> Expected<size_t> {
+    size_t block_size = self.DoGetBlockSize();
+    size_t done = 0;
+    for (auto buffer : buffers) {
+      size_t count = buffer.size() / block_size;
+      if (count == 0) {
+        continue;
+      }
+      auto result = self.DoReadBlocks(block_no + done, buffer, count);
+      if (!result) {
+        if (done == 0) {
+          return std::unexpected(result.error());
+        }
+        break;
+      }
+      done += *result;
+      if (*result < count) {
+        break;
+      }
+    }
+    return done;
+  }
+
+  /**
+   * @brief 聚集写入实现（支持分散/聚集的驱动可覆写）
+   *
+   * @param  block_no     起始块号
+   * @param  data         按块对齐的数据缓冲区列表，总计 block_count 块
+   * @param  block_count  总块数
+   * @return Expected<size_t> 从起点开始连续写入的块数
+   * @note   默认逐个缓冲区执行 DoWriteBlocks
+   */
+  auto DoWriteBlocksv(this Derived& self, uint64_t block_no,
+                      std::span<const std::span<const uint8_t>> data,
+                      [[maybe_unused]] size_t block_count)
+      -> Expected<size_t> {
+    size_t block_size = self.DoGetBlockSize();
+    size_t done = 0;
+    for (auto buffer : data) {
+      size_t count = buffer.size() / block_size;
+      if (count == 0) {
+        continue;
+      }
+      auto result = self.DoWriteBlocks(block_no + done, buffer, count);
+      if (!result) {
+        if (done == 0) {
+          return std::unexpected(result.error());
+        }
+        break;
+      }
+      done += *result;
+      if (*result < count) {
+        break;
+      }
+    }
+    return done;
+  }
+
   /**
    * @brief Flush 实现（派生类覆写）
    */
@@ -151,6 +482,111 @@ class BlockDevice : public DeviceOperationsBase<Derived> {
     return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
   }
 
+  /**
+   * @brief 异步块读取实现（派生类可覆写）
+   * @note  默认同步执行 DoReadBlocks，并立即记录完成结果
+   */
+  auto DoSubmitReadBlocks(this Derived& self, uint64_t block_no,
+                          std::span<uint8_t> buffer, size_t block_count,
+                          void* token) -> Expected<void> {
+    if (self.completion_count_ >= kMaxCompletions) {
+      return std::unexpected(Error{ErrorCode::kDeviceBusy});
+    }
+    auto result = self.DoReadBlocks(block_no, buffer, block_count);
+    auto status = result ? ErrorCode::kSuccess : result.error().code;
+    self.PostCompletion(token, status, result ? *result : 0);
+    return {};
+  }
+
+  /**
+   * @brief 异步块写入实现（派生类可覆写）
+   * @note  默认同步执行 DoWriteBlocks，并立即记录完成结果
+   */
+  auto DoSubmitWriteBlocks(this Derived& self, uint64_t block_no,
+                           std::span<const uint8_t> data, size_t block_count,
+                           void* token) -> Expected<void> {
+    if (self.completion_count_ >= kMaxCompletions) {
+      return std::unexpected(Error{ErrorCode::kDeviceBusy});
+    }
+    auto result = self.DoWriteBlocks(block_no, data, block_count);
+    auto status = result ? ErrorCode::kSuccess : result.error().code;
+    self.PostCompletion(token, status, result ? *result : 0);
+    return {};
+  }
+
+  /**
+   * @brief 异步 DMA 缓冲区块读取实现（DMA 驱动可覆写）
+   * @note  默认按普通缓冲区执行 DoSubmitReadBlocks
+   */
+  auto DoSubmitReadBlocksDma(this Derived& self, uint64_t block_no,
+                             const DmaBuffer& buffer, size_t block_count,
+                             void* token) -> Expected<void> {
+    return self.DoSubmitReadBlocks(block_no, buffer.Data(), block_count,
+                                   token);
+  }
+
+  /**
+   * @brief 异步 DMA 缓冲区块写入实现（DMA 驱动可覆写）
+   * @note  默认按普通缓冲区执行 DoSubmitWriteBlocks
+   */
+  auto DoSubmitWriteBlocksDma(this Derived& self, uint64_t block_no,
+                              const DmaBuffer& data, size_t block_count,
+                              void* token) -> Expected<void> {
+    return self.DoSubmitWriteBlocks(
+        block_no, std::span<const uint8_t>(data.virt, data.size), block_count,
+        token);
+  }
+
+  /**
+   * @brief 异步 Flush 实现（派生类可覆写）
+   * @note  默认同步执行 DoFlush，并立即记录完成结果
+   */
+  auto DoSubmitFlush(this Derived& self, void* token) -> Expected<void> {
+    if (self.completion_count_ >= kMaxCompletions) {
+      return std::unexpected(Error{ErrorCode::kDeviceBusy});
+    }
+    auto result = self.DoFlush();
+    auto status = result ? ErrorCode::kSuccess : result.error().code;
+    self.PostCompletion(token, status, 0);
+    return {};
+  }
+
+  /**
+   * @brief 完成处理推进实现（派生类可覆写）
+   * @note  默认无操作（同步回退路径在提交时已记录完成结果）
+   */
+  auto DoPollCompletions() -> void {}
+
+  /**
+   * @brief 记录一个已完成的异步请求（供派生类的完成处理调用）
+   *
+   * 完成记录由空变为非空时以 PollEvents::kIn 通知就绪等待者。
+   *
+   * @param  token        请求的用户 token
+   * @param  status       完成状态
+   * @param  block_count  实际完成的块数
+   * @return 记录已满返回 false（完成结果被丢弃）
+   * @pre    派生类应保证在途请求数 + PendingCompletions() <= kMaxCompletions
+   */
+  auto PostCompletion(void* token, ErrorCode status, size_t block_count)
+      -> bool {
+    if (completion_count_ >= kMaxCompletions) {
+      return false;
+    }
+    completions_[(completion_head_ + completion_count_) % kMaxCompletions] = {
+        token, status, block_count};
+    ++completion_count_;
+    this->UpdatePollReady(PollEvents{PollEvents::kIn});
+    return true;
+  }
+
+  /**
+   * @brief 获取尚未取走的完成记录数
+   */
+  [[nodiscard]] auto PendingCompletions() const -> size_t {
+    return completion_count_;
+  }
+
   /**
    * @brief 获取块大小实现（派生类必须覆写）
    * @note  默认返回 512（最常见的扇区大小）
@@ -163,6 +599,12 @@ class BlockDevice : public DeviceOperationsBase<Derived> {
    */
   auto DoGetBlockCount() const -> uint64_t { return 0; }
 
+  /**
+   * @brief 获取 I/O 提示实现（派生类可覆写）
+   * @note  默认不报告任何拓扑信息
+   */
+  auto DoGetIoHints() const -> BlockIoHints { return {}; }
+
   /**
    * @brief 字节级读取 → 块读取的桥接（要求对齐）
    */
@@ -205,7 +647,75 @@ class BlockDevice : public DeviceOperationsBase<Derived> {
     return *result * block_size;
   }
 
+  /**
+   * @brief 字节级分散读取 → 块分散读取的桥接（要求对齐）
+   */
+  auto DoReadv(this Derived& self, std::span<const std::span<uint8_t>> buffers,
+               size_t offset) -> Expected<size_t> {
+    auto blocks = self.ValidateVectorAccess(buffers, offset);
+    if (!blocks) {
+      return std::unexpected(blocks.error());
+    }
+    size_t block_size = self.DoGetBlockSize();
+    auto result = self.DoReadBlocksv(offset / block_size, buffers, *blocks);
+    if (!result) {
+      return std::unexpected(result.error());
+    }
+    return *result * block_size;
+  }
+
+  /**
+   * @brief 字节级聚集写入 → 块聚集写入的桥接（要求对齐）
+   */
+  auto DoWritev(this Derived& self,
+                std::span<const std::span<const uint8_t>> data, size_t offset)
+      -> Expected<size_t> {
+    auto blocks = self.ValidateVectorAccess(data, offset);
+    if (!blocks) {
+      return std::unexpected(blocks.error());
+    }
+    size_t block_size = self.DoGetBlockSize();
+    auto result = self.DoWriteBlocksv(offset / block_size, data, *blocks);
+    if (!result) {
+      return std::unexpected(result.error());
+    }
+    return *result * block_size;
+  }
+
  private:
+  /**
+   * @brief 校验分散/聚集访问：偏移与每个缓冲区均按块对齐且不越界
+   * @param  buffers  缓冲区列表
+   * @param  offset   设备内的起始偏移量（字节）
+   * @return Expected<size_t> 缓冲区覆盖的总块数
+   */
+  template <typename Buffer>
+  auto ValidateVectorAccess(this const Derived& self,
+                            std::span<const Buffer> buffers, size_t offset)
+      -> Expected<size_t> {
+    size_t block_size = self.GetBlockSize();
+    if (block_size == 0) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+    }
+    if (offset % block_size != 0) {
+      return std::unexpected(Error{ErrorCode::kDeviceBlockUnaligned});
+    }
+    size_t total = 0;
+    for (auto buffer : buffers) {
+      if (buffer.size() % block_size != 0) {
+        return std::unexpected(Error{ErrorCode::kDeviceBlockUnaligned});
+      }
+      total += buffer.size();
+    }
+    size_t block_count = total / block_size;
+    auto check =
+        self.ValidateBlockAccess(offset / block_size, total, block_count);
+    if (!check) {
+      return std::unexpected(check.error());
+    }
+    return block_count;
+  }
+
   /**
    * @brief 校验块访问参数的合法性
    * @param  block_no     起始块号
@@ -229,6 +739,13 @@ class BlockDevice : public DeviceOperationsBase<Derived> {
     }
     return {};
   }
+
+  /// 完成记录环形缓冲区
+  BlockCompletion completions_[kMaxCompletions]{};
+  /// 最早一条未取走记录的下标
+  size_t completion_head_ = 0;
+  /// 未取走的记录数
+  size_t completion_count_ = 0;
 };
 
 }  // namespace device_framework
@@ -10,46 +10,6 @@
 
 namespace device_framework {
 
-/**
- * @brief Poll 事件标志位
- */
-struct PollEvents {
-  /// 有数据可读
-  static constexpr uint32_t kIn = 1U << 0;
-  /// 可以写入（不会阻塞）
-  static constexpr uint32_t kOut = 1U << 1;
-  /// 发生错误
-  static constexpr uint32_t kErr = 1U << 2;
-  /// 挂起（对端关闭）
-  static constexpr uint32_t kHup = 1U << 3;
-
-  [[nodiscard]] constexpr auto HasIn() const -> bool {
-    return (value & kIn) != 0;
-  }
-
-  [[nodiscard]] constexpr auto HasOut() const -> bool {
-    return (value & kOut) != 0;
-  }
-
-  [[nodiscard]] constexpr auto HasErr() const -> bool {
-    return (value & kErr) != 0;
-  }
-
-  constexpr auto operator|(PollEvents other) const -> PollEvents {
-    return PollEvents{value | other.value};
-  }
-
-  constexpr auto operator&(PollEvents other) const -> PollEvents {
-    return PollEvents{value & other.value};
-  }
-
-  constexpr explicit operator bool() const { return value != 0; }
-
-  constexpr explicit PollEvents(uint32_t v = 0) : value(v) {}
-
-  uint32_t value;
-};
-
 /**
  * @brief 字符设备抽象接口
  *
@@ -74,6 +34,9 @@ class CharDevice : public DeviceOperationsBase<Derived> {
   /**
    * @brief 查询设备就绪状态（非阻塞）
    *
+   * 需要睡眠等待时改用 RegisterPollWaiter()：驱动在中断处理中报告就绪
+   * 状态变化，无需反复调用本函数。
+   *
    * @param  requested  感兴趣的事件集合
    * @return Expected<PollEvents> 当前就绪的事件集合
    */
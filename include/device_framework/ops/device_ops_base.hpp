@@ -10,8 +10,10 @@
 #include <cstdint>
 #include <expected>
 #include <span>
+#include <utility>
 
 #include "device_framework/expected.hpp"
+#include "device_framework/ops/poll_notifier.hpp"
 
 namespace device_framework {
 
@@ -45,6 +47,9 @@ struct OpenFlags {
   [[nodiscard]] constexpr auto CanWrite() const -> bool {
     return (value & kWrite) != 0;
   }
+  [[nodiscard]] constexpr auto IsNonBlock() const -> bool {
+    return (value & kNonBlock) != 0;
+  }
 };
 
 /**
@@ -166,6 +171,41 @@ class DeviceOperationsBase {
     return self.DoWrite(data, offset);
   }
 
+  /**
+   * @brief 从设备读取数据到多个缓冲区（分散读）
+   *
+   * 按顺序依次填满 buffers 中的每个缓冲区，相当于对连续的偏移多次调用
+   * Read()，但只做一次打开状态检查；驱动可覆写 DoReadv 合并为单个请求。
+   *
+   * @param  buffers  目标缓冲区列表
+   * @param  offset   设备内的起始偏移量（字节）
+   * @return Expected<size_t> 实际读取的总字节数；某个缓冲区未被填满时
+   *         停止，此前已有数据时返回部分计数而非错误
+   */
+  auto Readv(this Derived& self, std::span<const std::span<uint8_t>> buffers,
+             size_t offset = 0) -> Expected<size_t> {
+    if (!self.opened_.load()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotOpen});
+    }
+    return self.DoReadv(buffers, offset);
+  }
+
+  /**
+   * @brief 将多个缓冲区的数据写入设备（聚集写）
+   *
+   * @param  data    待写入的缓冲区列表
+   * @param  offset  设备内的起始偏移量（字节）
+   * @return Expected<size_t> 实际写入的总字节数，部分写入语义同 Readv()
+   */
+  auto Writev(this Derived& self,
+              std::span<const std::span<const uint8_t>> data,
+              size_t offset = 0) -> Expected<size_t> {
+    if (!self.opened_.load()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotOpen});
+    }
+    return self.DoWritev(data, offset);
+  }
+
   /**
    * @brief 将设备内存映射到进程地址空间
    *
@@ -264,10 +304,67 @@ class DeviceOperationsBase {
     return self.Open(OpenFlags{OpenFlags::kReadWrite});
   }
 
+  /**
+   * @brief 注册就绪通知回调
+   *
+   * 设备就绪事件（由驱动在中断处理中报告）新出现且与 mask 相交时调用
+   * callback，调用者可据此睡眠等待而无需轮询。不要求设备已打开。
+   *
+   * @param  mask      感兴趣的事件集合
+   * @param  callback  就绪通知回调（可能在中断上下文中调用）
+   * @param  context   原样传给回调的上下文
+   * @return Expected<size_t> 等待者句柄，见 PollNotifier::Register()
+   * @note   未报告就绪状态的驱动不会触发回调
+   */
+  auto RegisterPollWaiter(PollEvents mask, PollCallback callback,
+                          void* context) -> Expected<size_t> {
+    return poll_notifier_.Register(mask, callback, context);
+  }
+
+  /**
+   * @brief 注销就绪通知回调
+   * @param  handle  RegisterPollWaiter() 返回的句柄
+   */
+  auto UnregisterPollWaiter(size_t handle) -> Expected<void> {
+    return poll_notifier_.Unregister(handle);
+  }
+
+  /// @brief 驱动最近一次报告的就绪事件（不访问设备寄存器）
+  [[nodiscard]] auto GetPollReady() const -> PollEvents {
+    return poll_notifier_.Cached();
+  }
+
  protected:
   /// @brief 查询设备是否已打开
   [[nodiscard]] auto IsOpened() const -> bool { return opened_.load(); }
 
+  /**
+   * @brief 报告设备当前的就绪事件（供派生类的中断处理与读写路径调用）
+   *
+   * 更新 GetPollReady() 的缓存，并通知新就绪事件的等待者。
+   *
+   * @param  ready  设备当前的就绪事件
+   */
+  auto UpdatePollReady(PollEvents ready) -> void {
+    poll_notifier_.Update(ready);
+  }
+
+  /**
+   * @brief 采样并报告设备当前的就绪事件
+   *
+   * 就绪状态由设备状态（如环形缓冲区）推导、且读写路径与中断处理都会
+   * 报告时使用：采样后缓存若已被另一方更新则重新采样，避免以过期状态
+   * 覆盖（丢失唤醒）。
+   *
+   * @tparam Sample 签名：PollEvents()
+   * @param  sample  由设备状态得到当前就绪事件（可能被调用多次）
+   * @return 最终报告的就绪事件
+   */
+  template <typename Sample>
+  auto RefreshPollReady(Sample&& sample) -> PollEvents {
+    return poll_notifier_.Refresh(static_cast<Sample&&>(sample));
+  }
+
   /// @brief 默认 Open 实现（返回 kDeviceNotSupported）
   auto DoOpen([[maybe_unused]] OpenFlags flags) -> Expected<void> {
     return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
@@ -296,6 +393,57 @@ class DeviceOperationsBase {
     return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
   }
 
+  /**
+   * @brief 默认 Readv 实现：逐个缓冲区调用 DoRead
+   */
+  auto DoReadv(this Derived& self, std::span<const std::span<uint8_t>> buffers,
+               size_t offset) -> Expected<size_t> {
+    size_t total = 0;
+    for (auto buffer : buffers) {
+      if (buffer.empty()) {
+        continue;
+      }
+      auto result = self.DoRead(buffer, offset + total);
+      if (!result) {
+        if (total == 0) {
+          return std::unexpected(result.error());
+        }
+        break;
+      }
+      total += *result;
+      if (*result < buffer.size()) {
+        break;
+      }
+    }
+    return total;
+  }
+
+  /**
+   * @brief 默认 Writev 实现：逐个缓冲区调用 DoWrite
+   */
+  auto DoWritev(this Derived& self,
+                std::span<const std::span<const uint8_t>> data, size_t offset)
+      -> Expected<size_t> {
+    size_t total = 0;
+    for (auto buffer : data) {
+      if (buffer.empty()) {
+        continue;
+      }
+      auto result = self.DoWrite(buffer, offset + total);
+      if (!result) {
+        if (total == 0) {
+          return std::unexpected(result.error());
+        }
+        break;
+      }
+      total += *result;
+      if (*result < buffer.size()) {
+        break;
+      }
+    }
+    return total;
+  }
+
   /**
    * @brief 默认 Mmap 实现
    */
@@ -336,7 +484,8 @@ class DeviceOperationsBase {
   DeviceOperationsBase(const DeviceOperationsBase&) = delete;
   auto operator=(const DeviceOperationsBase&) -> DeviceOperationsBase& = delete;
   DeviceOperationsBase(DeviceOperationsBase&& other) noexcept
-      : opened_(other.opened_.load()) {
+      : opened_(other.opened_.load()),
+        poll_notifier_(std::move(other.poll_notifier_)) {
     other.opened_.store(false);
   }
   auto operator=(DeviceOperationsBase&& other) noexcept
@@ -344,6 +493,7 @@ class DeviceOperationsBase {
     if (this != &other) {
       opened_.store(other.opened_.load());
       other.opened_.store(false);
+      poll_notifier_ = std::move(other.poll_notifier_);
     }
     return *this;
   }
@@ -352,6 +502,8 @@ class DeviceOperationsBase {
  private:
   /// @brief 设备打开状态（原子操作，支持多核并发）
   std::atomic<bool> opened_{false};
+  /// @brief 就绪状态缓存与等待者
+  PollNotifier poll_notifier_;
 };
 
 }  // namespace device_framework
@@ -0,0 +1,112 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_OPS_FRAMEBUFFER_DEVICE_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_OPS_FRAMEBUFFER_DEVICE_HPP_
+
+#include "device_framework/defs.h"
+#include "device_framework/ops/device_ops_base.hpp"
+
+namespace device_framework {
+
+/**
+ * @brief 帧缓冲设备抽象接口
+ *
+ * 像素数据位于设备的后备存储中，调用者通过 Mmap() 直接绘制，
+ * 或通过 Read/Write 按字节偏移访问。绘制后用 MarkDirty() 标记脏区域，
+ * 再调用 Present() 把累积的脏区域一次性提交到显示端；派生类可在
+ * Present() 之前合并相邻或重叠的脏区域。
+ *
+ * @tparam Derived 具体帧缓冲设备类型
+ *
+ * @pre  派生类必须实现 DoGetInfo、DoMarkDirty 和 DoPresent
+ */
+template <class Derived>
+class FramebufferDevice : public DeviceOperationsBase<Derived> {
+ public:
+  /**
+   * @brief 获取设备类型
+   * @return DeviceType::kFramebuffer
+   */
+  [[nodiscard]] static constexpr auto GetDeviceType() -> DeviceType {
+    return DeviceType::kFramebuffer;
+  }
+
+  /**
+   * @brief 获取帧缓冲布局
+   *
+   * @return Expected<FramebufferInfo> 宽高、行间距与像素格式信息
+   */
+  auto GetInfo(this Derived& self) -> Expected<FramebufferInfo> {
+    if (!self.IsOpened()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotOpen});
+    }
+    return self.DoGetInfo();
+  }
+
+  /**
+   * @brief 标记需要刷新到显示端的区域
+   *
+   * 超出帧缓冲的部分被裁剪，空区域被忽略。
+   *
+   * @param  rect  脏区域
+   * @return Expected<void> 成功或失败
+   */
+  auto MarkDirty(this Derived& self, const FramebufferRect& rect)
+      -> Expected<void> {
+    if (!self.IsOpened()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotOpen});
+    }
+    return self.DoMarkDirty(rect);
+  }
+
+  /**
+   * @brief 把已标记的脏区域提交到显示端
+   *
+   * @return Expected<void> 成功或失败（没有脏区域时直接成功）
+   */
+  auto Present(this Derived& self) -> Expected<void> {
+    if (!self.IsOpened()) {
+      return std::unexpected(Error{ErrorCode::kDeviceNotOpen});
+    }
+    return self.DoPresent();
+  }
+
+ protected:
+  /**
+   * @brief 获取帧缓冲布局（派生类覆写）
+   */
+  auto DoGetInfo() -> Expected<FramebufferInfo> {
+    return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+  }
+
+  /**
+   * @brief 标记脏区域（派生类覆写）
+   */
+  auto DoMarkDirty([[maybe_unused]] const FramebufferRect& rect)
+      -> Expected<void> {
+    return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+  }
+
+  /**
+   * @brief 提交脏区域（派生类覆写）
+   */
+  auto DoPresent() -> Expected<void> {
+    return std::unexpected(Error{ErrorCode::kDeviceNotSupported});
+  }
+
+  /// @name 构造/析构函数
+  /// @{
+  FramebufferDevice() = default;
+  ~FramebufferDevice() = default;
+  FramebufferDevice(const FramebufferDevice&) = delete;
+  auto operator=(const FramebufferDevice&) -> FramebufferDevice& = delete;
+  FramebufferDevice(FramebufferDevice&&) noexcept = default;
+  auto operator=(FramebufferDevice&&) noexcept -> FramebufferDevice& = default;
+  /// @}
+};
+
+}  // namespace device_framework
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_OPS_FRAMEBUFFER_DEVICE_HPP_ */
@@ -0,0 +1,266 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_OPS_POLL_NOTIFIER_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_OPS_POLL_NOTIFIER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "device_framework/expected.hpp"
+
+namespace device_framework {
+
+/**
+ * @brief Poll 事件标志位
+ */
+struct PollEvents {
+  /// 有数据可读
+  static constexpr uint32_t kIn = 1U << 0;
+  /// 可以写入（不会阻塞）
+  static constexpr uint32_t kOut = 1U << 1;
+  /// 发生错误
+  static constexpr uint32_t kErr = 1U << 2;
+  /// 挂起（对端关闭）
+  static constexpr uint32_t kHup = 1U << 3;
+
+  [[nodiscard]] constexpr auto HasIn() const -> bool {
+    return (value & kIn) != 0;
+  }
+
+  [[nodiscard]] constexpr auto HasOut() const -> bool {
+    return (value & kOut) != 0;
+  }
+
+  [[nodiscard]] constexpr auto HasErr() const -> bool {
+    return (value & kErr) != 0;
+  }
+
+  constexpr auto operator|(PollEvents other) const -> PollEvents {
+    return PollEvents{value | other.value};
+  }
+
+  constexpr auto operator&(PollEvents other) const -> PollEvents {
+    return PollEvents{value & other.value};
+  }
+
+  constexpr explicit operator bool() const { return value != 0; }
+
+  constexpr explicit PollEvents(uint32_t v = 0) : value(v) {}
+
+  uint32_t value;
+};
+
+/**
+ * @brief 就绪通知回调
+ *
+ * @param context 注册时传入的上下文
+ * @param ready   触发通知的就绪事件（已按注册掩码过滤）
+ * @note 可能在中断上下文中调用，应只做唤醒等轻量操作
+ */
+using PollCallback = void (*)(void* context, PollEvents ready);
+
+/**
+ * @brief 设备就绪状态缓存与等待者通知
+ *
+ * 驱动在中断处理（以及改变就绪状态的读写路径）中以 Update() 报告当前
+ * 就绪事件；缓存值由新变为就绪的事件（上升沿）触发掩码匹配的等待者
+ * 回调。上层多路复用器据此在多个设备上睡眠，只在真实事件发生时唤醒，
+ * 无需反复轮询状态寄存器。
+ *
+ * 等待者存放在固定槽位中，注册、注销与通知均不加锁：槽位状态以原子
+ * 操作转换，Update() 只读取已发布（kArmed）的槽位。
+ *
+ * 就绪状态由读写路径与中断处理分别采样时，应使用 Refresh()：采样与
+ * 发布之间缓存若被其他一方更新（缓存带序号，不受 ABA 影响），则重新
+ * 采样，过期的采样结果不会覆盖更新的状态。
+ *
+ * @warning Unregister() 返回时，另一个核上正在执行的 Update() 仍可能
+ *          调用一次旧回调；释放 context 前调用者须自行同步（如先屏蔽
+ *          设备中断）
+ */
+class PollNotifier {
+ public:
+  /// 最大等待者数
+  static constexpr size_t kMaxWaiters = 4;
+
+  /**
+   * @brief 注册等待者
+   *
+   * 若注册时缓存中已有匹配的就绪事件，立即调用一次回调，
+   * 避免丢失注册之前到达的事件。
+   *
+   * @param mask     感兴趣的事件集合
+   * @param callback 就绪通知回调
+   * @param context  原样传给回调的上下文
+   * @return 等待者句柄（用于 Unregister）；mask 为空或 callback 为空返回
+   *         kInvalidArgument，槽位已满返回 kDeviceBusy
+   */
+  auto Register(PollEvents mask, PollCallback callback, void* context)
+      -> Expected<size_t> {
+    if (!mask || callback == nullptr) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    for (size_t i = 0; i < kMaxWaiters; ++i) {
+      auto& waiter = waiters_[i];
+      uint8_t expected = kFree;
+      if (!waiter.state.compare_exchange_strong(expected, kClaimed,
+                                                std::memory_order_acquire)) {
+        continue;
+      }
+      waiter.mask = mask.value;
+      waiter.callback = callback;
+      waiter.context = context;
+      waiter.state.store(kArmed, std::memory_order_release);
+
+      PollEvents ready = Cached() & mask;
+      if (ready) {
+        callback(context, ready);
+      }
+      return i;
+    }
+    return std::unexpected(Error{ErrorCode::kDeviceBusy});
+  }
+
+  /**
+   * @brief 注销等待者
+   *
+   * @param handle Register() 返回的句柄
+   * @return 句柄无效返回 kInvalidArgument
+   */
+  auto Unregister(size_t handle) -> Expected<void> {
+    if (handle >= kMaxWaiters ||
+        waiters_[handle].state.load(std::memory_order_relaxed) != kArmed) {
+      return std::unexpected(Error{ErrorCode::kInvalidArgument});
+    }
+    waiters_[handle].state.store(kFree, std::memory_order_release);
+    return {};
+  }
+
+  /**
+   * @brief 更新就绪状态缓存并通知新就绪事件的等待者
+   *
+   * @param ready 设备当前的就绪事件
+   * @note 可在中断上下文中安全调用
+   */
+  auto Update(PollEvents ready) -> void {
+    uint32_t old = ready_.load(std::memory_order_relaxed);
+    while (!ready_.compare_exchange_weak(old, Tag(old, ready),
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_relaxed)) {
+    }
+    Notify(ready, old);
+  }
+
+  /**
+   * @brief 采样并发布就绪状态，不以过期的采样覆盖并发的更新
+   *
+   * 采样后以 CAS 发布；期间缓存被其他 Update()/Refresh() 修改时重新
+   * 采样（例如读者在 RX 环为空时采样，随后中断存入数据并报告 kIn，
+   * 读者不会再把 kIn 清除）。
+   *
+   * @tparam Sample 签名：PollEvents()，由设备状态得到当前就绪事件
+   * @param sample 采样函数（可能被调用多次）
+   * @return 最终发布的就绪事件
+   * @note 可在中断上下文中安全调用
+   */
+  template <typename Sample>
+  auto Refresh(Sample&& sample) -> PollEvents {
+    uint32_t old = ready_.load(std::memory_order_acquire);
+    PollEvents ready = sample();
+    while (!ready_.compare_exchange_weak(old, Tag(old, ready),
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+      ready = sample();
+    }
+    Notify(ready, old);
+    return ready;
+  }
+
+  /// @brief 最近一次 Update()/Refresh() 报告的就绪事件
+  [[nodiscard]] auto Cached() const -> PollEvents {
+    return PollEvents{ready_.load(std::memory_order_acquire) & kEventMask};
+  }
+
+  /// @name 构造/析构函数
+  /// @{
+  PollNotifier() = default;
+  ~PollNotifier() = default;
+  PollNotifier(const PollNotifier&) = delete;
+  auto operator=(const PollNotifier&) -> PollNotifier& = delete;
+  /// 移动仅在无并发访问时进行（如设备初始化期间），等待者随之迁移
+  PollNotifier(PollNotifier&& other) noexcept { MoveFrom(other); }
+  auto operator=(PollNotifier&& other) noexcept -> PollNotifier& {
+    if (this != &other) {
+      MoveFrom(other);
+    }
+    return *this;
+  }
+  /// @}
+
+ private:
+  /// 槽位空闲
+  static constexpr uint8_t kFree = 0;
+  /// 槽位已被预留，正在填写
+  static constexpr uint8_t kClaimed = 1;
+  /// 槽位已发布，参与通知
+  static constexpr uint8_t kArmed = 2;
+
+  /// ready_ 低 16 位为就绪事件，高 16 位为更新序号
+  static constexpr uint32_t kEventMask = 0xFFFF;
+  static constexpr uint32_t kSequenceOne = kEventMask + 1;
+
+  /// @brief 由旧缓存值得到发布 ready 时的新缓存值（序号加一）
+  static constexpr auto Tag(uint32_t old, PollEvents ready) -> uint32_t {
+    return ((old & ~kEventMask) + kSequenceOne) | (ready.value & kEventMask);
+  }
+
+  /// @brief 通知相对旧缓存值 old 新就绪事件的等待者
+  auto Notify(PollEvents ready, uint32_t old) -> void {
+    uint32_t rising = ready.value & ~old & kEventMask;
+    if (rising == 0) {
+      return;
+    }
+    for (auto& waiter : waiters_) {
+      if (waiter.state.load(std::memory_order_acquire) != kArmed ||
+          (waiter.mask & rising) == 0) {
+        continue;
+      }
+      waiter.callback(waiter.context, PollEvents{waiter.mask & ready.value});
+    }
+  }
+
+  struct Waiter {
+    std::atomic<uint8_t> state{kFree};
+    uint32_t mask = 0;
+    PollCallback callback = nullptr;
+    void* context = nullptr;
+  };
+
+  auto MoveFrom(PollNotifier& other) -> void {
+    for (size_t i = 0; i < kMaxWaiters; ++i) {
+      auto& src = other.waiters_[i];
+      auto& dst = waiters_[i];
+      dst.mask = src.mask;
+      dst.callback = src.callback;
+      dst.context = src.context;
+      dst.state.store(src.state.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+      src.state.store(kFree, std::memory_order_relaxed);
+    }
+    ready_.store(other.ready_.load(std::memory_order_relaxed),
+                 std::memory_order_relaxed);
+    other.ready_.store(0, std::memory_order_relaxed);
+  }
+
+  /// 等待者槽位
+  Waiter waiters_[kMaxWaiters];
+  /// 就绪事件缓存（带更新序号，见 Tag()）
+  std::atomic<uint32_t> ready_{0};
+};
+
+}  // namespace device_framework
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_OPS_POLL_NOTIFIER_HPP_ */
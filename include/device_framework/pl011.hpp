@@ -18,6 +18,7 @@
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_PL011_HPP_
 
 #include "device_framework/detail/pl011/pl011_device.hpp"
+#include "device_framework/detail/pl011/pl011_dma_device.hpp"
 
 namespace device_framework::pl011 {
 using namespace detail::pl011;  // NOLINT(google-build-using-namespace)
@@ -0,0 +1,360 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_TRACE_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_TRACE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "device_framework/traits.hpp"
+
+namespace device_framework {
+
+/**
+ * @brief 跟踪点事件 ID
+ */
+enum class TraceEvent : uint16_t {
+  /// 请求已写入 Available Ring（head = 描述符链头，len = 数据字节数）
+  kEnqueue = 1,
+  /// Kick 通知了设备（head = avail idx，len = 自上次通知以来的新请求数）
+  kKickNotify = 2,
+  /// Kick 被 Event Index 省略（字段含义同 kKickNotify）
+  kKickElided = 3,
+  /// 进入中断处理（queue = 处理的队列，全部队列时为 kTraceAllQueues）
+  kInterrupt = 4,
+  /// 从 Used Ring 弹出一个元素（head = 描述符链头，len = 设备写入字节数）
+  kUsedPop = 5,
+  /// 调用完成回调之前（head = 描述符链头，len = ErrorCode）
+  kComplete = 6,
+};
+
+/// kInterrupt 记录中表示"全部队列"的队列号
+inline constexpr uint16_t kTraceAllQueues = 0xFFFF;
+
+/**
+ * @brief 定长跟踪记录（32 字节，二进制布局固定）
+ */
+struct TraceRecord {
+  /// Traits::Now() 时间戳
+  uint64_t timestamp;
+  /// 写入序号 + 1（0 表示空槽或正在写入；64 位，不会回绕）
+  uint64_t sequence;
+  /// 长度或附加值（含义见 TraceEvent）
+  uint32_t len;
+  /// TraceEvent
+  uint16_t event;
+  /// 队列索引
+  uint16_t queue;
+  /// 描述符链头或 avail idx
+  uint16_t head;
+  /// 保留，写 0
+  uint16_t reserved[3];
+};
+static_assert(sizeof(TraceRecord) == 32, "TraceRecord layout is fixed");
+
+/**
+ * @brief 跟踪环的二进制头（位于 TraceRing 对象起始处）
+ *
+ * 内存转储（如 QEMU pmemsave、gdb dump memory）按头部自描述，
+ * 可由 DecodeTraceImage() 离线解码；多个 CPU 的环可依次拼接。
+ */
+struct TraceRingHeader {
+  /// 魔数 kTraceMagic
+  uint32_t magic;
+  /// sizeof(TraceRecord)
+  uint16_t record_size;
+  /// 所属 CPU
+  uint16_t cpu;
+  /// 记录槽数（2 的幂）
+  uint32_t capacity;
+  /// 保留，写 0
+  uint32_t reserved;
+  /// 已分配的写入序号总数
+  uint64_t head;
+};
+static_assert(sizeof(TraceRingHeader) == 24, "TraceRingHeader layout is fixed");
+
+/// 跟踪环魔数（"TRCE"）
+inline constexpr uint32_t kTraceMagic = 0x45435254;
+
+/**
+ * @brief 按写入顺序遍历一组记录槽中的有效记录
+ *
+ * 从最旧的未被覆盖的序号开始；序号不匹配的槽（正在写入或已被覆盖）
+ * 跳过。
+ *
+ * @param records 记录槽
+ * @param capacity 槽数（2 的幂）
+ * @param head 已分配的写入序号总数
+ * @param visit 签名：void(const TraceRecord& record)
+ * @return 访问的记录数
+ */
+template <typename Visitor>
+auto ForEachTraceRecord(const TraceRecord* records, uint32_t capacity,
+                        uint64_t head, Visitor&& visit) -> size_t {
+  uint64_t first = head > capacity ? head - capacity : 0;
+  size_t visited = 0;
+  for (uint64_t seq = first; seq != head; ++seq) {
+    const TraceRecord& slot = records[seq & (capacity - 1)];
+    auto sequence_ref =
+        std::atomic_ref<uint64_t>(const_cast<uint64_t&>(slot.sequence));
+    if (sequence_ref.load(std::memory_order_acquire) != seq + 1) {
+      continue;
+    }
+    TraceRecord copy;
+    __builtin_memcpy(&copy, &slot, sizeof(copy));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // 复制期间被覆盖则丢弃
+    if (sequence_ref.load(std::memory_order_relaxed) != seq + 1) {
+      continue;
+    }
+    visit(static_cast<const TraceRecord&>(copy));
+    ++visited;
+  }
+  return visited;
+}
+
+/**
+ * @brief 单 CPU 的无锁二进制跟踪环（飞行记录器语义）
+ *
+ * 写入者以 fetch_add 预留序号，槽满后覆盖最旧的记录；同一 CPU 上被
+ * 中断嵌套的写入各自预留不同的槽，无需关中断或加锁。每条记录最后以
+ * release 写入序号，读者（ForEach()、DumpTrace()）以序号校验识别
+ * 正在写入或已被覆盖的槽，可在写入进行时读取。
+ *
+ * 每个 CPU 使用独立的环，由平台的 Traits::GetTraceRing() 按当前 CPU
+ * 返回；对象的内存布局即 TraceRingHeader + TraceRecord[Capacity]。
+ * 写入序号为 64 位，按任何实际写入速率都不会回绕。
+ *
+ * @tparam Capacity 记录槽数（2 的幂）
+ * @see TraceTraits
+ */
+template <size_t Capacity = 1024>
+class TraceRing {
+ public:
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+  static_assert(Capacity <= (size_t{1} << 31), "Capacity too large");
+  static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                "TraceRing requires lock-free 64-bit atomics");
+
+  /**
+   * @brief 构造函数
+   * @param cpu 所属 CPU（仅写入头部供解码使用）
+   */
+  explicit TraceRing(uint16_t cpu = 0)
+      : magic_(kTraceMagic),
+        record_size_(sizeof(TraceRecord)),
+        cpu_(cpu),
+        capacity_(static_cast<uint32_t>(Capacity)) {
+    static_assert(sizeof(TraceRing) ==
+                      sizeof(TraceRingHeader) + Capacity * sizeof(TraceRecord),
+                  "TraceRing must match TraceRingHeader + records layout");
+  }
+
+  /**
+   * @brief 写入一条记录
+   *
+   * @param event 事件 ID
+   * @param queue 队列索引
+   * @param head 描述符链头或 avail idx
+   * @param len 长度或附加值
+   * @param timestamp 时间戳
+   */
+  auto Record(TraceEvent event, uint16_t queue, uint16_t head, uint32_t len,
+              uint64_t timestamp) -> void {
+    uint64_t seq = head_.fetch_add(1, std::memory_order_relaxed);
+    TraceRecord& slot = records_[seq & (Capacity - 1)];
+    auto sequence_ref = std::atomic_ref<uint64_t>(slot.sequence);
+    sequence_ref.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestamp = timestamp;
+    slot.len = len;
+    slot.event = static_cast<uint16_t>(event);
+    slot.queue = queue;
+    slot.head = head;
+    for (auto& reserved : slot.reserved) {
+      reserved = 0;
+    }
+    sequence_ref.store(seq + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief 按写入顺序遍历当前保留的记录
+   *
+   * @tparam Visitor 签名：void(const TraceRecord& record)
+   * @return 访问的记录数
+   */
+  template <typename Visitor>
+  auto ForEach(Visitor&& visit) const -> size_t {
+    return ForEachTraceRecord(records_, capacity_,
+                              head_.load(std::memory_order_acquire),
+                              static_cast<Visitor&&>(visit));
+  }
+
+  /// @brief 因环满被覆盖的记录数
+  [[nodiscard]] auto Overwritten() const -> uint64_t {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    return head > capacity_ ? head - capacity_ : 0;
+  }
+
+  /// @brief 已写入的记录总数
+  [[nodiscard]] auto Written() const -> uint64_t {
+    return head_.load(std::memory_order_relaxed);
+  }
+
+  /// @brief 所属 CPU
+  [[nodiscard]] auto cpu() const -> uint16_t { return cpu_; }
+
+  /**
+   * @brief 清空环（不得与 Record() 并发）
+   */
+  auto Reset() -> void {
+    head_.store(0, std::memory_order_relaxed);
+    for (auto& slot : records_) {
+      slot = {};
+    }
+  }
+
+  /// @name 构造/析构函数
+  /// @{
+  TraceRing(const TraceRing&) = delete;
+  TraceRing(TraceRing&&) = delete;
+  auto operator=(const TraceRing&) -> TraceRing& = delete;
+  auto operator=(TraceRing&&) -> TraceRing& = delete;
+  ~TraceRing() = default;
+  /// @}
+
+ private:
+  // 以下成员依次构成 TraceRingHeader
+  uint32_t magic_;
+  uint16_t record_size_;
+  uint16_t cpu_;
+  uint32_t capacity_;
+  uint32_t reserved_ = 0;
+  std::atomic<uint64_t> head_{0};
+  TraceRecord records_[Capacity]{};
+};
+
+/**
+ * @brief 跟踪点：Traits 满足 TraceTraits 时写入当前 CPU 的跟踪环
+ *
+ * 否则为空操作，在编译期消除。
+ *
+ * @tparam Traits 平台环境特征类型
+ */
+template <typename Traits>
+inline auto TracePoint([[maybe_unused]] TraceEvent event,
+                       [[maybe_unused]] uint16_t queue,
+                       [[maybe_unused]] uint16_t head,
+                       [[maybe_unused]] uint32_t len) -> void {
+  if constexpr (TraceTraits<Traits>) {
+    Traits::GetTraceRing().Record(event, queue, head, len,
+                                  static_cast<uint64_t>(Traits::Now()));
+  }
+}
+
+/**
+ * @brief 事件 ID 的可读名称
+ */
+[[nodiscard]] constexpr auto TraceEventName(uint16_t event) -> const char* {
+  switch (static_cast<TraceEvent>(event)) {
+    case TraceEvent::kEnqueue:
+      return "enqueue";
+    case TraceEvent::kKickNotify:
+      return "kick";
+    case TraceEvent::kKickElided:
+      return "kick-elided";
+    case TraceEvent::kInterrupt:
+      return "irq";
+    case TraceEvent::kUsedPop:
+      return "used-pop";
+    case TraceEvent::kComplete:
+      return "complete";
+  }
+  return "unknown";
+}
+
+/**
+ * @brief 解码一段跟踪环内存转储
+ *
+ * 依次解析转储中拼接的每个环（头部 + 记录槽），魔数或记录大小不匹配、
+ * 数据不完整时停止。
+ *
+ * @tparam Visitor 签名：void(const TraceRingHeader& ring,
+ *         const TraceRecord& record)
+ * @param image 转储内容（按 8 字节对齐）
+ * @param visit 每条有效记录调用一次
+ * @return 成功解析的环数
+ */
+template <typename Visitor>
+auto DecodeTraceImage(std::span<const uint8_t> image, Visitor&& visit)
+    -> size_t {
+  size_t rings = 0;
+  size_t offset = 0;
+  while (image.size() - offset >= sizeof(TraceRingHeader)) {
+    TraceRingHeader header;
+    __builtin_memcpy(&header, image.data() + offset, sizeof(header));
+    if (header.magic != kTraceMagic ||
+        header.record_size != sizeof(TraceRecord) || header.capacity < 2 ||
+        (header.capacity & (header.capacity - 1)) != 0) {
+      break;
+    }
+    size_t bytes = sizeof(TraceRingHeader) +
+                   static_cast<size_t>(header.capacity) * sizeof(TraceRecord);
+    if (image.size() - offset < bytes) {
+      break;
+    }
+    const auto* records = reinterpret_cast<const TraceRecord*>(
+        image.data() + offset + sizeof(TraceRingHeader));
+    ForEachTraceRecord(records, header.capacity, header.head,
+                       [&](const TraceRecord& record) {
+                         visit(static_cast<const TraceRingHeader&>(header),
+                               record);
+                       });
+    offset += bytes;
+    ++rings;
+  }
+  return rings;
+}
+
+/**
+ * @brief 通过 Traits::Log 输出跟踪环内容（每条记录一行）
+ *
+ * 时间戳以首条记录为零点，delta 为与上一条记录的间隔。
+ *
+ * @tparam Traits 平台环境特征类型（需满足 EnvironmentTraits）
+ * @tparam Capacity 跟踪环容量
+ * @param ring 跟踪环
+ */
+template <EnvironmentTraits Traits, size_t Capacity>
+auto DumpTrace(const TraceRing<Capacity>& ring) -> void {
+  Traits::Log("trace cpu %u: %llu records (%llu overwritten)", ring.cpu(),
+              static_cast<unsigned long long>(ring.Written() -
+                                              ring.Overwritten()),
+              static_cast<unsigned long long>(ring.Overwritten()));
+  bool first = true;
+  uint64_t base = 0;
+  uint64_t last = 0;
+  ring.ForEach([&](const TraceRecord& record) {
+    if (first) {
+      base = record.timestamp;
+      last = record.timestamp;
+      first = false;
+    }
+    Traits::Log("%llu +%llu %s q=%u head=%u len=%u",
+                static_cast<unsigned long long>(record.timestamp - base),
+                static_cast<unsigned long long>(record.timestamp - last),
+                TraceEventName(record.event), record.queue, record.head,
+                record.len);
+    last = record.timestamp;
+  });
+}
+
+}  // namespace device_framework
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_TRACE_HPP_ */
@@ -63,6 +63,172 @@ concept SpinWaitTraits = requires {
   { T::kMaxSpinIterations } -> std::convertible_to<uint32_t>;
 };
 
+/**
+ * @brief 可选 Traits：等待期间让出 CPU
+ *
+ * 若 Traits 提供静态方法 Yield()，同步等待（如 VirtioBlk::WaitFor() 与
+ * 同步读写）在两次轮询之间调用它（如执行 pause、wfi 或让出调度器），
+ * 而不是空转；否则退化为紧凑的轮询循环。Yield() 须在有限时间内返回：
+ * 同步路径等待期间可能关闭了设备的完成中断。
+ */
+template <typename T>
+concept YieldTraits = requires {
+  { T::Yield() } -> std::same_as<void>;
+};
+
+/**
+ * @brief 轮询等待中的一次让出（未提供 Yield() 时为空操作）
+ *
+ * @tparam Traits 平台环境特征类型
+ */
+template <typename Traits>
+auto YieldCpu() -> void {
+  if constexpr (YieldTraits<Traits>) {
+    Traits::Yield();
+  }
+}
+
+/**
+ * @brief 可选 Traits：驱动遥测（编译期开关）
+ *
+ * 若 Traits 提供 `static constexpr bool kEnableTelemetry = true`，
+ * 驱动额外记录在途深度、每次回收的完成数等遥测数据；
+ * 否则相关代码与存储在编译期消除。
+ */
+template <typename T>
+concept TelemetryTraits = requires { requires T::kEnableTelemetry; };
+
+/**
+ * @brief 可选 Traits：单调递增的时间戳（如周期计数器）
+ *
+ * 与 TelemetryTraits 同时满足时，驱动以 Now() 的差值记录请求延迟。
+ */
+template <typename T>
+concept TimestampTraits = requires {
+  { T::Now() } -> std::convertible_to<uint64_t>;
+};
+
+/**
+ * @brief 可选 Traits：热路径跟踪（编译期开关）
+ *
+ * 若 Traits 满足 TimestampTraits 且提供静态方法 GetTraceRing()，返回
+ * 当前 CPU 的 TraceRing 引用（见 trace.hpp），支持跟踪的驱动在入队、
+ * Kick（通知或省略）、中断入口、Used Ring 弹出与完成回调处各写入一条
+ * 定长记录；否则跟踪点在编译期消除，不占用任何存储。
+ */
+template <typename T>
+concept TraceTraits = TimestampTraits<T> && requires { T::GetTraceRing(); };
+
+/**
+ * @brief 可选 Traits：多生产者并发提交（编译期开关）
+ *
+ * 若 Traits 提供 `static constexpr bool kConcurrentSubmit = true`，
+ * 支持该模式的驱动允许多个核不加锁地同时向同一队列提交请求：
+ * 请求槽与描述符以原子操作预留，描述符在各核上独立构建，
+ * 只有最终的 avail idx 发布按预留顺序串行。完成回收仍须由单一上下文执行。
+ */
+template <typename T>
+concept ConcurrentSubmitTraits = requires { requires T::kConcurrentSubmit; };
+
+/**
+ * @brief 外设 DMA 通道能力（如 PL330 的一对外设请求通道）
+ *
+ * 供本身不含 DMA 主控、通过外设请求线由系统 DMA 控制器搬运数据的设备
+ * （如 PL011 的 UARTDMACR）使用。平台为该设备分配一个发送通道
+ * （内存 → 设备寄存器）和一个接收通道（设备寄存器 → 内存），提供：
+ * - DmaStartTx(src, dev, len) / DmaStartRx(dev, dst, len)：在空闲通道上
+ *   启动一次传输（地址均为物理地址），通道忙或参数不被支持时返回 false
+ * - DmaTxRemaining() / DmaRxRemaining()：当前（或最近一次）传输尚未
+ *   搬运的字节数，为 0 表示传输完成
+ * - DmaStopRx()：中止接收传输，返回后 DmaRxRemaining() 须反映已写入
+ *   内存的字节数
+ *
+ * 传输完成时平台应产生中断并路由到设备的 HandleInterrupt()。
+ */
+template <typename T>
+concept DmaChannelTraits =
+    DmaTraits<T> && requires(uintptr_t addr, uintptr_t dev, size_t len) {
+      { T::DmaStartTx(addr, dev, len) } -> std::same_as<bool>;
+      { T::DmaStartRx(dev, addr, len) } -> std::same_as<bool>;
+      { T::DmaTxRemaining() } -> std::same_as<size_t>;
+      { T::DmaRxRemaining() } -> std::same_as<size_t>;
+      { T::DmaStopRx() } -> std::same_as<void>;
+    };
+
+/**
+ * @brief 可选 Traits：非一致性 DMA 的缓存维护
+ *
+ * CPU 缓存与设备 DMA 不一致的平台（如缺少一致性互连、需通过 Zicbom
+ * 指令维护缓存的 RISC-V SoC）可提供以下静态方法：
+ * - CacheClean(ptr, len)：将覆盖 [ptr, ptr+len) 的缓存行写回内存，
+ *   返回时写回须已对设备可见
+ * - CacheInvalidate(ptr, len)：丢弃覆盖 [ptr, ptr+len) 的缓存行，
+ *   之后的读取直接来自内存
+ *
+ * 驱动仅对与设备共享的内存（Virtqueue 环、请求头、状态字节、数据缓冲区）
+ * 调用它们，其余内存无需映射为不可缓存。可选的 kCacheLineSize 静态常量
+ * （默认 kDefaultCacheLineSize）用于将 CPU 与设备各自写入的区域分隔到
+ * 不同缓存行。未提供这些方法的 Traits 视为 DMA 一致，调用在编译期消除。
+ *
+ * @note 设备写入的数据缓冲区须按缓存行对齐并独占其覆盖的缓存行，
+ *       否则完成时的 CacheInvalidate 会丢弃相邻数据的 CPU 写入。
+ */
+template <typename T>
+concept DmaCoherencyTraits = requires(void* ptr, size_t len) {
+  { T::CacheClean(ptr, len) } -> std::same_as<void>;
+  { T::CacheInvalidate(ptr, len) } -> std::same_as<void>;
+};
+
+/// 非一致性 DMA 平台未提供 kCacheLineSize 时假定的缓存行大小
+inline constexpr size_t kDefaultCacheLineSize = 64;
+
+/**
+ * @brief CPU 写入区域与设备写入区域之间所需的对齐
+ *
+ * @tparam Traits 平台环境特征类型
+ * @return DMA 一致的平台返回 1，否则返回缓存行大小
+ */
+template <typename Traits>
+[[nodiscard]] constexpr auto DmaCacheLineSize() -> size_t {
+  if constexpr (!DmaCoherencyTraits<Traits>) {
+    return 1;
+  } else if constexpr (requires { Traits::kCacheLineSize; }) {
+    return static_cast<size_t>(Traits::kCacheLineSize);
+  } else {
+    return kDefaultCacheLineSize;
+  }
+}
+
+/**
+ * @brief 将 CPU 写入的共享内存交给设备（写回缓存行）
+ *
+ * 应在内存被 CPU 写入之后、对设备发布（写屏障 + 更新索引）之前调用。
+ *
+ * @tparam Traits 平台环境特征类型
+ * @param ptr 共享内存起始地址
+ * @param len 字节数
+ */
+template <typename Traits>
+auto DmaSyncForDevice(const volatile void* ptr, size_t len) -> void {
+  if constexpr (DmaCoherencyTraits<Traits>) {
+    Traits::CacheClean(const_cast<void*>(ptr), len);
+  }
+}
+
+/**
+ * @brief 在 CPU 读取设备写入的共享内存之前丢弃过期的缓存行
+ *
+ * @tparam Traits 平台环境特征类型
+ * @param ptr 共享内存起始地址
+ * @param len 字节数
+ */
+template <typename Traits>
+auto DmaSyncForCpu(const volatile void* ptr, size_t len) -> void {
+  if constexpr (DmaCoherencyTraits<Traits>) {
+    Traits::CacheInvalidate(const_cast<void*>(ptr), len);
+  }
+}
+
 /**
  * @brief 零开销默认 Traits
  *
@@ -22,7 +22,11 @@
 #define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_BLK_HPP_
 
 #include "device_framework/detail/virtio/device/virtio_blk_device.hpp"
+#include "device_framework/detail/virtio/device/virtio_blk_request_queue.hpp"
 #include "device_framework/detail/virtio/traits.hpp"
+#include "device_framework/detail/virtio/transport/mmio_bus.hpp"
+#include "device_framework/detail/virtio/transport/pci.hpp"
+#include "device_framework/detail/virtio/transport/pci_bus.hpp"
 
 namespace device_framework::virtio {
 using namespace detail::virtio;  // NOLINT(google-build-using-namespace)
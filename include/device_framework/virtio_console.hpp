@@ -0,0 +1,40 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ *
+ * @brief VirtIO 控制台设备公开接口
+ *
+ * 用户应通过此头文件使用 VirtIO 控制台设备，而非直接包含 detail/ 中的实现
+ * 文件。
+ *
+ * @code
+ * #include "device_framework/virtio_console.hpp"
+ *
+ * using Console = device_framework::virtio::console::VirtioConsole<MyTraits>;
+ * auto console = Console::Create(mmio_base, dma_buf);
+ * device_framework::virtio::console::VirtioConsoleDevice<MyTraits> tty(
+ *     *console, 0);
+ * tty.OpenReadWrite();
+ * tty.Write(data);
+ * @endcode
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_CONSOLE_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_CONSOLE_HPP_
+
+#include "device_framework/detail/virtio/device/virtio_console.hpp"
+#include "device_framework/detail/virtio/device/virtio_console_device.hpp"
+#include "device_framework/detail/virtio/traits.hpp"
+#include "device_framework/detail/virtio/transport/mmio_bus.hpp"
+#include "device_framework/detail/virtio/transport/pci.hpp"
+#include "device_framework/detail/virtio/transport/pci_bus.hpp"
+
+namespace device_framework::virtio {
+using namespace detail::virtio;  // NOLINT(google-build-using-namespace)
+}  // namespace device_framework::virtio
+
+namespace device_framework::virtio::console {
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace detail::virtio::console;
+}  // namespace device_framework::virtio::console
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_CONSOLE_HPP_ */
@@ -0,0 +1,37 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ *
+ * @brief VirtIO GPU 设备公开接口
+ *
+ * 用户应通过此头文件使用 VirtIO GPU 设备，而非直接包含 detail/ 中的实现文件。
+ *
+ * @code
+ * #include "device_framework/virtio_gpu.hpp"
+ *
+ * using Fb = device_framework::virtio::gpu::VirtioGpuDevice<MyTraits>;
+ * auto fb = Fb::Create(mmio_base, dma_buf, fb_buf, fb_size);
+ * fb->OpenReadWrite();
+ * fb->MarkDirty({x, y, w, h});
+ * fb->Present();
+ * @endcode
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_GPU_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_GPU_HPP_
+
+#include "device_framework/detail/virtio/device/virtio_gpu.hpp"
+#include "device_framework/detail/virtio/device/virtio_gpu_device.hpp"
+#include "device_framework/detail/virtio/traits.hpp"
+#include "device_framework/detail/virtio/transport/mmio_bus.hpp"
+#include "device_framework/detail/virtio/transport/pci.hpp"
+#include "device_framework/detail/virtio/transport/pci_bus.hpp"
+
+namespace device_framework::virtio {
+using namespace detail::virtio;  // NOLINT(google-build-using-namespace)
+}  // namespace device_framework::virtio
+
+namespace device_framework::virtio::gpu {
+using namespace detail::virtio::gpu;  // NOLINT(google-build-using-namespace)
+}  // namespace device_framework::virtio::gpu
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_GPU_HPP_ */
@@ -0,0 +1,37 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ *
+ * @brief VirtIO 输入设备公开接口
+ *
+ * 用户应通过此头文件使用 VirtIO 输入设备，而非直接包含 detail/ 中的实现
+ * 文件。
+ *
+ * @code
+ * #include "device_framework/virtio_input.hpp"
+ *
+ * using Input = device_framework::virtio::input::VirtioInputDevice<MyTraits>;
+ * auto dev = Input::Create(mmio_base, dma_buf);
+ * dev->OpenReadOnly();
+ * dev->Read(buffer);
+ * @endcode
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_INPUT_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_INPUT_HPP_
+
+#include "device_framework/detail/virtio/device/virtio_input.hpp"
+#include "device_framework/detail/virtio/device/virtio_input_device.hpp"
+#include "device_framework/detail/virtio/traits.hpp"
+#include "device_framework/detail/virtio/transport/mmio_bus.hpp"
+#include "device_framework/detail/virtio/transport/pci.hpp"
+#include "device_framework/detail/virtio/transport/pci_bus.hpp"
+
+namespace device_framework::virtio {
+using namespace detail::virtio;  // NOLINT(google-build-using-namespace)
+}  // namespace device_framework::virtio
+
+namespace device_framework::virtio::input {
+using namespace detail::virtio::input;  // NOLINT(google-build-using-namespace)
+}  // namespace device_framework::virtio::input
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_INPUT_HPP_ */
@@ -0,0 +1,36 @@
+/**
+ * @copyright Copyright The device_framework Contributors
+ *
+ * @brief VirtIO 网络设备公开接口
+ *
+ * 用户应通过此头文件使用 VirtIO 网络设备，而非直接包含 detail/ 中的实现文件。
+ *
+ * @code
+ * #include "device_framework/virtio_net.hpp"
+ *
+ * using Net = device_framework::virtio::net::VirtioNet<MyTraits>;
+ * auto net = Net::Create(mmio_base, dma_buf);
+ * net->Transmit(0, &frame, 1);
+ * net->KickTx(0);
+ * net->Receive(0, [](const Net::RxPacket& packet) { ... });
+ * @endcode
+ */
+
+#ifndef DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_NET_HPP_
+#define DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_NET_HPP_
+
+#include "device_framework/detail/virtio/device/virtio_net.hpp"
+#include "device_framework/detail/virtio/traits.hpp"
+#include "device_framework/detail/virtio/transport/mmio_bus.hpp"
+#include "device_framework/detail/virtio/transport/pci.hpp"
+#include "device_framework/detail/virtio/transport/pci_bus.hpp"
+
+namespace device_framework::virtio {
+using namespace detail::virtio;  // NOLINT(google-build-using-namespace)
+}  // namespace device_framework::virtio
+
+namespace device_framework::virtio::net {
+using namespace detail::virtio::net;  // NOLINT(google-build-using-namespace)
+}  // namespace device_framework::virtio::net
+
+#endif /* DEVICE_FRAMEWORK_INCLUDE_DEVICE_FRAMEWORK_VIRTIO_NET_HPP_ */
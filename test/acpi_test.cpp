@@ -0,0 +1,361 @@
+/**
+ * @file acpi_test.cpp
+ * @brief ACPI 表解析测试
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 在内存中构造 RSDP/XSDT 及若干描述表，测试内容：
+ * 1. RSDP/XSDT 校验和验证与表索引构建
+ * 2. 编译期签名查找（含 "MADT" 别名、多实例 SSDT、FADT 引用的 DSDT）
+ *    与 MCFG ECAM 窗口查找
+ * 3. 校验和错误的表被跳过
+ * 4. RSDP 签名/校验和错误与 RSDT 回退
+ * 5. MADT/SRAT/SLIT 提取 NUMA 拓扑（CPU → 节点、节点 → 内存、距离）
+ */
+
+#include "device_framework/acpi.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "test.h"
+#include "test_env.h"
+
+namespace {
+
+using device_framework::acpi::Acpi;
+
+/// 合成 MADT 中的 hart 数（最后一个 hart 不可用且不可上线）
+constexpr size_t kHarts = 5;
+/// 合成 SRAT 中的两个邻近域
+constexpr uint32_t kDomainA = 5;
+constexpr uint32_t kDomainB = 9;
+/// 合成 SLIT 的 locality 数（覆盖两个邻近域编号）
+constexpr size_t kLocalities = 10;
+/// 两个邻近域之间的距离
+constexpr uint8_t kRemote = 32;
+/// 合成 MCFG 中的 ECAM 窗口基地址
+constexpr uint64_t kEcamBase = 0x30000000;
+
+/// 合成表所在的内存
+alignas(16) uint8_t g_acpi_buf[4096];
+
+/// @brief 计算校验和字节，使 [data, data + length) 的字节和为 0
+auto FixChecksum(uint8_t* data, size_t length, size_t checksum_offset)
+    -> void {
+  data[checksum_offset] = 0;
+  uint8_t sum = 0;
+  for (size_t i = 0; i < length; ++i) {
+    sum = static_cast<uint8_t>(sum + data[i]);
+  }
+  data[checksum_offset] = static_cast<uint8_t>(-sum);
+}
+
+/// @brief 在 offset 处构造一个描述表头（length 含表头）
+auto MakeTable(size_t offset, const char* signature, uint32_t length)
+    -> Acpi::DescriptionHeader* {
+  auto* header = reinterpret_cast<Acpi::DescriptionHeader*>(g_acpi_buf +
+                                                             offset);
+  __builtin_memcpy(header->signature, signature, 4);
+  header->length = length;
+  header->revision = 1;
+  return header;
+}
+
+/// @brief 修正描述表校验和
+auto Seal(Acpi::DescriptionHeader* header) -> void {
+  FixChecksum(reinterpret_cast<uint8_t*>(header), header->length,
+              offsetof(Acpi::DescriptionHeader, checksum));
+}
+
+/// @brief 表的物理地址（测试环境恒等映射）
+auto Phys(const void* ptr) -> uint64_t {
+  return reinterpret_cast<uintptr_t>(ptr);
+}
+
+/**
+ * @brief 构造 MADT：kHarts 个 RINTC 结构（hart i 的 UID 为 10 + i）
+ */
+auto BuildMadt(size_t offset) -> Acpi::DescriptionHeader* {
+  auto* madt = MakeTable(offset, "APIC",
+                         sizeof(Acpi::Madt) + kHarts * sizeof(Acpi::MadtRintc));
+  auto* rintc = reinterpret_cast<Acpi::MadtRintc*>(g_acpi_buf + offset +
+                                                   sizeof(Acpi::Madt));
+  for (size_t i = 0; i < kHarts; ++i) {
+    rintc[i].header = {0x18, sizeof(Acpi::MadtRintc)};
+    rintc[i].version = 1;
+    rintc[i].hart_id = i;
+    rintc[i].acpi_processor_uid = static_cast<uint32_t>(10 + i);
+    rintc[i].flags = Acpi::kMadtEnabled;
+  }
+  rintc[kHarts - 2].flags = Acpi::kMadtOnlineCapable;
+  rintc[kHarts - 1].flags = 0;
+  Seal(madt);
+  return madt;
+}
+
+/**
+ * @brief 构造 SRAT：UID 10/11 位于 kDomainA，12/13 位于 kDomainB，
+ *        每个邻近域各一段 1 GiB 内存（kDomainB 的可热插拔）
+ */
+auto BuildSrat(size_t offset) -> Acpi::DescriptionHeader* {
+  constexpr size_t kCpus = 4;
+  auto* srat = MakeTable(offset, "SRAT",
+                         sizeof(Acpi::Srat) +
+                             kCpus * sizeof(Acpi::SratRintcAffinity) +
+                             2 * sizeof(Acpi::SratMemoryAffinity));
+  auto* cpu = reinterpret_cast<Acpi::SratRintcAffinity*>(g_acpi_buf + offset +
+                                                         sizeof(Acpi::Srat));
+  for (size_t i = 0; i < kCpus; ++i) {
+    cpu[i].header = {7, sizeof(Acpi::SratRintcAffinity)};
+    cpu[i].proximity_domain = i < 2 ? kDomainA : kDomainB;
+    cpu[i].acpi_processor_uid = static_cast<uint32_t>(10 + i);
+    cpu[i].flags = Acpi::kSratEnabled;
+  }
+  auto* mem = reinterpret_cast<Acpi::SratMemoryAffinity*>(cpu + kCpus);
+  mem[0].header = {1, sizeof(Acpi::SratMemoryAffinity)};
+  mem[0].proximity_domain = kDomainA;
+  mem[0].base_address = 0x80000000ULL;
+  mem[0].length = 0x40000000ULL;
+  mem[0].flags = Acpi::kSratEnabled;
+  mem[1] = mem[0];
+  mem[1].proximity_domain = kDomainB;
+  mem[1].base_address = 0xC0000000ULL;
+  mem[1].flags = Acpi::kSratEnabled | Acpi::kSratHotPluggable;
+  Seal(srat);
+  return srat;
+}
+
+/**
+ * @brief 构造 SLIT：kDomainA 与 kDomainB 之间距离为 kRemote
+ */
+auto BuildSlit(size_t offset) -> Acpi::DescriptionHeader* {
+  auto* slit = MakeTable(offset, "SLIT",
+                         sizeof(Acpi::Slit) + kLocalities * kLocalities);
+  reinterpret_cast<Acpi::Slit*>(slit)->number_of_localities = kLocalities;
+  uint8_t* matrix = g_acpi_buf + offset + sizeof(Acpi::Slit);
+  for (size_t i = 0; i < kLocalities; ++i) {
+    for (size_t j = 0; j < kLocalities; ++j) {
+      matrix[i * kLocalities + j] = i == j ? 10 : 20;
+    }
+  }
+  matrix[kDomainA * kLocalities + kDomainB] = kRemote;
+  matrix[kDomainB * kLocalities + kDomainA] = kRemote;
+  Seal(slit);
+  return slit;
+}
+
+/**
+ * @brief 构造 RSDP → XSDT →
+ *        {FACP, APIC, MCFG, SSDT, SSDT, 损坏表, SRAT, SLIT}，FACP → DSDT
+ *
+ * @param revision RSDP 版本（0 时只填写 RSDT）
+ * @return RSDP 物理地址
+ */
+auto BuildTables(uint8_t revision) -> uint64_t {
+  Memzero(g_acpi_buf, sizeof(g_acpi_buf));
+  constexpr size_t kHeader = sizeof(Acpi::DescriptionHeader);
+
+  auto* dsdt = MakeTable(0x100, "DSDT", kHeader + 16);
+  Seal(dsdt);
+  auto* fadt = MakeTable(0x200, "FACP", sizeof(Acpi::Fadt));
+  reinterpret_cast<Acpi::Fadt*>(fadt)->x_dsdt = Phys(dsdt);
+  Seal(fadt);
+  auto* madt = BuildMadt(0x400);
+  auto* mcfg = MakeTable(0x500, "MCFG",
+                         sizeof(Acpi::Mcfg) + sizeof(Acpi::McfgAllocation));
+  auto* ecam = reinterpret_cast<Acpi::McfgAllocation*>(g_acpi_buf + 0x500 +
+                                                       sizeof(Acpi::Mcfg));
+  ecam->base_address = kEcamBase;
+  ecam->pci_segment_group = 0;
+  ecam->start_bus = 0;
+  ecam->end_bus = 0x7F;
+  Seal(mcfg);
+  auto* ssdt0 = MakeTable(0x580, "SSDT", kHeader);
+  ssdt0->oem_revision = 0;
+  Seal(ssdt0);
+  auto* ssdt1 = MakeTable(0x600, "SSDT", kHeader);
+  ssdt1->oem_revision = 1;
+  Seal(ssdt1);
+  auto* broken = MakeTable(0x680, "HPET", kHeader + 4);
+  Seal(broken);
+  broken->oem_revision ^= 0xFF;  // 破坏校验和
+  auto* srat = BuildSrat(0x700);
+  auto* slit = BuildSlit(0x800);
+
+  const uint64_t tables[] = {Phys(fadt),  Phys(madt),   Phys(mcfg),
+                             Phys(ssdt0), Phys(ssdt1),  Phys(broken),
+                             Phys(srat),  Phys(slit)};
+  constexpr size_t kCount = sizeof(tables) / sizeof(tables[0]);
+
+  // XSDT 表项只按 4 字节对齐
+  auto* xsdt = MakeTable(0x900, "XSDT", kHeader + kCount * 8);
+  for (size_t i = 0; i < kCount; ++i) {
+    __builtin_memcpy(reinterpret_cast<uint8_t*>(xsdt) + kHeader + i * 8,
+                     &tables[i], 8);
+  }
+  Seal(xsdt);
+  auto* rsdt = MakeTable(0xA00, "RSDT", kHeader + kCount * 4);
+  for (size_t i = 0; i < kCount; ++i) {
+    auto entry = static_cast<uint32_t>(tables[i]);
+    __builtin_memcpy(reinterpret_cast<uint8_t*>(rsdt) + kHeader + i * 4,
+                     &entry, 4);
+  }
+  Seal(rsdt);
+
+  auto* rsdp = reinterpret_cast<Acpi::Rsdp*>(g_acpi_buf);
+  __builtin_memcpy(rsdp->signature, "RSD PTR ", 8);
+  rsdp->revision = revision;
+  rsdp->rsdt_address = static_cast<uint32_t>(Phys(rsdt));
+  if (revision >= 2) {
+    rsdp->length = sizeof(Acpi::Rsdp);
+    rsdp->xsdt_address = Phys(xsdt);
+  }
+  // 扩展校验和覆盖 checksum 字节，须最后计算
+  FixChecksum(g_acpi_buf, 20, offsetof(Acpi::Rsdp, checksum));
+  if (revision >= 2) {
+    FixChecksum(g_acpi_buf, sizeof(Acpi::Rsdp),
+                offsetof(Acpi::Rsdp, extended_checksum));
+  }
+  return Phys(rsdp);
+}
+
+}  // namespace
+
+void test_acpi() {
+  TEST_SUITE_BEGIN("ACPI");
+
+  // 合成表的地址须能放入 RSDT 的 32 位表项
+  if (Phys(g_acpi_buf + sizeof(g_acpi_buf)) > UINT32_MAX) {
+    LOG("Test buffer above 4 GiB, skipping ACPI tests");
+    TEST_SUITE_END();
+    return;
+  }
+
+  // === 测试 1: XSDT 验证与索引 ===
+  {
+    Acpi acpi(BuildTables(2));
+    EXPECT_TRUE(acpi.Validate().has_value(), "Validate() with XSDT");
+    EXPECT_EQ(static_cast<size_t>(8), acpi.GetTableCount(),
+              "Seven root tables plus DSDT indexed");
+    EXPECT_EQ(static_cast<size_t>(1), acpi.GetInvalidTableCount(),
+              "Corrupted table skipped");
+
+    // === 测试 2: 编译期签名查找 ===
+    auto madt = acpi.FindTable<"APIC">();
+    EXPECT_TRUE(madt.has_value() && Phys(*madt) == Phys(g_acpi_buf + 0x400),
+                "FindTable<\"APIC\">()");
+    auto alias = acpi.FindTable<"MADT">();
+    EXPECT_TRUE(alias.has_value() && *alias == *madt,
+                "\"MADT\" aliases \"APIC\"");
+    EXPECT_TRUE(acpi.FindTable<"MCFG">().has_value(), "FindTable<\"MCFG\">()");
+    auto allocs = acpi.GetMcfgAllocations();
+    EXPECT_TRUE(allocs.has_value() && allocs->size() == 1,
+                "One MCFG allocation");
+    auto window = acpi.FindMcfgAllocation(0, 0x10);
+    EXPECT_TRUE(window.has_value() && (*window)->base_address == kEcamBase,
+                "ECAM window covering bus 0x10");
+    EXPECT_FALSE(acpi.FindMcfgAllocation(0, 0x80).has_value(),
+                 "Bus beyond end_bus not covered");
+    EXPECT_FALSE(acpi.FindMcfgAllocation(1).has_value(),
+                 "Unknown segment not covered");
+
+    auto ssdt1 = acpi.FindTable<"SSDT">(1);
+    EXPECT_TRUE(ssdt1.has_value() && (*ssdt1)->oem_revision == 1,
+                "Second SSDT by instance");
+    EXPECT_FALSE(acpi.FindTable<"SSDT">(2).has_value(),
+                 "No third SSDT");
+
+    auto fadt = acpi.FindTable<"FADT", Acpi::Fadt>();
+    EXPECT_TRUE(fadt.has_value(), "Typed FADT lookup");
+    auto dsdt = acpi.FindTable<"DSDT">();
+    EXPECT_TRUE(dsdt.has_value() && fadt.has_value() &&
+                    Phys(*dsdt) == (*fadt)->x_dsdt,
+                "DSDT indexed through FADT");
+
+    // === 测试 3: 校验和错误的表不可见 ===
+    auto hpet = acpi.FindTable<"HPET">();
+    EXPECT_TRUE(!hpet.has_value() &&
+                    hpet.error().code ==
+                        device_framework::ErrorCode::kAcpiTableNotFound,
+                "Corrupted HPET not found");
+  }
+
+  // === 测试 4: RSDT 回退与 RSDP 错误 ===
+  {
+    Acpi acpi(BuildTables(0));
+    EXPECT_TRUE(acpi.FindTable<"APIC">().has_value(),
+                "ACPI 1.0 RSDP falls back to RSDT");
+  }
+  {
+    BuildTables(2);
+    g_acpi_buf[offsetof(Acpi::Rsdp, extended_checksum)] ^= 0x01;
+    Acpi acpi(Phys(g_acpi_buf));
+    auto result = acpi.Validate();
+    EXPECT_TRUE(!result.has_value() &&
+                    result.error().code ==
+                        device_framework::ErrorCode::kAcpiChecksumMismatch,
+                "Extended checksum mismatch rejected");
+    EXPECT_FALSE(acpi.FindTable<"APIC">().has_value(),
+                 "Lookup fails after validation error");
+  }
+  {
+    BuildTables(2);
+    g_acpi_buf[0] = 'X';
+    Acpi acpi(Phys(g_acpi_buf));
+    auto result = acpi.Validate();
+    EXPECT_TRUE(!result.has_value() &&
+                    result.error().code ==
+                        device_framework::ErrorCode::kAcpiInvalidSignature,
+                "Bad RSDP signature rejected");
+  }
+
+  // === 测试 5: NUMA 拓扑 ===
+  {
+    Acpi acpi(BuildTables(2));
+    auto topo = device_framework::acpi::NumaTopology<8, 4, 8>::Create(acpi);
+    EXPECT_TRUE(topo.has_value(), "NumaTopology::Create()");
+    if (topo.has_value()) {
+      EXPECT_EQ(kHarts - 1, topo->GetCpus().size(),
+                "Unusable hart skipped");
+      EXPECT_EQ(static_cast<size_t>(2), topo->GetNodeCount(),
+                "Two nodes from SRAT");
+      EXPECT_EQ(kDomainA, topo->GetProximityDomain(0),
+                "Node 0 is the first domain seen");
+      EXPECT_EQ(0u, static_cast<uint32_t>(topo->GetCpuNode(1)),
+                "Hart 1 on node 0");
+      EXPECT_EQ(1u, static_cast<uint32_t>(topo->GetCpuNode(2)),
+                "Hart 2 on node 1");
+      auto hart3 = topo->FindCpu(3);
+      EXPECT_TRUE(hart3.has_value() && !(*hart3)->enabled &&
+                      (*hart3)->node == 1,
+                  "Online-capable hart kept as disabled");
+
+      uint64_t ids[4] = {};
+      EXPECT_EQ(static_cast<size_t>(2), topo->GetCpusOfNode(1, ids),
+                "Two harts on node 1");
+      EXPECT_TRUE(ids[0] == 2 && ids[1] == 3, "Node 1 hart IDs");
+
+      auto ranges = topo->GetMemoryRanges();
+      EXPECT_EQ(static_cast<size_t>(2), ranges.size(), "Two memory ranges");
+      auto node = topo->FindMemoryNode(0xC0001000ULL);
+      EXPECT_TRUE(node.has_value() && *node == 1, "Address on node 1 memory");
+      EXPECT_FALSE(topo->FindMemoryNode(0x1000).has_value(),
+                   "Address outside SRAT ranges");
+
+      EXPECT_EQ(static_cast<uint32_t>(10),
+                static_cast<uint32_t>(topo->GetDistance(0, 0)),
+                "Local distance from SLIT");
+      EXPECT_EQ(static_cast<uint32_t>(kRemote),
+                static_cast<uint32_t>(topo->GetDistance(0, 1)),
+                "Remote distance from SLIT");
+
+      EXPECT_EQ(0u, static_cast<uint32_t>(topo->GetQueueNode(1, 4)),
+                "Queues 0-1 on node 0");
+      EXPECT_EQ(1u, static_cast<uint32_t>(topo->GetQueueNode(2, 4)),
+                "Queues 2-3 on node 1");
+      EXPECT_FALSE(topo->IsTruncated(), "Topology fits in capacity");
+    }
+  }
+
+  TEST_SUITE_END();
+}
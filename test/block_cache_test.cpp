@@ -0,0 +1,243 @@
+/**
+ * @file block_cache_test.cpp
+ * @brief 写回式块缓存测试
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 在 VirtioBlkDevice 之上测试 CachedBlockDevice：
+ * 1. Create() 参数校验与 Open
+ * 2. 写操作只进入缓存，Flush() 后才落到设备
+ * 3. 读命中统计
+ * 4. 超过容量时的 CLOCK 淘汰与脏页回写
+ * 5. 连续脏页的合并回写与 Release() 回写
+ * 6. 顺序读取触发预读
+ */
+
+#include <cstdint>
+
+#include "device_framework/block_cache.hpp"
+#include "device_framework/virtio_blk.hpp"
+#include "test.h"
+#include "test_env.h"
+
+namespace {
+
+/// 缓存页数量
+constexpr size_t kCachePages = 8;
+
+/// 缓存页内存池（DMA 可访问）
+alignas(4096) uint8_t g_cache_pool[kCachePages * kSectorSize];
+
+/**
+ * @brief 按块号生成测试数据
+ */
+auto Pattern(uint64_t block_no, size_t i, uint8_t seed) -> uint8_t {
+  return static_cast<uint8_t>((block_no * 7) ^ i ^ seed);
+}
+
+}  // namespace
+
+void test_block_cache() {
+  TEST_SUITE_BEGIN("Block Cache");
+
+  uint64_t blk_base = FindBlkDevice();
+  EXPECT_TRUE(blk_base != 0, "Find VirtIO block device");
+  if (blk_base == 0) {
+    LOG("No block device found, skipping remaining tests");
+    TEST_SUITE_END();
+    return;
+  }
+
+  using DeviceType =
+      device_framework::virtio::blk::VirtioBlkDevice<RiscvTraits>;
+  using CacheType =
+      device_framework::block_cache::CachedBlockDevice<DeviceType,
+                                                       kCachePages>;
+
+  // === 测试 1: Create() 参数校验与 Open ===
+  {
+    Memzero(g_dma_buf, DeviceType::CalcDmaSize());
+    auto tmp_result = DeviceType::Create(blk_base, g_dma_buf);
+    if (tmp_result.has_value()) {
+      auto too_small =
+          CacheType::Create(std::move(*tmp_result),
+                            std::span<uint8_t>(g_cache_pool, kSectorSize));
+      EXPECT_FALSE(too_small.has_value(), "Create() rejects a too small pool");
+    }
+  }
+
+  Memzero(g_dma_buf, DeviceType::CalcDmaSize());
+  auto dev_result = DeviceType::Create(blk_base, g_dma_buf);
+  EXPECT_TRUE(dev_result.has_value(), "VirtioBlkDevice::Create() succeeds");
+  if (!dev_result.has_value()) {
+    TEST_SUITE_END();
+    return;
+  }
+  auto cache_result = CacheType::Create(std::move(*dev_result), g_cache_pool);
+  EXPECT_TRUE(cache_result.has_value(), "CachedBlockDevice::Create() succeeds");
+  if (!cache_result.has_value()) {
+    TEST_SUITE_END();
+    return;
+  }
+  auto& cache = *cache_result;
+  EXPECT_TRUE(cache.OpenReadWrite().has_value(), "OpenReadWrite() succeeds");
+  EXPECT_EQ(static_cast<uint64_t>(kSectorSize),
+            static_cast<uint64_t>(cache.GetBlockSize()),
+            "Block size matches inner device");
+  auto& inner = cache.GetInner();
+
+  // === 测试 2: 写入只进入缓存，Flush() 后落盘 ===
+  {
+    constexpr uint64_t kBlock = 900;
+    Memzero(g_data_buf, kSectorSize);
+    (void)inner.WriteBlock(kBlock,
+                           std::span<const uint8_t>(g_data_buf, kSectorSize));
+
+    for (size_t i = 0; i < kSectorSize; ++i) {
+      g_data_buf[i] = Pattern(kBlock, i, 0x3C);
+    }
+    EXPECT_TRUE(cache
+                    .WriteBlock(kBlock, std::span<const uint8_t>(g_data_buf,
+                                                                 kSectorSize))
+                    .has_value(),
+                "Cached WriteBlock succeeds");
+    EXPECT_EQ(1u, cache.GetDirtyCount(), "One dirty page after write");
+
+    Memzero(g_data_buf, kSectorSize);
+    (void)inner.ReadBlock(kBlock, std::span<uint8_t>(g_data_buf, kSectorSize));
+    EXPECT_EQ(0u, g_data_buf[1], "Device not written before Flush");
+
+    EXPECT_TRUE(cache.Flush().has_value(), "Flush succeeds");
+    EXPECT_EQ(0u, cache.GetDirtyCount(), "No dirty pages after Flush");
+    (void)inner.ReadBlock(kBlock, std::span<uint8_t>(g_data_buf, kSectorSize));
+    bool match = true;
+    for (size_t i = 0; i < kSectorSize && match; ++i) {
+      match = g_data_buf[i] == Pattern(kBlock, i, 0x3C);
+    }
+    EXPECT_TRUE(match, "Device holds cached data after Flush");
+  }
+
+  // === 测试 3: 读命中 ===
+  {
+    auto before = cache.GetStats();
+    Memzero(g_data_buf, kSectorSize);
+    auto read_result =
+        cache.ReadBlock(900, std::span<uint8_t>(g_data_buf, kSectorSize));
+    EXPECT_TRUE(read_result.has_value(), "Cached ReadBlock succeeds");
+    auto after = cache.GetStats();
+    EXPECT_EQ(before.hits + 1, after.hits, "Read of cached block is a hit");
+    EXPECT_EQ(before.misses, after.misses, "No device read on hit");
+    EXPECT_EQ(Pattern(900, 5, 0x3C), g_data_buf[5], "Hit returns cached data");
+  }
+
+  // === 测试 4: 超过容量时淘汰并回写脏页 ===
+  constexpr uint64_t kBase = 910;
+  constexpr size_t kBlocks = kCachePages * 3;
+  {
+    for (size_t b = 0; b < kBlocks; ++b) {
+      for (size_t i = 0; i < kSectorSize; ++i) {
+        g_large_buf[b * kSectorSize + i] = Pattern(kBase + b, i, 0x5A);
+      }
+    }
+    auto written = cache.WriteBlocks(
+        kBase, std::span<const uint8_t>(g_large_buf, kBlocks * kSectorSize),
+        kBlocks);
+    EXPECT_TRUE(written.has_value() && *written == kBlocks,
+                "WriteBlocks beyond capacity succeeds");
+    auto stats = cache.GetStats();
+    EXPECT_TRUE(stats.evictions > 0, "Pages evicted beyond capacity");
+    EXPECT_TRUE(stats.writeback_blocks > 0, "Dirty victims written back");
+    EXPECT_TRUE(cache.GetDirtyCount() <= kCachePages,
+                "Dirty pages bounded by capacity");
+
+    Memzero(g_large_buf, kBlocks * kSectorSize);
+    auto read_back = cache.ReadBlocks(
+        kBase, std::span<uint8_t>(g_large_buf, kBlocks * kSectorSize),
+        kBlocks);
+    EXPECT_TRUE(read_back.has_value() && *read_back == kBlocks,
+                "ReadBlocks across evicted and cached blocks");
+    bool match = true;
+    for (size_t b = 0; b < kBlocks && match; ++b) {
+      for (size_t i = 0; i < kSectorSize && match; ++i) {
+        match = g_large_buf[b * kSectorSize + i] == Pattern(kBase + b, i, 0x5A);
+      }
+    }
+    EXPECT_TRUE(match, "Data intact after eviction");
+  }
+
+  // === 测试 5: 连续脏页合并回写，Release() 回写剩余脏页 ===
+  {
+    for (size_t b = 0; b < kCachePages; ++b) {
+      for (size_t i = 0; i < kSectorSize; ++i) {
+        g_large_buf[b * kSectorSize + i] = Pattern(kBase + b, i, 0xA7);
+      }
+    }
+    (void)cache.WriteBlocks(
+        kBase, std::span<const uint8_t>(g_large_buf, kCachePages * kSectorSize),
+        kCachePages);
+    auto before = cache.GetStats();
+    EXPECT_TRUE(cache.Flush().has_value(), "Flush of sequential run succeeds");
+    auto after = cache.GetStats();
+    uint64_t requests = after.writeback_requests - before.writeback_requests;
+    uint64_t blocks = after.writeback_blocks - before.writeback_blocks;
+    EXPECT_EQ(static_cast<uint64_t>(kCachePages), blocks,
+              "All sequential dirty pages written back");
+    EXPECT_TRUE(requests < blocks, "Sequential run coalesced");
+    RiscvTraits::Log("Cache: %u blocks in %u requests",
+                     static_cast<uint32_t>(blocks),
+                     static_cast<uint32_t>(requests));
+
+    for (size_t i = 0; i < kSectorSize; ++i) {
+      g_data_buf[i] = Pattern(kBase, i, 0xE1);
+    }
+    (void)cache.WriteBlock(kBase,
+                           std::span<const uint8_t>(g_data_buf, kSectorSize));
+    EXPECT_TRUE(cache.Release().has_value(), "Release() succeeds");
+
+    EXPECT_TRUE(inner.OpenReadOnly().has_value(), "Reopen inner device");
+    Memzero(g_data_buf, kSectorSize);
+    (void)inner.ReadBlock(kBase, std::span<uint8_t>(g_data_buf, kSectorSize));
+    EXPECT_EQ(Pattern(kBase, 9, 0xE1), g_data_buf[9],
+              "Release() wrote back dirty page");
+    (void)inner.Release();
+  }
+
+  // === 测试 6: 顺序读取触发预读 ===
+  {
+    EXPECT_TRUE(cache.OpenReadOnly().has_value(), "Reopen cache read-only");
+    cache.SetReadAhead(kCachePages / 2);
+    EXPECT_EQ(static_cast<uint64_t>(kCachePages / 2),
+              static_cast<uint64_t>(cache.GetReadAheadWindow()),
+              "Read-ahead window set");
+    auto before = cache.GetStats();
+    bool match = true;
+    constexpr uint64_t kStream = kBase + kBlocks;
+    for (uint64_t b = kStream; b < kStream + kCachePages * 2; ++b) {
+      Memzero(g_data_buf, kSectorSize);
+      auto result =
+          cache.ReadBlock(b, std::span<uint8_t>(g_data_buf, kSectorSize));
+      match = match && result.has_value();
+    }
+    auto after = cache.GetStats();
+    EXPECT_TRUE(match, "Sequential reads succeed");
+    EXPECT_TRUE(after.readahead_blocks > before.readahead_blocks,
+                "Sequential stream issues read-ahead");
+    EXPECT_TRUE(after.readahead_hits > before.readahead_hits,
+                "Read-ahead blocks hit by later reads");
+    RiscvTraits::Log("Read-ahead: %u blocks, %u hits",
+                     static_cast<uint32_t>(after.readahead_blocks -
+                                           before.readahead_blocks),
+                     static_cast<uint32_t>(after.readahead_hits -
+                                           before.readahead_hits));
+
+    cache.SetReadAhead(0);
+    before = cache.GetStats();
+    for (uint64_t b = kBase; b < kBase + 4; ++b) {
+      (void)cache.ReadBlock(b, std::span<uint8_t>(g_data_buf, kSectorSize));
+    }
+    EXPECT_EQ(before.readahead_blocks, cache.GetStats().readahead_blocks,
+              "No read-ahead when disabled");
+    EXPECT_TRUE(cache.Release().has_value(), "Release() after read-ahead");
+  }
+
+  TEST_SUITE_END();
+}
@@ -0,0 +1,191 @@
+/**
+ * @file dma_buffer_pool_test.cpp
+ * @brief DMA 缓冲池测试
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 测试内容：
+ * 1. Create() / AddRegion() 参数校验与缓冲区切分
+ * 2. Alloc() / Free() 耗尽与复用、Translate() 地址查询
+ * 3. VirtioBlk::Read/Write 的 DmaBuffer 重载
+ * 4. VirtioBlkDevice 零拷贝 ReadBlocks/WriteBlocks 与异步提交
+ */
+
+#include <cstdint>
+
+#include "device_framework/dma_buffer_pool.hpp"
+#include "device_framework/virtio_blk.hpp"
+#include "test.h"
+#include "test_env.h"
+
+namespace {
+
+/// 测试缓冲池的缓冲区大小（8 个扇区）
+constexpr size_t kPoolBufferSize = 8 * kSectorSize;
+/// 测试缓冲池的缓冲区数量
+constexpr size_t kPoolBuffers = 4;
+
+/// 注册到缓冲池的 DMA 区域（故意多出半个缓冲区以测试尾部丢弃）
+alignas(4096) uint8_t g_pool_region[kPoolBuffers * kPoolBufferSize +
+                                    kPoolBufferSize / 2];
+
+using PoolType = device_framework::DmaBufferPool<RiscvTraits, 8>;
+
+}  // namespace
+
+void test_dma_buffer_pool() {
+  TEST_SUITE_BEGIN("DMA Buffer Pool");
+
+  // === 测试 1: Create() / AddRegion() ===
+  EXPECT_FALSE(PoolType::Create(0).has_value(), "Create() rejects size 0");
+  EXPECT_FALSE(PoolType::Create(kPoolBufferSize, 48).has_value(),
+               "Create() rejects non power-of-two alignment");
+  auto pool_result = PoolType::Create(kPoolBufferSize, 4096);
+  EXPECT_TRUE(pool_result.has_value(), "Create() succeeds");
+  if (!pool_result.has_value()) {
+    TEST_SUITE_END();
+    return;
+  }
+  auto& pool = *pool_result;
+  EXPECT_FALSE(pool.AddRegion(nullptr, kPoolBufferSize).has_value(),
+               "AddRegion() rejects null region");
+  auto added = pool.AddRegion(g_pool_region, sizeof(g_pool_region));
+  EXPECT_TRUE(added.has_value() && *added == kPoolBuffers,
+              "AddRegion() carves whole buffers only");
+  EXPECT_EQ(static_cast<uint64_t>(kPoolBuffers),
+            static_cast<uint64_t>(pool.GetFreeCount()),
+            "All buffers free after AddRegion()");
+
+  // === 测试 2: Alloc() / Free() / Translate() ===
+  {
+    device_framework::DmaBuffer bufs[kPoolBuffers];
+    bool all_ok = true;
+    bool aligned = true;
+    for (auto& buf : bufs) {
+      auto r = pool.Alloc();
+      all_ok = all_ok && r.has_value();
+      if (r.has_value()) {
+        buf = *r;
+        aligned = aligned && (buf.phys % 4096) == 0 &&
+                  buf.phys == RiscvTraits::VirtToPhys(buf.virt);
+      }
+    }
+    EXPECT_TRUE(all_ok, "Alloc() returns every buffer");
+    EXPECT_TRUE(aligned, "Buffers aligned with cached physical address");
+    auto empty = pool.Alloc();
+    EXPECT_TRUE(!empty.has_value() &&
+                    empty.error().code ==
+                        device_framework::ErrorCode::kOutOfMemory,
+                "Alloc() on empty pool returns kOutOfMemory");
+
+    auto phys = pool.Translate(bufs[1].virt + 100);
+    EXPECT_TRUE(phys.has_value() && *phys == bufs[1].phys + 100,
+                "Translate() uses cached region mapping");
+    EXPECT_FALSE(pool.Translate(g_data_buf).has_value(),
+                 "Translate() rejects unregistered address");
+
+    EXPECT_TRUE(pool.Free(bufs[2]).has_value(), "Free() succeeds");
+    auto again = pool.Alloc();
+    EXPECT_TRUE(again.has_value() && again->virt == bufs[2].virt,
+                "Freed buffer is reused");
+    for (auto& buf : bufs) {
+      (void)pool.Free(buf);
+    }
+    device_framework::DmaBuffer foreign{g_data_buf, 0, kSectorSize, 0};
+    EXPECT_FALSE(pool.Free(foreign).has_value(),
+                 "Free() rejects foreign buffer");
+  }
+
+  uint64_t blk_base = FindBlkDevice();
+  EXPECT_TRUE(blk_base != 0, "Find VirtIO block device");
+  if (blk_base == 0) {
+    LOG("No block device found, skipping remaining tests");
+    TEST_SUITE_END();
+    return;
+  }
+
+  // === 测试 3: VirtioBlk::Read/Write(DmaBuffer) ===
+  {
+    using VirtioBlkType =
+        device_framework::virtio::blk::VirtioBlk<RiscvTraits>;
+    Memzero(g_dma_buf, kDmaBufSize);
+    auto blk_result = VirtioBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(blk_result.has_value(), "VirtioBlk::Create() succeeds");
+    auto buf = pool.Alloc();
+    if (blk_result.has_value() && buf.has_value()) {
+      for (size_t i = 0; i < kSectorSize; ++i) {
+        buf->virt[i] = static_cast<uint8_t>(i ^ 0x5D);
+      }
+      EXPECT_TRUE(blk_result->Write(1000, *buf).has_value(),
+                  "Write(DmaBuffer) succeeds");
+      Memzero(buf->virt, kSectorSize);
+      EXPECT_TRUE(blk_result->Read(1000, *buf).has_value(),
+                  "Read(DmaBuffer) succeeds");
+      EXPECT_EQ(static_cast<uint8_t>(7 ^ 0x5D), buf->virt[7],
+                "Read(DmaBuffer) returns written data");
+      EXPECT_FALSE(blk_result->Read(1000, buf->Slice(0, 16)).has_value(),
+                   "Read(DmaBuffer) rejects short buffer");
+    }
+    if (buf.has_value()) {
+      (void)pool.Free(*buf);
+    }
+  }
+
+  // === 测试 4: VirtioBlkDevice 零拷贝读写 ===
+  {
+    using DeviceType =
+        device_framework::virtio::blk::VirtioBlkDevice<RiscvTraits>;
+    constexpr size_t kBlocks = kPoolBufferSize / kSectorSize;
+    constexpr uint64_t kBlock = 1008;
+    Memzero(g_dma_buf, DeviceType::CalcDmaSize());
+    auto dev_result = DeviceType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(dev_result.has_value(), "VirtioBlkDevice::Create() succeeds");
+    auto buf = pool.Alloc();
+    if (dev_result.has_value() && buf.has_value()) {
+      auto& dev = *dev_result;
+      (void)dev.OpenReadWrite();
+      for (size_t i = 0; i < kPoolBufferSize; ++i) {
+        buf->virt[i] = static_cast<uint8_t>((i * 3) ^ (i >> 9));
+      }
+      auto written = dev.WriteBlocks(kBlock, *buf, kBlocks);
+      EXPECT_TRUE(written.has_value() && *written == kBlocks,
+                  "WriteBlocks(DmaBuffer) succeeds");
+
+      Memzero(buf->virt, kPoolBufferSize);
+      auto read = dev.ReadBlocks(kBlock, *buf, kBlocks);
+      EXPECT_TRUE(read.has_value() && *read == kBlocks,
+                  "ReadBlocks(DmaBuffer) succeeds");
+      bool match = true;
+      for (size_t i = 0; i < kPoolBufferSize && match; ++i) {
+        match = buf->virt[i] == static_cast<uint8_t>((i * 3) ^ (i >> 9));
+      }
+      EXPECT_TRUE(match, "Zero-copy read returns written data");
+
+      Memzero(buf->virt, kPoolBufferSize);
+      int token = 0;
+      auto submit = dev.SubmitReadBlocks(kBlock, *buf, kBlocks, &token);
+      EXPECT_TRUE(submit.has_value(), "SubmitReadBlocks(DmaBuffer) succeeds");
+      device_framework::BlockCompletion completion{};
+      size_t reaped = 0;
+      for (uint32_t spin = 0; spin < 100000000 && reaped == 0; ++spin) {
+        reaped = dev.Reap({&completion, 1});
+      }
+      EXPECT_TRUE(reaped == 1 && completion.token == &token &&
+                      completion.status ==
+                          device_framework::ErrorCode::kSuccess &&
+                      completion.block_count == kBlocks,
+                  "Async zero-copy read completes");
+      EXPECT_EQ(static_cast<uint8_t>((700 * 3) ^ (700 >> 9)), buf->virt[700],
+                "Async zero-copy read returns written data");
+
+      EXPECT_FALSE(dev.ReadBlocks(kBlock, buf->Slice(0, kSectorSize), kBlocks)
+                       .has_value(),
+                   "ReadBlocks(DmaBuffer) rejects short buffer");
+      (void)dev.Release();
+    }
+    if (buf.has_value()) {
+      (void)pool.Free(*buf);
+    }
+  }
+
+  TEST_SUITE_END();
+}
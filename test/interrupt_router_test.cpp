@@ -0,0 +1,161 @@
+/**
+ * @file interrupt_router_test.cpp
+ * @brief 中断分发表测试
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 测试内容：
+ * 1. Attach() 参数校验与表满
+ * 2. 共享中断线上只调用挂起设备的完整处理
+ * 3. 合并阈值与 Flush() 兜底
+ * 4. Detach() 后不再分发
+ */
+
+#include "device_framework/interrupt_router.hpp"
+
+#include <cstdint>
+
+#include "device_framework/ns16550a.hpp"
+#include "device_framework/virtio_blk.hpp"
+#include "test.h"
+#include "test_env.h"
+
+namespace {
+
+/// 可控挂起状态的模拟设备
+struct FakeDevice {
+  bool pending = false;
+  uint32_t handled = 0;
+  uint32_t acked = 0;
+
+  auto HandleInterrupt() -> void {
+    pending = false;
+    ++handled;
+  }
+  [[nodiscard]] auto IsInterruptPending() const -> bool { return pending; }
+  auto AcknowledgeInterrupt() -> void {
+    pending = false;
+    ++acked;
+  }
+};
+
+/// 不提供挂起查询和确认的模拟设备
+struct PlainDevice {
+  uint32_t handled = 0;
+
+  auto HandleInterrupt() -> void { ++handled; }
+};
+
+using RouterType = device_framework::InterruptRouter<16, 4>;
+
+// 驱动层的挂起查询与确认接口
+static_assert(device_framework::InterruptPendingQuery<
+              device_framework::virtio::blk::VirtioBlk<RiscvTraits>>);
+static_assert(device_framework::InterruptAcknowledge<
+              device_framework::virtio::blk::VirtioBlk<RiscvTraits>>);
+static_assert(device_framework::InterruptPendingQuery<
+              device_framework::detail::ns16550a::Ns16550a>);
+static_assert(!device_framework::InterruptAcknowledge<
+              device_framework::detail::ns16550a::Ns16550a>);
+
+}  // namespace
+
+void test_interrupt_router() {
+  TEST_SUITE_BEGIN("Interrupt Router");
+
+  // === 测试 1: Attach() 参数校验与表满 ===
+  {
+    RouterType router;
+    FakeDevice dev;
+    PlainDevice plain;
+    EXPECT_FALSE(router.Attach(16, dev).has_value(),
+                 "Attach() rejects IRQ beyond MaxIrqs");
+    EXPECT_FALSE(router.Attach(1, dev, 0).has_value(),
+                 "Attach() rejects coalesce threshold 0");
+    EXPECT_FALSE(router.Attach(1, device_framework::InterruptSource{})
+                     .has_value(),
+                 "Attach() rejects source without handler");
+    auto no_ack = router.Attach(1, plain, 4);
+    EXPECT_TRUE(!no_ack.has_value() &&
+                    no_ack.error().code ==
+                        device_framework::ErrorCode::kNotSupported,
+                "Coalescing requires AcknowledgeInterrupt()");
+    size_t attached = 0;
+    for (size_t i = 0; i < 5; ++i) {
+      attached += router.Attach(2, dev).has_value() ? 1 : 0;
+    }
+    EXPECT_EQ(4u, attached, "Attach() stops at MaxSources");
+  }
+
+  // === 测试 2: 共享中断线上只处理挂起设备 ===
+  {
+    RouterType router;
+    FakeDevice devs[3];
+    PlainDevice plain;
+    for (auto& dev : devs) {
+      (void)router.Attach(5, dev);
+    }
+    (void)router.Attach(6, plain);
+
+    devs[1].pending = true;
+    EXPECT_EQ(1u, router.Dispatch(5), "Only the pending device is handled");
+    EXPECT_TRUE(devs[0].handled == 0 && devs[1].handled == 1 &&
+                    devs[2].handled == 0,
+                "Idle devices on the shared line are skipped");
+    EXPECT_EQ(0u, router.Dispatch(5), "Spurious interrupt handles nothing");
+    EXPECT_EQ(1u, router.Dispatch(6),
+              "Device without pending query is always handled");
+    EXPECT_EQ(0u, router.Dispatch(7), "Unrouted IRQ handles nothing");
+  }
+
+  // === 测试 3: 合并阈值与 Flush() ===
+  {
+    RouterType router;
+    FakeDevice dev;
+    auto handle = router.Attach(3, dev, 3);
+    EXPECT_TRUE(handle.has_value(), "Attach() with coalesce threshold");
+    if (handle.has_value()) {
+      dev.pending = true;
+      (void)router.Dispatch(3);
+      dev.pending = true;
+      (void)router.Dispatch(3);
+      EXPECT_TRUE(dev.handled == 0 && dev.acked == 2,
+                  "Interrupts below the threshold are only acknowledged");
+      EXPECT_EQ(2u, router.GetDeferred(*handle), "Deferred count tracked");
+      dev.pending = true;
+      (void)router.Dispatch(3);
+      EXPECT_TRUE(dev.handled == 1 && router.GetDeferred(*handle) == 0,
+                  "Reaching the threshold runs the full handler");
+
+      dev.pending = true;
+      (void)router.Dispatch(3);
+      EXPECT_EQ(1u, router.Flush(), "Flush() handles deferred work");
+      EXPECT_EQ(2u, dev.handled, "Flushed device handled once");
+      EXPECT_EQ(0u, router.Flush(), "Nothing left to flush");
+    }
+  }
+
+  // === 测试 4: Detach() ===
+  {
+    RouterType router;
+    FakeDevice first;
+    FakeDevice second;
+    auto h1 = router.Attach(4, first);
+    auto h2 = router.Attach(4, second);
+    EXPECT_TRUE(h1.has_value() && h2.has_value(), "Two devices on one IRQ");
+    if (h1.has_value() && h2.has_value()) {
+      EXPECT_TRUE(router.Detach(*h1).has_value(), "Detach() succeeds");
+      EXPECT_FALSE(router.Detach(*h1).has_value(),
+                   "Detach() rejects a stale handle");
+      first.pending = true;
+      second.pending = true;
+      EXPECT_EQ(1u, router.Dispatch(4), "Detached device no longer handled");
+      EXPECT_TRUE(first.handled == 0 && second.handled == 1,
+                  "Remaining device still dispatched");
+      auto again = router.Attach(4, first);
+      EXPECT_TRUE(again.has_value() && *again == *h1,
+                  "Freed slot is reused");
+    }
+  }
+
+  TEST_SUITE_END();
+}
@@ -26,6 +26,15 @@ void test_main(uint32_t hart_id, uint8_t* dtb) {
   test_virtio_mmio_device_status();
   test_virtio_blk();
   test_virtio_blk_device();
+  test_block_cache();
+  test_dma_buffer_pool();
+  test_interrupt_router();
+  test_virtio_pci_transport();
+  test_virtio_net();
+  test_virtio_console();
+  test_virtio_gpu();
+  test_virtio_input();
+  test_acpi();
 
   test_print_summary();
 }
@@ -5,6 +5,7 @@
  */
 
 #include <cstdint>
+#include <span>
 
 #include "device_framework/virtio_blk.hpp"
 #include "test.h"
@@ -102,6 +103,18 @@ void test_virtio_mmio_device_status() {
       EXPECT_TRUE(vendor_id != 0, "Vendor ID should not be 0");
     }
 
+    // 测试 4b: 以 32 位块读取标识寄存器（Magic/Version/DeviceID/VendorID）
+    {
+      uint32_t ident[4] = {};
+      device_framework::detail::MmioAccessor(base).ReadBlock<sizeof(uint32_t)>(
+          transport.MmioReg::kMagicValue,
+          std::span(reinterpret_cast<uint8_t*>(ident), sizeof(ident)));
+      EXPECT_TRUE(ident[0] == device_framework::virtio::kMmioMagicValue &&
+                      ident[2] == transport.GetDeviceId() &&
+                      ident[3] == transport.GetVendorId(),
+                  "ReadBlock<4> matches individual register reads");
+    }
+
     // 测试 5: 读取初始状态（应该为 0）
     {
       auto initial_status = transport.GetStatus();
@@ -141,10 +154,55 @@ void test_virtio_mmio_device_status() {
       auto queue_max = transport.GetQueueNumMax(0);
       LOG_HEX("  Queue 0 max size", queue_max);
     }
+
+    // 测试 9: 队列状态缓存（运行期查询不再访问 QueueSel）
+    {
+      auto queue_max = transport.GetQueueNumMax(0);
+      EXPECT_EQ(queue_max, transport.GetQueueNumMax(0),
+                "Cached QueueNumMax matches the register");
+      EXPECT_FALSE(transport.GetQueueReady(0),
+                   "Queue 0 is not ready after reset");
+    }
   }
 
   EXPECT_TRUE(devices_found > 0, "Should find at least one VirtIO MMIO device");
   LOG_HEX("Total devices found", devices_found);
 
+  // 测试 10: VirtioMmioBus 一次扫描的结果与逐槽位探测一致
+  {
+    using Bus = device_framework::virtio::VirtioMmioBus<RiscvTraits>;
+    auto bus = Bus::Scan(kVirtioMmioBase, kVirtioMmioSize, kMaxVirtioDevices);
+    EXPECT_EQ(static_cast<size_t>(devices_found), bus.Devices().size(),
+              "Bus scan finds the same devices");
+    bool layout_ok = true;
+    for (const auto& info : bus.Devices()) {
+      layout_ok = layout_ok &&
+                  info.base == kVirtioMmioBase + info.slot * kVirtioMmioSize &&
+                  info.device_id != 0;
+    }
+    EXPECT_TRUE(layout_ok, "Bus entries carry slot, base and device ID");
+    EXPECT_EQ(static_cast<uint64_t>(FindBlkDevice()),
+              bus.Find(kBlockDeviceId).has_value()
+                  ? bus.Find(kBlockDeviceId)->base
+                  : 0,
+              "Find() locates the block device");
+    EXPECT_FALSE(bus.Find(kBlockDeviceId, bus.Count(kBlockDeviceId))
+                     .has_value(),
+                 "Find() past the last device of a type fails");
+
+    // 单核探测：认领全部表项，回调只接管块设备
+    size_t visited = 0;
+    auto bound = bus.Probe([&visited](const auto& info) {
+      ++visited;
+      return info.device_id == kBlockDeviceId;
+    });
+    EXPECT_EQ(bus.Devices().size(), visited, "Probe() visits every device");
+    EXPECT_EQ(bus.Count(kBlockDeviceId), bound,
+              "Probe() counts devices taken by a driver");
+    EXPECT_TRUE(bus.IsProbeComplete(), "Probe completes");
+    EXPECT_EQ(0u, bus.Probe([](const auto&) { return true; }),
+              "Claimed devices are not probed twice");
+  }
+
   TEST_SUITE_END();
 }
@@ -4,7 +4,10 @@
  * @copyright Copyright The device_framework Contributors
  *
  * 测试 NS16550A 通过统一 CharDevice 接口的操作：
- * Open/PutChar/Write/Poll/Release 及错误路径
+ * Open/PutChar/Write/Poll/Release 及错误路径，
+ * 以及中断驱动的 Ns16550aBufferedDevice（RX/TX 环形缓冲区）
+ * 和驱动的 WriteBurst/ReadBurst 批量收发、Ioctl 运行时配置、
+ * 中断驱动的就绪通知（含采样与中断交错时不丢失唤醒）
  */
 
 #include "device_framework/ns16550a.hpp"
@@ -245,5 +248,233 @@ void test_ns16550a() {
                  "IsInterruptPending() reports no pending in idle state");
   }
 
+  // === 测试 16: Ns16550aBufferedDevice 写入立即返回，中断补充发送 ===
+  {
+    using BufferedType = device_framework::ns16550a::Ns16550aBufferedDevice<>;
+    auto uart_result = BufferedType::Create(kUartBase);
+    EXPECT_TRUE(uart_result.has_value(), "Ns16550aBufferedDevice::Create()");
+    if (uart_result.has_value()) {
+      auto& uart = *uart_result;
+      EXPECT_TRUE(uart.OpenReadWrite().has_value(),
+                  "Buffered OpenReadWrite() succeeds");
+      const uint8_t msg[] = "buffered uart: queued without busy-wait\n";
+      auto write_result =
+          uart.Write(std::span<const uint8_t>(msg, sizeof(msg) - 1));
+      EXPECT_TRUE(write_result.has_value() && *write_result == sizeof(msg) - 1,
+                  "Buffered Write() queues the whole message");
+
+      // 未接入 UART 中断时以轮询方式调用中断处理程序补充发送 FIFO
+      for (uint32_t spin = 0; spin < 1000000 && uart.GetTxPending() != 0;
+           ++spin) {
+        uart.HandleInterrupt();
+      }
+      EXPECT_EQ(static_cast<uint64_t>(0),
+                static_cast<uint64_t>(uart.GetTxPending()),
+                "HandleInterrupt() drains the TX ring");
+
+      auto poll_result = uart.Poll(device_framework::PollEvents{
+          device_framework::PollEvents::kOut});
+      EXPECT_TRUE(poll_result.has_value() && poll_result->HasOut(),
+                  "Buffered Poll reports TX ring space");
+      EXPECT_TRUE(uart.Release().has_value(), "Buffered Release() succeeds");
+    }
+  }
+
+  // === 测试 17: Ns16550aBufferedDevice TX 环满时部分写入 ===
+  {
+    using SmallType =
+        device_framework::ns16550a::Ns16550aBufferedDevice<16, 16>;
+    auto uart_result = SmallType::Create(kUartBase);
+    if (uart_result.has_value()) {
+      auto& uart = *uart_result;
+      (void)uart.OpenReadWrite();
+      uint8_t line[40];
+      for (size_t i = 0; i < sizeof(line); ++i) {
+        line[i] = static_cast<uint8_t>('a' + i % 26);
+      }
+      line[sizeof(line) - 1] = '\n';
+      auto write_result = uart.Write(std::span<const uint8_t>(line));
+      EXPECT_TRUE(write_result.has_value() && *write_result < sizeof(line),
+                  "Write() larger than the TX ring is partial");
+      // Release() 同步排空 TX 环
+      EXPECT_TRUE(uart.Release().has_value(), "Release() drains the TX ring");
+      EXPECT_EQ(static_cast<uint64_t>(0),
+                static_cast<uint64_t>(uart.GetTxPending()),
+                "No bytes pending after Release()");
+    }
+  }
+
+  // === 测试 18: Ns16550aBufferedDevice 从 RX 环读取 ===
+  {
+    auto uart_result =
+        device_framework::ns16550a::Ns16550aBufferedDevice<>::Create(kUartBase);
+    if (uart_result.has_value()) {
+      auto& uart = *uart_result;
+      (void)uart.OpenReadWrite();
+      uart.HandleInterrupt();
+      uint8_t buf[8];
+      auto read_result = uart.Read(std::span<uint8_t>(buf));
+      EXPECT_TRUE(read_result.has_value() && *read_result <= sizeof(buf),
+                  "Buffered Read() returns bytes from the RX ring");
+      EXPECT_EQ(static_cast<uint64_t>(0), uart.GetRxDropped(),
+                "No RX bytes dropped");
+      (void)uart.Release();
+    }
+  }
+
+  // === 测试 19: 驱动 WriteBurst/ReadBurst 按 FIFO 块收发 ===
+  {
+    auto uart_result =
+        device_framework::ns16550a::Ns16550aBufferedDevice<>::Create(kUartBase);
+    if (uart_result.has_value()) {
+      auto& driver = uart_result->GetDriver();
+      const char msg[] = "[burst] 0123456789abcdefghij\n";
+      auto data = std::span<const uint8_t>(
+          reinterpret_cast<const uint8_t*>(msg), sizeof(msg) - 1);
+      size_t written = 0;
+      size_t bursts = 0;
+      while (written < data.size()) {
+        size_t n = driver.WriteBurst(data.subspan(written));
+        EXPECT_TRUE(n <= device_framework::detail::ns16550a::Ns16550a::
+                             kFifoDepth,
+                    "WriteBurst() writes at most one FIFO");
+        written += n;
+        bursts += n != 0 ? 1 : 0;
+      }
+      EXPECT_TRUE(bursts >= 2, "Message longer than the FIFO needs bursts");
+      uint8_t buf[4];
+      EXPECT_TRUE(driver.ReadBurst(std::span<uint8_t>(buf)) <= sizeof(buf),
+                  "ReadBurst() respects the buffer size");
+      EXPECT_EQ(static_cast<uint64_t>(0),
+                static_cast<uint64_t>(driver.ReadBurst(std::span<uint8_t>())),
+                "ReadBurst() into an empty buffer reads nothing");
+    }
+  }
+
+  // === 测试 20: Ioctl 读取与应用 UartConfig ===
+  {
+    auto uart_result = device_framework::ns16550a::Ns16550aDevice::Create(
+        kUartBase);
+    if (uart_result.has_value()) {
+      auto& uart = *uart_result;
+      (void)uart.OpenReadWrite();
+      device_framework::UartConfig config{};
+      auto get_result = uart.Ioctl(device_framework::UartIoctl::kGetConfig,
+                                   reinterpret_cast<uintptr_t>(&config));
+      EXPECT_TRUE(get_result.has_value() && config.rx_trigger == 1 &&
+                      config.data_bits == 8,
+                  "kGetConfig reports the Create() defaults");
+      EXPECT_FALSE(
+          uart.Ioctl(device_framework::UartIoctl::kGetConfig, 0).has_value(),
+          "kGetConfig rejects a null config");
+
+      config.rx_trigger = 10;
+      auto set_result = uart.Ioctl(device_framework::UartIoctl::kSetConfig,
+                                   reinterpret_cast<uintptr_t>(&config));
+      EXPECT_TRUE(set_result.has_value() && config.rx_trigger == 8,
+                  "kSetConfig rounds the RX trigger down to a FIFO level");
+
+      auto bad = config;
+      bad.data_bits = 9;
+      EXPECT_FALSE(uart.Ioctl(device_framework::UartIoctl::kSetConfig,
+                              reinterpret_cast<uintptr_t>(&bad))
+                       .has_value(),
+                   "kSetConfig rejects an invalid word format");
+      bad = config;
+      bad.baud_rate = 3000000;
+      bad.clock = device_framework::detail::ns16550a::Ns16550a::kDefaultClock;
+      EXPECT_FALSE(uart.Ioctl(device_framework::UartIoctl::kSetConfig,
+                              reinterpret_cast<uintptr_t>(&bad))
+                       .has_value(),
+                   "kSetConfig rejects an unreachable baud rate");
+
+      config.rx_trigger = 1;
+      (void)uart.Ioctl(device_framework::UartIoctl::kSetConfig,
+                       reinterpret_cast<uintptr_t>(&config));
+      (void)uart.Release();
+    }
+  }
+
+  // === 测试 21: 就绪通知由中断处理触发 ===
+  {
+    auto uart_result =
+        device_framework::ns16550a::Ns16550aBufferedDevice<>::Create(kUartBase);
+    if (uart_result.has_value()) {
+      auto& uart = *uart_result;
+      (void)uart.OpenReadWrite();
+      uint32_t wakeups = 0;
+      auto on_ready = [](void* context, device_framework::PollEvents ready) {
+        if (ready.HasOut()) {
+          ++*static_cast<uint32_t*>(context);
+        }
+      };
+      auto handle = uart.RegisterPollWaiter(
+          device_framework::PollEvents{device_framework::PollEvents::kOut},
+          on_ready, &wakeups);
+      EXPECT_TRUE(handle.has_value(), "RegisterPollWaiter() succeeds");
+      EXPECT_EQ(0u, wakeups, "No wakeup before readiness is reported");
+
+      uart.HandleInterrupt();
+      EXPECT_EQ(1u, wakeups, "Interrupt reports kOut and wakes the waiter");
+      EXPECT_TRUE(uart.GetPollReady().HasOut(), "Readiness is cached");
+      uart.HandleInterrupt();
+      EXPECT_EQ(1u, wakeups, "Unchanged readiness does not wake again");
+
+      EXPECT_FALSE(uart.RegisterPollWaiter(device_framework::PollEvents{},
+                                           on_ready, &wakeups)
+                       .has_value(),
+                   "RegisterPollWaiter() rejects an empty mask");
+      if (handle.has_value()) {
+        EXPECT_TRUE(uart.UnregisterPollWaiter(*handle).has_value(),
+                    "UnregisterPollWaiter() succeeds");
+        EXPECT_FALSE(uart.UnregisterPollWaiter(*handle).has_value(),
+                     "UnregisterPollWaiter() rejects a stale handle");
+      }
+      (void)uart.Release();
+    }
+  }
+
+  // === 测试 22: 采样与发布之间的中断更新不被过期采样覆盖 ===
+  {
+    using device_framework::PollEvents;
+    device_framework::PollNotifier notifier;
+    uint32_t wakeups = 0;
+    auto on_ready = [](void* context, PollEvents) {
+      ++*static_cast<uint32_t*>(context);
+    };
+    (void)notifier.Register(PollEvents{PollEvents::kIn}, on_ready, &wakeups);
+
+    // 读者采样到 RX 为空后、发布前，中断存入数据并报告 kIn
+    uint32_t samples = 0;
+    bool rx_empty = true;
+    auto sample = [&] {
+      ++samples;
+      PollEvents ready{rx_empty ? 0U : PollEvents::kIn};
+      if (rx_empty) {
+        rx_empty = false;
+        notifier.Update(PollEvents{PollEvents::kIn});
+      }
+      return ready;
+    };
+    PollEvents published = notifier.Refresh(sample);
+    EXPECT_EQ(2u, samples, "Refresh() resamples after a concurrent update");
+    EXPECT_TRUE(published.HasIn() && notifier.Cached().HasIn(),
+                "Concurrent kIn is not cleared by a stale sample");
+    EXPECT_EQ(1u, wakeups, "Interrupt update woke the waiter once");
+
+    // 中断写回与旧缓存相同的值（ABA）时同样重新采样
+    samples = 0;
+    auto stale_same = [&] {
+      if (samples++ == 0) {
+        notifier.Update(PollEvents{PollEvents::kIn});
+        return PollEvents{};
+      }
+      return PollEvents{PollEvents::kIn};
+    };
+    (void)notifier.Refresh(stale_same);
+    EXPECT_EQ(2u, samples, "Refresh() detects an update to the same value");
+    EXPECT_TRUE(notifier.Cached().HasIn(), "kIn survives the ABA update");
+  }
+
   TEST_SUITE_END();
 }
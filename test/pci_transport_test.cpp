@@ -0,0 +1,202 @@
+/**
+ * @file pci_transport_test.cpp
+ * @brief VirtIO PCI 传输层测试
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 测试内容：
+ * 1. 在 ECAM 中查找 virtio-blk-pci 并分配 BAR
+ * 2. capability 解析与设备识别
+ * 3. MSI-X 表大小与表项参数校验
+ * 4. PciConfigAccessor 枚举与 VirtioPciBus 缓存布局构造传输层
+ * 5. VirtioBlk<Traits, PciTransport>::Create() 与队列向量映射
+ * 6. 经 PCI 传输层的扇区读写
+ */
+
+#include "device_framework/detail/virtio/transport/pci.hpp"
+
+#include "device_framework/detail/pci_config_accessor.hpp"
+
+#include <cstdint>
+
+#include "device_framework/virtio_blk.hpp"
+#include "test.h"
+#include "test_env.h"
+
+namespace {
+
+/// QEMU virt 机器 PCIe ECAM 基地址
+constexpr uint64_t kPcieEcamBase = 0x30000000;
+/// QEMU virt 机器 PCIe 32 位 MMIO 窗口基地址
+constexpr uint64_t kPcieMmioBase = 0x40000000;
+/// 总线 0 上扫描的设备数
+constexpr uint32_t kPcieMaxDevices = 32;
+/// Modern virtio-blk-pci 的 PCI Device ID
+constexpr uint16_t kVirtioBlkPciDeviceId = 0x1042;
+
+/**
+ * @brief 为 function 的内存 BAR 分配地址
+ *
+ * 裸机环境下没有固件代为分配 BAR，测试按 BAR 大小自然对齐依次分配。
+ *
+ * @param cfg function 的 ECAM 配置空间地址
+ * @param next 下一个可用的 MMIO 地址（分配后前移）
+ */
+void AssignBars(uint64_t cfg, uint64_t& next) {
+  for (uint32_t bar = 0; bar < 6; ++bar) {
+    auto* reg = reinterpret_cast<volatile uint32_t*>(cfg + 0x10 + bar * 4);
+    uint32_t orig = reg[0];
+    if ((orig & 0x1) != 0) {
+      continue;
+    }
+    bool is_64bit = ((orig >> 1) & 0x3) == 0x2;
+
+    reg[0] = 0xFFFFFFFF;
+    uint64_t mask = reg[0] & ~0xFULL;
+    if (is_64bit) {
+      reg[1] = 0xFFFFFFFF;
+      mask |= static_cast<uint64_t>(reg[1]) << 32;
+    } else if (mask != 0) {
+      mask |= 0xFFFFFFFF00000000ULL;
+    }
+    if (mask == 0) {
+      reg[0] = 0;
+      continue;
+    }
+
+    uint64_t size = ~mask + 1;
+    next = (next + size - 1) & ~(size - 1);
+    reg[0] = static_cast<uint32_t>(next);
+    if (is_64bit) {
+      reg[1] = static_cast<uint32_t>(next >> 32);
+      ++bar;
+    }
+    next += size;
+  }
+}
+
+/**
+ * @brief 在总线 0 上查找 virtio-blk-pci
+ * @return function 的 ECAM 配置空间地址，未找到返回 0
+ */
+auto FindBlkPciDevice() -> uint64_t {
+  for (uint32_t dev = 0; dev < kPcieMaxDevices; ++dev) {
+    uint64_t cfg = kPcieEcamBase + (static_cast<uint64_t>(dev) << 15);
+    auto vendor = *reinterpret_cast<volatile uint16_t*>(cfg);
+    auto device = *reinterpret_cast<volatile uint16_t*>(cfg + 2);
+    if (vendor == device_framework::virtio::kPciVendorVirtio &&
+        device == kVirtioBlkPciDeviceId) {
+      return cfg;
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+
+void test_virtio_pci_transport() {
+  TEST_SUITE_BEGIN("VirtIO PCI Transport");
+
+  // === 测试 1: 查找设备并分配 BAR ===
+  uint64_t cfg = FindBlkPciDevice();
+  EXPECT_TRUE(cfg != 0, "Find virtio-blk-pci on PCIe bus 0");
+  if (cfg == 0) {
+    LOG("No virtio-blk-pci device found, skipping remaining tests");
+    TEST_SUITE_END();
+    return;
+  }
+  LOG_HEX("virtio-blk-pci config space at", cfg);
+  uint64_t next_mmio = kPcieMmioBase;
+  AssignBars(cfg, next_mmio);
+
+  // === 测试 2: capability 解析与设备识别 ===
+  {
+    device_framework::virtio::PciTransport<RiscvTraits> transport(cfg);
+    EXPECT_TRUE(transport.IsValid(), "PciTransport finds all capabilities");
+    EXPECT_EQ(kBlockDeviceId, transport.GetDeviceId(),
+              "Device ID derived from PCI Device ID");
+    EXPECT_EQ(0U, transport.GetStatus(), "Device status is 0 after reset");
+    EXPECT_TRUE(transport.GetQueueNumMax(0) > 0, "Queue 0 is available");
+
+    // === 测试 3: MSI-X ===
+    uint32_t vectors = transport.GetMsixTableSize();
+    LOG_HEX("MSI-X table size", vectors);
+    EXPECT_TRUE(vectors > 0, "virtio-blk-pci exposes MSI-X");
+    EXPECT_FALSE(transport.SetMsixEntry(vectors, 0, 0).has_value(),
+                 "SetMsixEntry() rejects vector beyond table size");
+    EXPECT_FALSE(transport.UsesQueueVectors(),
+                 "Queue vectors unused until MSI-X is enabled");
+  }
+
+  // === 测试 4: ECAM 枚举与缓存布局 ===
+  {
+    device_framework::detail::PciConfigAccessor ecam(kPcieEcamBase, 0, 0);
+    EXPECT_EQ(cfg, ecam.Function(0, static_cast<uint8_t>((cfg >> 15) & 0x1F),
+                                 0)
+                       .base(),
+              "ECAM function address matches bus 0 probe");
+    EXPECT_EQ(0ULL, ecam.Function(1, 0, 0).base(),
+              "Bus outside ECAM window rejected");
+    size_t functions = ecam.ForEachFunction(
+        [](uint8_t, uint8_t, uint8_t, device_framework::detail::MmioAccessor) {
+        });
+    EXPECT_TRUE(functions > 0, "ForEachFunction finds functions on bus 0");
+
+    auto bus = device_framework::virtio::VirtioPciBus<RiscvTraits>::Scan(ecam);
+    auto info = bus.Find(kBlockDeviceId);
+    EXPECT_TRUE(info.has_value(), "VirtioPciBus finds virtio-blk-pci");
+    if (info.has_value()) {
+      EXPECT_EQ(cfg, info->ecam, "Cached ECAM address");
+      EXPECT_TRUE(info->layout.IsComplete(), "Cached layout is complete");
+      auto transport = bus.CreateTransport(*info);
+      EXPECT_TRUE(transport.IsValid(), "PciTransport from cached layout");
+      EXPECT_EQ(kBlockDeviceId, transport.GetDeviceId(),
+                "Device ID from cached layout");
+      EXPECT_TRUE(transport.GetQueueNumMax(0) > 0,
+                  "Queue 0 available via cached layout");
+    }
+  }
+
+  // === 测试 5: VirtioBlk over PCI ===
+  using PciBlkType =
+      device_framework::virtio::blk::VirtioBlk<RiscvTraits,
+                                               device_framework::virtio::
+                                                   PciTransport>;
+  Memzero(g_dma_buf, PciBlkType::CalcDmaSize());
+  auto blk_result = PciBlkType::Create(cfg, g_dma_buf, 1, 128);
+  EXPECT_TRUE(blk_result.has_value(), "VirtioBlk<PciTransport>::Create()");
+  if (!blk_result.has_value()) {
+    TEST_SUITE_END();
+    return;
+  }
+  auto& blk = *blk_result;
+  EXPECT_TRUE(blk.GetCapacity() > 0, "Capacity read from device config");
+  if (blk.GetTransport().GetMsixTableSize() > 1) {
+    EXPECT_EQ(1U, blk.GetTransport().GetQueueMsixVector(0),
+              "Queue 0 mapped to its own MSI-X vector");
+  }
+  if (blk.GetTransport().GetMsixTableSize() != 0) {
+    EXPECT_EQ(0U, blk.GetTransport().GetConfigMsixVector(),
+              "Config vector survives the reset in device initialization");
+  }
+
+  // === 测试 6: 扇区读写 ===
+  {
+    for (size_t i = 0; i < kSectorSize; ++i) {
+      g_data_buf[i] = static_cast<uint8_t>(i ^ 0x5A);
+    }
+    auto write_result = blk.Write(1, g_data_buf);
+    EXPECT_TRUE(write_result.has_value(), "Write sector over PCI");
+
+    Memzero(g_data_buf, kSectorSize);
+    auto read_result = blk.Read(1, g_data_buf);
+    EXPECT_TRUE(read_result.has_value(), "Read sector over PCI");
+
+    bool match = true;
+    for (size_t i = 0; i < kSectorSize; ++i) {
+      match = match && g_data_buf[i] == static_cast<uint8_t>(i ^ 0x5A);
+    }
+    EXPECT_TRUE(match, "Data read back over PCI matches");
+  }
+
+  TEST_SUITE_END();
+}
@@ -12,6 +12,8 @@
 
 // Freestanding 环境需要的编译器内建函数
 // GCC/Clang 优化器在处理大型结构体拷贝时可能生成 memcpy/memset 调用
+// （宿主机构建由 libc 提供）
+#ifndef DEVICE_FRAMEWORK_HOSTED
 extern "C" {
 void* memcpy(void* dest, const void* src, size_t n) {
   auto* d = static_cast<uint8_t*>(dest);
@@ -30,6 +32,7 @@ void* memset(void* dest, int c, size_t n) {
   return dest;
 }
 }
+#endif
 
 TestStats g_suite_stats = {0, 0, 0};
 TestStats g_global_stats = {0, 0, 0};
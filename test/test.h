@@ -203,6 +203,15 @@ void test_ns16550a();
 void test_virtio_mmio_device_status();
 void test_virtio_blk();
 void test_virtio_blk_device();
+void test_block_cache();
+void test_dma_buffer_pool();
+void test_interrupt_router();
+void test_virtio_pci_transport();
+void test_virtio_net();
+void test_virtio_console();
+void test_virtio_gpu();
+void test_virtio_input();
+void test_acpi();
 
 /// @}
 
@@ -16,23 +16,15 @@ void operator delete(void*, size_t) noexcept {}
 alignas(4096) uint8_t g_dma_buf[kDmaBufSize];
 alignas(16) uint8_t g_data_buf[kSectorSize];
 alignas(16) uint8_t g_multi_buf[kMultiBufSectors * kSectorSize];
+alignas(4096) uint8_t g_large_buf[kLargeBufSectors * kSectorSize];
 
 /// @}
 
 auto FindBlkDevice() -> uint64_t {
-  for (int i = 0; i < kMaxVirtioDevices; ++i) {
-    uint64_t base = kVirtioMmioBase + i * kVirtioMmioSize;
-    auto magic = *reinterpret_cast<volatile uint32_t*>(base);
-    if (magic != device_framework::virtio::kMmioMagicValue) {
-      continue;
-    }
-    auto device_id = *reinterpret_cast<volatile uint32_t*>(
-        base + device_framework::virtio::MmioTransport<>::MmioReg::kDeviceId);
-    if (device_id == kBlockDeviceId) {
-      return base;
-    }
-  }
-  return 0;
+  auto bus = device_framework::virtio::VirtioMmioBus<RiscvTraits>::Scan(
+      kVirtioMmioBase, kVirtioMmioSize, kMaxVirtioDevices);
+  auto blk = bus.Find(kBlockDeviceId);
+  return blk.has_value() ? blk->base : 0;
 }
 
 void Memzero(void* ptr, size_t len) {
@@ -41,3 +33,15 @@ void Memzero(void* ptr, size_t len) {
     p[i] = 0;
   }
 }
+
+auto ReadCycleCounter() -> uint64_t {
+  uint64_t cycles;
+  asm volatile("rdcycle %0" : "=r"(cycles));
+  return cycles;
+}
+
+auto ReadTimeCounter() -> uint64_t {
+  uint64_t ticks;
+  asm volatile("rdtime %0" : "=r"(ticks));
+  return ticks;
+}
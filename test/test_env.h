@@ -27,9 +27,13 @@ constexpr uint32_t kBlockDeviceId = 2;
 /// 扇区大小
 constexpr size_t kSectorSize = 512;
 /// DMA 缓冲区大小
-constexpr size_t kDmaBufSize = 32768;
+constexpr size_t kDmaBufSize = 262144;
 /// 多扇区缓冲区的扇区数
 constexpr size_t kMultiBufSectors = 4;
+/// 大块传输缓冲区的扇区数（256KB，跨越多个请求）
+constexpr size_t kLargeBufSectors = 512;
+/// QEMU virt 机器的 timebase-frequency（rdtime 计数频率，Hz）
+constexpr uint64_t kTimebaseFrequency = 10000000;
 
 /// @}
 
@@ -75,6 +79,8 @@ extern uint8_t g_dma_buf[kDmaBufSize];
 extern uint8_t g_data_buf[kSectorSize];
 /// 多扇区数据缓冲区（16 字节对齐）
 extern uint8_t g_multi_buf[kMultiBufSectors * kSectorSize];
+/// 大块传输数据缓冲区（4096 字节对齐）
+extern uint8_t g_large_buf[kLargeBufSectors * kSectorSize];
 
 /// @}
 
@@ -94,6 +100,18 @@ auto FindBlkDevice() -> uint64_t;
  */
 void Memzero(void* ptr, size_t len);
 
+/**
+ * @brief 读取周期计数器（rdcycle）
+ * @return 当前周期计数
+ */
+auto ReadCycleCounter() -> uint64_t;
+
+/**
+ * @brief 读取实时计数器（rdtime，频率为 kTimebaseFrequency）
+ * @return 当前计数
+ */
+auto ReadTimeCounter() -> uint64_t;
+
 /// @}
 
 #endif /* DEVICE_FRAMEWORK_TEST_TEST_ENV_H_ */
@@ -4,8 +4,9 @@
  * @copyright Copyright The device_framework Contributors
  *
  * 测试 VirtIO 块设备通过统一 BlockDevice 接口的操作：
- * Open/ReadBlock/WriteBlock/ReadBlocks/WriteBlocks/Read/Write/Release
- * 及错误路径
+ * Open/ReadBlock/WriteBlock/ReadBlocks/WriteBlocks/Read/Write/Release、
+ * 异步 Submit/Reap 接口及错误路径、异步请求在途时移动设备对象、
+ * Readv/Writev 分散-聚集读写、异步完成的就绪通知、块大小与 I/O 提示
  */
 
 #include <cstdint>
@@ -82,6 +83,24 @@ void test_virtio_blk_device() {
     EXPECT_EQ(static_cast<uint64_t>(512), static_cast<uint64_t>(block_size),
               "GetBlockSize() returns 512");
 
+    using device_framework::virtio::blk::BlkFeatureBit;
+    const auto& config = dev.GetDriver().ReadConfig();
+    auto features = dev.GetDriver().GetNegotiatedFeatures();
+    if ((features & static_cast<uint64_t>(BlkFeatureBit::kBlkSize)) != 0) {
+      EXPECT_EQ(static_cast<uint64_t>(config.blk_size),
+                static_cast<uint64_t>(block_size),
+                "GetBlockSize() honors negotiated blk_size");
+    }
+    auto hints = dev.GetIoHints();
+    if ((features & static_cast<uint64_t>(BlkFeatureBit::kTopology)) != 0) {
+      EXPECT_EQ(config.topology.opt_io_size, hints.opt_io_size,
+                "GetIoHints() reports opt_io_size");
+      EXPECT_EQ(static_cast<uint32_t>(config.topology.min_io_size),
+                hints.min_io_size, "GetIoHints() reports min_io_size");
+    } else {
+      EXPECT_EQ(0u, hints.opt_io_size, "No topology: opt_io_size is 0");
+    }
+
     uint64_t block_count = dev.GetBlockCount();
     EXPECT_TRUE(block_count > 0, "GetBlockCount() > 0");
     LOG_HEX("Block count", block_count);
@@ -690,5 +709,347 @@ void test_virtio_blk_device() {
     }
   }
 
+  // === 测试 25: 大块 WriteBlocks / ReadBlocks（多扇区合并 + 多请求在途） ===
+  {
+    auto open_result = dev2.OpenReadWrite();
+    EXPECT_TRUE(open_result.has_value(), "Open for large transfer test");
+
+    if (open_result.has_value()) {
+      constexpr uint64_t kStartBlock = 2048;
+      constexpr size_t kTotalBytes =
+          kLargeBufSectors * device_framework::virtio::blk::kSectorSize;
+      for (size_t i = 0; i < kTotalBytes; ++i) {
+        g_large_buf[i] = static_cast<uint8_t>((i >> 9) ^ (i * 13));
+      }
+
+      auto write_result = dev2.WriteBlocks(
+          kStartBlock, std::span<const uint8_t>(g_large_buf, kTotalBytes),
+          kLargeBufSectors);
+      EXPECT_TRUE(write_result.has_value(), "Large WriteBlocks succeeds");
+      if (write_result.has_value()) {
+        EXPECT_EQ(kLargeBufSectors, *write_result,
+                  "Large WriteBlocks returned full block count");
+      }
+
+      Memzero(g_large_buf, kTotalBytes);
+      auto read_result = dev2.ReadBlocks(
+          kStartBlock, std::span<uint8_t>(g_large_buf, kTotalBytes),
+          kLargeBufSectors);
+      EXPECT_TRUE(read_result.has_value(), "Large ReadBlocks succeeds");
+
+      bool all_match = true;
+      for (size_t i = 0; i < kTotalBytes; ++i) {
+        if (g_large_buf[i] != static_cast<uint8_t>((i >> 9) ^ (i * 13))) {
+          all_match = false;
+          LOG_HEX("  Large transfer mismatch at byte", i);
+          break;
+        }
+      }
+      EXPECT_TRUE(all_match, "Large ReadBlocks data matches WriteBlocks data");
+
+      (void)dev2.Release();
+    }
+  }
+
+  // === 测试 26: 异步 SubmitWriteBlocks / SubmitReadBlocks + Reap ===
+  {
+    auto open_result = dev2.OpenReadWrite();
+    EXPECT_TRUE(open_result.has_value(), "Open for async test");
+
+    if (open_result.has_value()) {
+      constexpr uint64_t kStartBlock = 4096;
+      constexpr size_t kChunks = 8;
+      constexpr size_t kChunkBlocks = kLargeBufSectors / kChunks;
+      constexpr size_t kChunkBytes =
+          kChunkBlocks * device_framework::virtio::blk::kSectorSize;
+      constexpr size_t kTotalBytes = kChunks * kChunkBytes;
+      for (size_t i = 0; i < kTotalBytes; ++i) {
+        g_large_buf[i] = static_cast<uint8_t>((i >> 7) + (i * 29));
+      }
+
+      // 收集 kChunks 个完成记录，返回每个 token 的完成次数是否正确
+      bool seen[kChunks]{};
+      auto reap_all = [&dev2, &seen](const char* what) {
+        for (auto& s : seen) {
+          s = false;
+        }
+        size_t done = 0;
+        bool all_ok = true;
+        for (uint32_t spin = 0; spin < 100000000 && done < kChunks; ++spin) {
+          device_framework::BlockCompletion completions[4];
+          size_t n = dev2.Reap(completions);
+          for (size_t i = 0; i < n; ++i) {
+            auto idx = reinterpret_cast<uintptr_t>(completions[i].token) - 1;
+            if (idx >= kChunks || seen[idx] ||
+                completions[i].status !=
+                    device_framework::ErrorCode::kSuccess ||
+                completions[i].block_count != kChunkBlocks) {
+              all_ok = false;
+              LOG_HEX("  Unexpected async completion token", idx + 1);
+              continue;
+            }
+            seen[idx] = true;
+          }
+          done += n;
+        }
+        EXPECT_EQ(kChunks, done, what);
+        return all_ok;
+      };
+
+      bool submit_ok = true;
+      for (size_t c = 0; c < kChunks; ++c) {
+        auto r = dev2.SubmitWriteBlocks(
+            kStartBlock + c * kChunkBlocks,
+            std::span<const uint8_t>(g_large_buf + c * kChunkBytes,
+                                     kChunkBytes),
+            kChunkBlocks, reinterpret_cast<void*>(c + 1));
+        submit_ok = submit_ok && r.has_value();
+      }
+      EXPECT_TRUE(submit_ok, "All async writes submitted");
+      EXPECT_TRUE(reap_all("All async writes completed"),
+                  "Async write completions carry correct token and status");
+
+      Memzero(g_large_buf, kTotalBytes);
+      submit_ok = true;
+      for (size_t c = 0; c < kChunks; ++c) {
+        auto r = dev2.SubmitReadBlocks(
+            kStartBlock + c * kChunkBlocks,
+            std::span<uint8_t>(g_large_buf + c * kChunkBytes, kChunkBytes),
+            kChunkBlocks, reinterpret_cast<void*>(c + 1));
+        submit_ok = submit_ok && r.has_value();
+      }
+      EXPECT_TRUE(submit_ok, "All async reads submitted");
+      EXPECT_TRUE(reap_all("All async reads completed"),
+                  "Async read completions carry correct token and status");
+
+      bool all_match = true;
+      for (size_t i = 0; i < kTotalBytes; ++i) {
+        if (g_large_buf[i] != static_cast<uint8_t>((i >> 7) + (i * 29))) {
+          all_match = false;
+          LOG_HEX("  Async transfer mismatch at byte", i);
+          break;
+        }
+      }
+      EXPECT_TRUE(all_match, "Async read data matches async write data");
+
+      // 同步 ReadBlocks 与异步请求交错
+      auto async_r = dev2.SubmitReadBlocks(
+          kStartBlock, std::span<uint8_t>(g_large_buf, kChunkBytes),
+          kChunkBlocks, reinterpret_cast<void*>(1));
+      auto sync_r = dev2.ReadBlocks(
+          kStartBlock + kChunkBlocks,
+          std::span<uint8_t>(g_large_buf + kChunkBytes, kChunkBytes),
+          kChunkBlocks);
+      EXPECT_TRUE(async_r.has_value() && sync_r.has_value(),
+                  "Sync ReadBlocks with async read in flight succeeds");
+      device_framework::BlockCompletion completion{};
+      size_t got = 0;
+      for (uint32_t spin = 0; spin < 100000000 && got == 0; ++spin) {
+        got = dev2.Reap(std::span(&completion, 1));
+      }
+      EXPECT_EQ(1u, got, "Async read in flight is still reaped");
+      EXPECT_TRUE(completion.token == reinterpret_cast<void*>(1),
+                  "Interleaved async completion keeps its token");
+
+      (void)dev2.Release();
+    }
+  }
+
+  // === 测试 27: 异步接口错误路径 ===
+  {
+    auto not_open = dev2.SubmitReadBlocks(
+        0, std::span<uint8_t>(g_data_buf, sizeof(g_data_buf)), 1, nullptr);
+    EXPECT_FALSE(not_open.has_value(), "SubmitReadBlocks before Open fails");
+
+    auto open_result = dev2.OpenReadWrite();
+    if (open_result.has_value()) {
+      auto out_of_range = dev2.SubmitReadBlocks(
+          dev2.GetBlockCount(),
+          std::span<uint8_t>(g_data_buf, sizeof(g_data_buf)), 1, nullptr);
+      EXPECT_FALSE(out_of_range.has_value(),
+                   "SubmitReadBlocks out of range fails");
+
+      // 完成记录满时拒绝新的提交
+      constexpr size_t kMax = DeviceType::kMaxCompletions;
+      size_t accepted = 0;
+      for (size_t i = 0; i < kMax; ++i) {
+        auto r = dev2.SubmitReadBlocks(
+            i, std::span<uint8_t>(g_large_buf + i * 512, 512), 1, nullptr);
+        accepted += r.has_value() ? 1 : 0;
+      }
+      EXPECT_EQ(kMax, accepted, "Submit up to kMaxCompletions succeeds");
+      auto busy = dev2.SubmitReadBlocks(
+          kMax, std::span<uint8_t>(g_large_buf + kMax * 512, 512), 1, nullptr);
+      EXPECT_FALSE(busy.has_value(), "Submit beyond kMaxCompletions fails");
+      if (!busy.has_value()) {
+        EXPECT_EQ(
+            static_cast<uint32_t>(device_framework::ErrorCode::kDeviceBusy),
+            static_cast<uint32_t>(busy.error().code),
+            "Error code is kDeviceBusy");
+      }
+      size_t reaped = 0;
+      for (uint32_t spin = 0; spin < 100000000 && reaped < kMax; ++spin) {
+        device_framework::BlockCompletion completions[kMax];
+        reaped += dev2.Reap(completions);
+      }
+      EXPECT_EQ(kMax, reaped, "All queued async reads reaped");
+
+      // 异步 Flush：结果通过完成记录返回
+      auto flush = dev2.SubmitFlush(reinterpret_cast<void*>(0xF1));
+      EXPECT_TRUE(flush.has_value(), "SubmitFlush submitted");
+      size_t ready = 0;
+      for (uint32_t spin = 0; spin < 100000000 && ready == 0; ++spin) {
+        ready = dev2.Poll();
+      }
+      EXPECT_EQ(1u, ready, "Async flush completion is ready");
+      device_framework::BlockCompletion completion{};
+      EXPECT_EQ(1u, dev2.Reap(std::span(&completion, 1)),
+                "Async flush completion reaped");
+      EXPECT_TRUE(completion.token == reinterpret_cast<void*>(0xF1),
+                  "Async flush completion keeps its token");
+      EXPECT_EQ(static_cast<uint32_t>(device_framework::ErrorCode::kSuccess),
+                static_cast<uint32_t>(completion.status),
+                "Async flush succeeds");
+      EXPECT_EQ(0u, completion.block_count, "Flush completes zero blocks");
+
+      // 同步 Flush
+      EXPECT_TRUE(dev2.Flush().has_value(), "Sync Flush succeeds");
+
+      (void)dev2.Release();
+    }
+  }
+
+  // === 测试 28: 异步请求在途时移动设备对象 ===
+  {
+    auto open_result = dev2.OpenReadWrite();
+    EXPECT_TRUE(open_result.has_value(), "Reopen before move");
+    if (open_result.has_value()) {
+      constexpr uint64_t kBlock = 1200;
+      for (size_t i = 0; i < kSectorSize; ++i) {
+        g_data_buf[i] = static_cast<uint8_t>(i ^ 0x93);
+      }
+      (void)dev2.WriteBlock(
+          kBlock, std::span<const uint8_t>(g_data_buf, kSectorSize));
+      Memzero(g_data_buf, kSectorSize);
+      auto submit = dev2.SubmitReadBlocks(
+          kBlock, std::span<uint8_t>(g_data_buf, kSectorSize), 1,
+          reinterpret_cast<void*>(0x28));
+      EXPECT_TRUE(submit.has_value(), "Async read submitted before move");
+
+      DeviceType moved(std::move(dev2));
+      device_framework::BlockCompletion completion{};
+      size_t reaped = 0;
+      for (uint32_t spin = 0; spin < 100000000 && reaped == 0; ++spin) {
+        reaped = moved.Reap(std::span(&completion, 1));
+      }
+      EXPECT_EQ(1u, reaped, "Moved device reaps in-flight request");
+      EXPECT_TRUE(completion.token == reinterpret_cast<void*>(0x28) &&
+                      completion.status ==
+                          device_framework::ErrorCode::kSuccess,
+                  "In-flight request completes after move");
+      EXPECT_EQ(static_cast<uint8_t>(5 ^ 0x93), g_data_buf[5],
+                "In-flight read returns data after move");
+      (void)moved.Release();
+    }
+  }
+
+  // === 测试 29: Readv/Writev 分散-聚集读写 ===
+  {
+    Memzero(g_dma_buf, kRequiredDmaSize);
+    auto dev3_result = DeviceType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(dev3_result.has_value(),
+                "VirtioBlkDevice::Create() for vectored I/O");
+    if (dev3_result.has_value() && dev3_result->OpenReadWrite().has_value()) {
+      auto& dev3 = *dev3_result;
+      constexpr uint64_t kBlock = 1300;
+      constexpr size_t kOffset = kBlock * kSectorSize;
+      // 1 + 2 + 1 个扇区，中间段与首段不相邻
+      uint8_t* seg0 = g_large_buf;
+      uint8_t* seg1 = g_large_buf + 4 * kSectorSize;
+      uint8_t* seg2 = g_large_buf + 2 * kSectorSize;
+      for (size_t i = 0; i < 4 * kSectorSize; ++i) {
+        uint8_t value = static_cast<uint8_t>((i * 7) ^ (i >> 9));
+        uint8_t* dst = i < kSectorSize       ? seg0 + i
+                       : i < 3 * kSectorSize ? seg1 + (i - kSectorSize)
+                                             : seg2 + (i - 3 * kSectorSize);
+        *dst = value;
+      }
+      const std::span<const uint8_t> out[] = {
+          {seg0, kSectorSize}, {seg1, 2 * kSectorSize}, {seg2, kSectorSize}};
+      auto written = dev3.Writev(out, kOffset);
+      EXPECT_TRUE(written.has_value() && *written == 4 * kSectorSize,
+                  "Writev() writes all segments");
+
+      auto single = dev3.ReadBlocks(
+          kBlock + 1, std::span<uint8_t>(g_data_buf, 2 * kSectorSize), 2);
+      EXPECT_TRUE(single.has_value() &&
+                      g_data_buf[3] == static_cast<uint8_t>(
+                                           ((kSectorSize + 3) * 7) ^ 1),
+                  "Writev() lays segments out contiguously on disk");
+
+      Memzero(g_large_buf, 6 * kSectorSize);
+      const std::span<uint8_t> in[] = {
+          {seg0, kSectorSize}, {seg1, 2 * kSectorSize}, {seg2, kSectorSize}};
+      auto read = dev3.Readv(in, kOffset);
+      EXPECT_TRUE(read.has_value() && *read == 4 * kSectorSize,
+                  "Readv() fills all segments");
+      bool match = true;
+      for (size_t i = 0; i < 4 * kSectorSize && match; ++i) {
+        uint8_t value = static_cast<uint8_t>((i * 7) ^ (i >> 9));
+        const uint8_t* src = i < kSectorSize ? seg0 + i
+                             : i < 3 * kSectorSize
+                                 ? seg1 + (i - kSectorSize)
+                                 : seg2 + (i - 3 * kSectorSize);
+        match = *src == value;
+      }
+      EXPECT_TRUE(match, "Readv() returns data written by Writev()");
+
+      const std::span<uint8_t> unaligned[] = {{seg0, kSectorSize},
+                                              {seg1, kSectorSize / 2}};
+      EXPECT_FALSE(dev3.Readv(unaligned, kOffset).has_value(),
+                   "Readv() rejects unaligned segment");
+      EXPECT_FALSE(dev3.Readv(in, kOffset + 1).has_value(),
+                   "Readv() rejects unaligned offset");
+      (void)dev3.Release();
+    }
+  }
+
+  // === 测试 30: 异步完成触发就绪通知 ===
+  {
+    Memzero(g_dma_buf, kRequiredDmaSize);
+    auto dev4_result = DeviceType::Create(blk_base, g_dma_buf);
+    if (dev4_result.has_value() && dev4_result->OpenReadWrite().has_value()) {
+      auto& dev4 = *dev4_result;
+      uint32_t wakeups = 0;
+      auto handle = dev4.RegisterPollWaiter(
+          device_framework::PollEvents{device_framework::PollEvents::kIn},
+          [](void* context, device_framework::PollEvents) {
+            ++*static_cast<uint32_t*>(context);
+          },
+          &wakeups);
+      EXPECT_TRUE(handle.has_value(), "RegisterPollWaiter() succeeds");
+
+      auto submit = dev4.SubmitReadBlocks(
+          0, std::span<uint8_t>(g_data_buf, kSectorSize), 1,
+          reinterpret_cast<void*>(0x30));
+      EXPECT_TRUE(submit.has_value(), "Async read submitted");
+      for (uint32_t spin = 0; spin < 100000000 && dev4.Poll() == 0; ++spin) {
+      }
+      EXPECT_EQ(1u, wakeups, "Posted completion wakes the kIn waiter");
+      EXPECT_TRUE(dev4.GetPollReady().HasIn(),
+                  "kIn cached while completions are pending");
+
+      device_framework::BlockCompletion completion{};
+      EXPECT_EQ(1u, dev4.Reap(std::span(&completion, 1)),
+                "Completion reaped");
+      EXPECT_FALSE(dev4.GetPollReady().HasIn(),
+                   "kIn cleared once all completions are reaped");
+      if (handle.has_value()) {
+        (void)dev4.UnregisterPollWaiter(*handle);
+      }
+      (void)dev4.Release();
+    }
+  }
+
   TEST_SUITE_END();
 }
@@ -10,15 +10,130 @@
  * 4. 同步写入/读取操作并验证数据一致性
  * 5. 异步 Scatter-Gather / 批量提交 / Event Index 测试
  * 6. HandleInterrupt 回调机制与幂等性验证
+ * 7. 多队列（VIRTIO_BLK_F_MQ）初始化与按队列提交/回收
+ * 8. Packed Virtqueue（VIRTIO_F_RING_PACKED）读写
+ * 9. 间接描述符（VIRTIO_F_INDIRECT_DESC）大 SG 请求
+ * 10. 协程接口（co_await AsyncRead/AsyncWrite）
+ * 11. 微基准：不同队列深度下单个完成的处理开销
+ * 12. 深队列：MaxInflight = 256 时 256 个请求同时在途
+ * 13. EnqueueBatch 批量提交（单次写屏障与 Kick）
+ * 14. 自适应轮询：高完成率下暂停中断，空闲后恢复
+ * 15. FLUSH / GET_ID / 多段 WRITE_ZEROES / DISCARD 命令
+ * 16. BlkRequestQueue 请求合并与完成分发
+ * 17. 非一致性 DMA 缓存维护（DmaCoherencyTraits）
+ * 18. 遥测：按请求类别的延迟直方图与在途深度（TelemetryTraits）
+ * 19. 多生产者并发提交模式（ConcurrentSubmitTraits）
+ * 20. 编译期固定特性集（FeatureSet）
+ * 21. 配置空间快照与配置变更通知
+ * 22. BlkRequestQueue 不跨越最优 I/O 边界合并
+ * 23. Quiesce / Resume / Restore 快速恢复
  */
 
 #include "device_framework/virtio_blk.hpp"
 
+#include <coroutine>
 #include <cstdint>
 
 #include "test.h"
 #include "test_env.h"
 
+namespace {
+
+/**
+ * @brief 测试用最小协程类型
+ *
+ * 立即开始执行，结束时挂起以便调用者检查 done；
+ * 协程帧从静态区分配，测试中同一时刻最多存在 kMaxTasks 个协程。
+ */
+struct TestTask {
+  struct promise_type {
+    static constexpr size_t kMaxTasks = 4;
+    static constexpr size_t kFrameSize = 1024;
+
+    bool done = false;
+
+    // 测试协程帧远小于 kFrameSize，轮流复用静态帧
+    static auto operator new(size_t /*size*/) -> void* {
+      alignas(16) static uint8_t frames[kMaxTasks][kFrameSize];
+      static size_t next = 0;
+      return frames[next++ % kMaxTasks];
+    }
+    static auto operator delete(void*) -> void {}
+
+    auto get_return_object() -> TestTask {
+      return TestTask{
+          std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+    auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+    auto final_suspend() noexcept -> std::suspend_always {
+      done = true;
+      return {};
+    }
+    auto return_void() -> void {}
+    auto unhandled_exception() -> void {}
+  };
+
+  std::coroutine_handle<promise_type> handle;
+
+  [[nodiscard]] auto Done() const -> bool { return handle.promise().done; }
+  auto Destroy() -> void { handle.destroy(); }
+};
+
+/**
+ * @brief 写入一个扇区后读回，结果写入 *ok
+ */
+template <class Blk>
+auto WriteReadTask(Blk& blk, uint64_t sector, uint8_t* wbuf, uint8_t* rbuf,
+                   bool* ok) -> TestTask {
+  device_framework::virtio::IoVec wiov{RiscvTraits::VirtToPhys(wbuf),
+                                       kSectorSize};
+  device_framework::virtio::IoVec riov{RiscvTraits::VirtToPhys(rbuf),
+                                       kSectorSize};
+  auto w = co_await blk.AsyncWrite(0, sector, &wiov, 1);
+  if (!w) {
+    *ok = false;
+    co_return;
+  }
+  auto r = co_await blk.AsyncRead(0, sector, &riov, 1);
+  *ok = r.has_value();
+}
+
+/**
+ * @brief 模拟非一致性 DMA 平台的 Traits
+ *
+ * QEMU virt 的 DMA 是一致的，缓存维护只计数，用于验证驱动调用了钩子。
+ */
+struct NonCoherentTraits : RiscvTraits {
+  static inline uint32_t clean_count = 0;
+  static inline uint32_t invalidate_count = 0;
+  static inline size_t invalidated_bytes = 0;
+
+  static auto CacheClean(void* /*ptr*/, size_t /*len*/) -> void {
+    ++clean_count;
+  }
+  static auto CacheInvalidate(void* /*ptr*/, size_t len) -> void {
+    ++invalidate_count;
+    invalidated_bytes += len;
+  }
+};
+
+/**
+ * @brief 开启驱动遥测的 Traits（以周期计数器为时间戳）
+ */
+struct TelemetryEnabledTraits : RiscvTraits {
+  static constexpr bool kEnableTelemetry = true;
+  static auto Now() -> uint64_t { return ReadCycleCounter(); }
+};
+
+/**
+ * @brief 开启多生产者并发提交的 Traits
+ */
+struct ConcurrentTraits : RiscvTraits {
+  static constexpr bool kConcurrentSubmit = true;
+};
+
+}  // namespace
+
 void test_virtio_blk() {
   TEST_SUITE_BEGIN("VirtIO Block Device");
 
@@ -885,5 +1000,1069 @@ void test_virtio_blk() {
     g_virtio_irq_handlers[dev_idx] = nullptr;
   }
 
+  // === 测试 24: 多队列初始化与按队列提交/回收 ===
+  {
+    constexpr uint16_t kRequestedQueues = 2;
+    constexpr auto kMqDmaSize =
+        VirtioBlkType::GetRequiredVqMemSize(kRequestedQueues, 128).first;
+    static_assert(kDmaBufSize >= kMqDmaSize,
+                  "g_dma_buf too small for multi-queue VirtioBlk");
+    Memzero(g_dma_buf, kMqDmaSize);
+
+    auto mq_result =
+        VirtioBlkType::Create(blk_base, g_dma_buf, kRequestedQueues, 128);
+    EXPECT_TRUE(mq_result.has_value(), "Multi-queue: Create() succeeds");
+    if (mq_result.has_value()) {
+      auto& mq_blk = *mq_result;
+      uint16_t queue_count = mq_blk.GetQueueCount();
+      EXPECT_TRUE(queue_count >= 1 && queue_count <= kRequestedQueues,
+                  "Multi-queue: queue count within requested range");
+      LOG_HEX("Multi-queue: queue count", queue_count);
+
+      // 越界队列索引应被拒绝
+      device_framework::virtio::IoVec iov{
+          RiscvTraits::VirtToPhys(g_data_buf),
+          device_framework::virtio::blk::kSectorSize};
+      auto bad = mq_blk.EnqueueWrite(queue_count, 0, &iov, 1, nullptr);
+      EXPECT_FALSE(bad.has_value(),
+                   "Multi-queue: out-of-range queue index rejected");
+
+      // 在最后一个队列上写入并读回
+      uint16_t last_queue = queue_count - 1;
+      constexpr uint64_t kTestSector = 120;
+      for (size_t i = 0; i < device_framework::virtio::blk::kSectorSize; ++i) {
+        g_data_buf[i] = static_cast<uint8_t>(0x5A ^ i);
+      }
+      auto enq = mq_blk.EnqueueWrite(last_queue, kTestSector, &iov, 1, nullptr);
+      EXPECT_TRUE(enq.has_value(), "Multi-queue: enqueue on last queue");
+      if (enq.has_value()) {
+        mq_blk.Kick(last_queue);
+        bool done = false;
+        for (uint32_t spin = 0; spin < 100000000 && !done; ++spin) {
+          RiscvTraits::Rmb();
+          mq_blk.HandleInterrupt(
+              last_queue, [&done](void* /*token*/,
+                                  device_framework::ErrorCode /*status*/) {
+                done = true;
+              });
+        }
+        EXPECT_TRUE(done, "Multi-queue: write on last queue completed");
+        EXPECT_TRUE(mq_blk.GetQueueStats(last_queue).bytes_transferred > 0,
+                    "Multi-queue: per-queue stats updated");
+      }
+
+      Memzero(g_data_buf, device_framework::virtio::blk::kSectorSize);
+      auto rd = mq_blk.Read(kTestSector, g_data_buf);
+      EXPECT_TRUE(rd.has_value(), "Multi-queue: sync read on queue 0");
+      bool match = true;
+      for (size_t i = 0; i < device_framework::virtio::blk::kSectorSize; ++i) {
+        if (g_data_buf[i] != static_cast<uint8_t>(0x5A ^ i)) {
+          match = false;
+          break;
+        }
+      }
+      EXPECT_TRUE(match, "Multi-queue: data written on last queue read back");
+    }
+  }
+
+  // === 测试 25: Packed Virtqueue 读写 ===
+  {
+    using PackedBlkType = device_framework::virtio::blk::VirtioBlk<
+        RiscvTraits, device_framework::virtio::MmioTransport,
+        device_framework::virtio::PackedVirtqueue>;
+    constexpr size_t kPackedDmaSize = PackedBlkType::CalcDmaSize();
+    static_assert(kDmaBufSize >= kPackedDmaSize,
+                  "g_dma_buf too small for packed VirtioBlk");
+    Memzero(g_dma_buf, kPackedDmaSize);
+
+    auto packed_result = PackedBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(packed_result.has_value(), "Packed: Create() succeeds");
+    if (packed_result.has_value()) {
+      auto& packed_blk = *packed_result;
+      bool has_packed =
+          (packed_blk.GetNegotiatedFeatures() &
+           static_cast<uint64_t>(
+               device_framework::virtio::ReservedFeature::kRingPacked)) != 0;
+      EXPECT_TRUE(has_packed, "Packed: RING_PACKED negotiated");
+
+      // 写入次数超过队列大小，覆盖 wrap counter 翻转路径
+      constexpr uint64_t kBaseSector = 300;
+      constexpr uint32_t kRounds = 200;
+      bool all_ok = true;
+      for (uint32_t round = 0; round < kRounds && all_ok; ++round) {
+        for (size_t i = 0; i < device_framework::virtio::blk::kSectorSize;
+             ++i) {
+          g_data_buf[i] = static_cast<uint8_t>(round + i);
+        }
+        uint64_t sector = kBaseSector + (round % 8);
+        auto wr = packed_blk.Write(sector, g_data_buf);
+        Memzero(g_data_buf, device_framework::virtio::blk::kSectorSize);
+        auto rd = packed_blk.Read(sector, g_data_buf);
+        if (!wr.has_value() || !rd.has_value()) {
+          all_ok = false;
+          LOG_HEX("  Packed I/O failed at round", round);
+          break;
+        }
+        for (size_t i = 0; i < device_framework::virtio::blk::kSectorSize;
+             ++i) {
+          if (g_data_buf[i] != static_cast<uint8_t>(round + i)) {
+            all_ok = false;
+            LOG_HEX("  Packed data mismatch at round", round);
+            break;
+          }
+        }
+      }
+      EXPECT_TRUE(all_ok, "Packed: repeated write/read across ring wrap");
+    }
+  }
+
+  // === 测试 26: 间接描述符 - 超过 16 个数据段的 SG 请求 ===
+  {
+    Memzero(g_dma_buf, kRequiredDmaSize);
+    auto ind_result = VirtioBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(ind_result.has_value(), "Indirect: Create() succeeds");
+    if (ind_result.has_value()) {
+      auto& ind_blk = *ind_result;
+      bool has_indirect =
+          (ind_blk.GetNegotiatedFeatures() &
+           static_cast<uint64_t>(
+               device_framework::virtio::ReservedFeature::kIndirectDesc)) != 0;
+      EXPECT_TRUE(has_indirect, "Indirect: INDIRECT_DESC negotiated");
+      EXPECT_EQ(VirtioBlkType::kMaxIndirectSgElements,
+                ind_blk.GetMaxSgElements(),
+                "Indirect: SG limit raised to indirect table size");
+
+      // 16 x 64B + 4 x 256B = 4 个扇区，共 20 个数据段
+      constexpr size_t kSegCount = 20;
+      constexpr size_t kTotalBytes =
+          kMultiBufSectors * device_framework::virtio::blk::kSectorSize;
+      for (size_t i = 0; i < kTotalBytes; ++i) {
+        g_multi_buf[i] = static_cast<uint8_t>((i * 7) ^ 0x3C);
+      }
+      device_framework::virtio::IoVec iovs[kSegCount];
+      size_t offset = 0;
+      for (size_t i = 0; i < kSegCount; ++i) {
+        size_t len = i < 16 ? 64 : 256;
+        iovs[i] = {RiscvTraits::VirtToPhys(g_multi_buf + offset), len};
+        offset += len;
+      }
+
+      constexpr uint64_t kTestSector = 400;
+      auto enq = ind_blk.EnqueueWrite(0, kTestSector, iovs, kSegCount);
+      EXPECT_TRUE(enq.has_value(), "Indirect: 20-segment write enqueued");
+      if (enq.has_value()) {
+        ind_blk.Kick(0);
+        bool done = false;
+        device_framework::ErrorCode status =
+            device_framework::ErrorCode::kDeviceError;
+        for (uint32_t spin = 0; spin < 100000000 && !done; ++spin) {
+          RiscvTraits::Rmb();
+          ind_blk.HandleInterrupt(
+              [&done, &status](void* /*token*/,
+                               device_framework::ErrorCode ec) {
+                done = true;
+                status = ec;
+              });
+        }
+        EXPECT_TRUE(done, "Indirect: 20-segment write completed");
+        EXPECT_TRUE(status == device_framework::ErrorCode::kSuccess,
+                    "Indirect: 20-segment write succeeded");
+      }
+
+      bool match = true;
+      for (size_t s = 0; s < kMultiBufSectors && match; ++s) {
+        Memzero(g_data_buf, device_framework::virtio::blk::kSectorSize);
+        auto rd = ind_blk.Read(kTestSector + s, g_data_buf);
+        if (!rd.has_value()) {
+          match = false;
+          break;
+        }
+        for (size_t i = 0; i < device_framework::virtio::blk::kSectorSize;
+             ++i) {
+          size_t pos = s * device_framework::virtio::blk::kSectorSize + i;
+          if (g_data_buf[i] != static_cast<uint8_t>((pos * 7) ^ 0x3C)) {
+            match = false;
+            break;
+          }
+        }
+      }
+      EXPECT_TRUE(match, "Indirect: 20-segment write read back");
+    }
+  }
+
+  // === 测试 27: 协程接口 - 多个协程并发 co_await 读写 ===
+  {
+    Memzero(g_dma_buf, kRequiredDmaSize);
+    auto co_result = VirtioBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(co_result.has_value(), "Coroutine: Create() succeeds");
+    if (co_result.has_value()) {
+      auto& co_blk = *co_result;
+      constexpr size_t kTasks = TestTask::promise_type::kMaxTasks;
+      constexpr uint64_t kBaseSector = 500;
+      // g_large_buf 前 kTasks 个扇区为写缓冲，随后 kTasks 个扇区为读缓冲
+      uint8_t* wbufs = g_large_buf;
+      uint8_t* rbufs = g_large_buf + kTasks * kSectorSize;
+      for (size_t i = 0; i < kTasks * kSectorSize; ++i) {
+        wbufs[i] = static_cast<uint8_t>((i * 11) ^ (i >> 9));
+        rbufs[i] = 0;
+      }
+
+      bool ok[kTasks]{};
+      TestTask tasks[kTasks];
+      for (size_t t = 0; t < kTasks; ++t) {
+        tasks[t] = WriteReadTask(co_blk, kBaseSector + t,
+                                 wbufs + t * kSectorSize,
+                                 rbufs + t * kSectorSize, &ok[t]);
+      }
+
+      // 无回调逻辑：HandleInterrupt 直接恢复等待的协程
+      auto all_done = [&tasks] {
+        for (auto& task : tasks) {
+          if (!task.Done()) {
+            return false;
+          }
+        }
+        return true;
+      };
+      for (uint32_t spin = 0; spin < 100000000 && !all_done(); ++spin) {
+        RiscvTraits::Rmb();
+        co_blk.HandleInterrupt(
+            [](void* /*token*/, device_framework::ErrorCode /*status*/) {});
+      }
+      EXPECT_TRUE(all_done(), "Coroutine: all tasks completed");
+
+      bool all_ok = true;
+      for (size_t t = 0; t < kTasks; ++t) {
+        all_ok = all_ok && ok[t];
+      }
+      EXPECT_TRUE(all_ok, "Coroutine: all co_await requests succeeded");
+
+      bool match = true;
+      for (size_t i = 0; i < kTasks * kSectorSize; ++i) {
+        if (rbufs[i] != wbufs[i]) {
+          match = false;
+          LOG_HEX("  Coroutine mismatch at byte", i);
+          break;
+        }
+      }
+      EXPECT_TRUE(match, "Coroutine: read back matches written data");
+
+      for (auto& task : tasks) {
+        if (task.Done()) {
+          task.Destroy();
+        }
+      }
+    }
+  }
+
+  // === 测试 28: 微基准 - 队列深度 1/16/64 下单个完成的处理开销 ===
+  {
+    Memzero(g_dma_buf, kRequiredDmaSize);
+    auto bench_result = VirtioBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(bench_result.has_value(), "Bench: Create() succeeds");
+    if (bench_result.has_value()) {
+      auto& bench_blk = *bench_result;
+      constexpr size_t kDepths[] = {1, 16, VirtioBlkType::kMaxInflight};
+      constexpr size_t kRounds = 32;
+      static_assert(VirtioBlkType::kMaxInflight <= kLargeBufSectors,
+                    "g_large_buf too small for bench");
+
+      bool all_ok = true;
+      for (size_t depth : kDepths) {
+        uint64_t cycles = 0;
+        size_t completions = 0;
+        size_t calls = 0;
+        for (size_t round = 0; round < kRounds && all_ok; ++round) {
+          for (size_t i = 0; i < depth; ++i) {
+            device_framework::virtio::IoVec iov{
+                RiscvTraits::VirtToPhys(g_large_buf + i * kSectorSize),
+                kSectorSize};
+            if (!bench_blk.EnqueueRead(0, i, &iov, 1).has_value()) {
+              all_ok = false;
+              break;
+            }
+          }
+          bench_blk.Kick(0);
+
+          // 只统计回收到完成的 HandleInterrupt 调用（含中断确认的 MMIO 开销）
+          size_t reaped = 0;
+          for (uint32_t spin = 0; spin < 100000000 && reaped < depth;
+               ++spin) {
+            RiscvTraits::Rmb();
+            size_t before = reaped;
+            uint64_t start = ReadCycleCounter();
+            bench_blk.HandleInterrupt(
+                [&reaped](void* /*token*/,
+                          device_framework::ErrorCode /*status*/) {
+                  ++reaped;
+                });
+            uint64_t end = ReadCycleCounter();
+            if (reaped > before) {
+              cycles += end - start;
+              ++calls;
+            }
+          }
+          if (reaped < depth) {
+            all_ok = false;
+          }
+          completions += reaped;
+        }
+        uint64_t per_call = calls == 0 ? 0 : completions / calls;
+        uint64_t per_completion = completions == 0 ? 0 : cycles / completions;
+        RiscvTraits::Log(
+            "[BENCH] depth=%lu completions=%lu per_call=%lu "
+            "cycles/completion=%lu",
+            static_cast<unsigned long>(depth),
+            static_cast<unsigned long>(completions),
+            static_cast<unsigned long>(per_call),
+            static_cast<unsigned long>(per_completion));
+      }
+      EXPECT_TRUE(all_ok, "Bench: all benchmark requests completed");
+    }
+  }
+
+  // === 测试 29: 深队列 - 256 个请求同时在途 ===
+  {
+    constexpr uint16_t kDeepInflight = 256;
+    using DeepBlkType = device_framework::virtio::blk::VirtioBlk<
+        RiscvTraits, device_framework::virtio::MmioTransport,
+        device_framework::virtio::SplitVirtqueue, kDeepInflight>;
+    constexpr size_t kDeepDmaSize = DeepBlkType::CalcDmaSize(kDeepInflight);
+    static_assert(kDmaBufSize >= kDeepDmaSize,
+                  "g_dma_buf too small for deep queue test");
+    static_assert(kLargeBufSectors >= kDeepInflight,
+                  "g_large_buf too small for deep queue test");
+    Memzero(g_dma_buf, kDeepDmaSize);
+
+    auto deep_result =
+        DeepBlkType::Create(blk_base, g_dma_buf, 1, kDeepInflight);
+    EXPECT_TRUE(deep_result.has_value(), "Deep: Create() with 256 slots");
+    if (deep_result.has_value()) {
+      auto& deep_blk = *deep_result;
+      size_t enqueued = 0;
+      for (size_t i = 0; i < kDeepInflight; ++i) {
+        device_framework::virtio::IoVec iov{
+            RiscvTraits::VirtToPhys(g_large_buf + i * kSectorSize),
+            kSectorSize};
+        if (!deep_blk.EnqueueRead(0, i, &iov, 1).has_value()) {
+          break;
+        }
+        ++enqueued;
+      }
+      EXPECT_EQ(static_cast<size_t>(kDeepInflight), enqueued,
+                "Deep: 256 requests enqueued before any completion");
+
+      device_framework::virtio::IoVec extra{
+          RiscvTraits::VirtToPhys(g_data_buf), kSectorSize};
+      EXPECT_FALSE(deep_blk.EnqueueRead(0, 0, &extra, 1).has_value(),
+                   "Deep: request beyond queue depth rejected");
+
+      deep_blk.Kick(0);
+      size_t completed = 0;
+      bool all_ok = true;
+      for (uint32_t spin = 0; spin < 100000000 && completed < enqueued;
+           ++spin) {
+        RiscvTraits::Rmb();
+        deep_blk.HandleInterrupt(
+            [&completed, &all_ok](void* /*token*/,
+                                  device_framework::ErrorCode ec) {
+              ++completed;
+              all_ok = all_ok && ec == device_framework::ErrorCode::kSuccess;
+            });
+      }
+      EXPECT_EQ(enqueued, completed, "Deep: all in-flight requests completed");
+      EXPECT_TRUE(all_ok, "Deep: all in-flight requests succeeded");
+    }
+  }
+
+  // === 测试 30: EnqueueBatch - 32 个写请求一次发布 ===
+  {
+    Memzero(g_dma_buf, kRequiredDmaSize);
+    auto batch_result = VirtioBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(batch_result.has_value(), "Batch: Create() succeeds");
+    if (batch_result.has_value()) {
+      auto& batch_blk = *batch_result;
+      constexpr size_t kBatch = 32;
+      constexpr uint64_t kBaseSector = 600;
+      for (size_t i = 0; i < kBatch * kSectorSize; ++i) {
+        g_large_buf[i] = static_cast<uint8_t>((i * 5) ^ (i >> 9) ^ 0xA5);
+      }
+
+      device_framework::virtio::IoVec iovs[kBatch];
+      VirtioBlkType::BlkRequest requests[kBatch];
+      for (size_t i = 0; i < kBatch; ++i) {
+        iovs[i] = {RiscvTraits::VirtToPhys(g_large_buf + i * kSectorSize),
+                   kSectorSize};
+        requests[i] = {device_framework::virtio::blk::ReqType::kOut,
+                       kBaseSector + i, &iovs[i], 1,
+                       reinterpret_cast<void*>(i + 1)};
+      }
+
+      auto enq = batch_blk.EnqueueBatch(0, requests);
+      EXPECT_TRUE(enq.has_value(), "Batch: EnqueueBatch succeeds");
+      if (enq.has_value()) {
+        EXPECT_EQ(kBatch, *enq, "Batch: all 32 requests enqueued");
+      }
+
+      size_t completed = 0;
+      uint64_t token_sum = 0;
+      bool all_ok = true;
+      for (uint32_t spin = 0; spin < 100000000 && completed < kBatch;
+           ++spin) {
+        RiscvTraits::Rmb();
+        batch_blk.HandleInterrupt([&](void* token,
+                                      device_framework::ErrorCode ec) {
+          ++completed;
+          token_sum += reinterpret_cast<uintptr_t>(token);
+          all_ok = all_ok && ec == device_framework::ErrorCode::kSuccess;
+        });
+      }
+      EXPECT_EQ(kBatch, completed, "Batch: all requests completed");
+      EXPECT_EQ(kBatch * (kBatch + 1) / 2, token_sum,
+                "Batch: every token returned once");
+      EXPECT_TRUE(all_ok, "Batch: all requests succeeded");
+
+      bool match = true;
+      for (size_t s = 0; s < kBatch && match; ++s) {
+        Memzero(g_data_buf, kSectorSize);
+        if (!batch_blk.Read(kBaseSector + s, g_data_buf).has_value()) {
+          match = false;
+          break;
+        }
+        for (size_t i = 0; i < kSectorSize; ++i) {
+          size_t pos = s * kSectorSize + i;
+          if (g_data_buf[i] !=
+              static_cast<uint8_t>((pos * 5) ^ (pos >> 9) ^ 0xA5)) {
+            match = false;
+            break;
+          }
+        }
+      }
+      EXPECT_TRUE(match, "Batch: written sectors read back");
+
+      // 第一个请求即无效：整批失败，不提交任何请求
+      requests[0].type = device_framework::virtio::blk::ReqType::kGetId;
+      auto bad = batch_blk.EnqueueBatch(0, requests);
+      EXPECT_FALSE(bad.has_value(), "Batch: unsupported type rejected");
+    }
+  }
+
+  // === 测试 31: 自适应轮询 - 进入轮询模式并在空闲后恢复中断 ===
+  {
+    Memzero(g_dma_buf, kRequiredDmaSize);
+    auto poll_result = VirtioBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(poll_result.has_value(), "Poll: Create() succeeds");
+    if (poll_result.has_value()) {
+      auto& poll_blk = *poll_result;
+      constexpr size_t kBatch = 32;
+      constexpr uint64_t kBaseSector = 600;
+      constexpr size_t kBudget = 4;
+      // 阈值为 1：任意一次非空的中断处理都会切换到轮询模式
+      poll_blk.SetAdaptivePolling(1);
+      EXPECT_FALSE(poll_blk.IsPolling(0), "Poll: starts in interrupt mode");
+
+      device_framework::virtio::IoVec iovs[kBatch];
+      VirtioBlkType::BlkRequest requests[kBatch];
+      for (size_t i = 0; i < kBatch; ++i) {
+        iovs[i] = {RiscvTraits::VirtToPhys(g_large_buf + i * kSectorSize),
+                   kSectorSize};
+        requests[i] = {device_framework::virtio::blk::ReqType::kIn,
+                       kBaseSector + i, &iovs[i], 1,
+                       reinterpret_cast<void*>(i + 1)};
+      }
+      Memzero(g_large_buf, kBatch * kSectorSize);
+      auto enq = poll_blk.EnqueueBatch(0, requests);
+      EXPECT_TRUE(enq.has_value(), "Poll: EnqueueBatch succeeds");
+
+      size_t completed = 0;
+      size_t max_per_poll = 0;
+      bool all_ok = true;
+      auto on_complete = [&](void*, device_framework::ErrorCode ec) {
+        ++completed;
+        all_ok = all_ok && ec == device_framework::ErrorCode::kSuccess;
+      };
+      for (uint32_t spin = 0; spin < 100000000; ++spin) {
+        RiscvTraits::Rmb();
+        if (poll_blk.IsPolling(0)) {
+          size_t n = poll_blk.PollCompletions(0, kBudget, on_complete);
+          max_per_poll = n > max_per_poll ? n : max_per_poll;
+        } else if (completed < kBatch) {
+          poll_blk.HandleInterrupt(0, on_complete);
+        } else {
+          break;
+        }
+      }
+      auto stats = poll_blk.GetStats();
+      EXPECT_EQ(kBatch, completed, "Poll: all requests completed");
+      EXPECT_TRUE(all_ok, "Poll: all requests succeeded");
+      EXPECT_TRUE(stats.poll_mode_entries > 0, "Poll: entered polling mode");
+      EXPECT_TRUE(max_per_poll <= kBudget, "Poll: budget respected");
+      EXPECT_FALSE(poll_blk.IsPolling(0), "Poll: back to interrupt mode");
+      RiscvTraits::Log("Poll: entries=%u polled=%u",
+                       static_cast<uint32_t>(stats.poll_mode_entries),
+                       static_cast<uint32_t>(stats.polled_completions));
+
+      bool match = true;
+      for (size_t i = 0; i < kBatch * kSectorSize; ++i) {
+        if (g_large_buf[i] != static_cast<uint8_t>((i * 5) ^ (i >> 9) ^ 0xA5)) {
+          match = false;
+          break;
+        }
+      }
+      EXPECT_TRUE(match, "Poll: polled reads return written data");
+
+      // 恢复中断模式后同步路径仍可用
+      Memzero(g_data_buf, kSectorSize);
+      EXPECT_TRUE(poll_blk.Read(kBaseSector, g_data_buf).has_value(),
+                  "Poll: sync read after polling");
+    }
+  }
+
+  // === 测试 32: FLUSH / GET_ID / WRITE_ZEROES / DISCARD ===
+  {
+    Memzero(g_dma_buf, kRequiredDmaSize);
+    auto cmd_result = VirtioBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(cmd_result.has_value(), "Cmd: Create() succeeds");
+    if (cmd_result.has_value()) {
+      auto& cmd_blk = *cmd_result;
+      using device_framework::virtio::blk::BlkDiscardWriteZeroes;
+      constexpr uint64_t kBaseSector = 700;
+      constexpr size_t kSectors = 8;
+
+      EXPECT_TRUE(cmd_blk.Flush().has_value(), "Cmd: sync Flush succeeds");
+
+      uint8_t id[device_framework::virtio::blk::kDeviceIdMaxLen + 1] = {};
+      EXPECT_TRUE(cmd_blk.GetId(id).has_value(), "Cmd: GET_ID succeeds");
+      RiscvTraits::Log("Cmd: device id '%s'", reinterpret_cast<char*>(id));
+
+      auto wz_limits = cmd_blk.GetWriteZeroesLimits();
+      RiscvTraits::Log("Cmd: write zeroes max_sectors=%u max_seg=%u",
+                       wz_limits.max_sectors, wz_limits.max_segments);
+      if (wz_limits.max_segments == 0) {
+        auto unsupported = cmd_blk.WriteZeroes(kBaseSector, kSectors);
+        EXPECT_FALSE(unsupported.has_value(),
+                     "Cmd: WriteZeroes rejected without feature");
+      } else {
+        for (size_t i = 0; i < kSectors * kSectorSize; ++i) {
+          g_large_buf[i] = static_cast<uint8_t>(i | 1);
+        }
+        bool written = true;
+        for (size_t s = 0; s < kSectors; ++s) {
+          written = written && cmd_blk.Write(kBaseSector + s,
+                                             g_large_buf + s * kSectorSize)
+                                   .has_value();
+        }
+        EXPECT_TRUE(written, "Cmd: pattern written");
+
+        // 同步清零前半段（可能拆分为多个范围）
+        EXPECT_TRUE(cmd_blk.WriteZeroes(kBaseSector, kSectors / 2).has_value(),
+                    "Cmd: sync WriteZeroes succeeds");
+
+        // 异步多段清零：后半段拆成两个范围放在一个请求里
+        alignas(16) static BlkDiscardWriteZeroes ranges[2] = {};
+        size_t range_count = wz_limits.max_segments >= 2 ? 2 : 1;
+        ranges[0] = {kBaseSector + kSectors / 2,
+                     static_cast<uint32_t>(range_count == 2 ? 2 : 4),
+                     {0, 0}};
+        ranges[1] = {kBaseSector + kSectors / 2 + 2, 2, {0, 0}};
+        auto enq = cmd_blk.EnqueueWriteZeroes(0, ranges, range_count,
+                                              reinterpret_cast<void*>(0x2E));
+        EXPECT_TRUE(enq.has_value(), "Cmd: EnqueueWriteZeroes succeeds");
+        cmd_blk.Kick(0);
+        bool done = false;
+        bool ok = false;
+        for (uint32_t spin = 0; spin < 100000000 && !done; ++spin) {
+          RiscvTraits::Rmb();
+          cmd_blk.HandleInterrupt([&](void* token,
+                                      device_framework::ErrorCode ec) {
+            if (token == reinterpret_cast<void*>(0x2E)) {
+              done = true;
+              ok = ec == device_framework::ErrorCode::kSuccess;
+            }
+          });
+        }
+        EXPECT_TRUE(done && ok, "Cmd: async multi-range WriteZeroes done");
+
+        bool zeroed = true;
+        for (size_t s = 0; s < kSectors && zeroed; ++s) {
+          Memzero(g_data_buf, kSectorSize);
+          g_data_buf[0] = 0xFF;
+          zeroed = cmd_blk.Read(kBaseSector + s, g_data_buf).has_value();
+          for (size_t i = 0; i < kSectorSize && zeroed; ++i) {
+            zeroed = g_data_buf[i] == 0;
+          }
+        }
+        EXPECT_TRUE(zeroed, "Cmd: zeroed sectors read back as zero");
+
+        // 超过 max_write_zeroes_seg 的请求被拒绝
+        auto too_many = cmd_blk.EnqueueWriteZeroes(
+            0, ranges, static_cast<size_t>(wz_limits.max_segments) + 1);
+        EXPECT_FALSE(too_many.has_value(), "Cmd: too many ranges rejected");
+      }
+
+      auto discard_limits = cmd_blk.GetDiscardLimits();
+      auto discard = cmd_blk.Discard(kBaseSector, kSectors);
+      if (discard_limits.max_segments == 0) {
+        EXPECT_FALSE(discard.has_value(),
+                     "Cmd: Discard rejected without feature");
+      } else {
+        EXPECT_TRUE(discard.has_value(), "Cmd: sync Discard succeeds");
+      }
+
+      auto bad_flush = cmd_blk.EnqueueFlush(VirtioBlkType::kMaxQueues);
+      EXPECT_FALSE(bad_flush.has_value(), "Cmd: invalid queue rejected");
+    }
+  }
+
+  // === 测试 33: BlkRequestQueue - 乱序提交的相邻请求合并为一个请求 ===
+  {
+    Memzero(g_dma_buf, kRequiredDmaSize);
+    auto rq_result = VirtioBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(rq_result.has_value(), "ReqQueue: Create() succeeds");
+    if (rq_result.has_value()) {
+      using RequestQueueType =
+          device_framework::virtio::blk::BlkRequestQueue<VirtioBlkType, 16>;
+      RequestQueueType rq(*rq_result);
+      constexpr size_t kCount = 8;
+      constexpr uint64_t kBaseSector = 800;
+      constexpr size_t kOrder[kCount] = {3, 4, 2, 5, 1, 6, 0, 7};
+
+      size_t completed = 0;
+      uint32_t token_mask = 0;
+      bool all_ok = true;
+      auto on_complete = [&](void* token, device_framework::ErrorCode ec) {
+        ++completed;
+        token_mask |= 1U << (reinterpret_cast<uintptr_t>(token) - 1);
+        all_ok = all_ok && ec == device_framework::ErrorCode::kSuccess;
+      };
+      auto wait_all = [&]() {
+        for (uint32_t spin = 0; spin < 100000000 && completed < kCount;
+             ++spin) {
+          RiscvTraits::Rmb();
+          rq.HandleInterrupt(on_complete);
+        }
+      };
+
+      auto pattern = [](size_t i) {
+        return static_cast<uint8_t>((i * 13) ^ (i >> 9) ^ 0x6B);
+      };
+      for (size_t i = 0; i < kCount * kSectorSize; ++i) {
+        g_large_buf[i] = pattern(i);
+      }
+      bool enq_ok = true;
+      for (size_t i : kOrder) {
+        device_framework::virtio::IoVec iov{
+            RiscvTraits::VirtToPhys(g_large_buf + i * kSectorSize),
+            kSectorSize};
+        enq_ok = enq_ok && rq.EnqueueWrite(kBaseSector + i, &iov, 1,
+                                           reinterpret_cast<void*>(i + 1))
+                               .has_value();
+      }
+      EXPECT_TRUE(enq_ok, "ReqQueue: writes queued");
+      EXPECT_EQ(1u, rq.GetPendingCount(), "ReqQueue: writes merged");
+      auto dispatched = rq.Dispatch();
+      EXPECT_TRUE(dispatched.has_value() && *dispatched == 1,
+                  "ReqQueue: one merged write dispatched");
+      wait_all();
+      EXPECT_EQ(kCount, completed, "ReqQueue: every write completed");
+      EXPECT_EQ(0xFFu, token_mask, "ReqQueue: original tokens returned");
+      EXPECT_TRUE(all_ok, "ReqQueue: merged write succeeded");
+
+      auto stats = rq.GetStats();
+      EXPECT_TRUE(stats.back_merges > 0 && stats.front_merges > 0,
+                  "ReqQueue: front and back merges");
+      RiscvTraits::Log("ReqQueue: submitted=%u dispatched=%u",
+                       static_cast<uint32_t>(stats.submitted),
+                       static_cast<uint32_t>(stats.dispatched));
+
+      // 读回同一范围（反向提交）
+      Memzero(g_large_buf, kCount * kSectorSize);
+      completed = 0;
+      token_mask = 0;
+      for (size_t i = kCount; i > 0; --i) {
+        device_framework::virtio::IoVec iov{
+            RiscvTraits::VirtToPhys(g_large_buf + (i - 1) * kSectorSize),
+            kSectorSize};
+        (void)rq.EnqueueRead(kBaseSector + i - 1, &iov, 1,
+                             reinterpret_cast<void*>(i));
+      }
+      (void)rq.Dispatch();
+      wait_all();
+      EXPECT_EQ(kCount, completed, "ReqQueue: every read completed");
+      bool match = true;
+      for (size_t i = 0; i < kCount * kSectorSize; ++i) {
+        if (g_large_buf[i] != pattern(i)) {
+          match = false;
+          break;
+        }
+      }
+      EXPECT_TRUE(match, "ReqQueue: merged read returns written data");
+
+      device_framework::virtio::IoVec bad{
+          RiscvTraits::VirtToPhys(g_data_buf), kSectorSize / 2};
+      EXPECT_FALSE(rq.EnqueueRead(kBaseSector, &bad, 1).has_value(),
+                   "ReqQueue: partial sector rejected");
+    }
+  }
+
+  // === 测试 34: DmaCoherencyTraits - 共享内存的缓存维护 ===
+  {
+    using NcBlkType =
+        device_framework::virtio::blk::VirtioBlk<NonCoherentTraits>;
+    static_assert(device_framework::DmaCoherencyTraits<NonCoherentTraits>);
+    static_assert(!device_framework::DmaCoherencyTraits<RiscvTraits>);
+    static_assert(kDmaBufSize >= NcBlkType::CalcDmaSize(),
+                  "g_dma_buf too small for non-coherent VirtioBlk");
+    Memzero(g_dma_buf, NcBlkType::CalcDmaSize());
+    NonCoherentTraits::clean_count = 0;
+    auto nc_result = NcBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(nc_result.has_value(), "NonCoherent: Create() succeeds");
+    EXPECT_TRUE(NonCoherentTraits::clean_count > 0,
+                "NonCoherent: Create() cleans the queue region");
+    if (nc_result.has_value()) {
+      auto& nc_blk = *nc_result;
+      for (size_t i = 0; i < kSectorSize; ++i) {
+        g_data_buf[i] = static_cast<uint8_t>(i ^ 0xC3);
+      }
+      uint32_t cleans = NonCoherentTraits::clean_count;
+      EXPECT_TRUE(nc_blk.Write(1100, g_data_buf).has_value(),
+                  "NonCoherent: Write succeeds");
+      EXPECT_TRUE(NonCoherentTraits::clean_count > cleans,
+                  "NonCoherent: Write cleans shared memory");
+
+      Memzero(g_data_buf, kSectorSize);
+      NonCoherentTraits::invalidate_count = 0;
+      NonCoherentTraits::invalidated_bytes = 0;
+      EXPECT_TRUE(nc_blk.Read(1100, g_data_buf).has_value(),
+                  "NonCoherent: Read succeeds");
+      EXPECT_TRUE(NonCoherentTraits::invalidate_count > 0,
+                  "NonCoherent: completion invalidates used ring");
+      EXPECT_TRUE(NonCoherentTraits::invalidated_bytes >= kSectorSize + 1,
+                  "NonCoherent: data buffer and status invalidated");
+      EXPECT_EQ(static_cast<uint8_t>(9 ^ 0xC3), g_data_buf[9],
+                "NonCoherent: Read returns written data");
+    }
+  }
+
+  // === 测试 35: TelemetryTraits - 延迟直方图与在途深度 ===
+  {
+    using TelBlkType =
+        device_framework::virtio::blk::VirtioBlk<TelemetryEnabledTraits>;
+    using device_framework::virtio::blk::RequestClass;
+    static_assert(!device_framework::TelemetryTraits<RiscvTraits>);
+    static_assert(sizeof(TelBlkType) >= sizeof(VirtioBlkType));
+    Memzero(g_dma_buf, TelBlkType::CalcDmaSize());
+    auto tel_result = TelBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(tel_result.has_value(), "Telemetry: Create() succeeds");
+    if (tel_result.has_value()) {
+      auto& tel_blk = *tel_result;
+      constexpr size_t kTelRequests = 4;
+      EXPECT_TRUE(tel_blk.GetTelemetry(tel_blk.GetQueueCount()) == nullptr,
+                  "Telemetry: invalid queue index returns nullptr");
+      for (size_t i = 0; i < kSectorSize; ++i) {
+        g_data_buf[i] = static_cast<uint8_t>(i ^ 0x3E);
+      }
+      EXPECT_TRUE(tel_blk.Write(1200, g_data_buf).has_value(),
+                  "Telemetry: Write succeeds");
+      bool submitted = true;
+      for (size_t i = 0; i < kTelRequests; ++i) {
+        submitted =
+            submitted &&
+            tel_blk.Read(1200, g_large_buf + i * kSectorSize).has_value();
+      }
+      EXPECT_TRUE(submitted, "Telemetry: Reads succeed");
+
+      const auto* telemetry = tel_blk.GetTelemetry(0);
+      EXPECT_TRUE(telemetry != nullptr, "Telemetry: GetTelemetry(0)");
+      if (telemetry != nullptr) {
+        auto read = static_cast<size_t>(RequestClass::kRead);
+        auto write = static_cast<size_t>(RequestClass::kWrite);
+        EXPECT_EQ(static_cast<uint64_t>(kTelRequests),
+                  telemetry->submitted[read], "Telemetry: reads submitted");
+        EXPECT_EQ(static_cast<uint64_t>(kTelRequests),
+                  telemetry->completed[read], "Telemetry: reads completed");
+        EXPECT_EQ(1u, telemetry->completed[write],
+                  "Telemetry: write completed");
+        EXPECT_EQ(0u, telemetry->errors[read], "Telemetry: no read errors");
+        EXPECT_EQ(0u, telemetry->inflight, "Telemetry: nothing in flight");
+        EXPECT_EQ(static_cast<uint64_t>(kTelRequests),
+                  telemetry->latency[read].count,
+                  "Telemetry: read latencies recorded");
+        EXPECT_TRUE(telemetry->latency[read].max > 0,
+                    "Telemetry: read latency is non-zero");
+        EXPECT_TRUE(telemetry->latency[read].Percentile(500) <=
+                        telemetry->latency[read].Percentile(990),
+                    "Telemetry: percentiles are monotonic");
+        EXPECT_TRUE(telemetry->inflight_depth.count == kTelRequests + 1 &&
+                        telemetry->max_inflight >= 1,
+                    "Telemetry: in-flight depth recorded per submit");
+        EXPECT_TRUE(telemetry->completion_batch.count > 0,
+                    "Telemetry: completion batches recorded");
+        RiscvTraits::Log(
+            "Telemetry: read p50 <= %u cycles, p99 <= %u cycles",
+            static_cast<uint32_t>(telemetry->latency[read].Percentile(500)),
+            static_cast<uint32_t>(telemetry->latency[read].Percentile(990)));
+      }
+      tel_blk.ResetTelemetry(0);
+      EXPECT_EQ(0u, tel_blk.GetTelemetry(0)->latency[0].count,
+                "Telemetry: ResetTelemetry() clears histograms");
+    }
+  }
+
+  // === 测试 36: ConcurrentSubmitTraits - 并发提交模式 ===
+  {
+    using CsBlkType =
+        device_framework::virtio::blk::VirtioBlk<ConcurrentTraits>;
+    static_assert(device_framework::ConcurrentSubmitTraits<ConcurrentTraits>);
+    static_assert(!device_framework::ConcurrentSubmitTraits<RiscvTraits>);
+    Memzero(g_dma_buf, CsBlkType::CalcDmaSize());
+    auto cs_result = CsBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(cs_result.has_value(), "Concurrent: Create() succeeds");
+    if (cs_result.has_value()) {
+      auto& cs_blk = *cs_result;
+      constexpr size_t kCsRequests = 8;
+      constexpr uint64_t kCsSector = 1300;
+      for (size_t i = 0; i < kCsRequests * kSectorSize; ++i) {
+        g_large_buf[i] = static_cast<uint8_t>((i * 11) ^ (i >> 9));
+      }
+      device_framework::virtio::IoVec iovs[kCsRequests];
+      bool enqueued = true;
+      for (size_t i = 0; i < kCsRequests; ++i) {
+        iovs[i] = {RiscvTraits::VirtToPhys(g_large_buf + i * kSectorSize),
+                   kSectorSize};
+        enqueued = enqueued && cs_blk
+                                   .EnqueueWrite(0, kCsSector + i, &iovs[i], 1,
+                                                 &iovs[i])
+                                   .has_value();
+      }
+      EXPECT_TRUE(enqueued, "Concurrent: EnqueueWrite succeeds");
+      cs_blk.Kick(0);
+
+      size_t completed = 0;
+      bool all_ok = true;
+      for (uint32_t spin = 0; spin < 100000000 && completed < kCsRequests;
+           ++spin) {
+        cs_blk.HandleInterrupt(
+            0, [&completed, &all_ok](void* /*token*/,
+                                     device_framework::ErrorCode status) {
+              all_ok = all_ok &&
+                       status == device_framework::ErrorCode::kSuccess;
+              ++completed;
+            });
+      }
+      EXPECT_EQ(static_cast<uint64_t>(kCsRequests),
+                static_cast<uint64_t>(completed),
+                "Concurrent: all writes complete");
+      EXPECT_TRUE(all_ok, "Concurrent: writes succeed");
+
+      Memzero(g_data_buf, kSectorSize);
+      EXPECT_TRUE(cs_blk.Read(kCsSector + 5, g_data_buf).has_value(),
+                  "Concurrent: synchronous Read succeeds");
+      bool match = true;
+      for (size_t i = 0; i < kSectorSize && match; ++i) {
+        size_t off = 5 * kSectorSize + i;
+        match = g_data_buf[i] == static_cast<uint8_t>((off * 11) ^ (off >> 9));
+      }
+      EXPECT_TRUE(match, "Concurrent: Read returns written data");
+    }
+  }
+
+  // === 测试 37: FeatureSet - 编译期固定特性集 ===
+  {
+    using device_framework::virtio::FeatureSet;
+    using device_framework::virtio::ReservedFeature;
+    using device_framework::virtio::blk::BlkFeatureBit;
+    // 只开启 FLUSH：EVENT_IDX / MQ / DISCARD 等路径在编译期消除
+    using FsBlkType = device_framework::virtio::blk::VirtioBlk<
+        RiscvTraits, device_framework::virtio::MmioTransport,
+        device_framework::virtio::SplitVirtqueue, 64,
+        FeatureSet<BlkFeatureBit::kFlush>>;
+    static_assert(FsBlkType::kMaxQueues == 1,
+                  "FeatureSet without MQ keeps a single queue context");
+    Memzero(g_dma_buf, FsBlkType::CalcDmaSize());
+    auto fs_result = FsBlkType::Create(blk_base, g_dma_buf, 2);
+    EXPECT_TRUE(fs_result.has_value(), "FeatureSet: Create() succeeds");
+    if (fs_result.has_value()) {
+      auto& fs_blk = *fs_result;
+      auto features = fs_blk.GetNegotiatedFeatures();
+      EXPECT_EQ(0ULL,
+                features & (static_cast<uint64_t>(ReservedFeature::kEventIdx) |
+                            static_cast<uint64_t>(BlkFeatureBit::kMq) |
+                            static_cast<uint64_t>(BlkFeatureBit::kDiscard)),
+                "FeatureSet: disabled features not negotiated");
+      EXPECT_EQ(static_cast<uint16_t>(1), fs_blk.GetQueueCount(),
+                "FeatureSet: single queue without MQ");
+      EXPECT_TRUE(fs_blk.SupportsFlush(), "FeatureSet: FLUSH enabled");
+
+      for (size_t i = 0; i < kSectorSize; ++i) {
+        g_data_buf[i] = static_cast<uint8_t>(i ^ 0x3C);
+      }
+      constexpr uint64_t kFsSector = 1400;
+      EXPECT_TRUE(fs_blk.Write(kFsSector, g_data_buf).has_value(),
+                  "FeatureSet: Write succeeds");
+      Memzero(g_data_buf, kSectorSize);
+      EXPECT_TRUE(fs_blk.Read(kFsSector, g_data_buf).has_value(),
+                  "FeatureSet: Read succeeds");
+      bool match = true;
+      for (size_t i = 0; i < kSectorSize && match; ++i) {
+        match = g_data_buf[i] == static_cast<uint8_t>(i ^ 0x3C);
+      }
+      EXPECT_TRUE(match, "FeatureSet: Read returns written data");
+      EXPECT_TRUE(fs_blk.Flush().has_value(), "FeatureSet: Flush succeeds");
+      EXPECT_EQ(0ULL, fs_blk.GetStats().kicks_elided,
+                "FeatureSet: every kick notifies without EVENT_IDX");
+      EXPECT_FALSE(fs_blk.Discard(kFsSector, 1).has_value(),
+                   "FeatureSet: Discard rejected when compiled out");
+    }
+
+    // 设备不提供的特性（QEMU 未实现 LIFETIME）使 Create() 失败
+    using StrictBlkType = device_framework::virtio::blk::VirtioBlk<
+        RiscvTraits, device_framework::virtio::MmioTransport,
+        device_framework::virtio::SplitVirtqueue, 64,
+        FeatureSet<BlkFeatureBit::kLifetime>>;
+    Memzero(g_dma_buf, StrictBlkType::CalcDmaSize());
+    auto strict_result = StrictBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(!strict_result.has_value() &&
+                    strict_result.error().code ==
+                        device_framework::ErrorCode::kFeatureNegotiationFailed,
+                "FeatureSet: missing required feature fails Create()");
+  }
+
+  // === 测试 38: 配置快照 - 只在配置变更后重新读取 ===
+  {
+    Memzero(g_dma_buf, kRequiredDmaSize);
+    auto cfg_result = VirtioBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(cfg_result.has_value(), "Config: Create() succeeds");
+    if (cfg_result.has_value()) {
+      auto& cfg_blk = *cfg_result;
+      const auto& snapshot = cfg_blk.ReadConfig();
+      EXPECT_EQ(snapshot.capacity, cfg_blk.GetCapacity(),
+                "Config: GetCapacity() served from snapshot");
+      EXPECT_FALSE(cfg_blk.RefreshConfig(),
+                   "Config: RefreshConfig() keeps unchanged snapshot");
+
+      auto before = cfg_blk.GetStats();
+      cfg_blk.HandleConfigChange();
+      EXPECT_EQ(before.config_changes + 1, cfg_blk.GetStats().config_changes,
+                "Config: HandleConfigChange() counted");
+      EXPECT_TRUE(cfg_blk.RefreshConfig(),
+                  "Config: snapshot reloaded after config change");
+      EXPECT_EQ(snapshot.capacity, cfg_blk.ReadConfig().capacity,
+                "Config: reloaded capacity matches");
+    }
+  }
+
+  // === 测试 39: BlkRequestQueue - 合并请求不跨越最优 I/O 边界 ===
+  {
+    Memzero(g_dma_buf, kRequiredDmaSize);
+    auto bound_result = VirtioBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(bound_result.has_value(), "Boundary: Create() succeeds");
+    if (bound_result.has_value()) {
+      using RequestQueueType =
+          device_framework::virtio::blk::BlkRequestQueue<VirtioBlkType, 16>;
+      RequestQueueType rq(*bound_result);
+      constexpr size_t kCount = 8;
+      constexpr uint64_t kBaseSector = 800;
+      constexpr uint64_t kBoundary = 4;
+      rq.SetMergeBoundary(kBoundary);
+      EXPECT_EQ(kBoundary, rq.GetMergeBoundary(),
+                "Boundary: SetMergeBoundary() applied");
+
+      size_t completed = 0;
+      bool all_ok = true;
+      auto on_complete = [&](void*, device_framework::ErrorCode ec) {
+        ++completed;
+        all_ok = all_ok && ec == device_framework::ErrorCode::kSuccess;
+      };
+
+      bool enq_ok = true;
+      for (size_t i = 0; i < kCount; ++i) {
+        device_framework::virtio::IoVec iov{
+            RiscvTraits::VirtToPhys(g_large_buf + i * kSectorSize),
+            kSectorSize};
+        enq_ok = enq_ok && rq.EnqueueWrite(kBaseSector + i, &iov, 1,
+                                           reinterpret_cast<void*>(i + 1))
+                               .has_value();
+      }
+      EXPECT_TRUE(enq_ok, "Boundary: writes queued");
+      EXPECT_EQ(static_cast<size_t>(kCount / kBoundary), rq.GetPendingCount(),
+                "Boundary: one merged write per boundary interval");
+      EXPECT_TRUE(rq.GetStats().boundary_splits > 0,
+                  "Boundary: merges refused at boundary");
+
+      auto dispatched = rq.Dispatch();
+      EXPECT_TRUE(dispatched.has_value() && *dispatched == kCount / kBoundary,
+                  "Boundary: merged writes dispatched");
+      for (uint32_t spin = 0; spin < 100000000 && completed < kCount;
+           ++spin) {
+        RiscvTraits::Rmb();
+        rq.HandleInterrupt(on_complete);
+      }
+      EXPECT_EQ(kCount, completed, "Boundary: every write completed");
+      EXPECT_TRUE(all_ok, "Boundary: writes succeeded");
+    }
+  }
+
+  // === 测试 40: Quiesce / Resume / Restore - 不重新协商的快速恢复 ===
+  {
+    Memzero(g_dma_buf, kRequiredDmaSize);
+    auto qr_result = VirtioBlkType::Create(blk_base, g_dma_buf);
+    EXPECT_TRUE(qr_result.has_value(), "Quiesce: Create() succeeds");
+    if (qr_result.has_value()) {
+      auto& qr_blk = *qr_result;
+      constexpr size_t kCount = 8;
+      constexpr uint64_t kBaseSector = 900;
+      for (size_t i = 0; i < kCount * kSectorSize; ++i) {
+        g_large_buf[i] = static_cast<uint8_t>((i / kSectorSize) ^ 0x5A);
+      }
+
+      size_t completed = 0;
+      bool all_ok = true;
+      auto on_complete = [&](void*, device_framework::ErrorCode ec) {
+        ++completed;
+        all_ok = all_ok && ec == device_framework::ErrorCode::kSuccess;
+      };
+      for (size_t i = 0; i < kCount; ++i) {
+        device_framework::virtio::IoVec iov{
+            RiscvTraits::VirtToPhys(g_large_buf + i * kSectorSize),
+            kSectorSize};
+        (void)qr_blk.EnqueueWrite(0, kBaseSector + i, &iov, 1);
+      }
+      EXPECT_EQ(static_cast<size_t>(0), qr_blk.Quiesce(on_complete),
+                "Quiesce: drain cancels nothing");
+      EXPECT_EQ(kCount, completed, "Quiesce: in-flight writes drained");
+      EXPECT_TRUE(all_ok, "Quiesce: drained writes succeeded");
+      EXPECT_FALSE(qr_blk.Read(kBaseSector, g_data_buf).has_value(),
+                   "Quiesce: submission rejected while quiesced");
+
+      EXPECT_TRUE(qr_blk.Resume().has_value(), "Quiesce: Resume() succeeds");
+      Memzero(g_data_buf, kSectorSize);
+      EXPECT_TRUE(qr_blk.Read(kBaseSector + 3, g_data_buf).has_value(),
+                  "Quiesce: read after Resume()");
+      bool persisted = true;
+      for (size_t i = 0; i < kSectorSize; ++i) {
+        persisted =
+            persisted && g_data_buf[i] == g_large_buf[3 * kSectorSize + i];
+      }
+      EXPECT_TRUE(persisted, "Quiesce: data written before quiesce persisted");
+
+      (void)qr_blk.Quiesce(on_complete);
+      auto restored = VirtioBlkType::Restore(blk_base, g_dma_buf,
+                                             qr_blk.GetResumeState());
+      EXPECT_TRUE(restored.has_value(), "Quiesce: Restore() succeeds");
+      if (restored.has_value()) {
+        Memzero(g_data_buf, kSectorSize);
+        EXPECT_TRUE(restored->Read(kBaseSector + 5, g_data_buf).has_value(),
+                    "Quiesce: read through restored driver");
+        bool restored_match = true;
+        for (size_t i = 0; i < kSectorSize; ++i) {
+          restored_match = restored_match &&
+                           g_data_buf[i] == g_large_buf[5 * kSectorSize + i];
+        }
+        EXPECT_TRUE(restored_match, "Quiesce: restored read matches");
+      }
+    }
+  }
+
   TEST_SUITE_END();
 }
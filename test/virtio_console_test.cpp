@@ -0,0 +1,130 @@
+/**
+ * @file virtio_console_test.cpp
+ * @brief VirtIO 控制台设备驱动测试
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 测试内容：
+ * 1. 扫描 MMIO 设备，找到控制台设备 (Device ID == 3)
+ * 2. VirtioConsole::Create() 初始化与多端口发现
+ * 3. 通过 CharDevice 接口打开控制台端口并批量写入
+ * 4. 批量写入只占用一个描述符，且发送缓冲区被回收
+ * 5. 未添加端口的参数校验与非阻塞读取
+ */
+
+#include "device_framework/virtio_console.hpp"
+
+#include <cstdint>
+
+#include "test.h"
+#include "test_env.h"
+
+namespace {
+
+/// VirtIO 控制台设备的 Device ID
+constexpr uint32_t kConsoleDeviceId = 3;
+/// 测试使用的队列大小
+constexpr uint32_t kConsoleQueueSize = 8;
+/// 测试驱动支持的端口数（与 QEMU max_ports=2 一致）
+constexpr uint32_t kConsolePorts = 2;
+/// 单次批量写入的字节数（不超过一个发送缓冲区）
+constexpr size_t kBulkLen = 3000;
+/// 等待发送完成的最大轮询次数
+constexpr uint32_t kMaxPollIterations = 10000000;
+
+using ConsoleType = device_framework::virtio::console::VirtioConsole<
+    RiscvTraits, device_framework::virtio::MmioTransport,
+    device_framework::virtio::SplitVirtqueue, kConsolePorts>;
+using ConsoleDeviceType =
+    device_framework::virtio::console::VirtioConsoleDevice<
+        RiscvTraits, device_framework::virtio::MmioTransport,
+        device_framework::virtio::SplitVirtqueue, kConsolePorts>;
+
+/// 批量写入的数据
+uint8_t g_bulk_buf[kBulkLen];
+
+}  // namespace
+
+void test_virtio_console() {
+  TEST_SUITE_BEGIN("VirtIO Console");
+
+  // === 测试 1: 查找控制台设备 ===
+  auto bus = device_framework::virtio::VirtioMmioBus<RiscvTraits>::Scan(
+      kVirtioMmioBase, kVirtioMmioSize, kMaxVirtioDevices);
+  auto info = bus.Find(kConsoleDeviceId);
+  EXPECT_TRUE(info.has_value(), "Find virtio-console device");
+  if (!info.has_value()) {
+    LOG("No virtio-console device found, skipping remaining tests");
+    TEST_SUITE_END();
+    return;
+  }
+  LOG_HEX("virtio-console at", info->base);
+
+  // === 测试 2: Create() 与端口发现 ===
+  size_t dma_size = ConsoleType::CalcDmaSize(kConsoleQueueSize);
+  EXPECT_TRUE(dma_size <= kDmaBufSize, "DMA layout fits in test buffer");
+  Memzero(g_dma_buf, dma_size);
+  auto console_result =
+      ConsoleType::Create(info->base, g_dma_buf, kConsoleQueueSize);
+  EXPECT_TRUE(console_result.has_value(), "VirtioConsole::Create()");
+  if (!console_result.has_value()) {
+    TEST_SUITE_END();
+    return;
+  }
+  auto& console = *console_result;
+  EXPECT_EQ(kConsolePorts, console.GetPortCount(),
+            "Port count follows max_nr_ports");
+  EXPECT_TRUE(console.IsPortAdded(0), "Device added port 0");
+  EXPECT_TRUE(console.IsConsolePort(0), "Port 0 is the console port");
+  EXPECT_FALSE(console.IsPortAdded(1), "Port 1 has no backend");
+
+  // === 测试 3: CharDevice 打开与批量写入 ===
+  ConsoleDeviceType tty(console, 0);
+  EXPECT_TRUE(tty.OpenReadWrite().has_value(), "Open console port");
+
+  for (size_t i = 0; i < kBulkLen; ++i) {
+    g_bulk_buf[i] = static_cast<uint8_t>('a' + i % 26);
+  }
+  auto write_result = tty.Write(g_bulk_buf);
+  EXPECT_TRUE(write_result.has_value(), "Bulk Write()");
+  if (write_result.has_value()) {
+    EXPECT_EQ(kBulkLen, *write_result, "Bulk Write() queues all bytes");
+  }
+
+  // === 测试 4: 一个描述符，发送缓冲区回收 ===
+  auto stats = console.GetStats(0);
+  EXPECT_EQ(1U, stats.tx_buffers, "Bulk write uses one descriptor");
+  EXPECT_EQ(static_cast<uint64_t>(kBulkLen), stats.tx_bytes,
+            "TX bytes counted");
+  EXPECT_TRUE(stats.kicks + stats.kicks_elided >= 1, "Bulk write kicked");
+
+  // 连续写入超过发送队列深度的次数，验证缓冲区被回收
+  bool all_written = true;
+  for (uint32_t round = 0; round < kConsoleQueueSize * 2; ++round) {
+    auto result = tty.Write(std::span<const uint8_t>(g_bulk_buf, 64));
+    all_written = all_written && result.has_value() && *result == 64;
+  }
+  EXPECT_TRUE(all_written, "TX buffers are recycled across queue wrap");
+
+  bool writable = false;
+  for (uint32_t i = 0; i < kMaxPollIterations && !writable; ++i) {
+    auto events = tty.Poll(
+        device_framework::PollEvents{device_framework::PollEvents::kOut});
+    writable = events.has_value() && events->HasOut();
+  }
+  EXPECT_TRUE(writable, "Poll() reports kOut");
+
+  // === 测试 5: 参数校验与非阻塞读取 ===
+  EXPECT_FALSE(console.Write(1, std::span<const uint8_t>(g_bulk_buf, 1))
+                   .has_value(),
+               "Write() rejects port without backend");
+  EXPECT_FALSE(console.Write(kConsolePorts, g_bulk_buf).has_value(),
+               "Write() rejects out-of-range port");
+  {
+    uint8_t rx[16];
+    auto read_result = tty.Read(rx);
+    EXPECT_TRUE(read_result.has_value(), "Read() does not block");
+  }
+  EXPECT_TRUE(tty.Release().has_value(), "Release console port");
+
+  TEST_SUITE_END();
+}
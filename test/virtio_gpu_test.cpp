@@ -0,0 +1,167 @@
+/**
+ * @file virtio_gpu_test.cpp
+ * @brief VirtIO GPU 设备驱动测试
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 测试内容：
+ * 1. 扫描 MMIO 设备，找到 GPU 设备 (Device ID == 16)
+ * 2. VirtioGpuDevice::Create() 创建资源并设置扫描输出
+ * 3. 通过 FramebufferDevice 接口打开设备并 Mmap 后备存储
+ * 4. 重叠脏矩形合并，Present() 一批命令只 Kick 一次
+ * 5. Write 标记脏行，参数校验
+ */
+
+#include "device_framework/virtio_gpu.hpp"
+
+#include <cstdint>
+
+#include "test.h"
+#include "test_env.h"
+
+namespace {
+
+/// VirtIO GPU 设备的 Device ID
+constexpr uint32_t kGpuDeviceId = 16;
+/// 测试使用的分辨率
+constexpr uint32_t kFbWidth = 320;
+constexpr uint32_t kFbHeight = 200;
+/// 测试使用的控制队列大小
+constexpr uint32_t kGpuQueueSize = 32;
+/// 测试绘制的帧数
+constexpr uint32_t kFrames = 4;
+
+using GpuDeviceType = device_framework::virtio::gpu::VirtioGpuDevice<
+    RiscvTraits, device_framework::virtio::MmioTransport,
+    device_framework::virtio::SplitVirtqueue>;
+
+/// 帧缓冲后备存储
+constexpr size_t kFbSize =
+    GpuDeviceType::DriverType::CalcFramebufferSize(kFbWidth, kFbHeight);
+alignas(4096) uint8_t g_fb_buf[kFbSize];
+
+/// @brief 以 Mmap 返回的地址填充一个矩形
+void FillRect(uintptr_t base, uint32_t stride,
+              const device_framework::FramebufferRect& rect, uint32_t color) {
+  for (uint32_t y = rect.y; y < rect.y + rect.height; ++y) {
+    auto* row = reinterpret_cast<uint32_t*>(base + y * stride);
+    for (uint32_t x = rect.x; x < rect.x + rect.width; ++x) {
+      row[x] = color;
+    }
+  }
+}
+
+}  // namespace
+
+void test_virtio_gpu() {
+  TEST_SUITE_BEGIN("VirtIO GPU");
+
+  // === 测试 1: 查找 GPU 设备 ===
+  auto bus = device_framework::virtio::VirtioMmioBus<RiscvTraits>::Scan(
+      kVirtioMmioBase, kVirtioMmioSize, kMaxVirtioDevices);
+  auto info = bus.Find(kGpuDeviceId);
+  EXPECT_TRUE(info.has_value(), "Find virtio-gpu device");
+  if (!info.has_value()) {
+    LOG("No virtio-gpu device found, skipping remaining tests");
+    TEST_SUITE_END();
+    return;
+  }
+  LOG_HEX("virtio-gpu at", info->base);
+
+  // === 测试 2: Create() ===
+  size_t dma_size = GpuDeviceType::CalcDmaSize(kGpuQueueSize);
+  EXPECT_TRUE(dma_size <= kDmaBufSize, "DMA layout fits in test buffer");
+  Memzero(g_dma_buf, dma_size);
+  auto fb_result =
+      GpuDeviceType::Create(info->base, g_dma_buf, g_fb_buf, kFbSize, kFbWidth,
+                            kFbHeight, kGpuQueueSize);
+  EXPECT_TRUE(fb_result.has_value(), "VirtioGpuDevice::Create()");
+  if (!fb_result.has_value()) {
+    TEST_SUITE_END();
+    return;
+  }
+  auto& fb = *fb_result;
+  auto& gpu = fb.GetDriver();
+  EXPECT_EQ(0U, gpu.GetStats().errors, "Scanout setup succeeded");
+  EXPECT_EQ(1U, gpu.GetStats().batches, "Scanout setup is one batch");
+
+  // === 测试 3: 打开并映射后备存储 ===
+  EXPECT_FALSE(fb.GetInfo().has_value(), "GetInfo() before Open fails");
+  EXPECT_TRUE(fb.OpenReadWrite().has_value(), "Open framebuffer");
+  auto fb_info = fb.GetInfo();
+  EXPECT_TRUE(fb_info.has_value(), "GetInfo()");
+  if (!fb_info.has_value()) {
+    TEST_SUITE_END();
+    return;
+  }
+  EXPECT_EQ(kFbWidth, fb_info->width, "Width");
+  EXPECT_EQ(kFbHeight, fb_info->height, "Height");
+  EXPECT_EQ(kFbWidth * 4, fb_info->stride, "Stride");
+
+  auto mapping = fb.Mmap(
+      0, kFbSize,
+      device_framework::ProtFlags{device_framework::ProtFlags::kRead |
+                                  device_framework::ProtFlags::kWrite},
+      device_framework::MapFlags{device_framework::MapFlags::kShared}, 0);
+  EXPECT_TRUE(mapping.has_value(), "Mmap() backing store");
+  if (!mapping.has_value()) {
+    TEST_SUITE_END();
+    return;
+  }
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(g_fb_buf), *mapping,
+            "Mmap() returns backing store address");
+
+  // === 测试 4: 脏矩形合并与每帧一次 Kick ===
+  bool all_presented = true;
+  for (uint32_t frame = 0; frame < kFrames; ++frame) {
+    auto before = gpu.GetStats();
+    device_framework::FramebufferRect a{10 + frame, 10, 40, 30};
+    device_framework::FramebufferRect b{30 + frame, 20, 40, 30};
+    device_framework::FramebufferRect c{200, 150, 20, 20};
+    FillRect(*mapping, fb_info->stride, a, 0x00FF0000U);
+    FillRect(*mapping, fb_info->stride, b, 0x0000FF00U);
+    FillRect(*mapping, fb_info->stride, c, 0x000000FFU);
+    (void)fb.MarkDirty(a);
+    (void)fb.MarkDirty(b);
+    (void)fb.MarkDirty(c);
+    if (frame == 0) {
+      EXPECT_EQ(static_cast<size_t>(2), gpu.GetDirtyCount(),
+                "Overlapping rects merged");
+    }
+    all_presented = all_presented && fb.Present().has_value();
+    auto after = gpu.GetStats();
+    // 两个脏矩形各一条 TRANSFER_TO_HOST_2D，加一条 RESOURCE_FLUSH
+    all_presented = all_presented && after.commands - before.commands == 3 &&
+                    after.batches - before.batches == 1 &&
+                    (after.kicks + after.kicks_elided) -
+                            (before.kicks + before.kicks_elided) ==
+                        1;
+  }
+  EXPECT_TRUE(all_presented, "Present() is one batch and one kick per frame");
+  EXPECT_TRUE(gpu.WaitIdle().has_value(), "WaitIdle() after present");
+  EXPECT_EQ(0U, gpu.GetStats().errors, "No device error responses");
+
+  // === 测试 5: Write 标记脏行，参数校验 ===
+  {
+    uint8_t row[64] = {};
+    auto write_result = fb.Write(row, fb_info->stride * 5 + 16);
+    EXPECT_TRUE(write_result.has_value(), "Write() into framebuffer");
+    EXPECT_EQ(static_cast<size_t>(1), gpu.GetDirtyCount(),
+              "Write() marks touched rows dirty");
+    EXPECT_TRUE(fb.Present().has_value(), "Present() after Write()");
+  }
+  EXPECT_FALSE(
+      fb.Mmap(0, kFbSize, device_framework::ProtFlags{},
+              device_framework::MapFlags{device_framework::MapFlags::kShared},
+              4096 + kFbSize)
+          .has_value(),
+      "Mmap() rejects out-of-range offset");
+  EXPECT_EQ(static_cast<size_t>(0), gpu.GetDirtyCount(),
+            "Present() clears dirty rects");
+  (void)fb.MarkDirty({kFbWidth, kFbHeight, 10, 10});
+  EXPECT_EQ(static_cast<size_t>(0), gpu.GetDirtyCount(),
+            "Off-screen rect ignored");
+  EXPECT_TRUE(gpu.WaitIdle().has_value(), "WaitIdle()");
+  EXPECT_TRUE(fb.Release().has_value(), "Release framebuffer");
+
+  TEST_SUITE_END();
+}
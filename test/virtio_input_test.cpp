@@ -0,0 +1,96 @@
+/**
+ * @file virtio_input_test.cpp
+ * @brief VirtIO 输入设备驱动测试
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 测试内容：
+ * 1. 扫描 MMIO 设备，找到输入设备 (Device ID == 18)
+ * 2. VirtioInputDevice::Create() 预投递整个事件环
+ * 3. Open 时缓存设备配置（名称、事件类型位图）
+ * 4. 非阻塞批量读取与参数校验
+ */
+
+#include "device_framework/virtio_input.hpp"
+
+#include <cstdint>
+
+#include "test.h"
+#include "test_env.h"
+
+namespace {
+
+/// VirtIO 输入设备的 Device ID
+constexpr uint32_t kInputDeviceId = 18;
+/// 测试使用的事件队列大小
+constexpr uint32_t kInputQueueSize = 64;
+
+using InputDeviceType = device_framework::virtio::input::VirtioInputDevice<
+    RiscvTraits, device_framework::virtio::MmioTransport,
+    device_framework::virtio::SplitVirtqueue>;
+using device_framework::virtio::input::InputEvent;
+using device_framework::virtio::input::InputEventType;
+
+/// 事件读取缓冲区
+alignas(InputEvent) uint8_t g_event_buf[kInputQueueSize * sizeof(InputEvent)];
+
+}  // namespace
+
+void test_virtio_input() {
+  TEST_SUITE_BEGIN("VirtIO Input");
+
+  // === 测试 1: 查找输入设备 ===
+  auto bus = device_framework::virtio::VirtioMmioBus<RiscvTraits>::Scan(
+      kVirtioMmioBase, kVirtioMmioSize, kMaxVirtioDevices);
+  auto info = bus.Find(kInputDeviceId);
+  EXPECT_TRUE(info.has_value(), "Find virtio-input device");
+  if (!info.has_value()) {
+    LOG("No virtio-input device found, skipping remaining tests");
+    TEST_SUITE_END();
+    return;
+  }
+  LOG_HEX("virtio-input at", info->base);
+
+  // === 测试 2: Create() 预投递事件环 ===
+  size_t dma_size = InputDeviceType::CalcDmaSize(kInputQueueSize);
+  EXPECT_TRUE(dma_size <= kDmaBufSize, "DMA layout fits in test buffer");
+  Memzero(g_dma_buf, dma_size);
+  auto dev_result =
+      InputDeviceType::Create(info->base, g_dma_buf, kInputQueueSize);
+  EXPECT_TRUE(dev_result.has_value(), "VirtioInputDevice::Create()");
+  if (!dev_result.has_value()) {
+    TEST_SUITE_END();
+    return;
+  }
+  auto& dev = *dev_result;
+  auto& input = dev.GetDriver();
+  EXPECT_FALSE(input.IsConfigLoaded(), "Config not read before Open");
+
+  // === 测试 3: Open 时缓存配置 ===
+  device_framework::OpenFlags write_only{device_framework::OpenFlags::kWrite};
+  EXPECT_FALSE(dev.Open(write_only).has_value(), "Write-only open rejected");
+  EXPECT_TRUE(dev.OpenReadOnly().has_value(), "Open input device");
+  EXPECT_TRUE(input.IsConfigLoaded(), "Config cached at Open");
+  EXPECT_TRUE(input.GetName()[0] != '\0', "Device name is not empty");
+  LOG(input.GetName());
+  EXPECT_TRUE(input.HasEventType(static_cast<uint16_t>(InputEventType::kKey)),
+              "Device reports EV_KEY");
+  EXPECT_FALSE(input.HasEventType(0x1F), "Undefined event type not reported");
+
+  // === 测试 4: 非阻塞读取与参数校验 ===
+  auto read_result = dev.Read(g_event_buf);
+  EXPECT_TRUE(read_result.has_value(), "Read() does not block");
+  if (read_result.has_value()) {
+    EXPECT_EQ(static_cast<size_t>(0), *read_result % sizeof(InputEvent),
+              "Read() returns whole events");
+  }
+  EXPECT_FALSE(dev.Read(std::span<uint8_t>(g_event_buf, 4)).has_value(),
+               "Read() rejects buffer smaller than one event");
+  auto events = dev.Poll(
+      device_framework::PollEvents{device_framework::PollEvents::kIn});
+  EXPECT_TRUE(events.has_value(), "Poll()");
+  EXPECT_FALSE(dev.Write(std::span<const uint8_t>(g_event_buf, 8)).has_value(),
+               "Write() not supported");
+  EXPECT_TRUE(dev.Release().has_value(), "Release input device");
+
+  TEST_SUITE_END();
+}
@@ -0,0 +1,189 @@
+/**
+ * @file virtio_net_test.cpp
+ * @brief VirtIO 网络设备驱动测试
+ * @copyright Copyright The device_framework Contributors
+ *
+ * 测试内容：
+ * 1. 扫描 MMIO 设备，找到网络设备 (Device ID == 1)
+ * 2. VirtioNet::Create() 初始化与 MAC / 链路状态读取
+ * 3. 参数校验（队列对索引、IoVec 数量）
+ * 4. 发送 ARP 请求并接收 QEMU 用户网络网关的应答
+ * 5. 批量回收发送完成与接收缓冲区循环使用
+ */
+
+#include "device_framework/virtio_net.hpp"
+
+#include <cstdint>
+
+#include "test.h"
+#include "test_env.h"
+
+namespace {
+
+/// VirtIO 网络设备的 Device ID
+constexpr uint32_t kNetDeviceId = 1;
+/// 测试使用的队列大小（接收缓冲池 = 32 × 2048 字节）
+constexpr uint32_t kNetQueueSize = 32;
+/// 以太网最小帧长（不含 FCS）
+constexpr size_t kMinFrameLen = 60;
+/// 等待 ARP 应答的最大轮询次数
+constexpr uint32_t kMaxPollIterations = 10000000;
+
+/// QEMU 用户网络中本机与网关的 IPv4 地址
+constexpr uint8_t kGuestIp[4] = {10, 0, 2, 15};
+constexpr uint8_t kGatewayIp[4] = {10, 0, 2, 2};
+
+using NetType = device_framework::virtio::net::VirtioNet<RiscvTraits>;
+
+/**
+ * @brief 构造以 kGatewayIp 为目标的 ARP 请求帧
+ *
+ * @param frame 输出缓冲区（>= kMinFrameLen 字节）
+ * @param mac 本机 MAC 地址
+ */
+void BuildArpRequest(uint8_t* frame, const uint8_t* mac) {
+  Memzero(frame, kMinFrameLen);
+  for (size_t i = 0; i < 6; ++i) {
+    frame[i] = 0xFF;
+    frame[6 + i] = mac[i];
+    frame[22 + i] = mac[i];
+  }
+  // EtherType: ARP
+  frame[12] = 0x08;
+  frame[13] = 0x06;
+  // 硬件类型 Ethernet，协议类型 IPv4，地址长度 6/4，操作码 request
+  frame[15] = 0x01;
+  frame[16] = 0x08;
+  frame[18] = 6;
+  frame[19] = 4;
+  frame[21] = 0x01;
+  for (size_t i = 0; i < 4; ++i) {
+    frame[28 + i] = kGuestIp[i];
+    frame[38 + i] = kGatewayIp[i];
+  }
+}
+
+/**
+ * @brief 判断接收包是否为网关的 ARP 应答
+ */
+auto IsArpReplyFromGateway(const NetType::RxPacket& packet) -> bool {
+  if (packet.segment_count == 0 || packet.segments[0].len < 42) {
+    return false;
+  }
+  const uint8_t* p = packet.segments[0].data;
+  if (p[12] != 0x08 || p[13] != 0x06 || p[20] != 0x00 || p[21] != 0x02) {
+    return false;
+  }
+  for (size_t i = 0; i < 4; ++i) {
+    if (p[28 + i] != kGatewayIp[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+void test_virtio_net() {
+  TEST_SUITE_BEGIN("VirtIO Net");
+
+  // === 测试 1: 查找网络设备 ===
+  auto bus = device_framework::virtio::VirtioMmioBus<RiscvTraits>::Scan(
+      kVirtioMmioBase, kVirtioMmioSize, kMaxVirtioDevices);
+  auto info = bus.Find(kNetDeviceId);
+  EXPECT_TRUE(info.has_value(), "Find virtio-net device");
+  if (!info.has_value()) {
+    LOG("No virtio-net device found, skipping remaining tests");
+    TEST_SUITE_END();
+    return;
+  }
+  LOG_HEX("virtio-net at", info->base);
+
+  // === 测试 2: Create() 与设备信息 ===
+  size_t dma_size = NetType::CalcDmaSize(1, kNetQueueSize);
+  EXPECT_TRUE(dma_size <= kDmaBufSize, "DMA layout fits in test buffer");
+  Memzero(g_dma_buf, dma_size);
+  auto net_result = NetType::Create(info->base, g_dma_buf, 1, kNetQueueSize);
+  EXPECT_TRUE(net_result.has_value(), "VirtioNet::Create()");
+  if (!net_result.has_value()) {
+    TEST_SUITE_END();
+    return;
+  }
+  auto& net = *net_result;
+  EXPECT_EQ(1U, net.GetQueuePairCount(), "One queue pair in use");
+
+  const auto& mac = net.GetMac();
+  bool mac_nonzero = false;
+  for (auto byte : mac) {
+    mac_nonzero = mac_nonzero || byte != 0;
+  }
+  EXPECT_TRUE(mac_nonzero, "MAC address read from device config");
+  EXPECT_TRUE(net.IsLinkUp(), "Link is up");
+
+  // === 测试 3: 参数校验 ===
+  {
+    device_framework::virtio::IoVec iov{RiscvTraits::VirtToPhys(g_data_buf),
+                                        kMinFrameLen};
+    EXPECT_FALSE(net.Transmit(1, &iov, 1).has_value(),
+                 "Transmit() rejects invalid pair index");
+    EXPECT_FALSE(net.Transmit(0, &iov, 0).has_value(),
+                 "Transmit() rejects empty frame");
+    EXPECT_FALSE(
+        net.Transmit(0, &iov, NetType::kMaxTxSegments + 1).has_value(),
+        "Transmit() rejects too many segments");
+  }
+
+  // === 测试 4: ARP 请求 / 应答 ===
+  {
+    BuildArpRequest(g_data_buf, mac);
+    device_framework::virtio::IoVec iov{
+        RiscvTraits::VirtToPhys(g_data_buf), kMinFrameLen};
+    static uint8_t token = 0;
+    auto tx_result = net.Transmit(0, &iov, 1, nullptr, &token);
+    EXPECT_TRUE(tx_result.has_value(), "Transmit() ARP request");
+    net.KickTx(0);
+
+    bool got_reply = false;
+    size_t received = 0;
+    for (uint32_t i = 0; i < kMaxPollIterations && !got_reply; ++i) {
+      received += net.Receive(0, [&](const NetType::RxPacket& packet) {
+        got_reply = got_reply || IsArpReplyFromGateway(packet);
+      });
+    }
+    EXPECT_TRUE(got_reply, "Received ARP reply from gateway");
+    LOG_HEX("Packets received", received);
+
+    // === 测试 5: 发送回收与缓冲区循环 ===
+    bool token_seen = false;
+    size_t reaped = 0;
+    for (uint32_t i = 0; i < kMaxPollIterations && reaped == 0; ++i) {
+      reaped = net.ReapTx(0, [&](void* t) { token_seen = t == &token; });
+    }
+    EXPECT_EQ(1U, reaped, "ReapTx() reclaims the sent packet");
+    EXPECT_TRUE(token_seen, "ReapTx() returns the submitted token");
+
+    // 发送超过接收缓冲池大小的请求数，验证缓冲区被重新投递
+    size_t replies = 0;
+    for (uint32_t round = 0; round < kNetQueueSize + 8; ++round) {
+      (void)net.Transmit(0, &iov, 1);
+      net.KickTx(0);
+      bool got = false;
+      for (uint32_t i = 0; i < kMaxPollIterations && !got; ++i) {
+        net.Receive(0, [&](const NetType::RxPacket& packet) {
+          got = got || IsArpReplyFromGateway(packet);
+        });
+      }
+      replies += got ? 1 : 0;
+      (void)net.ReapTx(0);
+    }
+    EXPECT_EQ(static_cast<size_t>(kNetQueueSize + 8), replies,
+              "RX buffers are recycled across pool wrap-around");
+
+    auto stats = net.GetStats();
+    EXPECT_EQ(0U, stats.rx_dropped, "No RX packets dropped");
+    EXPECT_TRUE(stats.tx_packets >= kNetQueueSize + 9,
+                "TX completions counted");
+  }
+
+  TEST_SUITE_END();
+}